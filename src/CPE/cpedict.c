@@ -63,7 +63,10 @@ struct cpe_dict_model *cpe_dict_model_import_source(struct oscap_source *source)
 		}
 	}
 	cpe_parser_ctx_free(ctx);
-	xmlFreeTextReader(reader);
+	if (oscap_source_free_xmlTextReader(reader) != 0) {
+		cpe_dict_model_free(dict);
+		dict = NULL;
+	}
 	return dict;
 }
 
@@ -80,54 +83,73 @@ void cpe_dict_model_export(const struct cpe_dict_model *dict, const char *file)
 
 }
 
-bool cpe_name_match_dict(struct cpe_name * cpe, struct cpe_dict_model * dict)
+static bool cpe_name_match_list(struct cpe_name *cpe, struct oscap_list *items)
 {
-	// FIXME: We could match faster by matching per component and storing all
-	//        cpe_dict items in a big tree where leaves contain cpe_items and
-	//        inner nodes are the components.
+	bool ret = false;
+	struct oscap_iterator *it = oscap_iterator_new(items);
+	while (oscap_iterator_has_more(it)) {
+		struct cpe_item *item = oscap_iterator_next(it);
+		if (cpe_name_match_one(cpe_item_get_name(item), cpe)) {
+			ret = true;
+			break;
+		}
+	}
+	oscap_iterator_free(it);
+	return ret;
+}
 
+bool cpe_name_match_dict(struct cpe_name * cpe, struct cpe_dict_model * dict)
+{
 	__attribute__nonnull__(cpe);
 	__attribute__nonnull__(dict);
 
 	if (cpe == NULL || dict == NULL)
 		return false;
 
-	struct cpe_item_iterator *items = cpe_dict_model_get_items(dict);
-
-	bool ret = false;
-	while (cpe_item_iterator_has_more(items)) {
-		struct cpe_item* item = cpe_item_iterator_next(items);
-		struct cpe_name* name = cpe_item_get_name(item);
-
-		if (cpe_name_match_one(name, cpe)) {
-			ret = true;
-			break;
-		}
-	}
-	cpe_item_iterator_free(items);
-	return ret;
+	// The names of the dictionary items are matched against the CPE name,
+	// only the items with the same part, vendor and product and the items
+	// which don't specify them can match.
+	cpe_dict_model_build_name_index(dict);
+	char *key = cpe_dict_model_name_index_key(cpe, true);
+	struct oscap_list *bucket = oscap_htable_get(dict->name_index, key);
+	free(key);
+
+	if (bucket != NULL && cpe_name_match_list(cpe, bucket))
+		return true;
+	return cpe_name_match_list(cpe, dict->name_index_wildcards);
 }
 
 bool cpe_name_applicable_dict(struct cpe_name *cpe, struct cpe_dict_model *dict, cpe_check_fn cb, void* usr)
 {
-	// FIXME: We could match faster by matching per component and storing all
-	//        cpe_dict items in a big tree where leaves contain cpe_items and
-	//        inner nodes are the components.
-
 	__attribute__nonnull__(cpe);
 	__attribute__nonnull__(dict);
 
 	if (cpe == NULL || dict == NULL)
 		return false;
 
-	struct cpe_item_iterator *items = cpe_dict_model_get_items(dict);
+	// The CPE name is matched against the names of the dictionary items. If
+	// it specifies part, vendor and product, only the items with the same
+	// ones can match, they are looked up in the index. Otherwise all items
+	// are checked.
+	struct oscap_iterator *items = NULL;
+	char *key = cpe_dict_model_name_index_key(cpe, false);
+	if (key != NULL) {
+		cpe_dict_model_build_name_index(dict);
+		struct oscap_list *bucket = oscap_htable_get(dict->name_index, key);
+		free(key);
+		if (bucket == NULL)
+			return false;
+		items = oscap_iterator_new(bucket);
+	} else {
+		items = oscap_iterator_new(dict->items);
+	}
 
 	// essentially, we want at least one applicable match so as soon as we find
 	// a match we break and return true
 
 	bool ret = false;
-	while (cpe_item_iterator_has_more(items)) {
-		struct cpe_item* item = cpe_item_iterator_next(items);
+	while (oscap_iterator_has_more(items)) {
+		struct cpe_item* item = oscap_iterator_next(items);
 		struct cpe_name* name = cpe_item_get_name(item);
 
 		if (cpe_name_match_one(cpe, name) && cpe_item_is_applicable(item, cb, usr)) {
@@ -135,7 +157,7 @@ bool cpe_name_applicable_dict(struct cpe_name *cpe, struct cpe_dict_model *dict,
 			break;
 		}
 	}
-	cpe_item_iterator_free(items);
+	oscap_iterator_free(items);
 	return ret;
 }
 
@@ -174,7 +196,7 @@ char *cpe_dict_detect_version_priv(xmlTextReader *reader)
 {
 	char *version = NULL;
 	/* find root element */
-	while (xmlTextReaderRead(reader) == 1
+	while (xmlTextReaderNextNode(reader) == 1
 	       && xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT);
 
 	const char* elm_name = (const char *) xmlTextReaderConstLocalName(reader);
@@ -185,7 +207,7 @@ char *cpe_dict_detect_version_priv(xmlTextReader *reader)
 	const char* ns_uri = (const char *) xmlTextReaderConstNamespaceUri(reader);
 
 	/* find generator */
-	while (xmlTextReaderRead(reader) == 1
+	while (xmlTextReaderNextNode(reader) == 1
 		   && xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT);
 	elm_name = (const char *) xmlTextReaderConstLocalName(reader);
 
@@ -193,7 +215,7 @@ char *cpe_dict_detect_version_priv(xmlTextReader *reader)
 	if (elm_name && strcmp(elm_name, "generator") == 0) {
 		/* find schema_version */
 		const int depth = xmlTextReaderDepth(reader);
-		while (xmlTextReaderRead(reader) == 1 && xmlTextReaderDepth(reader) > depth) {
+		while (xmlTextReaderNextNode(reader) == 1 && xmlTextReaderDepth(reader) > depth) {
 			if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT)
 				continue;
 
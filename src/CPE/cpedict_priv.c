@@ -53,6 +53,8 @@
 #include "common/_error.h"
 #include "common/xmlns_priv.h"
 #include "common/xmltext_priv.h"
+#include "oscap_helpers.h"
+#include "cpename_priv.h"
 #include "source/oscap_source_priv.h"
 #include "source/public/oscap_source.h"
 
@@ -82,12 +84,12 @@ struct cpe_item {		// the node <cpe-item>
 	struct oscap_list *notes;	// list of notes - it's the same structure as titles
 	struct cpe_item_metadata *metadata;	// element <meta:item-metadata>
 	struct cpe23_item *cpe23_item;		///< element <cpe23-item>
+	struct cpe_dict_model *dict;		///< dictionary the item has been added to
 	struct {
 		bool deprecated:1;		///< Is the deprecated atrtribute specified in XML?
 	} export;
 };
 OSCAP_GETTER(struct cpe_name *, cpe_item, name)
-OSCAP_SETTER_GENERIC(cpe_item, const struct cpe_name *, name, cpe_name_free, )
 OSCAP_GETTER(struct cpe_name *, cpe_item, deprecated_by)
 OSCAP_SETTER_GENERIC(cpe_item, const struct cpe_name *, deprecated_by, cpe_name_free, )
 OSCAP_ACCESSOR_STRING(cpe_item, deprecation_date)
@@ -150,9 +152,91 @@ OSCAP_ACCESSOR_STRING(cpe_generator, product_name)
 
 OSCAP_GETTER(struct cpe_generator *, cpe_dict_model, generator)
 OSCAP_ACCESSOR_SIMPLE(int, cpe_dict_model, base_version)
-OSCAP_IGETINS_GEN(cpe_item, cpe_dict_model, items, item) OSCAP_ITERATOR_REMOVE_F(cpe_item)
+OSCAP_IGETTER_GEN(cpe_item, cpe_dict_model, items) OSCAP_ITERATOR_REMOVE_F(cpe_item)
 OSCAP_IGETINS_GEN(cpe_vendor, cpe_dict_model, vendors, vendor) OSCAP_ITERATOR_REMOVE_F(cpe_vendor)
 
+static void cpe_dict_model_drop_name_index(struct cpe_dict_model *dict)
+{
+	oscap_htable_free(dict->name_index, (oscap_destruct_func) oscap_list_free0);
+	oscap_list_free0(dict->name_index_wildcards);
+	dict->name_index = NULL;
+	dict->name_index_wildcards = NULL;
+}
+
+bool cpe_dict_model_add_item(struct cpe_dict_model *dict, struct cpe_item *item)
+{
+	cpe_dict_model_drop_name_index(dict);
+	oscap_list_add(dict->items, item);
+	item->dict = dict;
+	return true;
+}
+
+void cpe_item_name_changed(struct cpe_item *item)
+{
+	// the item is indexed by its name in the dictionary
+	if (item->dict != NULL)
+		cpe_dict_model_drop_name_index(item->dict);
+}
+
+bool cpe_item_set_name(struct cpe_item *item, const struct cpe_name *new_name)
+{
+	cpe_item_name_changed(item);
+	cpe_name_free(item->name);
+	item->name = (struct cpe_name *) new_name;
+	if (item->name != NULL)
+		cpe_name_set_item(item->name, item);
+	return true;
+}
+
+char *cpe_dict_model_name_index_key(const struct cpe_name *name, bool allow_empty)
+{
+	const cpe_part_t part = cpe_name_get_part(name);
+	const char *vendor = cpe_name_get_vendor(name);
+	const char *product = cpe_name_get_product(name);
+	if (!allow_empty && (part == CPE_PART_NONE || vendor == NULL || *vendor == '\0' || product == NULL || *product == '\0'))
+		return NULL;
+
+	// CPE names are matched case insensitively
+	char *key = oscap_sprintf("%d:%s:%s", part, vendor != NULL ? vendor : "", product != NULL ? product : "");
+	for (char *c = key; *c != '\0'; c++)
+		*c = tolower((unsigned char) *c);
+	return key;
+}
+
+void cpe_dict_model_build_name_index(struct cpe_dict_model *dict)
+{
+	const int itemcount = oscap_list_get_itemcount(dict->items);
+	if (dict->name_index != NULL && dict->name_index_itemcount == itemcount)
+		return;
+
+	cpe_dict_model_drop_name_index(dict);
+	dict->name_index = oscap_htable_new();
+	dict->name_index_wildcards = oscap_list_new();
+	dict->name_index_itemcount = itemcount;
+
+	struct oscap_iterator *items = oscap_iterator_new(dict->items);
+	while (oscap_iterator_has_more(items)) {
+		struct cpe_item *item = oscap_iterator_next(items);
+		const struct cpe_name *name = cpe_item_get_name(item);
+		if (name == NULL)
+			continue;
+		// Missing components of item names match any component
+		if (cpe_name_get_part(name) == CPE_PART_NONE || cpe_name_get_vendor(name) == NULL || cpe_name_get_product(name) == NULL) {
+			oscap_list_add(dict->name_index_wildcards, item);
+			continue;
+		}
+		char *key = cpe_dict_model_name_index_key(name, true);
+		struct oscap_list *bucket = oscap_htable_get(dict->name_index, key);
+		if (bucket == NULL) {
+			bucket = oscap_list_new();
+			oscap_htable_add(dict->name_index, key, bucket);
+		}
+		oscap_list_add(bucket, item);
+		free(key);
+	}
+	oscap_iterator_free(items);
+}
+
 /* ****************************************
  * Component-tree structures
  * ***************************************/
@@ -530,6 +614,8 @@ struct cpe_dict_model *cpe_dict_model_parse(struct cpe_parser_ctx *ctx)
 			return NULL;
 		}
 	}
+	if (next_ret == -1)
+		return NULL;
 
 	// make sure we exit when we reach this depth again
 	int entry_depth = xmlTextReaderDepth(reader);
@@ -559,7 +645,7 @@ struct cpe_dict_model *cpe_dict_model_parse(struct cpe_parser_ctx *ctx)
 
 	// go through elements and switch through actions till end of file..
 	next_ret = xmlTextReaderNextElementWE(reader, TAG_CPE_LIST_STR);
-	while (next_ret != 0) {
+	while (next_ret == 1) {
 		if (xmlTextReaderDepth(reader) <= entry_depth) {
 			// we have reached the end of <cpe-list>
 			// this is necessary to make XCCDF CPE integration to work
@@ -615,9 +701,9 @@ struct cpe_generator *cpe_generator_parse(struct cpe_parser_ctx *ctx)
 			return NULL;
 
 		// skip nodes until new element
-		xmlTextReaderNextElement(reader);
+		int next_ret = xmlTextReaderNextElement(reader);
 
-		while (xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_GENERATOR_STR) != 0) {
+		while (next_ret == 1 && xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_GENERATOR_STR) != 0) {
 
 			if ((xmlStrcmp(xmlTextReaderConstLocalName(reader),
 				       TAG_PRODUCT_NAME_STR) == 0) &&
@@ -646,7 +732,7 @@ struct cpe_generator *cpe_generator_parse(struct cpe_parser_ctx *ctx)
 			}
 			// element saved. Let's jump on the very next one node (not element, because we need to 
 			// find XML_READER_TYPE_END_ELEMENT node, see "while" condition and the condition below "while"
-			xmlTextReaderNextNode(reader);
+			next_ret = xmlTextReaderNextNode(reader);
 
 		}
 	}
@@ -681,8 +767,11 @@ struct cpe_item *cpe_item_parse(struct cpe_parser_ctx *ctx)
 
 		// Get a name attribute of cpe-item
 		data = (char *)xmlTextReaderGetAttribute(reader, ATTR_NAME_STR);
-		if (data != NULL)
+		if (data != NULL) {
 			ret->name = cpe_name_new(data);
+			if (ret->name != NULL)
+				cpe_name_set_item(ret->name, ret);
+		}
 		free(data);
 
 		// if there is "deprecated", "deprecated_by" and "deprecation_date" in cpe-item element
@@ -709,13 +798,13 @@ struct cpe_item *cpe_item_parse(struct cpe_parser_ctx *ctx)
 		free(data);
 		// ************************************************************************************
 
-		xmlTextReaderNextElementWE(reader, TAG_CPE_ITEM_STR);
+		int next_ret = xmlTextReaderNextElementWE(reader, TAG_CPE_ITEM_STR);
 		// Now it's time to go deaply to cpe-item element and parse it's children
 		// Do while there is another cpe-item element. Then return.
-		while (xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_CPE_ITEM_STR) != 0) {
+		while (next_ret == 1 && xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_CPE_ITEM_STR) != 0) {
 
 			if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) {
-				xmlTextReaderNextNode(reader);
+				next_ret = xmlTextReaderNextNode(reader);
 				continue;
 			}
 
@@ -770,7 +859,7 @@ struct cpe_item *cpe_item_parse(struct cpe_parser_ctx *ctx)
 			} else {
 				return ret;	// <-- we need to return here, because we don't want to jump to next element 
 			}
-			xmlTextReaderNextElementWE(reader, TAG_CPE_ITEM_STR);
+			next_ret = xmlTextReaderNextElementWE(reader, TAG_CPE_ITEM_STR);
 		}
 	}
 
@@ -830,10 +919,10 @@ static struct cpe_notes *cpe_notes_parse(xmlTextReaderPtr reader)
 	struct cpe_notes *notes = cpe_notes_new();
 	notes->lang = (char *) xmlTextReaderXmlLang(reader);
 	if (xmlTextReaderIsEmptyElement(reader) == 0) { // element contains child nodes
-		xmlTextReaderNextNode(reader);
-		while (xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_NOTES_STR) != 0) {
+		int next_ret = xmlTextReaderNextNode(reader);
+		while (next_ret == 1 && xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_NOTES_STR) != 0) {
 			if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) {
-				xmlTextReaderNextNode(reader);
+				next_ret = xmlTextReaderNextNode(reader);
 				continue;
 			}
 
@@ -846,7 +935,7 @@ static struct cpe_notes *cpe_notes_parse(xmlTextReaderPtr reader)
 				cpe_notes_free(notes);
 				return NULL;
 			}
-			xmlTextReaderNextNode(reader);
+			next_ret = xmlTextReaderNextNode(reader);
 		}
 	}
 
@@ -875,12 +964,12 @@ struct cpe_vendor *cpe_vendor_parse(xmlTextReaderPtr reader)
 
 	ret->value = (char *)xmlTextReaderGetAttribute(reader, ATTR_VALUE_STR);
 	// jump to next element (which should be product)
-	xmlTextReaderNextElement(reader);
+	int next_ret = xmlTextReaderNextElement(reader);
 
-	while (xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_VENDOR_STR) != 0) {
+	while (next_ret == 1 && xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_VENDOR_STR) != 0) {
 
 		if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) {
-			xmlTextReaderNextNode(reader);
+			next_ret = xmlTextReaderNextNode(reader);
 			continue;
 		}
 
@@ -937,7 +1026,7 @@ struct cpe_vendor *cpe_vendor_parse(xmlTextReaderPtr reader)
 			oscap_seterr(OSCAP_EFAMILY_OSCAP, "Unknown XML element withinin CPE vendor element, local name is '%s'.",
 				xmlTextReaderConstLocalName(reader));
 		}
-		xmlTextReaderNextNode(reader);
+		next_ret = xmlTextReaderNextNode(reader);
 	}
 	return ret;
 
@@ -1313,6 +1402,7 @@ void cpe_dict_model_free(struct cpe_dict_model *dict)
 	if (dict == NULL)
 		return;
 
+	cpe_dict_model_drop_name_index(dict);
 	oscap_list_free(dict->items, (oscap_destruct_func) cpe_item_free);
 	oscap_list_free(dict->vendors, (oscap_destruct_func) cpe_vendor_free);
 	cpe_generator_free(dict->generator);
@@ -142,8 +142,28 @@ struct cpe_dict_model {		// the main node
 	int base_version;
 	struct cpe_generator *generator;
 	char* origin_file;
+	struct oscap_htable *name_index;	// items by part, vendor and product of their names
+	struct oscap_list *name_index_wildcards;	// items whose names lack part, vendor or product
+	int name_index_itemcount;	// number of items when the index was built
 };
 
+/**
+ * Builds the index of dictionary items by their names unless it is up to date.
+ * The index is dropped when an item is added to the dictionary, when the name
+ * of its item is set or when part, vendor or product of the name of its item
+ * is changed. It is rebuilt when the number of items changes otherwise.
+ * @param dict CPE dictionary
+ */
+void cpe_dict_model_build_name_index(struct cpe_dict_model *dict);
+
+/**
+ * Returns the key of the name index for given CPE name.
+ * @param name CPE name
+ * @param allow_empty if false, NULL is returned for names which lack part,
+ * vendor or product or have them empty
+ */
+char *cpe_dict_model_name_index_key(const struct cpe_name *name, bool allow_empty);
+
 /** 
  * @cond INTERNAL
  */
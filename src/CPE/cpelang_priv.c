@@ -46,6 +46,7 @@
 #include "common/_error.h"
 #include "common/xmlns_priv.h"
 #include "common/xmltext_priv.h"
+#include "common/oscap_model_cache.h"
 #include "source/oscap_source_priv.h"
 #include "source/public/oscap_source.h"
 
@@ -227,8 +228,11 @@ struct cpe_lang_model *cpe_lang_model_import_source(struct oscap_source *source)
 		if (ret != NULL) {
 			cpe_lang_model_set_origin_file(ret, oscap_source_readable_origin(source));
 		}
+		if (oscap_source_free_xmlTextReader(reader) != 0) {
+			cpe_lang_model_free(ret);
+			ret = NULL;
+		}
 	}
-	xmlFreeTextReader(reader);
 	return ret;
 }
 
@@ -255,7 +259,8 @@ struct cpe_lang_model *cpe_lang_model_parse(xmlTextReaderPtr reader)
 			platform = cpe_platform_parse(reader);
 			if (platform)
 				cpe_lang_model_add_platform(ret, platform);
-			xmlTextReaderNextElementWE(reader, TAG_PLATFORM_SPEC_STR);
+			if (xmlTextReaderNextElementWE(reader, TAG_PLATFORM_SPEC_STR) != 1)
+				break;
 		}
 	}
 
@@ -281,7 +286,8 @@ struct cpe_platform *cpe_platform_parse(xmlTextReaderPtr reader)
 		return NULL;	// if there is no "id" in platform element, return NULL
 	}
 	// skip from <platform> node to next one
-	xmlTextReaderNextNode(reader);
+	if (xmlTextReaderNextNode(reader) != 1)
+		return ret;
 
 	// while we have element that is not "platform", it is inside this element, otherwise it's ended 
 	// element </platform> and we should end. If there is no one from "if" statement cases, we are parsing
@@ -303,8 +309,9 @@ struct cpe_platform *cpe_platform_parse(xmlTextReaderPtr reader)
 			ret->expr = cpe_testexpr_parse(reader);
 		} else if (xmlTextReaderNodeType(reader) == XML_READER_TYPE_ELEMENT)
 			oscap_seterr(OSCAP_EFAMILY_OSCAP, "Unknown XML element in platform");
-		// get the next node
-		xmlTextReaderNextNode(reader);
+		// get the next node, stop on a broken document
+		if (xmlTextReaderNextNode(reader) != 1)
+			break;
 	}
 	return ret;
 }
@@ -367,7 +374,8 @@ struct cpe_testexpr *cpe_testexpr_parse(xmlTextReaderPtr reader)
 
 	// go to next node
 	// skip to next node
-	xmlTextReaderNextNode(reader);
+	if (xmlTextReaderNextNode(reader) != 1)
+		return ret;
         int depth = xmlTextReaderDepth(reader);
         //printf("[%d] logical-test\n", depth);
 	// while it's not 'logical-test' or it's not ended element ..
@@ -378,7 +386,8 @@ struct cpe_testexpr *cpe_testexpr_parse(xmlTextReaderPtr reader)
                 //printf("[%d:%d] logical-test::%s\n", depth, xmlTextReaderDepth(reader), xmlTextReaderConstLocalName(reader));
 
 		if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) {
-			xmlTextReaderNextNode(reader);
+			if (xmlTextReaderNextNode(reader) != 1)
+				break;
 			continue;
 		}
 		elem_cnt++;
@@ -392,6 +401,8 @@ struct cpe_testexpr *cpe_testexpr_parse(xmlTextReaderPtr reader)
 		    xmlTextReaderNodeType(reader) == XML_READER_TYPE_ELEMENT) {
 			// ret->meta.expr[elem_cnt - 1] = *(cpe_testexpr_parse(reader));
 			oscap_list_add(ret->meta.expr, cpe_testexpr_parse(reader));
+			if (xmlTextReaderFailed(reader))
+				break;
                         if (xmlTextReaderDepth(reader) < depth) {
                                 return ret;
                         } else if (xmlTextReaderDepth(reader) == depth) continue;
@@ -418,7 +429,8 @@ struct cpe_testexpr *cpe_testexpr_parse(xmlTextReaderPtr reader)
 		} else if (xmlTextReaderNodeType(reader) == XML_READER_TYPE_ELEMENT) {
 			oscap_seterr(OSCAP_EFAMILY_OSCAP, "Unknown XML element in test expression");
 		}
-		xmlTextReaderNextNode(reader);
+		if (xmlTextReaderNextNode(reader) != 1)
+			break;
 	}
 	//ret->meta.expr[elem_cnt].oper = CPE_LANG_OPER_HALT;
 
@@ -435,7 +447,7 @@ static char *parse_text_element(xmlTextReaderPtr reader, char *name)
 
 	// parse string element attributes here (like xml:lang)
 
-	while (xmlTextReaderNextNode(reader)) {
+	while (xmlTextReaderNextNode(reader) == 1) {
 		if (xmlTextReaderNodeType(reader) == XML_READER_TYPE_END_ELEMENT &&
 		    !xmlStrcmp(xmlTextReaderConstLocalName(reader), BAD_CAST name)) {
 			return string;
@@ -577,6 +589,116 @@ void cpe_testexpr_export(const struct cpe_testexpr *expr, xmlTextWriterPtr write
  * */
 /***************************************************************************/
 
+/***************************************************************************/
+/* Model cache records, see common/oscap_model_cache.h
+ */
+
+static void cpe_testexpr_cache_write(struct oscap_model_writer *writer, const void *item)
+{
+	const struct cpe_testexpr *expr = item;
+	oscap_model_write_u32(writer, expr->oper);
+
+	switch (expr->oper & CPE_LANG_OPER_MASK) {
+	case CPE_LANG_OPER_AND:
+	case CPE_LANG_OPER_OR:
+		oscap_model_write_bool(writer, expr->meta.expr != NULL);
+		oscap_model_write_list(writer, expr->meta.expr, cpe_testexpr_cache_write);
+		break;
+	case CPE_LANG_OPER_MATCH: {
+		char *name = expr->meta.cpe != NULL ? cpe_name_get_as_str(expr->meta.cpe) : NULL;
+		if (expr->meta.cpe != NULL && name == NULL)
+			oscap_model_writer_fail(writer);
+		oscap_model_write_string(writer, name);
+		free(name);
+		break;
+	}
+	case CPE_LANG_OPER_CHECK:
+		oscap_model_write_string(writer, expr->meta.check.system);
+		oscap_model_write_string(writer, expr->meta.check.href);
+		oscap_model_write_string(writer, expr->meta.check.id);
+		break;
+	default:
+		break;
+	}
+}
+
+static void *cpe_testexpr_cache_read(struct oscap_model_reader *reader)
+{
+	struct cpe_testexpr *expr = cpe_testexpr_new();
+	expr->oper = oscap_model_read_u32(reader);
+
+	switch (expr->oper & CPE_LANG_OPER_MASK) {
+	case CPE_LANG_OPER_AND:
+	case CPE_LANG_OPER_OR:
+		if (oscap_model_read_bool(reader))
+			expr->meta.expr = oscap_list_new();
+		if (expr->meta.expr != NULL)
+			oscap_model_read_list(reader, expr->meta.expr, cpe_testexpr_cache_read);
+		else if (oscap_model_read_count(reader) != 0)
+			oscap_model_reader_fail(reader);
+		break;
+	case CPE_LANG_OPER_MATCH: {
+		char *name = oscap_model_read_string(reader);
+		if (name != NULL) {
+			expr->meta.cpe = cpe_name_new(name);
+			if (expr->meta.cpe == NULL)
+				oscap_model_reader_fail(reader);
+		}
+		free(name);
+		break;
+	}
+	case CPE_LANG_OPER_CHECK:
+		expr->meta.check.system = oscap_model_read_string(reader);
+		expr->meta.check.href = oscap_model_read_string(reader);
+		expr->meta.check.id = oscap_model_read_string(reader);
+		break;
+	default:
+		break;
+	}
+	return expr;
+}
+
+static void cpe_platform_cache_write(struct oscap_model_writer *writer, const void *item)
+{
+	const struct cpe_platform *platform = item;
+	oscap_model_write_string(writer, platform->id);
+	oscap_model_write_string(writer, platform->remark);
+	oscap_model_write_list(writer, platform->titles, oscap_text_cache_write);
+	oscap_model_write_bool(writer, platform->expr != NULL);
+	if (platform->expr != NULL)
+		cpe_testexpr_cache_write(writer, platform->expr);
+}
+
+static void *cpe_platform_cache_read(struct oscap_model_reader *reader)
+{
+	struct cpe_platform *platform = cpe_platform_new();
+	platform->id = oscap_model_read_string(reader);
+	platform->remark = oscap_model_read_string(reader);
+	oscap_model_read_list(reader, platform->titles, oscap_text_cache_read);
+	cpe_testexpr_free(platform->expr);
+	platform->expr = oscap_model_read_bool(reader) ? cpe_testexpr_cache_read(reader) : NULL;
+	if (platform->id == NULL)
+		oscap_model_reader_fail(reader);
+	return platform;
+}
+
+void cpe_lang_model_cache_write(const struct cpe_lang_model *lang_model, struct oscap_model_writer *writer)
+{
+	oscap_model_write_list(writer, lang_model->platforms, cpe_platform_cache_write);
+}
+
+struct cpe_lang_model *cpe_lang_model_cache_read(struct oscap_model_reader *reader)
+{
+	struct cpe_lang_model *lang_model = cpe_lang_model_new();
+	size_t count = oscap_model_read_count(reader);
+	for (size_t i = 0; i < count && !oscap_model_reader_failed(reader); ++i) {
+		struct cpe_platform *platform = cpe_platform_cache_read(reader);
+		if (!cpe_lang_model_add_platform(lang_model, platform))
+			cpe_platform_free(platform);
+	}
+	return lang_model;
+}
+
 /***************************************************************************/
 /* Free functions - all are static private, do not use them outside this file
  */
@@ -137,6 +137,22 @@ bool cpe_lang_model_set_origin_file(struct cpe_lang_model* lang_model, const cha
  */
 const char* cpe_lang_model_get_origin_file(const struct cpe_lang_model* lang_model);
 
+struct oscap_model_writer;
+struct oscap_model_reader;
+
+/**
+ * Serialize the platforms of the lang model to a model cache record
+ * @see oscap_model_cache_store
+ */
+void cpe_lang_model_cache_write(const struct cpe_lang_model *lang_model, struct oscap_model_writer *writer);
+
+/**
+ * Load the platforms written by cpe_lang_model_cache_write()
+ * The origin file isn't part of the record, the caller sets it.
+ * @return new lang model, check the reader for failures
+ */
+struct cpe_lang_model *cpe_lang_model_cache_read(struct oscap_model_reader *reader);
+
 
 /** 
  * @cond INTERNAL
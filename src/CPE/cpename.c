@@ -37,11 +37,12 @@
 
 #include <string.h>
 #include <stdio.h>
-#include <pcre.h>
 #include <ctype.h>
 
 #include "cpe_name.h"
+#include "cpename_priv.h"
 #include "common/util.h"
+#include "common/oscap_pcre.h"
 #include "oscap_helpers.h"
 
 #define CPE_URI_SUPPORTED "2.3"
@@ -88,6 +89,7 @@ struct cpe_name {
 	char *target_hw;
 	char *other;
 	/* end of extended attributes */
+	struct cpe_item *item;	// dictionary item named by this name, NULL if none
 };
 
 /* h - hardware
@@ -328,6 +330,7 @@ struct cpe_name * cpe_name_clone(struct cpe_name * old_name)
 	new_name->target_sw = oscap_strdup(old_name->target_sw);
 	new_name->target_hw = oscap_strdup(old_name->target_hw);
 	new_name->other = oscap_strdup(old_name->other);
+	new_name->item = NULL;
 
         return new_name;
 }
@@ -549,9 +552,7 @@ cpe_format_t cpe_name_get_format_of_str(const char *str)
 	if (str == NULL)
 		return CPE_FORMAT_UNKNOWN;
 
-	pcre *re;
-	const char *error;
-	int erroffset;
+	oscap_pcre_t *re;
 	int rc;
 	int ovector[30];
 
@@ -559,26 +560,26 @@ cpe_format_t cpe_name_get_format_of_str(const char *str)
 	// http://scap.nist.gov/schema/cpe/2.3/cpe-naming_2.3.xsd
 	// [c] was replaced with [cC] here and in the schemas
 
-	re = pcre_compile("^[cC][pP][eE]:/[AHOaho]?(:[A-Za-z0-9\\._\\-~%]*){0,6}$", 0, &error, &erroffset, NULL);
-	rc = pcre_exec(re, NULL, str, strlen(str), 0, 0, ovector, 30);
-	pcre_free(re);
+	re = oscap_pcre_get_cached("^[cC][pP][eE]:/[AHOaho]?(:[A-Za-z0-9\\._\\-~%]*){0,6}$", OSCAP_PCRE_OPTS_NONE, NULL, NULL);
+	rc = oscap_pcre_exec(re, str, strlen(str), 0, OSCAP_PCRE_OPTS_NONE, ovector, 30);
+	oscap_pcre_free(re);
 
 	if (rc >= 0)
 		return CPE_FORMAT_URI;
 
 	// The regex was taken from the official XSD at
 	// http://scap.nist.gov/schema/cpe/2.3/cpe-naming_2.3.xsd
-	re = pcre_compile("^cpe:2\\.3:[aho\\*\\-](:(((\\?*|\\*?)([a-zA-Z0-9\\-\\._]|(\\\\[\\\\\\*\\?!\"#$$%&'\\(\\)\\+,/:;<=>@\\[\\]\\^`\\{\\|}~]))+(\\?*|\\*?))|[\\*\\-])){5}(:(([a-zA-Z]{2,3}(-([a-zA-Z]{2}|[0-9]{3}))?)|[\\*\\-]))(:(((\\?*|\\*?)([a-zA-Z0-9\\-\\._]|(\\\\[\\\\\\*\\?!\"#$$%&'\\(\\)\\+,/:;<=>@\\[\\]\\^`\\{\\|}~]))+(\\?*|\\*?))|[\\*\\-])){4}$", 0, &error, &erroffset, NULL);
-	rc = pcre_exec(re, NULL, str, strlen(str), 0, 0, ovector, 30);
-	pcre_free(re);
+	re = oscap_pcre_get_cached("^cpe:2\\.3:[aho\\*\\-](:(((\\?*|\\*?)([a-zA-Z0-9\\-\\._]|(\\\\[\\\\\\*\\?!\"#$$%&'\\(\\)\\+,/:;<=>@\\[\\]\\^`\\{\\|}~]))+(\\?*|\\*?))|[\\*\\-])){5}(:(([a-zA-Z]{2,3}(-([a-zA-Z]{2}|[0-9]{3}))?)|[\\*\\-]))(:(((\\?*|\\*?)([a-zA-Z0-9\\-\\._]|(\\\\[\\\\\\*\\?!\"#$$%&'\\(\\)\\+,/:;<=>@\\[\\]\\^`\\{\\|}~]))+(\\?*|\\*?))|[\\*\\-])){4}$", OSCAP_PCRE_OPTS_NONE, NULL, NULL);
+	rc = oscap_pcre_exec(re, str, strlen(str), 0, OSCAP_PCRE_OPTS_NONE, ovector, 30);
+	oscap_pcre_free(re);
 
 	if (rc >= 0)
 		return CPE_FORMAT_STRING;
 
 	// FIXME: This should be way more strict
-	re = pcre_compile("^wfn:\\[.+\\]$", PCRE_CASELESS, &error, &erroffset, NULL);
-	rc = pcre_exec(re, NULL, str, strlen(str), 0, 0, ovector, 30);
-	pcre_free(re);
+	re = oscap_pcre_get_cached("^wfn:\\[.+\\]$", OSCAP_PCRE_OPTS_CASELESS, NULL, NULL);
+	rc = oscap_pcre_exec(re, str, strlen(str), 0, OSCAP_PCRE_OPTS_NONE, ovector, 30);
+	oscap_pcre_free(re);
 
 	if (rc >= 0)
 		return CPE_FORMAT_WFN;
@@ -722,9 +723,45 @@ const char * cpe_name_supported(void)
 }
 
 OSCAP_ACCESSOR_SIMPLE(cpe_format_t, cpe_name, format)
-OSCAP_ACCESSOR_SIMPLE(cpe_part_t, cpe_name, part)
-OSCAP_ACCESSOR_STRING(cpe_name, vendor)
-OSCAP_ACCESSOR_STRING(cpe_name, product)
+OSCAP_GETTER(cpe_part_t, cpe_name, part)
+OSCAP_GETTER(const char*, cpe_name, vendor)
+OSCAP_GETTER(const char*, cpe_name, product)
+
+void cpe_name_set_item(struct cpe_name *cpe, struct cpe_item *item)
+{
+	cpe->item = item;
+}
+
+/* Part, vendor and product are the key of the name index of dictionaries */
+static void cpe_name_key_changed(struct cpe_name *cpe)
+{
+	if (cpe->item != NULL)
+		cpe_item_name_changed(cpe->item);
+}
+
+bool cpe_name_set_part(struct cpe_name *cpe, cpe_part_t newval)
+{
+	cpe->part = newval;
+	cpe_name_key_changed(cpe);
+	return true;
+}
+
+bool cpe_name_set_vendor(struct cpe_name *cpe, const char *newval)
+{
+	free(cpe->vendor);
+	cpe->vendor = oscap_strdup(newval);
+	cpe_name_key_changed(cpe);
+	return true;
+}
+
+bool cpe_name_set_product(struct cpe_name *cpe, const char *newval)
+{
+	free(cpe->product);
+	cpe->product = oscap_strdup(newval);
+	cpe_name_key_changed(cpe);
+	return true;
+}
+
 OSCAP_ACCESSOR_STRING(cpe_name, version)
 OSCAP_ACCESSOR_STRING(cpe_name, update)
 OSCAP_ACCESSOR_STRING(cpe_name, edition)
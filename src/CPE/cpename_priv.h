@@ -0,0 +1,41 @@
+/*
+ * Copyright 2026 Red Hat Inc., Durham, North Carolina.
+ * All Rights Reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef CPENAME_PRIV_H_
+#define CPENAME_PRIV_H_
+
+struct cpe_name;
+struct cpe_item;
+
+/**
+ * Sets the dictionary item whose name the CPE name is. Changes of part,
+ * vendor or product of the name are reported to the item then.
+ * @param name CPE name
+ * @param item CPE dictionary item or NULL
+ */
+void cpe_name_set_item(struct cpe_name *name, struct cpe_item *item);
+
+/**
+ * Drops the name index of the dictionary the item has been added to,
+ * called when the name of the item changes.
+ * @param item CPE dictionary item
+ */
+void cpe_item_name_changed(struct cpe_item *item);
+
+#endif
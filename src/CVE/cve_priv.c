@@ -420,7 +420,10 @@ struct cve_model *cve_model_parse_xml(const char *file)
 
 	ret = cve_model_parse(reader);
 
-	xmlFreeTextReader(reader);
+	if (oscap_source_free_xmlTextReader(reader) != 0) {
+		cve_model_free(ret);
+		ret = NULL;
+	}
 	oscap_source_free(source);
 	return ret;
 }
@@ -452,7 +455,8 @@ struct cve_model *cve_model_parse(xmlTextReaderPtr reader)
 			entry = cve_entry_parse(reader);
 			if (entry)
 				oscap_list_add(ret->entries, entry);
-			xmlTextReaderNextElement(reader);
+			if (xmlTextReaderNextElement(reader) != 1)
+				break;
 		}
 	}
 
@@ -487,7 +491,8 @@ struct cve_entry *cve_entry_parse(xmlTextReaderPtr reader)
 		return ret;
 
 	/* skip from <entry> node to next one */
-	xmlTextReaderNextNode(reader);
+	if (xmlTextReaderNextNode(reader) != 1)
+		return ret;
 
 	/* while we have element that is not "entry", it is inside this element, otherwise it's ended 
 	 * element </entry> and we should end. If there is no one from "if" statement cases, we are parsing
@@ -496,7 +501,8 @@ struct cve_entry *cve_entry_parse(xmlTextReaderPtr reader)
 	while (xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_CVE_STR) != 0) {
 
 		if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) {
-			xmlTextReaderNextNode(reader);
+			if (xmlTextReaderNextNode(reader) != 1)
+				break;
 			continue;
 		}
 
@@ -505,14 +511,22 @@ struct cve_entry *cve_entry_parse(xmlTextReaderPtr reader)
 			conf = malloc(sizeof(struct cve_configuration));
 
 			conf->id = (char *)xmlTextReaderGetAttribute(reader, ATTR_CVE_ID_STR);
-			xmlTextReaderNextElement(reader);
+			if (xmlTextReaderNextElement(reader) != 1) {
+				xmlFree(conf->id);
+				free(conf);
+				break;
+			}
 			conf->expr = cpe_testexpr_parse(reader);
 
 			oscap_list_add(ret->configurations, conf);
+			/* the test expression parser stops on a broken document */
+			if (xmlTextReaderFailed(reader))
+				break;
                         continue;
 		} else if (!xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_VULNERABLE_SOFTWARE_LIST_STR)) {
 			/* this will be list of products */
-			xmlTextReaderNextNode(reader);
+			if (xmlTextReaderNextNode(reader) != 1)
+				break;
 			while (xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_VULNERABLE_SOFTWARE_LIST_STR) != 0) {
 				if (!xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_PRODUCT_STR) &&
 				    xmlTextReaderNodeType(reader) == XML_READER_TYPE_ELEMENT) {
@@ -523,7 +537,8 @@ struct cve_entry *cve_entry_parse(xmlTextReaderPtr reader)
 						oscap_list_add(ret->products, product);
                                         }
 				}
-				xmlTextReaderNextNode(reader);
+				if (xmlTextReaderNextNode(reader) != 1)
+					break;
 			}
 		} else if (!xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_CVE_ID_STR)) {
 			ret->cve_id = oscap_element_string_copy(reader);
@@ -546,8 +561,8 @@ struct cve_entry *cve_entry_parse(xmlTextReaderPtr reader)
 			if (refer) {
 			    refer->type = (char *)xmlTextReaderGetAttribute(reader, ATTR_REFERENCE_TYPE_STR);
 			    refer->lang = (char *)xmlTextReaderGetAttribute(reader, BAD_CAST "xml:lang");
-			    xmlTextReaderNextNode(reader);
-			    while (xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_REFERENCES_STR) != 0) {
+			    int rc = xmlTextReaderNextNode(reader);
+			    while (rc == 1 && xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_REFERENCES_STR) != 0) {
 
 				if (!xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_SOURCE_STR) &&
 				    xmlTextReaderNodeType(reader) == XML_READER_TYPE_ELEMENT) {
@@ -560,7 +575,7 @@ struct cve_entry *cve_entry_parse(xmlTextReaderPtr reader)
 					refer->value = oscap_element_string_copy(reader);
 
 				    }
-				xmlTextReaderNextNode(reader);
+				rc = xmlTextReaderNextNode(reader);
 			    }
 			    oscap_list_add(ret->references, refer);
 			}
@@ -574,19 +589,21 @@ struct cve_entry *cve_entry_parse(xmlTextReaderPtr reader)
 		} else if (!xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_ASSESSMENT_CHECK_STR)) {
 			/* Skip the assessment_check section in the XML file */
 			while (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) {
-				xmlTextReaderNextNode(reader);
+				if (xmlTextReaderNextNode(reader) != 1)
+					break;
 			}
 		} else if (!xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_SCANNER_STR)) {
 			/* Skip the scanner section in the XML file */
-			xmlTextReaderNextNode(reader);
-			while (xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_SCANNER_STR) != 0) {
+			int rc = xmlTextReaderNextNode(reader);
+			while (rc == 1 && xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_SCANNER_STR) != 0) {
 				if (!xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_DEFINITION_STR) &&
 				    xmlTextReaderNodeType(reader) == XML_READER_TYPE_ELEMENT) {
-					while (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) {
-						xmlTextReaderNextNode(reader);
+					while (rc == 1 && xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) {
+						rc = xmlTextReaderNextNode(reader);
 					}
 				}
-				xmlTextReaderNextNode(reader);
+				if (rc == 1)
+					rc = xmlTextReaderNextNode(reader);
 			}
 		} else {
 			oscap_seterr(OSCAP_EFAMILY_OSCAP, "Unknown XML element in CVE entry: %s",
@@ -595,8 +612,9 @@ struct cve_entry *cve_entry_parse(xmlTextReaderPtr reader)
 			return NULL;
 		}
 
-		/* get the next node */
-		xmlTextReaderNextNode(reader);
+		/* get the next node, stop on a broken document */
+		if (xmlTextReaderNextNode(reader) != 1)
+			break;
 	}
 
 	return ret;
@@ -69,7 +69,10 @@ struct cvrf_model *cvrf_model_import(struct oscap_source *source) {
 		return NULL;
 	}
 	struct cvrf_model *model = cvrf_model_parse(reader);
-	xmlFreeTextReader(reader);
+	if (oscap_source_free_xmlTextReader(reader) != 0) {
+		cvrf_model_free(model);
+		model = NULL;
+	}
 	return model;
 }
 
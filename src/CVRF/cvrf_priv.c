@@ -1447,7 +1447,7 @@ static void cvrf_parse_container(xmlTextReaderPtr reader, struct oscap_list *lis
 	if (item_type != CVRF_VULNERABILITY && item_type != CVRF_VULNERABILITY_CWE)
 		xmlTextReaderNextElement(reader);
 	bool error = false;
-	while (xmlStrcmp(xmlTextReaderConstLocalName(reader), BAD_CAST tag) == 0) {
+	while (!xmlTextReaderFailed(reader) && xmlStrcmp(xmlTextReaderConstLocalName(reader), BAD_CAST tag) == 0) {
 		if (item_type == CVRF_REVISION) {
 			error = !oscap_list_add(list, cvrf_revision_parse(reader));
 		} else if (item_type == CVRF_NOTE || item_type == CVRF_DOCUMENT_NOTE) {
@@ -1610,7 +1610,7 @@ struct cvrf_remediation *cvrf_remediation_parse(xmlTextReaderPtr reader) {
 	remed->type = cvrf_remediation_type_parse(reader);
 	remed->date = (char *)xmlTextReaderGetAttribute(reader, TAG_DATE);
 	xmlTextReaderNextElementWE(reader, TAG_REMEDIATION);
-	while (xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_REMEDIATION) != 0) {
+	while (!xmlTextReaderFailed(reader) && xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_REMEDIATION) != 0) {
 		if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) {
 			xmlTextReaderNextNode(reader);
 			continue;
@@ -1650,7 +1650,7 @@ struct cvrf_score_set *cvrf_score_set_parse(xmlTextReaderPtr reader) {
 	__attribute__nonnull__(reader);
 	struct cvrf_score_set *score_set = cvrf_score_set_new();
 	xmlTextReaderNextElementWE(reader, TAG_SCORE_SET);
-	while (xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_SCORE_SET) != 0) {
+	while (!xmlTextReaderFailed(reader) && xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_SCORE_SET) != 0) {
 		if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) {
 			xmlTextReaderNextNode(reader);
 			continue;
@@ -1695,7 +1695,7 @@ struct cvrf_threat *cvrf_threat_parse(xmlTextReaderPtr reader) {
 	threat->type = cvrf_threat_type_parse(reader);
 	threat->date = (char *)xmlTextReaderGetAttribute(reader, TAG_DATE);
 	xmlTextReaderNextElementWE(reader, TAG_THREAT);
-	while (xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_THREAT) != 0) {
+	while (!xmlTextReaderFailed(reader) && xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_THREAT) != 0) {
 		if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) {
 			xmlTextReaderNextNode(reader);
 			continue;
@@ -1730,7 +1730,7 @@ struct cvrf_product_status *cvrf_product_status_parse(xmlTextReaderPtr reader) {
 	struct cvrf_product_status *stat = cvrf_product_status_new();
 	stat->type = cvrf_product_status_type_parse(reader);
 	xmlTextReaderNextElementWE(reader, TAG_STATUS);
-	while (xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_STATUS) != 0) {
+	while (!xmlTextReaderFailed(reader) && xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_STATUS) != 0) {
 		if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) {
 			xmlTextReaderNextNode(reader);
 			continue;
@@ -1799,7 +1799,7 @@ struct cvrf_vulnerability *cvrf_vulnerability_parse(xmlTextReaderPtr reader) {
 	struct cvrf_vulnerability *vuln = cvrf_vulnerability_new();
 	vuln->ordinal = cvrf_parse_ordinal(reader);
 	xmlTextReaderNextElementWE(reader, TAG_VULNERABILITY);
-	while (xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_VULNERABILITY) != 0) {
+	while (!xmlTextReaderFailed(reader) && xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_VULNERABILITY) != 0) {
 		if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) {
 			xmlTextReaderNextNode(reader);
 			continue;
@@ -1894,7 +1894,7 @@ struct cvrf_group *cvrf_group_parse(xmlTextReaderPtr reader) {
 	struct cvrf_group *group = cvrf_group_new();
 	group->group_id = (char *)xmlTextReaderGetAttribute(reader, TAG_GROUP_ID);
 	xmlTextReaderNextElementWE(reader, TAG_GROUP);
-	while (xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_GROUP) != 0) {
+	while (!xmlTextReaderFailed(reader) && xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_GROUP) != 0) {
 		if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) {
 			xmlTextReaderNextNode(reader);
 			continue;
@@ -1952,7 +1952,7 @@ struct cvrf_branch *cvrf_branch_parse(xmlTextReaderPtr reader) {
 		xmlTextReaderNextNode(reader);
 		xmlTextReaderNextNode(reader);
 	} else {
-		while(xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_BRANCH) == 0) {
+		while(!xmlTextReaderFailed(reader) && xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_BRANCH) == 0) {
 			if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) {
 				xmlTextReaderNextNode(reader);
 				continue;
@@ -1989,7 +1989,7 @@ struct cvrf_product_tree *cvrf_product_tree_parse(xmlTextReaderPtr reader) {
 		return NULL;
 	}
 	xmlTextReaderNextElementWE(reader, TAG_PRODUCT_TREE);
-	while (xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_PRODUCT_TREE) != 0) {
+	while (!xmlTextReaderFailed(reader) && xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_PRODUCT_TREE) != 0) {
 		if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) {
 			xmlTextReaderNextNode(reader);
 			continue;
@@ -1998,7 +1998,7 @@ struct cvrf_product_tree *cvrf_product_tree_parse(xmlTextReaderPtr reader) {
 			if (!oscap_list_add(tree->product_names, cvrf_product_name_parse(reader)))
 				cvrf_set_parsing_error("FullProductName");
 		} else if (!xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_BRANCH)) {
-			while(xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_BRANCH) == 0) {
+			while(!xmlTextReaderFailed(reader) && xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_BRANCH) == 0) {
 				if (!oscap_list_add(tree->branches, cvrf_branch_parse(reader)))
 					cvrf_set_parsing_error("Branch");
 			}
@@ -2028,7 +2028,7 @@ struct cvrf_acknowledgment *cvrf_acknowledgment_parse(xmlTextReaderPtr reader) {
 	__attribute__nonnull__(reader);
 	struct cvrf_acknowledgment *ack = cvrf_acknowledgment_new();
 	xmlTextReaderNextElementWE(reader, TAG_ACKNOWLEDGMENT);
-	while (xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_ACKNOWLEDGMENT) != 0) {
+	while (!xmlTextReaderFailed(reader) && xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_ACKNOWLEDGMENT) != 0) {
 		if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) {
 			xmlTextReaderNextNode(reader);
 			continue;
@@ -2062,7 +2062,7 @@ struct cvrf_reference *cvrf_reference_parse(xmlTextReaderPtr reader) {
 	struct cvrf_reference *ref = cvrf_reference_new();
 	ref->type = cvrf_reference_type_parse(reader);
 	xmlTextReaderNextElementWE(reader, TAG_REFERENCE);
-	while (xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_REFERENCE) != 0) {
+	while (!xmlTextReaderFailed(reader) && xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_REFERENCE) != 0) {
 		if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) {
 			xmlTextReaderNextNode(reader);
 			continue;
@@ -2119,7 +2119,7 @@ struct cvrf_revision *cvrf_revision_parse(xmlTextReaderPtr reader) {
 	__attribute__nonnull__(reader);
 	struct cvrf_revision *revision = cvrf_revision_new();
 	xmlTextReaderNextElementWE(reader, TAG_REVISION);
-	while (xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_REVISION) != 0) {
+	while (!xmlTextReaderFailed(reader) && xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_REVISION) != 0) {
 		if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) {
 			xmlTextReaderNextNode(reader);
 			continue;
@@ -2155,7 +2155,7 @@ struct cvrf_doc_tracking *cvrf_doc_tracking_parse(xmlTextReaderPtr reader) {
 	}
 
 	xmlTextReaderNextElement(reader);
-	while (xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_DOCUMENT_TRACKING) != 0) {
+	while (!xmlTextReaderFailed(reader) && xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_DOCUMENT_TRACKING) != 0) {
 		if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) {
 			xmlTextReaderNextNode(reader);
 			continue;
@@ -2163,7 +2163,7 @@ struct cvrf_doc_tracking *cvrf_doc_tracking_parse(xmlTextReaderPtr reader) {
 		if (xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_IDENTIFICATION) == 0) {
 			xmlTextReaderNextElementWE(reader, TAG_IDENTIFICATION);
 			tracking->tracking_id = cvrf_parse_element(reader, "ID", false);
-			while (xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_IDENTIFICATION) != 0) {
+			while (!xmlTextReaderFailed(reader) && xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_IDENTIFICATION) != 0) {
 				if (xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_ALIAS) == 0) {
 					oscap_stringlist_add_string(tracking->aliases, cvrf_parse_element(reader, "Alias", false));
 					xmlTextReaderNextNode(reader);
@@ -2245,7 +2245,7 @@ struct cvrf_document *cvrf_document_parse(xmlTextReaderPtr reader) {
 	__attribute__nonnull__(reader);
 
 	struct cvrf_document *doc = cvrf_document_new();
-	while (xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_PRODUCT_TREE) != 0) {
+	while (!xmlTextReaderFailed(reader) && xmlStrcmp(xmlTextReaderConstLocalName(reader), TAG_PRODUCT_TREE) != 0) {
 		if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) {
 			xmlTextReaderNextNode(reader);
 			continue;
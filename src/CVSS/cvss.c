@@ -276,13 +276,13 @@ struct cvss_impact *cvss_impact_new_from_xml(xmlTextReaderPtr reader)
 
     int depth = oscap_element_depth(reader);
     struct cvss_impact *ret = cvss_impact_new();
-    xmlTextReaderRead(reader); // move to next element
+    xmlTextReaderNextNode(reader); // move to next element
 
     while (oscap_to_start_element(reader, depth + 1)) {
         struct cvss_metrics *mtx = cvss_metrics_new_from_xml(reader);
         if (mtx) cvss_impact_set_metrics(ret, mtx);
         // else issue a warning?
-        xmlTextReaderRead(reader);
+        xmlTextReaderNextNode(reader);
     }
 
     return ret;
@@ -560,18 +560,21 @@ struct cvss_metrics *cvss_metrics_new_from_xml(xmlTextReaderPtr reader)
     struct cvss_metrics *ret = cvss_metrics_new(cat);
 
     ret->upgraded_from_version = (char*) xmlTextReaderGetAttribute(reader, BAD_CAST "upgraded-from-version");
-    xmlTextReaderRead(reader);
+    xmlTextReaderNextNode(reader);
 
     while (oscap_to_start_element(reader, depth + 1)) {
         elname = (const char *) xmlTextReaderConstLocalName(reader);
-        if (oscap_streq(elname, "score")) ret->score = atof(oscap_element_string_get(reader));
+        if (oscap_streq(elname, "score")) {
+            const char *score = oscap_element_string_get(reader);
+            if (score) ret->score = atof(score);
+        }
         else if (oscap_streq(elname, "source")) cvss_metrics_set_source(ret, oscap_element_string_get(reader));
         else if (oscap_streq(elname, "generated-on-datetime")) cvss_metrics_set_generated_on_datetime(ret, oscap_element_string_get(reader));
         else {
             const struct cvss_valtab_entry *val = cvss_valtab(cvss_keytab(0, elname)->key, 0, NULL, oscap_element_string_get(reader));
             if (CVSS_CATEGORY(val->key) == cat) ret->metrics.ANY[CVSS_KEY_IDX(val->key)] = val->value;
         }
-        xmlTextReaderRead(reader);
+        xmlTextReaderNextNode(reader);
     }
 
     return ret;
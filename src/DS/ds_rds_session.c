@@ -71,6 +71,11 @@ void ds_rds_session_free(struct ds_rds_session *rds_session)
 struct rds_index *ds_rds_session_get_rds_idx(struct ds_rds_session *session)
 {
 	if (session->index == NULL) {
+		// Reports are selected from the DOM later on anyway, build it
+		// now so that the datastream is not parsed twice.
+		if (oscap_source_get_xmlDoc(session->source) == NULL) {
+			return NULL;
+		}
 		xmlTextReader *reader = oscap_source_get_xmlTextReader(session->source);
 		if (reader == NULL) {
 			return NULL;
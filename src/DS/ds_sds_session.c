@@ -53,6 +53,7 @@ struct ds_sds_session {
 	const char *checklist_uri;              ///< URI of selected checklist
 	struct oscap_htable *component_sources;	///< oscap_source for parsed components
 	struct oscap_htable *component_uris;    ///< maps component refs to component URIs
+	struct oscap_htable *component_nodes;   ///< maps component IDs to ds:component elements
 	bool fetch_remote_resources;            ///< Allows loading of external components;
 	download_progress_calllback_t progress;	///< Callback to report progress of download.
 	const char *local_files;            ///< Path to the directory where local copies of remote components are located
@@ -89,6 +90,7 @@ void ds_sds_session_free(struct ds_sds_session *sds_session)
 		}
 		oscap_htable_free(sds_session->component_sources, (oscap_destruct_func) oscap_source_free);
 		oscap_htable_free(sds_session->component_uris, (oscap_destruct_func) free);
+		oscap_htable_free0(sds_session->component_nodes);
 		free(sds_session);
 	}
 }
@@ -108,6 +110,11 @@ void ds_sds_session_reset(struct ds_sds_session *session)
 struct ds_sds_index *ds_sds_session_get_sds_idx(struct ds_sds_session *session)
 {
 	if (session->index == NULL) {
+		// Components are extracted from the DOM later on anyway, build it
+		// now so that the datastream is not parsed twice.
+		if (oscap_source_get_xmlDoc(session->source) == NULL) {
+			return NULL;
+		}
 		xmlTextReader *reader = oscap_source_get_xmlTextReader(session->source);
 		if (reader == NULL) {
 			return NULL;
@@ -194,6 +201,14 @@ const char *ds_sds_session_get_readable_origin(const struct ds_sds_session *sess
 	return oscap_source_readable_origin(session->source);
 }
 
+const char *ds_sds_session_get_digest(struct ds_sds_session *session)
+{
+	if (session->source == NULL)
+		return NULL;
+
+	return oscap_source_get_digest(session->source);
+}
+
 struct oscap_source *ds_sds_session_select_checklist(struct ds_sds_session *session, const char *datastream_id, const char *component_id, const char *benchmark_id)
 {
 	session->datastream_id = datastream_id;
@@ -268,6 +283,48 @@ xmlDoc *ds_sds_session_get_xmlDoc(struct ds_sds_session *session)
 	return oscap_source_get_xmlDoc(session->source);
 }
 
+xmlNode *ds_sds_session_get_component_by_id(struct ds_sds_session *session, const char *component_id)
+{
+	if (session->component_nodes == NULL) {
+		xmlDoc *doc = oscap_source_get_xmlDoc(session->source);
+		if (doc == NULL) {
+			return NULL;
+		}
+		session->component_nodes = oscap_htable_new();
+		xmlNode *root = xmlDocGetRootElement(doc);
+		for (xmlNode *candidate = root->children; candidate != NULL; candidate = candidate->next) {
+			if (candidate->type != XML_ELEMENT_NODE)
+				continue;
+			if (!oscap_streq((const char *) candidate->name, "component") &&
+			    !oscap_streq((const char *) candidate->name, "extended-component"))
+				continue;
+			char *id = (char *) xmlGetProp(candidate, BAD_CAST "id");
+			if (id != NULL) {
+				// the first component wins, as in lookup_component_in_collection()
+				oscap_htable_add(session->component_nodes, id, candidate);
+				xmlFree(id);
+			}
+		}
+	}
+	return oscap_htable_get(session->component_nodes, component_id);
+}
+
+int ds_sds_session_detach_components(struct ds_sds_session *session)
+{
+	int ret = 0;
+	struct oscap_htable_iterator *hit = oscap_htable_iterator_new(session->component_sources);
+	while (oscap_htable_iterator_has_more(hit)) {
+		struct oscap_source *component = oscap_htable_iterator_next_value(hit);
+		if (oscap_source_get_xmlDoc(component) == NULL) {
+			ret = -1;
+		}
+	}
+	oscap_htable_iterator_free(hit);
+	oscap_htable_free0(session->component_nodes);
+	session->component_nodes = NULL;
+	return ret;
+}
+
 int ds_sds_session_register_component_source(struct ds_sds_session *session, const char *relative_filepath, struct oscap_source *component)
 {
 	if (!oscap_htable_add(session->component_sources, relative_filepath, component)) {
@@ -32,6 +32,7 @@
 #include "common/util.h"
 #include "common/list.h"
 #include "common/debug_priv.h"
+#include "common/xml_stream.h"
 
 #include "ds_common.h"
 #include "ds_rds_session.h"
@@ -42,6 +43,8 @@
 #include "source/oscap_source_priv.h"
 
 #include <sys/stat.h>
+#include <errno.h>
+#include <stdio.h>
 #include <time.h>
 #include <string.h>
 
@@ -176,7 +179,7 @@ int ds_rds_dump_arf_content(struct ds_rds_session *session, const char *containe
 	return ds_rds_session_register_component_source(session, content_id, source);
 }
 
-xmlNodePtr ds_rds_create_report(xmlDocPtr target_doc, xmlNodePtr reports_node, xmlDocPtr source_doc, const char* report_id)
+static xmlNodePtr ds_rds_new_report(xmlDocPtr target_doc, const char* report_id)
 {
 	xmlNsPtr arf_ns = xmlSearchNsByHref(target_doc, xmlDocGetRootElement(target_doc), BAD_CAST arf_ns_uri);
 
@@ -186,16 +189,25 @@ xmlNodePtr ds_rds_create_report(xmlDocPtr target_doc, xmlNodePtr reports_node, x
 	xmlNodePtr report_content = xmlNewNode(arf_ns, BAD_CAST "content");
 	xmlAddChild(report, report_content);
 
+	return report;
+}
+
+static void ds_rds_add_report_content(xmlDocPtr target_doc, xmlNodePtr report, xmlDocPtr source_doc, xmlNodePtr source_node)
+{
 	xmlDOMWrapCtxtPtr wrap_ctxt = xmlDOMWrapNewCtxt();
 	xmlNodePtr res_node = NULL;
-	xmlDOMWrapCloneNode(wrap_ctxt, source_doc, xmlDocGetRootElement(source_doc),
+	xmlDOMWrapCloneNode(wrap_ctxt, source_doc, source_node,
 			&res_node, target_doc, NULL, 1, 0);
-	xmlAddChild(report_content, res_node);
+	xmlAddChild(report->children, res_node);
 	xmlDOMWrapReconcileNamespaces(wrap_ctxt, res_node, 0);
 	xmlDOMWrapFreeCtxt(wrap_ctxt);
+}
 
+xmlNodePtr ds_rds_create_report(xmlDocPtr target_doc, xmlNodePtr reports_node, xmlDocPtr source_doc, const char* report_id)
+{
+	xmlNodePtr report = ds_rds_new_report(target_doc, report_id);
+	ds_rds_add_report_content(target_doc, report, source_doc, xmlDocGetRootElement(source_doc));
 	xmlAddChild(reports_node, report);
-
 	return report;
 }
 
@@ -661,17 +673,32 @@ static void ds_rds_add_xccdf_test_results(xmlDocPtr doc, xmlNodePtr reports,
 	}
 }
 
+/* Finish the streamed ARF, an incomplete one is removed. */
+static int _ds_rds_stream_close(xmlDocPtr doc, const char *target_file, bool failed)
+{
+	int saved = oscap_xml_stream_close(doc);
+	if ((failed || saved != 1) && strcmp(target_file, "-") != 0) {
+		if (remove(target_file) != 0)
+			dW("Can't remove the incomplete ARF '%s': %s", target_file, strerror(errno));
+	}
+	return failed ? -1 : saved;
+}
+
 static int _ds_rds_create_from_dom(xmlDocPtr *ret, xmlDocPtr sds_doc,
 		xmlDocPtr tailoring_doc, const char *tailoring_filepath,
 		char *tailoring_doc_timestamp, xmlDocPtr xccdf_result_file_doc,
 		struct oscap_htable *oval_result_sources,
 		struct oscap_htable *oval_result_mapping,
 		struct oscap_htable *arf_report_mapping,
-		bool clone)
+		bool clone, const char *target_file)
 {
 	*ret = NULL;
 
 	xmlDocPtr doc = xmlNewDoc(BAD_CAST "1.0");
+	if (target_file != NULL && !oscap_xml_stream_open(doc, target_file)) {
+		xmlFreeDoc(doc);
+		return -1;
+	}
 	xmlNodePtr root = xmlNewNode(NULL, BAD_CAST "asset-report-collection");
 	xmlDocSetRootElement(doc, root);
 
@@ -762,6 +789,9 @@ static int _ds_rds_create_from_dom(xmlDocPtr *ret, xmlDocPtr sds_doc,
 					"This is most likely an internal error!.",
 					xlink_ns_uri);
 			free(tailoring_component_id);
+			if (target_file != NULL)
+				_ds_rds_stream_close(doc, target_file, true);
+			xmlFreeDoc(doc);
 			return -1;
 		}
 		char *tailoring_cref_href = oscap_sprintf("#%s", tailoring_component_id);
@@ -779,9 +809,12 @@ static int _ds_rds_create_from_dom(xmlDocPtr *ret, xmlDocPtr sds_doc,
 	xmlAddChild(report_requests, report_request);
 
 	xmlNodePtr reports = xmlNewNode(arf_ns, BAD_CAST "reports");
+	xmlAddChild(root, reports);
 
 	ds_rds_add_xccdf_test_results(doc, reports, xccdf_result_file_doc,
 			relationships, assets, "collection1", arf_report_mapping);
+	// The relationships and assets are complete now
+	oscap_xml_stream_flush(doc, reports);
 
 	struct oscap_htable_iterator *hit = oscap_htable_iterator_new(arf_report_mapping);
 	while (oscap_htable_iterator_has_more(hit)) {
@@ -790,13 +823,28 @@ static int _ds_rds_create_from_dom(xmlDocPtr *ret, xmlDocPtr sds_doc,
 		const char *report_id = report_mapping_item->value;
 		const char *report_file = oscap_htable_get(oval_result_mapping, oval_filename);
 		struct oscap_source *oval_source = oscap_htable_get(oval_result_sources, report_file);
-		xmlDoc *oval_result_doc = oscap_source_get_xmlDoc(oval_source);
 
-		ds_rds_create_report(doc, reports, oval_result_doc, report_id);
+		if (target_file != NULL && oscap_source_is_unparsed_file(oval_source)) {
+			// Copy the results file into the ARF without parsing it
+			xmlNodePtr report = ds_rds_new_report(doc, report_id);
+			xmlAddChild(reports, report);
+			if (!oscap_xml_stream_copy_file(doc, report->children, oscap_source_get_filepath(oval_source))) {
+				xmlDoc *oval_result_doc = oscap_source_get_xmlDoc(oval_source);
+				ds_rds_add_report_content(doc, report, oval_result_doc, xmlDocGetRootElement(oval_result_doc));
+			}
+		} else {
+			xmlDoc *oval_result_doc = oscap_source_get_xmlDoc(oval_source);
+			ds_rds_create_report(doc, reports, oval_result_doc, report_id);
+		}
+		oscap_xml_stream_flush(doc, reports);
 	}
 	oscap_htable_iterator_free(hit);
 
-	xmlAddChild(root, reports);
+	if (target_file != NULL) {
+		int saved = _ds_rds_stream_close(doc, target_file, false);
+		xmlFreeDoc(doc);
+		return saved == 1 ? 0 : -1;
+	}
 
 	*ret = doc;
 	return 0;
@@ -812,7 +860,21 @@ int ds_rds_create_from_dom(xmlDocPtr *ret, xmlDocPtr sds_doc,
 	return _ds_rds_create_from_dom(ret, sds_doc, tailoring_doc,
 			tailoring_filepath, tailoring_doc_timestamp,
 			xccdf_result_file_doc, oval_result_sources, oval_result_mapping,
-			arf_report_mapping, false);
+			arf_report_mapping, false, NULL);
+}
+
+int ds_rds_export_from_dom(const char *target_file, xmlDocPtr sds_doc,
+		xmlDocPtr tailoring_doc, const char *tailoring_filepath,
+		char *tailoring_doc_timestamp, xmlDocPtr xccdf_result_file_doc,
+		struct oscap_htable *oval_result_sources,
+		struct oscap_htable *oval_result_mapping,
+		struct oscap_htable *arf_report_mapping)
+{
+	xmlDocPtr doc = NULL;
+	return _ds_rds_create_from_dom(&doc, sds_doc, tailoring_doc,
+			tailoring_filepath, tailoring_doc_timestamp,
+			xccdf_result_file_doc, oval_result_sources, oval_result_mapping,
+			arf_report_mapping, false, target_file);
 }
 
 static int ds_rds_create_from_dom_clone(xmlDocPtr *ret, xmlDocPtr sds_doc,
@@ -825,7 +887,7 @@ static int ds_rds_create_from_dom_clone(xmlDocPtr *ret, xmlDocPtr sds_doc,
 	return _ds_rds_create_from_dom(ret, sds_doc, tailoring_doc,
 			tailoring_filepath, tailoring_doc_timestamp,
 			xccdf_result_file_doc, oval_result_sources, oval_result_mapping,
-			arf_report_mapping, true);
+			arf_report_mapping, true, NULL);
 }
 
 struct oscap_source *ds_rds_create_source(struct oscap_source *sds_source, struct oscap_source *tailoring_source, struct oscap_source *xccdf_result_source, struct oscap_htable *oval_result_sources, struct oscap_htable *oval_result_mapping, struct oscap_htable *arf_report_mapping, const char *target_file)
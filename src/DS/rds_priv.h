@@ -40,4 +40,11 @@ struct oscap_source *ds_rds_create_source(struct oscap_source *sds_source, struc
 xmlNodePtr ds_rds_create_report(xmlDocPtr target_doc, xmlNodePtr reports_node, xmlDocPtr source_doc, const char* report_id);
 
 int ds_rds_create_from_dom(xmlDocPtr* ret, xmlDocPtr sds_doc, xmlDocPtr tailoring_doc, const char* tailoring_filepath, char *tailoring_doc_timestamp, xmlDocPtr xccdf_result_file_doc, struct oscap_htable* oval_result_sources, struct oscap_htable* oval_result_mapping, struct oscap_htable *arf_report_mapping);
+
+/*
+ * Same as ds_rds_create_from_dom(), but the ARF is written to the target file
+ * as it is being built. OVAL results which haven't been parsed are copied from
+ * their files as they are. Returns 0 on success, -1 otherwise.
+ */
+int ds_rds_export_from_dom(const char *target_file, xmlDocPtr sds_doc, xmlDocPtr tailoring_doc, const char* tailoring_filepath, char *tailoring_doc_timestamp, xmlDocPtr xccdf_result_file_doc, struct oscap_htable* oval_result_sources, struct oscap_htable* oval_result_mapping, struct oscap_htable *arf_report_mapping);
 #endif
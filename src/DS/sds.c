@@ -40,6 +40,7 @@
 #include "common/util.h"
 #include "common/list.h"
 #include "common/oscap_acquire.h"
+#include "common/oscap_model_cache.h"
 #include "source/oscap_source_priv.h"
 #include "source/public/oscap_source.h"
 #include "oscap_helpers.h"
@@ -239,15 +240,30 @@ static int ds_sds_register_sce(struct ds_sds_session *session, xmlNodePtr compon
 	return ret;
 }
 
-static int ds_sds_register_xmlDoc(struct ds_sds_session *session, xmlDoc* doc, xmlNodePtr component_inner_root, const char *relative_filepath)
+static int ds_sds_register_xmlDoc(struct ds_sds_session *session, xmlDoc* doc, xmlNodePtr component_inner_root, const char* component_id, const char *relative_filepath)
 {
-	xmlDoc *new_doc = ds_doc_from_foreign_node(component_inner_root, doc);
-	if (new_doc == NULL) {
-		return -1;
+	struct oscap_source *component_source;
+	if (doc == ds_sds_session_get_xmlDoc(session)) {
+		// The datastream lives as long as the session, the component is
+		// copied out of it only when somebody really reads it.
+		component_source = oscap_source_new_from_foreign_node(component_inner_root, doc, relative_filepath);
+
+		// The component is identified by the datastream and its ID, so
+		// models built from it can be found in the model cache.
+		const char *digest = oscap_model_cache_enabled() ? ds_sds_session_get_digest(session) : NULL;
+		if (digest != NULL) {
+			char *component_digest = oscap_sprintf("%s#%s", digest, component_id);
+			oscap_source_set_digest(component_source, component_digest);
+			free(component_digest);
+		}
+	} else {
+		xmlDoc *new_doc = ds_doc_from_foreign_node(component_inner_root, doc);
+		if (new_doc == NULL) {
+			return -1;
+		}
+		component_source = oscap_source_new_from_xmlDoc(new_doc, relative_filepath);
 	}
 
-	struct oscap_source *component_source = oscap_source_new_from_xmlDoc(new_doc, relative_filepath);
-
 	if (ds_sds_session_register_component_source(session, relative_filepath, component_source) != 0) {
 		oscap_source_free(component_source);
 	}
@@ -269,7 +285,7 @@ static int ds_sds_register_component(struct ds_sds_session *session, xmlDoc* doc
 		// Otherwise we create a new XML doc we will dump the contents to.
 		// We can't just dump node "innerXML" because namespaces have to be
 		// handled.
-		return ds_sds_register_xmlDoc(session, doc, component_inner_root, relative_filepath);
+		return ds_sds_register_xmlDoc(session, doc, component_inner_root, component_id, relative_filepath);
 	}
 }
 
@@ -294,8 +310,16 @@ static xmlNodePtr ds_sds_get_component_root_by_id(xmlDoc *doc, const char* compo
 static int ds_sds_dump_local_component(const char* component_id, struct ds_sds_session *session, const char *target_filename_dirname, const char *relative_filepath)
 {
 	xmlDoc *doc = ds_sds_session_get_xmlDoc(session);
+	if (doc == NULL) {
+		return -1;
+	}
 
-	xmlNodePtr inner_root = ds_sds_get_component_root_by_id(doc, component_id);
+	xmlNodePtr component = ds_sds_session_get_component_by_id(session, component_id);
+	if (component == NULL) {
+		oscap_seterr(OSCAP_EFAMILY_XML, "Component of given id '%s' was not found in the document.", component_id);
+		return -1;
+	}
+	xmlNodePtr inner_root = node_get_child_element(component, NULL);
 
 	return ds_sds_register_component(session, doc, inner_root, component_id, target_filename_dirname, relative_filepath);
 }
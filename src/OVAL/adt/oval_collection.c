@@ -31,6 +31,8 @@
 #include <config.h>
 #endif
 
+#include <assert.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
 
@@ -42,17 +44,35 @@
 /* Variable definitions
  * */
 
-typedef struct _oval_collection_item_frame {
-	struct _oval_collection_item_frame *next;
-	void *item;
-} _oval_collection_item_frame_t;
+/*
+ * Items are kept in an array in the order in which they were added.
+ * Iterators over a collection borrow the array, they don't copy it.
+ * Membership of items is looked up in a set of pointers, which is built
+ * once the collection is queried and has enough items.
+ */
+#define OVAL_COLLECTION_ALLOC_MIN 4
+#define OVAL_COLLECTION_SET_MIN   16
 
 typedef struct oval_collection {
-	struct _oval_collection_item_frame *item_collection_frame;
+	void **items;
+	size_t count;
+	size_t alloc;
+	void **set;		/* open addressing set of the items, NULL if not built */
+	size_t set_size;	/* a power of 2 */
 } oval_collection_t;
 
+/*
+ * An iterator either walks a collection, or it's a stack of items
+ * created by oval_collection_iterator_new() and filled by
+ * oval_collection_iterator_add().
+ */
 typedef struct oval_iterator {
-	struct _oval_collection_item_frame *item_iterator_frame;
+	struct oval_collection *collection;
+	size_t pos;
+	size_t end;		/* items added to the collection later are not iterated */
+	void **stack;
+	size_t stack_count;
+	size_t stack_alloc;
 } oval_iterator_t;
 
 /* End of variable definitions
@@ -61,11 +81,10 @@ typedef struct oval_iterator {
 
 struct oval_collection *oval_collection_new()
 {
-	struct oval_collection *collection = (struct oval_collection *)malloc(sizeof(oval_collection_t));
+	struct oval_collection *collection = (struct oval_collection *)calloc(1, sizeof(oval_collection_t));
 	if (collection == NULL)
 		return NULL;
 
-	collection->item_collection_frame = NULL;
 	return collection;
 }
 
@@ -77,19 +96,17 @@ void oval_collection_free(struct oval_collection *collection)
 void oval_collection_free_items(struct oval_collection *collection, oscap_destruct_func free_func)
 {
 	if (collection) {
-		struct _oval_collection_item_frame *frame = collection->item_collection_frame;
-		while (frame != NULL) {
-			if (free_func != NULL) {
-				void *item = frame->item;
+		if (free_func != NULL) {
+			/* the most recently added items go first */
+			size_t i = collection->count;
+			while (i-- > 0) {
+				void *item = collection->items[i];
 				if (item)
 					(*free_func) (item);
-				frame->item = NULL;
 			}
-			struct _oval_collection_item_frame *temp = frame;
-			frame = frame->next;
-			temp->next = NULL;
-			free(temp);
 		}
+		free(collection->items);
+		free(collection->set);
 		free(collection);
 	}
 }
@@ -97,42 +114,125 @@ void oval_collection_free_items(struct oval_collection *collection, oscap_destru
 int oval_collection_is_empty(struct oval_collection *collection)
 {
 	__attribute__nonnull__(collection);
-	return collection->item_collection_frame == NULL;
+	return collection->count == 0;
+}
+
+static inline size_t _oval_collection_set_slot(const struct oval_collection *collection, const void *item)
+{
+	uintptr_t h = (uintptr_t)item;
+
+	h ^= h >> 4;
+	h *= (uintptr_t)0x9e3779b97f4a7c15ULL;
+	h ^= h >> 29;
+	return h & (collection->set_size - 1);
+}
+
+static void _oval_collection_set_insert(struct oval_collection *collection, void *item)
+{
+	size_t slot = _oval_collection_set_slot(collection, item);
+
+	while (collection->set[slot] != NULL) {
+		if (collection->set[slot] == item)
+			return;
+		slot = (slot + 1) & (collection->set_size - 1);
+	}
+	collection->set[slot] = item;
+}
+
+/* keep the set at most half full */
+static bool _oval_collection_set_build(struct oval_collection *collection, size_t count)
+{
+	size_t set_size = OVAL_COLLECTION_SET_MIN * 2;
+	void **set;
+
+	while (set_size < count * 2)
+		set_size *= 2;
+
+	set = calloc(set_size, sizeof(void *));
+	if (set == NULL)
+		return false;
+
+	free(collection->set);
+	collection->set = set;
+	collection->set_size = set_size;
+	for (size_t i = 0; i < collection->count; ++i) {
+		if (collection->items[i] != NULL)
+			_oval_collection_set_insert(collection, collection->items[i]);
+	}
+	return true;
 }
 
 void oval_collection_add(struct oval_collection *collection, void *item)
 {
 	__attribute__nonnull__(collection);
 
-	struct _oval_collection_item_frame *next = malloc(sizeof(_oval_collection_item_frame_t));
-	if (next == NULL)
-		return;
+	if (collection->count == collection->alloc) {
+		size_t alloc = collection->alloc > 0 ? collection->alloc * 2 : OVAL_COLLECTION_ALLOC_MIN;
+		void **items = realloc(collection->items, alloc * sizeof(void *));
+		if (items == NULL)
+			return;
+		collection->items = items;
+		collection->alloc = alloc;
+	}
+	collection->items[collection->count++] = item;
+
+	if (collection->set != NULL && item != NULL) {
+		if (collection->count * 2 > collection->set_size) {
+			if (!_oval_collection_set_build(collection, collection->count)) {
+				/* fall back to the linear search */
+				free(collection->set);
+				collection->set = NULL;
+			}
+		} else {
+			_oval_collection_set_insert(collection, item);
+		}
+	}
+}
+
+bool oval_collection_contains(struct oval_collection *collection, const void *item)
+{
+	__attribute__nonnull__(collection);
+
+	if (item == NULL)
+		return false;
+
+	if (collection->set == NULL && collection->count >= OVAL_COLLECTION_SET_MIN)
+		_oval_collection_set_build(collection, collection->count);
+
+	if (collection->set == NULL) {
+		for (size_t i = 0; i < collection->count; ++i) {
+			if (collection->items[i] == item)
+				return true;
+		}
+		return false;
+	}
 
-	next->next = collection->item_collection_frame;
-	collection->item_collection_frame = next;
-	next->item = item;
+	size_t slot = _oval_collection_set_slot(collection, item);
+	while (collection->set[slot] != NULL) {
+		if (collection->set[slot] == item)
+			return true;
+		slot = (slot + 1) & (collection->set_size - 1);
+	}
+	return false;
+}
+
+void *oval_collection_last(struct oval_collection *collection)
+{
+	__attribute__nonnull__(collection);
+
+	return collection->count > 0 ? collection->items[collection->count - 1] : NULL;
 }
 
 struct oval_iterator *oval_collection_iterator(struct oval_collection *collection)
 {
 	__attribute__nonnull__(collection);
 
-	struct oval_iterator *iterator = (struct oval_iterator *)malloc(sizeof(oval_iterator_t));
+	struct oval_iterator *iterator = (struct oval_iterator *)calloc(1, sizeof(oval_iterator_t));
 	if (iterator == NULL)
 		return NULL;
 
-	iterator->item_iterator_frame = NULL;
-	struct _oval_collection_item_frame *collection_frame = collection->item_collection_frame;
-
-	while (collection_frame != NULL) {
-		struct _oval_collection_item_frame *iterator_frame =
-		    (struct _oval_collection_item_frame *)malloc(sizeof(_oval_collection_item_frame_t));
-
-		iterator_frame->next = iterator->item_iterator_frame;
-		iterator_frame->item = collection_frame->item;
-		iterator->item_iterator_frame = iterator_frame;
-		collection_frame = collection_frame->next;
-	}
+	iterator->collection = collection;
+	iterator->end = collection->count;
 	return iterator;
 }
 
@@ -140,79 +240,66 @@ bool oval_collection_iterator_has_more(struct oval_iterator * iterator)
 {
 	__attribute__nonnull__(iterator);
 
-	return iterator->item_iterator_frame != NULL;
+	if (iterator->collection != NULL)
+		return iterator->pos < iterator->end;
+	return iterator->stack_count > 0;
 }
 
 int oval_collection_iterator_remaining(struct oval_iterator *iterator)
 {
 	__attribute__nonnull__(iterator);
 
-	int remaining;
-	struct _oval_collection_item_frame *next = iterator->item_iterator_frame;
-
-	for (remaining = 0; next; remaining++)
-		next = next->next;
-
-	return remaining;
+	if (iterator->collection != NULL)
+		return (int)(iterator->end - iterator->pos);
+	return (int)iterator->stack_count;
 }
 
 void *oval_collection_iterator_next(struct oval_iterator *iterator)
 {
 	__attribute__nonnull__(iterator);
 
-	struct _oval_collection_item_frame *oc_next = iterator->item_iterator_frame;
-	void *next;
-
-	if (oc_next == NULL) {
-		next = NULL;
-	} else {
-		next = oc_next->item;
-		iterator->item_iterator_frame = oc_next->next;
-		oc_next->item = NULL;
-		oc_next->next = NULL;
-		free(oc_next);
+	if (iterator->collection != NULL) {
+		if (iterator->pos >= iterator->end)
+			return NULL;
+		return iterator->collection->items[iterator->pos++];
 	}
-	return next;
+	if (iterator->stack_count == 0)
+		return NULL;
+	return iterator->stack[--iterator->stack_count];
 }
 
 void oval_collection_iterator_free(struct oval_iterator *iterator)
 {
 	if (iterator) {		//NOOP if iterator is NULL
-		while (iterator->item_iterator_frame) {
-			struct _oval_collection_item_frame *oc_this;
-			oc_this = iterator->item_iterator_frame;
-			iterator->item_iterator_frame = oc_this->next;
-			oc_this->item = NULL;
-			oc_this->next = NULL;
-			free(oc_this);
-		}
-		iterator->item_iterator_frame = NULL;
+		free(iterator->stack);
 		free(iterator);
 	}
 }
 
 struct oval_iterator *oval_collection_iterator_new()
 {
-	struct oval_iterator *iterator = (struct oval_iterator *)malloc(sizeof(oval_iterator_t));
+	struct oval_iterator *iterator = (struct oval_iterator *)calloc(1, sizeof(oval_iterator_t));
 	if (iterator == NULL)
 		return NULL;
 
-	iterator->item_iterator_frame = NULL;
 	return iterator;
 }
 
 void oval_collection_iterator_add(struct oval_iterator *iterator, void *item)
 {
 	__attribute__nonnull__(iterator);
-
-	struct _oval_collection_item_frame *newframe =
-	    (struct _oval_collection_item_frame *)malloc(sizeof(_oval_collection_item_frame_t));
-	if (newframe == NULL)	/* We don't have any information that error occurred ! */
-		return;
-
-	newframe->next = iterator->item_iterator_frame;
-	newframe->item = item;
-	iterator->item_iterator_frame = newframe;
+	assert(iterator->collection == NULL);
+
+	/* the most recently added item is returned first */
+	if (iterator->stack_count == iterator->stack_alloc) {
+		size_t alloc = iterator->stack_alloc > 0 ? iterator->stack_alloc * 2 : OVAL_COLLECTION_ALLOC_MIN;
+		void **stack = realloc(iterator->stack, alloc * sizeof(void *));
+		if (stack == NULL)	/* We don't have any information that error occurred ! */
+			return;
+		iterator->stack = stack;
+		iterator->stack_alloc = alloc;
+	}
+	iterator->stack[iterator->stack_count++] = item;
 }
 
 bool oval_string_iterator_has_more(struct oval_string_iterator * iterator)
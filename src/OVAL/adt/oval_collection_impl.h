@@ -40,6 +40,21 @@ void oval_collection_free(struct oval_collection *);
 void oval_collection_free_items(struct oval_collection *, oscap_destruct_func);
 int oval_collection_is_empty(struct oval_collection *collection);
 void oval_collection_add(struct oval_collection *, void *);
+/**
+ * Check whether the item has been added to the collection. Large
+ * collections build a set of their items to answer this.
+ */
+bool oval_collection_contains(struct oval_collection *, const void *);
+/**
+ * Get the most recently added item, NULL if the collection is empty.
+ */
+void *oval_collection_last(struct oval_collection *);
+/**
+ * Iterate the items of the collection in the order in which they were added.
+ * The iterator doesn't copy the items, the collection has to outlive it.
+ * Items added to the collection after the iterator was created are not
+ * iterated.
+ */
 struct oval_iterator *oval_collection_iterator(struct oval_collection *);
 struct oval_iterator *oval_collection_iterator_new(void);
 void oval_collection_iterator_add(struct oval_iterator *, void *);
@@ -68,17 +68,8 @@ void oval_smc_put_last_if_not_exists(struct oval_smc *map, const char *key, void
 			oval_string_map_put((struct oval_string_map *) map, key, list_col);
 		}
 
-		struct oval_iterator *list_it = oval_collection_iterator(list_col);
-		bool found = false;
-		while (!found && oval_collection_iterator_has_more(list_it)) {
-			if (item == oval_collection_iterator_next(list_it)) {
-				found = true;
-			}
-		}
-		oval_collection_iterator_free(list_it);
-		if (!found) {
+		if (!oval_collection_contains(list_col, item))
 			oval_collection_add(list_col, item);
-		}
 	}
 }
 
@@ -90,15 +81,8 @@ struct oval_iterator *oval_smc_get_all_it(struct oval_smc *map, const char *key)
 
 void *oval_smc_get_last(struct oval_smc *map, const char *key)
 {
-	struct oval_iterator *list_it = oval_smc_get_all_it(map, key);
-	if (list_it == NULL)
-		return NULL;
-	void *found = NULL;
-	while (oval_collection_iterator_has_more(list_it)) {
-		found = oval_collection_iterator_next(list_it);
-	}
-	oval_collection_iterator_free(list_it);
-	return found;
+	struct oval_collection *col = _oval_smc_get_all(map, key);
+	return (col == NULL) ? NULL : oval_collection_last(col);
 }
 
 void oval_smc_free0(struct oval_smc *map)
@@ -73,6 +73,9 @@ static void _var_collect_var_refs(struct oval_variable *var, struct oval_string_
 	char *var_id;
 
 	var_id = oval_variable_get_id(var);
+	/* already collected, with all the variables it references */
+	if (oval_string_map_get_value(vm, var_id) != NULL)
+		return;
 	oval_string_map_put(vm, var_id, var);
 
 	if (oval_variable_get_type(var) == OVAL_VARIABLE_LOCAL) {
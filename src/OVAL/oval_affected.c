@@ -236,3 +236,19 @@ int oval_affected_parse_tag(xmlTextReaderPtr reader, struct oval_parser_context
 	return oval_parser_parse_tag(reader, context, &_oval_affected_parse_tag, affected);
 }
 
+
+void oval_affected_cache_write(struct oscap_model_writer *writer, struct oval_affected *affected)
+{
+	oscap_model_write_u32(writer, affected->family);
+	oval_collection_cache_write(writer, affected->platforms, oval_string_cache_write);
+	oval_collection_cache_write(writer, affected->products, oval_string_cache_write);
+}
+
+struct oval_affected *oval_affected_cache_read(struct oscap_model_reader *reader, struct oval_definition_model *model)
+{
+	struct oval_affected *affected = oval_affected_new(model);
+	affected->family = oscap_model_read_u32(reader);
+	oval_collection_cache_read(reader, model, affected->platforms, oval_string_cache_read);
+	oval_collection_cache_read(reader, model, affected->products, oval_string_cache_read);
+	return affected;
+}
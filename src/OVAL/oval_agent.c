@@ -177,6 +177,10 @@ int oval_agent_eval_definition(oval_agent_session_t *ag_sess, const char *id)
 	struct oval_result_system *rsystem;
 
 	rsystem = _oval_agent_get_first_result_system(ag_sess);
+	/* probe objects of independent tests concurrently */
+	struct oval_definition *definition = oval_definition_model_get_definition(ag_sess->def_model, id);
+	if (definition != NULL)
+		oval_probe_query_definition(ag_sess->psess, definition);
 	/* eval */
 	ret = oval_result_system_eval_definition(rsystem, id);
 	return ret;
@@ -277,6 +281,9 @@ int oval_agent_eval_system(oval_agent_session_t * ag_sess, agent_reporter cb, vo
 	int ret = 0;
 
 	dI("OVAL agent started to evaluate OVAL definitions on your system.");
+#if defined(OVAL_PROBES_ENABLED)
+	oval_probe_query_definition_model(ag_sess->psess, ag_sess->def_model);
+#endif
 	oval_def_it = oval_definition_model_get_definitions(ag_sess->def_model);
 	while (oval_definition_iterator_has_more(oval_def_it)) {
 		oval_def = oval_definition_iterator_next(oval_def_it);
@@ -574,6 +581,9 @@ oval_agent_eval_multi_check(oval_agent_session_t *sess)
 		// better to report error.
 		final_result = XCCDF_RESULT_ERROR;
 	}
+#if defined(OVAL_PROBES_ENABLED)
+	oval_probe_query_definition_model(sess->psess, sess->def_model);
+#endif
 	while (oval_definition_iterator_has_more(oval_def_it)) {
 		oval_def = oval_definition_iterator_next(oval_def_it);
 		id = oval_definition_get_id(oval_def);
@@ -626,11 +636,44 @@ xccdf_test_result_type_t oval_agent_eval_rule(struct xccdf_policy *policy, const
         }
 }
 
+#if defined(OVAL_PROBES_ENABLED)
+static void _oval_agent_prefetch(struct oval_agent_session *sess, struct xccdf_check_iterator *check_it)
+{
+	struct oval_collection *definitions = oval_collection_new();
+
+	while (xccdf_check_iterator_has_more(check_it)) {
+		struct xccdf_check *check = xccdf_check_iterator_next(check_it);
+		struct xccdf_check_content_ref_iterator *content_it = xccdf_check_get_content_refs(check);
+		while (xccdf_check_content_ref_iterator_has_more(content_it)) {
+			struct xccdf_check_content_ref *content = xccdf_check_content_ref_iterator_next(content_it);
+			const char *name = xccdf_check_content_ref_get_name(content);
+			if (name == NULL || oscap_strcmp(sess->filename, xccdf_check_content_ref_get_href(content)))
+				continue;
+			struct oval_definition *definition = oval_definition_model_get_definition(sess->def_model, name);
+			if (definition != NULL)
+				oval_collection_add(definitions, definition);
+		}
+		xccdf_check_content_ref_iterator_free(content_it);
+	}
+
+	struct oval_definition_iterator *def_itr = (struct oval_definition_iterator *) oval_collection_iterator(definitions);
+	oval_probe_query_definitions(sess->psess, def_itr);
+	oval_definition_iterator_free(def_itr);
+	oval_collection_free(definitions);
+}
+#endif
+
 static void *
 _oval_agent_list_definitions(void *usr, xccdf_policy_engine_query_t query_type, void *query_data)
 {
 	__attribute__nonnull__(usr);
 	struct oval_agent_session *sess = (struct oval_agent_session *) usr;
+	if (query_type == POLICY_ENGINE_QUERY_PREFETCH) {
+#if defined(OVAL_PROBES_ENABLED)
+		_oval_agent_prefetch(sess, query_data);
+#endif
+		return NULL;
+	}
 	if (query_data != NULL && strcmp(sess->filename, (const char *) query_data)) {
 		return NULL;
 	}
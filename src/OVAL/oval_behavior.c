@@ -152,3 +152,17 @@ int oval_behavior_parse_tag(xmlTextReaderPtr reader,
 	return 0;
 }
 
+
+void oval_behavior_cache_write(struct oscap_model_writer *writer, struct oval_behavior *behavior)
+{
+	oscap_model_write_string(writer, behavior->key);
+	oscap_model_write_string(writer, behavior->value);
+}
+
+struct oval_behavior *oval_behavior_cache_read(struct oscap_model_reader *reader, struct oval_definition_model *model)
+{
+	struct oval_behavior *behavior = oval_behavior_new(model);
+	behavior->key = oscap_model_read_string(reader);
+	behavior->value = oscap_model_read_string(reader);
+	return behavior;
+}
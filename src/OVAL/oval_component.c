@@ -55,8 +55,8 @@
 #include "common/debug_priv.h"
 #include "common/_error.h"
 #include "common/oscap_string.h"
+#include "common/oscap_pcre.h"
 #include "oval_glob_to_regex.h"
-#include <pcre.h>
 
 #if !defined(OVAL_PROBES_ENABLED)
 const char *oval_subtype_to_str(oval_subtype_t subtype);
@@ -1977,12 +1977,11 @@ static long unsigned int _parse_fmt_sse(char *dt)
 static bool _match(const char *pattern, const char *string)
 {
 	bool match = false;
-	pcre *re;
-	const char *error;
-	int erroffset = -1, ovector[60], ovector_len = sizeof (ovector) / sizeof (ovector[0]);
-	re = pcre_compile(pattern, PCRE_UTF8, &error, &erroffset, NULL);
-	match = (pcre_exec(re, NULL, string, strlen(string), 0, 0, ovector, ovector_len) >= 0);
-	pcre_free(re);
+	oscap_pcre_t *re;
+	int ovector[60], ovector_len = sizeof (ovector) / sizeof (ovector[0]);
+	re = oscap_pcre_get_cached(pattern, OSCAP_PCRE_OPTS_UTF8, NULL, NULL);
+	match = (oscap_pcre_exec(re, string, strlen(string), 0, OSCAP_PCRE_OPTS_NONE, ovector, ovector_len) >= 0);
+	oscap_pcre_free(re);
 	return match;
 }
 
@@ -2205,13 +2204,15 @@ static oval_syschar_collection_flag_t _oval_component_evaluate_REGEX_CAPTURE(ova
 	int rc;
 	char *pattern;
 	int erroffset = -1;
-	pcre *re = NULL;
-	const char *error;
+	oscap_pcre_t *re = NULL;
+	char *error = NULL;
 
 	pattern = oval_component_get_regex_pattern(component);
-	re = pcre_compile(pattern, PCRE_UTF8, &error, &erroffset, NULL);
+	/* the same component is typically computed for every evaluated object */
+	re = oscap_pcre_get_cached(pattern, OSCAP_PCRE_OPTS_UTF8, &error, &erroffset);
 	if (re == NULL) {
 		dE("pcre_compile() failed: \"%s\".", error);
+		oscap_pcre_err_free(error);
 		return SYSCHAR_FLAG_ERROR;
 	}
 
@@ -2230,7 +2231,7 @@ static oval_syschar_collection_flag_t _oval_component_evaluate_REGEX_CAPTURE(ova
 			for (i = 0; i < ovector_len; ++i)
 				ovector[i] = -1;
 
-			rc = pcre_exec(re, NULL, text, strlen(text), 0, 0, ovector, ovector_len);
+			rc = oscap_pcre_exec(re, text, strlen(text), 0, OSCAP_PCRE_OPTS_NONE, ovector, ovector_len);
 			if (rc < -1) {
 				dE("pcre_exec() failed: %d.", rc);
 				flag = SYSCHAR_FLAG_ERROR;
@@ -2260,7 +2261,7 @@ static oval_syschar_collection_flag_t _oval_component_evaluate_REGEX_CAPTURE(ova
 		oval_collection_free_items(subcoll, (oscap_destruct_func) oval_value_free);
 	}
 	oval_component_iterator_free(subcomps);
-	pcre_free(re);
+	oscap_pcre_free(re);
 	return flag;
 }
 
@@ -2479,3 +2480,131 @@ oval_syschar_collection_flag_t oval_component_query(oval_probe_session_t *sess,
 	return oval_component_eval_common(&argu, component, value_collection);
 }
 #endif /* OVAL_PROBES_ENABLED */
+
+void oval_component_cache_write(struct oscap_model_writer *writer, struct oval_component *component)
+{
+	oscap_model_write_u32(writer, component->type);
+
+	switch (component->type) {
+	case OVAL_COMPONENT_LITERAL:{
+			struct oval_value *value = ((oval_component_LITERAL_t *) component)->value;
+			oscap_model_write_bool(writer, value != NULL);
+			if (value != NULL)
+				oval_value_cache_write(writer, value);
+		}
+		break;
+	case OVAL_COMPONENT_OBJECTREF:{
+			oval_component_OBJECTREF_t *objectref = (oval_component_OBJECTREF_t *) component;
+			oscap_model_write_string(writer, objectref->object != NULL ? oval_object_get_id(objectref->object) : NULL);
+			oscap_model_write_string(writer, objectref->item_field);
+			oscap_model_write_string(writer, objectref->record_field);
+		}
+		break;
+	case OVAL_COMPONENT_VARREF:{
+			struct oval_variable *variable = ((oval_component_VARREF_t *) component)->variable;
+			oscap_model_write_string(writer, variable != NULL ? oval_variable_get_id(variable) : NULL);
+		}
+		break;
+	default:{
+			oval_component_FUNCTION_t *function = (oval_component_FUNCTION_t *) component;
+			oval_collection_cache_write(writer, function->function_components, (oval_cache_write_func) oval_component_cache_write);
+
+			switch (component->type) {
+			case OVAL_FUNCTION_ARITHMETIC:
+				oscap_model_write_u32(writer, ((oval_component_ARITHMETIC_t *) component)->operation);
+				break;
+			case OVAL_FUNCTION_BEGIN:
+			case OVAL_FUNCTION_END:
+				oscap_model_write_string(writer, ((oval_component_BEGEND_t *) component)->character);
+				break;
+			case OVAL_FUNCTION_SPLIT:
+				oscap_model_write_string(writer, ((oval_component_SPLIT_t *) component)->delimiter);
+				break;
+			case OVAL_FUNCTION_GLOB_TO_REGEX:
+				oscap_model_write_bool(writer, ((oval_component_GLOB_t *) component)->glob_noescape);
+				break;
+			case OVAL_FUNCTION_SUBSTRING:
+				oscap_model_write_i64(writer, ((oval_component_SUBSTRING_t *) component)->start);
+				oscap_model_write_i64(writer, ((oval_component_SUBSTRING_t *) component)->length);
+				break;
+			case OVAL_FUNCTION_TIMEDIF:
+				oscap_model_write_u32(writer, ((oval_component_TIMEDIF_t *) component)->format_1);
+				oscap_model_write_u32(writer, ((oval_component_TIMEDIF_t *) component)->format_2);
+				break;
+			case OVAL_FUNCTION_REGEX_CAPTURE:
+				oscap_model_write_string(writer, ((oval_component_REGEX_CAPTURE_t *) component)->pattern);
+				break;
+			default:
+				break;
+			}
+		}
+	}
+}
+
+struct oval_component *oval_component_cache_read(struct oscap_model_reader *reader, struct oval_definition_model *model)
+{
+	struct oval_component *component = oval_component_new(model, oscap_model_read_u32(reader));
+	if (component == NULL)
+		return NULL;
+
+	switch (component->type) {
+	case OVAL_COMPONENT_LITERAL:
+		if (oscap_model_read_bool(reader))
+			((oval_component_LITERAL_t *) component)->value = oval_value_cache_read(reader, model);
+		break;
+	case OVAL_COMPONENT_OBJECTREF:{
+			oval_component_OBJECTREF_t *objectref = (oval_component_OBJECTREF_t *) component;
+			char *objref = oscap_model_read_string(reader);
+			if (objref != NULL) {
+				objectref->object = oval_definition_model_get_new_object(model, objref);
+				free(objref);
+			}
+			objectref->item_field = oscap_model_read_string(reader);
+			objectref->record_field = oscap_model_read_string(reader);
+		}
+		break;
+	case OVAL_COMPONENT_VARREF:{
+			char *varref = oscap_model_read_string(reader);
+			if (varref != NULL) {
+				((oval_component_VARREF_t *) component)->variable =
+				    oval_definition_model_get_new_variable(model, varref, OVAL_VARIABLE_UNKNOWN);
+				free(varref);
+			}
+		}
+		break;
+	default:{
+			oval_component_FUNCTION_t *function = (oval_component_FUNCTION_t *) component;
+			oval_collection_cache_read(reader, model, function->function_components, (oval_cache_read_func) oval_component_cache_read);
+
+			switch (component->type) {
+			case OVAL_FUNCTION_ARITHMETIC:
+				((oval_component_ARITHMETIC_t *) component)->operation = oscap_model_read_u32(reader);
+				break;
+			case OVAL_FUNCTION_BEGIN:
+			case OVAL_FUNCTION_END:
+				((oval_component_BEGEND_t *) component)->character = oscap_model_read_string(reader);
+				break;
+			case OVAL_FUNCTION_SPLIT:
+				((oval_component_SPLIT_t *) component)->delimiter = oscap_model_read_string(reader);
+				break;
+			case OVAL_FUNCTION_GLOB_TO_REGEX:
+				((oval_component_GLOB_t *) component)->glob_noescape = oscap_model_read_bool(reader);
+				break;
+			case OVAL_FUNCTION_SUBSTRING:
+				((oval_component_SUBSTRING_t *) component)->start = oscap_model_read_i64(reader);
+				((oval_component_SUBSTRING_t *) component)->length = oscap_model_read_i64(reader);
+				break;
+			case OVAL_FUNCTION_TIMEDIF:
+				((oval_component_TIMEDIF_t *) component)->format_1 = oscap_model_read_u32(reader);
+				((oval_component_TIMEDIF_t *) component)->format_2 = oscap_model_read_u32(reader);
+				break;
+			case OVAL_FUNCTION_REGEX_CAPTURE:
+				((oval_component_REGEX_CAPTURE_t *) component)->pattern = oscap_model_read_string(reader);
+				break;
+			default:
+				break;
+			}
+		}
+	}
+	return component;
+}
@@ -512,3 +512,65 @@ xmlNode *oval_criteria_node_to_dom(struct oval_criteria_node * cnode, xmlDoc * d
 
 	return criteria_node;
 }
+
+void oval_criteria_node_cache_write(struct oscap_model_writer *writer, struct oval_criteria_node *node)
+{
+	oscap_model_write_u32(writer, node->type);
+	oscap_model_write_bool(writer, node->negate);
+	oscap_model_write_string(writer, node->comment);
+	oscap_model_write_bool(writer, node->applicability_check);
+
+	switch (node->type) {
+	case OVAL_NODETYPE_CRITERIA:{
+			struct oval_criteria_node_CRITERIA *criteria = (struct oval_criteria_node_CRITERIA *)node;
+			oscap_model_write_u32(writer, criteria->operator);
+			oval_collection_cache_write(writer, criteria->subnodes, (oval_cache_write_func) oval_criteria_node_cache_write);
+		} break;
+	case OVAL_NODETYPE_CRITERION:{
+			struct oval_test *test = ((struct oval_criteria_node_CRITERION *)node)->test;
+			oscap_model_write_string(writer, test != NULL ? oval_test_get_id(test) : NULL);
+		} break;
+	case OVAL_NODETYPE_EXTENDDEF:{
+			struct oval_definition *definition = ((struct oval_criteria_node_EXTENDDEF *)node)->definition;
+			oscap_model_write_string(writer, definition != NULL ? oval_definition_get_id(definition) : NULL);
+		} break;
+	default:
+		oscap_model_writer_fail(writer);
+	}
+}
+
+struct oval_criteria_node *oval_criteria_node_cache_read(struct oscap_model_reader *reader, struct oval_definition_model *model)
+{
+	struct oval_criteria_node *node = oval_criteria_node_new(model, oscap_model_read_u32(reader));
+	if (node == NULL)
+		return NULL;
+
+	node->negate = oscap_model_read_bool(reader);
+	node->comment = oscap_model_read_string(reader);
+	node->applicability_check = oscap_model_read_bool(reader);
+
+	switch (node->type) {
+	case OVAL_NODETYPE_CRITERIA:{
+			struct oval_criteria_node_CRITERIA *criteria = (struct oval_criteria_node_CRITERIA *)node;
+			criteria->operator = oscap_model_read_u32(reader);
+			oval_collection_cache_read(reader, model, criteria->subnodes, (oval_cache_read_func) oval_criteria_node_cache_read);
+		} break;
+	case OVAL_NODETYPE_CRITERION:{
+			char *test_ref = oscap_model_read_string(reader);
+			if (test_ref != NULL) {
+				((struct oval_criteria_node_CRITERION *)node)->test = oval_definition_model_get_new_test(model, test_ref);
+				free(test_ref);
+			}
+		} break;
+	case OVAL_NODETYPE_EXTENDDEF:{
+			char *definition_ref = oscap_model_read_string(reader);
+			if (definition_ref != NULL) {
+				((struct oval_criteria_node_EXTENDDEF *)node)->definition = oval_definition_model_get_new_definition(model, definition_ref);
+				free(definition_ref);
+			}
+		} break;
+	default:
+		/*NOOP*/;
+	}
+	return node;
+}
@@ -38,6 +38,7 @@
 #include "oval_definitions_impl.h"
 #include "oval_agent_api_impl.h"
 #include "oval_parser_impl.h"
+#include "adt/oval_collection_impl.h"
 #include "adt/oval_string_map_impl.h"
 #include "oval_system_characteristics_impl.h"
 #if defined(OVAL_PROBES_ENABLED)
@@ -47,6 +48,7 @@
 #include "common/debug_priv.h"
 #include "common/_error.h"
 #include "common/elements.h"
+#include "common/xml_stream.h"
 #include "oscap_source.h"
 #include "source/oscap_source_priv.h"
 
@@ -60,6 +62,7 @@ typedef struct oval_definition_model {
 	struct oval_collection *bound_variable_models;
         char *schema;
 	struct oval_string_map *vardef_map;		///< look-up table for efficient @variable_instance processing
+	struct oval_string_map *vardep_map;		///< local variables depending (transitively) on a variable
 } oval_definition_model_t;
 
 /* failed   - NULL
@@ -80,6 +83,7 @@ struct oval_definition_model *oval_definition_model_new()
 	newmodel->bound_variable_models = NULL;
 	newmodel->schema = oscap_strdup(OVAL_DEF_SCHEMA_LOCATION);
 	newmodel->vardef_map = NULL;
+	newmodel->vardep_map = NULL;
 
 	return newmodel;
 }
@@ -120,6 +124,7 @@ struct oval_definition_model *oval_definition_model_clone(struct oval_definition
 	    (oldmodel->variable_map, newmodel, (_oval_clone_func) oval_variable_clone);
         newmodel->schema = oscap_strdup(oldmodel->schema);
 	newmodel->vardef_map = NULL;
+	newmodel->vardep_map = NULL;
 	return newmodel;
 }
 
@@ -133,6 +138,8 @@ void oval_definition_model_free(struct oval_definition_model *model)
 		oval_string_map_free(model->variable_map, (oscap_destruct_func) oval_variable_free);
 		if (model->vardef_map != NULL)
 			oval_string_map_free(model->vardef_map, (oscap_destruct_func) oval_string_map_free0);
+		if (model->vardep_map != NULL)
+			oval_string_map_free(model->vardep_map, (oscap_destruct_func) oval_string_map_free0);
 		if (model->bound_variable_models)
 			oval_collection_free_items(model->bound_variable_models,
 					   (oscap_destruct_func) oval_variable_model_free);
@@ -233,22 +240,147 @@ static inline int _oval_definition_model_merge_source(struct oval_definition_mod
 	context.definition_model = model;
 	context.user_data = NULL;
 	/* jump into oval_definitions */
-	while (xmlTextReaderRead(context.reader) == 1
+	while (xmlTextReaderNextNode(context.reader) == 1
 		&& xmlTextReaderNodeType(context.reader) != XML_READER_TYPE_ELEMENT) ;
 	/* start parsing */
 	int ret = oval_definition_model_parse(context.reader, &context);
-	xmlFreeTextReader(context.reader);
+	if (oscap_source_free_xmlTextReader(context.reader) != 0) {
+		ret = -1;
+	}
 	return ret;
 }
 
+void oval_collection_cache_write(struct oscap_model_writer *writer, struct oval_collection *collection, oval_cache_write_func write_item)
+{
+	if (collection == NULL) {
+		oscap_model_write_u32(writer, 0);
+		return;
+	}
+	struct oval_iterator *items = oval_collection_iterator(collection);
+	oscap_model_write_u32(writer, oval_collection_iterator_remaining(items));
+	while (oval_collection_iterator_has_more(items))
+		write_item(writer, oval_collection_iterator_next(items));
+	oval_collection_iterator_free(items);
+}
+
+void oval_collection_cache_read(struct oscap_model_reader *reader, struct oval_definition_model *model,
+				struct oval_collection *collection, oval_cache_read_func read_item)
+{
+	size_t count = oscap_model_read_count(reader);
+	for (size_t i = 0; i < count && !oscap_model_reader_failed(reader); ++i) {
+		void *item = read_item(reader, model);
+		if (item == NULL)
+			oscap_model_reader_fail(reader);
+		else
+			oval_collection_add(collection, item);
+	}
+}
+
+void oval_string_cache_write(struct oscap_model_writer *writer, void *str)
+{
+	oscap_model_write_string(writer, str);
+}
+
+void *oval_string_cache_read(struct oscap_model_reader *reader, struct oval_definition_model *model)
+{
+	return oscap_model_read_string(reader);
+}
+
+/*
+ * Model cache records of OVAL definitions
+ *
+ * The record holds the generator and every definition, test, object, state
+ * and variable of the maps of the model, including the ones which are only
+ * referenced. References are stored as ids and resolved the same way the
+ * parser resolves them, so the items may be loaded in any order. The model
+ * is stored as parsed, i.e. before it is optimized for evaluation and before
+ * any variables are bound to it.
+ *
+ * Change OVAL_MODEL_CACHE_VERSION whenever the layout of the record or of
+ * the model changes.
+ */
+#define OVAL_MODEL_CACHE_KIND "oval"
+#define OVAL_MODEL_CACHE_VERSION 1
+
+static void _oval_string_map_cache_write(struct oscap_model_writer *writer, struct oval_string_map *map, oval_cache_write_func write_item)
+{
+	struct oval_iterator *items = oval_string_map_values(map);
+	oscap_model_write_u32(writer, oval_collection_iterator_remaining(items));
+	while (oval_collection_iterator_has_more(items))
+		write_item(writer, oval_collection_iterator_next(items));
+	oval_collection_iterator_free(items);
+}
+
+/* The items register themselves to the maps of the model */
+static void _oval_string_map_cache_read(struct oscap_model_reader *reader, struct oval_definition_model *model, oval_cache_read_func read_item)
+{
+	size_t count = oscap_model_read_count(reader);
+	for (size_t i = 0; i < count && !oscap_model_reader_failed(reader); ++i) {
+		if (read_item(reader, model) == NULL)
+			oscap_model_reader_fail(reader);
+	}
+}
+
+static void _oval_definition_model_cache_write(struct oscap_model_writer *writer, struct oval_definition_model *model)
+{
+	oval_generator_cache_write(writer, model->generator);
+	oscap_model_write_string(writer, model->schema);
+	_oval_string_map_cache_write(writer, model->definition_map, (oval_cache_write_func) oval_definition_cache_write);
+	_oval_string_map_cache_write(writer, model->test_map, (oval_cache_write_func) oval_test_cache_write);
+	_oval_string_map_cache_write(writer, model->object_map, (oval_cache_write_func) oval_object_cache_write);
+	_oval_string_map_cache_write(writer, model->state_map, (oval_cache_write_func) oval_state_cache_write);
+	_oval_string_map_cache_write(writer, model->variable_map, (oval_cache_write_func) oval_variable_cache_write);
+}
+
+static struct oval_definition_model *_oval_definition_model_cache_read(struct oscap_model_reader *reader)
+{
+	struct oval_definition_model *model = oval_definition_model_new();
+	oval_generator_cache_read(reader, model->generator);
+	free(model->schema);
+	model->schema = oscap_model_read_string(reader);
+	_oval_string_map_cache_read(reader, model, (oval_cache_read_func) oval_definition_cache_read);
+	_oval_string_map_cache_read(reader, model, (oval_cache_read_func) oval_test_cache_read);
+	_oval_string_map_cache_read(reader, model, (oval_cache_read_func) oval_object_cache_read);
+	_oval_string_map_cache_read(reader, model, (oval_cache_read_func) oval_state_cache_read);
+	_oval_string_map_cache_read(reader, model, (oval_cache_read_func) oval_variable_cache_read);
+
+	if (oscap_model_reader_failed(reader)) {
+		oval_definition_model_free(model);
+		return NULL;
+	}
+	return model;
+}
+
 struct oval_definition_model *oval_definition_model_import_source(struct oscap_source *source)
 {
+	const char *digest = oscap_model_cache_enabled() ? oscap_source_get_digest(source) : NULL;
+
+	if (digest != NULL) {
+		struct oscap_model_reader *reader = oscap_model_cache_open(OVAL_MODEL_CACHE_KIND, OVAL_MODEL_CACHE_VERSION, digest);
+		if (reader != NULL) {
+			struct oval_definition_model *model = _oval_definition_model_cache_read(reader);
+			if (oscap_model_cache_close(reader) == 0 && model != NULL) {
+				dI("Loaded the OVAL definitions of '%s' from the model cache.", oscap_source_readable_origin(source));
+				return model;
+			}
+			dI("Ignoring the model cache record of '%s', it can't be loaded.", oscap_source_readable_origin(source));
+			oval_definition_model_free(model);
+		}
+	}
+
         struct oval_definition_model *model = oval_definition_model_new();
 	int ret = _oval_definition_model_merge_source(model, source);
         if (ret == -1 ) {
                 oval_definition_model_free(model);
-                model = NULL;
+                return NULL;
         }
+
+	if (digest != NULL && oscap_source_digest_is_current(source)) {
+		struct oscap_model_writer *writer = oscap_model_writer_new();
+		_oval_definition_model_cache_write(writer, model);
+		oscap_model_cache_store(OVAL_MODEL_CACHE_KIND, OVAL_MODEL_CACHE_VERSION, digest, writer);
+		oscap_model_writer_free(writer);
+	}
 	return model;
 }
 
@@ -324,6 +456,23 @@ struct oval_variable_model_iterator *oval_definition_model_get_variable_models(s
 		return (struct oval_variable_model_iterator *) oval_collection_iterator_new();
 }
 
+static struct oval_string_map *_oval_definition_model_get_vardep_map(struct oval_definition_model *model)
+{
+	if (model->vardep_map == NULL)
+		model->vardep_map = oval_definition_model_build_vardep_mapping(model);
+	return model->vardep_map;
+}
+
+bool oval_definition_model_is_variable_circular(struct oval_definition_model *model, struct oval_variable *variable)
+{
+	__attribute__nonnull__(model);
+	__attribute__nonnull__(variable);
+
+	const char *var_id = oval_variable_get_id(variable);
+	struct oval_string_map *dep_list = oval_string_map_get_value(_oval_definition_model_get_vardep_map(model), var_id);
+	return dep_list != NULL && oval_string_map_get_value(dep_list, var_id) != NULL;
+}
+
 void oval_definition_model_clear_external_variables(struct oval_definition_model *model)
 {
 	struct oval_variable_iterator *vars_itr;
@@ -337,6 +486,19 @@ void oval_definition_model_clear_external_variables(struct oval_definition_model
 			continue;
 
 		oval_variable_clear_values(var);
+
+		/* Local variables computed from the external variable have to be
+		 * computed again, the others keep their values. */
+		struct oval_string_map *dep_list = oval_string_map_get_value(_oval_definition_model_get_vardep_map(model), oval_variable_get_id(var));
+		if (dep_list == NULL)
+			continue;
+		struct oval_string_iterator *dep_itr = (struct oval_string_iterator *) oval_string_map_keys(dep_list);
+		while (oval_string_iterator_has_more(dep_itr)) {
+			struct oval_variable *local = oval_definition_model_get_variable(model, oval_string_iterator_next(dep_itr));
+			if (local != NULL)
+				oval_variable_clear_values(local);
+		}
+		oval_string_iterator_free(dep_itr);
 	}
 	oval_variable_iterator_free(vars_itr);
 }
@@ -493,6 +655,7 @@ xmlNode *oval_definition_model_to_dom(struct oval_definition_model *definition_m
 				definitions_node = xmlNewTextChild(root_node, ns_defntns, BAD_CAST "definitions", NULL);
 			}
 			oval_definition_to_dom(definition, doc, definitions_node);
+			oscap_xml_stream_flush(doc, definitions_node);
 		}
 	}
         oval_definition_iterator_free(definitions);
@@ -504,6 +667,7 @@ xmlNode *oval_definition_model_to_dom(struct oval_definition_model *definition_m
 		while (oval_test_iterator_has_more(tests)) {
 			struct oval_test *test = oval_test_iterator_next(tests);
 			oval_test_to_dom(test, doc, tests_node);
+			oscap_xml_stream_flush(doc, tests_node);
 		}
 	}
 	oval_test_iterator_free(tests);
@@ -518,6 +682,7 @@ xmlNode *oval_definition_model_to_dom(struct oval_definition_model *definition_m
 				/* Skip internal objects */
 				continue;
 			oval_object_to_dom(object, doc, objects_node);
+			oscap_xml_stream_flush(doc, objects_node);
 		}
 	}
 	oval_object_iterator_free(objects);
@@ -529,6 +694,7 @@ xmlNode *oval_definition_model_to_dom(struct oval_definition_model *definition_m
 		while (oval_state_iterator_has_more(states)) {
 			struct oval_state *state = oval_state_iterator_next(states);
 			oval_state_to_dom(state, doc, states_node);
+			oscap_xml_stream_flush(doc, states_node);
 		}
 	}
 	oval_state_iterator_free(states);
@@ -540,6 +706,7 @@ xmlNode *oval_definition_model_to_dom(struct oval_definition_model *definition_m
 		while (oval_variable_iterator_has_more(variables)) {
 			struct oval_variable *variable = oval_variable_iterator_next(variables);
 			oval_variable_to_dom(variable, doc, variables_node);
+			oscap_xml_stream_flush(doc, variables_node);
 		}
 	}
 	oval_variable_iterator_free(variables);
@@ -560,8 +727,14 @@ int oval_definition_model_export(struct oval_definition_model *model, const char
 		return -1;
 	}
 
+	if (!oscap_xml_stream_open(doc, file)) {
+		xmlFreeDoc(doc);
+		return -1;
+	}
 	oval_definition_model_to_dom(model, doc, NULL);
-	return oscap_xml_save_filename_free(file, doc);
+	int ret = oscap_xml_stream_close(doc);
+	xmlFreeDoc(doc);
+	return ret;
 }
 
 static void _fp_set_recurse(struct oval_definition_model *model, struct oval_setobject *set, char *set_id)
@@ -546,3 +546,42 @@ const char * oval_definition_model_supported(void)
 {
         return OVAL_SUPPORTED;
 }
+
+void oval_definition_cache_write(struct oscap_model_writer *writer, struct oval_definition *definition)
+{
+	oscap_model_write_string(writer, definition->id);
+	oscap_model_write_i64(writer, definition->version);
+	oscap_model_write_u32(writer, definition->class);
+	oscap_model_write_bool(writer, definition->deprecated);
+	oscap_model_write_string(writer, definition->title);
+	oscap_model_write_string(writer, definition->description);
+	oval_collection_cache_write(writer, definition->affected, (oval_cache_write_func) oval_affected_cache_write);
+	oval_collection_cache_write(writer, definition->reference, (oval_cache_write_func) oval_reference_cache_write);
+	oval_collection_cache_write(writer, definition->notes, oval_string_cache_write);
+	oscap_model_write_string(writer, definition->anyxml);
+	oscap_model_write_bool(writer, definition->criteria != NULL);
+	if (definition->criteria != NULL)
+		oval_criteria_node_cache_write(writer, definition->criteria);
+}
+
+struct oval_definition *oval_definition_cache_read(struct oscap_model_reader *reader, struct oval_definition_model *model)
+{
+	char *id = oscap_model_read_string(reader);
+	if (id == NULL)
+		return NULL;
+	struct oval_definition *definition = oval_definition_model_get_new_definition(model, id);
+	free(id);
+
+	definition->version = oscap_model_read_i64(reader);
+	definition->class = oscap_model_read_u32(reader);
+	definition->deprecated = oscap_model_read_bool(reader);
+	definition->title = oscap_model_read_string(reader);
+	definition->description = oscap_model_read_string(reader);
+	oval_collection_cache_read(reader, model, definition->affected, (oval_cache_read_func) oval_affected_cache_read);
+	oval_collection_cache_read(reader, model, definition->reference, (oval_cache_read_func) oval_reference_cache_read);
+	oval_collection_cache_read(reader, model, definition->notes, oval_string_cache_read);
+	definition->anyxml = oscap_model_read_string(reader);
+	if (oscap_model_read_bool(reader))
+		definition->criteria = oval_criteria_node_cache_read(reader, model);
+	return definition;
+}
@@ -40,6 +40,7 @@
 #include "oval_parser_impl.h"
 #include "adt/oval_string_map_impl.h"
 #include "../common/util.h"
+#include "../common/oscap_model_cache.h"
 
 
 oval_family_t oval_family_parse(xmlTextReaderPtr);
@@ -92,6 +93,10 @@ xmlNode *oval_object_to_dom(struct oval_object *, xmlDoc *, xmlNode *);
 struct oval_object *oval_object_clone2(struct oval_definition_model *, struct oval_object *, char *);
 struct oval_object *oval_object_create_internal(struct oval_object *, char *);
 struct oval_object *oval_object_get_base_obj(struct oval_object *);
+/* The string values of the notes and set elements with the whitespace of the source
+ * document, NULL if the object has none. The HTML report shows them as written. */
+const char *oval_object_get_notes_text(const struct oval_object *);
+const char *oval_object_get_set_text(const struct oval_object *);
 
 oval_schema_version_t oval_state_get_platform_schema_version(const struct oval_state *state);
 int oval_state_parse_tag(xmlTextReaderPtr reader, struct oval_parser_context *context, void *);
@@ -182,6 +187,56 @@ oval_schema_version_t oval_definition_model_get_platform_schema_version(struct o
 
 struct oval_string_map *oval_definition_model_build_vardef_mapping(struct oval_definition_model *model);
 struct oval_string_iterator *oval_definition_model_get_definitions_dependent_on_variable(struct oval_definition_model *model, struct oval_variable *variable);
+struct oval_string_map *oval_definition_model_build_vardep_mapping(struct oval_definition_model *model);
+bool oval_definition_model_is_variable_circular(struct oval_definition_model *model, struct oval_variable *variable);
+
+/* model cache, see common/oscap_model_cache.h */
+struct oval_collection;
+typedef void (*oval_cache_write_func) (struct oscap_model_writer *, void *);
+/* Read functions return NULL if the item can't be created from the record */
+typedef void *(*oval_cache_read_func) (struct oscap_model_reader *, struct oval_definition_model *);
+void oval_collection_cache_write(struct oscap_model_writer *, struct oval_collection *, oval_cache_write_func);
+void oval_collection_cache_read(struct oscap_model_reader *, struct oval_definition_model *, struct oval_collection *, oval_cache_read_func);
+void oval_string_cache_write(struct oscap_model_writer *, void *);
+void *oval_string_cache_read(struct oscap_model_reader *, struct oval_definition_model *);
+
+void oval_generator_cache_write(struct oscap_model_writer *, struct oval_generator *);
+void oval_generator_cache_read(struct oscap_model_reader *, struct oval_generator *);
+void oval_value_cache_write(struct oscap_model_writer *, struct oval_value *);
+struct oval_value *oval_value_cache_read(struct oscap_model_reader *, struct oval_definition_model *);
+void oval_entity_cache_write(struct oscap_model_writer *, struct oval_entity *);
+struct oval_entity *oval_entity_cache_read(struct oscap_model_reader *, struct oval_definition_model *);
+void oval_record_field_cache_write(struct oscap_model_writer *, struct oval_record_field *);
+struct oval_record_field *oval_record_field_cache_read(struct oscap_model_reader *, struct oval_definition_model *);
+void oval_affected_cache_write(struct oscap_model_writer *, struct oval_affected *);
+struct oval_affected *oval_affected_cache_read(struct oscap_model_reader *, struct oval_definition_model *);
+void oval_reference_cache_write(struct oscap_model_writer *, struct oval_reference *);
+struct oval_reference *oval_reference_cache_read(struct oscap_model_reader *, struct oval_definition_model *);
+void oval_behavior_cache_write(struct oscap_model_writer *, struct oval_behavior *);
+struct oval_behavior *oval_behavior_cache_read(struct oscap_model_reader *, struct oval_definition_model *);
+void oval_filter_cache_write(struct oscap_model_writer *, struct oval_filter *);
+struct oval_filter *oval_filter_cache_read(struct oscap_model_reader *, struct oval_definition_model *);
+void oval_setobject_cache_write(struct oscap_model_writer *, struct oval_setobject *);
+struct oval_setobject *oval_setobject_cache_read(struct oscap_model_reader *, struct oval_definition_model *);
+void oval_object_content_cache_write(struct oscap_model_writer *, struct oval_object_content *);
+struct oval_object_content *oval_object_content_cache_read(struct oscap_model_reader *, struct oval_definition_model *);
+void oval_state_content_cache_write(struct oscap_model_writer *, struct oval_state_content *);
+struct oval_state_content *oval_state_content_cache_read(struct oscap_model_reader *, struct oval_definition_model *);
+void oval_criteria_node_cache_write(struct oscap_model_writer *, struct oval_criteria_node *);
+struct oval_criteria_node *oval_criteria_node_cache_read(struct oscap_model_reader *, struct oval_definition_model *);
+void oval_component_cache_write(struct oscap_model_writer *, struct oval_component *);
+struct oval_component *oval_component_cache_read(struct oscap_model_reader *, struct oval_definition_model *);
+/* Items with an id are registered to the model by their read functions */
+void oval_definition_cache_write(struct oscap_model_writer *, struct oval_definition *);
+struct oval_definition *oval_definition_cache_read(struct oscap_model_reader *, struct oval_definition_model *);
+void oval_test_cache_write(struct oscap_model_writer *, struct oval_test *);
+struct oval_test *oval_test_cache_read(struct oscap_model_reader *, struct oval_definition_model *);
+void oval_object_cache_write(struct oscap_model_writer *, struct oval_object *);
+struct oval_object *oval_object_cache_read(struct oscap_model_reader *, struct oval_definition_model *);
+void oval_state_cache_write(struct oscap_model_writer *, struct oval_state *);
+struct oval_state *oval_state_cache_read(struct oscap_model_reader *, struct oval_definition_model *);
+void oval_variable_cache_write(struct oscap_model_writer *, struct oval_variable *);
+struct oval_variable *oval_variable_cache_read(struct oscap_model_reader *, struct oval_definition_model *);
 
 /* variable model */
 struct oval_collection *oval_variable_model_get_values_ref(struct oval_variable_model *, char *);
@@ -118,12 +118,12 @@ int oval_directives_model_import_source(struct oval_directives_model *model, str
         context.directives_model = model;
         context.user_data = NULL;
         /* jump into oval_system_characteristics */
-        xmlTextReaderRead(context.reader);
+        xmlTextReaderNextNode(context.reader);
 
         /* make sure this is a right schema and tag */
         tagname = (char *)xmlTextReaderLocalName(context.reader);
         namespace = (char *)xmlTextReaderNamespaceUri(context.reader);
-        int is_ovaldir = strcmp((const char *)OVAL_DIRECTIVES_NAMESPACE, namespace) == 0;
+        int is_ovaldir = oscap_strcmp((const char *)OVAL_DIRECTIVES_NAMESPACE, namespace) == 0;
         /* start parsing */
         if (is_ovaldir && (strcmp(tagname, OVAL_ROOT_ELM_DIRECTIVES) == 0)) {
                 ret = oval_directives_model_parse(context.reader, &context);
@@ -134,7 +134,9 @@ int oval_directives_model_import_source(struct oval_directives_model *model, str
 
         free(tagname);
         free(namespace);
-	xmlFreeTextReader(context.reader);
+	if (oscap_source_free_xmlTextReader(context.reader) != 0) {
+		ret = -1;
+	}
 	return ret;
 }
 
@@ -294,7 +296,8 @@ static int oval_directives_model_parse(xmlTextReaderPtr reader, struct oval_pars
 	int depth = xmlTextReaderDepth(reader);
 	int ret = 0;
 
-	xmlTextReaderRead(reader);
+	if (xmlTextReaderNextNode(reader) != 1)
+		return -1;
 	while ((xmlTextReaderDepth(reader) > depth) && (ret != -1 )) {
 		if (xmlTextReaderNodeType(reader) == XML_READER_TYPE_ELEMENT) {
 			char *tagname = (char *)xmlTextReaderLocalName(reader);
@@ -322,13 +325,13 @@ static int oval_directives_model_parse(xmlTextReaderPtr reader, struct oval_pars
 				free(class_str);
 			} else {
 				dW("Unprocessed tag: <%s:%s>.", namespace, tagname);
-				oval_parser_skip_tag(reader, context);
+				ret = oval_parser_skip_tag(reader, context);
 			}
 
 			free(tagname);
 			free(namespace);
 		} else {
-			if (xmlTextReaderRead(reader) != XML_READER_TYPE_ELEMENT) {
+			if (xmlTextReaderNextNode(reader) != XML_READER_TYPE_ELEMENT) {
 				ret = -1;
 				break;
 			}
@@ -425,3 +425,38 @@ xmlNode *oval_entity_to_dom(struct oval_entity *entity, xmlDoc * doc, xmlNode *
 
 	return entity_node;
 }
+
+void oval_entity_cache_write(struct oscap_model_writer *writer, struct oval_entity *entity)
+{
+	oscap_model_write_u32(writer, entity->type);
+	oscap_model_write_u32(writer, entity->datatype);
+	oscap_model_write_u32(writer, entity->operation);
+	oscap_model_write_bool(writer, entity->mask);
+	oscap_model_write_u32(writer, entity->varref_type);
+	oscap_model_write_string(writer, entity->name);
+	oscap_model_write_string(writer, entity->variable != NULL ? oval_variable_get_id(entity->variable) : NULL);
+	oscap_model_write_bool(writer, entity->value != NULL);
+	if (entity->value != NULL)
+		oval_value_cache_write(writer, entity->value);
+	oscap_model_write_bool(writer, entity->xsi_nil);
+}
+
+struct oval_entity *oval_entity_cache_read(struct oscap_model_reader *reader, struct oval_definition_model *model)
+{
+	struct oval_entity *entity = oval_entity_new(model);
+	entity->type = oscap_model_read_u32(reader);
+	entity->datatype = oscap_model_read_u32(reader);
+	entity->operation = oscap_model_read_u32(reader);
+	entity->mask = oscap_model_read_bool(reader);
+	entity->varref_type = oscap_model_read_u32(reader);
+	entity->name = oscap_model_read_string(reader);
+	char *varref = oscap_model_read_string(reader);
+	if (varref != NULL) {
+		entity->variable = oval_definition_model_get_new_variable(model, varref, OVAL_VARIABLE_UNKNOWN);
+		free(varref);
+	}
+	if (oscap_model_read_bool(reader))
+		entity->value = oval_value_cache_read(reader, model);
+	entity->xsi_nil = oscap_model_read_bool(reader);
+	return entity;
+}
@@ -175,3 +175,21 @@ xmlNode *oval_filter_to_dom(struct oval_filter *filter, xmlDoc *doc, xmlNode *pa
 }
 
 /// @}
+
+void oval_filter_cache_write(struct oscap_model_writer *writer, struct oval_filter *filter)
+{
+	oscap_model_write_string(writer, filter->state != NULL ? oval_state_get_id(filter->state) : NULL);
+	oscap_model_write_u32(writer, filter->action);
+}
+
+struct oval_filter *oval_filter_cache_read(struct oscap_model_reader *reader, struct oval_definition_model *model)
+{
+	struct oval_filter *filter = oval_filter_new(model);
+	char *ste_id = oscap_model_read_string(reader);
+	if (ste_id != NULL) {
+		filter->state = oval_definition_model_get_new_state(model, ste_id);
+		free(ste_id);
+	}
+	filter->action = oscap_model_read_u32(reader);
+	return filter;
+}
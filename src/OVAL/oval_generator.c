@@ -43,6 +43,7 @@
 #include "oval_agent_api_impl.h"
 #include "oval_definitions_impl.h"
 #include "common/list.h"
+#include "common/xmltext_priv.h"
 
 struct oval_generator {
 	char *product_name;
@@ -232,16 +233,16 @@ int oval_generator_parse_tag(xmlTextReader *reader, struct oval_parser_context *
 	namespace = (char *) xmlTextReaderNamespaceUri(reader);
 
 	if (!strcmp("product_name", tagname)) {
-		xmlTextReaderRead(reader);
+		xmlTextReaderNextNode(reader);
 		val = (char *) xmlTextReaderValue(reader);
 		oval_generator_set_product_name(gen, val);
 	} else if (!strcmp("product_version", tagname)) {
-		xmlTextReaderRead(reader);
+		xmlTextReaderNextNode(reader);
 		val = (char *) xmlTextReaderValue(reader);
 		oval_generator_set_product_version(gen, val);
 	} else if (!strcmp("schema_version", tagname)) {
 		char *platform = (char *) xmlTextReaderGetAttribute(reader, BAD_CAST "platform");
-		xmlTextReaderRead(reader);
+		xmlTextReaderNextNode(reader);
 		val = (char *) xmlTextReaderValue(reader);
 		if (platform != NULL) {
 			char *platform_name = strrchr(platform, '#');
@@ -254,7 +255,7 @@ int oval_generator_parse_tag(xmlTextReader *reader, struct oval_parser_context *
 			oval_generator_set_core_schema_version(gen, val);
 		}
 	} else if (!strcmp("timestamp", tagname)) {
-		xmlTextReaderRead(reader);
+		xmlTextReaderNextNode(reader);
 		val = (char *) xmlTextReaderValue(reader);
 		oval_generator_set_timestamp(gen, val);
 	} else {
@@ -269,3 +270,46 @@ int oval_generator_parse_tag(xmlTextReader *reader, struct oval_parser_context *
 	return ret;
 }
 
+
+void oval_generator_cache_write(struct oscap_model_writer *writer, struct oval_generator *generator)
+{
+	oscap_model_write_string(writer, generator->product_name);
+	oscap_model_write_string(writer, generator->product_version);
+	oscap_model_write_string(writer, generator->core_schema_version);
+	oscap_model_write_u32(writer, oscap_htable_itemcount(generator->platform_schema_versions));
+	struct oscap_htable_iterator *it = oscap_htable_iterator_new(generator->platform_schema_versions);
+	while (oscap_htable_iterator_has_more(it)) {
+		const char *platform;
+		void *schema_version;
+		oscap_htable_iterator_next_kv(it, &platform, &schema_version);
+		oscap_model_write_string(writer, platform);
+		oscap_model_write_string(writer, schema_version);
+	}
+	oscap_htable_iterator_free(it);
+	oscap_model_write_string(writer, generator->timestamp);
+	oscap_model_write_string(writer, generator->anyxml);
+}
+
+void oval_generator_cache_read(struct oscap_model_reader *reader, struct oval_generator *generator)
+{
+	free(generator->product_name);
+	generator->product_name = oscap_model_read_string(reader);
+	free(generator->product_version);
+	generator->product_version = oscap_model_read_string(reader);
+	free(generator->core_schema_version);
+	generator->core_schema_version = oscap_model_read_string(reader);
+	size_t count = oscap_model_read_count(reader);
+	for (size_t i = 0; i < count && !oscap_model_reader_failed(reader); ++i) {
+		char *platform = oscap_model_read_string(reader);
+		char *schema_version = oscap_model_read_string(reader);
+		if (platform == NULL || !oscap_htable_add(generator->platform_schema_versions, platform, schema_version)) {
+			oscap_model_reader_fail(reader);
+			free(schema_version);
+		}
+		free(platform);
+	}
+	free(generator->timestamp);
+	generator->timestamp = oscap_model_read_string(reader);
+	free(generator->anyxml);
+	generator->anyxml = oscap_model_read_string(reader);
+}
@@ -53,6 +53,8 @@ typedef struct oval_object {
 	int version;
 	struct oval_collection *object_content;
 	struct oval_collection *behaviors;
+	char *notes_text;
+	char *set_text;
 } oval_object_t;
 
 bool oval_object_iterator_has_more(struct oval_object_iterator *oc_object)
@@ -96,6 +98,20 @@ const char *oval_object_get_name(struct oval_object *object)
 	return oval_subtype_get_text(object->subtype);
 }
 
+const char *oval_object_get_notes_text(const struct oval_object *object)
+{
+	__attribute__nonnull__(object);
+
+	return object->notes_text;
+}
+
+const char *oval_object_get_set_text(const struct oval_object *object)
+{
+	__attribute__nonnull__(object);
+
+	return object->set_text;
+}
+
 struct oval_string_iterator *oval_object_get_notes(struct oval_object *object)
 {
 	__attribute__nonnull__(object);
@@ -178,6 +194,8 @@ struct oval_object *oval_object_new(struct oval_definition_model *model, const c
 	object->behaviors = oval_collection_new();
 	object->notes = oval_collection_new();
 	object->object_content = oval_collection_new();
+	object->notes_text = NULL;
+	object->set_text = NULL;
 	object->model = model;
 
 	oval_definition_model_add_object(model, object);
@@ -201,6 +219,8 @@ struct oval_object *oval_object_clone2(struct oval_definition_model *new_model,
 		oval_object_set_subtype(new_object, old_object->subtype);
 		oval_object_set_deprecated(new_object, old_object->deprecated);
 		oval_object_set_version(new_object, old_object->version);
+		new_object->notes_text = oscap_strdup(old_object->notes_text);
+		new_object->set_text = oscap_strdup(old_object->set_text);
 
 		struct oval_behavior_iterator *behaviors = oval_object_get_behaviors(old_object);
 		while (oval_behavior_iterator_has_more(behaviors)) {
@@ -242,6 +262,8 @@ void oval_object_free(struct oval_object *object)
 	oval_collection_free_items(object->behaviors, (oscap_destruct_func) oval_behavior_free);
 	oval_collection_free_items(object->notes, (oscap_destruct_func) free);
 	oval_collection_free_items(object->object_content, (oscap_destruct_func) oval_object_content_free);
+	free(object->notes_text);
+	free(object->set_text);
 
 	object->comment = NULL;
 	object->id = NULL;
@@ -316,12 +338,24 @@ static void oval_content_consume(struct oval_object_content *content, void *obje
 	oval_object_add_object_content(object, content);
 }
 
+/* The string value of the current element including the whitespace between its children */
+static char *_oval_object_element_text(xmlTextReaderPtr reader)
+{
+	xmlNode *node = xmlTextReaderExpand(reader);
+	return node != NULL ? (char *) xmlNodeGetContent(node) : NULL;
+}
+
 static int _oval_object_parse_tag(xmlTextReaderPtr reader, struct oval_parser_context *context, void *user)
 {
 	struct oval_object *object = (struct oval_object *)user;
 	char *tagname = (char *)xmlTextReaderLocalName(reader);
 	xmlChar *namespace = xmlTextReaderNamespaceUri(reader);
 	int return_code = 0;
+	if (strcmp(tagname, "notes") == 0 && object->notes_text == NULL)
+		object->notes_text = _oval_object_element_text(reader);
+	else if (strcmp(tagname, "set") == 0 && object->set_text == NULL)
+		object->set_text = _oval_object_element_text(reader);
+
 	if ((strcmp(tagname, "notes") == 0)) {
 		return_code = oval_parser_parse_tag(reader, context, &_oval_object_parse_notes, object);
 	} else if (strcmp(tagname, "behaviors") == 0) {
@@ -474,3 +508,43 @@ struct oval_object *oval_object_get_base_obj(struct oval_object *obj)
 {
 	return obj->base_obj_ref;
 }
+
+void oval_object_cache_write(struct oscap_model_writer *writer, struct oval_object *object)
+{
+	oscap_model_write_string(writer, object->id);
+	oscap_model_write_u32(writer, object->subtype);
+	oscap_model_write_string(writer, object->base_obj_ref != NULL ? object->base_obj_ref->id : NULL);
+	oval_collection_cache_write(writer, object->notes, oval_string_cache_write);
+	oscap_model_write_string(writer, object->comment);
+	oscap_model_write_bool(writer, object->deprecated);
+	oscap_model_write_i64(writer, object->version);
+	oval_collection_cache_write(writer, object->object_content, (oval_cache_write_func) oval_object_content_cache_write);
+	oval_collection_cache_write(writer, object->behaviors, (oval_cache_write_func) oval_behavior_cache_write);
+	oscap_model_write_string(writer, object->notes_text);
+	oscap_model_write_string(writer, object->set_text);
+}
+
+struct oval_object *oval_object_cache_read(struct oscap_model_reader *reader, struct oval_definition_model *model)
+{
+	char *id = oscap_model_read_string(reader);
+	if (id == NULL)
+		return NULL;
+	struct oval_object *object = oval_definition_model_get_new_object(model, id);
+	free(id);
+
+	object->subtype = oscap_model_read_u32(reader);
+	char *base_obj_ref = oscap_model_read_string(reader);
+	if (base_obj_ref != NULL) {
+		object->base_obj_ref = oval_definition_model_get_new_object(model, base_obj_ref);
+		free(base_obj_ref);
+	}
+	oval_collection_cache_read(reader, model, object->notes, oval_string_cache_read);
+	object->comment = oscap_model_read_string(reader);
+	object->deprecated = oscap_model_read_bool(reader);
+	object->version = oscap_model_read_i64(reader);
+	oval_collection_cache_read(reader, model, object->object_content, (oval_cache_read_func) oval_object_content_cache_read);
+	oval_collection_cache_read(reader, model, object->behaviors, (oval_cache_read_func) oval_behavior_cache_read);
+	object->notes_text = oscap_model_read_string(reader);
+	object->set_text = oscap_model_read_string(reader);
+	return object;
+}
@@ -425,3 +425,64 @@ xmlNode *oval_object_content_to_dom(struct oval_object_content *content, xmlDoc
 
 	return content_node;
 }
+
+void oval_object_content_cache_write(struct oscap_model_writer *writer, struct oval_object_content *content)
+{
+	oscap_model_write_u32(writer, content->type);
+	oscap_model_write_string(writer, content->fieldName);
+
+	switch (content->type) {
+	case OVAL_OBJECTCONTENT_ENTITY:{
+			struct oval_object_content_ENTITY *entity = (oval_object_content_ENTITY_t *) content;
+			oscap_model_write_bool(writer, entity->entity != NULL);
+			if (entity->entity != NULL)
+				oval_entity_cache_write(writer, entity->entity);
+			oscap_model_write_u32(writer, entity->varCheck);
+		} break;
+	case OVAL_OBJECTCONTENT_SET:{
+			struct oval_object_content_SET *set = (oval_object_content_SET_t *) content;
+			oscap_model_write_bool(writer, set->set != NULL);
+			if (set->set != NULL)
+				oval_setobject_cache_write(writer, set->set);
+		} break;
+	case OVAL_OBJECTCONTENT_FILTER:{
+			struct oval_object_content_FILTER *filter = (oval_object_content_FILTER_t *) content;
+			oscap_model_write_bool(writer, filter->filter != NULL);
+			if (filter->filter != NULL)
+				oval_filter_cache_write(writer, filter->filter);
+		} break;
+	default:
+		oscap_model_writer_fail(writer);
+	}
+}
+
+struct oval_object_content *oval_object_content_cache_read(struct oscap_model_reader *reader, struct oval_definition_model *model)
+{
+	struct oval_object_content *content = oval_object_content_new(model, oscap_model_read_u32(reader));
+	if (content == NULL)
+		return NULL;
+
+	content->fieldName = oscap_model_read_string(reader);
+
+	switch (content->type) {
+	case OVAL_OBJECTCONTENT_ENTITY:{
+			struct oval_object_content_ENTITY *entity = (oval_object_content_ENTITY_t *) content;
+			if (oscap_model_read_bool(reader))
+				entity->entity = oval_entity_cache_read(reader, model);
+			entity->varCheck = oscap_model_read_u32(reader);
+		} break;
+	case OVAL_OBJECTCONTENT_SET:{
+			struct oval_object_content_SET *set = (oval_object_content_SET_t *) content;
+			if (oscap_model_read_bool(reader))
+				set->set = oval_setobject_cache_read(reader, model);
+		} break;
+	case OVAL_OBJECTCONTENT_FILTER:{
+			struct oval_object_content_FILTER *filter = (oval_object_content_FILTER_t *) content;
+			if (oscap_model_read_bool(reader))
+				filter->filter = oval_filter_cache_read(reader, model);
+		} break;
+	default:
+		/*NOOP*/;
+	}
+	return content;
+}
@@ -55,12 +55,13 @@ int oval_parser_parse_tag(xmlTextReaderPtr reader, struct oval_parser_context *c
 	int ret=0;
 	int depth = xmlTextReaderDepth(reader);
 
-	xmlTextReaderRead(reader);
+	if (xmlTextReaderNextNode(reader) != 1)
+		return -1;
 	while ( (ret!=-1) &&  (xmlTextReaderDepth(reader) > depth) ) {
 		if (xmlTextReaderNodeType(reader) == XML_READER_TYPE_ELEMENT) {
 			ret = (*tag_parser) (reader, context, user);
 		}
-                if (xmlTextReaderRead(reader) != 1) {
+                if (xmlTextReaderNextNode(reader) != 1) {
 			ret = -1;
                         break;
 		}
@@ -76,7 +77,7 @@ char *oval_determine_document_schema_version_priv(xmlTextReader *reader, oscap_d
 	char *version = NULL;
 
 	/* find root element */
-	while (xmlTextReaderRead(reader) == 1
+	while (xmlTextReaderNextNode(reader) == 1
 	       && xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT);
 	/* verify document type */
 	switch (doc_type) {
@@ -110,7 +111,7 @@ char *oval_determine_document_schema_version_priv(xmlTextReader *reader, oscap_d
 		return NULL;
 	}
 	/* find generator */
-	while (xmlTextReaderRead(reader) == 1
+	while (xmlTextReaderNextNode(reader) == 1
 	       && xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT);
 	elm_name = (const char *) xmlTextReaderConstLocalName(reader);
 	if (!elm_name || strcmp(elm_name, "generator")) {
@@ -119,7 +120,7 @@ char *oval_determine_document_schema_version_priv(xmlTextReader *reader, oscap_d
 	}
 	/* find schema_version */
 	depth = xmlTextReaderDepth(reader);
-	while (xmlTextReaderRead(reader) == 1 && xmlTextReaderDepth(reader) > depth) {
+	while (xmlTextReaderNextNode(reader) == 1 && xmlTextReaderDepth(reader) > depth) {
 		if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT)
 			continue;
 
@@ -148,7 +149,8 @@ int oval_definition_model_parse(xmlTextReaderPtr reader, struct oval_parser_cont
 	int depth = xmlTextReaderDepth(reader);
 	int ret = 0;
 
-	xmlTextReaderRead(reader);
+	if (xmlTextReaderNextNode(reader) != 1)
+		return -1;
 	while ((xmlTextReaderDepth(reader) > depth) && (ret != -1 )) {
 		if (xmlTextReaderNodeType(reader) == XML_READER_TYPE_ELEMENT) {
 			char *tagname = (char *)xmlTextReaderLocalName(reader);
@@ -171,13 +173,13 @@ int oval_definition_model_parse(xmlTextReaderPtr reader, struct oval_parser_cont
 				ret = oval_parser_parse_tag(reader, context, &oval_generator_parse_tag, gen);
 			} else {
 				dW("Unprocessed tag: <%s:%s>.", namespace, tagname);
-				oval_parser_skip_tag(reader, context);
+				ret = oval_parser_skip_tag(reader, context);
 			}
 
 			free(tagname);
 			free(namespace);
 		} else {
-			if (xmlTextReaderRead(reader) != 1) {
+			if (xmlTextReaderNextNode(reader) != 1) {
 				ret = -1;
 				break;
 			}
@@ -193,9 +195,10 @@ int oval_parser_skip_tag(xmlTextReaderPtr reader, struct oval_parser_context *co
 	int ret = 0;
 	int depth = xmlTextReaderDepth(reader);
 
-	xmlTextReaderRead(reader);
+	if (xmlTextReaderNextNode(reader) != 1)
+		return -1;
 	while ( xmlTextReaderDepth(reader) > depth )  {
-		if (xmlTextReaderRead(reader) != 1) {
+		if (xmlTextReaderNextNode(reader) != 1) {
 			ret = -1;
                         break;
 		}
@@ -25,6 +25,7 @@
 #endif
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
@@ -48,6 +49,7 @@
 #include "_oval_probe_handler.h"
 #include "oval_probe_ext.h"
 #include "collectVarRefs_impl.h"
+#include "adt/oval_collection_impl.h"
 
 #ifdef OS_WINDOWS
 #define X_OK 0
@@ -167,6 +169,212 @@ int oval_probe_query_object(oval_probe_session_t *psess, struct oval_object *obj
 	return 0;
 }
 
+/*
+ * Objects which may be collected concurrently with other objects. Collection
+ * of objects with sets or variable references may require other objects to be
+ * collected first, these are always collected one by one by the regular path.
+ */
+static bool _oval_probe_object_is_independent(struct oval_object *object)
+{
+	struct oval_object_content_iterator *cont_itr;
+	struct oval_string_map *vm;
+	struct oval_iterator *var_itr;
+	bool independent = true;
+
+	cont_itr = oval_object_get_object_contents(object);
+	while (oval_object_content_iterator_has_more(cont_itr)) {
+		struct oval_object_content *cont = oval_object_content_iterator_next(cont_itr);
+
+		if (oval_object_content_get_type(cont) == OVAL_OBJECTCONTENT_SET) {
+			independent = false;
+			break;
+		}
+	}
+	oval_object_content_iterator_free(cont_itr);
+
+	if (!independent)
+		return false;
+
+	vm = oval_string_map_new();
+	oval_obj_collect_var_refs(object, vm);
+	var_itr = oval_string_map_values(vm);
+	independent = !oval_collection_iterator_has_more(var_itr);
+	oval_collection_iterator_free(var_itr);
+	oval_string_map_free(vm, NULL);
+
+	return independent;
+}
+
+/* Independent objects of the walked definitions */
+struct _oval_probe_prefetch {
+	struct oval_string_map *seen;    /* ids of the objects already in the list */
+	struct oval_collection *objects; /* objects in the order the definitions use them */
+	struct oval_string_map *visited; /* ids of the walked definitions, extend_definition may be circular */
+};
+
+static void _oval_probe_prefetch_init(struct _oval_probe_prefetch *prefetch)
+{
+	prefetch->seen = oval_string_map_new();
+	prefetch->objects = oval_collection_new();
+	prefetch->visited = oval_string_map_new();
+}
+
+static void _oval_probe_prefetch_clear(struct _oval_probe_prefetch *prefetch)
+{
+	oval_string_map_free(prefetch->seen, NULL);
+	oval_collection_free(prefetch->objects);
+	oval_string_map_free(prefetch->visited, NULL);
+}
+
+static void _oval_probe_collect_criteria(oval_probe_session_t *sess, struct oval_criteria_node *cnode,
+					 struct _oval_probe_prefetch *prefetch)
+{
+	switch (oval_criteria_node_get_type(cnode)) {
+	case OVAL_NODETYPE_CRITERION:{
+		struct oval_test *test = oval_criteria_node_get_test(cnode);
+		if (test == NULL)
+			return;
+		struct oval_object *object = oval_test_get_object(test);
+		if (object == NULL)
+			return;
+		if (oval_test_get_subtype(test) != oval_object_get_subtype(object))
+			return;
+		const char *oid = oval_object_get_id(object);
+		if (oval_string_map_get_value(prefetch->seen, oid) != NULL ||
+		    oval_syschar_model_get_syschar(sess->sys_model, oid) != NULL)
+			return;
+		oval_string_map_put(prefetch->seen, oid, object);
+		if (_oval_probe_object_is_independent(object))
+			oval_collection_add(prefetch->objects, object);
+		return;
+	}
+	case OVAL_NODETYPE_CRITERIA:{
+		struct oval_criteria_node_iterator *cnode_it = oval_criteria_node_get_subnodes(cnode);
+		if (cnode_it == NULL)
+			return;
+		while (oval_criteria_node_iterator_has_more(cnode_it)) {
+			struct oval_criteria_node *node = oval_criteria_node_iterator_next(cnode_it);
+			_oval_probe_collect_criteria(sess, node, prefetch);
+		}
+		oval_criteria_node_iterator_free(cnode_it);
+		return;
+	}
+	case OVAL_NODETYPE_EXTENDDEF:{
+		struct oval_definition *oval_def = oval_criteria_node_get_definition(cnode);
+		if (oval_def == NULL)
+			return;
+		const char *defid = oval_definition_get_id(oval_def);
+		if (oval_string_map_get_value(prefetch->visited, defid) != NULL)
+			return;
+		oval_string_map_put(prefetch->visited, defid, oval_def);
+		struct oval_criteria_node *def_cnode = oval_definition_get_criteria(oval_def);
+		if (def_cnode != NULL)
+			_oval_probe_collect_criteria(sess, def_cnode, prefetch);
+		return;
+	}
+	default:
+		return;
+	}
+}
+
+/*
+ * The syschars are added to the system characteristics model in the order
+ * in which the definitions use their objects, as in sequential collection.
+ */
+static int _oval_probe_query_objects(oval_probe_session_t *sess, struct oval_collection *objects)
+{
+	struct oval_syschar **syschars;
+	struct oval_iterator *obj_itr;
+	size_t count = 0, size = 32;
+	oval_ph_t *ph;
+	int ret;
+
+	ph = oval_probe_handler_get(sess->ph, OVAL_SUBTYPE_ALL);
+	if (ph == NULL)
+		return 0;
+
+	syschars = malloc(size * sizeof(struct oval_syschar *));
+	obj_itr = oval_collection_iterator(objects);
+	while (oval_collection_iterator_has_more(obj_itr)) {
+		struct oval_object *object = oval_collection_iterator_next(obj_itr);
+
+		if (oval_probe_handler_get(sess->ph, oval_object_get_subtype(object)) == NULL)
+			continue;
+		if (count == size) {
+			size *= 2;
+			syschars = realloc(syschars, size * sizeof(struct oval_syschar *));
+		}
+		syschars[count++] = oval_syschar_new(sess->sys_model, object);
+	}
+	oval_collection_iterator_free(obj_itr);
+
+	if (count == 0) {
+		free(syschars);
+		return 0;
+	}
+
+	ret = ph->func(OVAL_SUBTYPE_ALL, ph->uptr, PROBE_HANDLER_ACT_COLLECT, syschars, count);
+	if (ret != 0)
+		dW("Concurrent collection of %zu objects failed, the remaining objects will be collected sequentially.", count);
+
+	free(syschars);
+	return 0;
+}
+
+int oval_probe_query_definition(oval_probe_session_t *sess, struct oval_definition *definition)
+{
+	struct oval_criteria_node *cnode;
+	struct _oval_probe_prefetch prefetch;
+	int ret;
+
+	cnode = oval_definition_get_criteria(definition);
+	if (cnode == NULL)
+		return 0;
+
+	_oval_probe_prefetch_init(&prefetch);
+	oval_string_map_put(prefetch.visited, oval_definition_get_id(definition), definition);
+	_oval_probe_collect_criteria(sess, cnode, &prefetch);
+	ret = _oval_probe_query_objects(sess, prefetch.objects);
+	_oval_probe_prefetch_clear(&prefetch);
+
+	return ret;
+}
+
+int oval_probe_query_definitions(oval_probe_session_t *sess, struct oval_definition_iterator *def_itr)
+{
+	struct _oval_probe_prefetch prefetch;
+	int ret;
+
+	_oval_probe_prefetch_init(&prefetch);
+	while (oval_definition_iterator_has_more(def_itr)) {
+		struct oval_definition *definition = oval_definition_iterator_next(def_itr);
+		const char *defid = oval_definition_get_id(definition);
+		struct oval_criteria_node *cnode;
+
+		/* already walked as an extended definition */
+		if (oval_string_map_get_value(prefetch.visited, defid) != NULL)
+			continue;
+		oval_string_map_put(prefetch.visited, defid, definition);
+
+		cnode = oval_definition_get_criteria(definition);
+		if (cnode != NULL)
+			_oval_probe_collect_criteria(sess, cnode, &prefetch);
+	}
+
+	ret = _oval_probe_query_objects(sess, prefetch.objects);
+	_oval_probe_prefetch_clear(&prefetch);
+
+	return ret;
+}
+
+int oval_probe_query_definition_model(oval_probe_session_t *sess, struct oval_definition_model *model)
+{
+	struct oval_definition_iterator *def_itr = oval_definition_model_get_definitions(model);
+	int ret = oval_probe_query_definitions(sess, def_itr);
+	oval_definition_iterator_free(def_itr);
+	return ret;
+}
+
 int oval_probe_query_sysinfo(oval_probe_session_t *sess, struct oval_sysinfo **out_sysinfo)
 {
 	struct oval_sysinfo *sysinf;
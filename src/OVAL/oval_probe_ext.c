@@ -795,6 +795,55 @@ int oval_probe_sys_handler(oval_subtype_t type, void *ptr, int act, ...)
         return(ret);
 }
 
+/*
+ * Find the descriptor of the probe which collects the object of `sys'
+ * and register a new one if the probe wasn't started yet. Returns 1
+ * and marks the syschar as not collected if there is no such probe.
+ */
+static int oval_probe_ext_getpd(oval_pext_t *pext, struct oval_syschar *sys, oval_pd_t **out_pd)
+{
+	struct oval_object *obj = oval_syschar_get_object(sys);
+	oval_subtype_t obj_subtype = oval_object_get_subtype(obj);
+	oval_pd_t *pd = oval_pdtbl_get(pext->pdtbl, obj_subtype);
+
+	if (pd == NULL) {
+		char         probe_uri[PATH_MAX + 1];
+		size_t       probe_urilen;
+
+		if (!probe_table_exists(obj_subtype)) {
+			oval_syschar_add_new_message(sys, "OVAL object not supported", OVAL_MESSAGE_LEVEL_WARNING);
+			oval_syschar_set_flag(sys, SYSCHAR_FLAG_NOT_COLLECTED);
+			return (1);
+		}
+
+		probe_urilen = snprintf(probe_uri, sizeof probe_uri, "%s://%s",
+				OVAL_PROBE_SCHEME, oval_subtype_get_text(obj_subtype));
+
+		if (probe_urilen >= sizeof probe_uri) {
+			oscap_seterr (OSCAP_EFAMILY_GLIBC, "probe URI too long");
+			return (-1);
+		}
+
+		dI("Starting probe on URI '%s'.", probe_uri);
+
+		if (oval_pdtbl_add(pext->pdtbl, obj_subtype, -1, probe_uri) != 0) {
+			oval_syschar_add_new_message(sys, "OVAL object not supported", OVAL_MESSAGE_LEVEL_WARNING);
+			oval_syschar_set_flag(sys, SYSCHAR_FLAG_NOT_COLLECTED);
+			return (1);
+		}
+
+		pd = oval_pdtbl_get(pext->pdtbl, obj_subtype);
+
+		if (pd == NULL) {
+			oscap_seterr (OSCAP_EFAMILY_OVAL, "internal error");
+			return (-1);
+		}
+	}
+
+	*out_pd = pd;
+	return (0);
+}
+
 int oval_probe_ext_handler(oval_subtype_t type, void *ptr, int act, ...)
 {
         int          ret = 0;
@@ -807,53 +856,17 @@ int oval_probe_ext_handler(oval_subtype_t type, void *ptr, int act, ...)
         switch(act) {
         case PROBE_HANDLER_ACT_EVAL:
         {
-		struct oval_object *obj;
 		struct oval_syschar *sys;
 		int flags;
 
 		sys = va_arg(ap, struct oval_syschar *);
 		flags = va_arg(ap, int);
-		obj = oval_syschar_get_object(sys);
-		oval_subtype_t obj_subtype = oval_object_get_subtype(obj);
-		pd = oval_pdtbl_get(pext->pdtbl, obj_subtype);
-
-                if (pd == NULL) {
-                        char         probe_uri[PATH_MAX + 1];
-                        size_t       probe_urilen;
-
-			if (!probe_table_exists(obj_subtype)) {
-				oval_syschar_add_new_message(sys, "OVAL object not supported", OVAL_MESSAGE_LEVEL_WARNING);
-				oval_syschar_set_flag(sys, SYSCHAR_FLAG_NOT_COLLECTED);
-				va_end(ap);
-				return (1);
-			}
-
-			probe_urilen = snprintf(probe_uri, sizeof probe_uri, "%s://%s",
-					OVAL_PROBE_SCHEME, oval_subtype_get_text(obj_subtype));
-
-                        if (probe_urilen >= sizeof probe_uri) {
-                                oscap_seterr (OSCAP_EFAMILY_GLIBC, "probe URI too long");
-				va_end(ap);
-                                return (-1);
-                        }
 
-                        dI("Starting probe on URI '%s'.", probe_uri);
-
-                        if (oval_pdtbl_add(pext->pdtbl, obj_subtype, -1, probe_uri) != 0) {
-				oval_syschar_add_new_message(sys, "OVAL object not supported", OVAL_MESSAGE_LEVEL_WARNING);
-				oval_syschar_set_flag(sys, SYSCHAR_FLAG_NOT_COLLECTED);
-				va_end(ap);
-                                return (1);
-			}
-
-			pd = oval_pdtbl_get(pext->pdtbl, obj_subtype);
-
-                        if (pd == NULL) {
-                                oscap_seterr (OSCAP_EFAMILY_OVAL, "internal error");
-				va_end(ap);
-                                return (-1);
-                        }
-                }
+		ret = oval_probe_ext_getpd(pext, sys, &pd);
+		if (ret != 0) {
+			va_end(ap);
+			return ret;
+		}
 
 		ret = oval_probe_ext_eval(pext->pdtbl->ctx, pd, pext, sys, flags);
 
@@ -878,6 +891,16 @@ int oval_probe_ext_handler(oval_subtype_t type, void *ptr, int act, ...)
 		va_end(ap);
 		return ret;
         }
+        case PROBE_HANDLER_ACT_COLLECT:
+        {
+		struct oval_syschar **sys;
+		size_t count;
+
+		sys = va_arg(ap, struct oval_syschar **);
+		count = va_arg(ap, size_t);
+		ret = oval_probe_ext_collect(pext, sys, count);
+		break;
+        }
         case PROBE_HANDLER_ACT_OPEN:
                 break;
         case PROBE_HANDLER_ACT_INIT:
@@ -1019,6 +1042,228 @@ int oval_probe_ext_eval(SEAP_CTX_t *ctx, oval_pd_t *pd, oval_pext_t *pext, struc
 	return (ret);
 }
 
+/*
+ * State of one probe during a concurrent collection. The objects in
+ * `queue' are sent to the probe one by one; `busy' is the object for
+ * which a reply is expected.
+ */
+struct oval_pcoll {
+	oval_pd_t            *pd;
+	struct oval_syschar **queue;
+	size_t                count;
+	size_t                next;
+	struct oval_syschar  *busy;
+	SEAP_msg_t           *msg;
+};
+
+/*
+ * Close the descriptor of the probe after an error, like oval_probe_ext_eval()
+ * does. The request and its reply, if any, are dropped with it and the
+ * remaining objects are left to the regular collection path, which
+ * connects again.
+ */
+static void oval_probe_ext_collect_close(SEAP_CTX_t *ctx, struct oval_pcoll *pc)
+{
+	dD("Closing sd=%d (pd=%p) after an error", pc->pd->sd, pc->pd);
+
+	SEAP_close(ctx, pc->pd->sd);
+	pc->pd->sd = -1;
+	pc->next = pc->count;
+
+	SEAP_msg_free(pc->msg);
+	pc->msg  = NULL;
+	pc->busy = NULL;
+}
+
+static int oval_probe_ext_collect_send(SEAP_CTX_t *ctx, oval_pext_t *pext, struct oval_pcoll *pc)
+{
+	while (pc->next < pc->count) {
+		struct oval_syschar *sys = pc->queue[pc->next++];
+		struct oval_object *obj = oval_syschar_get_object(sys);
+		SEAP_msg_t *s_omsg;
+		SEXP_t *s_obj;
+
+		if (oval_object_to_sexp(pext->sess_ptr, oval_subtype_to_str(oval_object_get_subtype(obj)), sys, &s_obj) != 0)
+			continue;
+
+		if (pc->pd->sd == -1) {
+			ctx->subtype = pc->pd->subtype;
+			pc->pd->sd = SEAP_connect(ctx);
+
+			if (pc->pd->sd < 0) {
+				dW("Can't connect: %u, %s.", errno, strerror(errno));
+				pc->pd->sd = -1;
+				pc->next = pc->count;
+				SEXP_free(s_obj);
+				return (-1);
+			}
+		}
+
+		s_omsg = SEAP_msg_new();
+		SEAP_msg_set(s_omsg, s_obj);
+		SEXP_free(s_obj);
+
+		if (SEAP_sendmsg(ctx, pc->pd->sd, s_omsg) != 0) {
+			dW("Can't send message: %u, %s.", errno, strerror(errno));
+			SEAP_msg_free(s_omsg);
+			oval_probe_ext_collect_close(ctx, pc);
+			return (-1);
+		}
+
+		pc->busy = sys;
+		pc->msg  = s_omsg;
+		return (1);
+	}
+
+	return (0);
+}
+
+static int oval_probe_ext_collect_recv(SEAP_CTX_t *ctx, struct oval_pcoll *pc)
+{
+	SEAP_msg_t *s_imsg = NULL;
+	int ret = 0;
+
+	if (SEAP_recvmsg(ctx, pc->pd->sd, &s_imsg) == 0) {
+		SEXP_t *s_sys = SEAP_msg_get(s_imsg);
+
+		ret = oval_sexp_to_sysch(s_sys, pc->busy);
+		SEXP_free(s_sys);
+		SEAP_msg_free(s_imsg);
+	} else {
+		SEAP_err_t *err = NULL;
+
+		/*
+		 * Errors reported by the probe are not fatal here. The object
+		 * keeps the unknown flag and the regular collection path will
+		 * query it again and report the error properly.
+		 */
+		if (errno == ECANCELED &&
+		    SEAP_recverr_byid(ctx, pc->pd->sd, &err, SEAP_msg_id(pc->msg)) == 0) {
+			dD("Probe reported an error for object '%s'.",
+			   oval_object_get_id(oval_syschar_get_object(pc->busy)));
+			SEAP_error_free(err);
+		} else {
+			dW("Can't receive message: %u, %s.", errno, strerror(errno));
+			oval_probe_ext_collect_close(ctx, pc);
+			return (-1);
+		}
+	}
+
+	SEAP_msg_free(pc->msg);
+	pc->msg  = NULL;
+	pc->busy = NULL;
+
+	return (ret);
+}
+
+/*
+ * Collect several objects at once. Requests for objects of different
+ * subtypes are sent without waiting for the previous replies so that the
+ * probe threads work concurrently, and the replies are processed in the
+ * order in which they arrive. At most one request is outstanding per probe.
+ * Objects which couldn't be collected here keep the unknown flag and are
+ * left to the regular (sequential) collection path.
+ */
+int oval_probe_ext_collect(oval_pext_t *pext, struct oval_syschar **syschars, size_t count)
+{
+	SEAP_CTX_t *ctx;
+	struct oval_pcoll *pcoll;
+	struct oval_syschar **queue;
+	size_t i, j, pcount;
+	int *sds, ret = 0;
+
+	if (count == 0)
+		return (0);
+	if (oval_probe_ext_init(pext) != 0)
+		return (-1);
+
+	ctx    = pext->pdtbl->ctx;
+	pcoll  = calloc(count, sizeof(struct oval_pcoll));
+	queue  = malloc(count * sizeof(struct oval_syschar *));
+	sds    = malloc(count * sizeof(int));
+	pcount = 0;
+
+	/* Group the objects by the probe which collects them */
+	for (i = 0; i < count; ++i) {
+		oval_pd_t *pd = NULL;
+
+		if (oval_probe_ext_getpd(pext, syschars[i], &pd) != 0)
+			continue;
+
+		for (j = 0; j < pcount; ++j) {
+			if (pcoll[j].pd == pd)
+				break;
+		}
+		if (j == pcount)
+			pcoll[pcount++].pd = pd;
+		++pcoll[j].count;
+	}
+
+	for (j = 0, i = 0; j < pcount; ++j) {
+		pcoll[j].queue = queue + i;
+		i += pcoll[j].count;
+		pcoll[j].count = 0;
+	}
+
+	for (i = 0; i < count; ++i) {
+		oval_pd_t *pd = oval_pdtbl_get(pext->pdtbl,
+		                               oval_object_get_subtype(oval_syschar_get_object(syschars[i])));
+
+		if (oval_syschar_get_flag(syschars[i]) != SYSCHAR_FLAG_UNKNOWN)
+			continue;
+
+		for (j = 0; j < pcount; ++j) {
+			if (pcoll[j].pd == pd) {
+				pcoll[j].queue[pcoll[j].count++] = syschars[i];
+				break;
+			}
+		}
+	}
+
+	dI("Collecting %zu objects using %zu probes.", count, pcount);
+
+	for (;;) {
+		size_t nsds = 0;
+		int idx;
+
+		for (j = 0; j < pcount; ++j) {
+			if (pcoll[j].busy == NULL && oval_probe_ext_collect_send(ctx, pext, &pcoll[j]) < 0)
+				ret = -1;
+			if (pcoll[j].busy != NULL)
+				sds[nsds++] = pcoll[j].pd->sd;
+		}
+
+		if (nsds == 0)
+			break;
+
+		idx = SEAP_poll(ctx, sds, nsds);
+		if (idx < 0) {
+			dE("SEAP_poll failed: %u, %s.", errno, strerror(errno));
+			/* the replies of the outstanding requests would be read by the next requests */
+			for (j = 0; j < pcount; ++j) {
+				if (pcoll[j].busy != NULL)
+					oval_probe_ext_collect_close(ctx, &pcoll[j]);
+			}
+			ret = -1;
+			break;
+		}
+
+		for (j = 0; j < pcount; ++j) {
+			if (pcoll[j].busy != NULL && pcoll[j].pd->sd == sds[idx]) {
+				if (oval_probe_ext_collect_recv(ctx, &pcoll[j]) != 0)
+					ret = -1;
+				break;
+			}
+		}
+	}
+
+	free(sds);
+	free(queue);
+	free(pcoll);
+
+	return (ret);
+}
+
 int oval_probe_ext_reset(SEAP_CTX_t *ctx, oval_pd_t *pd, oval_pext_t *pext)
 {
         SEAP_cmd_exec(ctx, pd->sd, SEAP_EXEC_RECV, PROBECMD_RESET, NULL, SEAP_CMDTYPE_SYNC, NULL, NULL);
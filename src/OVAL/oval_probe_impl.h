@@ -50,6 +50,17 @@
 
 int oval_probe_query_test(oval_probe_session_t *sess, struct oval_test *test);
 
+/**
+ * Collect the objects needed to evaluate a definition (or several definitions,
+ * or all definitions of a model) ahead of the evaluation. Objects collected by
+ * different probes are collected concurrently. Objects which can't be
+ * collected this way are left to @ref oval_probe_query_object called during
+ * the evaluation.
+ */
+int oval_probe_query_definition(oval_probe_session_t *sess, struct oval_definition *definition);
+int oval_probe_query_definitions(oval_probe_session_t *sess, struct oval_definition_iterator *def_itr);
+int oval_probe_query_definition_model(oval_probe_session_t *sess, struct oval_definition_model *model);
+
 
 extern probe_ncache_t *OSCAP_GSYM(ncache);
 
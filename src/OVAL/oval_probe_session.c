@@ -49,6 +49,9 @@
 #include "probe-table.h"
 #include "oval_types.h"
 #include "crapi/crapi.h"
+#ifndef OS_WINDOWS
+#include "oval_fts_cache.h"
+#endif
 
 #if defined(OSCAP_THREAD_SAFE)
 #include <pthread.h>
@@ -136,6 +139,11 @@ static void oval_probe_session_init(oval_probe_session_t *sess, struct oval_sysc
 
         __init_once();
 
+#ifndef OS_WINDOWS
+	/* directory listings cached by previous scans might be stale */
+	oval_fts_cache_reset();
+#endif
+
 	oval_probe_handler_t *probe_handler;
 	int probe_count = probe_table_size();
 	for (int i = 0; i < probe_count; i++) {
@@ -167,6 +175,9 @@ static void oval_probe_session_free(oval_probe_session_t *sess)
 
 	oval_phtbl_free(sess->ph);
 	oval_pext_free(sess->pext);
+#ifndef OS_WINDOWS
+	oval_fts_cache_reset();
+#endif
 }
 
 void oval_probe_session_reinit(oval_probe_session_t *sess, struct oval_syschar_model *model)
@@ -194,6 +205,9 @@ int oval_probe_session_reset(oval_probe_session_t *sess, struct oval_syschar_mod
         if (ph->func(OVAL_SUBTYPE_ALL, ph->uptr, PROBE_HANDLER_ACT_RESET) != 0) {
                 return(-1);
         }
+#ifndef OS_WINDOWS
+        oval_fts_cache_reset();
+#endif
         if (sysch != NULL)
                 sess->sys_model = sysch;
 
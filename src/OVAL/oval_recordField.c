@@ -479,3 +479,51 @@ xmlNode *oval_record_field_to_dom(struct oval_record_field *rf, bool parent_mask
 
 	return node;
 }
+
+void oval_record_field_cache_write(struct oscap_model_writer *writer, struct oval_record_field *rf)
+{
+	oscap_model_write_u32(writer, rf->record_field_type);
+	oscap_model_write_string(writer, rf->name);
+	oscap_model_write_string(writer, rf->value);
+	oscap_model_write_u32(writer, rf->datatype);
+	oscap_model_write_bool(writer, rf->mask);
+
+	if (rf->record_field_type == OVAL_RECORD_FIELD_STATE) {
+		struct oval_record_field_STATE *rfs = (struct oval_record_field_STATE *) rf;
+
+		oscap_model_write_u32(writer, rfs->operation);
+		oscap_model_write_string(writer, rfs->variable != NULL ? oval_variable_get_id(rfs->variable) : NULL);
+		oscap_model_write_u32(writer, rfs->var_check);
+		oscap_model_write_u32(writer, rfs->ent_check);
+	} else {
+		oscap_model_write_u32(writer, ((struct oval_record_field_ITEM *) rf)->status);
+	}
+}
+
+struct oval_record_field *oval_record_field_cache_read(struct oscap_model_reader *reader, struct oval_definition_model *model)
+{
+	struct oval_record_field *rf = oval_record_field_new(oscap_model_read_u32(reader));
+	if (rf == NULL)
+		return NULL;
+
+	rf->name = oscap_model_read_string(reader);
+	rf->value = oscap_model_read_string(reader);
+	rf->datatype = oscap_model_read_u32(reader);
+	rf->mask = oscap_model_read_bool(reader);
+
+	if (rf->record_field_type == OVAL_RECORD_FIELD_STATE) {
+		struct oval_record_field_STATE *rfs = (struct oval_record_field_STATE *) rf;
+
+		rfs->operation = oscap_model_read_u32(reader);
+		char *var_ref = oscap_model_read_string(reader);
+		if (var_ref != NULL) {
+			rfs->variable = oval_definition_model_get_new_variable(model, var_ref, OVAL_VARIABLE_UNKNOWN);
+			free(var_ref);
+		}
+		rfs->var_check = oscap_model_read_u32(reader);
+		rfs->ent_check = oscap_model_read_u32(reader);
+	} else {
+		((struct oval_record_field_ITEM *) rf)->status = oscap_model_read_u32(reader);
+	}
+	return rf;
+}
@@ -183,3 +183,19 @@ int oval_reference_parse_tag(xmlTextReaderPtr reader, struct oval_parser_context
 	return 0;
 }
 
+
+void oval_reference_cache_write(struct oscap_model_writer *writer, struct oval_reference *ref)
+{
+	oscap_model_write_string(writer, ref->source);
+	oscap_model_write_string(writer, ref->id);
+	oscap_model_write_string(writer, ref->url);
+}
+
+struct oval_reference *oval_reference_cache_read(struct oscap_model_reader *reader, struct oval_definition_model *model)
+{
+	struct oval_reference *ref = oval_reference_new(model);
+	ref->source = oscap_model_read_string(reader);
+	ref->id = oscap_model_read_string(reader);
+	ref->url = oscap_model_read_string(reader);
+	return ref;
+}
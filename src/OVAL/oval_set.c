@@ -459,3 +459,68 @@ void oval_set_propagate_filters(struct oval_definition_model *model, struct oval
 	oval_collection_free_items(ext_col->objects, NULL);
 	ext_col->objects = new_objects;
 }
+
+static void oval_set_object_ref_cache_write(struct oscap_model_writer *writer, struct oval_object *object)
+{
+	oscap_model_write_string(writer, oval_object_get_id(object));
+}
+
+static struct oval_object *oval_set_object_ref_cache_read(struct oscap_model_reader *reader, struct oval_definition_model *model)
+{
+	char *objref = oscap_model_read_string(reader);
+	if (objref == NULL)
+		return NULL;
+	struct oval_object *object = oval_definition_model_get_new_object(model, objref);
+	free(objref);
+	return object;
+}
+
+void oval_setobject_cache_write(struct oscap_model_writer *writer, struct oval_setobject *set)
+{
+	oscap_model_write_u32(writer, set->type);
+	oscap_model_write_u32(writer, set->operation);
+
+	switch (set->type) {
+	case OVAL_SET_AGGREGATE:{
+			oval_set_AGGREGATE_t *aggregate = (oval_set_AGGREGATE_t *) set->extension;
+			oval_collection_cache_write(writer, aggregate->subsets, (oval_cache_write_func) oval_setobject_cache_write);
+		}
+		break;
+	case OVAL_SET_COLLECTIVE:{
+			oval_set_COLLECTIVE_t *collective = (oval_set_COLLECTIVE_t *) set->extension;
+			oval_collection_cache_write(writer, collective->objects, (oval_cache_write_func) oval_set_object_ref_cache_write);
+			oval_collection_cache_write(writer, collective->filters, (oval_cache_write_func) oval_filter_cache_write);
+		}
+		break;
+	case OVAL_SET_UNKNOWN:
+		break;
+	}
+}
+
+struct oval_setobject *oval_setobject_cache_read(struct oscap_model_reader *reader, struct oval_definition_model *model)
+{
+	struct oval_setobject *set = oval_setobject_new(model);
+	oval_setobject_type_t type = oscap_model_read_u32(reader);
+	set->operation = oscap_model_read_u32(reader);
+
+	switch (type) {
+	case OVAL_SET_AGGREGATE:{
+			oval_setobject_set_type(set, type);
+			oval_set_AGGREGATE_t *aggregate = (oval_set_AGGREGATE_t *) set->extension;
+			oval_collection_cache_read(reader, model, aggregate->subsets, (oval_cache_read_func) oval_setobject_cache_read);
+		}
+		break;
+	case OVAL_SET_COLLECTIVE:{
+			oval_setobject_set_type(set, type);
+			oval_set_COLLECTIVE_t *collective = (oval_set_COLLECTIVE_t *) set->extension;
+			oval_collection_cache_read(reader, model, collective->objects, (oval_cache_read_func) oval_set_object_ref_cache_read);
+			oval_collection_cache_read(reader, model, collective->filters, (oval_cache_read_func) oval_filter_cache_read);
+		}
+		break;
+	case OVAL_SET_UNKNOWN:
+		break;
+	default:
+		oscap_model_reader_fail(reader);
+	}
+	return set;
+}
@@ -930,10 +930,12 @@ static struct oval_sysent *oval_sexp_to_sysent(struct oval_syschar_model *model,
 			break;
 		}
 
-		oval_sysent_set_value(ent, valp);
-		if (valp != val)
-			free(valp);
-                SEXP_free(sval);
+		/* string values are already a private copy, don't duplicate them again */
+		if (valp == val)
+			oval_sysent_set_value(ent, val);
+		else
+			oval_sysent_take_value(ent, valp);
+		SEXP_free(sval);
 	}
 
 	return ent;
@@ -943,27 +945,27 @@ static struct oval_sysitem *oval_sexp_to_sysitem(struct oval_syschar_model *mode
 {
 	_A(sexp);
 
-	char *item_name, *name, *id, *family;
+	char item_name[128], *name, id[64], *family;
 	SEXP_t *id_sexp;
 	struct oval_sysitem *sysitem = NULL;
 
 	id_sexp = probe_ent_getattrval(sexp, "id");
-	id = SEXP_string_cstr(id_sexp);
+	if (SEXP_string_cstr_r(id_sexp, id, sizeof id) == (size_t)-1 || id[0] == '\0') {
+		SEXP_free(id_sexp);
+		return NULL;
+	}
 	SEXP_free(id_sexp);
 
 	sysitem = oval_syschar_model_get_sysitem(model, id);
 
-	if (sysitem) {
-                free(id);
+	if (sysitem)
 		return sysitem;
-        }
 
-	item_name = probe_ent_getname(sexp);
+	size_t item_name_len = probe_ent_getname_r(sexp, item_name, sizeof item_name);
 
-	if (item_name == NULL) {
-                free(id);
+	if (item_name_len == 0 || item_name_len == (size_t)-1) {
 		return NULL;
-        } else {
+	} else {
 		family = item_name;
 		char *endptr = strchr(family, ':');
 		*endptr = '\0';
@@ -971,7 +973,7 @@ static struct oval_sysitem *oval_sexp_to_sysitem(struct oval_syschar_model *mode
 		endptr = strrchr(name, '_');
 
 		if (strcmp(endptr, "_item") != 0)
-			goto cleanup;
+			return NULL;
 
 		*endptr = '\0';	// cut off the '_item' part
 	}
@@ -985,6 +987,7 @@ static struct oval_sysitem *oval_sexp_to_sysitem(struct oval_syschar_model *mode
 		abort();
 #endif
 	SEXP_t *sub;
+	SEXP_list_it *sub_it;
 	struct oval_sysent *sysent;
 
 	int status = probe_ent_getstatus(sexp);
@@ -993,15 +996,21 @@ static struct oval_sysitem *oval_sexp_to_sysitem(struct oval_syschar_model *mode
 	oval_sysitem_set_status(sysitem, status);
 	oval_sysitem_set_subtype(sysitem, type);
 
-	for (int i = 2; (sub = SEXP_list_nth(sexp, i)) != NULL; ++i) {
-	    if ((sysent = oval_sexp_to_sysent(model, sysitem, sub, mask_map)) != NULL)
-		    oval_sysitem_add_sysent(sysitem, sysent);
-		SEXP_free(sub);
+	/*
+	 * Walk the entities with a list iterator: the SEXPs are borrowed from
+	 * the probe reply, so no per-entity reference or nth-element lookup.
+	 */
+	sub_it = SEXP_list_it_new(sexp);
+	if (sub_it == NULL)
+		return sysitem;
+
+	(void)SEXP_list_it_next(sub_it); /* skip the item header */
+	while ((sub = SEXP_list_it_next(sub_it)) != NULL) {
+		if ((sysent = oval_sexp_to_sysent(model, sysitem, sub, mask_map)) != NULL)
+			oval_sysitem_add_sysent(sysitem, sysent);
 	}
+	SEXP_list_it_free(sub_it);
 
- cleanup:
-        free(id);
-	free(item_name);
 	return sysitem;
 }
 
@@ -1009,6 +1018,7 @@ int oval_sexp_to_sysch(const SEXP_t *cobj, struct oval_syschar *syschar)
 {
 	oval_syschar_collection_flag_t flag;
 	SEXP_t *messages, *msg, *items, *item, *mask;
+	SEXP_list_it *item_it;
 	struct oval_syschar_model *model;
 	struct oval_string_map *itm_id_map;
         struct oval_string_map *item_mask_map;
@@ -1045,7 +1055,8 @@ int oval_sexp_to_sysch(const SEXP_t *cobj, struct oval_syschar *syschar)
         } else
             item_mask_map = NULL;
 
-	SEXP_list_foreach(item, items) {
+	item_it = items != NULL ? SEXP_list_it_new(items) : NULL;
+	while (item_it != NULL && (item = SEXP_list_it_next(item_it)) != NULL) {
 		struct oval_sysitem *sysitem;
 
 		sysitem = oval_sexp_to_sysitem(model, item, item_mask_map);
@@ -1059,6 +1070,8 @@ int oval_sexp_to_sysch(const SEXP_t *cobj, struct oval_syschar *syschar)
 			}
 		}
 	}
+	if (item_it != NULL)
+		SEXP_list_it_free(item_it);
 	SEXP_free(items);
 	oval_string_map_free(itm_id_map, NULL);
         if (item_mask_map != NULL)
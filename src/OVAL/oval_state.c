@@ -386,3 +386,33 @@ xmlNode *oval_state_to_dom(struct oval_state *state, xmlDoc * doc, xmlNode * par
 	oval_state_content_iterator_free(contents);
 	return state_node;
 }
+
+void oval_state_cache_write(struct oscap_model_writer *writer, struct oval_state *state)
+{
+	oscap_model_write_string(writer, state->id);
+	oscap_model_write_u32(writer, state->subtype);
+	oscap_model_write_string(writer, state->comment);
+	oscap_model_write_bool(writer, state->deprecated);
+	oscap_model_write_i64(writer, state->version);
+	oscap_model_write_u32(writer, state->operator);
+	oval_collection_cache_write(writer, state->notes, oval_string_cache_write);
+	oval_collection_cache_write(writer, state->contents, (oval_cache_write_func) oval_state_content_cache_write);
+}
+
+struct oval_state *oval_state_cache_read(struct oscap_model_reader *reader, struct oval_definition_model *model)
+{
+	char *id = oscap_model_read_string(reader);
+	if (id == NULL)
+		return NULL;
+	struct oval_state *state = oval_definition_model_get_new_state(model, id);
+	free(id);
+
+	state->subtype = oscap_model_read_u32(reader);
+	state->comment = oscap_model_read_string(reader);
+	state->deprecated = oscap_model_read_bool(reader);
+	state->version = oscap_model_read_i64(reader);
+	state->operator = oscap_model_read_u32(reader);
+	oval_collection_cache_read(reader, model, state->notes, oval_string_cache_read);
+	oval_collection_cache_read(reader, model, state->contents, (oval_cache_read_func) oval_state_content_cache_read);
+	return state;
+}
@@ -278,3 +278,26 @@ xmlNode *oval_state_content_to_dom(struct oval_state_content * content, xmlDoc *
 
 	return content_node;
 }
+
+void oval_state_content_cache_write(struct oscap_model_writer *writer, struct oval_state_content *content)
+{
+	oscap_model_write_bool(writer, content->entity != NULL);
+	if (content->entity != NULL)
+		oval_entity_cache_write(writer, content->entity);
+	oval_collection_cache_write(writer, content->record_fields, (oval_cache_write_func) oval_record_field_cache_write);
+	oscap_model_write_u32(writer, content->ent_check);
+	oscap_model_write_u32(writer, content->var_check);
+	oscap_model_write_u32(writer, content->check_existence);
+}
+
+struct oval_state_content *oval_state_content_cache_read(struct oscap_model_reader *reader, struct oval_definition_model *model)
+{
+	struct oval_state_content *content = oval_state_content_new(model);
+	if (oscap_model_read_bool(reader))
+		content->entity = oval_entity_cache_read(reader, model);
+	oval_collection_cache_read(reader, model, content->record_fields, (oval_cache_read_func) oval_record_field_cache_read);
+	content->ent_check = oscap_model_read_u32(reader);
+	content->var_check = oscap_model_read_u32(reader);
+	content->check_existence = oscap_model_read_u32(reader);
+	return content;
+}
@@ -205,6 +205,14 @@ void oval_sysent_set_value(struct oval_sysent *sysent, char *value)
 	sysent->value = oscap_strdup(value);
 }
 
+void oval_sysent_take_value(struct oval_sysent *sysent, char *value)
+{
+	__attribute__nonnull__(sysent);
+	if (sysent->value != NULL)
+		free(sysent->value);
+	sysent->value = value;
+}
+
 void oval_sysent_add_record_field(struct oval_sysent *sysent, struct oval_record_field *rf)
 {
 	if (sysent->record_fields == NULL)
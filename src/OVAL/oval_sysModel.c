@@ -49,6 +49,7 @@
 #include "common/debug_priv.h"
 #include "common/_error.h"
 #include "common/elements.h"
+#include "common/xml_stream.h"
 #include "oscap_source.h"
 #include "source/oscap_source_priv.h"
 
@@ -244,11 +245,11 @@ int oval_syschar_model_import_source(struct oval_syschar_model *model, struct os
         context.user_data = NULL;
 
 	/* jump into oval_system_characteristics */
-	xmlTextReaderRead(context.reader);
+	xmlTextReaderNextNode(context.reader);
 	/* make sure this is syschar */
 	char *tagname = (char *)xmlTextReaderLocalName(context.reader);
 	char *namespace = (char *)xmlTextReaderNamespaceUri(context.reader);
-	int is_ovalsys = strcmp((const char *)OVAL_SYSCHAR_NAMESPACE, namespace) == 0;
+	int is_ovalsys = oscap_strcmp((const char *)OVAL_SYSCHAR_NAMESPACE, namespace) == 0;
 	/* start parsing */
 	if (is_ovalsys && (strcmp(tagname, OVAL_ROOT_ELM_SYSCHARS) == 0)) {
 		ret = oval_syschar_model_parse(context.reader, &context);
@@ -260,7 +261,9 @@ int oval_syschar_model_import_source(struct oval_syschar_model *model, struct os
 
 	free(tagname);
 	free(namespace);
-	xmlFreeTextReader(context.reader);
+	if (oscap_source_free_xmlTextReader(context.reader) != 0) {
+		ret = -1;
+	}
 	return ret;
 }
 
@@ -368,6 +371,7 @@ xmlNode *oval_syschar_model_to_dom(struct oval_syschar_model * syschar_model, xm
 			    || oval_object_get_base_obj(object)) /* Skip internal objects */
 				continue;
 			oval_syschar_to_dom(syschar, doc, tag_objects);
+			oscap_xml_stream_flush(doc, tag_objects);
 			struct oval_sysitem_iterator *sysitems = oval_syschar_get_sysitem(syschar);
 			while (oval_sysitem_iterator_has_more(sysitems)) {
 				struct oval_sysitem *sysitem = oval_sysitem_iterator_next(sysitems);
@@ -386,6 +390,7 @@ xmlNode *oval_syschar_model_to_dom(struct oval_syschar_model * syschar_model, xm
 			struct oval_sysitem *sysitem = (struct oval_sysitem *)
 			    oval_collection_iterator_next(sysitems);
 			oval_sysitem_to_dom(sysitem, doc, tag_items);
+			oscap_xml_stream_flush(doc, tag_items);
 		}
 	}
 	oval_collection_iterator_free(sysitems);
@@ -407,7 +412,13 @@ int oval_syschar_model_export(struct oval_syschar_model *model, const char *file
 		return -1;
 	}
 
+	if (!oscap_xml_stream_open(doc, file)) {
+		xmlFreeDoc(doc);
+		return -1;
+	}
 	oval_syschar_model_to_dom(model, doc, NULL, NULL, NULL, true);
-	return oscap_xml_save_filename_free(file, doc);
+	int ret = oscap_xml_stream_close(doc);
+	xmlFreeDoc(doc);
+	return ret;
 }
 
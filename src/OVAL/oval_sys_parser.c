@@ -51,7 +51,8 @@ int oval_syschar_model_parse(xmlTextReaderPtr reader, struct oval_parser_context
 	int depth = xmlTextReaderDepth(reader);
 	int ret = 0;
 
-	xmlTextReaderRead(reader);
+	if (xmlTextReaderNextNode(reader) != 1)
+		return -1;
 	while ((xmlTextReaderDepth(reader) > depth) && (ret != -1 )) {
 		if (xmlTextReaderNodeType(reader) == XML_READER_TYPE_ELEMENT) {
 			char *tagname = (char *)xmlTextReaderLocalName(reader);
@@ -70,13 +71,13 @@ int oval_syschar_model_parse(xmlTextReaderPtr reader, struct oval_parser_context
 				ret = oval_parser_parse_tag(reader, context, &oval_sysitem_parse_tag, NULL);
 			} else {
 				dW("Unprocessed tag: <%s:%s>.", namespace, tagname);
-				oval_parser_skip_tag(reader, context);
+				ret = oval_parser_skip_tag(reader, context);
 			}
 
 			free(tagname);
 			free(namespace);
 		} else {
-			if (xmlTextReaderRead(reader) != 1) {
+			if (xmlTextReaderNextNode(reader) != 1) {
 				ret = -1;
 				break;
 			}
@@ -62,6 +62,8 @@ typedef void (*oval_sysent_consumer) (struct oval_sysent *, void *client);
 int oval_sysent_parse_tag(xmlTextReaderPtr, struct oval_parser_context *, oval_sysent_consumer, void *);
 void oval_sysent_to_dom(struct oval_sysent *sysent, xmlDoc * doc, xmlNode * tag_parent);
 void oval_sysent_to_print(struct oval_sysent *, char *, int);
+/* like oval_sysent_set_value(), but takes ownership of a heap allocated value */
+void oval_sysent_take_value(struct oval_sysent *sysent, char *value);
 
 /* syschar_model */
 typedef bool oval_syschar_resolver(struct oval_syschar *, void *);
@@ -515,3 +515,58 @@ xmlNode *oval_test_to_dom(struct oval_test *test, xmlDoc * doc, xmlNode * parent
 
 	return test_node;
 }
+
+static void oval_test_state_ref_cache_write(struct oscap_model_writer *writer, struct oval_state *state)
+{
+	oscap_model_write_string(writer, oval_state_get_id(state));
+}
+
+static struct oval_state *oval_test_state_ref_cache_read(struct oscap_model_reader *reader, struct oval_definition_model *model)
+{
+	char *ste_ref = oscap_model_read_string(reader);
+	if (ste_ref == NULL)
+		return NULL;
+	struct oval_state *state = oval_definition_model_get_new_state(model, ste_ref);
+	free(ste_ref);
+	return state;
+}
+
+void oval_test_cache_write(struct oscap_model_writer *writer, struct oval_test *test)
+{
+	oscap_model_write_string(writer, test->id);
+	oscap_model_write_u32(writer, test->subtype);
+	oval_collection_cache_write(writer, test->notes, oval_string_cache_write);
+	oscap_model_write_string(writer, test->comment);
+	oscap_model_write_bool(writer, test->deprecated);
+	oscap_model_write_i64(writer, test->version);
+	oscap_model_write_u32(writer, test->existence);
+	oscap_model_write_u32(writer, test->check);
+	oscap_model_write_u32(writer, test->state_operator);
+	oscap_model_write_string(writer, test->object != NULL ? oval_object_get_id(test->object) : NULL);
+	oval_collection_cache_write(writer, test->states, (oval_cache_write_func) oval_test_state_ref_cache_write);
+}
+
+struct oval_test *oval_test_cache_read(struct oscap_model_reader *reader, struct oval_definition_model *model)
+{
+	char *id = oscap_model_read_string(reader);
+	if (id == NULL)
+		return NULL;
+	struct oval_test *test = oval_definition_model_get_new_test(model, id);
+	free(id);
+
+	test->subtype = oscap_model_read_u32(reader);
+	oval_collection_cache_read(reader, model, test->notes, oval_string_cache_read);
+	test->comment = oscap_model_read_string(reader);
+	test->deprecated = oscap_model_read_bool(reader);
+	test->version = oscap_model_read_i64(reader);
+	test->existence = oscap_model_read_u32(reader);
+	test->check = oscap_model_read_u32(reader);
+	test->state_operator = oscap_model_read_u32(reader);
+	char *obj_ref = oscap_model_read_string(reader);
+	if (obj_ref != NULL) {
+		test->object = oval_definition_model_get_new_object(model, obj_ref);
+		free(obj_ref);
+	}
+	oval_collection_cache_read(reader, model, test->states, (oval_cache_read_func) oval_test_state_ref_cache_read);
+	return test;
+}
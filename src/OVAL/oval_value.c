@@ -41,6 +41,7 @@
 #include "common/util.h"
 #include "common/debug_priv.h"
 #include "common/elements.h"
+#include "oscap_helpers.h"
 
 typedef struct oval_value {
 	oval_datatype_t datatype;
@@ -172,9 +173,12 @@ void oval_value_set_text(struct oval_value *value, char *text)
 }
 */
 
+/* The value is split into several nodes by CDATA sections or comments */
 static void oval_value_parse_tag_consume_text(char *string, void *text)
 {
-	*(char **)text = oscap_strdup(string);
+	char *prefix = *(char **)text;
+	*(char **)text = prefix == NULL ? oscap_strdup(string) : oscap_sprintf("%s%s", prefix, string);
+	free(prefix);
 }
 
 int oval_value_parse_tag(xmlTextReaderPtr reader,
@@ -198,3 +202,18 @@ int oval_value_parse_tag(xmlTextReaderPtr reader,
 xmlNode *oval_value_to_dom(struct oval_value *value, xmlDoc * doc, xmlNode * parent) {
 	return NULL;		//TODO: implement oval_value_to_dom
 }
+
+void oval_value_cache_write(struct oscap_model_writer *writer, struct oval_value *value)
+{
+	oscap_model_write_u32(writer, value->datatype);
+	oscap_model_write_string(writer, value->text);
+}
+
+struct oval_value *oval_value_cache_read(struct oscap_model_reader *reader, struct oval_definition_model *model)
+{
+	oval_datatype_t datatype = oscap_model_read_u32(reader);
+	char *text = oscap_model_read_string(reader);
+	struct oval_value *value = oval_value_new(datatype, text);
+	free(text);
+	return value;
+}
@@ -192,7 +192,7 @@ static int _oval_variable_model_parse_variable_values
 	if (is_variable_ns && oscap_strcmp("value", tagname) == 0) {
 		struct oval_value *ov;
 
-		return_code = xmlTextReaderRead(reader);
+		return_code = xmlTextReaderNextNode(reader);
 		char *value = (char *)xmlTextReaderValue(reader);
 		ov = oval_value_new(frame->datatype, value);
 		oval_collection_add(frame->values, ov);
@@ -307,14 +307,13 @@ struct oval_variable_model *oval_variable_model_import_source(struct oscap_sourc
                 return NULL;
 	}
 
-	xmlTextReaderRead(reader);
+	xmlTextReaderNextNode(reader);
 	struct oval_variable_model *model = oval_variable_model_new();
 	ret = _oval_variable_model_parse(model, reader, NULL);
-	if (ret != 1) {
+	if (oscap_source_free_xmlTextReader(reader) != 0 || ret != 1) {
 		oval_variable_model_free(model);
 		model = NULL;
 	}
-	xmlFreeTextReader(reader);
 	return model;
 
 }
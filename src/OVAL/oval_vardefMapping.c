@@ -33,7 +33,9 @@ static void _oval_object_fill_vardef(struct oval_object *object, struct oval_str
 static void _oval_setobject_fill_vardef(struct oval_setobject *set, struct oval_string_map *vardef, const char *definition_id);
 static void _oval_state_fill_vardef(struct oval_state *state, struct oval_string_map *vardef, const char *definition_id);
 static void _oval_entity_fill_vardef(struct oval_entity *entity, struct oval_string_map *vardef, const char *definition_id);
-static void _vardef_insert(struct oval_string_map *vardef, const char *definition_id, const char *variable_id);
+static void _oval_variable_fill_vardef(struct oval_variable *variable, struct oval_string_map *vardef, const char *dependent_id);
+static void _oval_component_fill_vardef(struct oval_component *component, struct oval_string_map *vardef, const char *dependent_id);
+static bool _vardef_insert(struct oval_string_map *vardef, const char *definition_id, const char *variable_id);
 
 struct oval_string_map *oval_definition_model_build_vardef_mapping(struct oval_definition_model *model)
 {
@@ -47,6 +49,22 @@ struct oval_string_map *oval_definition_model_build_vardef_mapping(struct oval_d
 	return vardef;
 }
 
+struct oval_string_map *oval_definition_model_build_vardep_mapping(struct oval_definition_model *model)
+{
+	struct oval_string_map *vardep = oval_string_map_new();
+	struct oval_variable_iterator *var_it = oval_definition_model_get_variables(model);
+	while (oval_variable_iterator_has_more(var_it)) {
+		struct oval_variable *variable = oval_variable_iterator_next(var_it);
+		if (oval_variable_get_type(variable) != OVAL_VARIABLE_LOCAL)
+			continue;
+		struct oval_component *component = oval_variable_get_component(variable);
+		if (component != NULL)
+			_oval_component_fill_vardef(component, vardep, oval_variable_get_id(variable));
+	}
+	oval_variable_iterator_free(var_it);
+	return vardep;
+}
+
 void _oval_definition_fill_vardef(struct oval_definition *definition, struct oval_string_map *vardef)
 {
 	struct oval_criteria_node *cnode = oval_definition_get_criteria(definition);
@@ -116,6 +134,12 @@ void _oval_object_fill_vardef(struct oval_object *object, struct oval_string_map
 			struct oval_setobject *set = oval_object_content_get_setobject(content);
 			_oval_setobject_fill_vardef(set, vardef, definition_id);
 			} break;
+		case OVAL_OBJECTCONTENT_FILTER:{
+			struct oval_filter *filter = oval_object_content_get_filter(content);
+			struct oval_state *state = oval_filter_get_state(filter);
+			if (state != NULL)
+				_oval_state_fill_vardef(state, vardef, definition_id);
+			} break;
 		default:
 			break;
 		}
@@ -173,16 +197,57 @@ void _oval_entity_fill_vardef(struct oval_entity *entity, struct oval_string_map
 		oval_entity_get_varref_type(entity) == OVAL_ENTITY_VARREF_ELEMENT) {
 		struct oval_variable *variable = oval_entity_get_variable(entity);
 		if (variable != NULL)
-			_vardef_insert(vardef, definition_id, oval_variable_get_id(variable));
+			_oval_variable_fill_vardef(variable, vardef, definition_id);
 	}
 }
 
-void _vardef_insert(struct oval_string_map *vardef, const char *definition_id, const char *variable_id)
+void _oval_variable_fill_vardef(struct oval_variable *variable, struct oval_string_map *vardef, const char *dependent_id)
+{
+	/* Stop when the variable has been already visited, this also ends reference cycles */
+	if (!_vardef_insert(vardef, dependent_id, oval_variable_get_id(variable)))
+		return;
+	/* Whatever the local variable depends on, the dependent depends on as well */
+	if (oval_variable_get_type(variable) == OVAL_VARIABLE_LOCAL) {
+		struct oval_component *component = oval_variable_get_component(variable);
+		if (component != NULL)
+			_oval_component_fill_vardef(component, vardef, dependent_id);
+	}
+}
+
+void _oval_component_fill_vardef(struct oval_component *component, struct oval_string_map *vardef, const char *dependent_id)
+{
+	switch (oval_component_get_type(component)) {
+	case OVAL_COMPONENT_OBJECTREF:{
+		struct oval_object *object = oval_component_get_object(component);
+		if (object != NULL)
+			_oval_object_fill_vardef(object, vardef, dependent_id);
+		} break;
+	case OVAL_COMPONENT_VARREF:{
+		struct oval_variable *variable = oval_component_get_variable(component);
+		if (variable != NULL)
+			_oval_variable_fill_vardef(variable, vardef, dependent_id);
+		} break;
+	default:{
+		struct oval_component_iterator *subcomp_it = oval_component_get_function_components(component);
+		if (subcomp_it == NULL)
+			break;
+		while (oval_component_iterator_has_more(subcomp_it)) {
+			struct oval_component *subcomp = oval_component_iterator_next(subcomp_it);
+			_oval_component_fill_vardef(subcomp, vardef, dependent_id);
+		}
+		oval_component_iterator_free(subcomp_it);
+		} break;
+	}
+}
+
+bool _vardef_insert(struct oval_string_map *vardef, const char *definition_id, const char *variable_id)
 {
 	struct oval_string_map *def_list = (struct oval_string_map *) oval_string_map_get_value(vardef, variable_id);
 	if (def_list == NULL) {
 		def_list = oval_string_map_new();
 		oval_string_map_put(vardef, variable_id, def_list);
-	}
+	} else if (oval_string_map_get_value(def_list, definition_id) != NULL)
+		return false;
 	oval_string_map_put(def_list, definition_id, (void *) "");
+	return true;
 }
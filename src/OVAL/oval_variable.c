@@ -43,6 +43,7 @@
 #include "common/debug_priv.h"
 #include "common/_error.h"
 #include "common/oscap_string.h"
+#include "common/xmltext_priv.h"
 #include "results/oval_cmp_impl.h"
 #include "results/oval_results_impl.h"
 #include "public/oval_probe.h"
@@ -429,6 +430,12 @@ int oval_syschar_model_compute_variable(struct oval_syschar_model *sysmod, struc
 	if (var->flag != SYSCHAR_FLAG_UNKNOWN)
 		return 0;
 
+	if (oval_definition_model_is_variable_circular(var->model, variable)) {
+		dE("Circular dependency in OVAL variable '%s'.", var->id);
+		var->flag = SYSCHAR_FLAG_ERROR;
+		return 0;
+	}
+
 	component = var->component;
         if (component) {
 		if (!var->values)
@@ -513,6 +520,12 @@ int oval_probe_query_variable(oval_probe_session_t *sess, struct oval_variable *
 	if (var->flag != SYSCHAR_FLAG_UNKNOWN)
 		return 0;
 
+	if (oval_definition_model_is_variable_circular(var->model, variable)) {
+		dE("Circular dependency in OVAL variable '%s'.", var->id);
+		var->flag = SYSCHAR_FLAG_ERROR;
+		return 0;
+	}
+
 	component = var->component;
         if (component) {
 		if (!var->values)
@@ -872,11 +885,6 @@ void oval_variable_clear_values(struct oval_variable *variable)
 {
 	__attribute__nonnull__(variable);
 
-	if (variable->type != OVAL_VARIABLE_CONSTANT && variable->type != OVAL_VARIABLE_EXTERNAL) {
-		dW("Wrong variable type for this operation: %d.", variable->type);
-		return;
-        }
-
 	switch (variable->type) {
 	case OVAL_VARIABLE_CONSTANT: {
 		oval_variable_CONSTANT_t *cvar;
@@ -899,7 +907,21 @@ void oval_variable_clear_values(struct oval_variable *variable)
 
 		break;
 	}
+	case OVAL_VARIABLE_LOCAL: {
+		oval_variable_LOCAL_t *lvar;
+
+		/* the values are computed again on the next use */
+		lvar = (oval_variable_LOCAL_t *) variable;
+		if (lvar->values) {
+			oval_collection_free_items(lvar->values, (oscap_destruct_func) oval_value_free);
+			lvar->values = NULL;
+		}
+		lvar->flag = SYSCHAR_FLAG_UNKNOWN;
+
+		break;
+	}
 	default:
+		dW("Wrong variable type for this operation: %d.", variable->type);
 		break;
 	}
 }
@@ -1017,7 +1039,7 @@ static int _oval_variable_parse_restriction_tag(xmlTextReaderPtr reader, struct
 	struct oval_variable_possible_restriction *pr = (struct oval_variable_possible_restriction *)user;
 	int return_code;
 	oval_operation_t operation = oval_operation_parse(reader, "operation", OVAL_OPERATION_EQUALS);
-	if (xmlTextReaderRead(reader) == 1) {
+	if (xmlTextReaderNextNode(reader) == 1) {
 		char *value = (char *)xmlTextReaderValue(reader);
 		struct oval_variable_restriction *restriction = oval_variable_restriction_new(operation, value);
 		oval_variable_possible_restriction_add_restriction(pr, restriction);
@@ -1037,7 +1059,7 @@ static int _oval_variable_parse_external_tag(xmlTextReaderPtr reader, struct ova
 	int return_code;
 	if (strcmp(tagname, "possible_value") == 0) {
 		char *hint = (char *)xmlTextReaderGetAttribute(reader, BAD_CAST "hint");
-		if (xmlTextReaderRead(reader) == 1) {
+		if (xmlTextReaderNextNode(reader) == 1) {
 			char *value = (char *)xmlTextReaderValue(reader);
 			struct oval_variable_possible_value *pv = oval_variable_possible_value_new(hint, value);
 			oval_variable_add_possible_value(variable, pv);
@@ -1267,3 +1289,136 @@ xmlNode *oval_variable_to_dom(struct oval_variable * variable, xmlDoc * doc, xml
 
 	return variable_node;
 }
+
+static void oval_variable_possible_value_cache_write(struct oscap_model_writer *writer, struct oval_variable_possible_value *pv)
+{
+	oscap_model_write_string(writer, pv->hint);
+	oscap_model_write_string(writer, pv->value);
+}
+
+static struct oval_variable_possible_value *oval_variable_possible_value_cache_read(struct oscap_model_reader *reader, struct oval_definition_model *model)
+{
+	char *hint = oscap_model_read_string(reader);
+	char *value = oscap_model_read_string(reader);
+	struct oval_variable_possible_value *pv = oval_variable_possible_value_new(hint, value);
+	free(hint);
+	free(value);
+	return pv;
+}
+
+static void oval_variable_restriction_cache_write(struct oscap_model_writer *writer, struct oval_variable_restriction *r)
+{
+	oscap_model_write_u32(writer, r->operation);
+	oscap_model_write_string(writer, r->value);
+}
+
+static struct oval_variable_restriction *oval_variable_restriction_cache_read(struct oscap_model_reader *reader, struct oval_definition_model *model)
+{
+	oval_operation_t operation = oscap_model_read_u32(reader);
+	char *value = oscap_model_read_string(reader);
+	struct oval_variable_restriction *r = oval_variable_restriction_new(operation, value);
+	free(value);
+	return r;
+}
+
+static void oval_variable_possible_restriction_cache_write(struct oscap_model_writer *writer, struct oval_variable_possible_restriction *pr)
+{
+	oscap_model_write_u32(writer, pr->operator);
+	oscap_model_write_string(writer, pr->hint);
+	oval_collection_cache_write(writer, pr->restrictions, (oval_cache_write_func) oval_variable_restriction_cache_write);
+}
+
+static struct oval_variable_possible_restriction *oval_variable_possible_restriction_cache_read(struct oscap_model_reader *reader, struct oval_definition_model *model)
+{
+	oval_operator_t operator = oscap_model_read_u32(reader);
+	char *hint = oscap_model_read_string(reader);
+	struct oval_variable_possible_restriction *pr = oval_variable_possible_restriction_new(operator, hint);
+	free(hint);
+	oval_collection_cache_read(reader, model, pr->restrictions, (oval_cache_read_func) oval_variable_restriction_cache_read);
+	return pr;
+}
+
+void oval_variable_cache_write(struct oscap_model_writer *writer, struct oval_variable *variable)
+{
+	oscap_model_write_u32(writer, variable->type);
+	oscap_model_write_string(writer, variable->id);
+	oscap_model_write_u32(writer, variable->flag);
+	oscap_model_write_i64(writer, variable->version);
+	oscap_model_write_u32(writer, variable->datatype);
+	oscap_model_write_string(writer, variable->comment);
+	oscap_model_write_bool(writer, variable->deprecated);
+
+	/* values of local and external variables aren't known until evaluation */
+	switch (variable->type) {
+	case OVAL_VARIABLE_CONSTANT: {
+		oval_variable_CONSTANT_t *cvar = (oval_variable_CONSTANT_t *) variable;
+		oscap_model_write_bool(writer, cvar->values != NULL);
+		if (cvar->values != NULL)
+			oval_collection_cache_write(writer, cvar->values, (oval_cache_write_func) oval_value_cache_write);
+		break;
+	}
+	case OVAL_VARIABLE_EXTERNAL: {
+		oval_variable_EXTERNAL_t *evar = (oval_variable_EXTERNAL_t *) variable;
+		if (evar->values_ref != NULL)
+			oscap_model_writer_fail(writer);
+		oval_collection_cache_write(writer, evar->possible_values, (oval_cache_write_func) oval_variable_possible_value_cache_write);
+		oval_collection_cache_write(writer, evar->possible_restrictions, (oval_cache_write_func) oval_variable_possible_restriction_cache_write);
+		break;
+	}
+	case OVAL_VARIABLE_LOCAL: {
+		oval_variable_LOCAL_t *lvar = (oval_variable_LOCAL_t *) variable;
+		if (lvar->values != NULL)
+			oscap_model_writer_fail(writer);
+		oscap_model_write_bool(writer, lvar->component != NULL);
+		if (lvar->component != NULL)
+			oval_component_cache_write(writer, lvar->component);
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+struct oval_variable *oval_variable_cache_read(struct oscap_model_reader *reader, struct oval_definition_model *model)
+{
+	oval_variable_type_t type = oscap_model_read_u32(reader);
+	char *id = oscap_model_read_string(reader);
+	if (id == NULL)
+		return NULL;
+	struct oval_variable *variable = oval_definition_model_get_new_variable(model, id, type);
+	free(id);
+	if (variable == NULL || variable->type != type)
+		return NULL;
+
+	variable->flag = oscap_model_read_u32(reader);
+	variable->version = oscap_model_read_i64(reader);
+	variable->datatype = oscap_model_read_u32(reader);
+	variable->comment = oscap_model_read_string(reader);
+	variable->deprecated = oscap_model_read_bool(reader);
+
+	switch (type) {
+	case OVAL_VARIABLE_CONSTANT: {
+		oval_variable_CONSTANT_t *cvar = (oval_variable_CONSTANT_t *) variable;
+		if (oscap_model_read_bool(reader)) {
+			cvar->values = oval_collection_new();
+			oval_collection_cache_read(reader, model, cvar->values, (oval_cache_read_func) oval_value_cache_read);
+		}
+		break;
+	}
+	case OVAL_VARIABLE_EXTERNAL: {
+		oval_variable_EXTERNAL_t *evar = (oval_variable_EXTERNAL_t *) variable;
+		oval_collection_cache_read(reader, model, evar->possible_values, (oval_cache_read_func) oval_variable_possible_value_cache_read);
+		oval_collection_cache_read(reader, model, evar->possible_restrictions, (oval_cache_read_func) oval_variable_possible_restriction_cache_read);
+		break;
+	}
+	case OVAL_VARIABLE_LOCAL: {
+		oval_variable_LOCAL_t *lvar = (oval_variable_LOCAL_t *) variable;
+		if (oscap_model_read_bool(reader))
+			lvar->component = oval_component_cache_read(reader, model);
+		break;
+	}
+	default:
+		break;
+	}
+	return variable;
+}
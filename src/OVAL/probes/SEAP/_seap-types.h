@@ -25,6 +25,7 @@
 #define _SEAP_TYPES_H
 
 #include <stdint.h>
+#include <pthread.h>
 #include "_sexp-types.h"
 #include "../../../common/util.h"
 #include "generic/rbt/rbt_common.h"
@@ -58,6 +59,10 @@ struct SEAP_CTX {
         uint16_t recv_timeout;
         uint16_t send_timeout;
 	oval_subtype_t subtype;
+
+	/* Signaled whenever a probe sends something to this context */
+	pthread_mutex_t recv_mutex;
+	pthread_cond_t  recv_cond;
 };
 typedef struct SEAP_CTX SEAP_CTX_t;
 
@@ -56,6 +56,7 @@ int SEAP_add_probe(SEAP_CTX_t *ctx, sch_queuedata_t *data);
 
 int SEAP_recvsexp(SEAP_CTX_t *ctx, int sd, SEXP_t **sexp);
 int SEAP_recvmsg(SEAP_CTX_t *ctx, int sd, SEAP_msg_t **seap_msg);
+int SEAP_poll(SEAP_CTX_t *ctx, const int *sds, size_t count);
 
 int SEAP_sendsexp(SEAP_CTX_t *ctx, int sd, SEXP_t *sexp);
 int SEAP_sendmsg(SEAP_CTX_t *ctx, int sd, SEAP_msg_t *seap_msg);
@@ -35,21 +35,89 @@
 #include "oval_definitions.h"
 
 
-int sch_queue_connect(SEAP_desc_t *desc)
+static void sch_ring_init(sch_ring_t *ring)
 {
-	sch_queuedata_t *data = malloc(sizeof(sch_queuedata_t));
+	ring->head = 0;
+	ring->tail = 0;
+	ring->consumer_waiting = 0;
+	ring->producer_waiting = 0;
+	pthread_mutex_init(&ring->mutex, NULL);
+	pthread_cond_init(&ring->cond, NULL);
+}
 
-	data->from_probe_queue = oscap_queue_new();
-	data->from_probe_cnt = 0;
-	pthread_cond_init(&data->from_probe_cond, NULL);
-	pthread_mutex_init(&data->from_probe_mutex, NULL);
+static void sch_ring_free(sch_ring_t *ring)
+{
+	while (ring->head != ring->tail) {
+		SEXP_free(ring->slot[ring->head & (SCH_RING_SIZE - 1)]);
+		ring->head++;
+	}
+}
 
-	data->to_probe_queue = oscap_queue_new();
-	data->to_probe_cnt = 0;
-	pthread_cond_init(&data->to_probe_cond, NULL);
-	pthread_mutex_init(&data->to_probe_mutex, NULL);
+static void sch_ring_wake(sch_ring_t *ring, int *waiting)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	if (__atomic_load_n(waiting, __ATOMIC_RELAXED)) {
+		pthread_mutex_lock(&ring->mutex);
+		pthread_cond_broadcast(&ring->cond);
+		pthread_mutex_unlock(&ring->mutex);
+	}
+}
 
-	data->parent_thread_id = pthread_self();
+static void sch_ring_push(sch_ring_t *ring, SEXP_t *sexp)
+{
+	size_t tail = ring->tail;
+
+	if (tail - __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) == SCH_RING_SIZE) {
+		pthread_mutex_lock(&ring->mutex);
+		__atomic_store_n(&ring->producer_waiting, 1, __ATOMIC_SEQ_CST);
+		while (tail - __atomic_load_n(&ring->head, __ATOMIC_SEQ_CST) == SCH_RING_SIZE)
+			pthread_cond_wait(&ring->cond, &ring->mutex);
+		__atomic_store_n(&ring->producer_waiting, 0, __ATOMIC_RELAXED);
+		pthread_mutex_unlock(&ring->mutex);
+	}
+
+	ring->slot[tail & (SCH_RING_SIZE - 1)] = sexp;
+	__atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+	sch_ring_wake(ring, &ring->consumer_waiting);
+}
+
+static SEXP_t *sch_ring_pop(sch_ring_t *ring)
+{
+	size_t head = ring->head;
+	SEXP_t *sexp;
+
+	if (__atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) == head) {
+		pthread_mutex_lock(&ring->mutex);
+		__atomic_store_n(&ring->consumer_waiting, 1, __ATOMIC_SEQ_CST);
+		while (__atomic_load_n(&ring->tail, __ATOMIC_SEQ_CST) == head)
+			pthread_cond_wait(&ring->cond, &ring->mutex);
+		__atomic_store_n(&ring->consumer_waiting, 0, __ATOMIC_RELAXED);
+		pthread_mutex_unlock(&ring->mutex);
+	}
+
+	sexp = ring->slot[head & (SCH_RING_SIZE - 1)];
+	__atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+	sch_ring_wake(ring, &ring->producer_waiting);
+
+	return sexp;
+}
+
+static size_t sch_ring_count(sch_ring_t *ring)
+{
+	return __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) -
+	       __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+}
+
+int sch_queue_connect(SEAP_desc_t *desc, pthread_mutex_t *notify_mutex, pthread_cond_t *notify_cond)
+{
+	sch_queuedata_t *data = malloc(sizeof(sch_queuedata_t));
+
+	sch_ring_init(&data->from_probe);
+	sch_ring_init(&data->to_probe);
+
+	data->parent_desc = desc;
+	data->notify_mutex = notify_mutex;
+	data->notify_cond = notify_cond;
 
 	struct probe_common_main_argument *arg = malloc(sizeof(struct probe_common_main_argument));
 	arg->subtype = desc->subtype;
@@ -72,59 +140,39 @@ int sch_queue_connect(SEAP_desc_t *desc)
 SEXP_t *sch_queue_recvsexp(SEAP_desc_t *desc)
 {
 	sch_queuedata_t *data = (sch_queuedata_t *)desc->scheme_data;
-	struct oscap_queue *queue;
-	pthread_mutex_t *mutex;
-	pthread_cond_t *cond;
-	int *cnt;
-	if (pthread_equal(pthread_self(), data->parent_thread_id)) {
-		queue = data->from_probe_queue;
-		mutex = &data->from_probe_mutex;
-		cond = &data->from_probe_cond;
-		cnt = &data->from_probe_cnt;
-	} else {
-		queue = data->to_probe_queue;
-		mutex = &data->to_probe_mutex;
-		cond = &data->to_probe_cond;
-		cnt = &data->to_probe_cnt;
-	}
-	pthread_mutex_lock(mutex);
-	while (*cnt == 0) {
-		pthread_cond_wait(cond, mutex);
-	}
-	SEXP_t *sexp = oscap_queue_remove(queue);
-	(*cnt)--;
-	pthread_mutex_unlock(mutex);
-	return sexp;
+
+	if (desc == data->parent_desc)
+		return sch_ring_pop(&data->from_probe);
+	else
+		return sch_ring_pop(&data->to_probe);
 }
 
 ssize_t sch_queue_sendsexp(SEAP_desc_t *desc, SEXP_t *sexp, uint32_t flags)
 {
 	sch_queuedata_t *data = (sch_queuedata_t *) desc->scheme_data;
-	struct oscap_queue *queue;
-	pthread_mutex_t *mutex;
-	pthread_cond_t *cond;
-	int *cnt;
-	if (pthread_equal(pthread_self(), data->parent_thread_id)) {
-		queue = data->to_probe_queue;
-		mutex = &data->to_probe_mutex;
-		cond = &data->to_probe_cond;
-		cnt = &data->to_probe_cnt;
-	} else {
-		queue = data->from_probe_queue;
-		mutex = &data->from_probe_mutex;
-		cond = &data->from_probe_cond;
-		cnt = &data->from_probe_cnt;
+
+	if (desc == data->parent_desc) {
+		sch_ring_push(&data->to_probe, SEXP_ref(sexp));
+		return 0;
+	}
+
+	sch_ring_push(&data->from_probe, SEXP_ref(sexp));
+	/* Wake up the library side if it waits for replies from several probes */
+	if (data->notify_cond != NULL) {
+		pthread_mutex_lock(data->notify_mutex);
+		pthread_cond_broadcast(data->notify_cond);
+		pthread_mutex_unlock(data->notify_mutex);
 	}
-	/* We want to send a SEXP, but the receiver expects a list of SEXPs. */
-	SEXP_t *sexp_list = SEXP_list_new(sexp, NULL);
-	pthread_mutex_lock(mutex);
-	oscap_queue_add(queue, (void *) sexp_list);
-	(*cnt)++;
-	pthread_cond_broadcast(cond);
-	pthread_mutex_unlock(mutex);
 	return 0;
 }
 
+int sch_queue_pending(SEAP_desc_t *desc)
+{
+	sch_queuedata_t *data = (sch_queuedata_t *) desc->scheme_data;
+
+	return (int) sch_ring_count(&data->from_probe);
+}
+
 int sch_queue_close(SEAP_desc_t *desc, uint32_t flags)
 {
 	int ret = 0;
@@ -141,8 +189,8 @@ int sch_queue_close(SEAP_desc_t *desc, uint32_t flags)
 		dE("Return code of %s_probe main thread is %d.", subtype_str, ret);
 	}
 cleanup:
-	oscap_queue_free(data->to_probe_queue, NULL);
-	oscap_queue_free(data->from_probe_queue, NULL);
+	sch_ring_free(&data->to_probe);
+	sch_ring_free(&data->from_probe);
 	free(data);
 	free(desc->arg);
 	return ret;
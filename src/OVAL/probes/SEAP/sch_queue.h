@@ -23,24 +23,45 @@
 #ifndef OPENSCAP_SCH_QUEUE_H
 #define OPENSCAP_SCH_QUEUE_H
 
+#include <pthread.h>
 #include "util.h"
-#include "oscap_queue.h"
 #include "seap-descriptor.h"
 
+/* Number of slots of a ring, must be a power of two */
+#define SCH_RING_SIZE 256
+
+/*
+ * Single-producer/single-consumer ring used to pass S-expressions between
+ * the library and a probe thread. Producers and consumers are serialized by
+ * the write and read locks of the SEAP descriptors on each side, so `head'
+ * is only written by the consumer and `tail' only by the producer. The mutex
+ * and the condition variable are used only when one side has to sleep; the
+ * other side signals it only if it's actually waiting.
+ */
+typedef struct {
+	SEXP_t *slot[SCH_RING_SIZE];
+	size_t head;
+	size_t tail;
+	int consumer_waiting;
+	int producer_waiting;
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+} sch_ring_t;
+
 typedef struct {
 	pthread_t probe_thread_id;
-	pthread_t parent_thread_id;
-	struct oscap_queue *to_probe_queue;
-	struct oscap_queue *from_probe_queue;
-	pthread_cond_t to_probe_cond;
-	pthread_mutex_t to_probe_mutex;
-	pthread_cond_t from_probe_cond;
-	pthread_mutex_t from_probe_mutex;
-	int to_probe_cnt;
-	int from_probe_cnt;
+	/* Descriptor of the library side, the probe side has its own one. The
+	 * direction doesn't depend on the calling thread, the library side may
+	 * be used by any thread which evaluates OVAL. */
+	SEAP_desc_t *parent_desc;
+	sch_ring_t to_probe;
+	sch_ring_t from_probe;
+	pthread_mutex_t *notify_mutex;
+	pthread_cond_t *notify_cond;
 } sch_queuedata_t;
 
-int sch_queue_connect(SEAP_desc_t *desc);
+int sch_queue_connect(SEAP_desc_t *desc, pthread_mutex_t *notify_mutex, pthread_cond_t *notify_cond);
+int sch_queue_pending(SEAP_desc_t *desc);
 ssize_t sch_queue_sendsexp(SEAP_desc_t *desc, SEXP_t *sexp, uint32_t flags);
 SEXP_t *sch_queue_recvsexp(SEAP_desc_t *desc);
 int sch_queue_close(SEAP_desc_t *desc, uint32_t flags);
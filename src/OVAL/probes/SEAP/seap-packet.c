@@ -601,7 +601,6 @@ static SEXP_t *SEAP_packet2sexp (SEAP_packet_t *packet)
 int SEAP_packet_recv (SEAP_CTX_t *ctx, int sd, SEAP_packet_t **packet)
 {
         SEAP_desc_t *dsc;
-        SEXP_t      *sexp_buffer;
         SEXP_t      *sexp_packet;
 
         SEXP_t     *psym_sexp;
@@ -660,152 +659,134 @@ int SEAP_packet_recv (SEAP_CTX_t *ctx, int sd, SEAP_packet_t **packet)
         }
 eloop_exit:
 
-	sexp_buffer = sch_queue_recvsexp(dsc);
-	SEXP_VALIDATE(sexp_buffer);
+	sexp_packet = sch_queue_recvsexp(dsc);
+	SEXP_VALIDATE(sexp_packet);
 
 	(*packet) = NULL;
 
-        while((sexp_packet = SEXP_list_pop (sexp_buffer)) != NULL) {
-		if (!SEXP_listp(sexp_packet)) {
-			dD("Invalid SEAP packet received: %s.", "not a list");
+	if (!SEXP_listp(sexp_packet)) {
+		dD("Invalid SEAP packet received: %s.", "not a list");
 
-			SEXP_free (sexp_packet);
-			SEXP_free (sexp_buffer);
+		SEXP_free (sexp_packet);
 
-			errno = EINVAL;
-			return (-1);
-		} else if (SEXP_list_length (sexp_packet) < 2) {
-			dD("Invalid SEAP packet received: %s.", "list length < 2");
+		errno = EINVAL;
+		return (-1);
+	} else if (SEXP_list_length (sexp_packet) < 2) {
+		dD("Invalid SEAP packet received: %s.", "list length < 2");
 
-			SEXP_free (sexp_packet);
-			SEXP_free (sexp_buffer);
+		SEXP_free (sexp_packet);
 
-			errno = EINVAL;
-			return (-1);
-		}
+		errno = EINVAL;
+		return (-1);
+	}
 
-		psym_sexp = SEXP_list_first (sexp_packet);
+	psym_sexp = SEXP_list_first (sexp_packet);
 
-		if (!SEXP_stringp(psym_sexp)) {
-			dD("Invalid SEAP packet received: %s.", "first list item is not a string");
+	if (!SEXP_stringp(psym_sexp)) {
+		dD("Invalid SEAP packet received: %s.", "first list item is not a string");
 
-			SEXP_free (psym_sexp);
-			SEXP_free (sexp_packet);
-			SEXP_free (sexp_buffer);
+		SEXP_free (psym_sexp);
+		SEXP_free (sexp_packet);
 
-			errno = EINVAL;
-			return (-1);
-		} else if (SEXP_string_length (psym_sexp) != (strlen (SEAP_SYM_PREFIX) + 3)) {
-			dD("Invalid SEAP packet received: %s.", "invalid packet type symbol length");
+		errno = EINVAL;
+		return (-1);
+	} else if (SEXP_string_length (psym_sexp) != (strlen (SEAP_SYM_PREFIX) + 3)) {
+		dD("Invalid SEAP packet received: %s.", "invalid packet type symbol length");
 
-			SEXP_free (psym_sexp);
-			SEXP_free (sexp_packet);
-			SEXP_free (sexp_buffer);
+		SEXP_free (psym_sexp);
+		SEXP_free (sexp_packet);
 
-			errno = EINVAL;
-			return (-1);
-		} else if (SEXP_strncmp (psym_sexp, SEAP_SYM_PREFIX, strlen (SEAP_SYM_PREFIX)) != 0) {
-			dD("Invalid SEAP packet received: %s.", "invalid prefix");
+		errno = EINVAL;
+		return (-1);
+	} else if (SEXP_strncmp (psym_sexp, SEAP_SYM_PREFIX, strlen (SEAP_SYM_PREFIX)) != 0) {
+		dD("Invalid SEAP packet received: %s.", "invalid prefix");
 
-			SEXP_free (psym_sexp);
-			SEXP_free (sexp_packet);
-			SEXP_free (sexp_buffer);
+		SEXP_free (psym_sexp);
+		SEXP_free (sexp_packet);
 
-			errno = EINVAL;
-			return (-1);
-		}
+		errno = EINVAL;
+		return (-1);
+	}
 
-		SEXP_string_cstr_r (psym_sexp, psym_cstr_b, sizeof psym_cstr_b);
-		psym_cstr = psym_cstr_b + strlen (SEAP_SYM_PREFIX);
-		SEXP_free (psym_sexp);
+	SEXP_string_cstr_r (psym_sexp, psym_cstr_b, sizeof psym_cstr_b);
+	psym_cstr = psym_cstr_b + strlen (SEAP_SYM_PREFIX);
+	SEXP_free (psym_sexp);
 
-		switch (psym_cstr[0]) {
-		case 'm':
-			if (psym_cstr[1] == 's' &&
-			    psym_cstr[2] == 'g')
-			{
-				_packet = SEAP_packet_new ();
-				_packet->type = SEAP_PACKET_MSG;
+	switch (psym_cstr[0]) {
+	case 'm':
+		if (psym_cstr[1] == 's' &&
+		    psym_cstr[2] == 'g')
+		{
+			_packet = SEAP_packet_new ();
+			_packet->type = SEAP_PACKET_MSG;
 
-				if (SEAP_packet_sexp2msg (sexp_packet, &(_packet->data.msg)) != 0) {
-					/* error */
-					dD("Invalid SEAP packet received: %s.", "can't translate to msg struct");
+			if (SEAP_packet_sexp2msg (sexp_packet, &(_packet->data.msg)) != 0) {
+				/* error */
+				dD("Invalid SEAP packet received: %s.", "can't translate to msg struct");
 
-					SEXP_free (sexp_packet);
-					SEAP_packet_free(_packet);
-					SEXP_free (sexp_buffer);
+				SEXP_free (sexp_packet);
+				SEAP_packet_free(_packet);
 
-					errno = EINVAL;
-					return (-1);
-				}
-				break;
+				errno = EINVAL;
+				return (-1);
 			}
-			goto invalid;
-		case 'c':
-			if (psym_cstr[1] == 'm' &&
-			    psym_cstr[2] == 'd')
-			{
-				_packet = SEAP_packet_new ();
-				_packet->type = SEAP_PACKET_CMD;
-
-				if (SEAP_packet_sexp2cmd (sexp_packet, &(_packet->data.cmd)) != 0) {
-					/* error */
-					dD("Invalid SEAP packet received: %s.", "can't translate to cmd struct");
-					SEXP_free (sexp_packet);
-					SEAP_packet_free(_packet);
-					SEXP_free (sexp_buffer);
-
-					errno = EINVAL;
-					return (-1);
-				}
-				break;
+			break;
+		}
+		goto invalid;
+	case 'c':
+		if (psym_cstr[1] == 'm' &&
+		    psym_cstr[2] == 'd')
+		{
+			_packet = SEAP_packet_new ();
+			_packet->type = SEAP_PACKET_CMD;
+
+			if (SEAP_packet_sexp2cmd (sexp_packet, &(_packet->data.cmd)) != 0) {
+				/* error */
+				dD("Invalid SEAP packet received: %s.", "can't translate to cmd struct");
+				SEXP_free (sexp_packet);
+				SEAP_packet_free(_packet);
+
+				errno = EINVAL;
+				return (-1);
 			}
-			goto invalid;
-		case 'e':
-			if (psym_cstr[1] == 'r' &&
-			    psym_cstr[2] == 'r')
-			{
-				_packet = SEAP_packet_new ();
-				_packet->type = SEAP_PACKET_ERR;
-
-				if (SEAP_packet_sexp2err (sexp_packet, &(_packet->data.err)) != 0) {
-					/* error */
-					dD("Invalid SEAP packet received: %s.", "can't translate to err struct");
-					SEXP_free (sexp_packet);
-					SEAP_packet_free(_packet);
-					SEXP_free (sexp_buffer);
-
-					errno = EINVAL;
-					return (-1);
-				}
-				break;
+			break;
+		}
+		goto invalid;
+	case 'e':
+		if (psym_cstr[1] == 'r' &&
+		    psym_cstr[2] == 'r')
+		{
+			_packet = SEAP_packet_new ();
+			_packet->type = SEAP_PACKET_ERR;
+
+			if (SEAP_packet_sexp2err (sexp_packet, &(_packet->data.err)) != 0) {
+				/* error */
+				dD("Invalid SEAP packet received: %s.", "can't translate to err struct");
+				SEXP_free (sexp_packet);
+				SEAP_packet_free(_packet);
+
+				errno = EINVAL;
+				return (-1);
 			}
-			/* FALLTHROUGH */
-		default:
-		invalid:
-			dD("Invalid SEAP packet received: %s.", "invalid packet type symbol");
-			SEXP_free (sexp_packet);
-			SEXP_free (sexp_buffer);
-			errno = EINVAL;
-			return (-1);
+			break;
 		}
+		/* FALLTHROUGH */
+	default:
+	invalid:
+		dD("Invalid SEAP packet received: %s.", "invalid packet type symbol");
+		SEXP_free (sexp_packet);
+		errno = EINVAL;
+		return (-1);
+	}
 
 
-		dD("Received packet");
-		dO(OSCAP_DEBUGOBJ_SEXP, sexp_packet);
-		dD("packet size: %zu", SEXP_sizeof(sexp_packet));
-
-		SEXP_free(sexp_packet);
-
-		if (*packet == NULL)
-			(*packet) = _packet;
-		else
-			SEAP_packetq_put(&dsc->pck_queue, _packet);
+	dD("Received packet");
+	dO(OSCAP_DEBUGOBJ_SEXP, sexp_packet);
+	dD("packet size: %zu", SEXP_sizeof(sexp_packet));
 
-		_packet = NULL;
-	}
+	SEXP_free(sexp_packet);
 
-        SEXP_free(sexp_buffer);
+	(*packet) = _packet;
 
         return (0);
 }
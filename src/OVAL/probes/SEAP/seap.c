@@ -64,6 +64,9 @@ static void SEAP_CTX_initdefault (SEAP_CTX_t *ctx)
         ctx->send_timeout = 5;
         ctx->cflags       = 0;
 
+        pthread_mutex_init(&ctx->recv_mutex, NULL);
+        pthread_cond_init(&ctx->recv_cond, NULL);
+
         return;
 }
 
@@ -87,6 +90,8 @@ void SEAP_CTX_free (SEAP_CTX_t *ctx)
         _A(ctx != NULL);
         SEAP_desctable_free(ctx->sd_table);
         SEAP_cmdtbl_free (ctx->cmd_c_table);
+        pthread_cond_destroy(&ctx->recv_cond);
+        pthread_mutex_destroy(&ctx->recv_mutex);
 	free(ctx);
 
         return;
@@ -113,7 +118,7 @@ int SEAP_connect(SEAP_CTX_t *ctx)
         }
 	dsc->subtype = ctx->subtype;
 
-	if (sch_queue_connect(dsc) != 0) {
+	if (sch_queue_connect(dsc, &ctx->recv_mutex, &ctx->recv_cond) != 0) {
                 dD("FAIL: errno=%u, %s.", errno, strerror (errno));
                 SEAP_desc_del(ctx->sd_table, sd);
 
@@ -344,6 +349,46 @@ static int __SEAP_recvmsg_process_err (SEAP_CTX_t *ctx, int sd, SEAP_err_t *err)
         return (0);
 }
 
+/**
+ * Wait until at least one of the descriptors in `sds' has input ready.
+ * This allows the caller to have requests outstanding on several probes
+ * at once and to process the replies in the order in which they arrive.
+ * Returns the index of the ready descriptor in `sds' or -1 on error.
+ */
+int SEAP_poll (SEAP_CTX_t *ctx, const int *sds, size_t count)
+{
+        SEAP_desc_t *dsc;
+        size_t i;
+
+        _A(ctx != NULL);
+        _A(sds != NULL);
+
+        if (count == 0) {
+                errno = EINVAL;
+                return (-1);
+        }
+
+        pthread_mutex_lock(&ctx->recv_mutex);
+        for (;;) {
+                for (i = 0; i < count; ++i) {
+                        dsc = SEAP_desc_get(ctx->sd_table, sds[i]);
+
+                        if (dsc == NULL) {
+                                pthread_mutex_unlock(&ctx->recv_mutex);
+                                errno = EBADF;
+                                return (-1);
+                        }
+
+                        if (SEAP_packetq_count(&dsc->pck_queue) > 0 ||
+                            sch_queue_pending(dsc) > 0) {
+                                pthread_mutex_unlock(&ctx->recv_mutex);
+                                return ((int)i);
+                        }
+                }
+                pthread_cond_wait(&ctx->recv_cond, &ctx->recv_mutex);
+        }
+}
+
 int SEAP_recvmsg (SEAP_CTX_t *ctx, int sd, SEAP_msg_t **seap_msg)
 {
         SEAP_packet_t *packet;
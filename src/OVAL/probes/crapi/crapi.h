@@ -24,6 +24,7 @@
 #define CRAPI_H
 
 #define CRAPI_IO_BUFSZ 4096
+#define CRAPI_IO_BLKSZ (128 * 1024) /* block size of crapi_mdigest_fd() */
 
 #ifndef _FILE_OFFSET_BITS
 # define _FILE_OFFSET_BITS 32
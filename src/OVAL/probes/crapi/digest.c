@@ -25,12 +25,15 @@
 #endif
 
 #include <stdarg.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <unistd.h>
 #include <errno.h>
 #include <stdlib.h>
+#include <fcntl.h>
 #include <sys/types.h>
+#include <sys/stat.h>
 
 #include "crapi.h"
 #include "digest.h"
@@ -38,6 +41,7 @@
 #include "sha1.h"
 #include "sha2.h"
 #include "rmd160.h"
+#include "digest_cache.h"
 
 int crapi_digest_fd (int fd, crapi_alg_t alg, void *dst, size_t *size)
 {
@@ -75,27 +79,86 @@ int crapi_digest_fd (int fd, crapi_alg_t alg, void *dst, size_t *size)
         return (-1);
 }
 
+static int crapi_mdigest_update (struct digest_ctbl_t *ctbl, int num, void *buf, size_t len)
+{
+        register int i;
+
+        for (i = 0; i < num; ++i) {
+                if (ctbl[i].ctx == NULL)
+                        continue;
+                if (ctbl[i].update (ctbl[i].ctx, buf, len) != 0)
+                        return (-1);
+        }
+
+        return (0);
+}
+
+/*
+ * Feed the whole file to all the contexts. The file is read in blocks of
+ * CRAPI_IO_BLKSZ bytes and every block is hashed by all the algorithms
+ * while it's cached. The file isn't mapped into memory, a mapped file
+ * which gets truncated while it's hashed would raise SIGBUS.
+ */
+static int crapi_mdigest_feed (int fd, struct digest_ctbl_t *ctbl, int num)
+{
+        uint8_t *buf;
+        ssize_t ret;
+
+#if defined(POSIX_FADV_SEQUENTIAL)
+        (void) posix_fadvise (fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+        buf = malloc (CRAPI_IO_BLKSZ);
+        if (buf == NULL)
+                return (-1);
+
+        while ((ret = read (fd, buf, CRAPI_IO_BLKSZ)) != 0) {
+                if (ret < 0) {
+                        if (errno == EINTR)
+                                continue;
+                        free (buf);
+                        return (-1);
+                }
+
+                if (crapi_mdigest_update (ctbl, num, buf, (size_t)ret) != 0) {
+                        free (buf);
+                        return (-1);
+                }
+        }
+
+        free (buf);
+        return (0);
+}
+
 int crapi_mdigest_fd (int fd, int num, ... /* crapi_alg_t alg, void *dst, size_t *size, ...*/)
 {
         register int i;
         va_list ap;
         struct digest_ctbl_t *ctbl = malloc(num * sizeof(struct digest_ctbl_t));
+        struct digest_req_t {
+                crapi_alg_t alg;
+                void       *dst;
+                size_t     *size;
+        } *req = malloc(num * sizeof(struct digest_req_t));
 
         crapi_alg_t alg;
         void       *dst;
         size_t     *size;
 
-        uint8_t fd_buf[CRAPI_IO_BUFSZ];
-        ssize_t ret;
+        struct stat st;
+        bool cached;
+        int  missing = 0;
 
-	if (num <= 0 || fd <= 0) {
+	if (num <= 0 || fd <= 0 || ctbl == NULL || req == NULL) {
 		errno = EINVAL;
 		free(ctbl);
+		free(req);
 		return -1;
 	}
         for (i = 0; i < num; ++i)
                 ctbl[i].ctx = NULL;
 
+        cached = crapi_digest_cache_enabled () && fstat (fd, &st) == 0 && S_ISREG(st.st_mode);
+
         va_start (ap, num);
 
         for (i = 0; i < num; ++i) {
@@ -155,48 +218,43 @@ int crapi_mdigest_fd (int fd, int num, ... /* crapi_alg_t alg, void *dst, size_t
                         goto fail;
                 }
 
+                req[i].alg  = alg;
+                req[i].dst  = dst;
+                req[i].size = size;
+
+                /* the digest might be known from a previous scan */
+                if (cached && crapi_digest_cache_get (&st, alg, dst, size) == 0)
+                        continue;
+
                 if ((ctbl[i].ctx = ctbl[i].init (dst, size)) == NULL)
 			*size = 0;
+                else
+                        ++missing;
         }
 
         va_end (ap);
 
-        while ((ret = read (fd, fd_buf, sizeof fd_buf)) == sizeof fd_buf) {
-                for (i = 0; i < num; ++i) {
-			if (ctbl[i].ctx == NULL)
-				continue;
-                        if (ctbl[i].update (ctbl[i].ctx, fd_buf, sizeof fd_buf) != 0) {
-                                goto fail;
-                        }
-                }
-        }
+        if (missing == 0)
+                goto done;
 
-        switch (ret) {
-        case 0:
-                break;
-        case -1:
+        if (crapi_mdigest_feed (fd, ctbl, num) != 0)
                 goto fail;
-        default:
-		if (ret <= 0) {
-			free(ctbl);
-			return -1;
-		}
-
-                for (i = 0; i < num; ++i) {
-			if (ctbl[i].ctx == NULL)
-				continue;
-                        if (ctbl[i].update (ctbl[i].ctx, fd_buf, (size_t)ret) != 0) {
-                                goto fail;
-                        }
-                }
-        }
+
+        /* don't store digests of files which were modified while being read */
+        if (cached && !crapi_digest_cache_unchanged (fd, &st))
+                cached = false;
 
         for (i = 0; i < num; ++i) {
 		if (ctbl[i].ctx == NULL)
 			continue;
                 ctbl[i].fini (ctbl[i].ctx);
+
+                if (cached)
+                        crapi_digest_cache_put (&st, req[i].alg, req[i].dst, *req[i].size);
 	}
+done:
         free(ctbl);
+        free(req);
         return (0);
 fail:
         for (i = 0; i < num; ++i)
@@ -204,5 +262,6 @@ fail:
                         ctbl[i].free (ctbl[i].ctx);
 
         free(ctbl);
+        free(req);
         return (-1);
 }
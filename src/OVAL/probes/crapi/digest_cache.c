@@ -0,0 +1,101 @@
+/*
+ * Copyright 2026 Red Hat Inc., Durham, North Carolina.
+ * All Rights Reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "oscap_file_cache.h"
+#include "digest_cache.h"
+
+/*
+ * Persistent cache of file digests, see oscap_file_cache.h. The records
+ * are tagged by the algorithm.
+ */
+
+#define CRAPI_DIGEST_CACHE_MAGIC  "OSCAPDC2"
+#define CRAPI_DIGEST_CACHE_MAXLEN 64
+
+struct crapi_digest_cache_data {
+        uint32_t len;
+        uint32_t reserved;
+        uint8_t  digest[CRAPI_DIGEST_CACHE_MAXLEN];
+};
+
+static pthread_once_t crapi_digest_cache_once = PTHREAD_ONCE_INIT;
+static struct oscap_file_cache *crapi_digest_cache = NULL;
+
+static void crapi_digest_cache_init (void)
+{
+        crapi_digest_cache = oscap_file_cache_open (getenv ("OSCAP_PROBE_FILEHASH_CACHE"), CRAPI_DIGEST_CACHE_MAGIC,
+                                                    sizeof (struct crapi_digest_cache_data), "file hash cache");
+}
+
+bool crapi_digest_cache_enabled (void)
+{
+        pthread_once (&crapi_digest_cache_once, crapi_digest_cache_init);
+        return (crapi_digest_cache != NULL);
+}
+
+int crapi_digest_cache_get (const struct stat *st, crapi_alg_t alg, void *dst, size_t *size)
+{
+        struct crapi_digest_cache_data data;
+
+        if (!crapi_digest_cache_enabled ())
+                return (-1);
+
+        if (!oscap_file_cache_get (crapi_digest_cache, st, (uint64_t)alg, &data)
+            || data.len > CRAPI_DIGEST_CACHE_MAXLEN || data.len > *size)
+                return (-1);
+
+        memcpy (dst, data.digest, data.len);
+        *size = data.len;
+
+        return (0);
+}
+
+bool crapi_digest_cache_unchanged (int fd, const struct stat *st)
+{
+        struct stat now;
+
+        if (fstat (fd, &now) != 0)
+                return (false);
+
+        return (oscap_file_stat_unchanged (&now, st));
+}
+
+void crapi_digest_cache_put (const struct stat *st, crapi_alg_t alg, const void *dst, size_t size)
+{
+        struct crapi_digest_cache_data data;
+
+        if (size == 0 || size > CRAPI_DIGEST_CACHE_MAXLEN || !crapi_digest_cache_enabled ())
+                return;
+
+        memset (&data, 0, sizeof data);
+        data.len = (uint32_t)size;
+        memcpy (data.digest, dst, size);
+
+        oscap_file_cache_put (crapi_digest_cache, st, (uint64_t)alg, &data);
+}
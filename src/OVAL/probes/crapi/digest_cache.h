@@ -0,0 +1,53 @@
+/*
+ * Copyright 2026 Red Hat Inc., Durham, North Carolina.
+ * All Rights Reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+#pragma once
+#ifndef CRAPI_DIGEST_CACHE_H
+#define CRAPI_DIGEST_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/stat.h>
+#include "digest.h"
+
+/**
+ * Check whether the persistent digest cache is enabled. The cache is
+ * enabled by setting OSCAP_PROBE_FILEHASH_CACHE to the path of the
+ * cache file.
+ */
+bool crapi_digest_cache_enabled (void);
+
+/**
+ * Look up the digest of the file described by st.
+ * @return 0 and the digest in dst/size if the digest is cached for the
+ *         same device, inode, size, mtime and ctime, -1 otherwise
+ */
+int crapi_digest_cache_get (const struct stat *st, crapi_alg_t alg, void *dst, size_t *size);
+
+/**
+ * Check that the file open as fd still has the size, mtime and ctime
+ * stored in st.
+ */
+bool crapi_digest_cache_unchanged (int fd, const struct stat *st);
+
+/**
+ * Store the digest of the file described by st.
+ */
+void crapi_digest_cache_put (const struct stat *st, crapi_alg_t alg, const void *dst, size_t size);
+
+#endif /* CRAPI_DIGEST_CACHE_H */
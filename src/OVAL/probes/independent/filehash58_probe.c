@@ -44,6 +44,7 @@
 #include <fcntl.h>
 #include <limits.h>
 #include <pthread.h>
+#include <unistd.h>
 #include <errno.h>
 #include <crapi/crapi.h>
 #include <probe/probe.h>
@@ -121,126 +122,329 @@ static int mem2hex (uint8_t *mem, size_t mlen, char *str, size_t slen)
 	return (0);
 }
 
-static int filehash58_cb(const char *prefix, const char *p, const char *f, const char *h, probe_ctx *ctx)
-{
-	SEXP_t *itm;
-
-	char   pbuf[PATH_MAX+1];
-	size_t plen, flen;
-
-	int fd;
-
-	if (f == NULL)
-		return (0);
-
-	/*
-	 * Prepare path
-	 */
-	plen = strlen (p);
-	flen = strlen (f);
-
-	if (plen + flen + 1 > PATH_MAX)
-		return (-1);
+/* Upper bound of the default worker count */
+#define FILEHASH58_WORKERS_MAX 4
+#define FILEHASH58_WINDOW      64
 
-	memcpy (pbuf, p, sizeof (char) * plen);
+/* hash type requested by the object */
+struct filehash58_type {
+	const char *name;
+	crapi_alg_t alg; /* 0 if not supported */
+	size_t      len;
+};
 
-	if (p[plen - 1] != FILE_SEPARATOR) {
-		pbuf[plen] = FILE_SEPARATOR;
-		++plen;
-	}
+/* file which is being hashed */
+struct filehash58_job {
+	OVAL_FTSENT *ent;
+	char   pbuf[PATH_MAX+1];
+	int    err;  /* errno of open(), 0 on success */
+	int    ret;  /* result of crapi_mdigest_fd() */
+	uint8_t hash_dst[6][64];
+	size_t  hash_dstlen[6];
+	bool   done;
+};
 
-	memcpy (pbuf + plen, f, sizeof (char) * flen);
-	pbuf[plen+flen] = '\0';
+/*
+ * Files are hashed by a pool of worker threads, all the requested hash
+ * types in one pass over the file. The items are collected by the probe
+ * thread in the order in which oval_fts_read() returned the files.
+ */
+struct filehash58_pool {
+	const char *prefix;
+	const struct filehash58_type *types;
+	int type_cnt;
+
+	pthread_mutex_t mutex;
+	pthread_cond_t  job_cond;
+	pthread_cond_t  done_cond;
+	bool shutdown;
+
+	struct filehash58_job *job; /* window of FILEHASH58_WINDOW jobs */
+	size_t head; /* next job to collect */
+	size_t next; /* next job to hash */
+	size_t tail; /* next free job */
+
+	pthread_t *thid;
+	unsigned thcnt;
+};
 
-	/*
-	 * Open the file
-	 */
-	if (prefix == NULL) {
-		fd = open(pbuf, O_RDONLY);
+static void filehash58_hash(struct filehash58_pool *pool, struct filehash58_job *job)
+{
+	const struct filehash58_type *types = pool->types;
+	int fd, i, n = 0;
+	struct {
+		crapi_alg_t alg;
+		void       *dst;
+		size_t     *len;
+	} arg[6];
+
+	job->err = 0;
+	job->ret = 0;
+
+	if (pool->prefix == NULL) {
+		fd = open(job->pbuf, O_RDONLY);
 	} else {
-		char *path_with_prefix = oscap_path_join(prefix, pbuf);
+		char *path_with_prefix = oscap_path_join(pool->prefix, job->pbuf);
 		fd = open(path_with_prefix, O_RDONLY);
 		free(path_with_prefix);
 	}
 
 	if (fd < 0) {
-		strerror_r (errno, pbuf, PATH_MAX);
-		pbuf[PATH_MAX] = '\0';
-
-		itm = probe_item_create (OVAL_INDEPENDENT_FILE_HASH58, NULL,
-					"filepath", OVAL_DATATYPE_STRING, pbuf,
-					"path",     OVAL_DATATYPE_STRING, p,
-					"filename", OVAL_DATATYPE_STRING, f,
-					"hash_type",OVAL_DATATYPE_STRING, h,
-					NULL);
-		probe_item_add_msg(itm, OVAL_MESSAGE_LEVEL_ERROR,
-			"Can't open \"%s\": errno=%d, %s.", pbuf, errno, strerror (errno));
-		probe_item_setstatus(itm, SYSCHAR_STATUS_ERROR);
+		job->err = errno;
+		return;
+	}
 
-		probe_item_collect(ctx, itm);
-		return 0;
+	/* crapi_mdigest_fd() reads only the first n triplets of arguments */
+	memset(arg, 0, sizeof arg);
+
+	for (i = 0; i < pool->type_cnt; ++i) {
+		if (types[i].alg == 0)
+			continue;
+
+		job->hash_dstlen[i] = types[i].len;
+		arg[n].alg = types[i].alg;
+		arg[n].dst = job->hash_dst[i];
+		arg[n].len = &job->hash_dstlen[i];
+		++n;
+	}
+
+	if (n > 0) {
+		job->ret = crapi_mdigest_fd(fd, n,
+		                            arg[0].alg, arg[0].dst, arg[0].len,
+		                            arg[1].alg, arg[1].dst, arg[1].len,
+		                            arg[2].alg, arg[2].dst, arg[2].len,
+		                            arg[3].alg, arg[3].dst, arg[3].len,
+		                            arg[4].alg, arg[4].dst, arg[4].len,
+		                            arg[5].alg, arg[5].dst, arg[5].len);
 	}
 
-	uint8_t hash_dst[1025];
-	size_t hash_dstlen = sizeof(hash_dst);
+	close(fd);
+}
+
+static void filehash58_collect(struct filehash58_pool *pool, struct filehash58_job *job, probe_ctx *ctx)
+{
+	const char *p = job->ent->path, *f = job->ent->file;
 	char hash_str[2051];
-	crapi_alg_t hash_type;
-
-	hash_type = oscap_string_to_enum(CRAPI_ALG_MAP, h);
-	if (hash_type == 0) {
-		char *msg = oscap_sprintf("This version of OpenSCAP doesn't support the '%s' hash algorithm.", h);
-		dW(msg);
-		itm = probe_item_create (OVAL_INDEPENDENT_FILE_HASH58, NULL,
-			"filepath", OVAL_DATATYPE_STRING, pbuf,
+	SEXP_t *itm;
+	int i;
+
+	for (i = 0; i < pool->type_cnt; ++i) {
+		const char *h = pool->types[i].name;
+
+		if (job->err != 0) {
+			itm = probe_item_create (OVAL_INDEPENDENT_FILE_HASH58, NULL,
+						"filepath", OVAL_DATATYPE_STRING, job->pbuf,
+						"path",     OVAL_DATATYPE_STRING, p,
+						"filename", OVAL_DATATYPE_STRING, f,
+						"hash_type",OVAL_DATATYPE_STRING, h,
+						NULL);
+			probe_item_add_msg(itm, OVAL_MESSAGE_LEVEL_ERROR,
+				"Can't open \"%s\": errno=%d, %s.", job->pbuf, job->err, strerror (job->err));
+			probe_item_setstatus(itm, SYSCHAR_STATUS_ERROR);
+
+			probe_item_collect(ctx, itm);
+			continue;
+		}
+
+		if (pool->types[i].alg == 0) {
+			char *msg = oscap_sprintf("This version of OpenSCAP doesn't support the '%s' hash algorithm.", h);
+			dW(msg);
+			itm = probe_item_create (OVAL_INDEPENDENT_FILE_HASH58, NULL,
+				"filepath", OVAL_DATATYPE_STRING, job->pbuf,
+				"path", OVAL_DATATYPE_STRING, p,
+				"filename", OVAL_DATATYPE_STRING, f,
+				"hash_type", OVAL_DATATYPE_STRING, h,
+				NULL);
+			probe_item_add_msg(itm, OVAL_MESSAGE_LEVEL_ERROR, msg);
+			free(msg);
+			probe_item_setstatus(itm, SYSCHAR_STATUS_ERROR);
+			probe_item_collect(ctx, itm);
+			continue;
+		}
+
+		if (job->ret != 0)
+			continue;
+
+		hash_str[0] = '\0';
+		mem2hex(job->hash_dst[i], job->hash_dstlen[i], hash_str, sizeof(hash_str));
+
+		/*
+		 * Create and add the item
+		 */
+		itm = probe_item_create(OVAL_INDEPENDENT_FILE_HASH58, NULL,
+			"filepath", OVAL_DATATYPE_STRING, job->pbuf,
 			"path", OVAL_DATATYPE_STRING, p,
 			"filename", OVAL_DATATYPE_STRING, f,
-			"hash_type", OVAL_DATATYPE_STRING, h,
+			"hash_type",OVAL_DATATYPE_STRING, h,
+			"hash", OVAL_DATATYPE_STRING, hash_str,
 			NULL);
-		probe_item_add_msg(itm, OVAL_MESSAGE_LEVEL_ERROR, msg);
-		free(msg);
-		probe_item_setstatus(itm, SYSCHAR_STATUS_ERROR);
+
+		if (job->hash_dstlen[i] == 0) {
+			probe_item_add_msg(itm, OVAL_MESSAGE_LEVEL_ERROR,
+				"Unable to compute %s hash value of \"%s\".", h, job->pbuf);
+			probe_item_setstatus(itm, SYSCHAR_STATUS_ERROR);
+		}
+
 		probe_item_collect(ctx, itm);
-		close(fd);
-		return 0;
 	}
+}
+
+static void *filehash58_worker(void *arg)
+{
+	struct filehash58_pool *pool = arg;
+	struct filehash58_job *job;
 
-	hash_dstlen = oscap_string_to_enum(CRAPI_ALG_MAP_SIZE, h);
+	pthread_mutex_lock(&pool->mutex);
 
-	/*
-	 * Compute hash value
-	 */
-	if (crapi_mdigest_fd(fd, 1, hash_type, hash_dst, &hash_dstlen) != 0) {
-		close (fd);
-		return (-1);
+	for (;;) {
+		while (pool->next == pool->tail && !pool->shutdown)
+			pthread_cond_wait(&pool->job_cond, &pool->mutex);
+
+		if (pool->next == pool->tail)
+			break;
+
+		job = &pool->job[pool->next++ % FILEHASH58_WINDOW];
+		pthread_mutex_unlock(&pool->mutex);
+
+		filehash58_hash(pool, job);
+
+		pthread_mutex_lock(&pool->mutex);
+		job->done = true;
+		pthread_cond_broadcast(&pool->done_cond);
 	}
 
-	close (fd);
+	pthread_mutex_unlock(&pool->mutex);
+
+	return (NULL);
+}
+
+/* wait for the oldest job and collect its items */
+static void filehash58_pool_collect(struct filehash58_pool *pool, probe_ctx *ctx)
+{
+	struct filehash58_job *job = &pool->job[pool->head % FILEHASH58_WINDOW];
+
+	if (pool->thcnt > 0) {
+		pthread_mutex_lock(&pool->mutex);
+		while (!job->done)
+			pthread_cond_wait(&pool->done_cond, &pool->mutex);
+		pthread_mutex_unlock(&pool->mutex);
+	} else {
+		filehash58_hash(pool, job);
+	}
+
+	filehash58_collect(pool, job, ctx);
+	oval_ftsent_free(job->ent);
+	job->ent = NULL;
+	++pool->head;
+}
+
+/* queue the file for hashing, the entry is freed once its items are collected */
+static void filehash58_pool_add(struct filehash58_pool *pool, OVAL_FTSENT *ent, probe_ctx *ctx)
+{
+	struct filehash58_job *job;
+	size_t plen, flen;
 
-	hash_str[0] = '\0';
-	mem2hex(hash_dst, hash_dstlen, hash_str, sizeof(hash_str));
+	if (ent->file == NULL) {
+		oval_ftsent_free(ent);
+		return;
+	}
 
 	/*
-	 * Create and add the item
+	 * Prepare path
 	 */
-	itm = probe_item_create(OVAL_INDEPENDENT_FILE_HASH58, NULL,
-		"filepath", OVAL_DATATYPE_STRING, pbuf,
-		"path", OVAL_DATATYPE_STRING, p,
-		"filename", OVAL_DATATYPE_STRING, f,
-		"hash_type",OVAL_DATATYPE_STRING, h,
-		"hash", OVAL_DATATYPE_STRING, hash_str,
-		NULL);
-
-	if (hash_dstlen == 0) {
-		probe_item_add_msg(itm, OVAL_MESSAGE_LEVEL_ERROR,
-			"Unable to compute %s hash value of \"%s\".", h, pbuf);
-		probe_item_setstatus(itm, SYSCHAR_STATUS_ERROR);
+	plen = strlen (ent->path);
+	flen = strlen (ent->file);
+
+	if (plen + flen + 1 > PATH_MAX) {
+		oval_ftsent_free(ent);
+		return;
 	}
 
-	probe_item_collect(ctx, itm);
+	if (pool->tail - pool->head == FILEHASH58_WINDOW)
+		filehash58_pool_collect(pool, ctx);
+
+	job = &pool->job[pool->tail % FILEHASH58_WINDOW];
+	job->ent = ent;
+	job->done = false;
+
+	memcpy (job->pbuf, ent->path, sizeof (char) * plen);
+
+	if (ent->path[plen - 1] != FILE_SEPARATOR) {
+		job->pbuf[plen] = FILE_SEPARATOR;
+		++plen;
+	}
+
+	memcpy (job->pbuf + plen, ent->file, sizeof (char) * flen);
+	job->pbuf[plen+flen] = '\0';
+
+	if (pool->thcnt > 0) {
+		pthread_mutex_lock(&pool->mutex);
+		++pool->tail;
+		pthread_cond_signal(&pool->job_cond);
+		pthread_mutex_unlock(&pool->mutex);
+	} else {
+		++pool->tail;
+	}
+}
+
+static int filehash58_pool_init(struct filehash58_pool *pool, const char *prefix,
+                                const struct filehash58_type *types, int type_cnt)
+{
+	unsigned i, thcnt;
+
+	memset(pool, 0, sizeof(struct filehash58_pool));
+
+	pool->prefix = prefix;
+	pool->types = types;
+	pool->type_cnt = type_cnt;
+	pool->job = calloc(FILEHASH58_WINDOW, sizeof(struct filehash58_job));
+
+	if (pool->job == NULL)
+		return (-1);
+
+	pthread_mutex_init(&pool->mutex, NULL);
+	pthread_cond_init(&pool->job_cond, NULL);
+	pthread_cond_init(&pool->done_cond, NULL);
+
+	thcnt = oscap_env_worker_count("OSCAP_PROBE_FILEHASH_WORKERS", FILEHASH58_WORKERS_MAX);
+	if (thcnt > 0)
+		pool->thid = malloc(thcnt * sizeof(pthread_t));
+	if (pool->thid == NULL)
+		thcnt = 0;
+
+	for (i = 0; i < thcnt; ++i) {
+		if (pthread_create(&pool->thid[i], NULL, filehash58_worker, pool) != 0) {
+			dW("Can't start the filehash58 worker #%u: %d, %s.", i, errno, strerror(errno));
+			break;
+		}
+		++pool->thcnt;
+	}
 
 	return (0);
 }
 
+static void filehash58_pool_fini(struct filehash58_pool *pool, probe_ctx *ctx)
+{
+	unsigned i;
+
+	while (pool->head != pool->tail)
+		filehash58_pool_collect(pool, ctx);
+
+	pthread_mutex_lock(&pool->mutex);
+	pool->shutdown = true;
+	pthread_cond_broadcast(&pool->job_cond);
+	pthread_mutex_unlock(&pool->mutex);
+
+	for (i = 0; i < pool->thcnt; ++i)
+		pthread_join(pool->thid[i], NULL);
+
+	pthread_mutex_destroy(&pool->mutex);
+	pthread_cond_destroy(&pool->job_cond);
+	pthread_cond_destroy(&pool->done_cond);
+	free(pool->thid);
+	free(pool->job);
+}
+
 int filehash58_probe_offline_mode_supported()
 {
 	return PROBE_OFFLINE_OWN;
@@ -283,6 +487,10 @@ int filehash58_probe_main(probe_ctx *ctx, void *arg)
 	OVAL_FTS    *ofts;
 	OVAL_FTSENT *ofts_ent;
 
+	struct filehash58_pool pool;
+	struct filehash58_type types[6];
+	int type_cnt = 0;
+
 	pthread_mutex_t *filehash58_probe_mutex = (pthread_mutex_t *)arg;
 	if (filehash58_probe_mutex == NULL) {
 		return (PROBE_EINIT);
@@ -320,20 +528,30 @@ int filehash58_probe_main(probe_ctx *ctx, void *arg)
 		goto cleanup;
 	}
 
+	/* find hash types to compare with entity, think "not satisfy" */
+	for (int i = 0; OVAL_FILEHASH58_HASH_TYPES[i] != NULL; i++) {
+		const char *oval_filehash58_hash_type = OVAL_FILEHASH58_HASH_TYPES[i];
+		SEXP_t *oval_filehash58_hash_type_sexp = SEXP_string_new(oval_filehash58_hash_type, strlen(oval_filehash58_hash_type));
+		if (probe_entobj_cmp(hash_type, oval_filehash58_hash_type_sexp) == OVAL_RESULT_TRUE) {
+			types[type_cnt].name = oval_filehash58_hash_type;
+			types[type_cnt].alg = oscap_string_to_enum(CRAPI_ALG_MAP, oval_filehash58_hash_type);
+			types[type_cnt].len = oscap_string_to_enum(CRAPI_ALG_MAP_SIZE, oval_filehash58_hash_type);
+			++type_cnt;
+		}
+
+		SEXP_free(oval_filehash58_hash_type_sexp);
+	}
+
 	const char *prefix = getenv("OSCAP_PROBE_ROOT");
 	if ((ofts = oval_fts_open_prefixed(prefix, path, filename, filepath, behaviors, probe_ctx_getresult(ctx))) != NULL) {
-		while ((ofts_ent = oval_fts_read(ofts)) != NULL) {
-			/* find hash types to compare with entity, think "not satisfy" */
-			for (int i = 0; OVAL_FILEHASH58_HASH_TYPES[i] != NULL; i++) {
-				const char *oval_filehash58_hash_type = OVAL_FILEHASH58_HASH_TYPES[i];
-				SEXP_t *oval_filehash58_hash_type_sexp = SEXP_string_new(oval_filehash58_hash_type, strlen(oval_filehash58_hash_type));
-				if (probe_entobj_cmp(hash_type, oval_filehash58_hash_type_sexp) == OVAL_RESULT_TRUE) {
-					filehash58_cb(prefix, ofts_ent->path, ofts_ent->file, oval_filehash58_hash_type, ctx);
-				}
-
-				SEXP_free(oval_filehash58_hash_type_sexp);
-			}
-			oval_ftsent_free(ofts_ent);
+		if (type_cnt > 0 && filehash58_pool_init(&pool, prefix, types, type_cnt) == 0) {
+			while ((ofts_ent = oval_fts_read(ofts)) != NULL)
+				filehash58_pool_add(&pool, ofts_ent, ctx);
+
+			filehash58_pool_fini(&pool, ctx);
+		} else {
+			while ((ofts_ent = oval_fts_read(ofts)) != NULL)
+				oval_ftsent_free(ofts_ent);
 		}
 
 		oval_fts_close(ofts);
@@ -43,7 +43,6 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <limits.h>
-#include <pcre.h>
 
 #include "_seap.h"
 #include <probe-api.h>
@@ -53,6 +52,7 @@
 #include <oval_fts.h>
 #include "common/debug_priv.h"
 #include "common/util.h"
+#include "common/oscap_pcre.h"
 #include "textfilecontent54_probe.h"
 
 #define FILE_SEPARATOR '/'
@@ -112,10 +112,10 @@ static SEXP_t *create_item(const char *path, const char *filename, char *pattern
 
 struct pfdata {
 	char *pattern;
-	int re_opts;
+	oscap_pcre_options_t re_opts;
 	SEXP_t *instance_ent;
         probe_ctx *ctx;
-	pcre *compiled_regex;
+	oscap_pcre_t *compiled_regex;
 };
 
 static int process_file(const char *prefix, const char *path, const char *file, void *arg, oval_schema_version_t over)
@@ -216,7 +216,7 @@ static int process_file(const char *prefix, const char *path, const char *file,
 			want_instance = 0;
 
 		SEXP_free(next_inst);
-		substr_cnt = oscap_get_substrings(buf, &ofs, pfd->compiled_regex, want_instance, &substrs);
+		substr_cnt = oscap_pcre_get_substrings(buf, &ofs, pfd->compiled_regex, want_instance, &substrs);
 
 		if (substr_cnt < 0) {
 			SEXP_t *msg;
@@ -274,7 +274,7 @@ int textfilecontent54_probe_main(probe_ctx *ctx, void *arg)
 	struct pfdata pfd;
 	int ret = 0;
 	int errorffset = -1;
-	const char *error;
+	char *error = NULL;
 	OVAL_FTS    *ofts;
 	OVAL_FTSENT *ofts_ent;
 
@@ -316,31 +316,32 @@ int textfilecontent54_probe_main(probe_ctx *ctx, void *arg)
 
 	pfd.instance_ent = inst_ent;
         pfd.ctx          = ctx;
-	pfd.re_opts = PCRE_UTF8;
+	pfd.re_opts = OSCAP_PCRE_OPTS_UTF8;
 	r0 = probe_ent_getattrval(bh_ent, "ignore_case");
 	if (r0) {
 		val = SEXP_string_getb(r0);
 		SEXP_free(r0);
 		if (val)
-			pfd.re_opts |= PCRE_CASELESS;
+			pfd.re_opts |= OSCAP_PCRE_OPTS_CASELESS;
 	}
 	r0 = probe_ent_getattrval(bh_ent, "multiline");
 	if (r0) {
 		val = SEXP_string_getb(r0);
 		SEXP_free(r0);
 		if (val)
-			pfd.re_opts |= PCRE_MULTILINE;
+			pfd.re_opts |= OSCAP_PCRE_OPTS_MULTILINE;
 	}
 	r0 = probe_ent_getattrval(bh_ent, "singleline");
 	if (r0) {
 		val = SEXP_string_getb(r0);
 		SEXP_free(r0);
 		if (val)
-			pfd.re_opts |= PCRE_DOTALL;
+			pfd.re_opts |= OSCAP_PCRE_OPTS_DOTALL;
 	}
 
-	pfd.compiled_regex = pcre_compile(pfd.pattern, pfd.re_opts, &error,
-					  &errorffset, NULL);
+	/* the pattern is matched in every file, get it JIT compiled from the cache */
+	pfd.compiled_regex = oscap_pcre_get_cached(pfd.pattern, pfd.re_opts, &error,
+						   &errorffset);
 	if (pfd.compiled_regex == NULL) {
 		SEXP_t *msg;
 
@@ -348,6 +349,7 @@ int textfilecontent54_probe_main(probe_ctx *ctx, void *arg)
 		probe_cobj_add_msg(probe_ctx_getresult(pfd.ctx), msg);
 		SEXP_free(msg);
 		probe_cobj_set_flag(probe_ctx_getresult(pfd.ctx), SYSCHAR_FLAG_ERROR);
+		oscap_pcre_err_free(error);
 		goto cleanup;
 	}
 
@@ -375,6 +377,6 @@ int textfilecontent54_probe_main(probe_ctx *ctx, void *arg)
 	if (pfd.pattern != NULL)
 		free(pfd.pattern);
 	if (pfd.compiled_regex != NULL)
-		pcre_free(pfd.compiled_regex);
+		oscap_pcre_free(pfd.compiled_regex);
 	return ret;
 }
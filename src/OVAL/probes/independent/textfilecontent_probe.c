@@ -62,7 +62,6 @@
 #include <sys/types.h>
 #include <fcntl.h>
 #include <limits.h>
-#include <pcre.h>
 
 #include "_seap.h"
 #include <probe-api.h>
@@ -72,6 +71,7 @@
 #include <oval_fts.h>
 #include "common/debug_priv.h"
 #include "common/util.h"
+#include "common/oscap_pcre.h"
 #include "textfilecontent_probe.h"
 
 #define FILE_SEPARATOR '/'
@@ -148,11 +148,12 @@ static int process_file(const char *prefix, const char *path, const char *filena
 
 // todo: move to probe_main()?
 	int erroffset = -1;
-	pcre *re = NULL;
-	const char *error;
+	oscap_pcre_t *re = NULL;
+	char *error = NULL;
 
-	re = pcre_compile(pfd->pattern, PCRE_UTF8, &error, &erroffset, NULL);
+	re = oscap_pcre_get_cached(pfd->pattern, OSCAP_PCRE_OPTS_UTF8, &error, &erroffset);
 	if (re == NULL) {
+		oscap_pcre_err_free(error);
 		return -1;
 	}
 
@@ -195,7 +196,7 @@ static int process_file(const char *prefix, const char *path, const char *filena
 	int ofs = 0;
 
 	while (fgets(line, sizeof(line), fp) != NULL) {
-		substr_cnt = oscap_get_substrings(line, &ofs, re, 1, &substrs);
+		substr_cnt = oscap_pcre_get_substrings(line, &ofs, re, 1, &substrs);
 		if (substr_cnt > 0) {
 			int k;
 			SEXP_t *item;
@@ -218,7 +219,7 @@ static int process_file(const char *prefix, const char *path, const char *filena
 	if (whole_path != NULL)
 		free(whole_path);
 	if (re != NULL)
-		pcre_free(re);
+		oscap_pcre_free(re);
 	free(whole_path_with_prefix);
 
 	return ret;
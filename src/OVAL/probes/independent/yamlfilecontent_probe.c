@@ -26,13 +26,13 @@
 
 #include <math.h>
 #include <errno.h>
-#include <pcre.h>
 #include <yaml.h>
 #include <yaml-path.h>
 
 #include "yamlfilecontent_probe.h"
 #include "sexp-manip.h"
 #include "debug_priv.h"
+#include "oscap_pcre.h"
 #include "oval_fts.h"
 #include "list.h"
 #include "probe/probe.h"
@@ -52,17 +52,19 @@ int yamlfilecontent_probe_offline_mode_supported()
 
 static bool match_regex(const char *pattern, const char *value)
 {
-	const char *errptr;
+	char *errptr;
 	int erroroffset;
-	pcre *re = pcre_compile(pattern, 0, &errptr, &erroroffset, NULL);
+	/* the same few patterns are matched with every scalar */
+	oscap_pcre_t *re = oscap_pcre_get_cached(pattern, OSCAP_PCRE_OPTS_NONE, &errptr, &erroroffset);
 	if (re == NULL) {
 		dE("pcre_compile failed on pattern '%s': %s at %d", pattern,
 			errptr, erroroffset);
+		oscap_pcre_err_free(errptr);
 		return false;
 	}
 	int ovector[OVECCOUNT];
-	int rc = pcre_exec(re, NULL, value, strlen(value), 0, 0, ovector, OVECCOUNT);
-	pcre_free(re);
+	int rc = oscap_pcre_exec(re, value, strlen(value), 0, OSCAP_PCRE_OPTS_NONE, ovector, OVECCOUNT);
+	oscap_pcre_free(re);
 	if (rc > 0) {
 		return true;
 	}
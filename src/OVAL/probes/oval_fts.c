@@ -32,7 +32,6 @@
 #include <sys/stat.h>
 #include <limits.h>
 #include <errno.h>
-#include <pcre.h>
 
 #include "oscap_helpers.h"
 #include "fsdev.h"
@@ -51,6 +50,15 @@
 #include <fts.h>
 #endif
 
+#if defined(OS_LINUX)
+#include <dirent.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "oval_fts_cache.h"
+#define OVAL_FTS_WALK
+#endif
+
 #undef OSCAP_FTS_DEBUG
 
 static OVAL_FTS *OVAL_FTS_new()
@@ -90,11 +98,46 @@ static int pathlen_from_ftse(int fts_pathlen, int fts_namelen)
 	return pathlen;
 }
 
+/* The entry and both of its strings are stored in a single allocation */
+static OVAL_FTSENT *OVAL_FTSENT_alloc(const char *path, size_t path_len,
+                                      const char *file, size_t file_len,
+                                      unsigned int fts_info)
+{
+	OVAL_FTSENT *ofts_ent;
+
+	if (path_len == 0) {
+		path = "/";
+		path_len = 1;
+	}
+
+	ofts_ent = malloc(sizeof(OVAL_FTSENT) + path_len + 1 + (file != NULL ? file_len + 1 : 0));
+	if (ofts_ent == NULL)
+		return NULL;
+
+	ofts_ent->fts_info = fts_info;
+	ofts_ent->path = (char *)(ofts_ent + 1);
+	ofts_ent->path_len = path_len;
+	memcpy(ofts_ent->path, path, path_len);
+	ofts_ent->path[path_len] = '\0';
+
+	if (file != NULL) {
+		ofts_ent->file = ofts_ent->path + path_len + 1;
+		ofts_ent->file_len = file_len;
+		memcpy(ofts_ent->file, file, file_len);
+		ofts_ent->file[file_len] = '\0';
+	} else {
+		ofts_ent->file = NULL;
+		ofts_ent->file_len = -1;
+	}
+
+	return (ofts_ent);
+}
+
 static OVAL_FTSENT *OVAL_FTSENT_new(OVAL_FTS *ofts, FTSENT *fts_ent)
 {
-	OVAL_FTSENT *ofts_ent = calloc(1, sizeof(OVAL_FTSENT));
+	OVAL_FTSENT *ofts_ent;
+	int path_len;
 
-	ofts_ent->fts_info = fts_ent->fts_info;
 	/* The 'shift' variable stores length of the prefix if the prefix
 	 * is defined, otherwise it is set to 0. The value of 'shift' gives
 	 * us information how many characters of the path string are part of
@@ -103,29 +146,13 @@ static OVAL_FTSENT *OVAL_FTSENT_new(OVAL_FTS *ofts, FTSENT *fts_ent)
 	 */
 	const size_t shift = ofts->prefix ? strlen(ofts->prefix) : 0;
 	if (ofts->ofts_sfilename || ofts->ofts_sfilepath) {
-		ofts_ent->path_len = pathlen_from_ftse(fts_ent->fts_pathlen, fts_ent->fts_namelen) - shift;
-		if (ofts_ent->path_len > 0) {
-			ofts_ent->path = malloc(ofts_ent->path_len + 1);
-			strncpy(ofts_ent->path, fts_ent->fts_path + shift, ofts_ent->path_len);
-			ofts_ent->path[ofts_ent->path_len] = '\0';
-		} else {
-			ofts_ent->path_len = 1;
-			ofts_ent->path = strdup("/");
-		}
-
-		ofts_ent->file_len = fts_ent->fts_namelen;
-		ofts_ent->file = strdup(fts_ent->fts_name);
+		path_len = pathlen_from_ftse(fts_ent->fts_pathlen, fts_ent->fts_namelen) - shift;
+		ofts_ent = OVAL_FTSENT_alloc(fts_ent->fts_path + shift, path_len > 0 ? path_len : 0,
+		                             fts_ent->fts_name, fts_ent->fts_namelen, fts_ent->fts_info);
 	} else {
-		ofts_ent->path_len = fts_ent->fts_pathlen - shift;
-		if (ofts_ent->path_len > 0) {
-			ofts_ent->path = strdup(fts_ent->fts_path + shift);
-		} else {
-			ofts_ent->path_len = 1;
-			ofts_ent->path = strdup("/");
-		}
-
-		ofts_ent->file_len = -1;
-		ofts_ent->file = NULL;
+		path_len = fts_ent->fts_pathlen - shift;
+		ofts_ent = OVAL_FTSENT_alloc(fts_ent->fts_path + shift, path_len > 0 ? path_len : 0,
+		                             NULL, 0, fts_ent->fts_info);
 	}
 
 #if defined(OSCAP_FTS_DEBUG)
@@ -136,8 +163,6 @@ static OVAL_FTSENT *OVAL_FTSENT_new(OVAL_FTS *ofts, FTSENT *fts_ent)
 
 static void OVAL_FTSENT_free(OVAL_FTSENT *ofts_ent)
 {
-	free(ofts_ent->path);
-	free(ofts_ent->file);
 	free(ofts_ent);
 	return;
 }
@@ -381,25 +406,21 @@ static char *extract_fixed_path_prefix(char *path)
 
 static int badpartial_check_slash(const char *pattern)
 {
-	pcre *regex;
-	const char *errptr = NULL;
-	int errofs = 0, fb, ret;
+	oscap_pcre_t *regex;
+	char *errptr = NULL;
+	int errofs = 0, fb;
 
-	regex = pcre_compile(pattern + 1 /* skip '^' */, 0, &errptr, &errofs, NULL);
+	regex = oscap_pcre_compile(pattern + 1 /* skip '^' */, OSCAP_PCRE_OPTS_NONE, &errptr, &errofs);
 	if (regex == NULL) {
 		dE("Failed to validate the pattern: pcre_compile(): "
 		   "error: '%s', error offset: %d, pattern: '%s'.\n",
 		   errptr, errofs, pattern);
+		oscap_pcre_err_free(errptr);
 		return -1;
 	}
-	ret = pcre_fullinfo(regex, NULL, PCRE_INFO_FIRSTBYTE, &fb);
-	pcre_free(regex);
+	fb = oscap_pcre_first_char(regex);
+	oscap_pcre_free(regex);
 	regex = NULL;
-	if (ret != 0) {
-		dE("Failed to validate the pattern: pcre_fullinfo(): "
-		   "return code: %d, pattern: '%s'.\n", ret, pattern);
-		return -1;
-	}
 	if (fb != '/') {
 		dE("Failed to validate the pattern: pcre_fullinfo(): "
 		   "first byte: %d '%c', pattern: '%s' - the first "
@@ -413,7 +434,7 @@ static int badpartial_check_slash(const char *pattern)
 #define TEST_PATH1 "/"
 #define TEST_PATH2 "x"
 
-static int badpartial_transform_pattern(char *pattern, pcre **regex_out)
+static int badpartial_transform_pattern(char *pattern, oscap_pcre_t **regex_out)
 {
 	/*
 	  PCREPARTIAL(3)
@@ -435,10 +456,10 @@ static int badpartial_transform_pattern(char *pattern, pcre **regex_out)
 	int ret, brkt_lvl = 0, errofs = 0;
 	const char *rchars = "\\[]()*+{"; /* probably incomplete */
 	const char *test_path1 = TEST_PATH1;
-	const char *errptr = NULL;
+	char *errptr = NULL;
 	char *s, *brkt_mark;
 	bool bracketed = false, found_regex = false;
-	pcre *regex;
+	oscap_pcre_t *regex;
 
 	/* The processing bellow builds upon the assumption that
 	   the pattern has been validated by pcre_compile() */
@@ -488,18 +509,19 @@ static int badpartial_transform_pattern(char *pattern, pcre **regex_out)
 	else
 		*s = '\0';
 
-	regex = pcre_compile(pattern, 0, &errptr, &errofs, NULL);
+	regex = oscap_pcre_get_cached(pattern, OSCAP_PCRE_OPTS_PARTIAL, &errptr, &errofs);
 	if (regex == NULL) {
 		dW("Nonfatal failure: can't transform the pattern for partial "
 		   "match optimization, error: '%s', error offset: %d, "
 		   "pattern: '%s'.", errptr, errofs, pattern);
+		oscap_pcre_err_free(errptr);
 		return -1;
 	}
 
-	ret = pcre_exec(regex, NULL, test_path1, strlen(test_path1), 0,
-		PCRE_PARTIAL, NULL, 0);
-	if (ret != PCRE_ERROR_PARTIAL && ret < 0) {
-		pcre_free(regex);
+	ret = oscap_pcre_exec(regex, test_path1, strlen(test_path1), 0,
+		OSCAP_PCRE_OPTS_PARTIAL, NULL, 0);
+	if (ret != OSCAP_PCRE_ERR_PARTIAL && ret < 0) {
+		oscap_pcre_free(regex);
 		dW("Nonfatal failure: can't transform the pattern for partial "
 		   "match optimization, pcre_exec() return code: %d, pattern: "
 		   "'%s'.", ret, pattern);
@@ -515,14 +537,14 @@ static int badpartial_transform_pattern(char *pattern, pcre **regex_out)
 /* Verify that the path is usable and try to craft a regex to speed up
    the filesystem traversal. If the path to match is ill-designed, an
    ugly heuristic is employed to obtain something meaningfull. */
-static int process_pattern_match(const char *path, pcre **regex_out)
+static int process_pattern_match(const char *path, oscap_pcre_t **regex_out)
 {
 	int ret, errofs = 0;
 	char *pattern;
 	const char *test_path1 = TEST_PATH1;
 	//const char *test_path2 = TEST_PATH2;
-	const char *errptr = NULL;
-	pcre *regex;
+	char *errptr = NULL;
+	oscap_pcre_t *regex;
 
 	if (path[0] != '^') {
 		/* Matching has to have a fixed starting point and thus
@@ -540,19 +562,22 @@ static int process_pattern_match(const char *path, pcre **regex_out)
 		pattern = strdup(path);
 	}
 
-	regex = pcre_compile(pattern, 0, &errptr, &errofs, NULL);
+	/* the same paths are traversed by many objects, the partial match
+	   optimization is JIT compiled and cached */
+	regex = oscap_pcre_get_cached(pattern, OSCAP_PCRE_OPTS_PARTIAL, &errptr, &errofs);
 	if (regex == NULL) {
 		dE("Failed to validate the pattern: pcre_compile(): "
 		   "error offset: %d, error: '%s', pattern: '%s'.\n",
 		   errofs, errptr, pattern);
+		oscap_pcre_err_free(errptr);
 		free(pattern);
 		return -1;
 	}
-	ret = pcre_exec(regex, NULL, test_path1, strlen(test_path1), 0,
-		PCRE_PARTIAL, NULL, 0);
+	ret = oscap_pcre_exec(regex, test_path1, strlen(test_path1), 0,
+		OSCAP_PCRE_OPTS_PARTIAL, NULL, 0);
 
 	switch (ret) {
-	case PCRE_ERROR_PARTIAL:
+	case OSCAP_PCRE_ERR_PARTIAL:
 		/* The pattern has matched a prefix of the test path
 		   and probably begins with a slash. Make sure that it
 		   doesn't match an arbitrary prefix. */
@@ -577,11 +602,11 @@ static int process_pattern_match(const char *path, pcre **regex_out)
 		}
 		*/
 		break;
-	case PCRE_ERROR_BADPARTIAL:
+	case OSCAP_PCRE_ERR_BADPARTIAL:
 		dD("pcre_exec() returned PCRE_ERROR_BADPARTIAL for pattern "
 		   "'%s' and a test path '%s'. Falling back to "
 		   "pcre_fullinfo().\n", pattern, test_path1);
-		pcre_free(regex);
+		oscap_pcre_free(regex);
 		regex = NULL;
 
 		/* Fallback to first byte check to determin if
@@ -597,7 +622,7 @@ static int process_pattern_match(const char *path, pcre **regex_out)
 		   can be handled. */
 		badpartial_transform_pattern(pattern, &regex);
 		break;
-	case PCRE_ERROR_NOMATCH:
+	case OSCAP_PCRE_ERR_NOMATCH:
 		/* The pattern doesn't contain a leading slash (or
 		   some part of this code is broken). Apologise to the
 		   user and fail. */
@@ -605,7 +630,7 @@ static int process_pattern_match(const char *path, pcre **regex_out)
 		   "PCRE_ERROR_NOMATCH for pattern '%s' and a test path '%s'. "
 		   "This indicates the pattern doesn't match a leading '/'.\n",
 		   pattern, test_path1);
-		pcre_free(regex);
+		oscap_pcre_free(regex);
 		free(pattern);
 		return -2;
 	default:
@@ -637,7 +662,7 @@ static int process_pattern_match(const char *path, pcre **regex_out)
 		dE("Failed to validate the pattern: pcre_exec() return "
 		   "code: %d, pattern '%s', test path '%s'.\n", ret,
 		   pattern, test_path1);
-		pcre_free(regex);
+		oscap_pcre_free(regex);
 		free(pattern);
 		return -1;
 	}
@@ -660,6 +685,602 @@ static int process_pattern_match(const char *path, pcre **regex_out)
 #undef TEST_PATH1
 #undef TEST_PATH2
 
+#if defined(OVAL_FTS_WALK)
+/*
+ * Parallel traversal for recurse_direction="down"
+ *
+ * The directories are read by a pool of worker threads through the directory
+ * cache in oval_fts_cache.c. A worker keeps the matching entries and the
+ * subdirectories of the directory it reads in the order of the directory
+ * listing. oval_fts_read() merges the results of the directories in the
+ * depth-first order, so the entries are returned in the same order with any
+ * number of threads. The directories are taken from a stack shared by the
+ * workers, the directory oval_fts_read() waits for is read first. The
+ * workers stop reading ahead when OVAL_FTS_WALK_AHEAD entries are waiting.
+ *
+ * The walker reports the same entries as the fts based traversal in
+ * oval_fts_read_recurse_path(), but not necessarily in the same order.
+ * Directories, entries of unknown type and symlink targets are stat-ed, the
+ * other entries are classified using d_type only.
+ *
+ * It is used only if the recursion into directories is enabled. Without it,
+ * the fts traversal descends into a directory only if it's reached right
+ * after following a symlink, which depends on the order of the traversal.
+ */
+
+/* Upper bound of the default number of threads */
+#define OVAL_FTS_WALK_THREADS_MAX 8
+#define OVAL_FTS_WALK_AHEAD       4096
+
+/* ancestors of a directory, used for the detection of cycles */
+struct oval_fts_walk_anc {
+	struct oval_fts_walk_anc *parent;
+	dev_t    dev;
+	ino_t    ino;
+	uint32_t refs;
+};
+
+enum {
+	OVAL_FTS_WALK_QUEUED,  /* waiting in the stack */
+	OVAL_FTS_WALK_READING, /* being read by a worker */
+	OVAL_FTS_WALK_DONE     /* the items are complete */
+};
+
+struct oval_fts_walk_dir;
+
+/* matching entry or subdirectory, one of them is set */
+struct oval_fts_walk_item {
+	OVAL_FTSENT *ent;
+	struct oval_fts_walk_dir *subdir;
+};
+
+/* directory of the tree, it owns its items */
+struct oval_fts_walk_dir {
+	struct oval_fts_walk_dir *parent;
+	struct oval_fts_walk_anc *anc;
+	int    level;
+	int    state;    /* protected by the walk mutex */
+	size_t slot;     /* position in the stack while queued */
+
+	struct oval_fts_walk_item *item;
+	size_t item_cnt;
+	size_t item_cap;
+	size_t ent_cnt;  /* number of entries among the items */
+	size_t next;     /* next item to return by oval_fts_read() */
+
+	size_t pathlen;
+	char   path[];
+};
+
+struct oval_fts_walk {
+	OVAL_FTS *ofts;
+	bool   collect_dirs;
+	size_t shift;
+
+	pthread_mutex_t mutex;    /* protects everything below */
+	pthread_cond_t  work_cond;
+	pthread_cond_t  done_cond;
+
+	struct oval_fts_walk_dir **stack; /* queued directories, NULL if taken out of order */
+	size_t stack_cnt;
+	size_t stack_cap;
+
+	size_t pending;  /* directories queued or being read */
+	size_t ahead;    /* entries of read directories not returned yet */
+	bool   abort;
+	bool   error;    /* a filename comparison failed */
+
+	OVAL_FTSENT *first; /* the root, returned before the tree */
+	struct oval_fts_walk_dir *cur;    /* directory being returned */
+	struct oval_fts_walk_dir *wanted; /* directory oval_fts_read() waits for */
+
+	unsigned  running; /* number of started worker threads */
+	pthread_t *thid;
+};
+
+static struct oval_fts_walk_anc *oval_fts_walk_anc_new(struct oval_fts_walk_anc *parent, dev_t dev, ino_t ino)
+{
+	struct oval_fts_walk_anc *anc = malloc(sizeof(struct oval_fts_walk_anc));
+
+	if (anc == NULL)
+		return NULL;
+
+	anc->parent = parent;
+	anc->dev = dev;
+	anc->ino = ino;
+	anc->refs = 1;
+
+	if (parent != NULL)
+		__sync_fetch_and_add(&parent->refs, 1);
+
+	return (anc);
+}
+
+static void oval_fts_walk_anc_free(struct oval_fts_walk_anc *anc)
+{
+	while (anc != NULL && __sync_sub_and_fetch(&anc->refs, 1) == 0) {
+		struct oval_fts_walk_anc *parent = anc->parent;
+
+		free(anc);
+		anc = parent;
+	}
+}
+
+static bool oval_fts_walk_anc_cycle(const struct oval_fts_walk_anc *anc, dev_t dev, ino_t ino)
+{
+	for (; anc != NULL; anc = anc->parent) {
+		if (anc->dev == dev && anc->ino == ino)
+			return (true);
+	}
+
+	return (false);
+}
+
+static struct oval_fts_walk_dir *oval_fts_walk_dir_new(struct oval_fts_walk_dir *parent, int level, size_t pathlen)
+{
+	struct oval_fts_walk_dir *dir = calloc(1, sizeof(struct oval_fts_walk_dir) + pathlen + 1);
+
+	if (dir == NULL)
+		return NULL;
+
+	dir->parent = parent;
+	dir->level = level;
+	dir->state = OVAL_FTS_WALK_DONE;
+
+	return (dir);
+}
+
+/* free the directory with the items which were not returned yet */
+static void oval_fts_walk_dir_free(struct oval_fts_walk_dir *dir)
+{
+	size_t i;
+
+	for (i = 0; i < dir->item_cnt; ++i) {
+		if (dir->item[i].ent != NULL)
+			OVAL_FTSENT_free(dir->item[i].ent);
+		if (dir->item[i].subdir != NULL)
+			oval_fts_walk_dir_free(dir->item[i].subdir);
+	}
+
+	oval_fts_walk_anc_free(dir->anc);
+	free(dir->item);
+	free(dir);
+}
+
+static bool oval_fts_walk_aborted(struct oval_fts_walk *walk)
+{
+	return __atomic_load_n(&walk->abort, __ATOMIC_RELAXED);
+}
+
+static bool oval_fts_walk_add(struct oval_fts_walk_dir *dir, OVAL_FTSENT *ent, struct oval_fts_walk_dir *subdir)
+{
+	if (dir->item_cnt == dir->item_cap) {
+		size_t cap = dir->item_cap > 0 ? dir->item_cap * 2 : 16;
+		void *item = realloc(dir->item, sizeof(struct oval_fts_walk_item) * cap);
+
+		if (item == NULL) {
+			dE("Can't allocate memory for the entries of '%s'.", dir->path);
+			return (false);
+		}
+
+		dir->item = item;
+		dir->item_cap = cap;
+	}
+
+	dir->item[dir->item_cnt].ent = ent;
+	dir->item[dir->item_cnt].subdir = subdir;
+	++dir->item_cnt;
+
+	if (ent != NULL)
+		++dir->ent_cnt;
+
+	return (true);
+}
+
+static void oval_fts_walk_emit(struct oval_fts_walk_dir *dir, OVAL_FTSENT *ofts_ent)
+{
+	if (ofts_ent == NULL)
+		return;
+
+	if (!oval_fts_walk_add(dir, ofts_ent, NULL))
+		OVAL_FTSENT_free(ofts_ent);
+}
+
+/* emit a non-directory entry of dirpath if its name matches the filename entity */
+static void oval_fts_walk_emit_file(struct oval_fts_walk *walk, struct oval_fts_walk_dir *dir,
+                                    const char *dirpath, size_t dirpathlen,
+                                    const char *name, size_t namelen, unsigned int fts_info)
+{
+	SEXP_t *stmp;
+
+	if (walk->collect_dirs)
+		return;
+
+	stmp = SEXP_string_new(name, namelen);
+
+	switch (probe_entobj_cmp(walk->ofts->ofts_sfilename, stmp)) {
+	case OVAL_RESULT_TRUE:
+		oval_fts_walk_emit(dir, OVAL_FTSENT_alloc(dirpath + walk->shift, dirpathlen - walk->shift,
+		                                          name, namelen, fts_info));
+		break;
+	case OVAL_RESULT_ERROR:
+		__atomic_store_n(&walk->error, true, __ATOMIC_RELAXED);
+		break;
+	default:
+		break;
+	}
+
+	SEXP_free(stmp);
+}
+
+/* queue the directory, the caller holds the walk mutex */
+static void oval_fts_walk_push(struct oval_fts_walk *walk, struct oval_fts_walk_dir *dir)
+{
+	if (walk->stack_cnt == walk->stack_cap) {
+		size_t cap = walk->stack_cap > 0 ? walk->stack_cap * 2 : 64;
+		void *stack = realloc(walk->stack, sizeof(struct oval_fts_walk_dir *) * cap);
+
+		if (stack == NULL) {
+			/* the directory stays empty */
+			dE("Can't allocate memory for the directory queue, skipping '%s'.", dir->path);
+			return;
+		}
+
+		walk->stack = stack;
+		walk->stack_cap = cap;
+	}
+
+	dir->state = OVAL_FTS_WALK_QUEUED;
+	dir->slot = walk->stack_cnt;
+	walk->stack[walk->stack_cnt++] = dir;
+	++walk->pending;
+}
+
+/* take the directory to read next, the caller holds the walk mutex */
+static struct oval_fts_walk_dir *oval_fts_walk_take(struct oval_fts_walk *walk)
+{
+	struct oval_fts_walk_dir *dir = NULL;
+
+	if (walk->wanted != NULL && walk->wanted->state == OVAL_FTS_WALK_QUEUED) {
+		dir = walk->wanted;
+		walk->stack[dir->slot] = NULL;
+	} else if (walk->ahead < OVAL_FTS_WALK_AHEAD) {
+		while (walk->stack_cnt > 0 && dir == NULL)
+			dir = walk->stack[--walk->stack_cnt];
+	}
+
+	if (dir != NULL)
+		dir->state = OVAL_FTS_WALK_READING;
+
+	return (dir);
+}
+
+/* handle a directory found in the tree, either directly or through a symlink */
+static void oval_fts_walk_subdir(struct oval_fts_walk *walk, struct oval_fts_walk_dir *dir,
+                                 const struct oval_fts_cache_ent *ent)
+{
+	OVAL_FTS *ofts = walk->ofts;
+	struct oval_fts_walk_dir *subdir;
+	int level = dir->level + 1;
+	bool depth_ok = (ofts->max_depth == -1 || level <= ofts->max_depth);
+
+	if (oval_fts_walk_anc_cycle(dir->anc, ent->dev, ent->ino)) {
+		dW("Filesystem tree cycle detected at '%s/%s'.", dir->path, ent->name);
+		return;
+	}
+
+	subdir = oval_fts_walk_dir_new(dir, level, dir->pathlen + ent->namelen + 1);
+	if (subdir == NULL)
+		return;
+
+	memcpy(subdir->path, dir->path, dir->pathlen);
+	subdir->pathlen = dir->pathlen;
+	if (subdir->pathlen == 0 || subdir->path[subdir->pathlen - 1] != '/')
+		subdir->path[subdir->pathlen++] = '/';
+	memcpy(subdir->path + subdir->pathlen, ent->name, ent->namelen);
+	subdir->pathlen += ent->namelen;
+	subdir->path[subdir->pathlen] = '\0';
+
+	/* collect matching target */
+	if (walk->collect_dirs && depth_ok) {
+		oval_fts_walk_emit(dir, OVAL_FTSENT_alloc(subdir->path + walk->shift, subdir->pathlen - walk->shift,
+		                                          NULL, 0, FTS_D));
+	}
+
+	/* limit recursion depth */
+	if (!depth_ok)
+		goto skip;
+	/* don't recurse into non-local filesystems */
+	if (ofts->filesystem == OVAL_RECURSE_FS_LOCAL && !OVAL_FTS_localp(ofts, subdir->path, (void *)&ent->dev))
+		goto skip;
+	/* don't recurse beyond the initial filesystem */
+	if (ofts->filesystem == OVAL_RECURSE_FS_DEFINED && ofts->ofts_recurse_path_devid != ent->dev)
+		goto skip;
+
+	subdir->anc = oval_fts_walk_anc_new(dir->anc, ent->dev, ent->ino);
+	if (subdir->anc == NULL)
+		goto skip;
+
+	/* the subdirectory is queued once the directory is read */
+	if (oval_fts_walk_add(dir, NULL, subdir))
+		return;
+skip:
+	oval_fts_walk_dir_free(subdir);
+}
+
+static void oval_fts_walk_entry(struct oval_fts_walk *walk, struct oval_fts_walk_dir *dir,
+                                const struct oval_fts_cache_ent *ent)
+{
+	OVAL_FTS *ofts = walk->ofts;
+	int level = dir->level + 1;
+
+	switch (ent->type) {
+	case DT_UNKNOWN:
+		oval_fts_walk_emit_file(walk, dir, dir->path, dir->pathlen, ent->name, ent->namelen, FTS_NS);
+		break;
+	case DT_DIR:
+		oval_fts_walk_subdir(walk, dir, ent);
+		break;
+	case DT_LNK:
+		oval_fts_walk_emit_file(walk, dir, dir->path, dir->pathlen, ent->name, ent->namelen, FTS_SL);
+
+		if (!(ofts->recurse & OVAL_RECURSE_SYMLINKS)
+		    || (ofts->max_depth != -1 && level > ofts->max_depth))
+			break;
+
+		/* follow the symlink, the target is reported as well */
+		if (ent->ltype == DT_UNKNOWN)
+			oval_fts_walk_emit_file(walk, dir, dir->path, dir->pathlen, ent->name, ent->namelen, FTS_SLNONE);
+		else if (ent->ltype == DT_DIR)
+			oval_fts_walk_subdir(walk, dir, ent);
+		else
+			oval_fts_walk_emit_file(walk, dir, dir->path, dir->pathlen, ent->name, ent->namelen,
+			                        ent->ltype == DT_REG ? FTS_F : FTS_DEFAULT);
+		break;
+	case DT_REG:
+		oval_fts_walk_emit_file(walk, dir, dir->path, dir->pathlen, ent->name, ent->namelen, FTS_F);
+		break;
+	default:
+		oval_fts_walk_emit_file(walk, dir, dir->path, dir->pathlen, ent->name, ent->namelen, FTS_DEFAULT);
+		break;
+	}
+}
+
+static void oval_fts_walk_read(struct oval_fts_walk *walk, struct oval_fts_walk_dir *dir)
+{
+	struct oval_fts_cache_dir *cdir;
+	size_t i;
+
+	cdir = oval_fts_cache_get(dir->path);
+	if (cdir == NULL) {
+		dE("Can't read the directory '%s'.", dir->path);
+		return;
+	}
+
+	if (cdir->unreadable) {
+		/* fts reports unreadable directories as FTS_DNR entries */
+		if (dir->level > 0) {
+			const char *name = strrchr(dir->path, '/') + 1;
+
+			oval_fts_walk_emit_file(walk, dir, dir->path, name - dir->path - 1,
+			                        name, strlen(name), FTS_DNR);
+		}
+	} else {
+		for (i = 0; i < cdir->count && !oval_fts_walk_aborted(walk); ++i)
+			oval_fts_walk_entry(walk, dir, &cdir->ent[i]);
+	}
+
+	oval_fts_cache_release(cdir);
+}
+
+static void *oval_fts_walk_worker(void *arg)
+{
+	struct oval_fts_walk *walk = arg;
+	struct oval_fts_walk_dir *dir;
+	size_t i;
+
+	pthread_mutex_lock(&walk->mutex);
+
+	for (;;) {
+		dir = NULL;
+
+		while (walk->pending > 0 && !walk->abort && (dir = oval_fts_walk_take(walk)) == NULL)
+			pthread_cond_wait(&walk->work_cond, &walk->mutex);
+
+		if (dir == NULL)
+			break;
+
+		pthread_mutex_unlock(&walk->mutex);
+
+		oval_fts_walk_read(walk, dir);
+
+		/* the subdirectories have their own references to the ancestors */
+		oval_fts_walk_anc_free(dir->anc);
+		dir->anc = NULL;
+
+		pthread_mutex_lock(&walk->mutex);
+
+		/* queue the subdirectories so that the first one is taken first */
+		for (i = dir->item_cnt; i > 0; --i) {
+			if (dir->item[i - 1].subdir != NULL)
+				oval_fts_walk_push(walk, dir->item[i - 1].subdir);
+		}
+
+		dir->state = OVAL_FTS_WALK_DONE;
+		walk->ahead += dir->ent_cnt;
+		--walk->pending;
+
+		pthread_cond_broadcast(&walk->work_cond);
+		if (dir == walk->wanted || walk->pending == 0)
+			pthread_cond_signal(&walk->done_cond);
+	}
+
+	pthread_mutex_unlock(&walk->mutex);
+
+	return (NULL);
+}
+
+static void oval_fts_walk_free(struct oval_fts_walk *walk)
+{
+	struct oval_fts_walk_dir *dir;
+	unsigned i;
+
+	pthread_mutex_lock(&walk->mutex);
+	walk->abort = true;
+	pthread_cond_broadcast(&walk->work_cond);
+	pthread_mutex_unlock(&walk->mutex);
+
+	for (i = 0; i < walk->running; ++i)
+		pthread_join(walk->thid[i], NULL);
+
+	/* the directories which weren't returned yet are owned by the current one and its ancestors */
+	while ((dir = walk->cur) != NULL) {
+		walk->cur = dir->parent;
+		oval_fts_walk_dir_free(dir);
+	}
+
+	if (walk->first != NULL)
+		OVAL_FTSENT_free(walk->first);
+
+	pthread_mutex_destroy(&walk->mutex);
+	pthread_cond_destroy(&walk->work_cond);
+	pthread_cond_destroy(&walk->done_cond);
+
+	free(walk->stack);
+	free(walk->thid);
+	free(walk);
+}
+
+static struct oval_fts_walk *oval_fts_walk_new(OVAL_FTS *ofts, const char *root)
+{
+	struct oval_fts_walk *walk;
+	struct oval_fts_walk_dir *dir;
+	struct stat st;
+	size_t rootlen = strlen(root);
+	unsigned i;
+
+	/* the root is followed if it's a symlink, like with FTS_COMFOLLOW */
+	if (stat(root, &st) != 0 || !S_ISDIR(st.st_mode))
+		return NULL;
+
+	walk = calloc(1, sizeof(struct oval_fts_walk));
+	if (walk == NULL)
+		return NULL;
+
+	walk->ofts = ofts;
+	walk->collect_dirs = (ofts->ofts_sfilename == NULL);
+	walk->shift = ofts->prefix ? strlen(ofts->prefix) : 0;
+
+	pthread_mutex_init(&walk->mutex, NULL);
+	pthread_cond_init(&walk->work_cond, NULL);
+	pthread_cond_init(&walk->done_cond, NULL);
+
+	walk->thid = calloc(ofts->ofts_walk_threads, sizeof(pthread_t));
+	if (walk->thid == NULL) {
+		oval_fts_walk_free(walk);
+		return NULL;
+	}
+
+	/* the fts root is collected, but it isn't subject to the depth and recurse limits */
+	if (walk->collect_dirs)
+		walk->first = OVAL_FTSENT_alloc(root + walk->shift, rootlen - walk->shift, NULL, 0, FTS_D);
+
+	if ((ofts->filesystem == OVAL_RECURSE_FS_LOCAL && !OVAL_FTS_localp(ofts, root, (void *)&st.st_dev))
+	    || (ofts->filesystem == OVAL_RECURSE_FS_DEFINED && ofts->ofts_recurse_path_devid != st.st_dev))
+		return (walk);
+
+	dir = oval_fts_walk_dir_new(NULL, 0, rootlen);
+	if (dir == NULL) {
+		oval_fts_walk_free(walk);
+		return NULL;
+	}
+
+	dir->pathlen = rootlen;
+	memcpy(dir->path, root, rootlen + 1);
+	dir->anc = oval_fts_walk_anc_new(NULL, st.st_dev, st.st_ino);
+	walk->cur = dir;
+
+	if (dir->anc == NULL) {
+		oval_fts_walk_free(walk);
+		return NULL;
+	}
+
+	oval_fts_walk_push(walk, dir);
+
+	for (i = 0; i < ofts->ofts_walk_threads; ++i) {
+		if (pthread_create(&walk->thid[i], NULL, oval_fts_walk_worker, walk) != 0) {
+			dW("Can't start the fts worker #%u: %d, %s.", i, errno, strerror(errno));
+			break;
+		}
+		++walk->running;
+	}
+
+	if (walk->running == 0) {
+		oval_fts_walk_free(walk);
+		return NULL;
+	}
+
+	return (walk);
+}
+
+/* find the next matching file or directory below the matched path */
+static OVAL_FTSENT *oval_fts_read_walk(OVAL_FTS *ofts)
+{
+	struct oval_fts_walk *walk = ofts->ofts_walk;
+	struct oval_fts_walk_dir *dir;
+	OVAL_FTSENT *ofts_ent = NULL;
+
+	pthread_mutex_lock(&walk->mutex);
+
+	if (walk->first != NULL) {
+		ofts_ent = walk->first;
+		walk->first = NULL;
+	}
+
+	/* return the items of the directories depth-first */
+	while (ofts_ent == NULL && (dir = walk->cur) != NULL) {
+		if (dir->state != OVAL_FTS_WALK_DONE) {
+			walk->wanted = dir;
+			pthread_cond_signal(&walk->work_cond);
+
+			while (dir->state != OVAL_FTS_WALK_DONE)
+				pthread_cond_wait(&walk->done_cond, &walk->mutex);
+
+			walk->wanted = NULL;
+		}
+
+		if (dir->next == dir->item_cnt) {
+			walk->cur = dir->parent;
+			oval_fts_walk_dir_free(dir);
+		} else if (dir->item[dir->next].ent != NULL) {
+			ofts_ent = dir->item[dir->next].ent;
+			dir->item[dir->next++].ent = NULL;
+
+			if (walk->ahead-- == OVAL_FTS_WALK_AHEAD)
+				pthread_cond_broadcast(&walk->work_cond);
+		} else {
+			walk->cur = dir->item[dir->next].subdir;
+			dir->item[dir->next++].subdir = NULL;
+		}
+	}
+
+	if (walk->error) {
+		walk->error = false;
+		if (ofts->result != NULL)
+			probe_cobj_set_flag(ofts->result, SYSCHAR_FLAG_ERROR);
+	}
+
+	pthread_mutex_unlock(&walk->mutex);
+
+	if (ofts_ent == NULL) {
+		oval_fts_walk_free(walk);
+		ofts->ofts_walk = NULL;
+	}
+
+	return (ofts_ent);
+}
+#endif /* OVAL_FTS_WALK */
+
 OVAL_FTS *oval_fts_open(SEXP_t *path, SEXP_t *filename, SEXP_t *filepath, SEXP_t *behaviors, SEXP_t* result)
 {
 	return oval_fts_open_prefixed(NULL, path, filename, filepath, behaviors, result);
@@ -685,7 +1306,7 @@ OVAL_FTS *oval_fts_open_prefixed(const char *prefix, SEXP_t *path, SEXP_t *filen
 
 	uint32_t path_op;
 	bool nilfilename = false;
-	pcre *regex = NULL;
+	oscap_pcre_t *regex = NULL;
 	struct stat st;
 
 	if ((path != NULL || filename != NULL || filepath == NULL)
@@ -845,6 +1466,7 @@ OVAL_FTS *oval_fts_open_prefixed(const char *prefix, SEXP_t *path, SEXP_t *filen
 			   errno, strerror(errno));
 		}
 		free((void *) paths[0]);
+		oscap_pcre_free(regex);
 		return NULL;
 	}
 
@@ -860,17 +1482,13 @@ OVAL_FTS *oval_fts_open_prefixed(const char *prefix, SEXP_t *path, SEXP_t *filen
 	if (ofts->ofts_match_path_fts == NULL || errno != 0) {
 		dE("fts_open() failed, errno: %d \"%s\".", errno, strerror(errno));
 		OVAL_FTS_free(ofts);
+		oscap_pcre_free(regex);
 		return (NULL);
 	}
 
 	ofts->ofts_recurse_path_fts_opts = rec_fts_options;
 	ofts->ofts_path_op = path_op;
-	if (regex != NULL) {
-		const char *errptr = NULL;
-
-		ofts->ofts_path_regex = regex;
-		ofts->ofts_path_regex_extra = pcre_study(regex, 0, &errptr);
-	}
+	ofts->ofts_path_regex = regex;
 
 	if (filesystem == OVAL_RECURSE_FS_LOCAL) {
 #if defined(OS_SOLARIS)
@@ -920,6 +1538,9 @@ OVAL_FTS *oval_fts_open_prefixed(const char *prefix, SEXP_t *path, SEXP_t *filen
 #endif
 
 	ofts->result = result;
+#if defined(OVAL_FTS_WALK)
+	ofts->ofts_walk_threads = oscap_env_worker_count("OSCAP_PROBE_FTS_WORKERS", OVAL_FTS_WALK_THREADS_MAX);
+#endif
 
 	return (ofts);
 }
@@ -995,16 +1616,16 @@ static FTSENT *oval_fts_read_match_path(OVAL_FTS *ofts)
 		if (ofts->ofts_path_regex != NULL && fts_ent->fts_info == FTS_D) {
 			int ret, svec[3];
 
-			ret = pcre_exec(ofts->ofts_path_regex, ofts->ofts_path_regex_extra,
-					fts_ent->fts_path+shift, fts_ent->fts_pathlen-shift, 0, PCRE_PARTIAL,
+			ret = oscap_pcre_exec(ofts->ofts_path_regex,
+					fts_ent->fts_path+shift, fts_ent->fts_pathlen-shift, 0, OSCAP_PCRE_OPTS_PARTIAL,
 					svec, sizeof(svec) / sizeof(svec[0]));
 			if (ret < 0) {
 				switch (ret) {
-				case PCRE_ERROR_NOMATCH:
+				case OSCAP_PCRE_ERR_NOMATCH:
 					dD("Partial match optimization: PCRE_ERROR_NOMATCH, skipping.");
 					fts_set(ofts->ofts_match_path_fts, fts_ent, FTS_SKIP);
 					continue;
-				case PCRE_ERROR_PARTIAL:
+				case OSCAP_PCRE_ERR_PARTIAL:
 					dD("Partial match optimization: PCRE_ERROR_PARTIAL, continuing.");
 					continue;
 				default:
@@ -1355,6 +1976,28 @@ OVAL_FTSENT *oval_fts_read(OVAL_FTS *ofts)
 			}
 			break;
 		} else {
+#if defined(OVAL_FTS_WALK)
+			if (ofts->direction == OVAL_RECURSE_DIRECTION_DOWN
+			    && (ofts->recurse & OVAL_RECURSE_DIRS)
+			    && ofts->ofts_walk_threads > 0) {
+				if (ofts->ofts_walk == NULL)
+					ofts->ofts_walk = oval_fts_walk_new(ofts, ofts->ofts_match_path_fts_ent->fts_path);
+
+				if (ofts->ofts_walk != NULL) {
+					OVAL_FTSENT *ofts_ent = oval_fts_read_walk(ofts);
+
+					if (ofts_ent != NULL)
+						return (ofts_ent);
+
+					ofts->ofts_match_path_fts_ent = NULL;
+
+					if (ofts->ofts_path_op == OVAL_OPERATION_EQUALS)
+						return (NULL);
+					continue;
+				}
+				/* fall back to fts, it handles the errors of the root too */
+			}
+#endif
 			fts_ent = oval_fts_read_recurse_path(ofts);
 			if (fts_ent != NULL)
 				break;
@@ -1378,13 +2021,15 @@ void oval_ftsent_free(OVAL_FTSENT *ofts_ent)
 
 int oval_fts_close(OVAL_FTS *ofts)
 {
+#if defined(OVAL_FTS_WALK)
+	if (ofts->ofts_walk != NULL)
+		oval_fts_walk_free(ofts->ofts_walk);
+#endif
 	if (ofts->ofts_recurse_path_pthcpy != NULL)
 		free(ofts->ofts_recurse_path_pthcpy);
 
 	if (ofts->ofts_path_regex)
-		pcre_free(ofts->ofts_path_regex);
-	if (ofts->ofts_path_regex_extra)
-		pcre_free(ofts->ofts_path_regex_extra);
+		oscap_pcre_free(ofts->ofts_path_regex);
 
 	if (ofts->ofts_spath != NULL)
 		SEXP_free(ofts->ofts_spath);
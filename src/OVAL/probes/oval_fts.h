@@ -30,7 +30,7 @@
 #else
 #include <fts.h>
 #endif
-#include <pcre.h>
+#include "common/oscap_pcre.h"
 #include "fsdev.h"
 
 #define ENT_GET_AREF(ent, dst, attr_name, mandatory)			\
@@ -78,8 +78,7 @@ typedef struct {
 	char *ofts_recurse_path_curpth;
 	dev_t ofts_recurse_path_devid;
 
-	pcre       *ofts_path_regex;
-	pcre_extra *ofts_path_regex_extra;
+	oscap_pcre_t *ofts_path_regex;
 	uint32_t ofts_path_op;
 
 	SEXP_t *ofts_spath;
@@ -95,6 +94,10 @@ typedef struct {
 
 	fsdev_t *localdevs;
 	const char *prefix;
+
+	/* parallel oval_fts_read_walk() state */
+	struct oval_fts_walk *ofts_walk;
+	unsigned ofts_walk_threads;
 } OVAL_FTS;
 
 #define OVAL_RECURSE_DIRECTION_NONE 0 /* default */
@@ -0,0 +1,376 @@
+/*
+ * Copyright 2026 Red Hat Inc., Durham, North Carolina.
+ * All Rights Reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "oval_fts_cache.h"
+
+#if defined(OS_LINUX)
+#include <dirent.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#include "list.h"
+#include "debug_priv.h"
+
+/*
+ * Objects of the file based probes often traverse the same trees, e.g.
+ * /etc or /usr/lib. The listings of the traversed directories, including
+ * the types of the entries, are kept here so every directory is read and
+ * every entry is stat-ed once per scan. The cache is dropped when a probe
+ * session starts or is reset.
+ *
+ * Fixes applied by --remediate (or other processes) may change the
+ * directories during a scan. The device and inode numbers and the
+ * modification and change times of a directory are stored with its
+ * listing and the listing is read again when they no longer match.
+ *
+ * The size of the cache is limited by OSCAP_PROBE_FTS_CACHE_SIZE (MiB),
+ * 0 disables the cache. Directories which don't fit are read again each
+ * time they're traversed.
+ */
+
+#define OVAL_FTS_CACHE_SIZE_DEFAULT 64
+#define OVAL_FTS_CACHE_HSIZE        4093
+#define OVAL_FTS_CACHE_DENTS_SIZE   (32 * 1024)
+
+struct oval_fts_cache_dirent64 {
+	uint64_t       d_ino;
+	int64_t        d_off;
+	unsigned short d_reclen;
+	unsigned char  d_type;
+	char           d_name[];
+};
+
+static pthread_mutex_t oval_fts_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+static struct oscap_htable *oval_fts_cache = NULL; /* path -> struct oval_fts_cache_dir */
+static size_t oval_fts_cache_size = 0;
+static size_t oval_fts_cache_limit = 0;
+static unsigned long oval_fts_cache_hits = 0;
+static unsigned long oval_fts_cache_misses = 0;
+
+static pthread_once_t oval_fts_cache_init_once = PTHREAD_ONCE_INIT;
+
+static void oval_fts_cache_init(void)
+{
+	const char *size_str = getenv("OSCAP_PROBE_FTS_CACHE_SIZE");
+	long size = OVAL_FTS_CACHE_SIZE_DEFAULT;
+
+	if (size_str != NULL) {
+		char *endptr;
+
+		size = strtol(size_str, &endptr, 10);
+		if (*size_str == '\0' || *endptr != '\0' || size < 0) {
+			dW("Invalid value of OSCAP_PROBE_FTS_CACHE_SIZE: '%s'", size_str);
+			size = OVAL_FTS_CACHE_SIZE_DEFAULT;
+		}
+	}
+
+	oval_fts_cache_limit = (size_t)size * 1024 * 1024;
+}
+
+static unsigned char oval_fts_cache_mode2type(mode_t mode)
+{
+	if (S_ISDIR(mode))
+		return DT_DIR;
+	if (S_ISLNK(mode))
+		return DT_LNK;
+	if (S_ISREG(mode))
+		return DT_REG;
+	if (S_ISCHR(mode))
+		return DT_CHR;
+	if (S_ISBLK(mode))
+		return DT_BLK;
+	if (S_ISFIFO(mode))
+		return DT_FIFO;
+	if (S_ISSOCK(mode))
+		return DT_SOCK;
+
+	return DT_UNKNOWN;
+}
+
+/* directory entries collected by oval_fts_cache_read() */
+struct oval_fts_cache_buf {
+	struct oval_fts_cache_ent *ent;
+	size_t count;
+	size_t alloc;
+	char  *names;
+	size_t names_len;
+	size_t names_alloc;
+};
+
+static struct oval_fts_cache_ent *oval_fts_cache_buf_add(struct oval_fts_cache_buf *buf, const char *name)
+{
+	size_t namelen = strlen(name);
+	struct oval_fts_cache_ent *ent;
+
+	if (buf->count == buf->alloc) {
+		size_t alloc = buf->alloc > 0 ? buf->alloc * 2 : 64;
+		void *tmp = realloc(buf->ent, sizeof(struct oval_fts_cache_ent) * alloc);
+
+		if (tmp == NULL)
+			return NULL;
+
+		buf->ent = tmp;
+		buf->alloc = alloc;
+	}
+
+	if (buf->names_len + namelen + 1 > buf->names_alloc) {
+		size_t alloc = buf->names_alloc > 0 ? buf->names_alloc * 2 : 1024;
+		void *tmp;
+
+		while (alloc < buf->names_len + namelen + 1)
+			alloc *= 2;
+
+		tmp = realloc(buf->names, alloc);
+		if (tmp == NULL)
+			return NULL;
+
+		buf->names = tmp;
+		buf->names_alloc = alloc;
+	}
+
+	ent = &buf->ent[buf->count++];
+	memset(ent, 0, sizeof(struct oval_fts_cache_ent));
+	/* the names are relocated by oval_fts_cache_buf_finish(), keep the offset for now */
+	ent->name = (const char *)(uintptr_t)buf->names_len;
+	ent->namelen = namelen;
+
+	memcpy(buf->names + buf->names_len, name, namelen + 1);
+	buf->names_len += namelen + 1;
+
+	return (ent);
+}
+
+/* put the listing into a single allocation */
+static struct oval_fts_cache_dir *oval_fts_cache_buf_finish(struct oval_fts_cache_buf *buf, bool unreadable, const struct stat *st)
+{
+	size_t ent_size = sizeof(struct oval_fts_cache_ent) * buf->count;
+	size_t size = sizeof(struct oval_fts_cache_dir) + ent_size + buf->names_len;
+	struct oval_fts_cache_dir *dir = malloc(size);
+	char *names;
+	size_t i;
+
+	if (dir == NULL)
+		return NULL;
+
+	dir->refs = 1;
+	dir->unreadable = unreadable;
+	dir->dev = st->st_dev;
+	dir->ino = st->st_ino;
+	dir->mtim = st->st_mtim;
+	dir->ctim = st->st_ctim;
+	dir->size = size;
+	dir->count = buf->count;
+
+	names = (char *)dir->ent + ent_size;
+	if (buf->names_len > 0)
+		memcpy(names, buf->names, buf->names_len);
+
+	for (i = 0; i < buf->count; ++i) {
+		dir->ent[i] = buf->ent[i];
+		dir->ent[i].name = names + (uintptr_t)buf->ent[i].name;
+	}
+
+	return (dir);
+}
+
+/* identity of the directory at path, all zeroes if it can't be stat-ed */
+static void oval_fts_cache_stat(const char *path, int fd, struct stat *st)
+{
+	if ((fd >= 0 ? fstat(fd, st) : stat(path, st)) != 0)
+		memset(st, 0, sizeof(struct stat));
+}
+
+static bool oval_fts_cache_valid(const struct oval_fts_cache_dir *dir, const char *path)
+{
+	struct stat st;
+
+	oval_fts_cache_stat(path, -1, &st);
+
+	return (dir->dev == st.st_dev && dir->ino == st.st_ino
+	        && dir->mtim.tv_sec == st.st_mtim.tv_sec && dir->mtim.tv_nsec == st.st_mtim.tv_nsec
+	        && dir->ctim.tv_sec == st.st_ctim.tv_sec && dir->ctim.tv_nsec == st.st_ctim.tv_nsec);
+}
+
+static struct oval_fts_cache_dir *oval_fts_cache_read(const char *path)
+{
+	struct oval_fts_cache_buf buf;
+	struct oval_fts_cache_dir *dir = NULL;
+	char dents[OVAL_FTS_CACHE_DENTS_SIZE];
+	long dents_len, pos;
+	struct stat dst;
+	int fd;
+
+	memset(&buf, 0, sizeof buf);
+
+	fd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	/* stat-ed before reading so the changes made meanwhile invalidate the listing */
+	oval_fts_cache_stat(path, fd, &dst);
+	if (fd < 0)
+		return oval_fts_cache_buf_finish(&buf, true, &dst);
+
+	while ((dents_len = syscall(SYS_getdents64, fd, dents, sizeof dents)) > 0) {
+		for (pos = 0; pos < dents_len; ) {
+			struct oval_fts_cache_dirent64 *d = (struct oval_fts_cache_dirent64 *)(dents + pos);
+			struct oval_fts_cache_ent *ent;
+			struct stat st;
+
+			pos += d->d_reclen;
+
+			if (d->d_name[0] == '.' && (d->d_name[1] == '\0'
+			    || (d->d_name[1] == '.' && d->d_name[2] == '\0')))
+				continue;
+
+			ent = oval_fts_cache_buf_add(&buf, d->d_name);
+			if (ent == NULL)
+				goto cleanup;
+
+			ent->type = d->d_type;
+
+			/* directories are stat-ed for the device and inode numbers */
+			if (d->d_type == DT_UNKNOWN || d->d_type == DT_DIR) {
+				if (fstatat(fd, d->d_name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+					ent->type = DT_UNKNOWN;
+					continue;
+				}
+
+				ent->type = oval_fts_cache_mode2type(st.st_mode);
+				ent->dev = st.st_dev;
+				ent->ino = st.st_ino;
+			}
+
+			if (ent->type == DT_LNK) {
+				if (fstatat(fd, d->d_name, &st, 0) != 0) {
+					ent->ltype = DT_UNKNOWN;
+					continue;
+				}
+
+				ent->ltype = oval_fts_cache_mode2type(st.st_mode);
+				ent->dev = st.st_dev;
+				ent->ino = st.st_ino;
+			}
+		}
+	}
+
+	dir = oval_fts_cache_buf_finish(&buf, false, &dst);
+cleanup:
+	close(fd);
+	free(buf.ent);
+	free(buf.names);
+
+	return (dir);
+}
+
+void oval_fts_cache_release(struct oval_fts_cache_dir *dir)
+{
+	if (dir != NULL && __sync_sub_and_fetch(&dir->refs, 1) == 0)
+		free(dir);
+}
+
+static void oval_fts_cache_release_cb(void *dir)
+{
+	oval_fts_cache_release(dir);
+}
+
+struct oval_fts_cache_dir *oval_fts_cache_get(const char *path)
+{
+	struct oval_fts_cache_dir *dir;
+
+	pthread_once(&oval_fts_cache_init_once, oval_fts_cache_init);
+
+	if (oval_fts_cache_limit == 0)
+		return oval_fts_cache_read(path);
+
+	pthread_mutex_lock(&oval_fts_cache_mutex);
+	dir = oval_fts_cache != NULL ? oscap_htable_get(oval_fts_cache, path) : NULL;
+	if (dir != NULL)
+		__sync_fetch_and_add(&dir->refs, 1);
+	pthread_mutex_unlock(&oval_fts_cache_mutex);
+
+	if (dir != NULL) {
+		if (oval_fts_cache_valid(dir, path)) {
+			__sync_fetch_and_add(&oval_fts_cache_hits, 1);
+			return (dir);
+		}
+
+		/* the directory changed, drop the stale listing unless another thread did */
+		pthread_mutex_lock(&oval_fts_cache_mutex);
+		if (oval_fts_cache != NULL && oscap_htable_get(oval_fts_cache, path) == dir) {
+			oscap_htable_detach(oval_fts_cache, path);
+			oval_fts_cache_size -= dir->size;
+			oval_fts_cache_release(dir);
+		}
+		pthread_mutex_unlock(&oval_fts_cache_mutex);
+		oval_fts_cache_release(dir);
+	}
+
+	__sync_fetch_and_add(&oval_fts_cache_misses, 1);
+
+	dir = oval_fts_cache_read(path);
+	if (dir == NULL)
+		return NULL;
+
+	pthread_mutex_lock(&oval_fts_cache_mutex);
+	if (oval_fts_cache == NULL)
+		oval_fts_cache = oscap_htable_new1((oscap_compare_func)strcmp, OVAL_FTS_CACHE_HSIZE);
+	/* the listing isn't cached if another thread was faster or the cache is full */
+	if (oval_fts_cache != NULL && oval_fts_cache_size + dir->size <= oval_fts_cache_limit
+	    && oscap_htable_add(oval_fts_cache, path, dir)) {
+		__sync_fetch_and_add(&dir->refs, 1);
+		oval_fts_cache_size += dir->size;
+	}
+	pthread_mutex_unlock(&oval_fts_cache_mutex);
+
+	return (dir);
+}
+
+void oval_fts_cache_reset(void)
+{
+	struct oscap_htable *cache;
+
+	pthread_mutex_lock(&oval_fts_cache_mutex);
+	cache = oval_fts_cache;
+	if (cache != NULL) {
+		dD("fts cache: %zu directories, %zu bytes, %lu hits, %lu misses",
+		   oscap_htable_itemcount(cache), oval_fts_cache_size,
+		   oval_fts_cache_hits, oval_fts_cache_misses);
+	}
+	oval_fts_cache = NULL;
+	oval_fts_cache_size = 0;
+	oval_fts_cache_hits = 0;
+	oval_fts_cache_misses = 0;
+	pthread_mutex_unlock(&oval_fts_cache_mutex);
+
+	/* the listings which are being traversed are freed once released */
+	oscap_htable_free(cache, oval_fts_cache_release_cb);
+}
+#else
+void oval_fts_cache_reset(void)
+{
+	return;
+}
+#endif /* OS_LINUX */
@@ -0,0 +1,85 @@
+/**
+ * @file   oval_fts_cache.h
+ * @brief  directory cache shared by the oval_fts traversals of one scan
+ */
+/*
+ * Copyright 2026 Red Hat Inc., Durham, North Carolina.
+ * All Rights Reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#pragma once
+#ifndef OVAL_FTS_CACHE_H
+#define OVAL_FTS_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <time.h>
+
+/**
+ * Directory entry. The type fields hold DT_* values, DT_UNKNOWN means
+ * that the entry (or the target of a symlink) couldn't be stat-ed.
+ */
+struct oval_fts_cache_ent {
+	const char   *name;
+	size_t        namelen;
+	unsigned char type;  /**< type of the entry itself */
+	unsigned char ltype; /**< type of the symlink target, symlinks only */
+	dev_t         dev;   /**< directories and symlinks to directories */
+	ino_t         ino;
+};
+
+/**
+ * Listing of one directory. The listing is immutable once it's returned
+ * by oval_fts_cache_get() and stays valid until it's released.
+ */
+struct oval_fts_cache_dir {
+	uint32_t refs;
+	bool     unreadable; /**< the directory couldn't be opened */
+	dev_t    dev;        /**< identity of the directory when it was read, */
+	ino_t    ino;        /**< all zeroes if it couldn't be stat-ed */
+	struct timespec mtim;
+	struct timespec ctim;
+	size_t   size;       /**< allocated bytes */
+	size_t   count;
+	struct oval_fts_cache_ent ent[];
+};
+
+#if defined(OS_LINUX)
+/**
+ * Get the listing of the directory at path. The listing is read from the
+ * cache, or from the filesystem and then stored in the cache. Cached
+ * listings of directories which were replaced or modified since they
+ * were read are read again.
+ * @return reference which has to be released, NULL on memory errors
+ */
+struct oval_fts_cache_dir *oval_fts_cache_get(const char *path);
+
+/**
+ * Release a listing returned by oval_fts_cache_get().
+ */
+void oval_fts_cache_release(struct oval_fts_cache_dir *dir);
+#endif
+
+/**
+ * Drop all cached listings. Called whenever a probe session starts or
+ * is reset, so the listings never outlive one scan.
+ */
+void oval_fts_cache_reset(void);
+
+#endif /* OVAL_FTS_CACHE_H */
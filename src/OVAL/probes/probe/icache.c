@@ -30,6 +30,8 @@
 #include <string.h>
 #include <inttypes.h>
 #include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
 
 #if defined(OS_FREEBSD)
 #include <pthread_np.h>
@@ -108,7 +110,7 @@ static int icache_lookup(rbt_t *tree, int64_t item_id, probe_iqpair_t *pair) {
 	register uint16_t i;
 	for (i = 0; i < cached->count; ++i) {
 		SEXP_t rest1;
-		SEXP_t* rest_r1 = SEXP_list_rest_r(&rest1, pair->p.item);
+		SEXP_t* rest_r1 = SEXP_list_rest_r(&rest1, pair->item);
 
 		SEXP_t rest2;
 		SEXP_t* rest_r2 = SEXP_list_rest_r(&rest2, cached->item[i]);
@@ -136,17 +138,17 @@ static int icache_lookup(rbt_t *tree, int64_t item_id, probe_iqpair_t *pair) {
 		}
 		cached->count++;
 		cached->item = new_item;
-		cached->item[cached->count - 1] = pair->p.item;
+		cached->item[cached->count - 1] = pair->item;
 
 		/* Assign an unique item ID */
-		probe_icache_item_setID(pair->p.item, item_id);
+		probe_icache_item_setID(pair->item, item_id);
 	} else {
 		/*
 		* Cache HIT
 		*/
 		dD("cache HIT #2 -> real HIT");
-		SEXP_free(pair->p.item);
-		pair->p.item = cached->item[i];
+		SEXP_free(pair->item);
+		pair->item = cached->item[i];
 	}
 	return 0;
 }
@@ -155,11 +157,11 @@ static void icache_add_to_tree(rbt_t *tree, int64_t item_id, probe_iqpair_t *pai
 
 	probe_citem_t *cached = malloc(sizeof(probe_citem_t));
 	cached->item = malloc(sizeof(SEXP_t *));
-	cached->item[0] = pair->p.item;
+	cached->item[0] = pair->item;
 	cached->count = 1;
 
 	/* Assign an unique item ID */
-	probe_icache_item_setID(pair->p.item, item_id);
+	probe_icache_item_setID(pair->item, item_id);
 
 	if (rbt_i64_add(tree, (int64_t)item_id, (void **)cached, NULL) != 0) {
 		dE("Can't add item (k=%"PRIi64" to the cache (%p)", item_id, tree);
@@ -172,11 +174,84 @@ static void icache_add_to_tree(rbt_t *tree, int64_t item_id, probe_iqpair_t *pai
 	}
 }
 
+/*
+ * Deduplicate the item in the tree shard selected by the item ID. Only
+ * items with the same ID can be equal, so the shards are independent.
+ */
+static void probe_icache_dedup(probe_icache_t *cache, probe_iqpair_t *pair)
+{
+        SEXP_ID_t       item_ID;
+        probe_ishard_t *shard;
+        SEXP_t         *item = pair->item;
+
+        item_ID = SEXP_ID_v(pair->item);
+        dD("item ID=%"PRIu64"", item_ID);
+
+        shard = &cache->shard[item_ID & (PROBE_ICACHE_SHARDS - 1)];
+
+        if (pthread_mutex_lock(&shard->mutex) != 0) {
+                dE("An error ocured while locking the shard mutex: %u, %s",
+                   errno, strerror(errno));
+                abort();
+        }
+
+        if (icache_lookup(shard->tree, item_ID, pair) != 0) {
+                /*
+                 * Cache MISS
+                 */
+                dD("cache MISS");
+                icache_add_to_tree(shard->tree, item_ID, pair);
+        }
+
+        if (pthread_mutex_unlock(&shard->mutex) != 0) {
+                dE("An error ocured while unlocking the shard mutex: %u, %s",
+                   errno, strerror(errno));
+                abort();
+        }
+
+        /* a duplicate is replaced by the cached item */
+        if (pair->count != NULL && pair->item == item) {
+                __sync_fetch_and_add(&pair->count->items, 1);
+                __sync_fetch_and_add(&pair->count->bytes, SEXP_sizeof(item));
+        }
+}
+
+/*
+ * Add the deduplicated item to its collected object once all the items
+ * queued before it were added, so that the item order doesn't depend on
+ * the number of workers.
+ */
+static void probe_icache_commit(probe_icache_t *cache, probe_iqpair_t *pair)
+{
+        if (pthread_mutex_lock(&cache->commit_mutex) != 0) {
+                dE("An error ocured while locking the commit mutex: %u, %s",
+                   errno, strerror(errno));
+                abort();
+        }
+
+        while (cache->commit_seq != pair->seq && !cache->shutdown)
+                pthread_cond_wait(&cache->commit_cond, &cache->commit_mutex);
+
+        if (!cache->shutdown) {
+                if (probe_cobj_add_item(pair->cobj, pair->item) != 0) {
+                        dW("An error ocured while adding the item to the collected object");
+                }
+
+                ++cache->commit_seq;
+                pthread_cond_broadcast(&cache->commit_cond);
+        }
+
+        if (pthread_mutex_unlock(&cache->commit_mutex) != 0) {
+                dE("An error ocured while unlocking the commit mutex: %u, %s",
+                   errno, strerror(errno));
+                abort();
+        }
+}
+
 static void *probe_icache_worker(void *arg)
 {
         probe_icache_t *cache = (probe_icache_t *)(arg);
-        probe_iqpair_t *pair, pair_mem;
-        SEXP_ID_t       item_ID;
+        probe_iqpair_t  pair;
 
 	if (cache == NULL) {
 		return NULL;
@@ -191,37 +266,45 @@ const char* thread_name = "icache_worker";
 # endif
 #endif
 
-        if (pthread_mutex_lock(&cache->queue_mutex) != 0) {
-                dE("An error ocured while locking the queue mutex: %u, %s",
-                   errno, strerror(errno));
-                return (NULL);
+        dD("icache worker ready");
+
+        /*
+         * The barrier counts the icache as one thread, let the first
+         * worker which gets here stand for all of them.
+         */
+        if (__sync_fetch_and_add(&cache->thready, 1) == 0) {
+                switch (errno = pthread_barrier_wait(&OSCAP_GSYM(th_barrier)))
+                {
+                case 0:
+                case PTHREAD_BARRIER_SERIAL_THREAD:
+                        break;
+                default:
+                        dE("pthread_barrier_wait: %d, %s.",
+                           errno, strerror(errno));
+                        return (NULL);
+                }
         }
 
-	pair = &pair_mem;
-        dD("icache worker ready");
+        for (;;) {
+                if (pthread_mutex_lock(&cache->queue_mutex) != 0) {
+                        dE("An error ocured while locking the queue mutex: %u, %s",
+                           errno, strerror(errno));
+                        abort();
+                }
+
+                while (cache->queue_cnt == 0 && !cache->shutdown)
+                        pthread_cond_wait(&cache->queue_notempty, &cache->queue_mutex);
+
+                if (cache->shutdown) {
+                        pthread_mutex_unlock(&cache->queue_mutex);
+                        break;
+                }
 
-        switch (errno = pthread_barrier_wait(&OSCAP_GSYM(th_barrier)))
-        {
-        case 0:
-        case PTHREAD_BARRIER_SERIAL_THREAD:
-	        break;
-        default:
-	        dE("pthread_barrier_wait: %d, %s.",
-	           errno, strerror(errno));
-	        pthread_mutex_unlock(&cache->queue_mutex);
-	        return (NULL);
-        }
-
-        while(pthread_cond_wait(&cache->queue_notempty, &cache->queue_mutex) == 0) {
-			if (cache->queue_cnt <= 0) {
-				return NULL;
-			}
-        do {
                 dD("Extracting item from the cache queue: cnt=%"PRIu16", beg=%"PRIu16"", cache->queue_cnt, cache->queue_beg);
                 /*
-                 * Extract an item from the queue and update queue beg, end & cnt
+                 * Extract an item from the queue and update queue beg & cnt
                  */
-                pair_mem = cache->queue[cache->queue_beg];
+                pair = cache->queue[cache->queue_beg];
 #ifndef NDEBUG
 		memset(cache->queue + cache->queue_beg, 0, sizeof(probe_iqpair_t));
 #endif
@@ -231,13 +314,6 @@ const char* thread_name = "icache_worker";
 		if (cache->queue_beg == cache->queue_max)
 			cache->queue_beg = 0;
 
-		if (cache->queue_cnt == 0 ?
-			cache->queue_end != cache->queue_beg :
-			cache->queue_end == cache->queue_beg) {
-			return NULL;
-		}
-
-
                 dD("Signaling `notfull'");
 
                 if (pthread_cond_signal(&cache->queue_notfull) != 0) {
@@ -245,81 +321,50 @@ const char* thread_name = "icache_worker";
                            errno, strerror(errno));
                         abort();
                 }
-                /*
-                 * Release the mutex
-                 */
+
                 if (pthread_mutex_unlock(&cache->queue_mutex) != 0) {
                         dE("An error ocured while unlocking the queue mutex: %u, %s",
                            errno, strerror(errno));
                         abort();
                 }
 
-                if (pair->cobj == NULL) {
-                        /*
-                         * Handle NOP case (synchronization)
-                         */
-					if (pair->p.cond == NULL) {
-						return NULL;
-					}
-
-                        dD("Handling NOP");
-
-                        if (pthread_cond_signal(pair->p.cond) != 0) {
-                                dE("An error ocured while signaling NOP condition: %u, %s",
-                                   errno, strerror(errno));
-                                abort();
-                        }
-                } else {
-
-                        dD("Handling cache request");
-
-                        /*
-                         * Compute item ID
-                         */
-			dD("pair address: %"PRIu64, (uint64_t) pair);
-			dD("item address: %"PRIu64, (uint64_t) pair->p.item);
-                        item_ID = SEXP_ID_v(pair->p.item);
-                        dD("item ID=%"PRIu64"", item_ID);
-
-                        if (icache_lookup(cache->tree, item_ID, pair) != 0) {
-                                /*
-                                 * Cache MISS
-                                 */
-                                dD("cache MISS");
-                                icache_add_to_tree(cache->tree, item_ID, pair);
-                        }
-
-                        if (probe_cobj_add_item(pair->cobj, pair->p.item) != 0) {
-                            dW("An error ocured while adding the item to the collected object");
-                        }
-                }
-
-                if (pthread_mutex_lock(&cache->queue_mutex) != 0) {
-                        dE("An error ocured while re-locking the queue mutex: %u, %s",
-                           errno, strerror(errno));
-                        abort();
-                }
+                dD("Handling cache request");
 
-                } while (cache->queue_cnt > 0);
+                probe_icache_dedup(cache, &pair);
+                probe_icache_commit(cache, &pair);
         }
 
         return (NULL);
 }
 
-probe_icache_t *probe_icache_new(void)
+probe_icache_t *probe_icache_new(unsigned thcnt)
 {
+        unsigned i;
         probe_icache_t *cache = malloc(sizeof(probe_icache_t));
-        cache->tree = rbt_i64_new();
 
-        if (pthread_mutex_init(&cache->queue_mutex, NULL) != 0) {
-                dE("Can't initialize icache mutex: %u, %s", errno, strerror(errno));
-                goto fail;
+        if (cache == NULL)
+                return (NULL);
+
+        for (i = 0; i < PROBE_ICACHE_SHARDS; ++i) {
+                pthread_mutex_init(&cache->shard[i].mutex, NULL);
+                cache->shard[i].tree = rbt_i64_new();
         }
 
+        cache->shutdown = false;
+        cache->thready  = 0;
+        cache->thcnt    = 0;
+
         cache->queue_beg = 0;
         cache->queue_end = 0;
         cache->queue_cnt = 0;
         cache->queue_max = PROBE_IQUEUE_CAPACITY;
+        cache->queue_seq = 0;
+        cache->commit_seq = 0;
+
+        if (pthread_mutex_init(&cache->queue_mutex, NULL) != 0) {
+                dE("Can't initialize icache mutex: %u, %s", errno, strerror(errno));
+                goto fail;
+        }
 
         if (pthread_cond_init(&cache->queue_notempty, NULL) != 0) {
                 dE("Can't initialize icache queue condition variable (notempty): %u, %s",
@@ -333,17 +378,42 @@ probe_icache_t *probe_icache_new(void)
                 goto fail;
         }
 
-        if (pthread_create(&cache->thid, NULL,
-                           probe_icache_worker, (void *)cache) != 0)
-        {
-                dE("Can't start the icache worker: %u, %s", errno, strerror(errno));
+        if (pthread_mutex_init(&cache->commit_mutex, NULL) != 0 ||
+            pthread_cond_init(&cache->commit_cond, NULL) != 0) {
+                dE("Can't initialize icache commit mutex/condition: %u, %s",
+                   errno, strerror(errno));
                 goto fail;
         }
 
+        cache->thid = malloc(sizeof(pthread_t) * (thcnt > 0 ? thcnt : 1));
+
+        if (cache->thid == NULL)
+                goto fail;
+
+        for (i = 0; i < thcnt; ++i) {
+                if (pthread_create(&cache->thid[i], NULL,
+                                   probe_icache_worker, (void *)cache) != 0)
+                {
+                        dE("Can't start the icache worker #%u: %u, %s", i, errno, strerror(errno));
+                        break;
+                }
+                ++cache->thcnt;
+        }
+
+        if (cache->thcnt == 0 && thcnt > 0) {
+                free(cache->thid);
+                goto fail;
+        }
+
+        dD("icache started with %u worker(s)", cache->thcnt);
+
         return (cache);
 fail:
-        if (cache->tree != NULL)
-                rbt_i64_free(cache->tree);
+        for (i = 0; i < PROBE_ICACHE_SHARDS; ++i) {
+                if (cache->shard[i].tree != NULL)
+                        rbt_i64_free(cache->shard[i].tree);
+                pthread_mutex_destroy(&cache->shard[i].mutex);
+        }
 
         pthread_mutex_destroy(&cache->queue_mutex);
         pthread_cond_destroy(&cache->queue_notempty);
@@ -352,49 +422,34 @@ fail:
         return (NULL);
 }
 
-static int __probe_icache_add_nolock(probe_icache_t *cache, SEXP_t *cobj, SEXP_t *item, pthread_cond_t *cond)
+static int __probe_icache_add_nolock(probe_icache_t *cache, SEXP_t *cobj, SEXP_t *item, probe_icount_t *count)
 {
-	if (!((cond == NULL) ^ (item == NULL))) {
-		return -1;
-	}
-retry:
-        if (cache->queue_cnt < cache->queue_max) {
-                cache->queue[cache->queue_end].cobj = cobj;
-
-                if (item != NULL) {
-					if (cobj == NULL) {
-						return -1;
-					}
-                        cache->queue[cache->queue_end].p.item = item;
-                } else {
-					if (item != NULL || cobj != NULL) {
-						return -1;
-					}
-                        cache->queue[cache->queue_end].p.cond = cond;
-		}
-
-                ++cache->queue_cnt;
-		++cache->queue_end;
-
-                if (cache->queue_end == cache->queue_max)
-                        cache->queue_end = 0;
-        } else {
+        while (cache->queue_cnt >= cache->queue_max) {
                 /*
                  * The queue is full, we have to wait
                  */
-                if (pthread_cond_wait(&cache->queue_notfull, &cache->queue_mutex) == 0)
-                        goto retry;
-                else {
+                if (pthread_cond_wait(&cache->queue_notfull, &cache->queue_mutex) != 0) {
                         dE("An error ocured while waiting for the `notfull' queue condition: %u, %s",
                            errno, strerror(errno));
                         return (-1);
                 }
         }
 
+        cache->queue[cache->queue_end].cobj = cobj;
+        cache->queue[cache->queue_end].item = item;
+        cache->queue[cache->queue_end].count = count;
+        cache->queue[cache->queue_end].seq  = cache->queue_seq++;
+
+        ++cache->queue_cnt;
+        ++cache->queue_end;
+
+        if (cache->queue_end == cache->queue_max)
+                cache->queue_end = 0;
+
         return (0);
 }
 
-int probe_icache_add(probe_icache_t *cache, SEXP_t *cobj, SEXP_t *item)
+int probe_icache_add(probe_icache_t *cache, SEXP_t *cobj, SEXP_t *item, probe_icount_t *count)
 {
         int ret;
 
@@ -407,7 +462,31 @@ int probe_icache_add(probe_icache_t *cache, SEXP_t *cobj, SEXP_t *item)
                 return (-1);
         }
 
-        ret = __probe_icache_add_nolock(cache, cobj, item, NULL);
+        if (cache->thcnt == 0) {
+                /*
+                 * No workers, handle the item right away. The commit
+                 * still keeps the order of items added by more threads.
+                 */
+                probe_iqpair_t pair;
+
+                pair.cobj  = cobj;
+                pair.item  = item;
+                pair.count = count;
+                pair.seq   = cache->queue_seq++;
+
+                if (pthread_mutex_unlock(&cache->queue_mutex) != 0) {
+                        dE("An error ocured while unlocking the queue mutex: %u, %s",
+                           errno, strerror(errno));
+                        abort();
+                }
+
+                probe_icache_dedup(cache, &pair);
+                probe_icache_commit(cache, &pair);
+
+                return (0);
+        }
+
+        ret = __probe_icache_add_nolock(cache, cobj, item, count);
 
         if (pthread_cond_signal(&cache->queue_notempty) != 0) {
                 dE("An error ocured while signaling the `notempty' condition: %u, %s",
@@ -429,7 +508,7 @@ int probe_icache_add(probe_icache_t *cache, SEXP_t *cobj, SEXP_t *item)
 
 int probe_icache_nop(probe_icache_t *cache)
 {
-        pthread_cond_t cond;
+        uint64_t seq;
 
         dD("NOP");
 
@@ -439,55 +518,46 @@ int probe_icache_nop(probe_icache_t *cache)
                 return (-1);
         }
 
-        if (pthread_cond_init(&cond, NULL) != 0) {
-                dE("Can't initialize icache queue condition variable (NOP): %u, %s",
-                   errno, strerror(errno));
-                return (-1);
-        }
-
-        if (__probe_icache_add_nolock(cache, NULL, NULL, &cond) != 0) {
-                if (pthread_mutex_unlock(&cache->queue_mutex) != 0) {
-                        dE("An error ocured while unlocking the queue mutex: %u, %s",
-                           errno, strerror(errno));
-                        abort();
-                }
+        seq = cache->queue_seq;
 
-                pthread_cond_destroy(&cond);
-                return (-1);
+        if (pthread_mutex_unlock(&cache->queue_mutex) != 0) {
+                dE("An error ocured while unlocking the queue mutex: %u, %s",
+                   errno, strerror(errno));
+                abort();
         }
 
-        dD("Signaling `notempty'");
+        dD("Waiting for icache workers to handle %"PRIu64" queued item(s)", seq);
 
-        if (pthread_cond_signal(&cache->queue_notempty) != 0) {
-                dE("An error ocured while signaling the `notempty' condition: %u, %s",
+        if (pthread_mutex_lock(&cache->commit_mutex) != 0) {
+                dE("An error ocured while locking the commit mutex: %u, %s",
                    errno, strerror(errno));
-
-                pthread_cond_destroy(&cond);
                 return (-1);
         }
 
-        dD("Waiting for icache worker to handle the NOP");
-
-        if (pthread_cond_wait(&cond, &cache->queue_mutex) != 0) {
-                dE("An error ocured while waiting for the `NOP' queue condition: %u, %s",
-                   errno, strerror(errno));
-                return (-1);
+        while (cache->commit_seq < seq && !cache->shutdown) {
+                if (pthread_cond_wait(&cache->commit_cond, &cache->commit_mutex) != 0) {
+                        dE("An error ocured while waiting for the `commit' condition: %u, %s",
+                           errno, strerror(errno));
+                        pthread_mutex_unlock(&cache->commit_mutex);
+                        return (-1);
+                }
         }
 
         dD("Sync");
 
-        if (pthread_mutex_unlock(&cache->queue_mutex) != 0) {
-                dE("An error ocured while unlocking the queue mutex: %u, %s",
+        if (pthread_mutex_unlock(&cache->commit_mutex) != 0) {
+                dE("An error ocured while unlocking the commit mutex: %u, %s",
                    errno, strerror(errno));
                 abort();
         }
 
-        pthread_cond_destroy(&cond);
-
         return (0);
 }
 
 #define PROBE_RESULT_MEMCHECK_CTRESHOLD  1000  /* item count */
+#define PROBE_RESULT_MEMCHECK_ITEMS      4096  /* items between two checks */
+#define PROBE_RESULT_MEMCHECK_BYTES      (1 << 20) /* item bytes between two checks */
+#define PROBE_RESULT_MEMCHECK_INTERVAL   1000  /* milliseconds between two checks */
 
 /**
  * Returns 0 if the memory constraints are not reached. Otherwise, 1 is returned.
@@ -520,6 +590,66 @@ static int probe_cobj_memcheck(size_t item_cnt, double max_ratio)
 	return (0);
 }
 
+/*
+ * Read the monotonic clock. Without it the time is always zero and only
+ * the item and byte budgets are used.
+ */
+static void probe_memcheck_clock(struct timespec *now)
+{
+#if defined(HAVE_CLOCK_GETTIME) && defined(CLOCK_MONOTONIC)
+	if (clock_gettime(CLOCK_MONOTONIC, now) == 0)
+		return;
+#endif
+	now->tv_sec = 0;
+	now->tv_nsec = 0;
+}
+
+/**
+ * Check the process memory usage once the budget of the context is used
+ * up. The budget is accounted on the items which were left in the
+ * collected object after deduplication, the icache workers count them.
+ * Reading the memory usage is costly (procfs), so it isn't done for every
+ * collected item. Once the limit is reached, it stays reached for the
+ * rest of the context.
+ *
+ * Returns the same values as probe_cobj_memcheck().
+ */
+static int probe_ctx_memcheck(struct probe_ctx *ctx)
+{
+	struct probe_memcheck *mc = &ctx->memcheck;
+	struct timespec now;
+	size_t items, bytes;
+	int ret;
+
+	if (mc->exceeded)
+		return (1);
+
+	items = __sync_fetch_and_add(&mc->collected.items, 0);
+	if (items <= PROBE_RESULT_MEMCHECK_CTRESHOLD)
+		return (0);
+	bytes = __sync_fetch_and_add(&mc->collected.bytes, 0);
+	probe_memcheck_clock(&now);
+
+	/* the first check is done once the collected object exceeds the threshold */
+	if (mc->checked_items != 0
+	    && items - mc->checked_items < PROBE_RESULT_MEMCHECK_ITEMS
+	    && bytes - mc->checked_bytes < PROBE_RESULT_MEMCHECK_BYTES
+	    && (now.tv_sec - mc->checked_time.tv_sec) * 1000
+	       + (now.tv_nsec - mc->checked_time.tv_nsec) / 1000000 < PROBE_RESULT_MEMCHECK_INTERVAL)
+		return (0);
+
+	ret = probe_cobj_memcheck(items, ctx->max_mem_ratio);
+
+	if (ret == 1)
+		mc->exceeded = true;
+
+	mc->checked_items = items;
+	mc->checked_bytes = bytes;
+	mc->checked_time = now;
+
+	return (ret);
+}
+
 /**
  * Collect an item
  * This function adds an item the collected object assosiated
@@ -537,19 +667,13 @@ static int probe_cobj_memcheck(size_t item_cnt, double max_ratio)
  */
 int probe_item_collect(struct probe_ctx *ctx, SEXP_t *item)
 {
-	SEXP_t *cobj_content;
-	size_t  cobj_itemcnt;
 	int memcheck_ret;
 
 	if (ctx == NULL || ctx->probe_out == NULL || item == NULL) {
 		return -1;
 	}
 
-	cobj_content = SEXP_listref_nth(ctx->probe_out, 3);
-	cobj_itemcnt = SEXP_list_length(cobj_content);
-	SEXP_free(cobj_content);
-
-	memcheck_ret = probe_cobj_memcheck(cobj_itemcnt, ctx->max_mem_ratio);
+	memcheck_ret = probe_ctx_memcheck(ctx);
 	if (memcheck_ret == -1) {
 		dE("Failed to check available memory");
 		return -1;
@@ -586,7 +710,7 @@ int probe_item_collect(struct probe_ctx *ctx, SEXP_t *item)
 		return (1);
         }
 
-        if (probe_icache_add(ctx->icache, ctx->probe_out, item) != 0) {
+        if (probe_icache_add(ctx->icache, ctx->probe_out, item, &ctx->memcheck.collected) != 0) {
                 dE("Can't add item (%p) to the item cache (%p)", item, ctx->icache);
                 SEXP_free(item);
                 return (-1);
@@ -610,15 +734,42 @@ static void probe_icache_free_node(struct rbt_i64_node *n)
 
 void probe_icache_free(probe_icache_t *cache)
 {
-        void *ret = NULL;
+        unsigned i;
+
+        /*
+         * Stop the workers. Items which are still queued are dropped,
+         * their collected objects may not exist anymore.
+         */
+        pthread_mutex_lock(&cache->queue_mutex);
+        pthread_mutex_lock(&cache->commit_mutex);
+        cache->shutdown = true;
+        pthread_cond_broadcast(&cache->queue_notempty);
+        pthread_cond_broadcast(&cache->commit_cond);
+        pthread_mutex_unlock(&cache->commit_mutex);
+        pthread_mutex_unlock(&cache->queue_mutex);
+
+        for (i = 0; i < cache->thcnt; ++i)
+                pthread_join(cache->thid[i], NULL);
+
+        for (; cache->queue_cnt > 0; --cache->queue_cnt) {
+                SEXP_free(cache->queue[cache->queue_beg].item);
+
+                if (++cache->queue_beg == cache->queue_max)
+                        cache->queue_beg = 0;
+        }
 
-        pthread_cancel(cache->thid);
-        pthread_join(cache->thid, &ret);
         pthread_mutex_destroy(&cache->queue_mutex);
         pthread_cond_destroy(&cache->queue_notempty);
         pthread_cond_destroy(&cache->queue_notfull);
+        pthread_mutex_destroy(&cache->commit_mutex);
+        pthread_cond_destroy(&cache->commit_cond);
+
+        for (i = 0; i < PROBE_ICACHE_SHARDS; ++i) {
+                rbt_i64_free_cb(cache->shard[i].tree, &probe_icache_free_node);
+                pthread_mutex_destroy(&cache->shard[i].mutex);
+        }
 
-        rbt_i64_free_cb(cache->tree, &probe_icache_free_node);
+        free(cache->thid);
         free(cache);
         return;
 }
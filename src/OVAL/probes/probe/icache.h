@@ -23,6 +23,9 @@
 #define ICACHE_H
 
 #include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
 #include <sexp.h>
 #include "../SEAP/generic/rbt/rbt.h"
 
@@ -30,17 +33,44 @@
 #define PROBE_IQUEUE_CAPACITY 1024
 #endif
 
+/* Number of independently locked item trees, must be a power of two */
+#ifndef PROBE_ICACHE_SHARDS
+#define PROBE_ICACHE_SHARDS 16
+#endif
+
+/* Upper bound of the default worker count, see probe_main.c */
+#ifndef PROBE_ICACHE_WORKERS_MAX
+#define PROBE_ICACHE_WORKERS_MAX 4
+#endif
+
+/*
+ * Items left in a collected object after deduplication and their size,
+ * updated by the icache workers.
+ */
+typedef struct {
+        size_t items;
+        size_t bytes;
+} probe_icount_t;
+
 typedef struct {
-        SEXP_t *cobj;
-        union {
-                SEXP_t         *item;
-                pthread_cond_t *cond;
-        } p;
+        SEXP_t         *cobj;
+        SEXP_t         *item;
+        probe_icount_t *count;
+        uint64_t        seq;
 } probe_iqpair_t;
 
 typedef struct {
-        rbt_t    *tree; /* XXX: rewrite to extensible or linear hashing */
-        pthread_t thid;
+        pthread_mutex_t mutex;
+        rbt_t          *tree; /* XXX: rewrite to extensible or linear hashing */
+} probe_ishard_t;
+
+typedef struct {
+        probe_ishard_t shard[PROBE_ICACHE_SHARDS];
+
+        pthread_t *thid;
+        unsigned   thcnt;
+        unsigned   thready;
+        bool       shutdown;
 
         pthread_mutex_t queue_mutex;
         pthread_cond_t  queue_notempty;
@@ -51,6 +81,15 @@ typedef struct {
         uint16_t        queue_end;
         uint16_t        queue_cnt;
         uint16_t        queue_max;
+        uint64_t        queue_seq;   /* sequence number of the next queued item */
+
+        /*
+         * Items are deduplicated in parallel, but added to the collected
+         * object in the order in which they were queued.
+         */
+        pthread_mutex_t commit_mutex;
+        pthread_cond_t  commit_cond;
+        uint64_t        commit_seq;  /* sequence number of the next item to commit */
 } probe_icache_t;
 
 typedef struct {
@@ -58,8 +97,17 @@ typedef struct {
         uint16_t  count;
 } probe_citem_t;
 
-probe_icache_t *probe_icache_new(void);
-int probe_icache_add(probe_icache_t *cache, SEXP_t *cobj, SEXP_t *item);
+/*
+ * Create the item cache with thcnt worker threads. Without workers the
+ * items are deduplicated by the thread which adds them.
+ */
+probe_icache_t *probe_icache_new(unsigned thcnt);
+/*
+ * Queue the item to be deduplicated and added to the collected object.
+ * If count isn't NULL, it's updated once the item is added and it isn't
+ * a duplicate of an item added before.
+ */
+int probe_icache_add(probe_icache_t *cache, SEXP_t *cobj, SEXP_t *item, probe_icount_t *count);
 int probe_icache_nop(probe_icache_t *cache);
 void probe_icache_free(probe_icache_t *cache);
 
@@ -34,6 +34,7 @@
 #include <stddef.h>
 #include <stdarg.h>
 #include <pthread.h>
+#include <time.h>
 #include "_seap.h"
 #include "ncache.h"
 #include "rcache.h"
@@ -77,6 +78,18 @@ typedef struct {
 	int real_cwd_fd;
 } probe_t;
 
+/**
+ * Memory usage accounting of a probe context. The process memory usage is
+ * sampled only after a budget of collected items, bytes or time is used up.
+ */
+struct probe_memcheck {
+	probe_icount_t  collected;     /**< items of the collected object after deduplication */
+	size_t          checked_items; /**< collected items at the last memory usage check */
+	size_t          checked_bytes; /**< collected bytes at the last memory usage check */
+	struct timespec checked_time;  /**< time of the last memory usage check */
+	bool            exceeded;      /**< the memory usage limit was reached */
+};
+
 struct probe_ctx {
         SEXP_t         *probe_in;  /**< S-exp representation of the input object */
         SEXP_t         *probe_out; /**< collected object */
@@ -84,6 +97,7 @@ struct probe_ctx {
         probe_icache_t *icache;    /**< item cache */
 	int offline_mode;
 	double max_mem_ratio;
+	struct probe_memcheck memcheck;
 };
 
 typedef enum {
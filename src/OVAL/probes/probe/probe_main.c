@@ -191,7 +191,8 @@ void *probe_common_main(void *arg)
 
 	dD("probe_common_main started");
 
-	const unsigned thread_count = 2; // input and icache threads
+	const unsigned icache_workers = oscap_env_worker_count("OSCAP_PROBE_ICACHE_WORKERS", PROBE_ICACHE_WORKERS_MAX);
+	const unsigned thread_count = icache_workers > 0 ? 2 : 1; // input and icache threads
 	if ((errno = pthread_barrier_init(&OSCAP_GSYM(th_barrier), NULL, thread_count)) != 0) {
 		fail(errno, "pthread_barrier_init", __LINE__ - 6);
 	}
@@ -218,7 +219,7 @@ void *probe_common_main(void *arg)
 	 * Initialize result & name caching
 	 */
 	probe.rcache = probe_rcache_new();
-	probe.icache = probe_icache_new();
+	probe.icache = probe_icache_new(icache_workers);
 	probe_ncache_clear(OSCAP_GSYM(ncache));
 	probe.ncache = OSCAP_GSYM(ncache);
 
@@ -1076,6 +1076,8 @@ SEXP_t *probe_worker(probe_t *probe, SEAP_msg_t *msg_in, int *ret)
 				pctx.max_mem_ratio = max_ratio;
 		}
 
+		memset(&pctx.memcheck, 0, sizeof pctx.memcheck);
+
 		/* simple object */
                 pctx.icache  = probe->icache;
 		pctx.filters = probe_prepare_filters(probe, probe_in);
@@ -1147,6 +1149,7 @@ SEXP_t *probe_worker(probe_t *probe, SEAP_msg_t *msg_in, int *ret)
                                  * Prepare the collected object
                                  */
 				cobj = probe_cobj_new(SYSCHAR_FLAG_UNKNOWN, NULL, NULL, mask);
+				memset(&pctx.memcheck, 0, sizeof pctx.memcheck);
 
                                 pctx.probe_in  = ctx->pi2;
                                 pctx.probe_out = cobj;
@@ -41,7 +41,6 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
-#include <pcre.h>
 
 #include "rpm-helper.h"
 #include "oscap_helpers.h"
@@ -53,6 +52,7 @@
 /* SEAP */
 #include <probe-api.h>
 #include "debug_priv.h"
+#include "oscap_pcre.h"
 #include "probe/entcmp.h"
 
 #include <probe/probe.h>
@@ -154,16 +154,18 @@ static int _compare_file_with_current_file(oval_operation_t file_op, const char
 		}
 		*result_file = current_file_realpath ? oscap_strdup(current_file_realpath) : oscap_strdup(current_file);
 	} else if (file_op == OVAL_OPERATION_PATTERN_MATCH) {
-		const char *errmsg;
+		char *errmsg;
 		int erroff;
-		pcre *re = pcre_compile(file, PCRE_UTF8, &errmsg,  &erroff, NULL);
+		/* the pattern is matched with every file of every package */
+		oscap_pcre_t *re = oscap_pcre_get_cached(file, OSCAP_PCRE_OPTS_UTF8, &errmsg, &erroff);
 		if (re == NULL) {
 			dE("pcre_compile pattern='%s': %s", file, errmsg);
+			oscap_pcre_err_free(errmsg);
 			ret = -1;
 			goto cleanup;
 		}
-		int pcre_ret = pcre_exec(re, NULL, current_file, strlen(current_file), 0, 0, NULL, 0);
-		pcre_free(re);
+		int pcre_ret = oscap_pcre_exec(re, current_file, strlen(current_file), 0, OSCAP_PCRE_OPTS_NONE, NULL, 0);
+		oscap_pcre_free(re);
 		if (pcre_ret == 0) {
 			/* match */
 			*result_file = oscap_strdup(current_file);
@@ -49,6 +49,12 @@ struct oval_string_iterator;
 
 /**
  * @name Iterators
+ * Iterators returned by the getters of the OVAL models don't copy the
+ * items they iterate over, they read them from the collection of the
+ * model object they were obtained from. An iterator must not outlive
+ * that object: free the iterator before the object or the model which
+ * owns it is freed. Items added to the collection after the iterator
+ * has been created are not returned by it.
  * @{
  */
 /**
@@ -8,6 +8,10 @@
  * Class diagram
  * \image html definition_model.png
  *
+ * Iterators returned by the getters of this model borrow the collections
+ * of the objects they were obtained from, see @ref OVALADT. Free them
+ * before the definition model is freed.
+ *
  * @file
  *
  * @author "David Niemoller" <David.Niemoller@g2-inc.com>
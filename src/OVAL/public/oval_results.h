@@ -8,6 +8,10 @@
  * Class diagram
  * \image html result_model.png
  *
+ * Iterators over result systems, definitions, tests and items read them
+ * from the results model (see @ref OVALADT), they must not be used once
+ * the results model is freed.
+ *
  * @file
  *
  * @author "David Niemoller" <David.Niemoller@g2-inc.com>
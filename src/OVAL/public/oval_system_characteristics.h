@@ -8,6 +8,10 @@
  * Class diagram
  * \image html system_characteristic.png
  *
+ * Iterators over system data, items and collected objects borrow the
+ * collections of this model (see @ref OVALADT) and must be freed before
+ * the system characteristics model is.
+ *
  * @file
  *
  * @author "David Niemoller" <David.Niemoller@g2-inc.com>
@@ -5,6 +5,9 @@
  * Interface to Variable model
  * @{
  *
+ * Iterators over variable IDs and values don't own them (see @ref OVALADT),
+ * free them before the variable model.
+ *
  * @file
  *
  * @author "David Niemoller" <David.Niemoller@g2-inc.com>
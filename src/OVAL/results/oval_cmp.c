@@ -28,6 +28,7 @@
 #include <config.h>
 #endif
 
+#include <stdlib.h>
 #include <string.h>
 #include <inttypes.h>
 
@@ -161,3 +162,145 @@ oval_result_t oval_str_cmp_str(char *state_data, oval_datatype_t state_data_type
 	oscap_seterr(OSCAP_EFAMILY_OVAL, "Invalid OVAL data type: %d.", state_data_type);
 	return OVAL_RESULT_ERROR;
 }
+
+typedef enum {
+	OVAL_CMP_OPERAND_TEXT,          ///< compared by oval_str_cmp_str()
+	OVAL_CMP_OPERAND_INTEGER,
+	OVAL_CMP_OPERAND_FLOAT,
+	OVAL_CMP_OPERAND_BOOLEAN,
+	OVAL_CMP_OPERAND_REGEX,
+	OVAL_CMP_OPERAND_EVR_STRING,
+	OVAL_CMP_OPERAND_DEBIAN_EVR_STRING,
+	OVAL_CMP_OPERAND_IPADDR
+} oval_cmp_operand_type_t;
+
+struct oval_cmp_operand {
+	char *state_data;
+	oval_datatype_t datatype;
+	oval_operation_t operation;
+	oval_cmp_operand_type_t type;
+	union {
+		intmax_t integer;
+		double real;
+		bool boolean;
+		oscap_pcre_t *regex;
+		struct oval_evr_string evr;
+		struct {
+			struct oval_evr_string evr;
+			struct dpkg_version version;
+		} debian;
+		struct oval_ipaddr ipaddr;
+	} value;
+};
+
+struct oval_cmp_operand *oval_cmp_operand_new(char *state_data, oval_datatype_t state_data_type, oval_operation_t operation)
+{
+	struct oval_cmp_operand *operand = calloc(1, sizeof(struct oval_cmp_operand));
+	operand->state_data = state_data;
+	operand->datatype = state_data_type;
+	operand->operation = operation;
+	operand->type = OVAL_CMP_OPERAND_TEXT;
+
+	/* The values which can't be parsed are compared as text to get
+	 * the same warnings as before for every comparison. */
+	switch (state_data_type) {
+	case OVAL_DATATYPE_STRING:
+		if (operation == OVAL_OPERATION_PATTERN_MATCH) {
+			operand->value.regex = oval_string_regex_compile(state_data);
+			if (operand->value.regex != NULL)
+				operand->type = OVAL_CMP_OPERAND_REGEX;
+		}
+		break;
+	case OVAL_DATATYPE_INTEGER:
+		if (cstr_to_intmax(state_data, &operand->value.integer))
+			operand->type = OVAL_CMP_OPERAND_INTEGER;
+		break;
+	case OVAL_DATATYPE_FLOAT:
+		if (cstr_to_double(state_data, &operand->value.real))
+			operand->type = OVAL_CMP_OPERAND_FLOAT;
+		break;
+	case OVAL_DATATYPE_BOOLEAN:
+		operand->value.boolean = strcmp(state_data, "true") == 0 || strcmp(state_data, "1") == 0;
+		operand->type = OVAL_CMP_OPERAND_BOOLEAN;
+		break;
+	case OVAL_DATATYPE_EVR_STRING:
+		oval_evr_string_parse(state_data, &operand->value.evr);
+		operand->type = OVAL_CMP_OPERAND_EVR_STRING;
+		break;
+	case OVAL_DATATYPE_DEBIAN_EVR_STRING:
+		if (oval_debian_evr_string_parse(state_data, &operand->value.debian.evr, &operand->value.debian.version) == 0)
+			operand->type = OVAL_CMP_OPERAND_DEBIAN_EVR_STRING;
+		break;
+	case OVAL_DATATYPE_IPV4ADDR:
+	case OVAL_DATATYPE_IPV6ADDR:
+		if (oval_ipaddr_parse(state_data_type == OVAL_DATATYPE_IPV4ADDR ? AF_INET : AF_INET6,
+				state_data, &operand->value.ipaddr) == 0)
+			operand->type = OVAL_CMP_OPERAND_IPADDR;
+		break;
+	default:
+		break;
+	}
+	return operand;
+}
+
+oval_result_t oval_cmp_operand_cmp(const struct oval_cmp_operand *operand, const char *sys_data)
+{
+	switch (operand->type) {
+	case OVAL_CMP_OPERAND_INTEGER: {
+		intmax_t syschar_val;
+
+		if (!cstr_to_intmax(sys_data, &syschar_val)) {
+			dW(
+				"Conversion of the string \"%s\" to an integer (%zu bits) failed: %s",
+				sys_data, sizeof(intmax_t)*8, strerror(errno));
+			return OVAL_RESULT_ERROR;
+		}
+		return oval_int_cmp(operand->value.integer, syschar_val, operand->operation);
+		}
+	case OVAL_CMP_OPERAND_FLOAT: {
+		double sys_val;
+
+		if (!cstr_to_double(sys_data, &sys_val)) {
+			dW(
+				"Conversion of the string \"%s\" to a floating type (double) failed: %s",
+				sys_data, strerror(errno));
+			return OVAL_RESULT_ERROR;
+		}
+		return oval_float_cmp(operand->value.real, sys_val, operand->operation);
+		}
+	case OVAL_CMP_OPERAND_BOOLEAN: {
+		bool sys_val = strcmp(sys_data, "true") == 0 || strcmp(sys_data, "1") == 0;
+		return oval_boolean_cmp(operand->value.boolean, sys_val, operand->operation);
+		}
+	case OVAL_CMP_OPERAND_REGEX:
+		return oval_string_regex_cmp(operand->value.regex, operand->state_data, sys_data);
+	case OVAL_CMP_OPERAND_EVR_STRING:
+		return oval_evr_string_cmp_parsed(&operand->value.evr, sys_data, operand->operation);
+	case OVAL_CMP_OPERAND_DEBIAN_EVR_STRING:
+		return oval_debian_evr_string_cmp_parsed(&operand->value.debian.version, sys_data, operand->operation);
+	case OVAL_CMP_OPERAND_IPADDR:
+		return oval_ipaddr_cmp_parsed(&operand->value.ipaddr, sys_data, operand->operation);
+	default:
+		return oval_str_cmp_str(operand->state_data, operand->datatype, sys_data, operand->operation);
+	}
+}
+
+void oval_cmp_operand_free(struct oval_cmp_operand *operand)
+{
+	if (operand == NULL)
+		return;
+	switch (operand->type) {
+	case OVAL_CMP_OPERAND_REGEX:
+		oscap_pcre_free(operand->value.regex);
+		break;
+	case OVAL_CMP_OPERAND_EVR_STRING:
+		oval_evr_string_clear(&operand->value.evr);
+		break;
+	case OVAL_CMP_OPERAND_DEBIAN_EVR_STRING:
+		oval_evr_string_clear(&operand->value.debian.evr);
+		break;
+	default:
+		break;
+	}
+	free(operand);
+}
@@ -27,11 +27,11 @@
 
 #include <math.h>
 #include <string.h>
-#include <pcre.h>
 
 #include "oval_types.h"
 #include "common/_error.h"
 #include "common/debug_priv.h"
+#include "common/oscap_pcre.h"
 #include "oval_cmp_basic_impl.h"
 
 oval_result_t oval_boolean_cmp(const bool state, const bool syschar, oval_operation_t operation)
@@ -120,33 +120,48 @@ static int istrcmp(const char *st1, const char *st2)
 	return oscap_strcasecmp(st1, st2);
 }
 
-static oval_result_t strregcomp(const char *pattern, const char *test_str)
+oscap_pcre_t *oval_string_regex_compile(const char *pattern)
 {
-	int ret;
-	oval_result_t result = OVAL_RESULT_ERROR;
-	pcre *re;
-	const char *err;
+	oscap_pcre_t *re;
+	char *err;
 	int errofs;
 
-	re = pcre_compile(pattern, PCRE_UTF8, &err, &errofs, NULL);
+	re = oscap_pcre_get_cached(pattern, OSCAP_PCRE_OPTS_UTF8, &err, &errofs);
 	if (re == NULL) {
 		dE("Unable to compile regex pattern '%s', "
 				"pcre_compile() returned error (offset: %d): '%s'.\n", pattern, errofs, err);
-		return OVAL_RESULT_ERROR;
+		oscap_pcre_err_free(err);
 	}
+	return re;
+}
 
-	ret = pcre_exec(re, NULL, test_str, strlen(test_str), 0, 0, NULL, 0);
+oval_result_t oval_string_regex_cmp(oscap_pcre_t *re, const char *pattern, const char *syschar)
+{
+	int ret;
+
+	syschar = syschar ? syschar : "";
+	ret = oscap_pcre_exec(re, syschar, strlen(syschar), 0, OSCAP_PCRE_OPTS_NONE, NULL, 0);
 	if (ret > -1 ) {
-		result = OVAL_RESULT_TRUE;
+		return OVAL_RESULT_TRUE;
 	} else if (ret == -1) {
-		result = OVAL_RESULT_FALSE;
-	} else {
-		dE("Unable to match regex pattern '%s' on string '%s', "
-				"pcre_exec() returned error: %d.\n", pattern, test_str, ret);
-		result = OVAL_RESULT_ERROR;
+		return OVAL_RESULT_FALSE;
 	}
+	dE("Unable to match regex pattern '%s' on string '%s', "
+			"pcre_exec() returned error: %d.\n", pattern, syschar, ret);
+	return OVAL_RESULT_ERROR;
+}
+
+static oval_result_t strregcomp(const char *pattern, const char *test_str)
+{
+	oval_result_t result;
+	oscap_pcre_t *re;
+
+	re = oval_string_regex_compile(pattern);
+	if (re == NULL)
+		return OVAL_RESULT_ERROR;
 
-	pcre_free(re);
+	result = oval_string_regex_cmp(re, pattern, test_str);
+	oscap_pcre_free(re);
 	return result;
 }
 
@@ -24,6 +24,7 @@
 #define OSCAP_OVAL_CMP_BASIC_IMPL_H_
 
 #include "../common/util.h"
+#include "../common/oscap_pcre.h"
 #include "oval_definitions.h"
 #include "oval_types.h"
 
@@ -38,5 +39,20 @@ oval_result_t oval_string_cmp(const char *state, const char *syschar, oval_opera
 
 oval_result_t oval_binary_cmp(const char *state, const char *syschar, oval_operation_t operation);
 
+/**
+ * Compile the regex pattern of a state for the pattern match operation.
+ * @returns the compiled pattern (to be freed by oscap_pcre_free) or NULL
+ * if the pattern is invalid
+ */
+oscap_pcre_t *oval_string_regex_compile(const char *pattern);
+
+/**
+ * Match a string collected from the system with the compiled regex pattern.
+ * @param re compiled pattern
+ * @param pattern the pattern, used in the error messages
+ * @param syschar string collected from the system
+ */
+oval_result_t oval_string_regex_cmp(oscap_pcre_t *re, const char *pattern, const char *syschar);
+
 
 #endif
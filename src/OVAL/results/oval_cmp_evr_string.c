@@ -57,16 +57,12 @@ static int risdigit(int c) {
 #endif
 
 static inline int rpmevrcmp(const char *a, const char *b);
+static int rpmevrcmp_parsed(const struct oval_evr_string *a, const struct oval_evr_string *b);
 static int compare_values(const char *str1, const char *str2);
 static void parseEVR(char *evr, const char **ep, const char **vp, const char **rp);
 
-oval_result_t oval_evr_string_cmp(const char *state, const char *sys, oval_operation_t operation)
+static oval_result_t evr_result(int result, oval_operation_t operation)
 {
-	if (state == NULL || sys == NULL) {
-		return OVAL_RESULT_ERROR;
-	}
-	int result = rpmevrcmp(sys, state);
-
 	if (operation == OVAL_OPERATION_EQUALS) {
 		return ((result == 0) ? OVAL_RESULT_TRUE : OVAL_RESULT_FALSE);
 	} else if (operation == OVAL_OPERATION_NOT_EQUAL) {
@@ -85,30 +81,77 @@ oval_result_t oval_evr_string_cmp(const char *state, const char *sys, oval_opera
 	return OVAL_RESULT_ERROR;
 }
 
+oval_result_t oval_evr_string_cmp(const char *state, const char *sys, oval_operation_t operation)
+{
+	if (state == NULL || sys == NULL) {
+		return OVAL_RESULT_ERROR;
+	}
+	return evr_result(rpmevrcmp(sys, state), operation);
+}
+
+void oval_evr_string_parse(const char *text, struct oval_evr_string *evr)
+{
+	evr->buffer = oscap_strdup(text);
+	evr->epoch = evr->version = evr->release = NULL;
+	parseEVR(evr->buffer, &evr->epoch, &evr->version, &evr->release);
+}
+
+void oval_evr_string_clear(struct oval_evr_string *evr)
+{
+	free(evr->buffer);
+	evr->buffer = NULL;
+}
+
+oval_result_t oval_evr_string_cmp_parsed(const struct oval_evr_string *state, const char *sys, oval_operation_t operation)
+{
+	struct oval_evr_string sys_evr = { NULL, NULL, NULL, NULL };
+	char buffer[256];
+	size_t len;
+	int result;
+
+	if (sys == NULL) {
+		return OVAL_RESULT_ERROR;
+	}
+	/* Most of the collected EVR strings are short, don't allocate them */
+	len = strlen(sys);
+	if (len < sizeof(buffer)) {
+		memcpy(buffer, sys, len + 1);
+		parseEVR(buffer, &sys_evr.epoch, &sys_evr.version, &sys_evr.release);
+		result = rpmevrcmp_parsed(&sys_evr, state);
+	} else {
+		oval_evr_string_parse(sys, &sys_evr);
+		result = rpmevrcmp_parsed(&sys_evr, state);
+		oval_evr_string_clear(&sys_evr);
+	}
+	return evr_result(result, operation);
+}
+
 static inline int rpmevrcmp(const char *a, const char *b)
 {
 	/* This mimics rpmevrcmp which is not exported by rpmlib version 4.
 	 * Code inspired by rpm.labelCompare() from rpm4/python/header-py.c
 	 */
-	const char *a_epoch, *a_version, *a_release;
-	const char *b_epoch, *b_version, *b_release;
-	char *a_copy, *b_copy;
+	struct oval_evr_string a_evr, b_evr;
 	int result;
 
-	a_copy = oscap_strdup(a);
-	b_copy = oscap_strdup(b);
-	parseEVR(a_copy, &a_epoch, &a_version, &a_release);
-	parseEVR(b_copy, &b_epoch, &b_version, &b_release);
+	oval_evr_string_parse(a, &a_evr);
+	oval_evr_string_parse(b, &b_evr);
+	result = rpmevrcmp_parsed(&a_evr, &b_evr);
+	oval_evr_string_clear(&a_evr);
+	oval_evr_string_clear(&b_evr);
+	return result;
+}
 
-	result = compare_values(a_epoch, b_epoch);
+static int rpmevrcmp_parsed(const struct oval_evr_string *a, const struct oval_evr_string *b)
+{
+	int result;
+
+	result = compare_values(a->epoch, b->epoch);
 	if (!result) {
-		result = compare_values(a_version, b_version);
+		result = compare_values(a->version, b->version);
 		if (!result)
-			result = compare_values(a_release, b_release);
+			result = compare_values(a->release, b->release);
 	}
-
-	free(a_copy);
-	free(b_copy);
 	return result;
 }
 
@@ -379,7 +422,7 @@ static int verrevcmp(const char *a, const char *b)
  * @retval <0 If a is smaller than b.
  * @retval >0 If a is greater than b.
  */
-static int dpkg_version_compare(struct dpkg_version *a, struct dpkg_version *b)
+static int dpkg_version_compare(const struct dpkg_version *a, const struct dpkg_version *b)
 {
 	int rc;
 
@@ -395,13 +438,43 @@ static int dpkg_version_compare(struct dpkg_version *a, struct dpkg_version *b)
 	return verrevcmp(a->revision, b->revision);
 }
 
+static oval_result_t debian_evr_result(int result, oval_operation_t operation)
+{
+	switch (operation) {
+	case OVAL_OPERATION_EQUALS:
+		return ((result == 0) ? OVAL_RESULT_TRUE : OVAL_RESULT_FALSE);
+	case OVAL_OPERATION_NOT_EQUAL:
+		return ((result != 0) ? OVAL_RESULT_TRUE : OVAL_RESULT_FALSE);
+	case OVAL_OPERATION_GREATER_THAN:
+		return ((result > 0) ? OVAL_RESULT_TRUE : OVAL_RESULT_FALSE);
+	case OVAL_OPERATION_GREATER_THAN_OR_EQUAL:
+		return ((result >= 0) ? OVAL_RESULT_TRUE : OVAL_RESULT_FALSE);
+	case OVAL_OPERATION_LESS_THAN:
+		return ((result < 0) ? OVAL_RESULT_TRUE : OVAL_RESULT_FALSE);
+	case OVAL_OPERATION_LESS_THAN_OR_EQUAL:
+		return ((result <= 0) ? OVAL_RESULT_TRUE : OVAL_RESULT_FALSE);
+	default:
+		oscap_seterr(OSCAP_EFAMILY_OVAL, "Invalid type of operation in rpm version comparison: %d.", operation);
+	}
+
+	return OVAL_RESULT_ERROR;
+}
+
+static bool debian_epoch(const char *epoch, unsigned int *epoch_out)
+{
+	long aux = strtol(epoch, NULL, 10);
+	if (aux < INT_MIN || aux > INT_MAX)
+		return false; // Outside int range
+	*epoch_out = (int) aux;
+	return true;
+}
+
 oval_result_t oval_debian_evr_string_cmp(const char *state, const char *sys, oval_operation_t operation)
 {
 	struct dpkg_version a, b;
-	const char *a_epoch, *a_version, *a_release;
-	const char *b_epoch, *b_version, *b_release;
+	const char *a_epoch = NULL, *a_version = NULL, *a_release = NULL;
+	const char *b_epoch = NULL, *b_version = NULL, *b_release = NULL;
 	char *a_copy, *b_copy;
-	long aux;
 
 	a_copy = oscap_strdup(sys);
 	b_copy = oscap_strdup(state);
@@ -415,21 +488,11 @@ oval_result_t oval_debian_evr_string_cmp(const char *state, const char *sys, ova
 		return OVAL_RESULT_ERROR;
 	}
 
-	aux = strtol(a_epoch, NULL, 10);
-	if (aux < INT_MIN || aux > INT_MAX) {
-		free(a_copy);
-		free(b_copy);
-		return OVAL_RESULT_ERROR; // Outside int range
-	}
-	a.epoch = (int) aux;
-
-	aux = strtol(b_epoch, NULL, 10);
-	if (aux < INT_MIN || aux > INT_MAX) {
+	if (!debian_epoch(a_epoch, &a.epoch) || !debian_epoch(b_epoch, &b.epoch)) {
 		free(a_copy);
 		free(b_copy);
-		return OVAL_RESULT_ERROR; // Outside int range
+		return OVAL_RESULT_ERROR;
 	}
-	b.epoch = (int) aux;
 
 	a.version = a_version;
 	a.revision = a_release;
@@ -439,24 +502,55 @@ oval_result_t oval_debian_evr_string_cmp(const char *state, const char *sys, ova
 
 	free(a_copy);
 	free(b_copy);
-	switch (operation) {
-	case OVAL_OPERATION_EQUALS:
-		return ((result == 0) ? OVAL_RESULT_TRUE : OVAL_RESULT_FALSE);
-	case OVAL_OPERATION_NOT_EQUAL:
-		return ((result != 0) ? OVAL_RESULT_TRUE : OVAL_RESULT_FALSE);
-	case OVAL_OPERATION_GREATER_THAN:
-		return ((result > 0) ? OVAL_RESULT_TRUE : OVAL_RESULT_FALSE);
-	case OVAL_OPERATION_GREATER_THAN_OR_EQUAL:
-		return ((result >= 0) ? OVAL_RESULT_TRUE : OVAL_RESULT_FALSE);
-	case OVAL_OPERATION_LESS_THAN:
-		return ((result < 0) ? OVAL_RESULT_TRUE : OVAL_RESULT_FALSE);
-	case OVAL_OPERATION_LESS_THAN_OR_EQUAL:
-		return ((result <= 0) ? OVAL_RESULT_TRUE : OVAL_RESULT_FALSE);
-	default:
-		oscap_seterr(OSCAP_EFAMILY_OVAL, "Invalid type of operation in rpm version comparison: %d.", operation);
+	return debian_evr_result(result, operation);
+}
+
+int oval_debian_evr_string_parse(const char *text, struct oval_evr_string *evr, struct dpkg_version *version)
+{
+	oval_evr_string_parse(text, evr);
+	if (evr->epoch == NULL || !debian_epoch(evr->epoch, &version->epoch)) {
+		oval_evr_string_clear(evr);
+		return -1;
 	}
+	version->version = evr->version;
+	version->revision = evr->release;
+	return 0;
+}
 
-	return OVAL_RESULT_ERROR;
+oval_result_t oval_debian_evr_string_cmp_parsed(const struct dpkg_version *state, const char *sys, oval_operation_t operation)
+{
+	struct oval_evr_string sys_evr = { NULL, NULL, NULL, NULL };
+	struct dpkg_version a;
+	char buffer[256];
+	size_t len;
+	int result;
+
+	if (sys == NULL) {
+		return OVAL_RESULT_ERROR;
+	}
+	/* Most of the collected EVR strings are short, don't allocate them */
+	len = strlen(sys);
+	if (len < sizeof(buffer)) {
+		memcpy(buffer, sys, len + 1);
+		parseEVR(buffer, &sys_evr.epoch, &sys_evr.version, &sys_evr.release);
+	} else {
+		oval_evr_string_parse(sys, &sys_evr);
+	}
+	if (sys_evr.epoch == NULL) {
+		oscap_seterr(OSCAP_EFAMILY_OVAL, "Invalid epoch.");
+		oval_evr_string_clear(&sys_evr);
+		return OVAL_RESULT_ERROR;
+	}
+	if (!debian_epoch(sys_evr.epoch, &a.epoch)) {
+		oval_evr_string_clear(&sys_evr);
+		return OVAL_RESULT_ERROR;
+	}
+	a.version = sys_evr.version;
+	a.revision = sys_evr.release;
+	result = dpkg_version_compare(&a, state);
+
+	oval_evr_string_clear(&sys_evr);
+	return debian_evr_result(result, operation);
 }
 
 oval_result_t oval_versiontype_cmp(const char *state, const char *syschar, oval_operation_t operation)
@@ -36,6 +36,29 @@
 #include "oval_types.h"
 
 
+/**
+ * EVR (Epoch:Version-Release) string split to its parts. The parts point
+ * to the buffer, the epoch and the release are NULL if they are missing.
+ */
+struct oval_evr_string {
+	char *buffer;
+	const char *epoch;
+	const char *version;
+	const char *release;
+};
+
+/*
+ * Code copied from lib/dpkg/version.h
+ */
+struct dpkg_version {
+	/** The epoch. It will be zero if no epoch is present. */
+	unsigned int epoch;
+	/** The upstream part of the version. */
+	const char *version;
+	/** The Debian revision part of the version. */
+	const char *revision;
+};
+
 /**
  * Compare two EVR (Epoch:Version-Release) strings. The format of input types shall
  * conform to EntityStateEVRStringType. Comparisons involving this datatype follow
@@ -47,20 +70,35 @@
  */
 oval_result_t oval_evr_string_cmp(const char *state, const char *sys, oval_operation_t operation);
 
+/**
+ * Split the EVR string to its parts, so it can be compared many times.
+ * The evr has to be cleared by oval_evr_string_clear.
+ */
+void oval_evr_string_parse(const char *text, struct oval_evr_string *evr);
+
+void oval_evr_string_clear(struct oval_evr_string *evr);
+
+/**
+ * Compare the EVR string parsed by oval_evr_string_parse with the EVR string
+ * captured from the system, the same as oval_evr_string_cmp does.
+ */
+oval_result_t oval_evr_string_cmp_parsed(const struct oval_evr_string *state, const char *sys, oval_operation_t operation);
+
 oval_result_t oval_versiontype_cmp(const char *state, const char *syschar, oval_operation_t operation);
 
 oval_result_t oval_debian_evr_string_cmp(const char *state, const char *sys, oval_operation_t operation);
 
-/*
- * Code copied from lib/dpkg/version.h
+/**
+ * Split the Debian EVR string to the version, the evr holds its parts and
+ * has to be cleared by oval_evr_string_clear.
+ * @returns -1 if the epoch is missing or invalid, 0 otherwise
  */
-struct dpkg_version {
-	/** The epoch. It will be zero if no epoch is present. */
-	unsigned int epoch;
-	/** The upstream part of the version. */
-	const char *version;
-	/** The Debian revision part of the version. */
-	const char *revision;
-};
+int oval_debian_evr_string_parse(const char *text, struct oval_evr_string *evr, struct dpkg_version *version);
+
+/**
+ * Compare the version parsed by oval_debian_evr_string_parse with the Debian
+ * EVR string captured from the system, the same as oval_debian_evr_string_cmp does.
+ */
+oval_result_t oval_debian_evr_string_cmp_parsed(const struct dpkg_version *state, const char *sys, oval_operation_t operation);
 
 #endif
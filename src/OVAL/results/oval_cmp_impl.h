@@ -40,5 +40,31 @@
  */
 oval_result_t oval_str_cmp_str(char *state_data, oval_datatype_t state_data_type, const char *sys_data, oval_operation_t operation);
 
+/**
+ * State value pre-parsed according to its data type, so it can be compared
+ * to many values collected from system without parsing it again.
+ */
+struct oval_cmp_operand;
+
+/**
+ * Parse the state value for comparisons with given operation.
+ * @param state_data Value defined within state/entity/value or variable/value,
+ * it isn't copied and has to outlive the operand
+ * @param state_data_type Data type of the value
+ * @param operation Comparison type operation
+ */
+struct oval_cmp_operand *oval_cmp_operand_new(char *state_data, oval_datatype_t state_data_type, oval_operation_t operation);
+
+/**
+ * Compare the state value to data collected from system. The result,
+ * warnings and errors are the same as those of oval_str_cmp_str().
+ * @param operand Parsed state value
+ * @param sys_data Value collected from system
+ * @returns OVAL Result of comparison
+ */
+oval_result_t oval_cmp_operand_cmp(const struct oval_cmp_operand *operand, const char *sys_data);
+
+void oval_cmp_operand_free(struct oval_cmp_operand *operand);
+
 
 #endif
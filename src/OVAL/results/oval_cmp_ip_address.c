@@ -55,6 +55,9 @@
 #include "common/debug_priv.h"
 #include "oval_cmp_ip_address_impl.h"
 
+#define IPADDR_EINVAL  -1 /* the address is invalid */
+#define IPADDR_EPREFIX -2 /* the prefix or the netmask is invalid */
+
 static inline void ipv4addr_mask(struct in_addr *ip_addr, uint32_t netmask);
 static inline void ipv6addr_mask(struct in6_addr *addr, int prefix_len);
 static inline int ipv4addr_parse(const char *oval_ipv4_string, uint32_t *netmask_out, struct in_addr *ip_out);
@@ -82,7 +85,8 @@ static inline void ipaddr_mask(int af, const void *ip_addr, uint32_t mask)
 
 }
 
-static inline int ipaddr_parse(int af, const char *oval_ip_string, uint32_t *mask_out, void * ip_out)
+/* Parse the address without warnings, returns IPADDR_EINVAL or IPADDR_EPREFIX on failure */
+static inline int ipaddr_parse_quiet(int af, const char *oval_ip_string, uint32_t *mask_out, void * ip_out)
 {
 	if (af == AF_INET)
 		return ipv4addr_parse(oval_ip_string, mask_out, ip_out);
@@ -90,16 +94,50 @@ static inline int ipaddr_parse(int af, const char *oval_ip_string, uint32_t *mas
 	return ipv6addr_parse(oval_ip_string, mask_out, ip_out);
 }
 
+static inline int ipaddr_parse(int af, const char *oval_ip_string, uint32_t *mask_out, void * ip_out)
+{
+	switch (ipaddr_parse_quiet(af, oval_ip_string, mask_out, ip_out)) {
+	case 0:
+		return 0;
+	case IPADDR_EPREFIX:
+		dW("Invalid prefix or netmask.");
+		return -1;
+	default:
+		dW("inet_pton() failed.");
+		return -1;
+	}
+}
+
+int oval_ipaddr_parse(int af, const char *text, struct oval_ipaddr *ipaddr)
+{
+	ipaddr->af = af;
+	ipaddr->mask = 0;
+	return ipaddr_parse_quiet(af, text, &ipaddr->mask, ipaddr->addr) == 0 ? 0 : -1;
+}
+
 oval_result_t oval_ipaddr_cmp(int af, const char *s1, const char *s2, oval_operation_t op)
+{
+	struct oval_ipaddr ipaddr1 = { .af = af, .mask = 0 };
+
+	if (ipaddr_parse(af, s1, &ipaddr1.mask, ipaddr1.addr)) {
+		return OVAL_RESULT_ERROR;
+	}
+	return oval_ipaddr_cmp_parsed(&ipaddr1, s2, op);
+}
+
+oval_result_t oval_ipaddr_cmp_parsed(const struct oval_ipaddr *ipaddr1, const char *s2, oval_operation_t op)
 {
 	oval_result_t result = OVAL_RESULT_ERROR;
-	uint32_t mask1 = 0, mask2 = 0;
-	char addr1[INET6_ADDRSTRLEN];
-	char addr2[INET6_ADDRSTRLEN];
+	int af = ipaddr1->af;
+	uint32_t mask1 = ipaddr1->mask, mask2 = 0;
+	uint32_t addr1[4];
+	uint32_t addr2[4];
 
-	if (ipaddr_parse(af, s1, &mask1, &addr1) || ipaddr_parse(af, s2, &mask2, &addr2)) {
+	if (ipaddr_parse(af, s2, &mask2, &addr2)) {
 		return result;
 	}
+	/* The state address is masked in place by some of the operations */
+	memcpy(addr1, ipaddr1->addr, sizeof(addr1));
 
 	switch (op) {
 	case OVAL_OPERATION_EQUALS:
@@ -207,7 +245,7 @@ oval_result_t oval_ipaddr_cmp(int af, const char *s1, const char *s2, oval_opera
 static inline int ipv4addr_parse(const char *oval_ipv4_string, uint32_t *netmask_out, struct in_addr *ip_out)
 {
 	char *s, *pfx;
-	int result = -1;
+	int result = IPADDR_EINVAL;
 
 	s = strdup(oval_ipv4_string);
 	pfx = strchr(s, '/');
@@ -222,17 +260,14 @@ static inline int ipv4addr_parse(const char *oval_ipv4_string, uint32_t *netmask
 		} else if (cnt == 1 && nm[0] <= 32) { /* prefix */
 			*netmask_out = (~0u) << (32u - nm[0]);
 		} else {
-			dW("Invalid prefix or netmask.");
 			free(s);
-			return -1;
+			return IPADDR_EPREFIX;
 		}
 	} else {
 		*netmask_out = ~0;
 	}
 
-	if (inet_pton(AF_INET, s, ip_out) <= 0)
-		dW("inet_pton() failed.");
-	else
+	if (inet_pton(AF_INET, s, ip_out) > 0)
 		result = 0;
 
 	free(s);
@@ -247,7 +282,7 @@ static inline void ipv4addr_mask(struct in_addr *ip_addr, uint32_t netmask)
 static inline int ipv6addr_parse(const char *oval_ipv6_string, uint32_t *len_out, struct in6_addr *ip_out)
 {
 	char *s, *pfx;
-	int result = -1;
+	int result = IPADDR_EINVAL;
 
 	s = strdup(oval_ipv6_string);
 	pfx = strchr(s, '/');
@@ -258,9 +293,7 @@ static inline int ipv6addr_parse(const char *oval_ipv6_string, uint32_t *len_out
 		*len_out = 128;
 	}
 
-	if (inet_pton(AF_INET6, s, ip_out) <= 0)
-		dW("inet_pton() failed.");
-	else
+	if (inet_pton(AF_INET6, s, ip_out) > 0)
 		result = 0;
 
 	free(s);
@@ -31,6 +31,8 @@
 #ifndef OSCAP_OVAL_IP_ADDRESS_IMPL_H_
 #define OSCAP_OVAL_IP_ADDRESS_IMPL_H_
 
+#include <stdint.h>
+
 #include "common/util.h"
 
 #include "oval_definitions.h"
@@ -49,5 +51,26 @@
  */
 oval_result_t oval_ipaddr_cmp(int af, const char *s1, const char *s2, oval_operation_t op);
 
+/**
+ * IP address or address set (CIDR) parsed by oval_ipaddr_parse
+ */
+struct oval_ipaddr {
+	int af;             ///< Internet address family (AF_INET or AF_INET6)
+	uint32_t mask;      ///< netmask (IPv4) or prefix length (IPv6)
+	uint32_t addr[4];   ///< struct in_addr or struct in6_addr
+};
+
+/**
+ * Parse the IP address defined by state element, so it can be compared many times.
+ * @returns 0 on success, -1 if the address is invalid
+ */
+int oval_ipaddr_parse(int af, const char *text, struct oval_ipaddr *ipaddr);
+
+/**
+ * Compare the IP address parsed by oval_ipaddr_parse with the address captured
+ * from system, the same as oval_ipaddr_cmp does.
+ */
+oval_result_t oval_ipaddr_cmp_parsed(const struct oval_ipaddr *ipaddr1, const char *s2, oval_operation_t op);
+
 
 #endif
@@ -50,6 +50,7 @@
 #include "common/debug_priv.h"
 #include "common/_error.h"
 #include "common/elements.h"
+#include "common/xml_stream.h"
 #include "oscap_source.h"
 #include "source/oscap_source_priv.h"
 
@@ -209,11 +210,11 @@ int oval_results_model_import_source(struct oval_results_model *model, struct os
 	context.user_data = NULL;
 	oscap_setxmlerr(xmlGetLastError());
 	/* jump into document */
-	xmlTextReaderRead(context.reader);
+	xmlTextReaderNextNode(context.reader);
 	/* make sure these are results */
 	tagname = (char *)xmlTextReaderLocalName(context.reader);
 	namespace = (char *)xmlTextReaderNamespaceUri(context.reader);
-	int is_ovalres = strcmp((const char *)OVAL_RESULTS_NAMESPACE, namespace) == 0;
+	int is_ovalres = oscap_strcmp((const char *)OVAL_RESULTS_NAMESPACE, namespace) == 0;
 	/* star parsing */
 	if (is_ovalres && (strcmp(tagname, OVAL_ROOT_ELM_RESULTS) == 0)) {
 		ret = oval_results_model_parse(context.reader, &context);
@@ -224,7 +225,9 @@ int oval_results_model_import_source(struct oval_results_model *model, struct os
 
         free(tagname);
         free(namespace);
-	xmlFreeTextReader(context.reader);
+	if (oscap_source_free_xmlTextReader(context.reader) != 0) {
+		ret = -1;
+	}
 	return ret;
 }
 
@@ -247,6 +250,29 @@ int oval_results_model_eval(struct oval_results_model *res_model)
 	return 0;
 }
 
+static bool oval_definition_model_has_record_states(struct oval_definition_model *definition_model)
+{
+	bool found = false;
+	struct oval_state_iterator *states = oval_definition_model_get_states(definition_model);
+
+	while (!found && oval_state_iterator_has_more(states)) {
+		struct oval_state *state = oval_state_iterator_next(states);
+		struct oval_state_content_iterator *contents = oval_state_get_contents(state);
+
+		while (!found && oval_state_content_iterator_has_more(contents)) {
+			struct oval_state_content *content = oval_state_content_iterator_next(contents);
+			struct oval_record_field_iterator *fields = oval_state_content_get_record_fields(content);
+
+			found = oval_record_field_iterator_has_more(fields);
+			oval_record_field_iterator_free(fields);
+		}
+		oval_state_content_iterator_free(contents);
+	}
+	oval_state_iterator_free(states);
+
+	return found;
+}
+
 static xmlNode *oval_results_to_dom(struct oval_results_model *results_model,
 				    struct oval_directives_model *directives_model, 
 				    xmlDocPtr doc, xmlNode * parent)
@@ -269,19 +295,25 @@ static xmlNode *oval_results_to_dom(struct oval_results_model *results_model,
 	xmlSetNs(root_node, ns_common);
 	xmlSetNs(root_node, ns_results);
 
+	dirs_model = (directives_model) ? directives_model : results_model->directives_model;
+	dirs = oval_directives_model_get_defdirs(dirs_model);
+	struct oval_definition_model *definition_model = oval_results_model_get_definition_model(results_model);
+
+	/* The record fields of states use the oval-def prefix declared on the root
+	 * element, it has to exist before the root is written by oscap_xml_stream_flush() */
+	if (parent == NULL && oval_result_directives_get_included(dirs)
+	    && oval_definition_model_has_record_states(definition_model))
+		xmlNewNs(root_node, OVAL_DEFINITIONS_NAMESPACE, BAD_CAST "oval-def");
+
 	/* Report generator */
 	oval_generator_to_dom(results_model->generator, doc, root_node);
 
 	/* Report default directives and class directives from internal or external
 	 * directives model(if provided) */
-	dirs_model = (directives_model) ? directives_model : results_model->directives_model;
 	oval_directives_model_to_dom(dirs_model, doc, root_node);
 
-	dirs = oval_directives_model_get_defdirs(dirs_model);
-
 	/* Report definitions */
 	if(oval_result_directives_get_included(dirs)) {
-		struct oval_definition_model *definition_model = oval_results_model_get_definition_model(results_model);
 		oval_definition_model_to_dom(definition_model, doc, root_node);
 	}
 
@@ -296,6 +328,16 @@ static xmlNode *oval_results_to_dom(struct oval_results_model *results_model,
 	return root_node;
 }
 
+void oval_results_model_walk_export(struct oval_results_model *results_model, const struct oval_result_export_walker *walker)
+{
+	struct oval_result_system_iterator *systems = oval_results_model_get_systems(results_model);
+	while (oval_result_system_iterator_has_more(systems)) {
+		struct oval_result_system *sys = oval_result_system_iterator_next(systems);
+		oval_result_system_walk_export(sys, results_model, results_model->directives_model, walker);
+	}
+	oval_result_system_iterator_free(systems);
+}
+
 struct oscap_source *oval_results_model_export_source(struct oval_results_model *results_model, struct oval_directives_model *directives_model, const char *name)
 {
 	__attribute__nonnull__(results_model);
@@ -314,20 +356,30 @@ int oval_results_model_export(struct oval_results_model *results_model,
 			      struct oval_directives_model *directives_model,
 			      const char *file)
 {
-	struct oscap_source *source = oval_results_model_export_source(results_model, directives_model, file);
-	if (source == NULL) {
+	__attribute__nonnull__(results_model);
+
+	xmlDocPtr doc = xmlNewDoc(BAD_CAST "1.0");
+	if (doc == NULL) {
+		oscap_setxmlerr(xmlGetLastError());
 		return -1;
 	}
-	int ret = oscap_source_save_as(source, NULL);
-	oscap_source_free(source);
-	return ret;
+	if (!oscap_xml_stream_open(doc, file)) {
+		xmlFreeDoc(doc);
+		return -1;
+	}
+
+	oval_results_to_dom(results_model, directives_model, doc, NULL);
+	int ret = oscap_xml_stream_close(doc);
+	xmlFreeDoc(doc);
+	return ret == 1 ? 0 : -1;
 }
 
 int oval_results_model_parse(xmlTextReaderPtr reader, struct oval_parser_context *context) {
         int depth = xmlTextReaderDepth(reader);
         int ret = 0;
 
-        xmlTextReaderRead(reader);
+        if (xmlTextReaderNextNode(reader) != 1)
+                return -1;
         while ((xmlTextReaderDepth(reader) > depth) && (ret != -1 )) {
                 if (xmlTextReaderNodeType(reader) == XML_READER_TYPE_ELEMENT) {
                         char *tagname = (char *)xmlTextReaderLocalName(reader);
@@ -360,13 +412,13 @@ int oval_results_model_parse(xmlTextReaderPtr reader, struct oval_parser_context
                                 ret = oval_parser_parse_tag(reader, context, &oval_result_system_parse_tag , NULL);
                         } else {
                                 dW("Unprocessed tag: <%s:%s>.", namespace, tagname);
-                                oval_parser_skip_tag(reader, context);
+                                ret = oval_parser_skip_tag(reader, context);
                         }
 
                         free(tagname);
                         free(namespace);
                 } else {
-                        if (xmlTextReaderRead(reader) != 1) {
+                        if (xmlTextReaderNextNode(reader) != 1) {
                                 ret = -1;
                                 break;
                         }
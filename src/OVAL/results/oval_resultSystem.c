@@ -51,6 +51,7 @@
 #include "common/_error.h"
 #include "common/util.h"
 #include "common/list.h"
+#include "common/xml_stream.h"
 
 typedef struct oval_result_system {
 	struct oval_results_model *model;
@@ -410,17 +411,18 @@ cleanup:
 	return rslt_definition;
 }
 
-static void _oval_result_definition_to_dom_based_on_directives(struct oval_result_definition *rslt_definition,
+typedef void (*oval_result_definition_consumer)(struct oval_result_definition *, oval_result_directive_content_t, void *);
+
+static void _oval_result_definition_walk_based_on_directives(struct oval_result_definition *rslt_definition,
 						   struct oval_result_directives * directives,
-						   xmlDocPtr doc,
-						   xmlNode *definitions_node,
-						   struct oval_smc *tstmap)
+						   struct oval_smc *tstmap,
+						   oval_result_definition_consumer consumer, void *user_arg)
 {
 	oval_result_t result = oval_result_definition_get_result(rslt_definition);
 	if (oval_result_directives_get_reported(directives, result)) {
 		oval_result_directive_content_t content = oval_result_directives_get_content(directives, result);
 		/* report definition according to directives settings */
-		oval_result_definition_to_dom(rslt_definition, content, doc, definitions_node);
+		consumer(rslt_definition, content, user_arg);
 		if (content == OVAL_DIRECTIVE_CONTENT_FULL) {
 			struct oval_result_criteria_node *criteria = oval_result_definition_get_criteria(rslt_definition);
 			/* collect the tests that are referenced from reported definitions */
@@ -432,15 +434,108 @@ static void _oval_result_definition_to_dom_based_on_directives(struct oval_resul
 	}
 }
 
+/* Pass the definitions which are reported according to directives to the consumer
+ * and collect the tests they reference. */
+static void _oval_result_system_walk_definitions(struct oval_result_system *sys,
+						 struct oval_results_model *results_model,
+						 struct oval_directives_model *directives_model,
+						 struct oval_smc *tstmap,
+						 oval_result_definition_consumer consumer, void *user_arg)
+{
+	struct oval_result_directives * directives;
+	struct oval_result_directives * class_dirs;
+	struct oval_result_directives * def_dirs = oval_directives_model_get_defdirs(directives_model);
+
+	struct oval_definition_model *definition_model = oval_results_model_get_definition_model(results_model);
+	struct oval_definition_iterator *oval_definitions = oval_definition_model_get_definitions(definition_model);
+	while(oval_definition_iterator_has_more(oval_definitions)) {
+		struct oval_definition *oval_definition = oval_definition_iterator_next(oval_definitions);
+
+		oval_definition_class_t def_class = oval_definition_get_class(oval_definition);
+		class_dirs = oval_directives_model_get_classdir(directives_model, def_class);
+		directives = class_dirs ? class_dirs : def_dirs;
+
+		bool exported = false;
+		struct oval_iterator *rslt_definitions_it = oval_smc_get_all_it(sys->definitions, oval_definition_get_id(oval_definition));
+		if (rslt_definitions_it != NULL) {
+			while (oval_collection_iterator_has_more(rslt_definitions_it)) {
+				struct oval_result_definition *rslt_definition = oval_collection_iterator_next(rslt_definitions_it);
+				_oval_result_definition_walk_based_on_directives(rslt_definition, directives, tstmap, consumer, user_arg);
+				exported = true;
+			}
+			oval_collection_iterator_free(rslt_definitions_it);
+		}
+		if (!exported) {
+			struct oval_result_definition *rslt_definition = oval_result_system_get_new_definition(sys, oval_definition, 1);
+			if (rslt_definition) {
+				_oval_result_definition_walk_based_on_directives(rslt_definition, directives, tstmap, consumer, user_arg);
+			}
+		}
+	}
+	oval_definition_iterator_free(oval_definitions);
+}
+
+/* Collect the objects, states and variables referenced from the reported test */
+static void _oval_result_system_scan_test_for_references(struct oval_syschar_model *syschar_model,
+							 struct oval_result_test *result_test,
+							 struct oval_string_map *objmap,
+							 struct oval_string_map *sttmap,
+							 struct oval_string_map *varmap,
+							 struct oval_string_map *sysmap)
+{
+	struct oval_state_iterator *ste_itr;
+	struct oval_test *oval_test = oval_result_test_get_test(result_test);
+	/* look for objects in path: test->object ...  */
+	struct oval_object *object = oval_test_get_object(oval_test);
+	if (object) {
+		char *objid = oval_object_get_id(object);
+		/* is object already "collected" */
+		void *value = oval_string_map_get_value(objmap, objid);
+		if (value == NULL) {
+			/* is there a system characteristic for the object */
+			struct oval_syschar *syschar =
+			    oval_syschar_model_get_syschar(syschar_model, objid);
+			if (syschar) {
+				/* put object into map */
+				oval_string_map_put(objmap, objid, object);
+				_oval_result_system_scan_object_for_references
+				    (syschar_model, object, objmap, sttmap, varmap, sysmap);
+			}
+		}
+	}
+	/* look for objects in test->state->... */
+	ste_itr = oval_test_get_states(oval_test);
+	while (oval_state_iterator_has_more(ste_itr)) {
+		struct oval_state *state = oval_state_iterator_next(ste_itr);
+		char *sttid = oval_state_get_id(state);
+		void *value = oval_string_map_get_value(sttmap, sttid);
+		if (value == NULL) {
+			oval_string_map_put(sttmap, sttid, state);
+			_oval_result_system_scan_state_for_references(syschar_model, state, objmap, sttmap,
+								      varmap, sysmap);
+		}
+	}
+	oval_state_iterator_free(ste_itr);
+}
+
+struct oval_result_system_dom_ctx {
+	xmlDocPtr doc;
+	xmlNode *definitions_node;
+};
+
+static void _oval_result_system_definition_to_dom(struct oval_result_definition *rslt_definition,
+						  oval_result_directive_content_t content, void *user_arg)
+{
+	struct oval_result_system_dom_ctx *ctx = user_arg;
+	oval_result_definition_to_dom(rslt_definition, content, ctx->doc, ctx->definitions_node);
+	oscap_xml_stream_flush(ctx->doc, ctx->definitions_node);
+}
+
 xmlNode *oval_result_system_to_dom(struct oval_result_system * sys,
 				   struct oval_results_model * results_model,
 				   struct oval_directives_model * directives_model, 
 				   xmlDocPtr doc, xmlNode * parent) {
 
-	struct oval_result_directives * directives;
-	struct oval_result_directives * class_dirs;
-	struct oval_result_directives * def_dirs = oval_directives_model_get_defdirs(directives_model);
-
 	xmlNs *ns_results = xmlSearchNsByHref(doc, parent, OVAL_RESULTS_NAMESPACE);
 	xmlNode *system_node = xmlNewTextChild(parent, ns_results, BAD_CAST "system", NULL);
 
@@ -449,31 +544,12 @@ xmlNode *oval_result_system_to_dom(struct oval_result_system * sys,
 	struct oval_definition_model *definition_model = oval_results_model_get_definition_model(results_model);
 	struct oval_definition_iterator *oval_definitions = oval_definition_model_get_definitions(definition_model);
 	if(oval_definition_iterator_has_more(oval_definitions)) {
-		xmlNode *definitions_node = xmlNewTextChild(system_node, ns_results, BAD_CAST "definitions", NULL);
-		while(oval_definition_iterator_has_more(oval_definitions)) {
-			struct oval_definition *oval_definition = oval_definition_iterator_next(oval_definitions);
-
-			oval_definition_class_t def_class = oval_definition_get_class(oval_definition);
-			class_dirs = oval_directives_model_get_classdir(directives_model, def_class);
-			directives = class_dirs ? class_dirs : def_dirs;
-
-			bool exported = false;
-			struct oval_iterator *rslt_definitions_it = oval_smc_get_all_it(sys->definitions, oval_definition_get_id(oval_definition));
-			if (rslt_definitions_it != NULL) {
-				while (oval_collection_iterator_has_more(rslt_definitions_it)) {
-					struct oval_result_definition *rslt_definition = oval_collection_iterator_next(rslt_definitions_it);
-					_oval_result_definition_to_dom_based_on_directives(rslt_definition, directives, doc, definitions_node, tstmap);
-					exported = true;
-				}
-				oval_collection_iterator_free(rslt_definitions_it);
-			}
-			if (!exported) {
-				struct oval_result_definition *rslt_definition = oval_result_system_get_new_definition(sys, oval_definition, 1);
-				if (rslt_definition) {
-					_oval_result_definition_to_dom_based_on_directives(rslt_definition, directives, doc, definitions_node, tstmap);
-				}
-			}
-		}
+		struct oval_result_system_dom_ctx ctx = {
+			.doc = doc,
+			.definitions_node = xmlNewTextChild(system_node, ns_results, BAD_CAST "definitions", NULL),
+		};
+		_oval_result_system_walk_definitions(sys, results_model, directives_model, tstmap,
+						     _oval_result_system_definition_to_dom, &ctx);
 	}
 	oval_definition_iterator_free(oval_definitions);
 
@@ -487,43 +563,12 @@ xmlNode *oval_result_system_to_dom(struct oval_result_system * sys,
 	if (oval_smc_iterator_has_more(result_tests)) {
 		xmlNode *tests_node = xmlNewTextChild(system_node, ns_results, BAD_CAST "tests", NULL);
 		while (oval_smc_iterator_has_more(result_tests)) {
-			struct oval_state_iterator *ste_itr;
 			struct oval_result_test *result_test = oval_smc_iterator_next(result_tests);
 			/* report the test */
 			oval_result_test_to_dom(result_test, doc, tests_node);
-			struct oval_test *oval_test = oval_result_test_get_test(result_test);
-			/* collect the objects that are referenced from reported test */
-			/* look for objects in path: test->object ...  */
-			struct oval_object *object = oval_test_get_object(oval_test);
-			if (object) {
-				char *objid = oval_object_get_id(object);
-				/* is object already "collected" */
-				void *value = oval_string_map_get_value(objmap, objid);
-				if (value == NULL) {
-					/* is there a system characteristic for the object */
-					struct oval_syschar *syschar =
-					    oval_syschar_model_get_syschar(syschar_model, objid);
-					if (syschar) {
-						/* put object into map */
-						oval_string_map_put(objmap, objid, object);
-						_oval_result_system_scan_object_for_references
-						    (syschar_model, object, objmap, sttmap, varmap, sysmap);
-					}
-				}
-			}
-			/* look for objects in test->state->... */
-			ste_itr = oval_test_get_states(oval_test);
-			while (oval_state_iterator_has_more(ste_itr)) {
-				struct oval_state *state = oval_state_iterator_next(ste_itr);
-				char *sttid = oval_state_get_id(state);
-				void *value = oval_string_map_get_value(sttmap, sttid);
-				if (value == NULL) {
-					oval_string_map_put(sttmap, sttid, state);
-					_oval_result_system_scan_state_for_references(syschar_model, state, objmap, sttmap,
-										      varmap, sysmap);
-				}
-			}
-			oval_state_iterator_free(ste_itr);
+			oscap_xml_stream_flush(doc, tests_node);
+			_oval_result_system_scan_test_for_references(syschar_model, result_test,
+								     objmap, sttmap, varmap, sysmap);
 		}
 	}
 	oval_smc_iterator_free(result_tests);
@@ -541,6 +586,51 @@ xmlNode *oval_result_system_to_dom(struct oval_result_system * sys,
 	return system_node;
 }
 
+void oval_result_system_walk_export(struct oval_result_system *sys,
+				    struct oval_results_model *results_model,
+				    struct oval_directives_model *directives_model,
+				    const struct oval_result_export_walker *walker)
+{
+	struct oval_smc *tstmap = oval_smc_new();
+	_oval_result_system_walk_definitions(sys, results_model, directives_model, tstmap,
+					     walker->definition, walker->user_arg);
+
+	struct oval_syschar_model *syschar_model = oval_result_system_get_syschar_model(sys);
+	struct oval_string_map *sysmap = oval_string_map_new();
+	struct oval_string_map *objmap = oval_string_map_new();
+	struct oval_string_map *sttmap = oval_string_map_new();
+	struct oval_string_map *varmap = oval_string_map_new();
+
+	struct oval_smc_iterator *result_tests = oval_smc_iterator_new(tstmap);
+	while (oval_smc_iterator_has_more(result_tests)) {
+		struct oval_result_test *result_test = oval_smc_iterator_next(result_tests);
+		walker->test(result_test, walker->user_arg);
+		_oval_result_system_scan_test_for_references(syschar_model, result_test,
+							     objmap, sttmap, varmap, sysmap);
+	}
+	oval_smc_iterator_free(result_tests);
+
+	/* the same selection of collected objects as in oval_syschar_model_to_dom() */
+	if (oval_results_model_get_export_system_characteristics(results_model)) {
+		struct oval_syschar_iterator *syschars = oval_syschar_model_get_syschars(syschar_model);
+		while (oval_syschar_iterator_has_more(syschars)) {
+			struct oval_syschar *syschar = oval_syschar_iterator_next(syschars);
+			if (!_oval_result_system_resolve_syschar(syschar, sysmap)
+			    || oval_syschar_get_flag(syschar) == SYSCHAR_FLAG_UNKNOWN
+			    || oval_object_get_base_obj(oval_syschar_get_object(syschar)))
+				continue;
+			walker->syschar(syschar, walker->user_arg);
+		}
+		oval_syschar_iterator_free(syschars);
+	}
+
+	oval_string_map_free(sysmap, NULL);
+	oval_string_map_free(objmap, NULL);
+	oval_string_map_free(sttmap, NULL);
+	oval_string_map_free(varmap, NULL);
+	oval_smc_free0(tstmap);
+}
+
 
 
 
@@ -509,138 +509,349 @@ static oval_result_t _evaluate_sysent_record(struct oval_syschar_model *syschar_
 	return ores_get_result_byopr(&record_ores, OVAL_OPERATOR_AND);
 }
 
-static inline oval_result_t _evaluate_sysent(struct oval_syschar_model *syschar_model, struct oval_sysent *item_entity, struct oval_entity *state_entity, oval_operation_t state_entity_operation, struct oval_state_content *content)
+/*
+ * The states of a test are compiled once to matchers, which are then applied
+ * to each of the collected items. The entities of a matcher hold the resolved
+ * names of the item entities and the state values parsed according to their
+ * datatypes, so they aren't looked up and parsed again for every item.
+ */
+typedef enum {
+	ENTITY_MATCHER_INVALID,         ///< the state content is invalid, the evaluation fails
+	ENTITY_MATCHER_VALUE,           ///< compared to the parsed value of the state entity
+	ENTITY_MATCHER_VARIABLE,        ///< compared to the values of the variable
+	ENTITY_MATCHER_RECORD,          ///< compared field by field
+	ENTITY_MATCHER_NO_VALUE         ///< the value is missing, the comparison fails
+} oval_entity_matcher_type_t;
+
+struct oval_entity_matcher {
+	oval_entity_matcher_type_t type;
+	const char *error;              ///< error of invalid content or of missing value
+	struct oval_state_content *content;
+	const char *name;               ///< name of the item entities to compare
+	oval_check_t entity_check;
+	oval_existence_t check_existence;
+	oval_operation_t operation;
+	bool mask;
+	struct oval_cmp_operand *operand;
+	struct oval_variable *variable;
+	oval_check_t var_check;
+	bool var_parsed;                ///< the values of the variable are parsed on the first use
+	bool var_null_value;            ///< a value of the variable is missing its text
+	size_t var_count;
+	char **var_texts;
+	struct oval_cmp_operand **var_operands;
+	unsigned int layout;            ///< layout of the item entities the indexes were resolved for
+	size_t index_count;
+	size_t *indexes;                ///< indexes of the item entities with the name
+};
+
+struct oval_state_matcher {
+	struct oval_state *state;
+	oval_operator_t operator;
+	size_t count;
+	struct oval_entity_matcher *entities;
+};
+
+/*
+ * Entities of a collected item with their status counted once for all states.
+ * The items of a test usually have the same entity names in the same order,
+ * the layout changes only when the names differ from the previous item.
+ */
+struct oval_item_sysents {
+	struct oval_sysent **sysents;
+	const char **names;             ///< names of the entities of the last layout
+	size_t count;
+	size_t names_count;
+	size_t capacity;
+	unsigned int layout;
+	bool null_sysent;
+	struct oval_status_counter counter;
+};
+
+static bool _oval_entity_matcher_init(struct oval_entity_matcher *matcher, struct oval_state *state, struct oval_state_content *content)
 {
-	if (oval_sysent_get_status(item_entity) == SYSCHAR_STATUS_DOES_NOT_EXIST) {
-		return OVAL_RESULT_FALSE;
-	} else if (oval_entity_get_varref_type(state_entity) == OVAL_ENTITY_VARREF_ATTRIBUTE) {
-		struct oval_variable *state_entity_var;
-		if ((state_entity_var = oval_entity_get_variable(state_entity)) == NULL) {
-			oscap_seterr(OSCAP_EFAMILY_OVAL, "OVAL internal error: found NULL variable");
-			return -1;
+	struct oval_entity *state_entity;
+	char *state_entity_name;
+
+	memset(matcher, 0, sizeof(*matcher));
+	matcher->type = ENTITY_MATCHER_INVALID;
+	if (content == NULL) {
+		matcher->error = "OVAL internal error: found NULL state content";
+		return false;
+	}
+	if ((state_entity = oval_state_content_get_entity(content)) == NULL) {
+		matcher->error = "OVAL internal error: found NULL entity";
+		return false;
+	}
+	if ((state_entity_name = oval_entity_get_name(state_entity)) == NULL) {
+		matcher->error = "OVAL internal error: found NULL entity name";
+		return false;
+	}
+
+	if (oscap_streq(state_entity_name, "line") &&
+		oval_state_get_subtype(state) == (oval_subtype_t) OVAL_INDEPENDENT_TEXT_FILE_CONTENT) {
+		/* Hack: textfilecontent_state/line shall be compared against textfilecontent_item/text.
+		 *
+		 * textfilecontent_test and textfilecontent54_test share the same syschar
+		 * (textfilecontent_item). In OVAL 5.3 and below this syschar did not hold any usable
+		 * information ('text' ent). In OVAL 5.4 textfilecontent_test was deprecated. But the
+		 * 'text' ent has been added to textfilecontent_item, making it potentially usable. */
+		oval_schema_version_t over = oval_state_get_platform_schema_version(state);
+		if (oval_schema_version_cmp(over, OVAL_SCHEMA_VERSION(5.4)) >= 0) {
+			/* The OVAL-5.3 does not have textfilecontent_item/text */
+			state_entity_name = "text";
 		}
-		const char *sys_data = oval_sysent_get_value(item_entity);
-		oval_check_t var_check = oval_state_content_get_var_check(content);
+	}
 
-		return _evaluate_sysent_with_variable(syschar_model,
-				state_entity_var, sys_data,
-				state_entity_operation, var_check);
+	matcher->content = content;
+	matcher->name = state_entity_name;
+	matcher->entity_check = oval_state_content_get_ent_check(content);
+	matcher->check_existence = oval_state_content_get_check_existence(content);
+	matcher->operation = oval_entity_get_operation(state_entity);
+	matcher->mask = oval_entity_get_mask(state_entity);
+
+	if (oval_entity_get_varref_type(state_entity) == OVAL_ENTITY_VARREF_ATTRIBUTE) {
+		matcher->variable = oval_entity_get_variable(state_entity);
+		if (matcher->variable == NULL) {
+			matcher->type = ENTITY_MATCHER_NO_VALUE;
+			matcher->error = "OVAL internal error: found NULL variable";
+		} else {
+			matcher->type = ENTITY_MATCHER_VARIABLE;
+			matcher->var_check = oval_state_content_get_var_check(content);
+		}
+	} else if (oval_entity_get_datatype(state_entity) == OVAL_DATATYPE_RECORD) {
+		matcher->type = ENTITY_MATCHER_RECORD;
 	} else {
 		struct oval_value *state_entity_val;
 		char *state_entity_val_text;
-		oval_datatype_t state_entity_val_datatype;
 
-		oval_datatype_t state_entity_type = oval_entity_get_datatype(state_entity);
-		if (state_entity_type == OVAL_DATATYPE_RECORD) {
-			if (state_entity_operation != OVAL_OPERATION_EQUALS) {
-				dE("The only allowed operation for comparing record types is 'equals'.");
-				return OVAL_RESULT_ERROR;
-			}
-			return _evaluate_sysent_record(syschar_model, content, item_entity);
+		matcher->type = ENTITY_MATCHER_NO_VALUE;
+		if ((state_entity_val = oval_entity_get_value(state_entity)) == NULL) {
+			matcher->error = "OVAL internal error: found NULL entity value";
+		} else if ((state_entity_val_text = oval_value_get_text(state_entity_val)) == NULL) {
+			matcher->error = "OVAL internal error: found NULL entity value text";
 		} else {
-			if ((state_entity_val = oval_entity_get_value(state_entity)) == NULL) {
-				oscap_seterr(OSCAP_EFAMILY_OVAL, "OVAL internal error: found NULL entity value");
-				return -1;
-			}
-			if ((state_entity_val_text = oval_value_get_text(state_entity_val)) == NULL) {
-				oscap_seterr(OSCAP_EFAMILY_OVAL, "OVAL internal error: found NULL entity value text");
-				return -1;
+			matcher->type = ENTITY_MATCHER_VALUE;
+			matcher->operand = oval_cmp_operand_new(state_entity_val_text,
+					oval_value_get_datatype(state_entity_val), matcher->operation);
+		}
+	}
+	return true;
+}
+
+static void _oval_entity_matcher_clear(struct oval_entity_matcher *matcher)
+{
+	oval_cmp_operand_free(matcher->operand);
+	for (size_t i = 0; i < matcher->var_count; i++)
+		oval_cmp_operand_free(matcher->var_operands[i]);
+	free(matcher->var_operands);
+	free(matcher->var_texts);
+	free(matcher->indexes);
+}
+
+/* Find the item entities compared by the matcher, once per layout of the items */
+static void _oval_entity_matcher_resolve(struct oval_entity_matcher *matcher, const struct oval_item_sysents *item_sysents)
+{
+	matcher->indexes = realloc(matcher->indexes, (item_sysents->count + 1) * sizeof(size_t));
+	matcher->index_count = 0;
+	for (size_t i = 0; i < item_sysents->count; i++) {
+		if (strcmp(item_sysents->names[i], matcher->name) == 0)
+			matcher->indexes[matcher->index_count++] = i;
+	}
+	matcher->layout = item_sysents->layout;
+}
+
+static void _oval_entity_matcher_parse_variable(struct oval_entity_matcher *matcher)
+{
+	struct oval_value_iterator *val_itr = oval_variable_get_values(matcher->variable);
+	size_t capacity = 0;
+
+	while (oval_value_iterator_has_more(val_itr)) {
+		struct oval_value *var_val = oval_value_iterator_next(val_itr);
+		char *state_entity_val_text = oval_value_get_text(var_val);
+		if (state_entity_val_text == NULL) {
+			matcher->var_null_value = true;
+			break;
+		}
+		if (matcher->var_count == capacity) {
+			capacity = capacity ? 2 * capacity : 4;
+			matcher->var_texts = realloc(matcher->var_texts, capacity * sizeof(char *));
+			matcher->var_operands = realloc(matcher->var_operands, capacity * sizeof(struct oval_cmp_operand *));
+		}
+		matcher->var_texts[matcher->var_count] = state_entity_val_text;
+		matcher->var_operands[matcher->var_count] = oval_cmp_operand_new(state_entity_val_text,
+				oval_value_get_datatype(var_val), matcher->operation);
+		matcher->var_count++;
+	}
+	oval_value_iterator_free(val_itr);
+	matcher->var_parsed = true;
+}
+
+static oval_result_t _oval_entity_matcher_eval_variable(struct oval_entity_matcher *matcher, struct oval_syschar_model *syschar_model, const char *sys_data)
+{
+	struct oresults var_ores;
+
+	if (0 != oval_syschar_model_compute_variable(syschar_model, matcher->variable)) {
+		return -1;
+	}
+
+	switch (oval_variable_get_collection_flag(matcher->variable)) {
+	case SYSCHAR_FLAG_COMPLETE:
+	case SYSCHAR_FLAG_INCOMPLETE:
+		/* The values don't change once the variable is computed */
+		if (!matcher->var_parsed)
+			_oval_entity_matcher_parse_variable(matcher);
+
+		ores_clear(&var_ores);
+		for (size_t i = 0; i < matcher->var_count; i++) {
+			oval_result_t var_val_res = oval_cmp_operand_cmp(matcher->var_operands[i], sys_data);
+			if (var_val_res == OVAL_RESULT_ERROR) {
+				dW("Can't compare variable '%s' value = '%s' with collected item entity = '%s'",
+					oval_variable_get_id(matcher->variable), matcher->var_texts[i], sys_data);
 			}
-			state_entity_val_datatype = oval_value_get_datatype(state_entity_val);
+			ores_add_res(&var_ores, var_val_res);
+		}
+		if (matcher->var_null_value) {
+			dE("Found NULL variable value text.");
+			ores_add_res(&var_ores, OVAL_RESULT_ERROR);
+		}
+		return ores_get_result_bychk(&var_ores, matcher->var_check);
+	case SYSCHAR_FLAG_ERROR:
+	case SYSCHAR_FLAG_DOES_NOT_EXIST:
+	case SYSCHAR_FLAG_NOT_COLLECTED:
+	case SYSCHAR_FLAG_NOT_APPLICABLE:
+		return OVAL_RESULT_ERROR;
+	default:
+		return -1;
+	}
+}
+
+static oval_result_t _oval_entity_matcher_eval(struct oval_entity_matcher *matcher, struct oval_syschar_model *syschar_model, struct oval_sysent *item_entity)
+{
+	if (oval_sysent_get_status(item_entity) == SYSCHAR_STATUS_DOES_NOT_EXIST)
+		return OVAL_RESULT_FALSE;
 
-			const char *sys_data = oval_sysent_get_value(item_entity);
-			return oval_str_cmp_str(state_entity_val_text, state_entity_val_datatype, sys_data, state_entity_operation);
+	switch (matcher->type) {
+	case ENTITY_MATCHER_VALUE:
+		return oval_cmp_operand_cmp(matcher->operand, oval_sysent_get_value(item_entity));
+	case ENTITY_MATCHER_VARIABLE:
+		return _oval_entity_matcher_eval_variable(matcher, syschar_model, oval_sysent_get_value(item_entity));
+	case ENTITY_MATCHER_RECORD:
+		if (matcher->operation != OVAL_OPERATION_EQUALS) {
+			dE("The only allowed operation for comparing record types is 'equals'.");
+			return OVAL_RESULT_ERROR;
 		}
+		return _evaluate_sysent_record(syschar_model, matcher->content, item_entity);
+	default:
+		oscap_seterr(OSCAP_EFAMILY_OVAL, "%s", matcher->error);
+		return -1;
 	}
 }
 
-static oval_result_t eval_item(struct oval_syschar_model *syschar_model, struct oval_sysitem *cur_sysitem, struct oval_state *state)
+static void _oval_state_matcher_init(struct oval_state_matcher *matcher, struct oval_state *state)
 {
 	struct oval_state_content_iterator *state_contents_itr;
-	struct oresults ste_ores;
-	oval_operator_t operator;
-	oval_result_t result = OVAL_RESULT_ERROR;
+	size_t capacity = 0;
 
-	ores_clear(&ste_ores);
+	matcher->state = state;
+	matcher->operator = oval_state_get_operator(state);
+	matcher->count = 0;
+	matcher->entities = NULL;
 
 	state_contents_itr = oval_state_get_contents(state);
 	while (oval_state_content_iterator_has_more(state_contents_itr)) {
-		struct oval_state_content *content;
-		struct oval_entity *state_entity;
-		char *state_entity_name;
-		oval_operation_t state_entity_operation;
-		oval_check_t entity_check;
-		oval_existence_t check_existence;
-		oval_result_t ste_ent_res;
-		struct oval_sysent_iterator *item_entities_itr;
-		struct oresults ent_ores;
-		struct oval_status_counter counter;
-		bool found_matching_item;
+		if (matcher->count == capacity) {
+			capacity = capacity ? 2 * capacity : 4;
+			matcher->entities = realloc(matcher->entities, capacity * sizeof(struct oval_entity_matcher));
+		}
+		struct oval_state_content *content = oval_state_content_iterator_next(state_contents_itr);
+		/* The contents after an invalid one are never compared */
+		if (!_oval_entity_matcher_init(&matcher->entities[matcher->count++], state, content))
+			break;
+	}
+	oval_state_content_iterator_free(state_contents_itr);
+}
 
-		if ((content = oval_state_content_iterator_next(state_contents_itr)) == NULL) {
-			oscap_seterr(OSCAP_EFAMILY_OVAL, "OVAL internal error: found NULL state content");
-			goto fail;
+static void _oval_state_matcher_clear(struct oval_state_matcher *matcher)
+{
+	for (size_t i = 0; i < matcher->count; i++)
+		_oval_entity_matcher_clear(&matcher->entities[i]);
+	free(matcher->entities);
+}
+
+static void _oval_item_sysents_collect(struct oval_item_sysents *item_sysents, struct oval_sysitem *item)
+{
+	struct oval_sysent_iterator *item_entities_itr;
+	bool changed = false;
+
+	item_sysents->count = 0;
+	item_sysents->null_sysent = false;
+	oval_status_counter_clear(&item_sysents->counter);
+
+	item_entities_itr = oval_sysitem_get_sysents(item);
+	while (oval_sysent_iterator_has_more(item_entities_itr)) {
+		struct oval_sysent *item_entity = oval_sysent_iterator_next(item_entities_itr);
+		if (item_entity == NULL) {
+			item_sysents->null_sysent = true;
+			break;
 		}
-		if ((state_entity = oval_state_content_get_entity(content)) == NULL) {
-			oscap_seterr(OSCAP_EFAMILY_OVAL, "OVAL internal error: found NULL entity");
-			goto fail;
+		if (item_sysents->count == item_sysents->capacity) {
+			item_sysents->capacity = item_sysents->capacity ? 2 * item_sysents->capacity : 16;
+			item_sysents->sysents = realloc(item_sysents->sysents, item_sysents->capacity * sizeof(struct oval_sysent *));
+			item_sysents->names = realloc(item_sysents->names, item_sysents->capacity * sizeof(const char *));
 		}
-		if ((state_entity_name = oval_entity_get_name(state_entity)) == NULL) {
-			oscap_seterr(OSCAP_EFAMILY_OVAL, "OVAL internal error: found NULL entity name");
-			goto fail;
+		const char *name = oval_sysent_get_name(item_entity);
+		if (item_sysents->count >= item_sysents->names_count
+		    || (item_sysents->names[item_sysents->count] != name
+		        && strcmp(item_sysents->names[item_sysents->count], name) != 0)) {
+			changed = true;
 		}
+		/* the names of the previous item are kept until a different one is found */
+		if (changed)
+			item_sysents->names[item_sysents->count] = name;
+		item_sysents->sysents[item_sysents->count++] = item_entity;
+		oval_status_counter_add_status(&item_sysents->counter, oval_sysent_get_status(item_entity));
+	}
+	oval_sysent_iterator_free(item_entities_itr);
 
-		if (oscap_streq(state_entity_name, "line") &&
-			oval_state_get_subtype(state) == (oval_subtype_t) OVAL_INDEPENDENT_TEXT_FILE_CONTENT) {
-			/* Hack: textfilecontent_state/line shall be compared against textfilecontent_item/text.
-			 *
-			 * textfilecontent_test and textfilecontent54_test share the same syschar
-			 * (textfilecontent_item). In OVAL 5.3 and below this syschar did not hold any usable
-			 * information ('text' ent). In OVAL 5.4 textfilecontent_test was deprecated. But the
-			 * 'text' ent has been added to textfilecontent_item, making it potentially usable. */
-			oval_schema_version_t over = oval_state_get_platform_schema_version(state);
-			if (oval_schema_version_cmp(over, OVAL_SCHEMA_VERSION(5.4)) >= 0) {
-				/* The OVAL-5.3 does not have textfilecontent_item/text */
-				state_entity_name = "text";
-			}
-		}
+	if (changed || item_sysents->count != item_sysents->names_count || item_sysents->layout == 0) {
+		item_sysents->names_count = item_sysents->count;
+		item_sysents->layout++;
+	}
+}
 
-		entity_check = oval_state_content_get_ent_check(content);
-		check_existence = oval_state_content_get_check_existence(content);
-		state_entity_operation = oval_entity_get_operation(state_entity);
+static oval_result_t eval_item(struct oval_syschar_model *syschar_model, struct oval_sysitem *cur_sysitem, struct oval_item_sysents *item_sysents, struct oval_state_matcher *matcher)
+{
+	struct oval_state *state = matcher->state;
+	struct oresults ste_ores;
+	oval_result_t result;
 
-		ores_clear(&ent_ores);
-		found_matching_item = false;
-		oval_status_counter_clear(&counter);
+	ores_clear(&ste_ores);
 
-		item_entities_itr = oval_sysitem_get_sysents(cur_sysitem);
-		while (oval_sysent_iterator_has_more(item_entities_itr)) {
-			struct oval_sysent *item_entity;
-			oval_result_t ent_val_res;
-			char *item_entity_name;
-			oval_syschar_status_t item_status;
-
-			item_entity = oval_sysent_iterator_next(item_entities_itr);
-			if (item_entity == NULL) {
-				oscap_seterr(OSCAP_EFAMILY_OVAL, "OVAL internal error: found NULL sysent");
-				oval_sysent_iterator_free(item_entities_itr);
-				goto fail;
-			}
-			item_status = oval_sysent_get_status(item_entity);
-			oval_status_counter_add_status(&counter, item_status);
+	for (size_t i = 0; i < matcher->count; i++) {
+		struct oval_entity_matcher *entity_matcher = &matcher->entities[i];
+		struct oresults ent_ores;
+		bool found_matching_item = false;
 
-			item_entity_name = oval_sysent_get_name(item_entity);
-			if (strcmp(item_entity_name, state_entity_name))
-				continue;
+		if (entity_matcher->type == ENTITY_MATCHER_INVALID) {
+			oscap_seterr(OSCAP_EFAMILY_OVAL, "%s", entity_matcher->error);
+			return OVAL_RESULT_ERROR;
+		}
+
+		ores_clear(&ent_ores);
+		if (entity_matcher->layout != item_sysents->layout)
+			_oval_entity_matcher_resolve(entity_matcher, item_sysents);
+		for (size_t j = 0; j < entity_matcher->index_count; j++) {
+			struct oval_sysent *item_entity = item_sysents->sysents[entity_matcher->indexes[j]];
+			oval_result_t ent_val_res;
 
 			found_matching_item = true;
 
 			/* copy mask attribute from state to item */
-			if (oval_entity_get_mask(state_entity))
+			if (entity_matcher->mask)
 				oval_sysent_set_mask(item_entity,1);
 
-			ent_val_res = _evaluate_sysent(syschar_model, item_entity, state_entity,
-					state_entity_operation, content);
+			ent_val_res = _oval_entity_matcher_eval(entity_matcher, syschar_model, item_entity);
 			if (ent_val_res == OVAL_RESULT_TRUE) {
 				dI("Entity '%s'='%s' of item '%s' matches corresponding entity in state '%s'.",
 						oval_sysent_get_name(item_entity),
@@ -653,42 +864,35 @@ static oval_result_t eval_item(struct oval_syschar_model *syschar_model, struct
 						oval_sysent_get_value(item_entity),
 						oval_sysitem_get_id(cur_sysitem), oval_state_get_id(state));
 			}
-			if (((signed) ent_val_res) == -1) {
-				oval_sysent_iterator_free(item_entities_itr);
-				goto fail;
-			}
+			if (((signed) ent_val_res) == -1)
+				return OVAL_RESULT_ERROR;
 
 			ores_add_res(&ent_ores, ent_val_res);
 		}
-		oval_sysent_iterator_free(item_entities_itr);
+		if (item_sysents->null_sysent) {
+			oscap_seterr(OSCAP_EFAMILY_OVAL, "OVAL internal error: found NULL sysent");
+			return OVAL_RESULT_ERROR;
+		}
 
 		if (!found_matching_item)
 			dW("Entity name '%s' from state (id: '%s') not found in item (id: '%s').",
-			   state_entity_name, oval_state_get_id(state), oval_sysitem_get_id(cur_sysitem));
+			   entity_matcher->name, oval_state_get_id(state), oval_sysitem_get_id(cur_sysitem));
 
-		oval_result_t cres = oval_status_counter_get_result(&counter, check_existence);
+		oval_result_t cres = oval_status_counter_get_result(&item_sysents->counter, entity_matcher->check_existence);
 		/* The entity check results are only relevant when the check existence is satisfied */
 		if (cres == OVAL_RESULT_TRUE) {
-			ste_ent_res = ores_get_result_bychk(&ent_ores, entity_check);
-			ores_add_res(&ste_ores, ste_ent_res);
+			ores_add_res(&ste_ores, ores_get_result_bychk(&ent_ores, entity_matcher->entity_check));
 		} else {
 			ores_add_res(&ste_ores, cres);
 		}
 	}
-	oval_state_content_iterator_free(state_contents_itr);
 
-	operator = oval_state_get_operator(state);
-	result = ores_get_result_byopr(&ste_ores, operator);
+	result = ores_get_result_byopr(&ste_ores, matcher->operator);
 	dI("Item '%s' compared to state '%s' with result %s.",
 			   oval_sysitem_get_id(cur_sysitem), oval_state_get_id(state),
 			   oval_result_get_text(result));
 
 	return result;
-
- fail:
-	oval_state_content_iterator_free(state_contents_itr);
-
-	return OVAL_RESULT_ERROR;
 }
 
 #define ITEMMAP (struct oval_string_map    *)args[2]
@@ -715,6 +919,10 @@ static oval_result_t eval_check_state(struct oval_test *test, void **args)
 	oval_result_t result;
 	oval_check_t ste_check;
 	oval_operator_t ste_opr;
+	struct oval_state_iterator *ste_itr;
+	struct oval_state_matcher *matchers = NULL;
+	size_t matchers_count = 0, matchers_capacity = 0;
+	struct oval_item_sysents item_sysents = { NULL, NULL, 0, 0, 0, 0, false, { 0 } };
 
 	ste_check = oval_test_get_check(test);
 	ste_opr = oval_test_get_state_operator(test);
@@ -728,13 +936,22 @@ static oval_result_t eval_check_state(struct oval_test *test, void **args)
 		free(state_names);
 	}
 
+	ste_itr = oval_test_get_states(test);
+	while (oval_state_iterator_has_more(ste_itr)) {
+		if (matchers_count == matchers_capacity) {
+			matchers_capacity = matchers_capacity ? 2 * matchers_capacity : 4;
+			matchers = realloc(matchers, matchers_capacity * sizeof(struct oval_state_matcher));
+		}
+		_oval_state_matcher_init(&matchers[matchers_count++], oval_state_iterator_next(ste_itr));
+	}
+	oval_state_iterator_free(ste_itr);
+
 	ritems_itr = oval_result_test_get_items(TEST);
 	while (oval_result_item_iterator_has_more(ritems_itr)) {
 		struct oval_result_item *ritem;
 		struct oval_sysitem *item;
 		oval_syschar_status_t item_status;
 		struct oresults ste_ores;
-		struct oval_state_iterator *ste_itr;
 		oval_result_t item_res;
 
 		ritem = oval_result_item_iterator_next(ritems_itr);
@@ -759,22 +976,22 @@ static oval_result_t eval_check_state(struct oval_test *test, void **args)
 
 		ores_clear(&ste_ores);
 
-		ste_itr = oval_test_get_states(test);
-		while (oval_state_iterator_has_more(ste_itr)) {
-			struct oval_state *ste;
-			oval_result_t ste_res;
-
-			ste = oval_state_iterator_next(ste_itr);
-			ste_res = eval_item(syschar_model, item, ste);
+		_oval_item_sysents_collect(&item_sysents, item);
+		for (size_t i = 0; i < matchers_count; i++) {
+			oval_result_t ste_res = eval_item(syschar_model, item, &item_sysents, &matchers[i]);
 			ores_add_res(&ste_ores, ste_res);
 		}
-		oval_state_iterator_free(ste_itr);
 
 		item_res = ores_get_result_byopr(&ste_ores, ste_opr);
 		ores_add_res(&item_ores, item_res);
 		oval_result_item_set_result(ritem, item_res);
 	}
 	oval_result_item_iterator_free(ritems_itr);
+	free(item_sysents.sysents);
+	free(item_sysents.names);
+	for (size_t i = 0; i < matchers_count; i++)
+		_oval_state_matcher_clear(&matchers[i]);
+	free(matchers);
 
 	result = ores_get_result_bychk(&item_ores, ste_check);
 
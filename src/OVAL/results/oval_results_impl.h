@@ -45,6 +45,29 @@
 int oval_result_system_parse_tag(xmlTextReaderPtr, struct oval_parser_context *, void *);
 xmlNode *oval_result_system_to_dom(struct oval_result_system *, struct oval_results_model *, struct oval_directives_model *, xmlDocPtr, xmlNode *);
 
+/**
+ * Callbacks receiving the parts of the results which get exported, see
+ * oval_results_model_walk_export(). All of them have to be set.
+ */
+struct oval_result_export_walker {
+	/* a reported definition and the content it is reported with */
+	void (*definition)(struct oval_result_definition *, oval_result_directive_content_t, void *);
+	/* a test referenced from a definition reported with full content */
+	void (*test)(struct oval_result_test *, void *);
+	/* a collected object, its items are exported in system_data */
+	void (*syschar)(struct oval_syschar *, void *);
+	void *user_arg;
+};
+
+void oval_result_system_walk_export(struct oval_result_system *, struct oval_results_model *, struct oval_directives_model *, const struct oval_result_export_walker *);
+
+/**
+ * Walk the results as oval_results_model_export() with the default directives
+ * would export them, without building any DOM. The callbacks get called in
+ * the order of the exported document, system by system.
+ */
+void oval_results_model_walk_export(struct oval_results_model *, const struct oval_result_export_walker *);
+
 struct oval_result_test *oval_result_system_get_new_test(struct oval_result_system *, struct oval_test *, int variable_instance);
 
 int oval_result_definition_parse_tag(xmlTextReaderPtr, struct oval_parser_context *, void *);
@@ -54,13 +54,16 @@
 #include <sys/stat.h>
 #include <assert.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <sys/types.h>
 #if defined(OS_LINUX)
 #include <sys/prctl.h>
 #endif
 #include <limits.h>
 #include <unistd.h>
+#include <errno.h>
 #include <libgen.h>
+#include <pthread.h>
 
 #define SCE_SCRIPT "oscap-run-sce-script"
 
@@ -217,12 +220,14 @@ void sce_check_result_export(struct sce_check_result* v, const char* target_file
 struct sce_session
 {
 	struct oscap_list* results;
+	pthread_mutex_t lock;	///< the checks may be evaluated concurrently
 };
 
 struct sce_session* sce_session_new(void)
 {
 	struct sce_session* ret = malloc(sizeof(struct sce_session));
 	ret->results = oscap_list_new();
+	pthread_mutex_init(&ret->lock, NULL);
 
 	return ret;
 }
@@ -233,6 +238,7 @@ void sce_session_free(struct sce_session* s)
 		return;
 
 	oscap_list_free(s->results, (oscap_destruct_func) sce_check_result_free);
+	pthread_mutex_destroy(&s->lock);
 	free(s);
 }
 
@@ -244,7 +250,9 @@ void sce_session_reset(struct sce_session* s)
 
 void sce_session_add_check_result(struct sce_session* s, struct sce_check_result* result)
 {
+	pthread_mutex_lock(&s->lock);
 	oscap_list_push(s->results, result);
+	pthread_mutex_unlock(&s->lock);
 }
 
 OSCAP_ITERATOR_GEN(sce_check_result)
@@ -324,31 +332,36 @@ void sce_parameters_allocate_session(struct sce_parameters* v)
 	sce_parameters_set_session(v, sce_session_new());
 }
 
+#define SCE_PIPE_READ_SIZE 65536
+
 static void _pipe_try_read_into_string(int fd, struct oscap_string *string, bool *eof)
 {
-	// FIXME: Read by larger chunks in the future
-	char readbuf;
+	char readbuf[SCE_PIPE_READ_SIZE];
 	while (true) {
-		const int read_status = read(fd, &readbuf, 1);
-		if (read_status == 1) {  // successful read
-			if (readbuf == '&') {
+		const ssize_t read_status = read(fd, readbuf, sizeof(readbuf));
+		if (read_status > 0) {  // successful read
+			const char *chunk = readbuf;
+			const char *end = readbuf + read_status;
+			const char *amp;
+			while ((amp = memchr(chunk, '&', end - chunk)) != NULL) {
 				// & is a special case, we have to "escape" it manually
 				// (all else will eventually get handled by libxml)
+				oscap_string_append_string_len(string, chunk, amp - chunk);
 				oscap_string_append_string(string, "&amp;");
-			} else {
-				oscap_string_append_char(string, readbuf);
+				chunk = amp + 1;
 			}
+			oscap_string_append_string_len(string, chunk, end - chunk);
 		}
 		else if (read_status == 0) {  // EOF
 			*eof = true;
 			break;
 		}
 		else {
-			if (errno == EAGAIN) {
+			if (errno == EAGAIN || errno == EWOULDBLOCK) {
 				// NOOP, we are waiting for more input
 				break;
 			}
-			else {
+			else if (errno != EINTR) {
 				*eof = true;  // signal EOF to exit the loops
 				break;
 			}
@@ -356,6 +369,49 @@ static void _pipe_try_read_into_string(int fd, struct oscap_string *string, bool
 	}
 }
 
+/*
+ * Reads both pipes until the script closes them, the reading sleeps in poll()
+ * until there is more output or the pipe is closed.
+ */
+static void _pipes_read_into_strings(int stdout_fd, struct oscap_string *stdout_string,
+		int stderr_fd, struct oscap_string *stderr_string)
+{
+	bool stdout_eof = false;
+	bool stderr_eof = false;
+
+	while (!stdout_eof || !stderr_eof) {
+		struct pollfd fds[2];
+		nfds_t nfds = 0;
+
+		if (!stdout_eof) {
+			fds[nfds].fd = stdout_fd;
+			fds[nfds].events = POLLIN;
+			nfds++;
+		}
+		if (!stderr_eof) {
+			fds[nfds].fd = stderr_fd;
+			fds[nfds].events = POLLIN;
+			nfds++;
+		}
+
+		if (poll(fds, nfds, -1) == -1) {
+			if (errno == EINTR)
+				continue;
+			dE("Failed to poll the pipes of SCE script: %s", strerror(errno));
+			break;
+		}
+
+		for (nfds_t i = 0; i < nfds; i++) {
+			if (fds[i].revents == 0)
+				continue;
+			if (fds[i].fd == stdout_fd)
+				_pipe_try_read_into_string(stdout_fd, stdout_string, &stdout_eof);
+			else
+				_pipe_try_read_into_string(stderr_fd, stderr_string, &stderr_eof);
+		}
+	}
+}
+
 
 static void free_env_values(char **env_values, size_t index_of_first_env_value_not_compiled_in, size_t real_env_values_count) {
 	for (size_t i = index_of_first_env_value_not_compiled_in; i < real_env_values_count; i++) {
@@ -517,10 +573,11 @@ xccdf_test_result_type_t sce_engine_eval_rule(struct xccdf_policy *policy, const
 	env_values = new_env_values;
 	env_values[env_value_count] = NULL;
 
-	// We open a pipe for communication with the forked process
+	// We open a pipe for communication with the forked process, the pipes
+	// must not leak into scripts forked concurrently by other threads
 	int stdout_pipefd[2];
 	int stderr_pipefd[2];
-	if (pipe(stdout_pipefd) == -1 || pipe(stderr_pipefd) == -1)
+	if (pipe2(stdout_pipefd, O_CLOEXEC) == -1 || pipe2(stderr_pipefd, O_CLOEXEC) == -1)
 	{
 		dE("Error in pipe");
 		free_env_values(env_values, index_of_first_env_value_not_compiled_in, env_value_count);
@@ -633,19 +690,7 @@ xccdf_test_result_type_t sce_engine_eval_rule(struct xccdf_policy *policy, const
 			struct oscap_string *stdout_string = oscap_string_new();
 			struct oscap_string *stderr_string = oscap_string_new();
 
-			bool stdout_eof = false;
-			bool stderr_eof = false;
-
-			while (!stdout_eof || !stderr_eof) {
-				if (!stdout_eof)
-					_pipe_try_read_into_string(stdout_pipefd[0], stdout_string, &stdout_eof);
-
-				if (!stderr_eof)
-					_pipe_try_read_into_string(stderr_pipefd[0], stderr_string, &stderr_eof);
-
-				// sleep for 10ms to avoid wasting CPU
-				usleep(10 * 1000);
-			}
+			_pipes_read_into_strings(stdout_pipefd[0], stdout_string, stderr_pipefd[0], stderr_string);
 
 			close(stdout_pipefd[0]);
 			close(stderr_pipefd[0]);
@@ -724,8 +769,16 @@ xccdf_test_result_type_t sce_engine_eval_rule(struct xccdf_policy *policy, const
 	}
 }
 
+static void *sce_engine_query(void *usr, xccdf_policy_engine_query_t query_type, void *query_data)
+{
+	// every script is run by its own process
+	if (query_type == POLICY_ENGINE_QUERY_CONCURRENT_EVAL)
+		return usr;
+	return NULL;
+}
+
 bool xccdf_policy_model_register_engine_sce(struct xccdf_policy_model * model, struct sce_parameters *parameters)
 {
 	return xccdf_policy_model_register_engine_and_query_callback(model,
-		"http://open-scap.org/page/SCE", sce_engine_eval_rule, (void*)parameters, NULL);
+		"http://open-scap.org/page/SCE", sce_engine_eval_rule, (void*)parameters, sce_engine_query);
 }
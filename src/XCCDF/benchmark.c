@@ -33,6 +33,7 @@
 #include "common/_error.h"
 #include "common/debug_priv.h"
 #include "common/elements.h"
+#include "common/xml_stream.h"
 #include "source/public/oscap_source.h"
 #include "source/oscap_source_priv.h"
 
@@ -54,11 +55,16 @@ struct xccdf_backref {
 struct xccdf_benchmark *xccdf_benchmark_import_source(struct oscap_source *source)
 {
 	xmlTextReader *reader = oscap_source_get_xmlTextReader(source);
+	if (reader == NULL) {
+		return NULL;
+	}
 
-	while (xmlTextReaderRead(reader) == 1 && xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) ;
+	while (xmlTextReaderNextNode(reader) == 1 && xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) ;
 	struct xccdf_benchmark *benchmark = xccdf_benchmark_new();
-	const bool parse_result = xccdf_benchmark_parse(XITEM(benchmark), reader);
-	xmlFreeTextReader(reader);
+	bool parse_result = xccdf_benchmark_parse(XITEM(benchmark), reader);
+	if (oscap_source_free_xmlTextReader(reader) != 0) {
+		parse_result = false;
+	}
 
 	if (!parse_result) { // parsing fatal error
 		oscap_seterr(OSCAP_EFAMILY_XML, "Failed to import XCCDF content from '%s'.", oscap_source_readable_origin(source));
@@ -209,7 +215,7 @@ bool xccdf_benchmark_parse(struct xccdf_item * benchmark, xmlTextReaderPtr reade
 				dW("Encountered an unknown element '%s' while parsing XCCDF benchmark.",
 				   xmlTextReaderConstLocalName(reader));
 		}
-		xmlTextReaderRead(reader);
+		xmlTextReaderNextNode(reader);
 	}
 
 	return true;
@@ -233,13 +239,20 @@ int xccdf_benchmark_export(struct xccdf_benchmark *benchmark, const char *file)
 
 	LIBXML_TEST_VERSION;
 
-	struct oscap_source *source = xccdf_benchmark_export_source(benchmark, file);
-	if (source == NULL) {
+	xmlDocPtr doc = xmlNewDoc(BAD_CAST "1.0");
+	if (doc == NULL) {
+		oscap_setxmlerr(xmlGetLastError());
+		return -1;
+	}
+	if (!oscap_xml_stream_open(doc, file)) {
+		xmlFreeDoc(doc);
 		return -1;
 	}
-	int ret = oscap_source_save_as(source, NULL);
-	oscap_source_free(source);;
-	return ret;
+
+	xccdf_benchmark_to_dom(benchmark, doc, NULL, NULL);
+	int ret = oscap_xml_stream_close(doc);
+	xmlFreeDoc(doc);
+	return ret == 1 ? 0 : -1;
 }
 
 #define OSCAP_XML_XSI BAD_CAST "http://www.w3.org/XML/1998/namespace"
@@ -348,6 +361,7 @@ xmlNode *xccdf_benchmark_to_dom(struct xccdf_benchmark *benchmark, xmlDocPtr doc
 	while (xccdf_profile_iterator_has_more(profiles)) {
 		struct xccdf_profile *profile = xccdf_profile_iterator_next(profiles);
 		xccdf_item_to_dom(XITEM(profile), doc, root_node, version_info);
+		oscap_xml_stream_flush(doc, root_node);
 	}
 	xccdf_profile_iterator_free(profiles);
 
@@ -355,14 +369,17 @@ xmlNode *xccdf_benchmark_to_dom(struct xccdf_benchmark *benchmark, xmlDocPtr doc
 	while (xccdf_value_iterator_has_more(values)) {
 		struct xccdf_value *value = xccdf_value_iterator_next(values);
 		xccdf_item_to_dom(XITEM(value), doc, root_node, version_info);
+		oscap_xml_stream_flush(doc, root_node);
 	}
 	xccdf_value_iterator_free(values);
 
 	struct xccdf_item_iterator *items = xccdf_benchmark_get_content(benchmark);
 	while (xccdf_item_iterator_has_more(items)) {
 		struct xccdf_item *item = xccdf_item_iterator_next(items);
-		if (XBENCHMARK(xccdf_item_get_parent(item)) == benchmark)
+		if (XBENCHMARK(xccdf_item_get_parent(item)) == benchmark) {
 			xccdf_item_to_dom(item, doc, root_node, version_info);
+			oscap_xml_stream_flush(doc, root_node);
+		}
 	}
 	xccdf_item_iterator_free(items);
 
@@ -370,6 +387,7 @@ xmlNode *xccdf_benchmark_to_dom(struct xccdf_benchmark *benchmark, xmlDocPtr doc
 	while (xccdf_result_iterator_has_more(results)) {
 		struct xccdf_result *result = xccdf_result_iterator_next(results);
 		xccdf_item_to_dom(XITEM(result), doc, root_node, version_info);
+		oscap_xml_stream_flush(doc, root_node);
 	}
 	xccdf_result_iterator_free(results);
 
@@ -471,6 +489,11 @@ bool xccdf_benchmark_add_result(struct xccdf_benchmark *benchmark, struct xccdf_
 		"result" "-");
 }
 
+bool xccdf_benchmark_remove_result(struct xccdf_benchmark *benchmark, struct xccdf_result *result)
+{
+	return oscap_list_remove(XITEM(benchmark)->sub.benchmark.results, result, oscap_ptr_cmp, (oscap_destruct_func) xccdf_result_free);
+}
+
 struct xccdf_profile *
 xccdf_benchmark_get_profile_by_id(struct xccdf_benchmark *benchmark, const char *profile_id)
 {
@@ -0,0 +1,756 @@
+/*
+ * Copyright 2026 Red Hat Inc., Durham, North Carolina.
+ * All Rights Reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+/*
+ * Model cache records of resolved XCCDF benchmarks.
+ *
+ * The record holds every member of the benchmark and its items in the order
+ * of the lists of the model, so the loaded benchmark is the same as the one
+ * parsed and resolved from the document. Items are registered to the
+ * benchmark before their children, the same way the parser does. The origin
+ * file of the embedded CPE lang model isn't part of the record, it's set
+ * from the source the benchmark is loaded for.
+ *
+ * Members added to the model have to be added to the record as well,
+ * otherwise they are lost when the benchmark is loaded from the cache.
+ * test_xccdf_model_cache.sh compares the exports of parsed and loaded
+ * benchmarks. Change XCCDF_MODEL_CACHE_VERSION whenever the layout of the
+ * record or of the model changes.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdlib.h>
+
+#include "item.h"
+#include "helpers.h"
+#include "benchmark_cache_priv.h"
+#include "common/debug_priv.h"
+#include "common/oscap_model_cache.h"
+#include "CPE/cpelang_priv.h"
+#include "source/oscap_source_priv.h"
+
+#define XCCDF_MODEL_CACHE_KIND "xccdf"
+#define XCCDF_MODEL_CACHE_VERSION 2
+
+static void xccdf_status_cache_write(struct oscap_model_writer *writer, const void *item)
+{
+	const struct xccdf_status *status = item;
+	oscap_model_write_u32(writer, status->status);
+	oscap_model_write_i64(writer, status->date);
+}
+
+static void *xccdf_status_cache_read(struct oscap_model_reader *reader)
+{
+	struct xccdf_status *status = xccdf_status_new();
+	status->status = oscap_model_read_u32(reader);
+	status->date = oscap_model_read_i64(reader);
+	return status;
+}
+
+/* Texts which may be missing in the model */
+static void xccdf_text_cache_write(struct oscap_model_writer *writer, const struct oscap_text *text)
+{
+	oscap_model_write_bool(writer, text != NULL);
+	if (text != NULL)
+		oscap_text_cache_write(writer, text);
+}
+
+static struct oscap_text *xccdf_text_cache_read(struct oscap_model_reader *reader)
+{
+	return oscap_model_read_bool(reader) ? oscap_text_cache_read(reader) : NULL;
+}
+
+static void xccdf_warning_cache_write(struct oscap_model_writer *writer, const void *item)
+{
+	const struct xccdf_warning *warning = item;
+	xccdf_text_cache_write(writer, warning->text);
+	oscap_model_write_u32(writer, warning->category);
+}
+
+static void *xccdf_warning_cache_read(struct oscap_model_reader *reader)
+{
+	struct xccdf_warning *warning = xccdf_warning_new();
+	warning->text = xccdf_text_cache_read(reader);
+	warning->category = oscap_model_read_u32(reader);
+	return warning;
+}
+
+static void xccdf_item_base_cache_write(struct oscap_model_writer *writer, const struct xccdf_item_base *base)
+{
+	oscap_model_write_string(writer, base->id);
+	oscap_model_write_string(writer, base->cluster_id);
+	oscap_model_write_float(writer, base->weight);
+	oscap_model_write_list(writer, base->title, oscap_text_cache_write);
+	oscap_model_write_list(writer, base->description, oscap_text_cache_write);
+	oscap_model_write_list(writer, base->question, oscap_text_cache_write);
+	oscap_model_write_list(writer, base->rationale, oscap_text_cache_write);
+	oscap_model_write_list(writer, base->warnings, xccdf_warning_cache_write);
+	oscap_model_write_string(writer, base->version);
+	oscap_model_write_string(writer, base->version_update);
+	oscap_model_write_string(writer, base->version_time);
+	oscap_model_write_string(writer, base->extends);
+	oscap_model_write_list(writer, base->statuses, xccdf_status_cache_write);
+	oscap_model_write_list(writer, base->dc_statuses, oscap_reference_cache_write);
+	oscap_model_write_list(writer, base->references, oscap_reference_cache_write);
+	oscap_model_write_list(writer, base->platforms, oscap_model_write_string_item);
+
+	oscap_model_write_bool(writer, base->flags.selected);
+	oscap_model_write_bool(writer, base->flags.hidden);
+	oscap_model_write_bool(writer, base->flags.resolved);
+	oscap_model_write_bool(writer, base->flags.abstract);
+	oscap_model_write_bool(writer, base->flags.prohibit_changes);
+	oscap_model_write_bool(writer, base->flags.interactive);
+	oscap_model_write_bool(writer, base->flags.multiple);
+
+	oscap_model_write_bool(writer, base->defined_flags.selected);
+	oscap_model_write_bool(writer, base->defined_flags.hidden);
+	oscap_model_write_bool(writer, base->defined_flags.resolved);
+	oscap_model_write_bool(writer, base->defined_flags.abstract);
+	oscap_model_write_bool(writer, base->defined_flags.prohibit_changes);
+	oscap_model_write_bool(writer, base->defined_flags.interactive);
+	oscap_model_write_bool(writer, base->defined_flags.multiple);
+	oscap_model_write_bool(writer, base->defined_flags.weight);
+	oscap_model_write_bool(writer, base->defined_flags.role);
+	oscap_model_write_bool(writer, base->defined_flags.severity);
+
+	oscap_model_write_list(writer, base->metadata, oscap_model_write_string_item);
+}
+
+static void xccdf_item_base_cache_read(struct oscap_model_reader *reader, struct xccdf_item_base *base)
+{
+	base->id = oscap_model_read_string(reader);
+	base->cluster_id = oscap_model_read_string(reader);
+	base->weight = oscap_model_read_float(reader);
+	oscap_model_read_list(reader, base->title, oscap_text_cache_read);
+	oscap_model_read_list(reader, base->description, oscap_text_cache_read);
+	oscap_model_read_list(reader, base->question, oscap_text_cache_read);
+	oscap_model_read_list(reader, base->rationale, oscap_text_cache_read);
+	oscap_model_read_list(reader, base->warnings, xccdf_warning_cache_read);
+	base->version = oscap_model_read_string(reader);
+	base->version_update = oscap_model_read_string(reader);
+	base->version_time = oscap_model_read_string(reader);
+	base->extends = oscap_model_read_string(reader);
+	oscap_model_read_list(reader, base->statuses, xccdf_status_cache_read);
+	oscap_model_read_list(reader, base->dc_statuses, oscap_reference_cache_read);
+	oscap_model_read_list(reader, base->references, oscap_reference_cache_read);
+	oscap_model_read_list(reader, base->platforms, oscap_model_read_string_item);
+
+	base->flags.selected = oscap_model_read_bool(reader);
+	base->flags.hidden = oscap_model_read_bool(reader);
+	base->flags.resolved = oscap_model_read_bool(reader);
+	base->flags.abstract = oscap_model_read_bool(reader);
+	base->flags.prohibit_changes = oscap_model_read_bool(reader);
+	base->flags.interactive = oscap_model_read_bool(reader);
+	base->flags.multiple = oscap_model_read_bool(reader);
+
+	base->defined_flags.selected = oscap_model_read_bool(reader);
+	base->defined_flags.hidden = oscap_model_read_bool(reader);
+	base->defined_flags.resolved = oscap_model_read_bool(reader);
+	base->defined_flags.abstract = oscap_model_read_bool(reader);
+	base->defined_flags.prohibit_changes = oscap_model_read_bool(reader);
+	base->defined_flags.interactive = oscap_model_read_bool(reader);
+	base->defined_flags.multiple = oscap_model_read_bool(reader);
+	base->defined_flags.weight = oscap_model_read_bool(reader);
+	base->defined_flags.role = oscap_model_read_bool(reader);
+	base->defined_flags.severity = oscap_model_read_bool(reader);
+
+	oscap_model_read_list(reader, base->metadata, oscap_model_read_string_item);
+}
+
+/* Lists of alternative IDs of xccdf:requires */
+static void xccdf_requires_cache_write(struct oscap_model_writer *writer, const void *item)
+{
+	oscap_model_write_list(writer, item, oscap_model_write_string_item);
+}
+
+static void *xccdf_requires_cache_read(struct oscap_model_reader *reader)
+{
+	struct oscap_list *ids = oscap_list_new();
+	oscap_model_read_list(reader, ids, oscap_model_read_string_item);
+	return ids;
+}
+
+static void xccdf_ident_cache_write(struct oscap_model_writer *writer, const void *item)
+{
+	const struct xccdf_ident *ident = item;
+	oscap_model_write_string(writer, ident->id);
+	oscap_model_write_string(writer, ident->system);
+}
+
+static void *xccdf_ident_cache_read(struct oscap_model_reader *reader)
+{
+	struct xccdf_ident *ident = xccdf_ident_new();
+	ident->id = oscap_model_read_string(reader);
+	ident->system = oscap_model_read_string(reader);
+	return ident;
+}
+
+static void xccdf_profile_note_cache_write(struct oscap_model_writer *writer, const void *item)
+{
+	const struct xccdf_profile_note *note = item;
+	xccdf_text_cache_write(writer, note->text);
+	oscap_model_write_string(writer, note->reftag);
+}
+
+static void *xccdf_profile_note_cache_read(struct oscap_model_reader *reader)
+{
+	struct xccdf_profile_note *note = xccdf_profile_note_new();
+	note->text = xccdf_text_cache_read(reader);
+	note->reftag = oscap_model_read_string(reader);
+	return note;
+}
+
+static void xccdf_check_import_cache_write(struct oscap_model_writer *writer, const void *item)
+{
+	const struct xccdf_check_import *import = item;
+	oscap_model_write_string(writer, import->name);
+	oscap_model_write_string(writer, import->xpath);
+	oscap_model_write_string(writer, import->content);
+}
+
+static void *xccdf_check_import_cache_read(struct oscap_model_reader *reader)
+{
+	struct xccdf_check_import *import = xccdf_check_import_new();
+	import->name = oscap_model_read_string(reader);
+	import->xpath = oscap_model_read_string(reader);
+	import->content = oscap_model_read_string(reader);
+	return import;
+}
+
+static void xccdf_check_export_cache_write(struct oscap_model_writer *writer, const void *item)
+{
+	const struct xccdf_check_export *export = item;
+	oscap_model_write_string(writer, export->name);
+	oscap_model_write_string(writer, export->value);
+}
+
+static void *xccdf_check_export_cache_read(struct oscap_model_reader *reader)
+{
+	struct xccdf_check_export *export = xccdf_check_export_new();
+	export->name = oscap_model_read_string(reader);
+	export->value = oscap_model_read_string(reader);
+	return export;
+}
+
+static void xccdf_check_content_ref_cache_write(struct oscap_model_writer *writer, const void *item)
+{
+	const struct xccdf_check_content_ref *ref = item;
+	oscap_model_write_string(writer, ref->href);
+	oscap_model_write_string(writer, ref->name);
+}
+
+static void *xccdf_check_content_ref_cache_read(struct oscap_model_reader *reader)
+{
+	struct xccdf_check_content_ref *ref = xccdf_check_content_ref_new();
+	ref->href = oscap_model_read_string(reader);
+	ref->name = oscap_model_read_string(reader);
+	return ref;
+}
+
+static void xccdf_check_cache_write(struct oscap_model_writer *writer, const void *item)
+{
+	const struct xccdf_check *check = item;
+	oscap_model_write_u32(writer, check->oper);
+	oscap_model_write_list(writer, check->children, xccdf_check_cache_write);
+	oscap_model_write_string(writer, check->id);
+	oscap_model_write_string(writer, check->system);
+	oscap_model_write_string(writer, check->selector);
+	oscap_model_write_string(writer, check->content);
+	oscap_model_write_bool(writer, check->flags.multicheck);
+	oscap_model_write_bool(writer, check->flags.def_multicheck);
+	oscap_model_write_bool(writer, check->flags.negate);
+	oscap_model_write_bool(writer, check->flags.def_negate);
+	oscap_model_write_list(writer, check->imports, xccdf_check_import_cache_write);
+	oscap_model_write_list(writer, check->exports, xccdf_check_export_cache_write);
+	oscap_model_write_list(writer, check->content_refs, xccdf_check_content_ref_cache_write);
+}
+
+static void *xccdf_check_cache_read(struct oscap_model_reader *reader)
+{
+	struct xccdf_check *check = xccdf_check_new();
+	check->oper = oscap_model_read_u32(reader);
+	oscap_model_read_list(reader, check->children, xccdf_check_cache_read);
+	check->id = oscap_model_read_string(reader);
+	check->system = oscap_model_read_string(reader);
+	check->selector = oscap_model_read_string(reader);
+	check->content = oscap_model_read_string(reader);
+	check->flags.multicheck = oscap_model_read_bool(reader);
+	check->flags.def_multicheck = oscap_model_read_bool(reader);
+	check->flags.negate = oscap_model_read_bool(reader);
+	check->flags.def_negate = oscap_model_read_bool(reader);
+	oscap_model_read_list(reader, check->imports, xccdf_check_import_cache_read);
+	oscap_model_read_list(reader, check->exports, xccdf_check_export_cache_read);
+	oscap_model_read_list(reader, check->content_refs, xccdf_check_content_ref_cache_read);
+	return check;
+}
+
+static void xccdf_fix_cache_write(struct oscap_model_writer *writer, const void *item)
+{
+	const struct xccdf_fix *fix = item;
+	oscap_model_write_bool(writer, fix->reboot);
+	oscap_model_write_bool(writer, fix->def_reboot);
+	oscap_model_write_u32(writer, fix->strategy);
+	oscap_model_write_u32(writer, fix->disruption);
+	oscap_model_write_u32(writer, fix->complexity);
+	oscap_model_write_string(writer, fix->id);
+	oscap_model_write_string(writer, fix->content);
+	oscap_model_write_string(writer, fix->system);
+	oscap_model_write_string(writer, fix->platform);
+}
+
+static void *xccdf_fix_cache_read(struct oscap_model_reader *reader)
+{
+	struct xccdf_fix *fix = xccdf_fix_new();
+	fix->reboot = oscap_model_read_bool(reader);
+	fix->def_reboot = oscap_model_read_bool(reader);
+	fix->strategy = oscap_model_read_u32(reader);
+	fix->disruption = oscap_model_read_u32(reader);
+	fix->complexity = oscap_model_read_u32(reader);
+	fix->id = oscap_model_read_string(reader);
+	fix->content = oscap_model_read_string(reader);
+	fix->system = oscap_model_read_string(reader);
+	fix->platform = oscap_model_read_string(reader);
+	return fix;
+}
+
+static void xccdf_fixtext_cache_write(struct oscap_model_writer *writer, const void *item)
+{
+	const struct xccdf_fixtext *fixtext = item;
+	xccdf_text_cache_write(writer, fixtext->text);
+	oscap_model_write_bool(writer, fixtext->reboot);
+	oscap_model_write_u32(writer, fixtext->strategy);
+	oscap_model_write_u32(writer, fixtext->disruption);
+	oscap_model_write_u32(writer, fixtext->complexity);
+	oscap_model_write_string(writer, fixtext->fixref);
+}
+
+static void *xccdf_fixtext_cache_read(struct oscap_model_reader *reader)
+{
+	struct xccdf_fixtext *fixtext = xccdf_fixtext_new();
+	fixtext->text = xccdf_text_cache_read(reader);
+	fixtext->reboot = oscap_model_read_bool(reader);
+	fixtext->strategy = oscap_model_read_u32(reader);
+	fixtext->disruption = oscap_model_read_u32(reader);
+	fixtext->complexity = oscap_model_read_u32(reader);
+	fixtext->fixref = oscap_model_read_string(reader);
+	return fixtext;
+}
+
+static void xccdf_value_instance_cache_write(struct oscap_model_writer *writer, const void *item)
+{
+	const struct xccdf_value_instance *inst = item;
+	oscap_model_write_u32(writer, inst->type);
+	oscap_model_write_string(writer, inst->selector);
+	oscap_model_write_string(writer, inst->value);
+	oscap_model_write_string(writer, inst->defval);
+	oscap_model_write_list(writer, inst->choices, oscap_model_write_string_item);
+	oscap_model_write_float(writer, inst->lower_bound);
+	oscap_model_write_float(writer, inst->upper_bound);
+	oscap_model_write_string(writer, inst->match);
+	oscap_model_write_bool(writer, inst->flags.value_given);
+	oscap_model_write_bool(writer, inst->flags.defval_given);
+	oscap_model_write_bool(writer, inst->flags.must_match_given);
+	oscap_model_write_bool(writer, inst->flags.must_match);
+}
+
+static void *xccdf_value_instance_cache_read(struct oscap_model_reader *reader)
+{
+	struct xccdf_value_instance *inst = xccdf_value_instance_new(oscap_model_read_u32(reader));
+	inst->selector = oscap_model_read_string(reader);
+	inst->value = oscap_model_read_string(reader);
+	inst->defval = oscap_model_read_string(reader);
+	oscap_model_read_list(reader, inst->choices, oscap_model_read_string_item);
+	inst->lower_bound = oscap_model_read_float(reader);
+	inst->upper_bound = oscap_model_read_float(reader);
+	inst->match = oscap_model_read_string(reader);
+	inst->flags.value_given = oscap_model_read_bool(reader);
+	inst->flags.defval_given = oscap_model_read_bool(reader);
+	inst->flags.must_match_given = oscap_model_read_bool(reader);
+	inst->flags.must_match = oscap_model_read_bool(reader);
+	return inst;
+}
+
+static void xccdf_select_cache_write(struct oscap_model_writer *writer, const void *item)
+{
+	const struct xccdf_select *sel = item;
+	oscap_model_write_string(writer, sel->item);
+	oscap_model_write_bool(writer, sel->selected);
+	oscap_model_write_list(writer, sel->remarks, oscap_text_cache_write);
+}
+
+static void *xccdf_select_cache_read(struct oscap_model_reader *reader)
+{
+	struct xccdf_select *sel = xccdf_select_new();
+	sel->item = oscap_model_read_string(reader);
+	sel->selected = oscap_model_read_bool(reader);
+	oscap_model_read_list(reader, sel->remarks, oscap_text_cache_read);
+	return sel;
+}
+
+static void xccdf_setvalue_cache_write(struct oscap_model_writer *writer, const void *item)
+{
+	const struct xccdf_setvalue *setvalue = item;
+	oscap_model_write_string(writer, setvalue->item);
+	oscap_model_write_string(writer, setvalue->value);
+}
+
+static void *xccdf_setvalue_cache_read(struct oscap_model_reader *reader)
+{
+	struct xccdf_setvalue *setvalue = xccdf_setvalue_new();
+	setvalue->item = oscap_model_read_string(reader);
+	setvalue->value = oscap_model_read_string(reader);
+	return setvalue;
+}
+
+static void xccdf_refine_value_cache_write(struct oscap_model_writer *writer, const void *item)
+{
+	const struct xccdf_refine_value *rv = item;
+	oscap_model_write_string(writer, rv->item);
+	oscap_model_write_string(writer, rv->selector);
+	oscap_model_write_u32(writer, rv->oper);
+	oscap_model_write_list(writer, rv->remarks, oscap_text_cache_write);
+}
+
+static void *xccdf_refine_value_cache_read(struct oscap_model_reader *reader)
+{
+	struct xccdf_refine_value *rv = xccdf_refine_value_new();
+	rv->item = oscap_model_read_string(reader);
+	rv->selector = oscap_model_read_string(reader);
+	rv->oper = oscap_model_read_u32(reader);
+	oscap_model_read_list(reader, rv->remarks, oscap_text_cache_read);
+	return rv;
+}
+
+static void xccdf_refine_rule_cache_write(struct oscap_model_writer *writer, const void *item)
+{
+	const struct xccdf_refine_rule *rr = item;
+	oscap_model_write_string(writer, rr->item);
+	oscap_model_write_string(writer, rr->selector);
+	oscap_model_write_u32(writer, rr->role);
+	oscap_model_write_u32(writer, rr->severity);
+	oscap_model_write_float(writer, rr->weight);
+	oscap_model_write_list(writer, rr->remarks, oscap_text_cache_write);
+}
+
+static void *xccdf_refine_rule_cache_read(struct oscap_model_reader *reader)
+{
+	struct xccdf_refine_rule *rr = xccdf_refine_rule_new();
+	rr->item = oscap_model_read_string(reader);
+	rr->selector = oscap_model_read_string(reader);
+	rr->role = oscap_model_read_u32(reader);
+	rr->severity = oscap_model_read_u32(reader);
+	rr->weight = oscap_model_read_float(reader);
+	oscap_model_read_list(reader, rr->remarks, oscap_text_cache_read);
+	return rr;
+}
+
+static void xccdf_item_cache_write(struct oscap_model_writer *writer, const void *ptr)
+{
+	const struct xccdf_item *item = ptr;
+	oscap_model_write_u32(writer, item->type);
+	if (item->type == XCCDF_VALUE)
+		oscap_model_write_u32(writer, item->sub.value.type);
+	xccdf_item_base_cache_write(writer, &item->item);
+
+	switch (item->type) {
+	case XCCDF_RULE:
+		oscap_model_write_string(writer, item->sub.rule.impact_metric);
+		oscap_model_write_u32(writer, item->sub.rule.role);
+		oscap_model_write_u32(writer, item->sub.rule.severity);
+		oscap_model_write_list(writer, item->sub.rule.requires, xccdf_requires_cache_write);
+		oscap_model_write_list(writer, item->sub.rule.conflicts, oscap_model_write_string_item);
+		oscap_model_write_list(writer, item->sub.rule.profile_notes, xccdf_profile_note_cache_write);
+		oscap_model_write_list(writer, item->sub.rule.idents, xccdf_ident_cache_write);
+		oscap_model_write_list(writer, item->sub.rule.checks, xccdf_check_cache_write);
+		oscap_model_write_list(writer, item->sub.rule.fixes, xccdf_fix_cache_write);
+		oscap_model_write_list(writer, item->sub.rule.fixtexts, xccdf_fixtext_cache_write);
+		break;
+	case XCCDF_GROUP:
+		oscap_model_write_list(writer, item->sub.group.requires, xccdf_requires_cache_write);
+		oscap_model_write_list(writer, item->sub.group.conflicts, oscap_model_write_string_item);
+		oscap_model_write_list(writer, item->sub.group.values, xccdf_item_cache_write);
+		oscap_model_write_list(writer, item->sub.group.content, xccdf_item_cache_write);
+		break;
+	case XCCDF_VALUE:
+		oscap_model_write_u32(writer, item->sub.value.interface_hint);
+		oscap_model_write_u32(writer, item->sub.value.oper);
+		oscap_model_write_list(writer, item->sub.value.instances, xccdf_value_instance_cache_write);
+		oscap_model_write_list(writer, item->sub.value.sources, oscap_model_write_string_item);
+		break;
+	case XCCDF_PROFILE:
+		oscap_model_write_string(writer, item->sub.profile.note_tag);
+		oscap_model_write_list(writer, item->sub.profile.selects, xccdf_select_cache_write);
+		oscap_model_write_list(writer, item->sub.profile.setvalues, xccdf_setvalue_cache_write);
+		oscap_model_write_list(writer, item->sub.profile.refine_values, xccdf_refine_value_cache_write);
+		oscap_model_write_list(writer, item->sub.profile.refine_rules, xccdf_refine_rule_cache_write);
+		oscap_model_write_bool(writer, item->sub.profile.tailoring);
+		break;
+	default:
+		oscap_model_writer_fail(writer);
+		break;
+	}
+}
+
+static void xccdf_items_cache_read(struct oscap_model_reader *reader, struct xccdf_item *parent, struct oscap_list *list, xccdf_type_t types);
+
+static struct xccdf_item *xccdf_item_cache_read(struct oscap_model_reader *reader, struct xccdf_item *parent, xccdf_type_t types)
+{
+	xccdf_type_t type = oscap_model_read_u32(reader);
+	struct xccdf_item *item;
+
+	switch (oscap_model_reader_failed(reader) ? 0 : type & types) {
+	case XCCDF_RULE:
+		item = xccdf_rule_new_internal(parent);
+		break;
+	case XCCDF_GROUP:
+		item = xccdf_group_new_internal(parent);
+		break;
+	case XCCDF_VALUE:
+		item = xccdf_value_new_internal(parent, oscap_model_read_u32(reader));
+		break;
+	case XCCDF_PROFILE:
+		item = xccdf_profile_new_internal(parent);
+		break;
+	default:
+		oscap_model_reader_fail(reader);
+		return NULL;
+	}
+
+	xccdf_item_base_cache_read(reader, &item->item);
+	if (item->item.id != NULL)
+		xccdf_benchmark_register_item(xccdf_item_get_benchmark(item), item);
+
+	switch (type) {
+	case XCCDF_RULE:
+		item->sub.rule.impact_metric = oscap_model_read_string(reader);
+		item->sub.rule.role = oscap_model_read_u32(reader);
+		item->sub.rule.severity = oscap_model_read_u32(reader);
+		oscap_model_read_list(reader, item->sub.rule.requires, xccdf_requires_cache_read);
+		oscap_model_read_list(reader, item->sub.rule.conflicts, oscap_model_read_string_item);
+		oscap_model_read_list(reader, item->sub.rule.profile_notes, xccdf_profile_note_cache_read);
+		oscap_model_read_list(reader, item->sub.rule.idents, xccdf_ident_cache_read);
+		oscap_model_read_list(reader, item->sub.rule.checks, xccdf_check_cache_read);
+		oscap_model_read_list(reader, item->sub.rule.fixes, xccdf_fix_cache_read);
+		oscap_model_read_list(reader, item->sub.rule.fixtexts, xccdf_fixtext_cache_read);
+		break;
+	case XCCDF_GROUP:
+		oscap_model_read_list(reader, item->sub.group.requires, xccdf_requires_cache_read);
+		oscap_model_read_list(reader, item->sub.group.conflicts, oscap_model_read_string_item);
+		xccdf_items_cache_read(reader, item, item->sub.group.values, XCCDF_VALUE);
+		xccdf_items_cache_read(reader, item, item->sub.group.content, XCCDF_CONTENT);
+		break;
+	case XCCDF_VALUE:
+		item->sub.value.interface_hint = oscap_model_read_u32(reader);
+		item->sub.value.oper = oscap_model_read_u32(reader);
+		oscap_model_read_list(reader, item->sub.value.instances, xccdf_value_instance_cache_read);
+		oscap_model_read_list(reader, item->sub.value.sources, oscap_model_read_string_item);
+		break;
+	case XCCDF_PROFILE:
+		item->sub.profile.note_tag = oscap_model_read_string(reader);
+		oscap_model_read_list(reader, item->sub.profile.selects, xccdf_select_cache_read);
+		oscap_model_read_list(reader, item->sub.profile.setvalues, xccdf_setvalue_cache_read);
+		oscap_model_read_list(reader, item->sub.profile.refine_values, xccdf_refine_value_cache_read);
+		oscap_model_read_list(reader, item->sub.profile.refine_rules, xccdf_refine_rule_cache_read);
+		item->sub.profile.tailoring = oscap_model_read_bool(reader);
+		break;
+	default:
+		break;
+	}
+	return item;
+}
+
+/* Items are added to the list even if the reader fails, the caller frees them with the benchmark */
+static void xccdf_items_cache_read(struct oscap_model_reader *reader, struct xccdf_item *parent, struct oscap_list *list, xccdf_type_t types)
+{
+	size_t count = oscap_model_read_count(reader);
+	for (size_t i = 0; i < count && !oscap_model_reader_failed(reader); ++i)
+		oscap_list_add(list, xccdf_item_cache_read(reader, parent, types));
+}
+
+static void xccdf_notice_cache_write(struct oscap_model_writer *writer, const void *item)
+{
+	const struct xccdf_notice *notice = item;
+	oscap_model_write_string(writer, notice->id);
+	xccdf_text_cache_write(writer, notice->text);
+}
+
+static void *xccdf_notice_cache_read(struct oscap_model_reader *reader)
+{
+	struct xccdf_notice *notice = calloc(1, sizeof(struct xccdf_notice));
+	notice->id = oscap_model_read_string(reader);
+	notice->text = xccdf_text_cache_read(reader);
+	return notice;
+}
+
+static void xccdf_plain_text_cache_write(struct oscap_model_writer *writer, const void *item)
+{
+	const struct xccdf_plain_text *plain = item;
+	oscap_model_write_string(writer, plain->id);
+	oscap_model_write_string(writer, plain->text);
+}
+
+static void *xccdf_plain_text_cache_read(struct oscap_model_reader *reader)
+{
+	struct xccdf_plain_text *plain = xccdf_plain_text_new();
+	plain->id = oscap_model_read_string(reader);
+	plain->text = oscap_model_read_string(reader);
+	return plain;
+}
+
+static void xccdf_model_cache_write(struct oscap_model_writer *writer, const void *item)
+{
+	const struct xccdf_model *model = item;
+	oscap_model_write_string(writer, model->system);
+
+	oscap_model_write_u32(writer, oscap_htable_itemcount(model->params));
+	struct oscap_htable_iterator *it = oscap_htable_iterator_new(model->params);
+	while (oscap_htable_iterator_has_more(it)) {
+		const char *name;
+		void *value;
+		oscap_htable_iterator_next_kv(it, &name, &value);
+		oscap_model_write_string(writer, name);
+		oscap_model_write_string(writer, value);
+	}
+	oscap_htable_iterator_free(it);
+}
+
+static void *xccdf_model_cache_read(struct oscap_model_reader *reader)
+{
+	struct xccdf_model *model = xccdf_model_new();
+	model->system = oscap_model_read_string(reader);
+
+	size_t count = oscap_model_read_count(reader);
+	for (size_t i = 0; i < count && !oscap_model_reader_failed(reader); ++i) {
+		char *name = oscap_model_read_string(reader);
+		char *value = oscap_model_read_string(reader);
+		if (name == NULL || value == NULL || !oscap_htable_add(model->params, name, value)) {
+			oscap_model_reader_fail(reader);
+			free(value);
+		}
+		free(name);
+	}
+	return model;
+}
+
+static void xccdf_benchmark_cache_write(struct oscap_model_writer *writer, struct xccdf_benchmark *benchmark)
+{
+	const struct xccdf_item *bench = XITEM(benchmark);
+	const struct xccdf_benchmark_item *sub = &bench->sub.benchmark;
+
+	xccdf_item_base_cache_write(writer, &bench->item);
+	oscap_model_write_string(writer, sub->schema_version != NULL ? xccdf_version_info_get_version(sub->schema_version) : NULL);
+	oscap_model_write_list(writer, sub->notices, xccdf_notice_cache_write);
+	oscap_model_write_list(writer, sub->plain_texts, xccdf_plain_text_cache_write);
+	oscap_model_write_bool(writer, sub->cpe_lang_model != NULL);
+	if (sub->cpe_lang_model != NULL)
+		cpe_lang_model_cache_write(sub->cpe_lang_model, writer);
+	oscap_model_write_string(writer, sub->style);
+	oscap_model_write_string(writer, sub->style_href);
+	oscap_model_write_string(writer, sub->lang);
+	oscap_model_write_list(writer, sub->front_matter, oscap_text_cache_write);
+	oscap_model_write_list(writer, sub->rear_matter, oscap_text_cache_write);
+	oscap_model_write_list(writer, sub->models, xccdf_model_cache_write);
+	oscap_model_write_list(writer, sub->profiles, xccdf_item_cache_write);
+	oscap_model_write_list(writer, sub->values, xccdf_item_cache_write);
+	oscap_model_write_list(writer, sub->content, xccdf_item_cache_write);
+}
+
+static struct xccdf_benchmark *xccdf_benchmark_cache_read(struct oscap_model_reader *reader)
+{
+	struct xccdf_benchmark *benchmark = xccdf_benchmark_new();
+	struct xccdf_item *bench = XITEM(benchmark);
+	struct xccdf_benchmark_item *sub = &bench->sub.benchmark;
+
+	xccdf_item_base_cache_read(reader, &bench->item);
+	char *version = oscap_model_read_string(reader);
+	if (version != NULL) {
+		sub->schema_version = xccdf_version_info_find(version);
+		if (sub->schema_version == NULL)
+			oscap_model_reader_fail(reader);
+		free(version);
+	}
+	oscap_model_read_list(reader, sub->notices, xccdf_notice_cache_read);
+	oscap_model_read_list(reader, sub->plain_texts, xccdf_plain_text_cache_read);
+	if (oscap_model_read_bool(reader))
+		sub->cpe_lang_model = cpe_lang_model_cache_read(reader);
+	sub->style = oscap_model_read_string(reader);
+	sub->style_href = oscap_model_read_string(reader);
+	sub->lang = oscap_model_read_string(reader);
+	oscap_model_read_list(reader, sub->front_matter, oscap_text_cache_read);
+	oscap_model_read_list(reader, sub->rear_matter, oscap_text_cache_read);
+	// the record has all the models, including the implied default one
+	oscap_list_free(sub->models, (oscap_destruct_func) xccdf_model_free);
+	sub->models = oscap_list_new();
+	oscap_model_read_list(reader, sub->models, xccdf_model_cache_read);
+	xccdf_items_cache_read(reader, bench, sub->profiles, XCCDF_PROFILE);
+	xccdf_items_cache_read(reader, bench, sub->values, XCCDF_VALUE);
+	xccdf_items_cache_read(reader, bench, sub->content, XCCDF_CONTENT);
+
+	if (oscap_model_reader_failed(reader)) {
+		xccdf_benchmark_free(benchmark);
+		return NULL;
+	}
+	return benchmark;
+}
+
+static void xccdf_benchmark_set_origin(struct xccdf_benchmark *benchmark, struct oscap_source *source)
+{
+	struct cpe_lang_model *embedded_lang_model = xccdf_benchmark_get_cpe_lang_model(benchmark);
+	if (embedded_lang_model != NULL)
+		cpe_lang_model_set_origin_file(embedded_lang_model, oscap_source_readable_origin(source));
+}
+
+struct xccdf_benchmark *xccdf_benchmark_import_resolved_source(struct oscap_source *source)
+{
+	const char *digest = oscap_model_cache_enabled() ? oscap_source_get_digest(source) : NULL;
+
+	if (digest != NULL) {
+		struct oscap_model_reader *reader = oscap_model_cache_open(XCCDF_MODEL_CACHE_KIND, XCCDF_MODEL_CACHE_VERSION, digest);
+		if (reader != NULL) {
+			struct xccdf_benchmark *benchmark = xccdf_benchmark_cache_read(reader);
+			if (oscap_model_cache_close(reader) == 0 && benchmark != NULL) {
+				xccdf_benchmark_set_origin(benchmark, source);
+				dI("Loaded the XCCDF benchmark of '%s' from the model cache.", oscap_source_readable_origin(source));
+				return benchmark;
+			}
+			dI("Ignoring the model cache record of '%s', it can't be loaded.", oscap_source_readable_origin(source));
+			xccdf_benchmark_free(benchmark);
+		}
+	}
+
+	struct xccdf_benchmark *benchmark = xccdf_benchmark_import_source(source);
+	if (benchmark == NULL)
+		return NULL;
+	xccdf_benchmark_resolve(benchmark);
+
+	// TestResults and CPE1 dictionaries aren't part of the record
+	const struct xccdf_benchmark_item *sub = &XITEM(benchmark)->sub.benchmark;
+	if (digest != NULL && oscap_list_get_itemcount(sub->results) == 0 && sub->cpe_list == NULL &&
+			oscap_source_digest_is_current(source)) {
+		struct oscap_model_writer *writer = oscap_model_writer_new();
+		xccdf_benchmark_cache_write(writer, benchmark);
+		oscap_model_cache_store(XCCDF_MODEL_CACHE_KIND, XCCDF_MODEL_CACHE_VERSION, digest, writer);
+		oscap_model_writer_free(writer);
+	}
+	return benchmark;
+}
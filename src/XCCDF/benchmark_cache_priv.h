@@ -0,0 +1,39 @@
+/*
+ * Copyright 2026 Red Hat Inc., Durham, North Carolina.
+ * All Rights Reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+#ifndef OSCAP_XCCDF_BENCHMARK_CACHE_H
+#define OSCAP_XCCDF_BENCHMARK_CACHE_H
+
+#include "public/xccdf_benchmark.h"
+#include "source/public/oscap_source.h"
+
+/**
+ * Import the XCCDF benchmark from the source and resolve it.
+ * If the model cache is configured (see common/oscap_model_cache.h) and the
+ * source has a digest, the resolved benchmark is loaded from the cache when
+ * there is a record for the digest. Otherwise the benchmark is parsed and
+ * resolved and the record is written for the next time. Benchmarks with
+ * TestResults or an embedded CPE dictionary are never cached.
+ * @memberof xccdf_benchmark
+ * @param source The oscap_source to import from
+ * @returns resolved benchmark or NULL on parse error
+ */
+struct xccdf_benchmark *xccdf_benchmark_import_resolved_source(struct oscap_source *source);
+
+#endif
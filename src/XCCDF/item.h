@@ -323,6 +323,7 @@ struct xccdf_profile_note {
 
 struct xccdf_fix {
 	bool reboot;
+	bool def_reboot;
 	xccdf_strategy_t strategy;
 	xccdf_level_t disruption;
 	xccdf_level_t complexity;
@@ -446,6 +447,8 @@ char *xccdf_benchmark_gen_id(struct xccdf_benchmark *benchmark, xccdf_type_t typ
 struct xccdf_result *xccdf_benchmark_get_result_by_id(struct xccdf_benchmark *benchmark, const char *testresult_id);
 struct xccdf_result *xccdf_benchmark_get_result_by_id_suffix(struct xccdf_benchmark *benchmark, const char *testresult_suffix);
 bool xccdf_add_item(struct oscap_list *list, struct xccdf_item *parent, struct xccdf_item *item, const char *prefix);
+/// Remove the TestResult added by xccdf_benchmark_add_result() and free it
+bool xccdf_benchmark_remove_result(struct xccdf_benchmark *benchmark, struct xccdf_result *result);
 
 struct xccdf_tailoring *xccdf_tailoring_parse(xmlTextReaderPtr reader, struct xccdf_item* benchmark);
 xmlNodePtr xccdf_tailoring_to_dom(struct xccdf_tailoring *tailoring, xmlDocPtr doc, xmlNodePtr parent, const struct xccdf_version_info *version_info);
@@ -470,6 +473,7 @@ struct xccdf_check_iterator *xccdf_rule_get_complex_checks(struct xccdf_item *ru
 
 struct xccdf_item *xccdf_value_parse(xmlTextReaderPtr reader, struct xccdf_item *parent);
 struct xccdf_item *xccdf_value_new_internal(struct xccdf_item *parent, xccdf_value_type_t type);
+struct xccdf_value_instance *xccdf_value_instance_new(xccdf_value_type_t type);
 void xccdf_value_dump(struct xccdf_item *value, int depth);
 
 struct xccdf_notice *xccdf_notice_new_parse(xmlTextReaderPtr reader);
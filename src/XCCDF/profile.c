@@ -294,7 +294,7 @@ struct xccdf_item *xccdf_profile_parse(xmlTextReaderPtr reader, struct xccdf_ite
 				dW("Encountered an unknown element '%s' while parsing XCCDF profile.",
 				   xmlTextReaderConstLocalName(reader));
 		}
-		xmlTextReaderRead(reader);
+		xmlTextReaderNextNode(reader);
 	}
 
 	return prof;
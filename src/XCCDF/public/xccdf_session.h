@@ -159,6 +159,20 @@ OSCAP_API void xccdf_session_set_signature_enforcement(struct xccdf_session *ses
  */
 OSCAP_API void xccdf_session_set_thin_results(struct xccdf_session *session, bool thin_result);
 
+/**
+ * Set the number of rules evaluated at once.
+ * The checks of the engines which can't evaluate concurrently (e.g. OVAL)
+ * are still evaluated one at a time in the order of the rules, the checks
+ * of the other engines (e.g. SCE) are evaluated alongside. The engines may
+ * collect the data for the checks of the following rules at once beforehand
+ * (the OVAL probes collect the objects concurrently). The rule-results
+ * are reported in the order of the rules regardless of the number.
+ * @memberof xccdf_session
+ * @param session XCCDF Session
+ * @param jobs number of rules, 0 or 1 to evaluate the rules in turn (default)
+ */
+OSCAP_API void xccdf_session_set_jobs(struct xccdf_session *session, unsigned int jobs);
+
 /**
  * Set requested datastream_id for this session. This datastream_id is later
  * passed down to @ref ds_sds_index_select_checklist to determine target component.
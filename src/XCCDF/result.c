@@ -77,6 +77,7 @@
 #include "common/_error.h"
 #include "oscap_text.h"
 #include "common/debug_priv.h"
+#include "common/xml_stream.h"
 #include "source/oscap_source_priv.h"
 #include "oscap_helpers.h"
 
@@ -962,10 +963,13 @@ struct xccdf_result *xccdf_result_import_source(struct oscap_source *source)
 	if (reader == NULL) {
 		return NULL;
 	}
-	while (xmlTextReaderRead(reader) == 1
+	while (xmlTextReaderNextNode(reader) == 1
 			&& xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT);
 	struct xccdf_result *result = xccdf_result_new_parse(reader);
-	xmlFreeTextReader(reader);
+	if (oscap_source_free_xmlTextReader(reader) != 0) {
+		xccdf_result_free(result);
+		result = NULL;
+	}
 	return result;
 }
 
@@ -1017,13 +1021,13 @@ struct xccdf_result *xccdf_result_new_parse(xmlTextReaderPtr reader)
 			break;
 		case XCCDFE_TARGET_FACTS:
 			// we have to read inside the target-facts element
-			xmlTextReaderRead(reader);
+			xmlTextReaderNextNode(reader);
 
 			// iterate over all inner elements of the target-facts element
 			while (oscap_to_start_element(reader, depth + 1)) {
 				if (xccdf_element_get(reader) == XCCDFE_FACT)
 					oscap_list_add(res->sub.result.target_facts, xccdf_target_fact_new_parse(reader));
-				xmlTextReaderRead(reader);
+				xmlTextReaderNextNode(reader);
 			}
 			break;
 		case XCCDFE_TARGET_IDENTIFIER:
@@ -1050,7 +1054,7 @@ struct xccdf_result *xccdf_result_new_parse(xmlTextReaderPtr reader)
 
 		// TODO: any element from other namespace is supposed to go into xccdf_target_identifier
 		}
-		xmlTextReaderRead(reader);
+		xmlTextReaderNextNode(reader);
 	}
 
 	return XRESULT(res);
@@ -1316,6 +1320,7 @@ void xccdf_result_to_dom(struct xccdf_result *result, xmlNode *result_node, xmlD
 	while (xccdf_rule_result_iterator_has_more(rule_results)) {
 		struct xccdf_rule_result *rule_result = xccdf_rule_result_iterator_next(rule_results);
 		xccdf_rule_result_to_dom(rule_result, doc, result_node, version_info, associated_benchmark, use_stig_rule_id, nodes_by_rule_id);
+		oscap_xml_stream_flush(doc, result_node);
 	}
 	xccdf_rule_result_iterator_free(rule_results);
 
@@ -1374,8 +1379,9 @@ static struct xccdf_target_identifier *xccdf_target_identifier_new_parse(xmlText
 		xccdf_target_identifier_set_name(ret, xccdf_attribute_get(reader, XCCDFA_NAME));
 	}
 	else {
-		// this is OK because we clone the node in the setter
-		xccdf_target_identifier_set_xml_node(ret, xmlTextReaderCurrentNode(reader));
+		// this is OK because we clone the node in the setter, the node has
+		// to be expanded first when the reader is streaming
+		xccdf_target_identifier_set_xml_node(ret, xmlTextReaderExpand(reader));
 	}
 
 	return ret;
@@ -1434,7 +1440,7 @@ static struct xccdf_rule_result *xccdf_rule_result_new_parse(xmlTextReaderPtr re
 			break;
 		default: break;
 		}
-		xmlTextReaderRead(reader);
+		xmlTextReaderNextNode(reader);
 	}
 
 	return rr;
@@ -1639,7 +1645,7 @@ static struct xccdf_override *xccdf_override_new_parse(xmlTextReaderPtr reader)
 			break;
 		default: break;
 		}
-		xmlTextReaderRead(reader);
+		xmlTextReaderNextNode(reader);
 	}
 
 	return override;
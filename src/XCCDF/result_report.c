@@ -0,0 +1,2733 @@
+/*
+ * Copyright 2026 Red Hat Inc., Durham, North Carolina.
+ * All Rights Reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+/*
+ * Native HTML report generator.
+ *
+ * The report is the same, byte for byte, as the one xccdf-report.xsl
+ * produces from the ARF of the evaluation. Instead of exporting the ARF and
+ * transforming it, the report is rendered directly from the XCCDF and OVAL
+ * models. Every fragment of the report is built as a small HTML subtree in
+ * a scratch document, serialized by the same libxml2 HTML serializer
+ * libxslt uses for the "html" output method and freed right away, so the
+ * memory footprint doesn't grow with the size of the report.
+ *
+ * The CSS, JavaScript and logo are taken from the installed stylesheets, so
+ * the branding customizations of xccdf-branding.xsl apply to both
+ * generators.
+ *
+ * Benchmarks the resolution changed, the ones with their own TestResults and
+ * the ones writing booleans as "1"/"0" or selectors as "" aren't rendered
+ * here, see xccdf_benchmark_html_report_supported(); the session falls back
+ * to the transformation for them. Namespace declarations are copied the way
+ * libxslt copies them, except for a declaration of a schema invalid element
+ * that only its descendants use, which the stylesheet may keep on the
+ * element itself.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef OS_WINDOWS
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <libxml/HTMLtree.h>
+#include <libxml/parser.h>
+#include <libxml/tree.h>
+#include <libxml/xpath.h>
+#include <libxml/xpathInternals.h>
+
+#include "item.h"
+#include "helpers.h"
+#include "elements.h"
+#include "xccdf_impl.h"
+#include "common/_error.h"
+#include "common/debug_priv.h"
+#include "common/list.h"
+#include "common/oscapxml.h"
+#include "common/util.h"
+#include "common/oscap_string.h"
+#include "oscap_helpers.h"
+#include "oscap_source.h"
+#include "source/oscap_source_priv.h"
+#include "OVAL/results/oval_results_impl.h"
+#include "OVAL/public/oval_system_characteristics.h"
+#include "result_report_priv.h"
+
+#define XCCDF11_NS "http://checklists.nist.gov/xccdf/1.1"
+#define XCCDF12_NS "http://checklists.nist.gov/xccdf/1.2"
+#define OVAL5_CHECK_SYSTEM "http://oval.mitre.org/XMLSchema/oval-definitions-5"
+#define SCE_CHECK_SYSTEM "http://open-scap.org/page/SCE"
+#define SCE_RESULTS_NS "http://open-scap.org/page/SCE_result_file"
+#define XSLT_NS "http://www.w3.org/1999/XSL/Transform"
+
+#define NBSP "\xc2\xa0"
+
+/* libxml2 indents the saved documents by 2 spaces per level up to this limit */
+#define XML_SAVE_MAX_INDENT 60
+/* depth of oval-res:definition/oval-res:criteria in a saved OVAL results document */
+#define OVAL_RESULTS_CRITERIA_DEPTH 5
+/* depth of the items in oval-res:system/oval-sc:oval_system_characteristics/oval-sc:system_data */
+#define OVAL_RESULTS_ITEM_DEPTH 5
+/* the report lists only the first so many items of a test */
+#define OVAL_TEST_ITEMS_LIMIT 100
+
+struct xccdf_report_definition {
+	struct oval_result_definition *definition;
+	oval_result_directive_content_t content;
+	unsigned int position;	/* the position in the ARF, definitions are listed in the document order */
+};
+
+struct xccdf_report {
+	xmlOutputBuffer *out;
+	xmlDoc *doc;			/* scratch document the fragments are built in */
+	struct xccdf_item *result;
+	struct xccdf_item *benchmark;
+	struct xccdf_item *profile;
+	const char *benchmark_uri;
+	char *sce_template;
+	struct oscap_htable *rule_results;	/* rule id -> list of rule results */
+	struct oscap_htable *rule_counts;	/* item id -> struct xccdf_report_counts */
+	struct oscap_htable *generated_ids;	/* generate-id() of the stylesheet */
+	unsigned int last_id;
+	/* OVAL results of all the reports, as the keys of the stylesheet see them */
+	const char *oval_report_id;
+	struct oscap_htable *oval_definitions;	/* definition id -> list of struct xccdf_report_definition */
+	struct oscap_htable *oval_tests;	/* test id -> list of result tests */
+	struct oscap_htable *oval_items;	/* item id -> list of system items */
+	struct oscap_htable *oval_objects;	/* object id -> list of collected objects */
+	unsigned int oval_position;
+};
+
+/* Numbers of the descendant rules of an item with given results */
+struct xccdf_report_counts {
+	unsigned int rules;
+	unsigned int fail;
+	unsigned int error;
+	unsigned int unknown;
+	unsigned int notchecked;
+	unsigned int notselected;
+};
+
+/* Whether the cdf:TestResult is passed to the substitution and whether the text is a cdf:fix */
+struct xccdf_report_sub {
+	bool testresult;
+	bool fix;
+};
+
+static const struct xccdf_report_sub SUB_PLAIN = { .testresult = false, .fix = false };
+static const struct xccdf_report_sub SUB_TESTRESULT = { .testresult = true, .fix = false };
+static const struct xccdf_report_sub SUB_FIX = { .testresult = true, .fix = true };
+
+/*
+ * Output
+ */
+
+static inline void _report_write(struct xccdf_report *report, const char *str)
+{
+	xmlOutputBufferWriteString(report->out, str);
+}
+
+/* Serialize a complete fragment and free it */
+static void _report_flush(struct xccdf_report *report, xmlNode *node)
+{
+	htmlNodeDumpFormatOutput(report->out, report->doc, node, "utf-8", 0);
+	xmlUnlinkNode(node);
+	xmlFreeNode(node);
+}
+
+static void _report_write_text(struct xccdf_report *report, const char *text)
+{
+	if (text == NULL || *text == '\0')
+		return;
+	_report_flush(report, xmlNewDocText(report->doc, BAD_CAST text));
+}
+
+static xmlNode *_report_element(struct xccdf_report *report, xmlNode *parent, const char *name, const char *class_attr)
+{
+	xmlNode *node = xmlNewDocNode(report->doc, NULL, BAD_CAST name, NULL);
+	if (parent != NULL)
+		xmlAddChild(parent, node);
+	if (class_attr != NULL)
+		xmlNewProp(node, BAD_CAST "class", BAD_CAST class_attr);
+	return node;
+}
+
+static void _report_text(struct xccdf_report *report, xmlNode *parent, const char *text)
+{
+	if (text == NULL || *text == '\0')
+		return;
+	xmlAddChild(parent, xmlNewDocText(report->doc, BAD_CAST text));
+}
+
+static xmlNode *_report_text_element(struct xccdf_report *report, xmlNode *parent, const char *name, const char *class_attr, const char *text)
+{
+	xmlNode *node = _report_element(report, parent, name, class_attr);
+	_report_text(report, node, text);
+	return node;
+}
+
+/* number() formatted as the string() of XPath */
+static char *_report_number_to_string(double number)
+{
+	xmlChar *str = xmlXPathCastNumberToString(number);
+	char *ret = oscap_strdup(str != NULL ? (const char *) str : "NaN");
+	xmlFree(str);
+	return ret;
+}
+
+static void _report_number(struct xccdf_report *report, xmlNode *parent, double number)
+{
+	char *str = _report_number_to_string(number);
+	_report_text(report, parent, str);
+	free(str);
+}
+
+static void _report_width(xmlNode *node, double percent)
+{
+	char *number = _report_number_to_string(percent);
+	char *style = oscap_sprintf("width: %s%%", number);
+	xmlNewProp(node, BAD_CAST "style", BAD_CAST style);
+	free(style);
+	free(number);
+}
+
+/* round() of XPath */
+static double _report_round(double number)
+{
+	if (isnan(number) || isinf(number))
+		return number;
+	if (number >= -0.5 && number < 0.5)
+		return number * 0.0;
+	double rounded = floor(number);
+	if (number - rounded >= 0.5)
+		rounded += 1.0;
+	return rounded;
+}
+
+static bool _report_is_blank(const char *str)
+{
+	if (str == NULL)
+		return true;
+	for (; *str; str++) {
+		if (*str != ' ' && *str != '\t' && *str != '\n' && *str != '\r')
+			return false;
+	}
+	return true;
+}
+
+/* generate-id() of the stylesheet, ids are assigned in the order of the first use */
+static const char *_report_generate_id(struct xccdf_report *report, const void *node)
+{
+	char key[32];
+	snprintf(key, sizeof(key), "%p", node);
+	char *id = oscap_htable_get(report->generated_ids, key);
+	if (id == NULL) {
+		id = oscap_sprintf("id%u", ++report->last_id);
+		oscap_htable_add(report->generated_ids, key, id);
+	}
+	return id;
+}
+
+/* Indentation the XML documents are saved with */
+static void _report_indent(struct xccdf_report *report, xmlNode *parent, int depth)
+{
+	char indent[XML_SAVE_MAX_INDENT + 2] = "\n";
+	int width = 2 * depth > XML_SAVE_MAX_INDENT ? XML_SAVE_MAX_INDENT : 2 * depth;
+	memset(indent + 1, ' ', width);
+	indent[width + 1] = '\0';
+	_report_text(report, parent, indent);
+}
+
+/* Read the XML file, the document is owned by the caller */
+static xmlDoc *_report_read_file(const char *path)
+{
+	struct oscap_source *source = oscap_source_new_from_file(path);
+	xmlDoc *doc = oscap_source_pop_xmlDoc(source);
+	oscap_source_free(source);
+	return doc;
+}
+
+static bool _report_load_file(struct xccdf_report *report, const char *file, xmlDoc **doc)
+{
+	char *path = oscap_sprintf("%s/%s", oscap_path_to_xslt(), file);
+	*doc = _report_read_file(path);
+	if (*doc == NULL)
+		oscap_seterr(OSCAP_EFAMILY_OSCAP, "Could not read '%s' the HTML report is built from", path);
+	free(path);
+	return *doc != NULL;
+}
+
+/* Find the named xsl:template of the stylesheet */
+static xmlNode *_report_find_template(xmlDoc *doc, const char *name)
+{
+	xmlNode *root = xmlDocGetRootElement(doc);
+	for (xmlNode *node = root ? root->children : NULL; node != NULL; node = node->next) {
+		if (node->type != XML_ELEMENT_NODE || node->ns == NULL || !xmlStrEqual(node->ns->href, BAD_CAST XSLT_NS)
+		    || !xmlStrEqual(node->name, BAD_CAST "template"))
+			continue;
+		xmlChar *template_name = xmlGetProp(node, BAD_CAST "name");
+		bool found = xmlStrEqual(template_name, BAD_CAST name);
+		xmlFree(template_name);
+		if (found)
+			return node;
+	}
+	return NULL;
+}
+
+/* The text the template outputs, whitespace-only text nodes are stripped from stylesheets */
+static void _report_write_template_text(struct xccdf_report *report, xmlDoc *doc, const char *name)
+{
+	xmlNode *template = _report_find_template(doc, name);
+	for (xmlNode *node = template ? template->children : NULL; node != NULL; node = node->next) {
+		if (node->type == XML_CDATA_SECTION_NODE
+		    || (node->type == XML_TEXT_NODE && !_report_is_blank((const char *) node->content)))
+			_report_write(report, (const char *) node->content);
+	}
+}
+
+/*
+ * Substitution of XCCDF texts, the "sub-testresult" mode of the stylesheet
+ */
+
+static void _report_sub_nodes(struct xccdf_report *report, xmlNode *parent, xmlNode *first, const struct xccdf_report_sub *sub, bool text_and_elements_only);
+
+static bool _report_is_xccdf_ns(const xmlNs *ns)
+{
+	return ns != NULL && (xmlStrEqual(ns->href, BAD_CAST XCCDF12_NS) || xmlStrEqual(ns->href, BAD_CAST XCCDF11_NS));
+}
+
+static struct xccdf_value_instance *_report_value_instance(struct xccdf_item *value, const char *selector)
+{
+	struct xccdf_value_instance *found = NULL;
+	if (value == NULL)
+		return NULL;
+	for (struct oscap_list_item *it = value->sub.value.instances->first; it != NULL; it = it->next) {
+		struct xccdf_value_instance *instance = it->data;
+		if (instance->flags.value_given && oscap_streq(instance->selector == NULL ? "" : instance->selector, selector))
+			found = instance;
+	}
+	return found;
+}
+
+static struct xccdf_setvalue *_report_setvalue(struct oscap_list *setvalues, const char *idref)
+{
+	struct xccdf_setvalue *found = NULL;
+	for (struct oscap_list_item *it = setvalues->first; it != NULL; it = it->next) {
+		struct xccdf_setvalue *setvalue = it->data;
+		if (oscap_streq(setvalue->item, idref))
+			found = setvalue;
+	}
+	return found;
+}
+
+static void _report_abbr(struct xccdf_report *report, xmlNode *parent, const char *title_prefix, const char *idref, const char *text)
+{
+	xmlNode *abbr = _report_text_element(report, parent, "abbr", NULL, text);
+	char *title = oscap_sprintf("%s%s", title_prefix, idref);
+	xmlNewProp(abbr, BAD_CAST "title", BAD_CAST title);
+	free(title);
+}
+
+/* cdf:sub */
+static void _report_sub_value(struct xccdf_report *report, xmlNode *parent, const char *idref, const struct xccdf_report_sub *sub)
+{
+	if (idref == NULL)
+		idref = "";
+
+	struct xccdf_setvalue *setvalue = NULL;
+	if (sub->testresult && (setvalue = _report_setvalue(report->result->sub.result.setvalues, idref)) != NULL) {
+		_report_abbr(report, parent, "from TestResult: ", idref, setvalue->value);
+		return;
+	}
+	if (report->profile != NULL && (setvalue = _report_setvalue(report->profile->sub.profile.setvalues, idref)) != NULL) {
+		_report_abbr(report, parent, "from Profile/set-value: ", idref, setvalue->value);
+		return;
+	}
+
+	struct xccdf_item *item = XITEM(xccdf_benchmark_get_item(XBENCHMARK(report->benchmark), idref));
+	if (item != NULL && item->type != XCCDF_VALUE)
+		item = NULL;
+
+	struct xccdf_refine_value *refine = NULL;
+	if (report->profile != NULL) {
+		for (struct oscap_list_item *it = report->profile->sub.profile.refine_values->first; it != NULL; it = it->next) {
+			struct xccdf_refine_value *refine_value = it->data;
+			if (oscap_streq(refine_value->item, idref))
+				refine = refine_value;
+		}
+	}
+	if (refine != NULL) {
+		struct xccdf_value_instance *instance = NULL;
+		if (refine->selector != NULL && *refine->selector != '\0')
+			instance = _report_value_instance(item, refine->selector);
+		_report_abbr(report, parent, "from Profile/refine-value: ", idref, instance ? instance->value : NULL);
+		return;
+	}
+
+	struct xccdf_value_instance *instance = _report_value_instance(item, "");
+	if (instance != NULL && item->item.flags.prohibit_changes)
+		_report_text(report, parent, instance->value);
+	else if (instance != NULL)
+		_report_abbr(report, parent, "from Benchmark/Value: ", idref, instance->value);
+	else
+		_report_abbr(report, parent, "Substitution failed: ", idref, "(N/A)");
+}
+
+/* cdf:instance of a cdf:fix */
+static void _report_sub_instance(struct xccdf_report *report, xmlNode *parent, const char *context)
+{
+	const char *content = NULL;
+	if (context != NULL) {
+		for (struct oscap_list_item *it = report->result->sub.result.rule_results->first; it != NULL && content == NULL; it = it->next) {
+			struct xccdf_rule_result *rule_result = it->data;
+			for (struct oscap_list_item *iit = rule_result->instances->first; iit != NULL; iit = iit->next) {
+				struct xccdf_instance *instance = iit->data;
+				if (oscap_streq(instance->context, context)) {
+					content = instance->content ? instance->content : "";
+					break;
+				}
+			}
+		}
+	}
+
+	if (content != NULL) {
+		_report_abbr(report, parent, "context: ", context, content);
+	} else {
+		xmlNode *abbr = _report_text_element(report, parent, "abbr", "cdf-sub-context", context);
+		char *title = oscap_sprintf("replace with actual %s context", context ? context : "");
+		xmlNewProp(abbr, BAD_CAST "title", BAD_CAST title);
+		free(title);
+	}
+}
+
+/* The namespace of a copied element, XCCDF 1.1 is seen as XCCDF 1.2 by the stylesheet */
+static bool _report_ns_used(const xmlNode *node, const xmlNs *ns, bool descendants)
+{
+	if (node->ns == ns)
+		return true;
+	for (const xmlAttr *attr = node->properties; attr != NULL; attr = attr->next) {
+		if (attr->ns == ns)
+			return true;
+	}
+	for (const xmlNode *child = descendants ? node->children : NULL; child != NULL; child = child->next) {
+		if (child->type == XML_ELEMENT_NODE && _report_ns_used(child, ns, true))
+			return true;
+	}
+	return false;
+}
+
+/*
+ * The text markup is saved with the declarations of the namespaces used by
+ * the descendants of an element on the element, unless they are declared
+ * inside. The stylesheet copies only the declarations written on the
+ * element, the others are declared where they are used.
+ */
+static bool _report_ns_reconciled(const xmlNode *node, const xmlNs *ns)
+{
+	if (_report_ns_used(node, ns, false))
+		return false;
+	for (const xmlNode *child = node->children; child != NULL; child = child->next) {
+		if (child->type == XML_ELEMENT_NODE && _report_ns_used(child, ns, true))
+			return true;
+	}
+	return false;
+}
+
+/* A namespace declaration copied by xsl:copy, unless the same one is in scope */
+static void _report_copy_ns_def(xmlNode *copy, const xmlNs *ns)
+{
+	xmlNs *in_scope = xmlSearchNs(copy->doc, copy, ns->prefix);
+	if (in_scope == NULL || !xmlStrEqual(in_scope->href, ns->href))
+		xmlNewNs(copy, ns->href, ns->prefix);
+}
+
+static void _report_copy_ns(xmlNode *copy, const xmlNs *ns)
+{
+	const xmlChar *href = ns->href;
+	const xmlChar *prefix = ns->prefix;
+	if (xmlStrEqual(href, BAD_CAST XCCDF11_NS)) {
+		href = BAD_CAST XCCDF12_NS;
+		prefix = BAD_CAST "cdf12";
+	}
+	xmlNs *in_scope = xmlSearchNs(copy->doc, copy, prefix);
+	if (in_scope != NULL && xmlStrEqual(in_scope->href, href))
+		xmlSetNs(copy, in_scope);
+	else
+		xmlSetNs(copy, xmlNewNs(copy, href, prefix));
+}
+
+static void _report_sub_element(struct xccdf_report *report, xmlNode *parent, xmlNode *node, const struct xccdf_report_sub *sub)
+{
+	if (_report_is_xccdf_ns(node->ns) && xmlStrEqual(node->name, BAD_CAST "sub")) {
+		xmlChar *idref = xmlGetProp(node, BAD_CAST "idref");
+		_report_sub_value(report, parent, (const char *) idref, sub);
+		xmlFree(idref);
+	} else if (sub->fix && _report_is_xccdf_ns(node->ns) && xmlStrEqual(node->name, BAD_CAST "instance")) {
+		xmlChar *context = xmlGetProp(node, BAD_CAST "context");
+		_report_sub_instance(report, parent, (const char *) context);
+		xmlFree(context);
+	} else if (node->ns != NULL && xmlStrEqual(node->ns->href, XCCDF_XHTML_NAMESPACE)) {
+		/* XHTML elements are stripped of the namespace */
+		xmlNode *copy = _report_element(report, parent, (const char *) node->name, NULL);
+		if (!xmlStrEqual(node->name, BAD_CAST "br")) {
+			copy->properties = xmlCopyPropList(copy, node->properties);
+			_report_sub_nodes(report, copy, node->children, sub, true);
+		}
+	} else {
+		xmlNode *copy = _report_element(report, parent, (const char *) node->name, NULL);
+		for (const xmlNs *ns = node->nsDef; ns != NULL; ns = ns->next) {
+			if (!_report_ns_reconciled(node, ns))
+				_report_copy_ns_def(copy, ns);
+		}
+		if (node->ns != NULL)
+			_report_copy_ns(copy, node->ns);
+		copy->properties = xmlCopyPropList(copy, node->properties);
+		_report_sub_nodes(report, copy, node->children, sub, false);
+	}
+}
+
+static void _report_sub_nodes(struct xccdf_report *report, xmlNode *parent, xmlNode *first, const struct xccdf_report_sub *sub, bool text_and_elements_only)
+{
+	for (xmlNode *node = first; node != NULL; node = node->next) {
+		switch (node->type) {
+		case XML_TEXT_NODE:
+		case XML_CDATA_SECTION_NODE:
+			_report_text(report, parent, (const char *) node->content);
+			break;
+		case XML_ELEMENT_NODE:
+			_report_sub_element(report, parent, node, sub);
+			break;
+		case XML_COMMENT_NODE:
+		case XML_PI_NODE:
+			if (!text_and_elements_only)
+				xmlAddChild(parent, xmlDocCopyNode(node, report->doc, 1));
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+/* Parse the markup of a text as oscap_xmlstr_to_dom() does */
+static xmlDoc *_report_parse_markup(const char *markup)
+{
+	char *str = oscap_sprintf("<x xmlns:xhtml='http://www.w3.org/1999/xhtml'>%s</x>", markup ? markup : "");
+	xmlDoc *doc = xmlReadMemory(str, strlen(str), NULL, NULL,
+		XML_PARSE_RECOVER | XML_PARSE_NOERROR | XML_PARSE_NOWARNING | XML_PARSE_NONET | XML_PARSE_NSCLEAN);
+	free(str);
+	return doc;
+}
+
+static void _report_sub_markup(struct xccdf_report *report, xmlNode *parent, const char *markup, const struct xccdf_report_sub *sub)
+{
+	xmlDoc *doc = _report_parse_markup(markup);
+	xmlNode *root = doc ? xmlDocGetRootElement(doc) : NULL;
+	if (root != NULL)
+		_report_sub_nodes(report, parent, root->children, sub, false);
+	xmlFreeDoc(doc);
+}
+
+static void _report_sub_text(struct xccdf_report *report, xmlNode *parent, const struct oscap_text *text, const struct xccdf_report_sub *sub)
+{
+	if (text == NULL)
+		return;
+	if (text->traits.html || text->traits.can_substitute)
+		_report_sub_markup(report, parent, text->text, sub);
+	else
+		_report_text(report, parent, text->text);
+}
+
+static void _report_sub_texts(struct xccdf_report *report, xmlNode *parent, struct oscap_list *texts, const struct xccdf_report_sub *sub)
+{
+	for (struct oscap_list_item *it = texts->first; it != NULL; it = it->next)
+		_report_sub_text(report, parent, it->data, sub);
+}
+
+/* Whether the exported element of the text has a text child, $text/text() */
+static bool _report_text_has_text_child(const struct oscap_text *text)
+{
+	if (text == NULL || text->text == NULL)
+		return false;
+	if (!(text->traits.html || text->traits.can_substitute))
+		return *text->text != '\0';
+
+	bool found = false;
+	xmlDoc *doc = _report_parse_markup(text->text);
+	xmlNode *root = doc ? xmlDocGetRootElement(doc) : NULL;
+	for (xmlNode *node = root ? root->children : NULL; node != NULL && !found; node = node->next)
+		found = node->type == XML_TEXT_NODE || node->type == XML_CDATA_SECTION_NODE;
+	xmlFreeDoc(doc);
+	return found;
+}
+
+static bool _report_texts_have_text_child(struct oscap_list *texts)
+{
+	for (struct oscap_list_item *it = texts->first; it != NULL; it = it->next) {
+		if (_report_text_has_text_child(it->data))
+			return true;
+	}
+	return false;
+}
+
+/* The first text child of the exported element of the text, $text/text() */
+static char *_report_text_first_text_child(const struct oscap_text *text)
+{
+	if (text == NULL || text->text == NULL)
+		return NULL;
+	if (!(text->traits.html || text->traits.can_substitute))
+		return oscap_strdup(text->text);
+
+	char *ret = NULL;
+	xmlDoc *doc = _report_parse_markup(text->text);
+	xmlNode *root = doc ? xmlDocGetRootElement(doc) : NULL;
+	for (xmlNode *node = root ? root->children : NULL; node != NULL && ret == NULL; node = node->next) {
+		if (node->type == XML_TEXT_NODE || node->type == XML_CDATA_SECTION_NODE)
+			ret = oscap_strdup((const char *) node->content);
+	}
+	xmlFreeDoc(doc);
+	return ret;
+}
+
+/* item-title */
+static void _report_item_title(struct xccdf_report *report, xmlNode *parent, struct xccdf_item *item)
+{
+	if (item->item.title->itemcount > 0) {
+		_report_sub_texts(report, parent, item->item.title, &SUB_PLAIN);
+	} else {
+		char *text = oscap_sprintf("\n            ID: %s", item->item.id);
+		_report_text(report, parent, text);
+		free(text);
+	}
+}
+
+/*
+ * Rule results
+ */
+
+static const char *_report_result_text(xccdf_test_result_type_t result)
+{
+	return XCCDF_RESULT_MAP[result - 1].string;
+}
+
+static const char *_report_result_tooltip(xccdf_test_result_type_t result)
+{
+	switch (result) {
+	case XCCDF_RESULT_PASS:
+		return "The target system or system component satisfied all the conditions of the rule.";
+	case XCCDF_RESULT_FIXED:
+		return "The Rule had failed, but was then fixed (possibly by a tool that can automatically apply remediation, or possibly by the human auditor).";
+	case XCCDF_RESULT_INFORMATIONAL:
+		return "The Rule was checked, but the output from the checking engine is simply information for auditors or administrators; it is not a compliance category. This status value is designed for Rule elements whose main purpose is to extract information from the target rather than test the target.";
+	case XCCDF_RESULT_FAIL:
+		return "The target system or system component did not satisfy at least one condition of the rule.";
+	case XCCDF_RESULT_ERROR:
+		return "The checking engine could not complete the evaluation, therefore the status of the target's compliance with the rule is not certain. This could happen, for example, if a testing tool was run with insufficient privileges and could not gather all of the necessary information.";
+	case XCCDF_RESULT_UNKNOWN:
+		return "The testing tool encountered some problem and the result is unknown. For example, a result of 'unknown' might be given if the testing tool was unable to interpret the output of the checking engine (the output has no meaning to the testing tool).";
+	case XCCDF_RESULT_NOT_CHECKED:
+		return "The Rule was not evaluated by the checking engine. This status is designed for Rule elements that have no check elements or that correspond to an unsupported checking system. It may also correspond to a status returned by a checking engine if the checking engine does not support the indicated check code.";
+	case XCCDF_RESULT_NOT_SELECTED:
+		return "The Rule was not selected in the evaluation. This may be caused by the rule not being selected by default in the benchmark or by the profile unselecting it.";
+	case XCCDF_RESULT_NOT_APPLICABLE:
+		return "The Rule was not applicable to the target of the test. For example, the Rule might have been specific to a different version of the target OS, or it might have been a test against a platform feature that was not installed.";
+	default:
+		return NULL;
+	}
+}
+
+static bool _report_result_needs_attention(xccdf_test_result_type_t result)
+{
+	return result == XCCDF_RESULT_FAIL || result == XCCDF_RESULT_ERROR || result == XCCDF_RESULT_UNKNOWN;
+}
+
+/* Rule results get into the report unless they are notselected */
+static bool _report_rule_result_shown(const struct xccdf_rule_result *rule_result)
+{
+	return rule_result->result != 0 && rule_result->result != XCCDF_RESULT_NOT_SELECTED;
+}
+
+static void _report_result_cell(struct xccdf_report *report, xmlNode *td, xccdf_test_result_type_t result)
+{
+	xmlNode *abbr = _report_text_element(report, _report_element(report, td, "div", NULL), "abbr", NULL, _report_result_text(result));
+	xmlNewProp(abbr, BAD_CAST "title", BAD_CAST _report_result_tooltip(result));
+}
+
+static const char *_report_rule_result_severity(const struct xccdf_rule_result *rule_result)
+{
+	if (rule_result->severity == XCCDF_LEVEL_NOT_DEFINED)
+		return NULL;
+	return XCCDF_LEVEL_MAP[rule_result->severity - 1].string;
+}
+
+/* The checks of a rule result, cdf:complex-check is not a cdf:check */
+#define RULE_RESULT_CHECKS_FOREACH(rule_result, check) \
+	for (struct oscap_list_item *_it = (rule_result)->checks->first; _it != NULL; _it = _it->next) \
+		for (struct xccdf_check *check = _it->data; check != NULL; check = NULL) \
+			if (!xccdf_check_get_complex(check))
+
+static bool _report_rule_result_multicheck(const struct xccdf_rule_result *rule_result)
+{
+	RULE_RESULT_CHECKS_FOREACH(rule_result, check) {
+		if (check->flags.multicheck)
+			return true;
+	}
+	return false;
+}
+
+static bool _report_rule_result_has_check_system(const struct xccdf_rule_result *rule_result, const char *system)
+{
+	RULE_RESULT_CHECKS_FOREACH(rule_result, check) {
+		if (oscap_streq(check->system, system))
+			return true;
+	}
+	return false;
+}
+
+/* cdf:check/cdf:check-content-ref/@name */
+static const char *_report_rule_result_first_content_ref_name(const struct xccdf_rule_result *rule_result)
+{
+	RULE_RESULT_CHECKS_FOREACH(rule_result, check) {
+		for (struct oscap_list_item *it = check->content_refs->first; it != NULL; it = it->next) {
+			struct xccdf_check_content_ref *ref = it->data;
+			if (ref->name != NULL)
+				return ref->name;
+		}
+	}
+	return NULL;
+}
+
+static void _report_count_rule(struct xccdf_report *report, struct xccdf_item *rule, struct xccdf_report_counts *counts)
+{
+	bool fail = false, error = false, unknown = false, notchecked = false, notselected = false;
+	struct oscap_list *rule_results = oscap_htable_get(report->rule_results, rule->item.id);
+	for (struct oscap_list_item *it = rule_results ? rule_results->first : NULL; it != NULL; it = it->next) {
+		struct xccdf_rule_result *rule_result = it->data;
+		fail |= rule_result->result == XCCDF_RESULT_FAIL;
+		error |= rule_result->result == XCCDF_RESULT_ERROR;
+		unknown |= rule_result->result == XCCDF_RESULT_UNKNOWN;
+		notchecked |= rule_result->result == XCCDF_RESULT_NOT_CHECKED;
+		notselected |= rule_result->result == XCCDF_RESULT_NOT_SELECTED;
+	}
+	counts->rules++;
+	counts->fail += fail;
+	counts->error += error;
+	counts->unknown += unknown;
+	counts->notchecked += notchecked;
+	counts->notselected += notselected;
+}
+
+static struct oscap_list *_report_item_content(struct xccdf_item *item)
+{
+	return item->type == XCCDF_BENCHMARK ? item->sub.benchmark.content : item->sub.group.content;
+}
+
+/* Count the results of the descendant rules of all the groups at once */
+static void _report_count_rules(struct xccdf_report *report, struct xccdf_item *item, struct xccdf_report_counts *parent_counts)
+{
+	struct xccdf_report_counts *counts = calloc(1, sizeof(struct xccdf_report_counts));
+	for (struct oscap_list_item *it = _report_item_content(item)->first; it != NULL; it = it->next) {
+		struct xccdf_item *child = it->data;
+		if (child->type == XCCDF_GROUP)
+			_report_count_rules(report, child, counts);
+		else if (child->type == XCCDF_RULE)
+			_report_count_rule(report, child, counts);
+	}
+	if (parent_counts != NULL) {
+		parent_counts->rules += counts->rules;
+		parent_counts->fail += counts->fail;
+		parent_counts->error += counts->error;
+		parent_counts->unknown += counts->unknown;
+		parent_counts->notchecked += counts->notchecked;
+		parent_counts->notselected += counts->notselected;
+	}
+	if (!oscap_htable_add(report->rule_counts, item->item.id, counts))
+		free(counts);
+}
+
+/*
+ * Introduction, characteristics, compliance and scoring
+ */
+
+static void _report_introduction(struct xccdf_report *report)
+{
+	struct xccdf_item *benchmark = report->benchmark;
+	struct xccdf_item *profile = report->profile;
+
+	xmlNode *introduction = _report_element(report, NULL, "div", NULL);
+	xmlNewProp(introduction, BAD_CAST "id", BAD_CAST "introduction");
+	xmlNode *row = _report_element(report, introduction, "div", "row");
+
+	xmlNode *h2 = _report_element(report, row, "h2", NULL);
+	if (benchmark->item.title->itemcount > 0)
+		_report_sub_text(report, h2, benchmark->item.title->first->data, &SUB_PLAIN);
+	else
+		_report_text(report, h2, benchmark->item.id);
+
+	if (profile != NULL) {
+		xmlNode *blockquote = _report_text_element(report, row, "blockquote", NULL, "with profile ");
+		xmlNode *mark = _report_element(report, blockquote, "mark", NULL);
+		if (_report_texts_have_text_child(profile->item.title))
+			_report_sub_text(report, mark, profile->item.title->first->data, &SUB_PLAIN);
+		else
+			_report_text(report, mark, profile->item.id);
+		if (_report_texts_have_text_child(profile->item.description)) {
+			xmlNode *well = _report_element(report, blockquote, "div", "col-md-12 well well-lg horizontal-scroll");
+			xmlNode *description = _report_element(report, well, "div", "description profile-description");
+			_report_sub_text(report, _report_element(report, description, "small", NULL),
+					 profile->item.description->first->data, &SUB_PLAIN);
+		}
+	}
+
+	xmlNode *well = _report_element(report, row, "div", "col-md-12 well well-lg horizontal-scroll");
+	if (benchmark->sub.benchmark.front_matter->itemcount > 0)
+		_report_sub_text(report, _report_element(report, well, "div", "front-matter"),
+				 benchmark->sub.benchmark.front_matter->first->data, &SUB_PLAIN);
+	if (_report_texts_have_text_child(benchmark->item.description))
+		_report_sub_text(report, _report_element(report, well, "div", "description"),
+				 benchmark->item.description->first->data, &SUB_PLAIN);
+
+	bool notice_text = false;
+	for (struct oscap_list_item *it = benchmark->sub.benchmark.notices->first; it != NULL && !notice_text; it = it->next)
+		notice_text = _report_text_has_text_child(((struct xccdf_notice *) it->data)->text);
+	if (notice_text) {
+		xmlNode *notices = _report_element(report, well, "div", "top-spacer-10");
+		for (struct oscap_list_item *it = benchmark->sub.benchmark.notices->first; it != NULL; it = it->next) {
+			struct xccdf_notice *notice = it->data;
+			_report_sub_text(report, _report_element(report, notices, "div", "alert alert-info"), notice->text, &SUB_PLAIN);
+		}
+	}
+
+	_report_flush(report, introduction);
+}
+
+static void _report_characteristic(struct xccdf_report *report, xmlNode *table, const char *name, const char *value)
+{
+	xmlNode *tr = _report_element(report, table, "tr", NULL);
+	_report_text_element(report, tr, "th", NULL, name);
+	_report_text_element(report, tr, "td", NULL, value);
+}
+
+static const char *_report_fact_value(struct xccdf_report *report, const char *name)
+{
+	for (struct oscap_list_item *it = report->result->sub.result.target_facts->first; it != NULL; it = it->next) {
+		struct xccdf_target_fact *fact = it->data;
+		if (oscap_streq(fact->name, name))
+			return fact->value ? fact->value : "";
+	}
+	return NULL;
+}
+
+static void _report_address(struct xccdf_report *report, xmlNode *ul, const char *label_class, const char *label, const char *address)
+{
+	xmlNode *li = _report_element(report, ul, "li", "list-group-item");
+	if (label != NULL)
+		_report_text_element(report, li, "span", label_class, label);
+	char *text = oscap_sprintf("\n                            " NBSP "%s", address);
+	_report_text(report, li, text);
+	free(text);
+}
+
+static void _report_characteristics(struct xccdf_report *report)
+{
+	struct xccdf_item *result = report->result;
+	struct xccdf_item *benchmark = report->benchmark;
+
+	xmlNode *characteristics = _report_element(report, NULL, "div", NULL);
+	xmlNewProp(characteristics, BAD_CAST "id", BAD_CAST "characteristics");
+	_report_text_element(report, characteristics, "h2", NULL, "Evaluation Characteristics");
+	xmlNode *row = _report_element(report, characteristics, "div", "row");
+
+	xmlNode *table = _report_element(report, _report_element(report, row, "div", "col-md-5 well well-lg horizontal-scroll"), "table", "table table-bordered");
+	struct oscap_list *targets = result->sub.result.targets;
+	_report_characteristic(report, table, "Evaluation target", targets->first ? targets->first->data : NULL);
+	const char *target_id = _report_fact_value(report, "urn:xccdf:fact:identifier");
+	if (target_id != NULL)
+		_report_characteristic(report, table, "Target ID", target_id);
+	if (report->benchmark_uri != NULL) {
+		_report_characteristic(report, table, "Benchmark URL", report->benchmark_uri);
+		/* the TestResult is exported as a part of the benchmark */
+		if (xccdf_version_cmp(xccdf_item_get_schema_version(benchmark), "1.2") >= 0)
+			_report_characteristic(report, table, "Benchmark ID", benchmark->item.id);
+	}
+	if (benchmark->item.version != NULL)
+		_report_characteristic(report, table, "Benchmark version", benchmark->item.version);
+	if (result->sub.result.profile != NULL)
+		_report_characteristic(report, table, "Profile ID", result->sub.result.profile);
+	_report_characteristic(report, table, "Started at", result->sub.result.start_time ? result->sub.result.start_time :
+			       "\n                                    unknown time\n                                ");
+	_report_characteristic(report, table, "Finished at", result->sub.result.end_time);
+	struct oscap_list *identities = result->sub.result.identities;
+	_report_characteristic(report, table, "Performed by", identities->first ? ((struct xccdf_identity *) identities->first->data)->name :
+			       "\n                                    unknown user\n                                ");
+	_report_characteristic(report, table, "Test system", result->sub.result.test_system ? result->sub.result.test_system :
+			       "\n                                    unknown\n                                ");
+
+	xmlNode *platforms = _report_element(report, row, "div", "col-md-3 horizontal-scroll");
+	_report_text_element(report, platforms, "h4", NULL, "CPE Platforms");
+	xmlNode *ul = _report_element(report, platforms, "ul", "list-group");
+	/* all the applicable platforms first, then the rest */
+	for (int applicable = 1; applicable >= 0; applicable--) {
+		for (struct oscap_list_item *it = benchmark->item.platforms->first; it != NULL; it = it->next) {
+			const char *idref = it->data;
+			if (oscap_list_contains(result->sub.result.applicable_platforms, (void *) idref, (oscap_cmp_func) oscap_streq) != applicable)
+				continue;
+			xmlNode *li = _report_element(report, ul, "li", "list-group-item");
+			xmlNode *span = _report_text_element(report, li, "span", applicable ? "label label-success" : "label label-default", idref);
+			char *title = applicable ? oscap_sprintf("CPE platform %s was found applicable on the evaluated machine", idref)
+						 : oscap_strdup("This CPE platform was not applicable on the evaluated machine");
+			xmlNewProp(span, BAD_CAST "title", BAD_CAST title);
+			free(title);
+		}
+	}
+
+	xmlNode *addresses = _report_element(report, row, "div", "col-md-4 horizontal-scroll");
+	_report_text_element(report, addresses, "h4", NULL, "Addresses");
+	ul = _report_element(report, addresses, "ul", "list-group");
+	/* Addresses are not listed again when they are found anywhere before in
+	 * the ARF, that includes the TestResults stored in the benchmark */
+	struct oscap_htable *addresses_seen = oscap_htable_new();
+	struct oscap_htable *facts_seen = oscap_htable_new();
+	for (struct oscap_list_item *it = benchmark->sub.benchmark.results->first; it != NULL; it = it->next) {
+		struct xccdf_item *stored = it->data;
+		if (stored == result)
+			break;
+		/* the stored TestResults are in the ARF as they were read and also
+		 * as exported in the reports of their own */
+		for (struct oscap_list_item *ait = stored->sub.result.target_addresses->first; ait != NULL; ait = ait->next) {
+			oscap_htable_add(addresses_seen, ait->data, NULL);
+			if (strchr(ait->data, ':') != NULL) {
+				char *expanded = oscap_expand_ipv6(ait->data);
+				oscap_htable_add(addresses_seen, expanded, NULL);
+				free(expanded);
+			}
+		}
+		for (struct oscap_list_item *fit = stored->sub.result.target_facts->first; fit != NULL; fit = fit->next) {
+			struct xccdf_target_fact *fact = fit->data;
+			oscap_htable_add(facts_seen, fact->value ? fact->value : "", NULL);
+		}
+	}
+	for (struct oscap_list_item *it = result->sub.result.target_addresses->first; it != NULL; it = it->next) {
+		/* IPv6 addresses are exported expanded */
+		char *address = strchr(it->data, ':') != NULL ? oscap_expand_ipv6(it->data) : oscap_strdup(it->data);
+		if (oscap_htable_add(addresses_seen, address, NULL)) {
+			if (strchr(address, ':') != NULL)
+				_report_address(report, ul, "label label-info", "IPv6", address);
+			else if (strchr(address, '.') != NULL)
+				_report_address(report, ul, "label label-primary", "IPv4", address);
+			else
+				_report_address(report, ul, NULL, NULL, address);
+		}
+		free(address);
+	}
+	for (struct oscap_list_item *it = result->sub.result.target_facts->first; it != NULL; it = it->next) {
+		struct xccdf_target_fact *fact = it->data;
+		const char *value = fact->value ? fact->value : "";
+		if (oscap_htable_add(facts_seen, value, NULL) && oscap_streq(fact->name, "urn:xccdf:fact:ethernet:MAC"))
+			_report_address(report, ul, "label label-default", "MAC", value);
+	}
+	oscap_htable_free0(addresses_seen);
+	oscap_htable_free0(facts_seen);
+
+	_report_flush(report, characteristics);
+}
+
+static void _report_progress_bar(struct xccdf_report *report, xmlNode *progress, const char *class_attr, double width, const char *text)
+{
+	xmlNode *bar = _report_text_element(report, progress, "div", class_attr, text);
+	_report_width(bar, width);
+}
+
+static void _report_count_bar(struct xccdf_report *report, xmlNode *progress, const char *class_attr, double count, double total, const char *label)
+{
+	char *number = _report_number_to_string(count);
+	char *text = oscap_sprintf("%s%s", number, label);
+	_report_progress_bar(report, progress, class_attr, count / total * 100, text);
+	free(text);
+	free(number);
+}
+
+static void _report_compliance_and_scoring(struct xccdf_report *report)
+{
+	double total = 0, ignored = 0, passed = 0, failed = 0, uncertain = 0;
+	double failed_low = 0, failed_medium = 0, failed_high = 0;
+	for (struct oscap_list_item *it = report->result->sub.result.rule_results->first; it != NULL; it = it->next) {
+		struct xccdf_rule_result *rule_result = it->data;
+		if (rule_result->result == 0)
+			continue;
+		total++;
+		switch (rule_result->result) {
+		case XCCDF_RESULT_NOT_SELECTED:
+		case XCCDF_RESULT_NOT_APPLICABLE:
+			ignored++;
+			break;
+		case XCCDF_RESULT_PASS:
+		case XCCDF_RESULT_FIXED:
+			passed++;
+			break;
+		case XCCDF_RESULT_FAIL:
+			failed++;
+			failed_low += rule_result->severity == XCCDF_LOW;
+			failed_medium += rule_result->severity == XCCDF_MEDIUM;
+			failed_high += rule_result->severity == XCCDF_HIGH;
+			break;
+		case XCCDF_RESULT_ERROR:
+		case XCCDF_RESULT_UNKNOWN:
+			uncertain++;
+			break;
+		default:
+			break;
+		}
+	}
+	double not_ignored = total - ignored;
+
+	xmlNode *compliance = _report_element(report, NULL, "div", NULL);
+	xmlNewProp(compliance, BAD_CAST "id", BAD_CAST "compliance-and-scoring");
+	_report_text_element(report, compliance, "h2", NULL, "Compliance and Scoring");
+
+	char *failed_str = _report_number_to_string(failed);
+	char *uncertain_str = _report_number_to_string(uncertain);
+	char *text;
+	if (failed > 0) {
+		xmlNode *alert = _report_element(report, compliance, "div", "alert alert-danger");
+		text = oscap_sprintf("The target system did not satisfy the conditions of %s rules!", failed_str);
+		_report_text_element(report, alert, "strong", NULL, text);
+		free(text);
+		if (uncertain > 0) {
+			text = oscap_sprintf("\n                        Furthermore, the results of %s rules were inconclusive.\n                    ", uncertain_str);
+			_report_text(report, alert, text);
+			free(text);
+		}
+		_report_text(report, alert, "\n                    Please review rule results and consider applying remediation.\n                ");
+	} else if (uncertain > 0) {
+		xmlNode *alert = _report_element(report, compliance, "div", "alert alert-warning");
+		text = oscap_sprintf("There were no failed rules, but the results of %s rules were inconclusive!", uncertain_str);
+		_report_text_element(report, alert, "strong", NULL, text);
+		free(text);
+		_report_text(report, alert, "\n                    Please review rule results and consider applying remediation.\n                ");
+	} else {
+		xmlNode *alert = _report_element(report, compliance, "div", "alert alert-success");
+		_report_text_element(report, alert, "strong", NULL, "There were no failed or uncertain rules.");
+		_report_text(report, alert, " It seems that no action is necessary.\n                ");
+	}
+	free(uncertain_str);
+
+	_report_text_element(report, compliance, "h3", NULL, "Rule results");
+	if (not_ignored > 0) {
+		xmlNode *progress = _report_element(report, compliance, "div", "progress");
+		xmlNewProp(progress, BAD_CAST "title", BAD_CAST "Displays proportion of passed/fixed, failed/error, and other rules (in that order). There were $not_ignored_rules_count rules taken into account.");
+		_report_count_bar(report, progress, "progress-bar progress-bar-success", passed, not_ignored, " passed\n                    ");
+		_report_count_bar(report, progress, "progress-bar progress-bar-danger", failed, not_ignored, " failed\n                    ");
+		char *other = _report_number_to_string(not_ignored - passed - failed);
+		text = oscap_sprintf("%s other\n                    ", other);
+		_report_progress_bar(report, progress, "progress-bar progress-bar-warning", (1 - (passed + failed) / not_ignored) * 100, text);
+		free(text);
+		free(other);
+	} else {
+		_report_text_element(report, compliance, "div", NULL, "No rules were evaluated.");
+	}
+
+	if (failed > 0) {
+		_report_text_element(report, compliance, "h3", NULL, "Severity of failed rules");
+		xmlNode *progress = _report_element(report, compliance, "div", "progress");
+		text = oscap_sprintf("Displays proportion of high, medium, low, and other severity failed rules (in that order). There were %s total failed rules.", failed_str);
+		xmlNewProp(progress, BAD_CAST "title", BAD_CAST text);
+		free(text);
+		_report_count_bar(report, progress, "progress-bar progress-bar-success", failed - failed_high - failed_medium - failed_low, failed, " other\n                ");
+		_report_count_bar(report, progress, "progress-bar progress-bar-info", failed_low, failed, " low\n                ");
+		_report_count_bar(report, progress, "progress-bar progress-bar-warning", failed_medium, failed, " medium\n                ");
+		_report_count_bar(report, progress, "progress-bar progress-bar-danger", failed_high, failed, " high\n                ");
+	}
+	free(failed_str);
+
+	xmlNode *h3 = _report_text_element(report, compliance, "h3", NULL, "Score");
+	xmlNewProp(h3, BAD_CAST "title", BAD_CAST "As per the XCCDF specification");
+	xmlNode *table = _report_element(report, compliance, "table", "table table-striped table-bordered");
+	xmlNode *tr = _report_element(report, _report_element(report, table, "thead", NULL), "tr", NULL);
+	_report_text_element(report, tr, "th", NULL, "Scoring system");
+	_report_text_element(report, tr, "th", "text-center", "Score");
+	_report_text_element(report, tr, "th", "text-center", "Maximum");
+	xmlNewProp(_report_text_element(report, tr, "th", "text-center", "Percent"), BAD_CAST "style", BAD_CAST "width: 40%");
+	xmlNode *tbody = _report_element(report, table, "tbody", NULL);
+	for (struct oscap_list_item *it = report->result->sub.result.scores->first; it != NULL; it = it->next) {
+		struct xccdf_score *score = it->data;
+		/* the score is exported as "%f" */
+		char *score_str = oscap_sprintf("%f", score->score);
+		char *maximum_str = oscap_sprintf("%f", score->maximum);
+		double percent = (xmlXPathCastStringToNumber(BAD_CAST score_str) / xmlXPathCastStringToNumber(BAD_CAST maximum_str)) * 100;
+
+		tr = _report_element(report, tbody, "tr", NULL);
+		_report_text_element(report, tr, "td", NULL, score->system);
+		_report_text_element(report, tr, "td", "text-center", score_str);
+		_report_text_element(report, tr, "td", "text-center", maximum_str);
+		xmlNode *progress = _report_element(report, _report_element(report, tr, "td", NULL), "div", "progress");
+		xmlNode *success = _report_element(report, progress, "div", "progress-bar progress-bar-success");
+		_report_width(success, percent);
+		xmlNode *danger = _report_element(report, progress, "div", "progress-bar progress-bar-danger");
+		_report_width(danger, 100 - percent);
+		xmlNode *label = percent >= 50 ? success : (percent < 50 ? danger : NULL);
+		if (label != NULL) {
+			_report_number(report, label, _report_round(percent * 100) / 100);
+			_report_text(report, label, "%");
+		}
+		free(score_str);
+		free(maximum_str);
+	}
+
+	_report_flush(report, compliance);
+}
+
+/*
+ * Rule overview
+ */
+
+static const struct {
+	const char *prefix;
+	const char *name;
+} REFERENCE_NAMES[] = {
+	{ "http://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-53", "NIST SP 800-53" },
+	{ "http://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-171", "NIST SP 800-171" },
+	{ "http://iase.disa.mil/stigs/cci/", "DISA CCI" },
+	{ "http://iase.disa.mil/stigs/srgs/", "DISA SRG" },
+	{ "http://iase.disa.mil/stigs/os/general/Pages/index.aspx", "DISA SRG" },
+	{ "http://iase.disa.mil/stigs/app-security/app-servers/Pages/general.aspx", "DISA SRG" },
+	{ "http://iase.disa.mil/stigs/os/", "DISA STIG" },
+	{ "http://iase.disa.mil/stigs/app-security/", "DISA STIG" },
+	{ "https://www.pcisecuritystandards.org/", "PCI-DSS Requirement" },
+	{ "https://benchmarks.cisecurity.org/", "CIS Recommendation" },
+	{ "https://www.fbi.gov/file-repository/cjis-security-policy", "FBI CJIS" },
+	{ "http://www.ssi.gouv.fr/administration/bonnes-pratiques", "ANSSI" },
+	{ "https://www.gpo.gov/fdsys/pkg/CFR-2007-title45-vol1", "HIPAA" },
+	{ "https://www.iso.org/standard/54534.html", "ISO 27001-2013" },
+	{ "https://iase.disa.mil/stigs/pages/stig-viewing-guidance", "STIG Viewer" },
+};
+
+/* convert-reference-url-to-name */
+static const char *_report_reference_name(const char *href)
+{
+	for (size_t i = 0; i < sizeof(REFERENCE_NAMES) / sizeof(REFERENCE_NAMES[0]); i++) {
+		if (oscap_str_startswith(href, REFERENCE_NAMES[i].prefix))
+			return REFERENCE_NAMES[i].name;
+	}
+	return href;
+}
+
+/* The first text node of a reference, text() */
+static const char *_report_reference_text(const struct oscap_reference *reference)
+{
+	if (reference->content == NULL)	/* not parsed */
+		return reference->is_dublincore ? NULL : reference->title;
+	return reference->text;
+}
+
+/* The whole text of a reference, string() */
+static const char *_report_reference_string(const struct oscap_reference *reference)
+{
+	if (reference->content == NULL)
+		return reference->title ? reference->title : "";
+	return reference->content;
+}
+
+static int _report_strcmp(const void *a, const void *b)
+{
+	return strcmp(*(const char **) a, *(const char **) b);
+}
+
+/* Collect the references of the benchmark and count them, each of them gets an id
+ * generated in get-all-references before anything else */
+static void _report_collect_references(struct xccdf_item *item, struct oscap_htable *hrefs, struct oscap_list *sorted, unsigned int *count)
+{
+	for (struct oscap_list_item *it = item->item.references->first; it != NULL; it = it->next) {
+		struct oscap_reference *reference = it->data;
+		(*count)++;
+		if (reference->href != NULL && oscap_htable_add(hrefs, reference->href, reference))
+			oscap_list_add(sorted, reference->href);
+	}
+
+	struct oscap_list *lists[3] = { NULL, NULL, NULL };
+	switch (item->type) {
+	case XCCDF_BENCHMARK:
+		lists[0] = item->sub.benchmark.profiles;
+		lists[1] = item->sub.benchmark.values;
+		lists[2] = item->sub.benchmark.content;
+		break;
+	case XCCDF_GROUP:
+		lists[1] = item->sub.group.values;
+		lists[2] = item->sub.group.content;
+		break;
+	default:
+		break;
+	}
+	for (int i = 0; i < 3; i++) {
+		for (struct oscap_list_item *it = lists[i] ? lists[i]->first : NULL; it != NULL; it = it->next)
+			_report_collect_references(it->data, hrefs, sorted, count);
+	}
+}
+
+/* get-all-references */
+static void _report_reference_options(struct xccdf_report *report)
+{
+	struct oscap_htable *hrefs = oscap_htable_new();
+	struct oscap_list *list = oscap_list_new();
+	unsigned int count = 0;
+	_report_collect_references(report->benchmark, hrefs, list, &count);
+	report->last_id = count;
+
+	size_t size = list->itemcount;
+	const char **sorted = malloc(size * sizeof(const char *) + 1);
+	size_t i = 0;
+	for (struct oscap_list_item *it = list->first; it != NULL; it = it->next)
+		sorted[i++] = it->data;
+	qsort(sorted, size, sizeof(const char *), _report_strcmp);
+
+	for (i = 0; i < size; i++) {
+		if (_report_is_blank(sorted[i]) || strcmp(sorted[i], "https://github.com/OpenSCAP/scap-security-guide/wiki/Contributors") == 0)
+			continue;
+		const char *name = _report_reference_name(sorted[i]);
+		xmlNode *option = _report_text_element(report, NULL, "option", NULL, name);
+		xmlNewProp(option, BAD_CAST "value", BAD_CAST name);
+		_report_flush(report, option);
+	}
+
+	free(sorted);
+	oscap_list_free(list, NULL);
+	oscap_htable_free(hrefs, NULL);
+}
+
+struct xccdf_report_reference_group {
+	const char *href;
+	struct oscap_list *references;
+};
+
+static int _report_reference_group_cmp(const void *a, const void *b)
+{
+	const struct xccdf_report_reference_group *group_a = a;
+	const struct xccdf_report_reference_group *group_b = b;
+	return strcmp(group_a->href, group_b->href);
+}
+
+/* references-to-json */
+static char *_report_references_to_json(struct xccdf_item *item)
+{
+	struct oscap_list *references = item->item.references;
+	/* the references with @href, grouped by @href in the order of their first occurrence;
+	 * the position the first one of the group is sorted to determines the comma */
+	size_t size = references->itemcount;
+	struct xccdf_report_reference_group *groups = calloc(size + 1, sizeof(struct xccdf_report_reference_group));
+	size_t count = 0;
+	unsigned int without_href = 0;
+	for (struct oscap_list_item *it = references->first; it != NULL; it = it->next) {
+		struct oscap_reference *reference = it->data;
+		if (reference->href == NULL) {
+			without_href++;
+			continue;
+		}
+		size_t i = 0;
+		while (i < count && strcmp(groups[i].href, reference->href) != 0)
+			i++;
+		if (i == count) {
+			groups[count].href = reference->href;
+			groups[count].references = oscap_list_new();
+			count++;
+		}
+		oscap_list_add(groups[i].references, reference);
+	}
+	/* xsl:sort is stable, the references without @href sort before the others as "" */
+	qsort(groups, count, sizeof(struct xccdf_report_reference_group), _report_reference_group_cmp);
+
+	struct oscap_string *json = oscap_string_new();
+	oscap_string_append_char(json, '{');
+	for (size_t i = 0; i < count; i++) {
+		/* position() counts the references of the whole group and those without @href */
+		if (i != 0 || without_href > 0)
+			oscap_string_append_char(json, ',');
+		oscap_string_append_char(json, '"');
+		oscap_string_append_string(json, _report_reference_name(groups[i].href));
+		oscap_string_append_string(json, "\":[");
+		for (struct oscap_list_item *it = groups[i].references->first; it != NULL; it = it->next) {
+			const char *text = _report_reference_string(it->data);
+			oscap_string_append_char(json, '"');
+			oscap_string_append_string(json, _report_is_blank(text) ? "unknown" : text);
+			oscap_string_append_char(json, '"');
+			if (it->next != NULL)
+				oscap_string_append_char(json, ',');
+		}
+		oscap_string_append_char(json, ']');
+		oscap_list_free(groups[i].references, NULL);
+	}
+	oscap_string_append_char(json, '}');
+	free(groups);
+	return oscap_string_bequeath(json);
+}
+
+static void _report_overview_leaf(struct xccdf_report *report, struct xccdf_item *rule, int indent)
+{
+	struct oscap_list *rule_results = oscap_htable_get(report->rule_results, rule->item.id);
+	if (rule_results == NULL)
+		return;
+
+	char *references = NULL;
+	for (struct oscap_list_item *it = rule_results->first; it != NULL; it = it->next) {
+		struct xccdf_rule_result *rule_result = it->data;
+		if (!_report_rule_result_shown(rule_result))
+			continue;
+		const char *result = _report_result_text(rule_result->result);
+		const char *id = _report_generate_id(report, rule_result);
+		if (references == NULL)
+			references = _report_references_to_json(rule);
+
+		xmlNode *tr = _report_element(report, NULL, "tr", NULL);
+		xmlNewProp(tr, BAD_CAST "data-tt-id", BAD_CAST rule->item.id);
+		char *str = _report_result_needs_attention(rule_result->result)
+			? oscap_sprintf("rule-overview-leaf rule-overview-leaf-%s rule-overview-needs-attention", result)
+			: oscap_sprintf("rule-overview-leaf rule-overview-leaf-%s rule-overview-leaf-id-%s", result, rule->item.id);
+		xmlNewProp(tr, BAD_CAST "class", BAD_CAST str);
+		free(str);
+		str = oscap_sprintf("rule-overview-leaf-%s", id);
+		xmlNewProp(tr, BAD_CAST "id", BAD_CAST str);
+		free(str);
+		xmlNewProp(tr, BAD_CAST "data-tt-parent-id", BAD_CAST (rule->item.parent ? rule->item.parent->item.id : ""));
+		xmlNewProp(tr, BAD_CAST "data-references", BAD_CAST references);
+
+		xmlNode *td = _report_element(report, tr, "td", NULL);
+		str = oscap_sprintf("padding-left: %dpx", indent * 19);
+		xmlNewProp(td, BAD_CAST "style", BAD_CAST str);
+		free(str);
+		xmlNode *a = _report_element(report, td, "a", NULL);
+		str = oscap_sprintf("#rule-detail-%s", id);
+		xmlNewProp(a, BAD_CAST "href", BAD_CAST str);
+		free(str);
+		str = oscap_sprintf("return openRuleDetailsDialog('%s')", id);
+		xmlNewProp(a, BAD_CAST "onclick", BAD_CAST str);
+		free(str);
+		_report_item_title(report, a, rule);
+		if (_report_rule_result_multicheck(rule_result)) {
+			const char *name = _report_rule_result_first_content_ref_name(rule_result);
+			str = oscap_sprintf("\n                (%s)\n            ", name ? name : "");
+			_report_text(report, td, str);
+			free(str);
+		}
+		if (rule_result->overrides->itemcount > 0) {
+			_report_text(report, td, "\n                " NBSP);
+			_report_text_element(report, td, "span", "label label-warning", "waived");
+		}
+
+		const char *severity = _report_rule_result_severity(rule_result);
+		xmlNode *severity_td = _report_text_element(report, tr, "td", "rule-severity", severity ? severity : "unknown");
+		xmlNewProp(severity_td, BAD_CAST "style", BAD_CAST "text-align: center");
+
+		str = oscap_sprintf("rule-result rule-result-%s", result);
+		_report_result_cell(report, _report_element(report, tr, "td", str), rule_result->result);
+		free(str);
+
+		_report_flush(report, tr);
+	}
+	free(references);
+}
+
+static void _report_overview_inner_node(struct xccdf_report *report, struct xccdf_item *item, int indent)
+{
+	struct xccdf_report_counts *counts = oscap_htable_get(report->rule_counts, item->item.id);
+	if (counts == NULL || counts->notselected >= counts->rules)
+		return;
+
+	xmlNode *tr = _report_element(report, NULL, "tr", NULL);
+	xmlNewProp(tr, BAD_CAST "data-tt-id", BAD_CAST item->item.id);
+	char *str = oscap_sprintf("rule-overview-inner-node rule-overview-inner-node-id-%s", item->item.id);
+	xmlNewProp(tr, BAD_CAST "class", BAD_CAST str);
+	free(str);
+	if (item->item.parent != NULL && (item->item.parent->type == XCCDF_GROUP || item->item.parent->type == XCCDF_BENCHMARK))
+		xmlNewProp(tr, BAD_CAST "data-tt-parent-id", BAD_CAST item->item.parent->item.id);
+
+	xmlNode *td = _report_element(report, tr, "td", NULL);
+	xmlNewProp(td, BAD_CAST "colspan", BAD_CAST "3");
+	str = oscap_sprintf("padding-left: %dpx", indent * 19);
+	xmlNewProp(td, BAD_CAST "style", BAD_CAST str);
+	free(str);
+	if (counts->fail + counts->error + counts->unknown + counts->notchecked > 0) {
+		_report_item_title(report, _report_element(report, td, "strong", NULL), item);
+		const struct {
+			unsigned int count;
+			const char *label;
+		} badges[] = {
+			{ counts->fail, "fail" },
+			{ counts->error, "error" },
+			{ counts->unknown, "unknown" },
+			{ counts->notchecked, "notchecked" },
+		};
+		for (size_t i = 0; i < sizeof(badges) / sizeof(badges[0]); i++) {
+			if (badges[i].count == 0)
+				continue;
+			_report_text(report, td, NBSP);
+			str = oscap_sprintf("%ux %s", badges[i].count, badges[i].label);
+			_report_text_element(report, td, "span", "badge", str);
+			free(str);
+		}
+	} else {
+		_report_item_title(report, td, item);
+		str = oscap_sprintf("$(document).ready(function(){$('.treetable').treetable(\"collapseNode\",\"%s\");});", item->item.id);
+		_report_text_element(report, td, "script", NULL, str);
+		free(str);
+	}
+	_report_flush(report, tr);
+
+	struct oscap_list *content = _report_item_content(item);
+	for (struct oscap_list_item *it = content->first; it != NULL; it = it->next) {
+		struct xccdf_item *child = it->data;
+		if (child->type == XCCDF_GROUP)
+			_report_overview_inner_node(report, child, indent + 1);
+	}
+	for (struct oscap_list_item *it = content->first; it != NULL; it = it->next) {
+		struct xccdf_item *child = it->data;
+		if (child->type == XCCDF_RULE)
+			_report_overview_leaf(report, child, indent + 1);
+	}
+}
+
+static void _report_rule_overview(struct xccdf_report *report)
+{
+	_report_write(report,
+		"<div id=\"rule-overview\"><h2>Rule Overview</h2>"
+		"<div class=\"form-group js-only hidden-print\"><div class=\"row\"><div title=\"Filter rules by their XCCDF result\">"
+		"<div class=\"col-sm-2 toggle-rule-display-success\">"
+		"<div class=\"checkbox\"><label><input class=\"toggle-rule-display\" type=\"checkbox\" onclick=\"toggleRuleDisplay(this)\" checked value=\"pass\">pass</label></div>"
+		"<div class=\"checkbox\"><label><input class=\"toggle-rule-display\" type=\"checkbox\" onclick=\"toggleRuleDisplay(this)\" checked value=\"fixed\">fixed</label></div>"
+		"<div class=\"checkbox\"><label><input class=\"toggle-rule-display\" type=\"checkbox\" onclick=\"toggleRuleDisplay(this)\" checked value=\"informational\">informational</label></div>"
+		"</div>"
+		"<div class=\"col-sm-2 toggle-rule-display-danger\">"
+		"<div class=\"checkbox\"><label><input class=\"toggle-rule-display\" type=\"checkbox\" onclick=\"toggleRuleDisplay(this)\" checked value=\"fail\">fail</label></div>"
+		"<div class=\"checkbox\"><label><input class=\"toggle-rule-display\" type=\"checkbox\" onclick=\"toggleRuleDisplay(this)\" checked value=\"error\">error</label></div>"
+		"<div class=\"checkbox\"><label><input class=\"toggle-rule-display\" type=\"checkbox\" onclick=\"toggleRuleDisplay(this)\" checked value=\"unknown\">unknown</label></div>"
+		"</div>"
+		"<div class=\"col-sm-2 toggle-rule-display-other\">"
+		"<div class=\"checkbox\"><label><input class=\"toggle-rule-display\" type=\"checkbox\" onclick=\"toggleRuleDisplay(this)\" checked value=\"notchecked\">notchecked</label></div>"
+		"<div class=\"checkbox\"><label><input class=\"toggle-rule-display\" type=\"checkbox\" onclick=\"toggleRuleDisplay(this)\" checked value=\"notapplicable\">notapplicable</label></div>"
+		"</div></div>"
+		"<div class=\"col-sm-6\"><div class=\"input-group\">"
+		"<input type=\"text\" class=\"form-control\" placeholder=\"Search through XCCDF rules\" id=\"search-input\" oninput=\"ruleSearch()\">"
+		"<div class=\"input-group-btn\"><button class=\"btn btn-default\" onclick=\"ruleSearch()\">Search</button></div></div>"
+		"<p id=\"search-matches\"></p>\n"
+		"                    Group rules by:\n"
+		"                    <select name=\"groupby\" onchange=\"groupRulesBy(value)\">"
+		"<option value=\"default\" selected>Default</option>"
+		"<option value=\"severity\">Severity</option>"
+		"<option value=\"result\">Result</option>"
+		"<option disabled>\xe2\x94\x80\xe2\x94\x80\xe2\x94\x80\xe2\x94\x80\xe2\x94\x80\xe2\x94\x80\xe2\x94\x80\xe2\x94\x80\xe2\x94\x80\xe2\x94\x80</option>");
+	_report_reference_options(report);
+	_report_write(report,
+		"</select></div></div></div>"
+		"<table class=\"treetable table table-bordered\"><thead><tr><th>Title</th>"
+		"<th style=\"width: 120px; text-align: center\">Severity</th>"
+		"<th style=\"width: 120px; text-align: center\">Result</th></tr></thead><tbody>");
+	_report_overview_inner_node(report, report->benchmark, 0);
+	_report_write(report, "</tbody></table></div>");
+}
+
+/*
+ * Result details
+ */
+
+static void _report_idents_refs(struct xccdf_report *report, xmlNode *parent, struct xccdf_item *rule)
+{
+	if (rule->sub.rule.idents->itemcount > 0) {
+		xmlNode *p = _report_element(report, parent, "p", NULL);
+		xmlNode *span = _report_text_element(report, p, "span", "label label-info", "Identifiers:");
+		xmlNewProp(span, BAD_CAST "title", BAD_CAST "A globally meaningful identifiers for this rule. MAY be the name or identifier of a security configuration issue or vulnerability that the rule remediates. By setting an identifier on a rule, the benchmark author effectively declares that the rule instantiates, implements, or remediates the issue for which the name was assigned.");
+		_report_text(report, p, NBSP "\n            ");
+		for (struct oscap_list_item *it = rule->sub.rule.idents->first; it != NULL; it = it->next) {
+			struct xccdf_ident *ident = it->data;
+			const char *id = ident->id ? ident->id : "";
+			const char *system = ident->system ? ident->system : "";
+			xmlNode *abbr_parent = p;
+			char *href = NULL;
+			if (oscap_str_startswith(system, "http://cve.mitre.org"))
+				href = oscap_sprintf("https://cve.mitre.org/cgi-bin/cvename.cgi?name=%s", id);
+			else if (oscap_str_startswith(system, "https://access.redhat.com/errata"))
+				href = oscap_sprintf("https://access.redhat.com/errata/%s.html", id);
+			if (href != NULL) {
+				abbr_parent = _report_element(report, p, "a", NULL);
+				xmlNewProp(abbr_parent, BAD_CAST "href", BAD_CAST href);
+				free(href);
+			}
+			xmlNode *abbr = _report_text_element(report, abbr_parent, "abbr", NULL, id);
+			char *title = oscap_sprintf("%s: %s", system, id);
+			xmlNewProp(abbr, BAD_CAST "title", BAD_CAST title);
+			free(title);
+			if (it->next != NULL)
+				_report_text(report, p, ", ");
+		}
+	}
+	if (rule->item.references->itemcount > 0) {
+		xmlNode *p = _report_element(report, parent, "p", NULL);
+		xmlNode *span = _report_text_element(report, p, "span", "label label-default", "References:");
+		xmlNewProp(span, BAD_CAST "title", BAD_CAST "Provide a reference to a document or resource where the user can learn more about the subject of the Rule or Group.");
+		_report_text(report, p, NBSP "\n            ");
+		for (struct oscap_list_item *it = rule->item.references->first; it != NULL; it = it->next) {
+			struct oscap_reference *reference = it->data;
+			const char *text = _report_reference_text(reference);
+			if (reference->href != NULL) {
+				xmlNode *a = _report_text_element(report, p, "a", NULL, text != NULL ? text : reference->href);
+				xmlNewProp(a, BAD_CAST "href", BAD_CAST reference->href);
+			} else {
+				_report_text(report, p, text);
+			}
+			if (it->next != NULL)
+				_report_text(report, p, ", ");
+		}
+	}
+}
+
+static xmlNode *_report_detail_row(struct xccdf_report *report, xmlNode *tbody, const char *label)
+{
+	xmlNode *tr = _report_element(report, tbody, "tr", NULL);
+	_report_text_element(report, tr, "td", NULL, label);
+	return _report_element(report, tr, "td", NULL);
+}
+
+static xmlNode *_report_detail_wide_row(struct xccdf_report *report, xmlNode *tbody, const char *tr_class)
+{
+	xmlNode *td = _report_element(report, _report_element(report, tbody, "tr", tr_class), "td", NULL);
+	xmlNewProp(td, BAD_CAST "colspan", BAD_CAST "2");
+	return td;
+}
+
+static void _report_fix_attribute(struct xccdf_report *report, xmlNode *table, const char *name, const char *value)
+{
+	xmlNode *tr = _report_element(report, table, "tr", NULL);
+	_report_text_element(report, tr, "th", NULL, name);
+	_report_text_element(report, tr, "td", NULL, value);
+}
+
+static const char *_report_fix_type(const char *system)
+{
+	static const struct {
+		const char *system;
+		const char *type;
+	} FIX_TYPES[] = {
+		{ "urn:xccdf:fix:script:sh", "Shell script" },
+		{ "urn:xccdf:fix:script:ansible", "Ansible snippet" },
+		{ "urn:xccdf:fix:script:puppet", "Puppet snippet" },
+		{ "urn:redhat:anaconda:pre", "Anaconda snippet" },
+		{ "urn:xccdf:fix:script:kubernetes", "Kubernetes snippet" },
+		{ "urn:redhat:osbuild:blueprint", "OSBuild Blueprint snippet" },
+	};
+	for (size_t i = 0; i < sizeof(FIX_TYPES) / sizeof(FIX_TYPES[0]); i++) {
+		if (oscap_streq(system, FIX_TYPES[i].system))
+			return FIX_TYPES[i].type;
+	}
+	return "script";
+}
+
+/* show-fix */
+static void _report_fix(struct xccdf_report *report, xmlNode *parent, struct xccdf_fix *fix)
+{
+	const char *id = _report_generate_id(report, fix);
+	char *str;
+
+	xmlNode *a = _report_element(report, parent, "a", "btn btn-success");
+	xmlNewProp(a, BAD_CAST "data-toggle", BAD_CAST "collapse");
+	str = oscap_sprintf("#%s", id);
+	xmlNewProp(a, BAD_CAST "data-target", BAD_CAST str);
+	free(str);
+	xmlNewProp(a, BAD_CAST "tabindex", BAD_CAST "0");
+	xmlNewProp(a, BAD_CAST "role", BAD_CAST "button");
+	xmlNewProp(a, BAD_CAST "aria-expanded", BAD_CAST "false");
+	xmlNewProp(a, BAD_CAST "title", BAD_CAST "Activate to reveal");
+	xmlNewProp(a, BAD_CAST "href", BAD_CAST "#!");
+	str = oscap_sprintf("Remediation %s \xe2\x87\xb2", _report_fix_type(fix->system));
+	_report_text(report, a, str);
+	free(str);
+	_report_element(report, parent, "br", NULL);
+
+	xmlNode *div = _report_element(report, parent, "div", "panel-collapse collapse");
+	xmlNewProp(div, BAD_CAST "id", BAD_CAST id);
+	/* the attributes given in the benchmark */
+	if (fix->complexity != XCCDF_LEVEL_NOT_DEFINED || fix->disruption != XCCDF_LEVEL_NOT_DEFINED
+	    || fix->def_reboot || fix->strategy != XCCDF_STRATEGY_UNKNOWN) {
+		xmlNode *table = _report_element(report, div, "table", "table table-striped table-bordered table-condensed");
+		if (fix->complexity != XCCDF_LEVEL_NOT_DEFINED)
+			_report_fix_attribute(report, table, "Complexity:", XCCDF_LEVEL_MAP[fix->complexity - 1].string);
+		if (fix->disruption != XCCDF_LEVEL_NOT_DEFINED)
+			_report_fix_attribute(report, table, "Disruption:", XCCDF_LEVEL_MAP[fix->disruption - 1].string);
+		if (fix->def_reboot)
+			_report_fix_attribute(report, table, "Reboot:", fix->reboot ? "true" : "false");
+		if (fix->strategy != XCCDF_STRATEGY_UNKNOWN)
+			_report_fix_attribute(report, table, "Strategy:", XCCDF_STRATEGY_MAP[fix->strategy - 1].string);
+	}
+	xmlNode *code = _report_element(report, _report_element(report, div, "pre", NULL), "code", NULL);
+	_report_sub_markup(report, code, fix->content, &SUB_FIX);
+}
+
+static void _report_overrides(struct xccdf_report *report, xmlNode *tbody, const struct xccdf_rule_result *rule_result)
+{
+	if (rule_result->overrides->itemcount == 0)
+		return;
+
+	xmlNode *td = _report_detail_wide_row(report, tbody, NULL);
+	for (struct oscap_list_item *it = rule_result->overrides->first; it != NULL; it = it->next) {
+		struct xccdf_override *override = it->data;
+		const char *old_result = override->old_result != 0 ? _report_result_text(override->old_result) : "";
+
+		xmlNode *div = _report_element(report, td, "div", "alert alert-warning waiver");
+		_report_text(report, div, "\n                            This rule has been waived by ");
+		_report_text_element(report, div, "strong", NULL, override->authority);
+		_report_text(report, div, " at ");
+		_report_text_element(report, div, "strong", NULL, override->time);
+		_report_text(report, div, ".\n                            ");
+		char *remark = _report_text_first_text_child(override->remark);
+		_report_text_element(report, div, "blockquote", NULL, remark);
+		free(remark);
+		xmlNode *small = _report_text_element(report, div, "small", NULL, "\n                                The previous result was ");
+		char *str = oscap_sprintf("rule-result rule-result-%s", old_result);
+		xmlNode *span = _report_element(report, small, "span", str);
+		free(str);
+		str = oscap_sprintf(NBSP "%s" NBSP, old_result);
+		_report_text(report, span, str);
+		free(str);
+		_report_text(report, small, ".\n                            ");
+	}
+}
+
+static void _report_remarks(struct xccdf_report *report, xmlNode *tbody, struct xccdf_item *rule)
+{
+	if (report->profile == NULL)
+		return;
+
+	xmlNode *td = NULL;
+	for (struct oscap_list_item *it = report->profile->sub.profile.selects->first; it != NULL; it = it->next) {
+		struct xccdf_select *select = it->data;
+		if (!oscap_streq(select->item, rule->item.id))
+			continue;
+		for (struct oscap_list_item *rit = select->remarks->first; rit != NULL; rit = rit->next) {
+			if (td == NULL) {
+				td = _report_detail_row(report, tbody, "Remarks");
+				xmlNewProp(td, BAD_CAST "class", BAD_CAST "remarks");
+			}
+			char *remark = _report_text_first_text_child(rit->data);
+			_report_text_element(report, td, "blockquote", "small", remark);
+			free(remark);
+		}
+	}
+}
+
+static void _report_messages(struct xccdf_report *report, xmlNode *tbody, const struct xccdf_rule_result *rule_result)
+{
+	if (rule_result->messages->itemcount == 0)
+		return;
+
+	xmlNode *td = _report_detail_wide_row(report, tbody, NULL);
+	xmlNode *messages = _report_element(report, td, "div", "evaluation-messages");
+	xmlNode *abbr = _report_text_element(report, _report_element(report, messages, "span", "label label-default"), "abbr", NULL, "Evaluation messages");
+	xmlNewProp(abbr, BAD_CAST "title", BAD_CAST "Messages taken from rule-result");
+	xmlNode *body = _report_element(report, _report_element(report, messages, "div", "panel panel-default"), "div", "panel-body");
+
+	/* the cdf:message elements are copied as they are */
+	const struct xccdf_version_info *version = xccdf_item_get_schema_version(report->benchmark);
+	bool xccdf11 = oscap_streq(xccdf_version_info_get_namespace_uri(version), XCCDF11_NS);
+	for (struct oscap_list_item *it = rule_result->messages->first; it != NULL; it = it->next) {
+		struct xccdf_message *message = it->data;
+		const char *severity = message->severity != XCCDF_MSG_NOT_DEFINED ? XCCDF_LEVEL_MAP[message->severity - 1].string : NULL;
+		if (severity != NULL) {
+			_report_text_element(report, body, "span", "label label-primary", severity);
+			_report_text(report, body, NBSP "\n                                ");
+		}
+		xmlNode *pre = _report_element(report, body, "pre", NULL);
+		xmlNode *copy = _report_text_element(report, pre, "message", NULL, message->content);
+		xmlSetNs(copy, xmlNewNs(copy, BAD_CAST XCCDF12_NS, xccdf11 ? BAD_CAST "cdf12" : NULL));
+		if (severity != NULL)
+			xmlNewProp(copy, BAD_CAST "severity", BAD_CAST severity);
+	}
+}
+
+static void _report_check_system_details(struct xccdf_report *report, xmlNode *parent, const struct xccdf_rule_result *rule_result, xccdf_test_result_type_t result);
+
+/* result-details-leaf-table */
+static void _report_details_table(struct xccdf_report *report, xmlNode *parent, struct xccdf_item *rule, const struct xccdf_rule_result *rule_result)
+{
+	const char *result = _report_result_text(rule_result->result);
+	char *str;
+
+	xmlNode *tbody = _report_element(report, _report_element(report, parent, "table", "table table-striped table-bordered"), "tbody", NULL);
+
+	xmlNode *tr = _report_element(report, tbody, "tr", NULL);
+	_report_text_element(report, tr, "td", "col-md-3", "Rule ID");
+	_report_text_element(report, tr, "td", "rule-id col-md-9", rule->item.id);
+
+	tr = _report_element(report, tbody, "tr", NULL);
+	_report_text_element(report, tr, "td", NULL, "Result");
+	str = oscap_sprintf("rule-result rule-result-%s", result);
+	_report_result_cell(report, _report_element(report, tr, "td", str), rule_result->result);
+	free(str);
+
+	_report_text(report, _report_detail_row(report, tbody, "Multi-check rule"), _report_rule_result_multicheck(rule_result) ? "yes" : "no");
+	if (_report_rule_result_has_check_system(rule_result, OVAL5_CHECK_SYSTEM))
+		_report_text(report, _report_detail_row(report, tbody, "OVAL Definition ID"), _report_rule_result_first_content_ref_name(rule_result));
+	_report_text(report, _report_detail_row(report, tbody, "Time"), rule_result->time);
+	const char *severity = _report_rule_result_severity(rule_result);
+	_report_text(report, _report_detail_row(report, tbody, "Severity"), severity ? severity : "unknown");
+
+	xmlNode *identifiers = _report_detail_row(report, tbody, "Identifiers and References");
+	xmlNewProp(identifiers, BAD_CAST "class", BAD_CAST "identifiers");
+	_report_idents_refs(report, identifiers, rule);
+
+	_report_overrides(report, tbody, rule_result);
+
+	if (rule->item.description->itemcount > 0)
+		_report_sub_texts(report, _report_element(report, _report_detail_row(report, tbody, "Description"), "div", "description"),
+				  rule->item.description, &SUB_TESTRESULT);
+	if (rule->item.rationale->itemcount > 0)
+		_report_sub_texts(report, _report_element(report, _report_detail_row(report, tbody, "Rationale"), "div", "rationale"),
+				  rule->item.rationale, &SUB_TESTRESULT);
+
+	_report_remarks(report, tbody, rule);
+
+	if (rule->item.warnings->itemcount > 0) {
+		xmlNode *td = _report_detail_row(report, tbody, "Warnings");
+		for (struct oscap_list_item *it = rule->item.warnings->first; it != NULL; it = it->next) {
+			struct xccdf_warning *warning = it->data;
+			xmlNode *heading = _report_element(report, _report_element(report, td, "div", "panel panel-warning"), "div", "panel-heading");
+			_report_text_element(report, heading, "span", "label label-warning", "warning");
+			_report_text(report, heading, NBSP "\n                                ");
+			_report_sub_text(report, heading, warning->text, &SUB_PLAIN);
+		}
+	}
+
+	_report_messages(report, tbody, rule_result);
+
+	if (_report_result_needs_attention(rule_result->result)) {
+		for (struct oscap_list_item *it = rule->sub.rule.fixtexts->first; it != NULL; it = it->next) {
+			struct xccdf_fixtext *fixtext = it->data;
+			xmlNode *div = _report_element(report, _report_detail_wide_row(report, tbody, NULL), "div", "remediation-description");
+			_report_text_element(report, div, "span", "label label-success", "Remediation description:");
+			xmlNode *body = _report_element(report, _report_element(report, div, "div", "panel panel-default"), "div", "panel-body");
+			_report_sub_text(report, body, fixtext->text, &SUB_TESTRESULT);
+		}
+		for (struct oscap_list_item *it = rule->sub.rule.fixes->first; it != NULL; it = it->next) {
+			xmlNode *div = _report_element(report, _report_detail_wide_row(report, tbody, "noprint"), "div", "remediation");
+			_report_fix(report, div, it->data);
+		}
+	}
+}
+
+static void _report_details_leaf(struct xccdf_report *report, struct xccdf_item *rule)
+{
+	struct oscap_list *rule_results = oscap_htable_get(report->rule_results, rule->item.id);
+	if (rule_results == NULL)
+		return;
+
+	for (struct oscap_list_item *it = rule_results->first; it != NULL; it = it->next) {
+		struct xccdf_rule_result *rule_result = it->data;
+		if (!_report_rule_result_shown(rule_result))
+			continue;
+		const char *result = _report_result_text(rule_result->result);
+		const char *id = _report_generate_id(report, rule_result);
+
+		char *str = oscap_sprintf("panel panel-default rule-detail rule-detail-%s rule-detail-id-%s", result, rule->item.id);
+		xmlNode *panel = _report_element(report, NULL, "div", str);
+		free(str);
+		str = oscap_sprintf("rule-detail-%s", id);
+		xmlNewProp(panel, BAD_CAST "id", BAD_CAST str);
+		free(str);
+
+		xmlNode *keywords = _report_element(report, panel, "div", "keywords sr-only");
+		xmlAddChild(keywords, xmlNewDocComment(report->doc, BAD_CAST "This allows OpenSCAP JS to search the report rules"));
+		_report_item_title(report, keywords, rule);
+		str = oscap_sprintf("%s ", rule->item.id);
+		_report_text(report, keywords, str);
+		free(str);
+		_report_text(report, keywords, _report_rule_result_severity(rule_result));
+		for (struct oscap_list_item *iit = rule_result->idents->first; iit != NULL; iit = iit->next) {
+			struct xccdf_ident *ident = iit->data;
+			str = oscap_sprintf("%s ", ident->id ? ident->id : "");
+			_report_text(report, keywords, str);
+			free(str);
+		}
+
+		xmlNode *heading = _report_element(report, panel, "div", "panel-heading");
+		_report_item_title(report, _report_element(report, heading, "h3", "panel-title"), rule);
+
+		xmlNode *body = _report_element(report, panel, "div", "panel-body");
+		_report_details_table(report, body, rule, rule_result);
+		xmlNode *details = _report_element(report, NULL, "div", "check-system-details");
+		_report_check_system_details(report, details, rule_result, rule_result->result);
+		if (details->children != NULL)
+			xmlAddChild(body, details);
+		else
+			xmlFreeNode(details);
+
+		_report_flush(report, panel);
+	}
+}
+
+static void _report_details_inner_node(struct xccdf_report *report, struct xccdf_item *item)
+{
+	struct oscap_list *content = _report_item_content(item);
+	for (struct oscap_list_item *it = content->first; it != NULL; it = it->next) {
+		struct xccdf_item *child = it->data;
+		if (child->type == XCCDF_GROUP)
+			_report_details_inner_node(report, child);
+	}
+	for (struct oscap_list_item *it = content->first; it != NULL; it = it->next) {
+		struct xccdf_item *child = it->data;
+		if (child->type == XCCDF_RULE)
+			_report_details_leaf(report, child);
+	}
+}
+
+static void _report_result_details(struct xccdf_report *report)
+{
+	_report_write(report,
+		"<div class=\"js-only hidden-print\"><button type=\"button\" class=\"btn btn-info\" onclick=\"return toggleResultDetails(this)\">Show all result details</button></div>"
+		"<div id=\"result-details\"><h2>Result Details</h2>");
+	_report_details_inner_node(report, report->benchmark);
+	_report_write(report, "<a href=\"#result-details\" class=\"btn btn-info noprint\">Scroll back to the first rule</a></div>");
+}
+
+static void _report_rear_matter(struct xccdf_report *report)
+{
+	xmlNode *rear_matter = _report_element(report, NULL, "div", NULL);
+	xmlNewProp(rear_matter, BAD_CAST "id", BAD_CAST "rear-matter");
+	xmlNode *well = _report_element(report, _report_element(report, rear_matter, "div", "row top-spacer-10"), "div", "col-md-12 well well-lg");
+	struct oscap_list *texts = report->benchmark->sub.benchmark.rear_matter;
+	if (texts->itemcount > 0)
+		_report_sub_text(report, _report_element(report, well, "div", "rear-matter"), texts->first->data, &SUB_PLAIN);
+	_report_flush(report, rear_matter);
+}
+
+/*
+ * OVAL and SCE details
+ */
+
+static void _report_oval_index_add(struct oscap_htable *index, const char *id, void *item)
+{
+	if (id == NULL)
+		return;
+	struct oscap_list *list = oscap_htable_get(index, id);
+	if (list == NULL) {
+		list = oscap_list_new();
+		oscap_htable_add(index, id, list);
+	}
+	oscap_list_add(list, item);
+}
+
+struct xccdf_report_oval_walk {
+	struct xccdf_report *report;
+	struct oscap_htable *items;	/* items of the report, system_data lists each of them once */
+};
+
+static void _report_oval_walk_definition(struct oval_result_definition *definition, oval_result_directive_content_t content, void *arg)
+{
+	struct xccdf_report_oval_walk *walk = arg;
+	struct xccdf_report_definition *entry = malloc(sizeof(struct xccdf_report_definition));
+	entry->definition = definition;
+	entry->content = content;
+	entry->position = walk->report->oval_position++;
+	_report_oval_index_add(walk->report->oval_definitions, oval_result_definition_get_id(definition), entry);
+}
+
+static void _report_oval_walk_test(struct oval_result_test *test, void *arg)
+{
+	struct xccdf_report_oval_walk *walk = arg;
+	_report_oval_index_add(walk->report->oval_tests, oval_result_test_get_id(test), test);
+}
+
+static void _report_oval_walk_syschar(struct oval_syschar *syschar, void *arg)
+{
+	struct xccdf_report_oval_walk *walk = arg;
+	struct oval_object *object = oval_syschar_get_object(syschar);
+	_report_oval_index_add(walk->report->oval_objects, oval_object_get_id(object), syschar);
+
+	struct oval_sysitem_iterator *sysitems = oval_syschar_get_sysitem(syschar);
+	while (oval_sysitem_iterator_has_more(sysitems)) {
+		struct oval_sysitem *sysitem = oval_sysitem_iterator_next(sysitems);
+		const char *id = oval_sysitem_get_id(sysitem);
+		if (id != NULL && oscap_htable_add(walk->items, id, sysitem))
+			_report_oval_index_add(walk->report->oval_items, id, sysitem);
+	}
+	oval_sysitem_iterator_free(sysitems);
+}
+
+static void _report_oval_index(struct xccdf_report *report, const struct xccdf_report_oval *oval_reports, size_t count)
+{
+	report->oval_definitions = oscap_htable_new();
+	report->oval_tests = oscap_htable_new();
+	report->oval_items = oscap_htable_new();
+	report->oval_objects = oscap_htable_new();
+	for (size_t i = 0; i < count; i++) {
+		if (oval_reports[i].results == NULL)
+			continue;
+		if (report->oval_report_id == NULL)
+			report->oval_report_id = oval_reports[i].report_id;
+		struct xccdf_report_oval_walk walk = {
+			.report = report,
+			.items = oscap_htable_new(),
+		};
+		const struct oval_result_export_walker walker = {
+			.definition = _report_oval_walk_definition,
+			.test = _report_oval_walk_test,
+			.syschar = _report_oval_walk_syschar,
+			.user_arg = &walk,
+		};
+		oval_results_model_walk_export(oval_reports[i].results, &walker);
+		oscap_htable_free(walk.items, NULL);
+	}
+}
+
+static void _report_free_list(void *list)
+{
+	oscap_list_free(list, NULL);
+}
+
+static void _report_free_definitions(void *list)
+{
+	oscap_list_free(list, free);
+}
+
+/* The label of the generic item table, the name with the first letter capitalized */
+static void _report_item_label(struct xccdf_report *report, xmlNode *tr, const char *name)
+{
+	char *label = oscap_strdup(name);
+	for (char *c = label; *c; c++) {
+		if (*c == '_')
+			*c = ' ';
+	}
+	if (*label >= 'a' && *label <= 'z')
+		*label = *label - 'a' + 'A';
+	_report_text_element(report, tr, "th", NULL, label);
+	free(label);
+}
+
+static void _report_item_head(struct xccdf_report *report, xmlNode *thead, struct oval_sysitem *sysitem)
+{
+	xmlNode *tr = _report_element(report, thead, "tr", NULL);
+	switch (oval_sysitem_get_subtype(sysitem)) {
+	case OVAL_UNIX_FILE: {
+		const char *labels[] = { "Path", "Type", "UID", "GID", "Size (B)", "Permissions" };
+		for (size_t i = 0; i < sizeof(labels) / sizeof(labels[0]); i++)
+			_report_text_element(report, tr, "th", NULL, labels[i]);
+		break;
+	}
+	case OVAL_INDEPENDENT_TEXT_FILE_CONTENT:
+		_report_text_element(report, tr, "th", NULL, "Path");
+		_report_text_element(report, tr, "th", NULL, "Content");
+		break;
+	default: {
+		struct oval_message_iterator *messages = oval_sysitem_get_messages(sysitem);
+		while (oval_message_iterator_has_more(messages)) {
+			oval_message_iterator_next(messages);
+			_report_item_label(report, tr, "message");
+		}
+		oval_message_iterator_free(messages);
+		struct oval_sysent_iterator *sysents = oval_sysitem_get_sysents(sysitem);
+		while (oval_sysent_iterator_has_more(sysents))
+			_report_item_label(report, tr, oval_sysent_get_name(oval_sysent_iterator_next(sysents)));
+		oval_sysent_iterator_free(sysents);
+		break;
+	}
+	}
+}
+
+/* The exported value of the entity, the values are masked in the results */
+static const char *_report_sysent_value(struct oval_sysent *sysent)
+{
+	if (oval_sysent_get_mask(sysent))
+		return "";
+	const char *value = oval_sysent_get_value(sysent);
+	return value ? value : "";
+}
+
+/* string() of the first entity of given name */
+static struct oval_sysent *_report_sysitem_entity(struct oval_sysitem *sysitem, const char *name)
+{
+	struct oval_sysent *found = NULL;
+	struct oval_sysent_iterator *sysents = oval_sysitem_get_sysents(sysitem);
+	while (found == NULL && oval_sysent_iterator_has_more(sysents)) {
+		struct oval_sysent *sysent = oval_sysent_iterator_next(sysents);
+		if (oscap_streq(oval_sysent_get_name(sysent), name))
+			found = sysent;
+	}
+	oval_sysent_iterator_free(sysents);
+	return found;
+}
+
+static const char *_report_sysitem_value(struct oval_sysitem *sysitem, const char *name)
+{
+	struct oval_sysent *sysent = _report_sysitem_entity(sysitem, name);
+	return sysent ? _report_sysent_value(sysent) : "";
+}
+
+static void _report_permission(struct oscap_string *permissions, struct oval_sysitem *sysitem, const char *name)
+{
+	struct oval_sysent *sysent = _report_sysitem_entity(sysitem, name);
+	if (sysent == NULL)
+		return;
+	if (strcmp(_report_sysent_value(sysent), "true") == 0)
+		oscap_string_append_char(permissions, name[1] == 'e' ? 'x' : name[1]);
+	else
+		oscap_string_append_char(permissions, '-');
+}
+
+static void _report_special_permission(struct oscap_string *permissions, struct oval_sysitem *sysitem, const char *name, const char *set, const char *fallback)
+{
+	if (strcmp(_report_sysitem_value(sysitem, name), "true") == 0)
+		oscap_string_append_string(permissions, set);
+	else if (fallback != NULL)
+		_report_permission(permissions, sysitem, fallback);
+	else
+		oscap_string_append_string(permissions, NBSP);
+}
+
+static void _report_item_path(struct xccdf_report *report, xmlNode *tr, struct oval_sysitem *sysitem)
+{
+	char *path = oscap_sprintf("%s/%s", _report_sysitem_value(sysitem, "path"), _report_sysitem_value(sysitem, "filename"));
+	_report_text_element(report, tr, "td", NULL, path);
+	free(path);
+}
+
+static void _report_item_body(struct xccdf_report *report, xmlNode *tbody, struct oval_sysitem *sysitem)
+{
+	xmlNode *tr = _report_element(report, tbody, "tr", NULL);
+	switch (oval_sysitem_get_subtype(sysitem)) {
+	case OVAL_UNIX_FILE: {
+		_report_item_path(report, tr, sysitem);
+		const char *columns[] = { "type", "user_id", "group_id", "size" };
+		for (size_t i = 0; i < sizeof(columns) / sizeof(columns[0]); i++)
+			_report_text_element(report, tr, "td", NULL, _report_sysitem_value(sysitem, columns[i]));
+		struct oscap_string *permissions = oscap_string_new();
+		_report_permission(permissions, sysitem, "uread");
+		_report_permission(permissions, sysitem, "uwrite");
+		_report_special_permission(permissions, sysitem, "suid", "s", "uexec");
+		_report_permission(permissions, sysitem, "gread");
+		_report_permission(permissions, sysitem, "gwrite");
+		_report_special_permission(permissions, sysitem, "sgid", "s", "gexec");
+		_report_permission(permissions, sysitem, "oread");
+		_report_permission(permissions, sysitem, "owrite");
+		_report_permission(permissions, sysitem, "oexec");
+		_report_special_permission(permissions, sysitem, "sticky", "t", NULL);
+		_report_text_element(report, _report_element(report, tr, "td", NULL), "code", NULL, oscap_string_get_cstr(permissions));
+		oscap_string_free(permissions);
+		break;
+	}
+	case OVAL_INDEPENDENT_TEXT_FILE_CONTENT:
+		_report_item_path(report, tr, sysitem);
+		_report_text_element(report, tr, "td", NULL, _report_sysitem_value(sysitem, "text"));
+		break;
+	default: {
+		struct oval_message_iterator *messages = oval_sysitem_get_messages(sysitem);
+		while (oval_message_iterator_has_more(messages))
+			_report_text_element(report, tr, "td", NULL, oval_message_get_text(oval_message_iterator_next(messages)));
+		oval_message_iterator_free(messages);
+		struct oval_sysent_iterator *sysents = oval_sysitem_get_sysents(sysitem);
+		while (oval_sysent_iterator_has_more(sysents)) {
+			struct oval_sysent *sysent = oval_sysent_iterator_next(sysents);
+			xmlNode *td = _report_element(report, tr, "td", NULL);
+			oval_datatype_t datatype = oval_sysent_get_datatype(sysent);
+			if (datatype == OVAL_DATATYPE_INTEGER || datatype == OVAL_DATATYPE_BOOLEAN)
+				xmlNewProp(td, BAD_CAST "role", BAD_CAST "num");
+			const char *value = _report_sysent_value(sysent);
+			_report_text(report, td, value);
+			/* the fields of a record get indented when the record has no text */
+			struct oval_record_field_iterator *fields = oval_sysent_get_record_fields(sysent);
+			bool has_fields = false;
+			while (oval_record_field_iterator_has_more(fields)) {
+				struct oval_record_field *field = oval_record_field_iterator_next(fields);
+				if (*value == '\0')
+					_report_indent(report, td, OVAL_RESULTS_ITEM_DEPTH + 2);
+				if (!oval_record_field_get_mask(field) && !oval_sysent_get_mask(sysent))
+					_report_text(report, td, oval_record_field_get_value(field));
+				has_fields = true;
+			}
+			oval_record_field_iterator_free(fields);
+			if (has_fields && *value == '\0')
+				_report_indent(report, td, OVAL_RESULTS_ITEM_DEPTH + 1);
+		}
+		oval_sysent_iterator_free(sysents);
+		break;
+	}
+	}
+}
+
+/* The string value of a set built by the API, the parsed ones have it from the source */
+static void _report_setobject_text(struct oscap_string *text, struct oval_setobject *set)
+{
+	if (oval_setobject_get_type(set) == OVAL_SET_AGGREGATE) {
+		struct oval_setobject_iterator *subsets = oval_setobject_get_subsets(set);
+		while (oval_setobject_iterator_has_more(subsets))
+			_report_setobject_text(text, oval_setobject_iterator_next(subsets));
+		oval_setobject_iterator_free(subsets);
+		return;
+	}
+	struct oval_object_iterator *objects = oval_setobject_get_objects(set);
+	while (oval_object_iterator_has_more(objects))
+		oscap_string_append_string(text, oval_object_get_id(oval_object_iterator_next(objects)));
+	oval_object_iterator_free(objects);
+	struct oval_filter_iterator *filters = oval_setobject_get_filters(set);
+	while (oval_filter_iterator_has_more(filters)) {
+		struct oval_state *state = oval_filter_get_state(oval_filter_iterator_next(filters));
+		if (state != NULL)
+			oscap_string_append_string(text, oval_state_get_id(state));
+	}
+	oval_filter_iterator_free(filters);
+}
+
+/* Children of the object element in the order they are exported: notes, behaviors and the content */
+struct xccdf_report_object_child {
+	char *name;
+	char *text;
+	bool has_children;
+	bool var_ref;
+};
+
+static struct oscap_list *_report_object_children(struct oval_object *object)
+{
+	struct oscap_list *children = oscap_list_new();
+
+	struct oval_string_iterator *notes = oval_object_get_notes(object);
+	if (oval_string_iterator_has_more(notes)) {
+		struct oscap_string *text = oscap_string_new();
+		if (oval_object_get_notes_text(object) != NULL) {
+			oscap_string_append_string(text, oval_object_get_notes_text(object));
+		} else {
+			while (oval_string_iterator_has_more(notes))
+				oscap_string_append_string(text, oval_string_iterator_next(notes));
+		}
+		struct xccdf_report_object_child *child = calloc(1, sizeof(struct xccdf_report_object_child));
+		child->name = oscap_strdup("notes");
+		child->text = oscap_string_bequeath(text);
+		child->has_children = true;
+		oscap_list_add(children, child);
+	}
+	oval_string_iterator_free(notes);
+
+	struct oval_behavior_iterator *behaviors = oval_object_get_behaviors(object);
+	if (oval_behavior_iterator_has_more(behaviors)) {
+		struct xccdf_report_object_child *child = calloc(1, sizeof(struct xccdf_report_object_child));
+		child->name = oscap_strdup("behaviors");
+		child->text = oscap_strdup("");
+		oscap_list_add(children, child);
+	}
+	oval_behavior_iterator_free(behaviors);
+
+	struct oval_object_content_iterator *contents = oval_object_get_object_contents(object);
+	while (oval_object_content_iterator_has_more(contents)) {
+		struct oval_object_content *content = oval_object_content_iterator_next(contents);
+		struct xccdf_report_object_child *child = calloc(1, sizeof(struct xccdf_report_object_child));
+		switch (oval_object_content_get_type(content)) {
+		case OVAL_OBJECTCONTENT_ENTITY: {
+			struct oval_entity *entity = oval_object_content_get_entity(content);
+			child->name = oscap_strdup(oval_entity_get_name(entity));
+			oval_entity_varref_type_t varref_type = oval_entity_get_varref_type(entity);
+			struct oval_value *value = oval_entity_get_value(entity);
+			if (varref_type == OVAL_ENTITY_VARREF_ELEMENT)
+				child->text = oscap_strdup(oval_variable_get_id(oval_entity_get_variable(entity)));
+			else
+				child->text = oscap_strdup(value ? oval_value_get_text(value) : "");
+			child->var_ref = varref_type == OVAL_ENTITY_VARREF_ATTRIBUTE;
+			break;
+		}
+		case OVAL_OBJECTCONTENT_SET: {
+			struct oscap_string *text = oscap_string_new();
+			if (oval_object_get_set_text(object) != NULL)
+				oscap_string_append_string(text, oval_object_get_set_text(object));
+			else
+				_report_setobject_text(text, oval_object_content_get_setobject(content));
+			child->name = oscap_strdup("set");
+			child->text = oscap_string_bequeath(text);
+			child->has_children = true;
+			break;
+		}
+		case OVAL_OBJECTCONTENT_FILTER: {
+			struct oval_state *state = oval_filter_get_state(oval_object_content_get_filter(content));
+			child->name = oscap_strdup("filter");
+			child->text = oscap_strdup(state ? oval_state_get_id(state) : "");
+			break;
+		}
+		default:
+			free(child);
+			continue;
+		}
+		if (child->text == NULL)
+			child->text = oscap_strdup("");
+		oscap_list_add(children, child);
+	}
+	oval_object_content_iterator_free(contents);
+
+	return children;
+}
+
+static void _report_object_child_free(struct xccdf_report_object_child *child)
+{
+	if (child == NULL)
+		return;
+	free(child->name);
+	free(child->text);
+	free(child);
+}
+
+/* The object of a test which hasn't found any items */
+static void _report_oval_object(struct xccdf_report *report, xmlNode *parent, struct oval_result_test *test, struct oval_object *object)
+{
+	const char *object_id = oval_object_get_id(object);
+
+	_report_text_element(report, parent, "h5", NULL, "No items have been found conforming to the following objects:");
+	xmlNode *h5 = _report_text_element(report, parent, "h5", NULL, "Object ");
+	xmlNode *abbr = _report_text_element(report, _report_element(report, h5, "strong", NULL), "abbr", NULL, object_id);
+	const char *comment = oval_object_get_comment(object);
+	if (comment != NULL)
+		xmlNewProp(abbr, BAD_CAST "title", BAD_CAST comment);
+	_report_text(report, h5, " of type\n                ");
+	char *type = oscap_sprintf("%s_object", oval_subtype_get_text(oval_object_get_subtype(object)));
+	_report_text_element(report, h5, "strong", NULL, type);
+	free(type);
+
+	struct oscap_list *children = _report_object_children(object);
+	xmlNode *table = _report_element(report, parent, "table", "table table-striped table-bordered");
+	xmlNode *tr = _report_element(report, _report_element(report, table, "thead", NULL), "tr", NULL);
+	bool var_ref = false;
+	for (struct oscap_list_item *it = children->first; it != NULL; it = it->next) {
+		struct xccdf_report_object_child *child = it->data;
+		_report_item_label(report, tr, child->name);
+		var_ref |= child->var_ref;
+	}
+
+	tr = _report_element(report, _report_element(report, table, "tbody", NULL), "tr", NULL);
+	if (var_ref) {
+		xmlNode *td = _report_element(report, tr, "td", NULL);
+		struct oscap_list *values = oscap_list_new();
+		struct oval_variable_binding_iterator *bindings = oval_result_test_get_bindings(test);
+		while (oval_variable_binding_iterator_has_more(bindings)) {
+			struct oval_string_iterator *binding_values = oval_variable_binding_get_values(oval_variable_binding_iterator_next(bindings));
+			while (oval_string_iterator_has_more(binding_values))
+				oscap_list_add(values, oval_string_iterator_next(binding_values));
+			oval_string_iterator_free(binding_values);
+		}
+		oval_variable_binding_iterator_free(bindings);
+		if (oval_result_test_get_result(test) != OVAL_RESULT_NOT_EVALUATED) {
+			if (values->itemcount > 1) {
+				xmlNode *values_table = _report_element(report, td, "table", NULL);
+				for (struct oscap_list_item *it = values->first; it != NULL; it = it->next) {
+					if (!_report_is_blank(it->data))
+						_report_text_element(report, _report_element(report, values_table, "tr", NULL), "td", NULL, it->data);
+				}
+			} else if (values->itemcount == 1 && !_report_is_blank(values->first->data)) {
+				_report_text(report, td, values->first->data);
+			}
+		}
+		oscap_list_free(values, NULL);
+
+		struct oscap_list *syschars = oscap_htable_get(report->oval_objects, object_id);
+		for (struct oscap_list_item *it = syschars ? syschars->first : NULL; it != NULL; it = it->next) {
+			struct oval_message_iterator *messages = oval_syschar_get_messages(it->data);
+			if (oval_message_iterator_has_more(messages))
+				_report_text(report, td, oval_message_get_text(oval_message_iterator_next(messages)));
+			oval_message_iterator_free(messages);
+		}
+	}
+	for (struct oscap_list_item *it = children->first; it != NULL; it = it->next) {
+		struct xccdf_report_object_child *child = it->data;
+		if (!child->has_children && _report_is_blank(child->text) && !child->var_ref)
+			_report_text_element(report, tr, "td", NULL, "no value");
+		if (child->has_children || !_report_is_blank(child->text))
+			_report_text_element(report, tr, "td", NULL, child->text);
+	}
+	oscap_list_free(children, (oscap_destruct_func) _report_object_child_free);
+}
+
+/* ovalres:test in the "brief" mode */
+static void _report_oval_test(struct xccdf_report *report, xmlNode *parent, struct oval_result_test *test)
+{
+	struct oval_test *definition = oval_result_test_get_test(test);
+	oval_result_t result = oval_result_test_get_result(test);
+
+	xmlNode *h4 = _report_element(report, parent, "h4", NULL);
+	const char *comment = definition ? oval_test_get_comment(definition) : NULL;
+	if (comment != NULL) {
+		_report_text_element(report, h4, "span", "label label-primary", comment);
+		_report_text(report, h4, NBSP "\n        ");
+	}
+	_report_text_element(report, h4, "span", "label label-default", oval_result_test_get_id(test));
+	_report_text(report, h4, NBSP "\n        ");
+	_report_text_element(report, h4, "span", result == OVAL_RESULT_TRUE ? "label label-success" : "label label-danger", oval_result_get_text(result));
+
+	/* the items are not exported for the tests which were not evaluated */
+	struct oscap_list *items = oscap_list_new();
+	if (result != OVAL_RESULT_NOT_EVALUATED) {
+		struct oval_result_item_iterator *result_items = oval_result_test_get_items(test);
+		while (oval_result_item_iterator_has_more(result_items))
+			oscap_list_add(items, oval_result_item_get_sysitem(oval_result_item_iterator_next(result_items)));
+		oval_result_item_iterator_free(result_items);
+	}
+
+	if (items->itemcount > 0) {
+		_report_text_element(report, parent, "h5", NULL, "Following items have been found on the system:");
+		xmlNode *table = _report_element(report, parent, "table", "table table-striped table-bordered");
+		xmlNode *thead = _report_element(report, table, "thead", NULL);
+		struct oscap_list *first = oscap_htable_get(report->oval_items, oval_sysitem_get_id(items->first->data));
+		for (struct oscap_list_item *it = first ? first->first : NULL; it != NULL; it = it->next)
+			_report_item_head(report, thead, it->data);
+		xmlNode *tbody = _report_element(report, table, "tbody", NULL);
+		unsigned int position = 0;
+		for (struct oscap_list_item *it = items->first; it != NULL && ++position <= OVAL_TEST_ITEMS_LIMIT; it = it->next) {
+			struct oscap_list *sysitems = oscap_htable_get(report->oval_items, oval_sysitem_get_id(it->data));
+			for (struct oscap_list_item *iit = sysitems ? sysitems->first : NULL; iit != NULL; iit = iit->next)
+				_report_item_body(report, tbody, iit->data);
+		}
+		if (items->itemcount > OVAL_TEST_ITEMS_LIMIT) {
+			char *text = oscap_sprintf("\n                ... and %zu more items.\n            ", items->itemcount - OVAL_TEST_ITEMS_LIMIT);
+			_report_text(report, parent, text);
+			free(text);
+		}
+	} else {
+		struct oval_object *object = definition ? oval_test_get_object(definition) : NULL;
+		if (object != NULL)
+			_report_oval_object(report, parent, test, object);
+	}
+	oscap_list_free(items, NULL);
+}
+
+static void _report_oval_definition(struct xccdf_report *report, xmlNode *parent, const struct xccdf_report_definition *entry);
+
+static void _report_oval_definitions(struct xccdf_report *report, xmlNode *parent, const char *id)
+{
+	struct oscap_list *definitions = oscap_htable_get(report->oval_definitions, id);
+	for (struct oscap_list_item *it = definitions ? definitions->first : NULL; it != NULL; it = it->next)
+		_report_oval_definition(report, parent, it->data);
+}
+
+/* The criteria in the "brief" mode, the whitespace of the saved results is copied too */
+static void _report_oval_criteria(struct xccdf_report *report, xmlNode *parent, struct oval_result_criteria_node *node, int depth)
+{
+	switch (oval_result_criteria_node_get_type(node)) {
+	case OVAL_NODETYPE_CRITERIA: {
+		bool empty = true;
+		struct oval_result_criteria_node_iterator *subnodes = oval_result_criteria_node_get_subnodes(node);
+		while (oval_result_criteria_node_iterator_has_more(subnodes)) {
+			_report_indent(report, parent, depth + 1);
+			_report_oval_criteria(report, parent, oval_result_criteria_node_iterator_next(subnodes), depth + 1);
+			empty = false;
+		}
+		oval_result_criteria_node_iterator_free(subnodes);
+		if (!empty)
+			_report_indent(report, parent, depth);
+		break;
+	}
+	case OVAL_NODETYPE_CRITERION: {
+		struct oval_result_test *test = oval_result_criteria_node_get_test(node);
+		const char *test_id = test ? oval_result_test_get_id(test) : NULL;
+		struct oscap_list *tests = test_id ? oscap_htable_get(report->oval_tests, test_id) : NULL;
+		for (struct oscap_list_item *it = tests ? tests->first : NULL; it != NULL; it = it->next)
+			_report_oval_test(report, parent, it->data);
+		break;
+	}
+	case OVAL_NODETYPE_EXTENDDEF: {
+		struct oval_result_definition *extends = oval_result_criteria_node_get_extends(node);
+		if (extends != NULL)
+			_report_oval_definitions(report, parent, oval_result_definition_get_id(extends));
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+static void _report_oval_definition(struct xccdf_report *report, xmlNode *parent, const struct xccdf_report_definition *entry)
+{
+	/* only the full content has the criteria */
+	if (entry->content != OVAL_DIRECTIVE_CONTENT_FULL)
+		return;
+	struct oval_result_criteria_node *criteria = oval_result_definition_get_criteria(entry->definition);
+	if (criteria != NULL)
+		_report_oval_criteria(report, parent, criteria, OVAL_RESULTS_CRITERIA_DEPTH);
+}
+
+static int _report_definition_position_cmp(const void *a, const void *b)
+{
+	const struct xccdf_report_definition *def_a = *(const struct xccdf_report_definition **) a;
+	const struct xccdf_report_definition *def_b = *(const struct xccdf_report_definition **) b;
+	return (def_a->position > def_b->position) - (def_a->position < def_b->position);
+}
+
+static void _report_oval_details(struct xccdf_report *report, xmlNode *parent, const struct xccdf_rule_result *rule_result)
+{
+	if (report->oval_report_id == NULL)
+		return;
+
+	/* the definitions of all the check-content-refs, in the document order */
+	struct oscap_list *found = oscap_list_new();
+	struct oscap_htable *seen = oscap_htable_new();
+	RULE_RESULT_CHECKS_FOREACH(rule_result, check) {
+		for (struct oscap_list_item *it = check->content_refs->first; it != NULL; it = it->next) {
+			struct xccdf_check_content_ref *ref = it->data;
+			if (ref->name == NULL || !oscap_htable_add(seen, ref->name, ref))
+				continue;
+			struct oscap_list *definitions = oscap_htable_get(report->oval_definitions, ref->name);
+			for (struct oscap_list_item *dit = definitions ? definitions->first : NULL; dit != NULL; dit = dit->next)
+				oscap_list_add(found, dit->data);
+		}
+	}
+	oscap_htable_free(seen, NULL);
+	if (found->itemcount == 0) {
+		oscap_list_free(found, NULL);
+		return;
+	}
+	size_t size = found->itemcount, i = 0;
+	const struct xccdf_report_definition **sorted = malloc(size * sizeof(struct xccdf_report_definition *));
+	for (struct oscap_list_item *it = found->first; it != NULL; it = it->next)
+		sorted[i++] = it->data;
+	qsort(sorted, size, sizeof(struct xccdf_report_definition *), _report_definition_position_cmp);
+
+	xmlNode *details = _report_element(report, NULL, "div", NULL);
+	for (i = 0; i < size; i++)
+		_report_oval_definition(report, details, sorted[i]);
+	free(sorted);
+	oscap_list_free(found, NULL);
+
+	xmlChar *content = xmlNodeGetContent(details);
+	bool blank = _report_is_blank((const char *) content);
+	xmlFree(content);
+	if (blank) {
+		xmlFreeNode(details);
+		return;
+	}
+
+	xmlNode *abbr = _report_text_element(report, _report_element(report, parent, "span", "label label-default"), "abbr", NULL, "OVAL test results details");
+	char *title = oscap_sprintf("OVAL details taken from arf:report with id='%s'", report->oval_report_id);
+	xmlNewProp(abbr, BAD_CAST "title", BAD_CAST title);
+	free(title);
+	xmlNode *body = _report_element(report, _report_element(report, parent, "div", "panel panel-default"), "div", "panel-body");
+	xmlNode *child = details->children;
+	while (child != NULL) {
+		xmlNode *next = child->next;
+		xmlUnlinkNode(child);
+		xmlAddChild(body, child);
+		child = next;
+	}
+	xmlFreeNode(details);
+}
+
+static void _report_sce_output(struct xccdf_report *report, xmlNode *parent, const char *name, const char *origin, const char *text)
+{
+	xmlNode *abbr = _report_text_element(report, _report_element(report, parent, "span", "label label-default"), "abbr", NULL, !strcmp(name, "stdout") ? "SCE stdout" : "SCE stderr");
+	char *title = oscap_sprintf("Script Check Engine %s taken from %s", name, origin);
+	xmlNewProp(abbr, BAD_CAST "title", BAD_CAST title);
+	free(title);
+	_report_text_element(report, _report_element(report, parent, "pre", NULL), "code", NULL, text);
+}
+
+/* The first text node of the exported check-import, its content is parsed for entities */
+static char *_report_check_import_text(struct xccdf_report *report, const struct xccdf_rule_result *rule_result, const char *name)
+{
+	RULE_RESULT_CHECKS_FOREACH(rule_result, check) {
+		for (struct oscap_list_item *it = check->imports->first; it != NULL; it = it->next) {
+			struct xccdf_check_import *import = it->data;
+			if (!oscap_streq(import->name, name) || import->content == NULL)
+				continue;
+			xmlNode *node = xmlNewDocNode(report->doc, NULL, BAD_CAST "check-import", BAD_CAST import->content);
+			char *text = NULL;
+			for (xmlNode *child = node->children; child != NULL && text == NULL; child = child->next) {
+				if (child->type == XML_TEXT_NODE)
+					text = oscap_strdup((const char *) child->content);
+			}
+			xmlFreeNode(node);
+			if (text != NULL)
+				return text;
+		}
+	}
+	return NULL;
+}
+
+static void _report_sce_details(struct xccdf_report *report, xmlNode *parent, const struct xccdf_rule_result *rule_result)
+{
+	char *out = _report_check_import_text(report, rule_result, "stdout");
+	char *err = _report_check_import_text(report, rule_result, "stderr");
+	if (out != NULL || err != NULL) {
+		if (out != NULL)
+			_report_sce_output(report, parent, "stdout", "check-import", out);
+		if (err != NULL)
+			_report_sce_output(report, parent, "stderr", "check-import", err);
+		free(out);
+		free(err);
+		return;
+	}
+
+	if (report->sce_template == NULL || *report->sce_template == '\0')
+		return;
+	char *filename = NULL;
+	const char *percent = strchr(report->sce_template, '%');
+	if (percent != NULL) {
+		const char *href = "";
+		RULE_RESULT_CHECKS_FOREACH(rule_result, check) {
+			if (check->content_refs->first != NULL) {
+				href = ((struct xccdf_check_content_ref *) check->content_refs->first->data)->href;
+				break;
+			}
+		}
+		filename = oscap_sprintf("%.*s%s%s", (int) (percent - report->sce_template), report->sce_template, href ? href : "", percent + 1);
+	} else {
+		filename = oscap_strdup(report->sce_template);
+	}
+
+	xmlDoc *doc = access(filename, R_OK) == 0 ? _report_read_file(filename) : NULL;
+	xmlNode *root = doc ? xmlDocGetRootElement(doc) : NULL;
+	if (root != NULL && root->ns != NULL && xmlStrEqual(root->ns->href, BAD_CAST SCE_RESULTS_NS)
+	    && xmlStrEqual(root->name, BAD_CAST "sce_results")) {
+		char *origin = oscap_sprintf("'%s'", filename);
+		const char *names[] = { "stdout", "stderr" };
+		for (size_t i = 0; i < 2; i++) {
+			/* all the text nodes of the elements */
+			struct oscap_string *text = oscap_string_new();
+			for (xmlNode *node = root->children; node != NULL; node = node->next) {
+				if (node->type != XML_ELEMENT_NODE || node->ns == NULL || !xmlStrEqual(node->ns->href, BAD_CAST SCE_RESULTS_NS)
+				    || !xmlStrEqual(node->name, BAD_CAST names[i]))
+					continue;
+				for (xmlNode *child = node->children; child != NULL; child = child->next) {
+					if (child->type == XML_TEXT_NODE || child->type == XML_CDATA_SECTION_NODE)
+						oscap_string_append_string(text, (const char *) child->content);
+				}
+			}
+			if (!_report_is_blank(oscap_string_get_cstr(text)))
+				_report_sce_output(report, parent, names[i], origin, oscap_string_get_cstr(text));
+			oscap_string_free(text);
+		}
+		free(origin);
+	}
+	xmlFreeDoc(doc);
+	free(filename);
+}
+
+/* check-system-details */
+static void _report_check_system_details(struct xccdf_report *report, xmlNode *parent, const struct xccdf_rule_result *rule_result, xccdf_test_result_type_t result)
+{
+	if (_report_rule_result_has_check_system(rule_result, OVAL5_CHECK_SYSTEM))
+		_report_oval_details(report, parent, rule_result);
+	else if (_report_rule_result_has_check_system(rule_result, SCE_CHECK_SYSTEM))
+		_report_sce_details(report, parent, rule_result);
+}
+
+/*
+ * The report
+ */
+
+static bool _report_write_head(struct xccdf_report *report)
+{
+	xmlDoc *resources = NULL;
+	if (!_report_load_file(report, "xccdf-resources.xsl", &resources))
+		return false;
+
+	_report_write(report, "<!DOCTYPE html><html lang=\"en\"><head>"
+		"<meta http-equiv=\"Content-Type\" content=\"text/html; charset=utf-8\">"
+		"<meta http-equiv=\"X-UA-Compatible\" content=\"IE=edge\">"
+		"<meta name=\"viewport\" content=\"width=device-width, initial-scale=1\">");
+	char *title = oscap_sprintf("%s | OpenSCAP Evaluation Report", report->result->item.id);
+	_report_flush(report, _report_text_element(report, NULL, "title", NULL, title));
+	free(title);
+	_report_write(report, "<style>");
+	_report_write_template_text(report, resources, "css-sources");
+	_report_write(report, "</style><script>");
+	_report_write_template_text(report, resources, "js-sources");
+	_report_write(report, "</script></head><body>");
+	xmlFreeDoc(resources);
+	return true;
+}
+
+static bool _report_write_header(struct xccdf_report *report)
+{
+	xmlDoc *branding = NULL;
+	if (!_report_load_file(report, "xccdf-branding.xsl", &branding))
+		return false;
+
+	_report_write(report, "<nav class=\"navbar navbar-default\"><div class=\"navbar-header\" style=\"float: none\"><a class=\"navbar-brand\" href=\"#\">");
+	xmlNode *logo = _report_find_template(branding, "xccdf-branding-logo");
+	for (xmlNode *node = logo ? logo->children : NULL; node != NULL; node = node->next) {
+		if (node->type == XML_ELEMENT_NODE)
+			_report_flush(report, xmlDocCopyNode(node, report->doc, 1));
+	}
+	_report_write(report, "</a><div><h1>OpenSCAP Evaluation Report</h1></div></div></nav>");
+	xmlFreeDoc(branding);
+	return true;
+}
+
+static void _report_write_footer(struct xccdf_report *report)
+{
+	_report_write(report, "<footer id=\"footer\"><div class=\"container\"><p class=\"muted credit\">\n"
+		"                Generated using <a href=\"http://open-scap.org\">OpenSCAP</a>");
+	char *version = oscap_sprintf(" %s", oscap_get_version());
+	_report_write_text(report, version);
+	free(version);
+	_report_write(report, "</p></div></footer></body></html>\n");
+}
+
+static void _report_free_rule_counts(void *counts)
+{
+	free(counts);
+}
+
+static bool _report_is_literal_bool(const xmlNode *node, const char *attr)
+{
+	xmlChar *value = xmlGetProp(node, BAD_CAST attr);
+	bool literal = value != NULL && (xmlStrEqual(value, BAD_CAST "1") || xmlStrEqual(value, BAD_CAST "0"));
+	xmlFree(value);
+	return literal;
+}
+
+/* Whether the stylesheet renders the element and its XCCDF descendants as the model */
+static bool _report_source_supported(const xmlNode *node)
+{
+	const char *name = (const char *) node->name;
+
+	/* the resolution fills in the inherited properties and removes the abstract items */
+	if (xmlHasProp(node, BAD_CAST "extends") != NULL)
+		return false;
+	xmlChar *abstract = xmlGetProp(node, BAD_CAST "abstract");
+	bool is_abstract = abstract != NULL && !xmlStrEqual(abstract, BAD_CAST "false") && !xmlStrEqual(abstract, BAD_CAST "0");
+	xmlFree(abstract);
+	if (is_abstract)
+		return false;
+	/* the stylesheet picks the TestResult by its id or end time from all of them */
+	if (strcmp(name, "TestResult") == 0)
+		return false;
+	/* booleans are compared with "true", selectors tell "" from a missing one */
+	if ((strcmp(name, "Value") == 0 && _report_is_literal_bool(node, "prohibitChanges"))
+			|| (strcmp(name, "check") == 0 && _report_is_literal_bool(node, "multi-check"))
+			|| (strcmp(name, "fix") == 0 && _report_is_literal_bool(node, "reboot")))
+		return false;
+	if (strcmp(name, "value") == 0) {
+		xmlChar *selector = xmlGetProp(node, BAD_CAST "selector");
+		bool empty = selector != NULL && *selector == '\0';
+		xmlFree(selector);
+		if (empty)
+			return false;
+	}
+
+	for (const xmlNode *child = node->children; child != NULL; child = child->next) {
+		if (child->type != XML_ELEMENT_NODE || child->ns == NULL)
+			continue;
+		if (!xmlStrEqual(child->ns->href, BAD_CAST XCCDF12_NS) && !xmlStrEqual(child->ns->href, BAD_CAST XCCDF11_NS))
+			continue;
+		if (!_report_source_supported(child))
+			return false;
+	}
+	return true;
+}
+
+bool xccdf_benchmark_html_report_supported(struct oscap_source *benchmark_source)
+{
+	xmlDoc *doc = benchmark_source != NULL ? oscap_source_get_xmlDoc(benchmark_source) : NULL;
+	xmlNode *root = doc != NULL ? xmlDocGetRootElement(doc) : NULL;
+	return root != NULL && _report_source_supported(root);
+}
+
+int xccdf_result_export_html_report(struct xccdf_result *result, struct xccdf_benchmark *benchmark,
+		const char *benchmark_uri, const struct xccdf_report_oval *oval_reports, size_t oval_reports_count,
+		const char *sce_template, const char *filename)
+{
+	if (result == NULL || benchmark == NULL || filename == NULL) {
+		oscap_seterr(OSCAP_EFAMILY_OSCAP, "Can't generate the HTML report without the results.");
+		return -1;
+	}
+
+	struct xccdf_report report = {
+		.result = XITEM(result),
+		.benchmark = XITEM(benchmark),
+		.benchmark_uri = benchmark_uri,
+		.rule_results = oscap_htable_new(),
+		.rule_counts = oscap_htable_new(),
+		.generated_ids = oscap_htable_new(),
+	};
+	int ret = -1;
+	const char *profile_id = xccdf_result_get_profile(result);
+	if (profile_id != NULL)
+		report.profile = XITEM(xccdf_benchmark_get_profile_by_id(benchmark, profile_id));
+
+	/* relative SCE templates are resolved against the working directory */
+	if (sce_template != NULL && *sce_template != '\0' && *sce_template != '/') {
+		char pwd[PATH_MAX];
+		if (getcwd(pwd, sizeof(pwd)) == NULL) {
+			oscap_seterr(OSCAP_EFAMILY_OSCAP, "Getcwd() failed: %s", strerror(errno));
+			goto cleanup;
+		}
+		report.sce_template = oscap_sprintf("%s/%s", pwd, sce_template);
+	} else {
+		report.sce_template = oscap_strdup(sce_template);
+	}
+
+	for (struct oscap_list_item *it = report.result->sub.result.rule_results->first; it != NULL; it = it->next) {
+		struct xccdf_rule_result *rule_result = it->data;
+		if (rule_result->idref == NULL)
+			continue;
+		struct oscap_list *list = oscap_htable_get(report.rule_results, rule_result->idref);
+		if (list == NULL) {
+			list = oscap_list_new();
+			oscap_htable_add(report.rule_results, rule_result->idref, list);
+		}
+		oscap_list_add(list, rule_result);
+	}
+	_report_count_rules(&report, report.benchmark, NULL);
+	_report_oval_index(&report, oval_reports, oval_reports_count);
+
+	int fd = strcmp(filename, "-") == 0 ? STDOUT_FILENO : oscap_open_writable(filename);
+	if (fd == -1)
+		goto cleanup;
+	report.out = xmlOutputBufferCreateFd(fd, NULL);
+	report.doc = htmlNewDocNoDtD(NULL, NULL);
+	report.doc->encoding = xmlStrdup(BAD_CAST "utf-8");
+
+	if (_report_write_head(&report) && _report_write_header(&report)) {
+		_report_write(&report, "<div class=\"container\"><div id=\"content\">");
+		_report_introduction(&report);
+		_report_characteristics(&report);
+		_report_compliance_and_scoring(&report);
+		_report_rule_overview(&report);
+		_report_result_details(&report);
+		_report_rear_matter(&report);
+		_report_write(&report, "</div></div>");
+		_report_write_footer(&report);
+		ret = 0;
+	}
+
+	if (xmlOutputBufferClose(report.out) < 0 && ret == 0) {
+		oscap_seterr(OSCAP_EFAMILY_OSCAP, "Could not write the HTML report to %s", filename);
+		ret = -1;
+	}
+	if (fd != STDOUT_FILENO)
+		close(fd);
+	xmlFreeDoc(report.doc);
+
+cleanup:
+	free(report.sce_template);
+	oscap_htable_free(report.rule_results, _report_free_list);
+	oscap_htable_free(report.rule_counts, _report_free_rule_counts);
+	oscap_htable_free(report.generated_ids, free);
+	if (report.oval_definitions != NULL) {
+		oscap_htable_free(report.oval_definitions, _report_free_definitions);
+		oscap_htable_free(report.oval_tests, _report_free_list);
+		oscap_htable_free(report.oval_items, _report_free_list);
+		oscap_htable_free(report.oval_objects, _report_free_list);
+	}
+	return ret;
+}
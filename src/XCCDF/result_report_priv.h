@@ -0,0 +1,74 @@
+/*
+ * Copyright 2026 Red Hat Inc., Durham, North Carolina.
+ * All Rights Reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+#ifndef OSCAP_XCCDF_RESULT_REPORT_H
+#define OSCAP_XCCDF_RESULT_REPORT_H
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stddef.h>
+
+#include "public/xccdf_benchmark.h"
+#include "OVAL/public/oval_results.h"
+
+/**
+ * OVAL results the report takes the OVAL details from, in the order
+ * of the reports in the ARF.
+ */
+struct xccdf_report_oval {
+	const char *report_id;			///< ID of the arf:report with the results
+	struct oval_results_model *results;
+};
+
+/**
+ * Whether the native report of given benchmark is the same as the one of
+ * xccdf-report.xsl. The stylesheet reads the benchmark as it is in the
+ * source, the native report renders the resolved model, so benchmarks with
+ * items the resolution changes are not supported. Neither are the ones with
+ * their own TestResults, "1"/"0" booleans or empty selectors the stylesheet
+ * tells apart from the model values. The model doesn't keep any of these,
+ * they are looked up in the source document of the benchmark.
+ * @memberof xccdf_benchmark
+ * @param benchmark_source source of the XCCDF Benchmark
+ * @returns true if the native report can be used
+ */
+bool xccdf_benchmark_html_report_supported(struct oscap_source *benchmark_source);
+
+/**
+ * Write the HTML report of given XCCDF TestResult. The output is the same as
+ * the one of xccdf-report.xsl applied to the ARF holding the results, but the
+ * report is rendered from the models as it is being written, without
+ * building the ARF nor the HTML DOM.
+ * @memberof xccdf_result
+ * @param result XCCDF TestResult, as attached to the benchmark for the export
+ * @param benchmark XCCDF Benchmark which is origin of given XCCDF TestResult
+ * @param benchmark_uri URI of the benchmark the TestResult refers to
+ * @param oval_reports OVAL results of the evaluation, may be NULL
+ * @param oval_reports_count number of OVAL results
+ * @param sce_template path to SCE results, '%' stands for the check content, may be NULL
+ * @param filename path to the report, "-" for standard output
+ * @returns 0 on success, -1 on failure (oscap_seterr is set)
+ */
+int xccdf_result_export_html_report(struct xccdf_result *result, struct xccdf_benchmark *benchmark,
+		const char *benchmark_uri, const struct xccdf_report_oval *oval_reports, size_t oval_reports_count,
+		const char *sce_template, const char *filename);
+
+#endif
@@ -35,6 +35,7 @@
 #include "helpers.h"
 #include "xccdf_impl.h"
 #include "common/debug_priv.h"
+#include "common/xml_stream.h"
 #include "oscap_helpers.h"
 #include "oscap_string.h"
 
@@ -234,7 +235,7 @@ struct xccdf_item *xccdf_group_parse(xmlTextReaderPtr reader, struct xccdf_item
 				dW("Encountered an unknown element '%s' while parsing XCCDF group.",
 				   xmlTextReaderConstLocalName(reader));
 		}
-		xmlTextReaderRead(reader);
+		xmlTextReaderNextNode(reader);
 	}
 
 	return group;
@@ -363,7 +364,7 @@ struct xccdf_item *xccdf_rule_parse(xmlTextReaderPtr reader, struct xccdf_item *
 				dW("Encountered an unknown element '%s' while parsing XCCDF group.",
 				   xmlTextReaderConstLocalName(reader));
 		}
-		xmlTextReaderRead(reader);
+		xmlTextReaderNextNode(reader);
 	}
 
 	return rule;
@@ -644,7 +645,7 @@ struct xccdf_check *xccdf_check_parse(xmlTextReaderPtr reader)
 		default:
 			break;
 		}
-		xmlTextReaderRead(reader);
+		xmlTextReaderNextNode(reader);
 	}
 
 	return check;
@@ -781,6 +782,7 @@ struct xccdf_fix *xccdf_fix_clone(const struct xccdf_fix *old_fix)
 	struct xccdf_fix *new_fix = calloc(1, sizeof(struct xccdf_fix));
 
 	new_fix->reboot = old_fix->reboot;
+	new_fix->def_reboot = old_fix->def_reboot;
 	new_fix->strategy = old_fix->strategy;
 	new_fix->disruption = old_fix->disruption;
 	new_fix->complexity = old_fix->complexity;
@@ -802,6 +804,7 @@ struct xccdf_fix *xccdf_fix_parse(xmlTextReaderPtr reader)
 	fix->system = xccdf_attribute_copy(reader, XCCDFA_SYSTEM);
 	fix->platform = xccdf_attribute_copy(reader, XCCDFA_PLATFORM);
 	fix->reboot     = xccdf_attribute_get_bool(reader, XCCDFA_REBOOT);
+	fix->def_reboot = xccdf_attribute_has(reader, XCCDFA_REBOOT);
 	fix->strategy   = oscap_string_to_enum(XCCDF_STRATEGY_MAP, xccdf_attribute_get(reader, XCCDFA_STRATEGY));
 	fix->disruption = oscap_string_to_enum(XCCDF_LEVEL_MAP, xccdf_attribute_get(reader, XCCDFA_DISRUPTION));
 	fix->complexity = oscap_string_to_enum(XCCDF_LEVEL_MAP, xccdf_attribute_get(reader, XCCDFA_COMPLEXITY));
@@ -1100,6 +1103,7 @@ void xccdf_group_to_dom(struct xccdf_group *group, xmlNode *group_node, xmlDoc *
 		struct xccdf_value *value = xccdf_value_iterator_next(values);
 		if (XGROUP(xccdf_value_get_parent(value)) == group) {
 			xccdf_item_to_dom((struct xccdf_item *)value, doc, group_node, version_info);
+			oscap_xml_stream_flush(doc, group_node);
 		}
 	}
 	xccdf_value_iterator_free(values);
@@ -1109,6 +1113,7 @@ void xccdf_group_to_dom(struct xccdf_group *group, xmlNode *group_node, xmlDoc *
 		struct xccdf_item *item = xccdf_item_iterator_next(items);
 		if (XGROUP(xccdf_item_get_parent(item)) == group) {
 			xccdf_item_to_dom(item, doc, group_node, version_info);
+			oscap_xml_stream_flush(doc, group_node);
 		}
 	}
 	xccdf_item_iterator_free(items);
@@ -133,7 +133,7 @@ struct xccdf_tailoring *xccdf_tailoring_parse(xmlTextReaderPtr reader, struct xc
 	int depth = oscap_element_depth(reader) + 1;
 
 	// Read to the inside of Tailoring.
-	xmlTextReaderRead(reader);
+	xmlTextReaderNextNode(reader);
 
 	while (oscap_to_start_element(reader, depth)) {
 		switch (xccdf_element_get(reader)) {
@@ -198,7 +198,7 @@ struct xccdf_tailoring *xccdf_tailoring_parse(xmlTextReaderPtr reader, struct xc
 			dW("Encountered an unknown element '%s' while parsing XCCDF Tailoring element.",
 				xmlTextReaderConstLocalName(reader));
 		}
-		xmlTextReaderRead(reader);
+		xmlTextReaderNextNode(reader);
 	}
 
 	return tailoring;
@@ -211,9 +211,12 @@ struct xccdf_tailoring *xccdf_tailoring_import_source(struct oscap_source *sourc
 		return NULL;
 	}
 
-	while (xmlTextReaderRead(reader) == 1 && xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) ;
+	while (xmlTextReaderNextNode(reader) == 1 && xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) ;
 	struct xccdf_tailoring *tailoring = xccdf_tailoring_parse(reader, XITEM(benchmark));
-	xmlFreeTextReader(reader);
+	if (oscap_source_free_xmlTextReader(reader) != 0) {
+		xccdf_tailoring_free(tailoring);
+		tailoring = NULL;
+	}
 	if (!tailoring) { // parsing fatal error
 		oscap_seterr(OSCAP_EFAMILY_XML, "Failed to parse tailoring from '%s'.", oscap_source_readable_origin(source));
 	}
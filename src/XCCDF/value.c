@@ -35,7 +35,6 @@
 #include "common/debug_priv.h"
 #include "oscap_helpers.h"
 
-static struct xccdf_value_instance *xccdf_value_instance_new(xccdf_value_type_t type);
 static struct xccdf_value_instance *_xccdf_value_get_instance_by_selector_internal(const struct xccdf_value *value, const char *selector);
 
 struct xccdf_item *xccdf_value_new_internal(struct xccdf_item *parent, xccdf_value_type_t type)
@@ -157,11 +156,11 @@ struct xccdf_item *xccdf_value_parse(xmlTextReaderPtr reader, struct xccdf_item
 			val = _xccdf_value_find_or_create_instance(XVALUE(value), selector, type);
 			val->flags.must_match = xccdf_attribute_get_bool(reader, XCCDFA_MUSTMATCH);
 			val->flags.must_match_given = true;
-                        xmlTextReaderRead(reader); /* Move to the next node (subnode of <choices>)*/
+                        xmlTextReaderNextNode(reader); /* Move to the next node (subnode of <choices>)*/
 			while (oscap_to_start_element(reader, depth + 1)) {
 				if (xccdf_element_get(reader) == XCCDFE_CHOICE)
 					oscap_list_add(val->choices, oscap_element_string_copy(reader));
-				xmlTextReaderRead(reader);
+				xmlTextReaderNextNode(reader);
 			}
                         break;
 		default:
@@ -170,7 +169,7 @@ struct xccdf_item *xccdf_value_parse(xmlTextReaderPtr reader, struct xccdf_item
 				   xmlTextReaderConstLocalName(reader));
 			break;
 		}
-		xmlTextReaderRead(reader);
+		xmlTextReaderNextNode(reader);
 	}
 
 	return value;
@@ -50,12 +50,15 @@
 #include "DS/sds_priv.h"
 #include "OVAL/results/oval_results_impl.h"
 #include "source/xslt_priv.h"
+#include "source/oscap_source_priv.h"
 #include "source/signature_priv.h"
 #include "XCCDF/xccdf_impl.h"
 #include "XCCDF_POLICY/public/xccdf_policy.h"
 #include "XCCDF_POLICY/xccdf_policy_priv.h"
 #include "XCCDF_POLICY/xccdf_policy_model_priv.h"
 #include "item.h"
+#include "result_report_priv.h"
+#include "benchmark_cache_priv.h"
 #include "public/xccdf_session.h"
 #include "XCCDF_POLICY/public/check_engine_plugin.h"
 #include "oscap_helpers.h"
@@ -79,6 +82,7 @@ struct xccdf_session {
 		struct xccdf_result *result;		///< XCCDF Result model.
 		float base_score;			///< Basec score of the latest evaluation.
 		struct oscap_source *result_source;     ///< oscap_source for the exported XCCDF result
+		bool result_files_exported;		///< XCCDF and STIG Viewer result files have been written
 	} xccdf;
 	struct {
 		struct ds_sds_session *session;         ///< SDS Registry abstract structure
@@ -124,6 +128,7 @@ struct xccdf_session {
 
 	struct oscap_list *check_engine_plugins; ///< Extra non-OVAL check engines that may or may not have been loaded
 	xccdf_session_loading_flags_t loading_flags; ///< Load referenced files while loading XCCDF
+	unsigned int jobs;				///< Number of rules evaluated at once.
 };
 
 static int _xccdf_session_autonegotiate_tailoring_file(struct xccdf_session *session, const char *original_path);
@@ -256,13 +261,18 @@ static struct oscap_source* xccdf_session_create_arf_source(struct xccdf_session
 	return session->oval.arf_report;
 }
 
-static struct oscap_source *xccdf_session_extract_arf_source(struct xccdf_session *session)
+static int xccdf_session_write_arf(struct xccdf_session *session, const char *target_file)
 {
-	struct oscap_source *rds_source = NULL;
+	int ret = -1;
 	char *tailoring_doc_timestamp = NULL;
 	xmlDoc *sds_doc = NULL;
 
 	if (xccdf_session_is_sds(session)) {
+		// components are still read from the datastream which is going
+		// to be consumed by the ARF
+		if (ds_sds_session_detach_components(session->ds.session) != 0) {
+			goto cleanup;
+		}
 		sds_doc = oscap_source_pop_xmlDoc(session->source);
 	} else {
 		sds_doc = ds_sds_compose_xmlDoc_from_xccdf_source(session->source);
@@ -307,21 +317,15 @@ static struct oscap_source *xccdf_session_extract_arf_source(struct xccdf_sessio
 		}
 	}
 
-	xmlDocPtr rds_doc = NULL;
-
-	if (ds_rds_create_from_dom(&rds_doc, sds_doc, tailoring_doc,
+	ret = ds_rds_export_from_dom(target_file, sds_doc, tailoring_doc,
 			tailoring_filepath, tailoring_doc_timestamp, result_file_doc,
 			session->oval.result_sources, session->oval.results_mapping,
-			session->oval.arf_report_mapping) != 0) {
-		goto cleanup;
-	}
-
-	rds_source = oscap_source_new_from_xmlDoc(rds_doc, session->export.arf_file);
+			session->oval.arf_report_mapping);
 
 cleanup:
 	free(tailoring_doc_timestamp);
 	xmlFreeDoc(sds_doc);
-	return rds_source;
+	return ret;
 }
 
 void xccdf_session_free(struct xccdf_session *session)
@@ -409,6 +413,11 @@ void xccdf_session_set_thin_results(struct xccdf_session *session, bool thin_res
 	session->export.thin_results = thin_results;
 }
 
+void xccdf_session_set_jobs(struct xccdf_session *session, unsigned int jobs)
+{
+	session->jobs = jobs;
+}
+
 void xccdf_session_set_datastream_id(struct xccdf_session *session, const char *datastream_id)
 {
 	free(session->ds.user_datastream_id);
@@ -743,7 +752,7 @@ static inline int _xccdf_session_load_xccdf_benchmark(struct xccdf_session *sess
 	}
 
 	/* Load XCCDF model and XCCDF Policy model */
-	struct xccdf_benchmark *benchmark = xccdf_benchmark_import_source(session->xccdf.source);
+	struct xccdf_benchmark *benchmark = xccdf_benchmark_import_resolved_source(session->xccdf.source);
 	if (benchmark == NULL) {
 		return 1;
 	}
@@ -1346,6 +1355,7 @@ int xccdf_session_evaluate(struct xccdf_session *session)
 		oscap_htable_add(policy->skip_rules, rule_id, (void *)true);
 	}
 	oscap_iterator_free(sit);
+	policy->jobs = session->jobs;
 
 	session->xccdf.result = xccdf_policy_evaluate(policy);
 	if (session->xccdf.result == NULL)
@@ -1424,6 +1434,114 @@ static inline int _xccdf_gen_report(struct oscap_source *infile, const char *id,
 	return _app_xslt(infile, "xccdf-report.xsl", outfile, params);
 }
 
+/* The HTML report is rendered natively only if OSCAP_REPORT_GENERATOR=native
+ * and the native report of the benchmark is the same as the XSLT one */
+static bool _xccdf_session_native_report(struct xccdf_session *session)
+{
+	const char *generator = getenv("OSCAP_REPORT_GENERATOR");
+	if (generator == NULL || strcmp(generator, "native") != 0)
+		return false;
+	if (!xccdf_benchmark_html_report_supported(session->xccdf.source)) {
+		dI("The HTML report is generated from the ARF, the built-in generator doesn't support the benchmark.");
+		return false;
+	}
+	return true;
+}
+
+static struct oval_agent_session *_xccdf_session_find_oval_agent(struct xccdf_session *session, const char *filename)
+{
+	for (int i = 0; session->oval.agents && session->oval.agents[i]; i++) {
+		if (oscap_streq(oval_agent_get_filename(session->oval.agents[i]), filename))
+			return session->oval.agents[i];
+	}
+	struct oval_agent_session *found = NULL;
+	struct oscap_htable_iterator *cpe_it = xccdf_policy_model_get_cpe_oval_sessions(session->xccdf.policy_model);
+	while (found == NULL && oscap_htable_iterator_has_more(cpe_it)) {
+		struct oval_agent_session *value = oscap_htable_iterator_next_value(cpe_it);
+		if (oscap_streq(oval_agent_get_filename(value), filename))
+			found = value;
+	}
+	oscap_htable_iterator_free(cpe_it);
+	return found;
+}
+
+static int _xccdf_session_gen_native_report(struct xccdf_session *session)
+{
+	/* The OVAL results in the order of the reports in the ARF, the report IDs
+	 * are assigned the same way the ARF assigns them when there is none. */
+	struct oscap_htable *report_mapping = session->oval.arf_report_mapping;
+	if (report_mapping == NULL) {
+		report_mapping = oscap_htable_new();
+		int counter = 0;
+		for (int i = 0; session->oval.agents && session->oval.agents[i]; i++) {
+			char *report_id = oscap_sprintf("oval%d", counter++);
+			if (!oscap_htable_add(report_mapping, oval_agent_get_filename(session->oval.agents[i]), report_id))
+				free(report_id);
+		}
+		struct oscap_htable_iterator *cpe_it = xccdf_policy_model_get_cpe_oval_sessions(session->xccdf.policy_model);
+		while (oscap_htable_iterator_has_more(cpe_it)) {
+			struct oval_agent_session *value = oscap_htable_iterator_next_value(cpe_it);
+			char *report_id = oscap_sprintf("oval%d", counter++);
+			if (!oscap_htable_add(report_mapping, oval_agent_get_filename(value), report_id))
+				free(report_id);
+		}
+		oscap_htable_iterator_free(cpe_it);
+	}
+
+	size_t count = 0;
+	struct oscap_htable_iterator *hit = oscap_htable_iterator_new(report_mapping);
+	while (oscap_htable_iterator_has_more(hit)) {
+		oscap_htable_iterator_next(hit);
+		count++;
+	}
+	oscap_htable_iterator_free(hit);
+	struct xccdf_report_oval *oval_reports = calloc(count + 1, sizeof(struct xccdf_report_oval));
+	count = 0;
+	hit = oscap_htable_iterator_new(report_mapping);
+	while (oscap_htable_iterator_has_more(hit)) {
+		const char *filename = NULL;
+		const char *report_id = NULL;
+		oscap_htable_iterator_next_kv(hit, &filename, (void *) &report_id);
+		struct oval_agent_session *agent = _xccdf_session_find_oval_agent(session, filename);
+		if (agent == NULL)
+			continue;
+		oval_reports[count].report_id = report_id;
+		oval_reports[count].results = oval_agent_get_results_model(agent);
+		count++;
+	}
+	oscap_htable_iterator_free(hit);
+
+	/* The report shows the TestResult as it is exported, that is the copy
+	 * attached to the benchmark for the ARF (the last TestResult of the
+	 * benchmark) or a copy attached just for the time of the report. */
+	struct xccdf_benchmark *benchmark = xccdf_policy_model_get_benchmark(session->xccdf.policy_model);
+	struct xccdf_result *result = NULL;
+	if (session->xccdf.result_source != NULL) {
+		struct xccdf_result_iterator *rit = xccdf_benchmark_get_results(benchmark);
+		while (xccdf_result_iterator_has_more(rit))
+			result = xccdf_result_iterator_next(rit);
+		xccdf_result_iterator_free(rit);
+	}
+	const bool attached = result == NULL;
+	if (attached) {
+		result = xccdf_result_clone(session->xccdf.result);
+		xccdf_benchmark_add_result(benchmark, result);
+	}
+	const char *benchmark_uri = xccdf_session_is_sds(session) ?
+		ds_sds_session_get_checklist_uri(xccdf_session_get_ds_sds_session(session)) :
+		xccdf_result_get_benchmark_uri(result);
+	int ret = xccdf_result_export_html_report(result, benchmark, benchmark_uri,
+		oval_reports, count, session->export.check_engine_plugins_results ? "%.result.xml" : NULL,
+		session->export.report_file);
+	if (attached)
+		xccdf_benchmark_remove_result(benchmark, result);
+
+	free(oval_reports);
+	if (report_mapping != session->oval.arf_report_mapping)
+		oscap_htable_free(report_mapping, (oscap_destruct_func) free);
+	return ret == 0 ? 0 : 1;
+}
+
 static int _build_xccdf_result_source(struct xccdf_session *session)
 {
 	if (session->xccdf.result_source != NULL) {
@@ -1440,30 +1558,35 @@ static int _build_xccdf_result_source(struct xccdf_session *session)
 			return 1;
 		}
 
-		if (session->export.xccdf_file != NULL) {
-			struct xccdf_benchmark *cloned_benchmark = xccdf_benchmark_clone(benchmark);
+		if (!session->xccdf.result_files_exported && session->export.xccdf_file != NULL) {
+			// The result is attached to the benchmark just for the time of
+			// the export, the file is written as the DOM is being built.
 			struct xccdf_result *cloned_result = xccdf_result_clone(session->xccdf.result);
-			xccdf_benchmark_add_result(cloned_benchmark, cloned_result);
-			struct oscap_source *xccdf_result_source = xccdf_benchmark_export_source(cloned_benchmark, session->export.xccdf_file);
-			// cloned_result is freed during xccdf_benchmark_free
-			xccdf_benchmark_free(cloned_benchmark);
-			// Export XCCDF result file only when explicitly requested
-			if (oscap_source_save_as(xccdf_result_source, NULL) != 0) {
-				oscap_seterr(OSCAP_EFAMILY_OSCAP, "Could not save file: %s",
-						oscap_source_readable_origin(xccdf_result_source));
-				oscap_source_free(xccdf_result_source);
+			xccdf_benchmark_add_result(benchmark, cloned_result);
+			int ret = xccdf_benchmark_export(benchmark, session->export.xccdf_file);
+			xccdf_benchmark_remove_result(benchmark, cloned_result);
+			if (ret != 0) {
+				oscap_seterr(OSCAP_EFAMILY_OSCAP, "Could not save file: %s", session->export.xccdf_file);
 				return -1;
 			}
-			oscap_source_free(xccdf_result_source);
+			/* validate XCCDF Results */
+			if (session->validate && session->full_validation) {
+				struct oscap_source *xccdf_result_source = oscap_source_new_from_file(session->export.xccdf_file);
+				ret = oscap_source_validate(xccdf_result_source, _reporter, NULL);
+				oscap_source_free(xccdf_result_source);
+				if (ret != 0) {
+					oscap_seterr(OSCAP_EFAMILY_OSCAP, "Could not export XCCDF Results correctly to %s",
+						session->export.xccdf_file);
+					return 1;
+				}
+			}
 		}
 
-		if (session->export.xccdf_stig_viewer_file != NULL) {
-			struct xccdf_benchmark *cloned_benchmark = xccdf_benchmark_clone(benchmark);
+		if (!session->xccdf.result_files_exported && session->export.xccdf_stig_viewer_file != NULL) {
 			struct xccdf_result *cloned_result = xccdf_result_clone(session->xccdf.result);
-			xccdf_benchmark_add_result(cloned_benchmark, cloned_result);
+			xccdf_benchmark_add_result(benchmark, cloned_result);
 			struct oscap_source * stig_result = xccdf_result_stig_viewer_export_source(cloned_result, session->export.xccdf_stig_viewer_file);
-			// cloned_result is freed during xccdf_benchmark_free
-			xccdf_benchmark_free(cloned_benchmark);
+			xccdf_benchmark_remove_result(benchmark, cloned_result);
 			if (oscap_source_save_as(stig_result, NULL) != 0) {
 				oscap_seterr(OSCAP_EFAMILY_OSCAP, "Could not save file: %s",
 						oscap_source_readable_origin(stig_result));
@@ -1472,6 +1595,12 @@ static int _build_xccdf_result_source(struct xccdf_session *session)
 			}
 			oscap_source_free(stig_result);
 		}
+		session->xccdf.result_files_exported = true;
+
+		/* The DOM is needed only to build the ARF */
+		if (session->export.arf_file == NULL && (session->export.report_file == NULL || _xccdf_session_native_report(session))) {
+			return 0;
+		}
 
 		struct xccdf_result *cloned_result = xccdf_result_clone(session->xccdf.result);
 		if (xccdf_session_is_sds(session)) {
@@ -1502,6 +1631,9 @@ int xccdf_session_export_xccdf(struct xccdf_session *session)
 	if (session->export.report_file == NULL)
 		return 0;
 
+	if (_xccdf_session_native_report(session))
+		return _xccdf_session_gen_native_report(session);
+
 	struct oscap_source* arf = xccdf_session_create_arf_source(session);
 	if (arf == NULL) {
 		return 1;
@@ -1628,7 +1760,11 @@ static char *_xccdf_session_export_oval_result_file(struct xccdf_session *sessio
 		return NULL;
 	}
 
-	struct oscap_source *source = oval_results_model_export_source(res_model, NULL, name);
+	// Write the file as it is being built, the ARF copies it from the
+	// file and it's parsed back only when its DOM is requested later.
+	struct oscap_source *source = NULL;
+	if (oval_results_model_export(res_model, NULL, name) == 0)
+		source = oscap_source_new_from_file(name);
 	if (source == NULL) {
 		free(name);
 		return NULL;
@@ -1712,6 +1848,10 @@ int xccdf_session_export_oval(struct xccdf_session *session)
 	struct oscap_htable_iterator *hit = oscap_htable_iterator_new(session->oval.result_sources);
 	while (oscap_htable_iterator_has_more(hit)) {
 		struct oscap_source *source = oscap_htable_iterator_next_value(hit);
+		if (oscap_source_is_unparsed_file(source)) {
+			// already written by _xccdf_session_export_oval_result_file()
+			continue;
+		}
 		if (oscap_source_save_as(source, NULL) != 0) {
 			oscap_seterr(OSCAP_EFAMILY_OSCAP, "Could not save file: %s", oscap_source_readable_origin(source));
 			oscap_htable_iterator_free(hit);
@@ -1969,6 +2109,29 @@ int xccdf_session_generate_guide(struct xccdf_session *session, const char *outf
 	return 0;
 }
 
+/* Generate the report from the ARF, save the ARF if it's not saved yet and
+ * validate it. */
+static int _xccdf_session_export_arf_source(struct xccdf_session *session, struct oscap_source *arf_source, const char *arf_file, bool report)
+{
+	if (report) {
+		_xccdf_gen_report(arf_source,
+				xccdf_result_get_id(session->xccdf.result),
+				session->export.report_file,
+				"",
+				(session->export.check_engine_plugins_results ? "%.result.xml" : ""),
+				session->xccdf.profile_id == NULL ? "" : session->xccdf.profile_id
+		);
+	}
+
+	if (arf_file != NULL && oscap_source_save_as(arf_source, arf_file) != 0)
+		return 1;
+	if (session->full_validation && session->export.arf_file != NULL) {
+		if (oscap_source_validate(arf_source, _reporter, NULL) != 0)
+			return 1;
+	}
+	return 0;
+}
+
 int xccdf_session_export_all(struct xccdf_session *session)
 {
 	int ret = 0;
@@ -1983,35 +2146,46 @@ int xccdf_session_export_all(struct xccdf_session *session)
 		goto cleanup;
 	}
 
-	arf_source = xccdf_session_extract_arf_source(session);
-	if (arf_source == NULL) {
-		ret = 1;
-		goto cleanup;
-	}
-
-	if (session->export.report_file != NULL) {
-		/* generate report */
-		_xccdf_gen_report(arf_source,
-				xccdf_result_get_id(session->xccdf.result),
-				session->export.report_file,
-				"",
-				(session->export.check_engine_plugins_results ? "%.result.xml" : ""),
-				session->xccdf.profile_id == NULL ? "" : session->xccdf.profile_id
-		);
-	}
-
-	if (session->export.arf_file != NULL) {
-		if (oscap_source_save_as(arf_source, NULL) != 0) {
+	/* The native report doesn't need the ARF, it's generated before the
+	 * ARF consumes the source datastream */
+	const bool native_report = session->export.report_file != NULL && _xccdf_session_native_report(session);
+	if (native_report) {
+		if (_xccdf_session_gen_native_report(session) != 0) {
 			ret = 1;
 			goto cleanup;
 		}
-		if (session->full_validation) {
-			if (oscap_source_validate(arf_source, _reporter, NULL) != 0) {
+		if (session->export.arf_file == NULL)
+			goto cleanup;
+	}
+
+	const char *arf_file = session->export.arf_file;
+	const bool xslt_report = session->export.report_file != NULL && !native_report;
+	if (arf_file == NULL || strcmp(arf_file, "-") == 0) {
+		if (xslt_report || (arf_file != NULL && session->full_validation)) {
+			/* The report and the validation need the whole ARF document
+			 * and there is no file to read it back from, so the ARF is
+			 * built in memory. It's as large as the parsed file would be. */
+			struct oscap_source *arf_report = xccdf_session_create_arf_source(session);
+			if (arf_report == NULL) {
 				ret = 1;
 				goto cleanup;
 			}
+			ret = _xccdf_session_export_arf_source(session, arf_report, arf_file, xslt_report);
+		} else {
+			/* The ARF goes to the standard output as it is being built */
+			ret = xccdf_session_write_arf(session, arf_file) != 0;
 		}
+		goto cleanup;
+	}
+
+	/* The ARF is written to the file as it is being built, the report
+	 * and the validation read it back from the file then. */
+	if (xccdf_session_write_arf(session, arf_file) != 0) {
+		ret = 1;
+		goto cleanup;
 	}
+	arf_source = oscap_source_new_from_file(arf_file);
+	ret = _xccdf_session_export_arf_source(session, arf_source, NULL, xslt_report);
 
 cleanup:
 	oscap_source_free(arf_source);
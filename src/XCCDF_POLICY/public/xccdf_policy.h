@@ -72,6 +72,8 @@ struct xccdf_policy_iterator;
 typedef enum {
 	POLICY_ENGINE_QUERY_NAMES_FOR_HREF = 1,		/// Considering xccdf:check-content-ref, what are possible @name attributes for given href?
 	POLICY_ENGINE_QUERY_OVAL_DEFS_FOR_HREF = 2,	/// Considering xccdf:check-content-ref, what are OVAL definitions for given href?
+	POLICY_ENGINE_QUERY_CONCURRENT_EVAL = 3,	/// Can the engine evaluate more checks concurrently from different threads?
+	POLICY_ENGINE_QUERY_PREFETCH = 4,		/// Collect the data for the checks of query_data (struct xccdf_check_iterator) ahead of their evaluation, nothing is returned
 } xccdf_policy_engine_query_t;
 
 /**
@@ -84,10 +86,12 @@ typedef enum {
  * dependent on query and defined as follows:
  *  - (const char *)href -- for POLICY_ENGINE_QUERY_NAMES_FOR_HREF
  *  - (const char *)href -- for POLICY_ENGINE_QUERY_OVAL_DEFS_FOR_HREF
+ *  - NULL -- for POLICY_ENGINE_QUERY_CONCURRENT_EVAL
  *
  * Expected return type depends also on query as follows:
  *  - (struct oscap_stringlist *) -- for POLICY_ENGINE_QUERY_NAMES_FOR_HREF
  *  - (struct oscap_list *) -- for POLICY_ENGINE_QUERY_OVAL_DEFS_FOR_HREF
+ *  - any non-NULL pointer if the engine can -- for POLICY_ENGINE_QUERY_CONCURRENT_EVAL
  *  - NULL shall be returned if the function doesn't understand the query.
  */
 typedef void *(*xccdf_policy_engine_query_fn) (void *, xccdf_policy_engine_query_t, void *);
@@ -30,6 +30,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <pthread.h>
 
 #include "xccdf_policy_priv.h"
 #include "xccdf_policy_model_priv.h"
@@ -840,127 +841,126 @@ static bool _xccdf_policy_cpe_dict_cb(struct cpe_name* name, void* usr)
 	return ret;
 }
 
-static bool xccdf_policy_model_platforms_are_applicable_dict(struct xccdf_policy_model *model, struct cpe_dict_model *dict, struct oscap_string_iterator *platforms)
+static bool xccdf_policy_model_platform_is_applicable_dict(struct xccdf_policy_model *model, struct cpe_dict_model *dict, const char *platform)
 {
-	// at this point we know that the item has 1 or more platforms specified
-	bool ret = false;
-
-	while (oscap_string_iterator_has_more(platforms))
-	{
-		const char* platform = oscap_string_iterator_next(platforms);
-		// Platform could be a reference to CPE2 platform, skip the ones
-		// that aren't valid CPE names.
-		if (!cpe_name_check(platform))
-			continue;
-
-		struct cpe_name* name = cpe_name_new(platform);
-
-		struct cpe_check_cb_usr* usr = malloc(sizeof(struct cpe_check_cb_usr));
-		usr->model = model;
-		usr->dict = dict;
-		usr->lang_model = NULL;
-		const bool applicable = cpe_name_applicable_dict(name, dict, (cpe_check_fn) _xccdf_policy_cpe_check_cb, usr);
-		free(usr);
+	// Platform could be a reference to CPE2 platform, skip the ones
+	// that aren't valid CPE names.
+	if (!cpe_name_check(platform))
+		return false;
 
-		cpe_name_free(name);
+	struct cpe_name* name = cpe_name_new(platform);
 
-		if (applicable)
-		{
-			ret = true;
+	struct cpe_check_cb_usr* usr = malloc(sizeof(struct cpe_check_cb_usr));
+	usr->model = model;
+	usr->dict = dict;
+	usr->lang_model = NULL;
+	const bool applicable = cpe_name_applicable_dict(name, dict, (cpe_check_fn) _xccdf_policy_cpe_check_cb, usr);
+	free(usr);
 
-			if (oscap_htable_get(model->cpe->applicable_platforms, platform) == NULL) {
-				oscap_htable_add(model->cpe->applicable_platforms, platform, 0);
-			}
-		}
-	}
-	oscap_string_iterator_reset(platforms);
-
-	return ret;
+	cpe_name_free(name);
+	return applicable;
 }
 
-static bool xccdf_policy_model_platforms_are_applicable_lang_model(struct xccdf_policy_model *model, struct cpe_lang_model *lang_model, struct oscap_string_iterator *platforms)
+static bool xccdf_policy_model_platform_is_applicable_lang_model(struct xccdf_policy_model *model, struct cpe_lang_model *lang_model, const char *platform)
 {
-	// at this point we know that the item has 1 or more platforms specified
-	bool ret = false;
+	// Specification says that platform should begin with "#" if it is
+	// a reference to a CPE2 platform. However content exists where this
+	// is not strictly followed so we support both with and without "#"
+	// references.
 
-	while (oscap_string_iterator_has_more(platforms))
+	const char* platform_shifted = platform;
+	if (strlen(platform_shifted) >= 1 && *platform_shifted == '#')
 	{
-		const char* platform = oscap_string_iterator_next(platforms);
-		// Specification says that platform should begin with "#" if it is
-		// a reference to a CPE2 platform. However content exists where this
-		// is not strictly followed so we support both with and without "#"
-		// references.
-
-		const char* platform_shifted = platform;
-		if (strlen(platform_shifted) >= 1 && *platform_shifted == '#')
-		{
-			// skip the "#" character
-			platform_shifted++;
-		}
-
-		struct cpe_check_cb_usr* usr = malloc(sizeof(struct cpe_check_cb_usr));
-		usr->model = model;
-		usr->dict = NULL;
-		usr->lang_model = lang_model;
-		const bool applicable = cpe_platform_applicable_lang_model(platform_shifted, lang_model, (cpe_check_fn)_xccdf_policy_cpe_check_cb, (cpe_dict_fn)_xccdf_policy_cpe_dict_cb, usr);
-		free(usr);
-
-		if (applicable)
-		{
-			ret = true;
-
-			if (oscap_htable_get(model->cpe->applicable_platforms, platform) == NULL) {
-				oscap_htable_add(model->cpe->applicable_platforms, platform, 0);
-			}
-		}
+		// skip the "#" character
+		platform_shifted++;
 	}
-	oscap_string_iterator_reset(platforms);
 
-	return ret;
+	struct cpe_check_cb_usr* usr = malloc(sizeof(struct cpe_check_cb_usr));
+	usr->model = model;
+	usr->dict = NULL;
+	usr->lang_model = lang_model;
+	const bool applicable = cpe_platform_applicable_lang_model(platform_shifted, lang_model, (cpe_check_fn)_xccdf_policy_cpe_check_cb, (cpe_dict_fn)_xccdf_policy_cpe_dict_cb, usr);
+	free(usr);
+	return applicable;
 }
 
-bool xccdf_policy_model_platforms_are_applicable(struct xccdf_policy_model *model, struct oscap_string_iterator *platforms)
+/* Values of xccdf_policy_model->platform_applicability */
+static char _platform_applicable;
+static char _platform_not_applicable;
+
+static bool xccdf_policy_model_platform_is_applicable(struct xccdf_policy_model *model, const char *platform)
 {
-	// we have to check whether the item has any platforms at all, if it has none
-	// it should be applicable to all platforms
-	if (!oscap_string_iterator_has_more(platforms))
-		return true;
+	void *cached = oscap_htable_get(model->platform_applicability, platform);
+	if (cached != NULL)
+		return cached == &_platform_applicable;
 
 	bool ret = false;
-	// We do not check whether the platform entries are valid platform refs
-	// or CPE names. We let the policy_model methods do that instead.
+	// We do not check whether the platform entry is a valid platform ref
+	// or CPE name. We let the policy_model methods do that instead.
 	// Therefore we check all 4 (!) places where a platform may match.
 	// CPE2 takes precedence over CPE1 in this implementation. This is not
 	// dictated by the specification, it's an arbitrary choice.
 	struct xccdf_benchmark* benchmark = xccdf_policy_model_get_benchmark(model);
 	struct cpe_lang_model *embedded_lang_model = xccdf_benchmark_get_cpe_lang_model(benchmark);
 	if (embedded_lang_model != NULL) {
-		if (xccdf_policy_model_platforms_are_applicable_lang_model(model, embedded_lang_model, platforms))
+		if (xccdf_policy_model_platform_is_applicable_lang_model(model, embedded_lang_model, platform))
 			ret = true;
 	}
 
 	struct oscap_iterator *lang_models = oscap_iterator_new(model->cpe->lang_models);
 	while (oscap_iterator_has_more(lang_models)) {
 		struct cpe_lang_model *lang_model = (struct cpe_lang_model *) oscap_iterator_next(lang_models);
-		if (xccdf_policy_model_platforms_are_applicable_lang_model(model, lang_model, platforms))
+		if (xccdf_policy_model_platform_is_applicable_lang_model(model, lang_model, platform))
 			ret = true;
 	}
 	oscap_iterator_free(lang_models);
 
 	struct cpe_dict_model *embedded_dict = xccdf_benchmark_get_cpe_list(benchmark);
 	if (embedded_dict != NULL) {
-		if (xccdf_policy_model_platforms_are_applicable_dict(model, embedded_dict, platforms))
+		if (xccdf_policy_model_platform_is_applicable_dict(model, embedded_dict, platform))
 			ret = true;
 	}
 
 	struct oscap_iterator *dicts = oscap_iterator_new(model->cpe->dicts);
 	while (oscap_iterator_has_more(dicts)) {
 		struct cpe_dict_model *dict = (struct cpe_dict_model *) oscap_iterator_next(dicts);
-		if (xccdf_policy_model_platforms_are_applicable_dict(model, dict, platforms))
+		if (xccdf_policy_model_platform_is_applicable_dict(model, dict, platform))
 			ret = true;
 	}
 	oscap_iterator_free(dicts);
 
+	if (ret && oscap_htable_get(model->cpe->applicable_platforms, platform) == NULL) {
+		oscap_htable_add(model->cpe->applicable_platforms, platform, 0);
+	}
+	oscap_htable_add(model->platform_applicability, platform, ret ? &_platform_applicable : &_platform_not_applicable);
+	return ret;
+}
+
+/* Forget the applicability of platforms when the CPE dictionaries or
+ * lang models of the model change. */
+static void xccdf_policy_model_reset_platform_applicability(struct xccdf_policy_model *model)
+{
+	oscap_htable_free0(model->platform_applicability);
+	model->platform_applicability = oscap_htable_new();
+}
+
+bool xccdf_policy_model_platforms_are_applicable(struct xccdf_policy_model *model, struct oscap_string_iterator *platforms)
+{
+	// we have to check whether the item has any platforms at all, if it has none
+	// it should be applicable to all platforms
+	if (!oscap_string_iterator_has_more(platforms))
+		return true;
+
+	// The applicability of each platform is evaluated once per model,
+	// all platforms are checked to record every applicable one.
+	bool ret = false;
+	while (oscap_string_iterator_has_more(platforms)) {
+		const char *platform = oscap_string_iterator_next(platforms);
+		if (xccdf_policy_model_platform_is_applicable(model, platform))
+			ret = true;
+	}
+	oscap_string_iterator_reset(platforms);
+
 	return ret;
 }
 
@@ -1032,76 +1032,196 @@ static void _warn_about_required_rules(const struct xccdf_policy *policy, const
 }
 
 /**
- * Evaluate given check which is immediate child of the rule.
- * A possibe child checks will be evaluated by xccdf_policy_check_evaluate.
- * This duplication is needed to handle @multi-check correctly,
- * which is (in general) not predictable in any way.
+ * Rule-result of an evaluated rule waiting to be reported, a multi-check
+ * rule yields one for each OVAL definition.
  */
-static inline int
-_xccdf_policy_rule_evaluate(struct xccdf_policy * policy, const struct xccdf_rule *rule, struct xccdf_result *result, bool parent_selected)
-{
-	const char* rule_id = xccdf_rule_get_id(rule);
-	const bool is_selected = xccdf_policy_is_item_selected(policy, rule_id);
-	const char *message = NULL;
-	int report = 0;
+struct xccdf_policy_outcome {
+	struct oval_definition *definition;	///< OVAL definition of the multi-check, NULL otherwise
+	struct xccdf_check *check;
+	int result;
+	const char *message;
+};
 
-	/* If the rule is requested to be skipped by the user using --skip-rule on
-	 * the command line we will skip the evaluation of this rule. */
-	if (oscap_htable_get(policy->skip_rules, rule_id) != NULL) {
-		return _xccdf_policy_report_rule_result(policy, result, rule, NULL, XCCDF_RESULT_NOT_SELECTED, NULL);
-	}
+/**
+ * Evaluation of a single rule. The evaluation and the reporting of the rule
+ * are done at once unless the job is deferred. The callbacks and rule-results
+ * of a deferred job are kept in the job until they are reported in the order
+ * of the rules, after the job has been evaluated by a worker of the pool.
+ */
+struct xccdf_policy_job {
+	struct xccdf_policy *policy;
+	struct xccdf_result *result;
+	const struct xccdf_rule *rule;
+	xccdf_role_t role;
+	struct xccdf_check *check;		///< check to be evaluated, NULL if the job is done
+	struct oscap_list *bindings;		///< value bindings of the check
+	bool deferred;				///< is the reporting deferred?
+	bool started;				///< shall the start of the rule be reported?
+	bool exclusive;				///< is any of the engines unable to evaluate concurrently?
+	bool done;				///< has the check been evaluated?
+	int reported;				///< number of rule-results reported
+	struct oscap_list *outcomes;		///< deferred rule-results
+	struct err_queue *errors;		///< errors set by the evaluation in a worker
+};
 
-	/* If user wants to evaluate only specific rules and the rule currently
-	 * being evaluated is not among these rules, do not evaluate it and mark it
-	 * as notselected. */
-	if (_user_specified_rule_mode(policy) > 0) {
-		if (oscap_htable_get(policy->rules, rule_id) == NULL) {
-			return _xccdf_policy_report_rule_result(policy, result, rule, NULL, XCCDF_RESULT_NOT_SELECTED, NULL);
-		}
-		oscap_htable_add(policy->rules_found, rule_id, (void *)true);
-		_xccdf_policy_modify_selected_final(policy, rule_id, true);
-		_warn_about_required_rules(policy, rule);
+/* Number of the following exclusive jobs whose checks are prefetched at once */
+#define XCCDF_POLICY_PREFETCH_JOBS 64
 
-	} else {
-		/* solve selects only when in --rule mode */
-		if (!is_selected || !parent_selected)
-			return _xccdf_policy_report_rule_result(policy, result, rule, NULL, XCCDF_RESULT_NOT_SELECTED, NULL);
+/**
+ * Pool of workers evaluating the deferred jobs. The jobs of engines which
+ * can't evaluate concurrently (e.g. OVAL) are evaluated one at a time in the
+ * order of the rules, the other jobs are evaluated by any free worker. Before
+ * the exclusive jobs are evaluated, the engines collect the data for the
+ * checks of the following exclusive jobs at once (e.g. the OVAL probes collect
+ * the objects of independent definitions concurrently).
+ */
+struct xccdf_policy_pool {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;			///< signalled whenever a job is done
+	struct xccdf_policy_job **jobs;		///< all jobs in the order of the rules
+	size_t count;
+	size_t capacity;
+	size_t next_exclusive;			///< first exclusive job which might not be taken yet
+	size_t next_concurrent;			///< first concurrent job which might not be taken yet
+	bool exclusive_busy;			///< is an exclusive job being evaluated?
+	size_t prefetched;			///< the checks of the jobs before this one have been prefetched
+	bool cancelled;				///< stop taking the jobs
+	unsigned int workers;
+};
 
-		// See section 7.2.3.3.2 (<xccdf:requires> and <xccdf:conflicts> Elements) of the XCCDF specification.
-		if (_xccdf_policy_item_is_in_conflict(policy, XITEM(rule)) || !_xccdf_policy_item_has_all_requirements(policy, XITEM(rule))) {
-			xccdf_policy_resolve_item(policy, XITEM(rule), false);
-			return _xccdf_policy_report_rule_result(policy, result, rule, NULL, XCCDF_RESULT_NOT_SELECTED, NULL);
-		}
+static int _xccdf_policy_job_start(struct xccdf_policy_job *job)
+{
+	if (job->deferred) {
+		job->started = true;
+		return 0;
 	}
+	return xccdf_policy_report_cb(job->policy, XCCDF_POLICY_OUTCB_START, (void *) job->rule);
+}
 
-	/* Otherwise start reporting */
-	report = xccdf_policy_report_cb(policy, XCCDF_POLICY_OUTCB_START, (void *) rule);
-	if (report)
-		return report;
+static int _xccdf_policy_report_multicheck(struct xccdf_policy_job *job, struct oval_definition *definition)
+{
+	int report = 0;
+	/* The start of the rule is reported again for each of the definitions */
+	if (job->reported > 0)
+		report = xccdf_policy_report_cb(job->policy, XCCDF_POLICY_OUTCB_START, (void *) job->rule);
+	if (report == 0)
+		report = xccdf_policy_report_cb(job->policy, XCCDF_POLICY_OUTCB_MULTICHECK, (void *) definition);
+	return report;
+}
 
-	struct xccdf_refine_rule_internal* r_rule = oscap_htable_get(policy->refine_rules_internal, rule_id);
-	xccdf_role_t role = xccdf_get_final_role(rule, r_rule);
+static int _xccdf_policy_report_outcome(struct xccdf_policy_job *job, struct xccdf_check *check, int res, const char *message)
+{
+	job->reported++;
+	if (res == -1) {
+		xccdf_check_free(check);
+		return res;
+	}
+	return _xccdf_policy_report_rule_result(job->policy, job->result, job->rule, check, res, message);
+}
 
-	dI("Evaluating XCCDF rule '%s'.", rule_id);
+static int _xccdf_policy_job_multicheck(struct xccdf_policy_job *job, struct oval_definition *definition)
+{
+	if (job->deferred)
+		return 0;
+	return _xccdf_policy_report_multicheck(job, definition);
+}
+
+static int _xccdf_policy_job_outcome(struct xccdf_policy_job *job, struct oval_definition *definition,
+				     struct xccdf_check *check, int res, const char *message)
+{
+	if (!job->deferred)
+		return _xccdf_policy_report_outcome(job, check, res, message);
 
-	if (role == XCCDF_ROLE_UNCHECKED)
-		return _xccdf_policy_report_rule_result(policy, result, rule, NULL, XCCDF_RESULT_NOT_CHECKED, NULL);
+	struct xccdf_policy_outcome *outcome = malloc(sizeof(struct xccdf_policy_outcome));
+	outcome->definition = definition;
+	outcome->check = check;
+	outcome->result = res;
+	outcome->message = message;
+	oscap_list_add(job->outcomes, outcome);
+	return res == -1 ? res : 0;
+}
 
-	const bool is_applicable = xccdf_policy_model_item_is_applicable(policy->model, (struct xccdf_item*)rule);
-	if (!is_applicable) {
-		dI("Rule '%s' is not applicable.", rule_id);
-		return _xccdf_policy_report_rule_result(policy, result, rule, NULL, XCCDF_RESULT_NOT_APPLICABLE, NULL);
+static void _xccdf_policy_outcome_free(struct xccdf_policy_outcome *outcome)
+{
+	if (outcome != NULL) {
+		xccdf_check_free(outcome->check);
+		free(outcome);
 	}
+}
 
-	const struct xccdf_check *orig_check = _xccdf_policy_rule_get_applicable_check(policy, (struct xccdf_item *) rule);
-	if (orig_check == NULL)
-		// No candidate or applicable check found.
-		return _xccdf_policy_report_rule_result(policy, result, rule, NULL, XCCDF_RESULT_NOT_CHECKED, "No candidate or applicable check found.");
+/**
+ * Report the deferred callbacks and rule-results of a job which is done.
+ */
+static int _xccdf_policy_job_report(struct xccdf_policy_job *job)
+{
+	int report = 0;
+	oscap_err_restore(job->errors);
+	job->errors = NULL;
+	if (job->started)
+		report = xccdf_policy_report_cb(job->policy, XCCDF_POLICY_OUTCB_START, (void *) job->rule);
+
+	struct oscap_iterator *it = oscap_iterator_new(job->outcomes);
+	while (report == 0 && oscap_iterator_has_more(it)) {
+		struct xccdf_policy_outcome *outcome = oscap_iterator_next(it);
+		if (outcome->definition != NULL)
+			report = _xccdf_policy_report_multicheck(job, outcome->definition);
+		if (report == 0)
+			report = _xccdf_policy_report_outcome(job, outcome->check, outcome->result, outcome->message);
+		else
+			xccdf_check_free(outcome->check);
+		/* the check is owned by the rule-result now */
+		outcome->check = NULL;
+	}
+	oscap_iterator_free(it);
+	return report;
+}
 
-	// we need to clone the check to avoid changing the original content
-	struct xccdf_check *check = xccdf_check_clone(orig_check);
+static void _xccdf_policy_job_free(struct xccdf_policy_job *job)
+{
+	if (job == NULL)
+		return;
+	xccdf_check_free(job->check);
+	oscap_list_free(job->bindings, (oscap_destruct_func) xccdf_value_binding_free);
+	oscap_list_free(job->outcomes, (oscap_destruct_func) _xccdf_policy_outcome_free);
+	/* the errors of a job which hasn't been reported are not lost */
+	oscap_err_restore(job->errors);
+	free(job);
+}
+
+static bool _xccdf_policy_check_is_exclusive(struct xccdf_policy *policy, struct xccdf_check *check)
+{
+	bool exclusive = false;
+	if (xccdf_check_get_complex(check)) {
+		struct xccdf_check_iterator *child_it = xccdf_check_get_children(check);
+		while (!exclusive && xccdf_check_iterator_has_more(child_it))
+			exclusive = _xccdf_policy_check_is_exclusive(policy, xccdf_check_iterator_next(child_it));
+		xccdf_check_iterator_free(child_it);
+	} else {
+		struct oscap_iterator *cb_it = _xccdf_policy_get_engines_by_sysname(policy, xccdf_check_get_system(check));
+		while (!exclusive && oscap_iterator_has_more(cb_it))
+			exclusive = !xccdf_policy_engine_is_concurrent(oscap_iterator_next(cb_it));
+		oscap_iterator_free(cb_it);
+	}
+	return exclusive;
+}
+
+/**
+ * Evaluate given check which is immediate child of the rule.
+ * A possibe child checks will be evaluated by xccdf_policy_check_evaluate.
+ * This duplication is needed to handle @multi-check correctly,
+ * which is (in general) not predictable in any way.
+ */
+static int _xccdf_policy_job_evaluate(struct xccdf_policy_job *job)
+{
+	struct xccdf_policy *policy = job->policy;
+	struct xccdf_check *check = job->check;
+	const char *message = NULL;
+	int report = 0;
+
+	/* The check is passed to the rule-result */
+	job->check = NULL;
 	if (xccdf_check_get_complex(check))
-		return _xccdf_policy_report_rule_result(policy, result, rule, check, xccdf_policy_check_evaluate(policy, check), NULL);
+		return _xccdf_policy_job_outcome(job, NULL, check, xccdf_policy_check_evaluate(policy, check), NULL);
 
 	// Now we are evaluating single simple xccdf:check within xccdf:rule.
 	// Since the fact that a check will yield multi-check is not predictable in general
@@ -1110,10 +1230,8 @@ _xccdf_policy_rule_evaluate(struct xccdf_policy * policy, const struct xccdf_rul
 	//
 	// Important: if touching this code, please revisit also xccdf_policy_check_evaluate.
 	const char *system_name = xccdf_check_get_system(check);
-	struct oscap_list *bindings = xccdf_policy_check_get_value_bindings(policy, xccdf_check_get_exports(check));
-	if (bindings == NULL)
-		return _xccdf_policy_report_rule_result(policy, result, rule, check, XCCDF_RESULT_UNKNOWN, "Value bindings not found.");
-
+	struct oscap_list *bindings = job->bindings;
+	job->bindings = NULL;
 
 	struct xccdf_check_content_ref_iterator *content_it = xccdf_check_get_content_refs(check);
 	struct xccdf_check_content_ref *content;
@@ -1135,7 +1253,7 @@ _xccdf_policy_rule_evaluate(struct xccdf_policy * policy, const struct xccdf_rul
 				if (!oscap_iterator_has_more(oval_definition_iterator)) {
 					// Super special case when oval file contains no definitions
 					// thus multi-check shall yield zero rule-results.
-					report = _xccdf_policy_report_rule_result(policy, result, rule, check, XCCDF_RESULT_UNKNOWN, "No definitions found for @multi-check.");
+					report = _xccdf_policy_job_outcome(job, NULL, check, XCCDF_RESULT_UNKNOWN, "No definitions found for @multi-check.");
 					oscap_iterator_free(oval_definition_iterator);
 					oscap_list_free(oval_definition_list, NULL);
 					xccdf_check_content_ref_iterator_free(content_it);
@@ -1144,23 +1262,13 @@ _xccdf_policy_rule_evaluate(struct xccdf_policy * policy, const struct xccdf_rul
 				}
 				while (oscap_iterator_has_more(oval_definition_iterator)) {
 					struct oval_definition *oval_definition = oscap_iterator_next(oval_definition_iterator);
-					if ((report = xccdf_policy_report_cb(policy, XCCDF_POLICY_OUTCB_MULTICHECK, (void *) oval_definition)) != 0) {
+					if ((report = _xccdf_policy_job_multicheck(job, oval_definition)) != 0)
 						break;
-					}
 					struct xccdf_check *cloned_check = xccdf_check_clone(check);
 					xccdf_check_inject_content_ref(cloned_check, content, oval_definition_get_id(oval_definition));
 					int inner_ret = xccdf_policy_check_evaluate(policy, cloned_check);
-					if (inner_ret == -1) {
-						xccdf_check_free(cloned_check);
-						report = inner_ret;
+					if ((report = _xccdf_policy_job_outcome(job, oval_definition, cloned_check, inner_ret, NULL)) != 0)
 						break;
-					}
-					if ((report = _xccdf_policy_report_rule_result(policy, result, rule, cloned_check, inner_ret, NULL)) != 0)
-						break;
-					if (oscap_iterator_has_more(oval_definition_iterator)) {
-						if ((report = xccdf_policy_report_cb(policy, XCCDF_POLICY_OUTCB_START, (void *) rule)) != 0)
-							break;
-					}
 				}
 				oscap_iterator_free(oval_definition_iterator);
 				oscap_list_free(oval_definition_list, NULL);
@@ -1189,14 +1297,267 @@ _xccdf_policy_rule_evaluate(struct xccdf_policy * policy, const struct xccdf_rul
 	if ((xccdf_test_result_type_t) ret == XCCDF_RESULT_NOT_CHECKED)
 		message = "None of the check-content-ref elements was resolvable.";
 
-	if (role == XCCDF_ROLE_UNSCORED)
+	if (job->role == XCCDF_ROLE_UNSCORED)
 		ret = XCCDF_RESULT_INFORMATIONAL;
 
 	xccdf_check_content_ref_iterator_free(content_it);
 	oscap_list_free(bindings, (oscap_destruct_func) xccdf_value_binding_free);
 	/* Negate only once */
 	ret = _resolve_negate(ret, check);
-	return _xccdf_policy_report_rule_result(policy, result, rule, check, ret, message);
+	return _xccdf_policy_job_outcome(job, NULL, check, ret, message);
+}
+
+static struct xccdf_policy_job *_xccdf_policy_pool_add_job(struct xccdf_policy_pool *pool)
+{
+	if (pool->count == pool->capacity) {
+		pool->capacity = pool->capacity == 0 ? 64 : 2 * pool->capacity;
+		pool->jobs = realloc(pool->jobs, pool->capacity * sizeof(struct xccdf_policy_job *));
+	}
+	struct xccdf_policy_job *job = calloc(1, sizeof(struct xccdf_policy_job));
+	job->deferred = true;
+	job->done = true;
+	job->outcomes = oscap_list_new();
+	pool->jobs[pool->count++] = job;
+	return job;
+}
+
+static inline int
+_xccdf_policy_rule_evaluate(struct xccdf_policy * policy, const struct xccdf_rule *rule, struct xccdf_result *result, bool parent_selected)
+{
+	const char* rule_id = xccdf_rule_get_id(rule);
+	const bool is_selected = xccdf_policy_is_item_selected(policy, rule_id);
+	int report = 0;
+
+	/* The rule is evaluated right away unless the jobs are evaluated by the pool */
+	struct xccdf_policy_job serial_job = { .deferred = false };
+	struct xccdf_policy_job *job = policy->pool != NULL ? _xccdf_policy_pool_add_job(policy->pool) : &serial_job;
+	job->policy = policy;
+	job->result = result;
+	job->rule = rule;
+
+	/* If the rule is requested to be skipped by the user using --skip-rule on
+	 * the command line we will skip the evaluation of this rule. */
+	if (oscap_htable_get(policy->skip_rules, rule_id) != NULL) {
+		return _xccdf_policy_job_outcome(job, NULL, NULL, XCCDF_RESULT_NOT_SELECTED, NULL);
+	}
+
+	/* If user wants to evaluate only specific rules and the rule currently
+	 * being evaluated is not among these rules, do not evaluate it and mark it
+	 * as notselected. */
+	if (_user_specified_rule_mode(policy) > 0) {
+		if (oscap_htable_get(policy->rules, rule_id) == NULL) {
+			return _xccdf_policy_job_outcome(job, NULL, NULL, XCCDF_RESULT_NOT_SELECTED, NULL);
+		}
+		oscap_htable_add(policy->rules_found, rule_id, (void *)true);
+		_xccdf_policy_modify_selected_final(policy, rule_id, true);
+		_warn_about_required_rules(policy, rule);
+
+	} else {
+		/* solve selects only when in --rule mode */
+		if (!is_selected || !parent_selected)
+			return _xccdf_policy_job_outcome(job, NULL, NULL, XCCDF_RESULT_NOT_SELECTED, NULL);
+
+		// See section 7.2.3.3.2 (<xccdf:requires> and <xccdf:conflicts> Elements) of the XCCDF specification.
+		if (_xccdf_policy_item_is_in_conflict(policy, XITEM(rule)) || !_xccdf_policy_item_has_all_requirements(policy, XITEM(rule))) {
+			xccdf_policy_resolve_item(policy, XITEM(rule), false);
+			return _xccdf_policy_job_outcome(job, NULL, NULL, XCCDF_RESULT_NOT_SELECTED, NULL);
+		}
+	}
+
+	/* Otherwise start reporting */
+	report = _xccdf_policy_job_start(job);
+	if (report)
+		return report;
+
+	struct xccdf_refine_rule_internal* r_rule = oscap_htable_get(policy->refine_rules_internal, rule_id);
+	job->role = xccdf_get_final_role(rule, r_rule);
+
+	dI("Evaluating XCCDF rule '%s'.", rule_id);
+
+	if (job->role == XCCDF_ROLE_UNCHECKED)
+		return _xccdf_policy_job_outcome(job, NULL, NULL, XCCDF_RESULT_NOT_CHECKED, NULL);
+
+	const bool is_applicable = xccdf_policy_model_item_is_applicable(policy->model, (struct xccdf_item*)rule);
+	if (!is_applicable) {
+		dI("Rule '%s' is not applicable.", rule_id);
+		return _xccdf_policy_job_outcome(job, NULL, NULL, XCCDF_RESULT_NOT_APPLICABLE, NULL);
+	}
+
+	const struct xccdf_check *orig_check = _xccdf_policy_rule_get_applicable_check(policy, (struct xccdf_item *) rule);
+	if (orig_check == NULL)
+		// No candidate or applicable check found.
+		return _xccdf_policy_job_outcome(job, NULL, NULL, XCCDF_RESULT_NOT_CHECKED, "No candidate or applicable check found.");
+
+	// we need to clone the check to avoid changing the original content
+	struct xccdf_check *check = xccdf_check_clone(orig_check);
+	if (!xccdf_check_get_complex(check)) {
+		job->bindings = xccdf_policy_check_get_value_bindings(policy, xccdf_check_get_exports(check));
+		if (job->bindings == NULL)
+			return _xccdf_policy_job_outcome(job, NULL, check, XCCDF_RESULT_UNKNOWN, "Value bindings not found.");
+	}
+	job->check = check;
+	if (!job->deferred)
+		return _xccdf_policy_job_evaluate(job);
+
+	job->exclusive = _xccdf_policy_check_is_exclusive(policy, check);
+	job->done = false;
+	return 0;
+}
+
+static void _xccdf_policy_add_simple_checks(struct oscap_list *checks, struct xccdf_check *check)
+{
+	if (!xccdf_check_get_complex(check)) {
+		oscap_list_add(checks, check);
+		return;
+	}
+	struct xccdf_check_iterator *child_it = xccdf_check_get_children(check);
+	while (xccdf_check_iterator_has_more(child_it))
+		_xccdf_policy_add_simple_checks(checks, xccdf_check_iterator_next(child_it));
+	xccdf_check_iterator_free(child_it);
+}
+
+/*
+ * Returns the checks of the exclusive jobs from the given one on, which are to
+ * be prefetched. Called with the pool locked.
+ */
+static struct oscap_list *_xccdf_policy_pool_prefetch_checks(struct xccdf_policy_pool *pool, size_t first)
+{
+	struct oscap_list *checks = oscap_list_new();
+	size_t i = first, jobs = 0;
+	for (; i < pool->count && jobs < XCCDF_POLICY_PREFETCH_JOBS; i++) {
+		struct xccdf_policy_job *job = pool->jobs[i];
+		if (job->done || !job->exclusive)
+			continue;
+		_xccdf_policy_add_simple_checks(checks, job->check);
+		jobs++;
+	}
+	pool->prefetched = i;
+	return checks;
+}
+
+static void _xccdf_policy_prefetch(struct xccdf_policy *policy, struct oscap_list *checks)
+{
+	struct oscap_iterator *engine_it = oscap_iterator_new(policy->model->engines);
+	while (oscap_iterator_has_more(engine_it))
+		xccdf_policy_engine_prefetch(oscap_iterator_next(engine_it), checks);
+	oscap_iterator_free(engine_it);
+}
+
+static void *_xccdf_policy_pool_worker(void *arg)
+{
+	struct xccdf_policy_pool *pool = arg;
+
+	pthread_mutex_lock(&pool->lock);
+	while (!pool->cancelled) {
+		struct xccdf_policy_job *job = NULL;
+		struct oscap_list *prefetch = NULL;
+		if (!pool->exclusive_busy) {
+			while (pool->next_exclusive < pool->count &&
+			       (pool->jobs[pool->next_exclusive]->done || !pool->jobs[pool->next_exclusive]->exclusive))
+				pool->next_exclusive++;
+			if (pool->next_exclusive < pool->count) {
+				job = pool->jobs[pool->next_exclusive++];
+				pool->exclusive_busy = true;
+				if (pool->next_exclusive > pool->prefetched)
+					prefetch = _xccdf_policy_pool_prefetch_checks(pool, pool->next_exclusive - 1);
+			}
+		}
+		if (job == NULL) {
+			while (pool->next_concurrent < pool->count &&
+			       (pool->jobs[pool->next_concurrent]->done || pool->jobs[pool->next_concurrent]->exclusive))
+				pool->next_concurrent++;
+			if (pool->next_concurrent < pool->count)
+				job = pool->jobs[pool->next_concurrent++];
+		}
+		/* The remaining exclusive jobs are taken by the worker of the exclusive one */
+		if (job == NULL)
+			break;
+		pthread_mutex_unlock(&pool->lock);
+
+		/* The exclusive jobs can't be evaluated meanwhile, their checks
+		 * stay in the jobs. */
+		if (prefetch != NULL) {
+			_xccdf_policy_prefetch(job->policy, prefetch);
+			oscap_list_free0(prefetch);
+		}
+		_xccdf_policy_job_evaluate(job);
+		/* The errors are local to the thread, keep them to be reported with the job */
+		job->errors = oscap_err_take();
+
+		pthread_mutex_lock(&pool->lock);
+		job->done = true;
+		if (job->exclusive)
+			pool->exclusive_busy = false;
+		pthread_cond_broadcast(&pool->cond);
+	}
+	pthread_mutex_unlock(&pool->lock);
+	return NULL;
+}
+
+/**
+ * Evaluate the jobs of the pool by its workers and report them in the order
+ * of the rules as they are done.
+ */
+static int _xccdf_policy_pool_run(struct xccdf_policy_pool *pool)
+{
+	size_t pending = 0;
+	for (size_t i = 0; i < pool->count; i++) {
+		if (!pool->jobs[i]->done)
+			pending++;
+	}
+	unsigned int workers = pool->workers < pending ? pool->workers : pending;
+	dI("Evaluating %zu rules by %u workers.", pending, workers);
+
+	pthread_t *threads = malloc(workers * sizeof(pthread_t));
+	unsigned int started = 0;
+	for (; started < workers; started++) {
+		int err = pthread_create(&threads[started], NULL, _xccdf_policy_pool_worker, pool);
+		if (err != 0) {
+			dW("Failed to start a worker thread: %s", strerror(err));
+			break;
+		}
+	}
+	if (started == 0 && pending > 0)
+		_xccdf_policy_pool_worker(pool);
+
+	int report = 0;
+	for (size_t i = 0; i < pool->count && report == 0; i++) {
+		struct xccdf_policy_job *job = pool->jobs[i];
+		pthread_mutex_lock(&pool->lock);
+		while (!job->done)
+			pthread_cond_wait(&pool->cond, &pool->lock);
+		pthread_mutex_unlock(&pool->lock);
+		report = _xccdf_policy_job_report(job);
+	}
+
+	pthread_mutex_lock(&pool->lock);
+	pool->cancelled = true;
+	pthread_mutex_unlock(&pool->lock);
+	for (unsigned int i = 0; i < started; i++)
+		pthread_join(threads[i], NULL);
+	free(threads);
+	return report;
+}
+
+static struct xccdf_policy_pool *_xccdf_policy_pool_new(unsigned int workers)
+{
+	struct xccdf_policy_pool *pool = calloc(1, sizeof(struct xccdf_policy_pool));
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->cond, NULL);
+	pool->workers = workers;
+	return pool;
+}
+
+static void _xccdf_policy_pool_free(struct xccdf_policy_pool *pool)
+{
+	if (pool == NULL)
+		return;
+	for (size_t i = 0; i < pool->count; i++)
+		_xccdf_policy_job_free(pool->jobs[i]);
+	free(pool->jobs);
+	pthread_cond_destroy(&pool->cond);
+	pthread_mutex_destroy(&pool->lock);
+	free(pool);
 }
 
 /** 
@@ -1593,6 +1954,7 @@ bool xccdf_policy_model_add_cpe_dict_source(struct xccdf_policy_model * model, s
 	__attribute__nonnull__(model);
 	__attribute__nonnull__(source);
 
+	xccdf_policy_model_reset_platform_applicability(model);
 	return cpe_session_add_cpe_dict_source(model->cpe, source);
 }
 
@@ -1602,6 +1964,7 @@ bool xccdf_policy_model_add_cpe_dict(struct xccdf_policy_model *model, const cha
 		__attribute__nonnull__(cpe_dict);
 
 	struct oscap_source *source = oscap_source_new_from_file(cpe_dict);
+	xccdf_policy_model_reset_platform_applicability(model);
 	bool ret = cpe_session_add_cpe_dict_source(model->cpe, source);
 	oscap_source_free(source);
 	return ret;
@@ -1612,6 +1975,7 @@ bool xccdf_policy_model_add_cpe_lang_model_source(struct xccdf_policy_model *mod
 	__attribute__nonnull__(model);
 	__attribute__nonnull__(source);
 
+	xccdf_policy_model_reset_platform_applicability(model);
 	return cpe_session_add_cpe_lang_model_source(model->cpe, source);
 }
 
@@ -1620,6 +1984,7 @@ bool xccdf_policy_model_add_cpe_autodetect_source(struct xccdf_policy_model *mod
 	__attribute__nonnull__(model);
 	__attribute__nonnull__(source);
 
+	xccdf_policy_model_reset_platform_applicability(model);
 	return cpe_session_add_cpe_autodetect_source(model->cpe, source);
 }
 
@@ -1741,6 +2106,7 @@ struct xccdf_policy_model * xccdf_policy_model_new(struct xccdf_benchmark * benc
 	model->engines = oscap_list_new();
 
 	model->cpe = cpe_session_new();
+	model->platform_applicability = oscap_htable_new();
 
         /* Resolve document */
         xccdf_benchmark_resolve(benchmark);
@@ -1880,6 +2246,8 @@ struct xccdf_policy * xccdf_policy_new(struct xccdf_policy_model * model, struct
 	policy->selected_internal = oscap_htable_new();
 	policy->selected_final = oscap_htable_new();
 	policy->refine_rules_internal = oscap_htable_new();
+	policy->jobs = 0;
+	policy->pool = NULL;
 	policy->model = model;
 
 	benchmark = xccdf_policy_model_get_benchmark(model);
@@ -2077,7 +2445,7 @@ static void xccdf_policy_add_final_setvalues(struct xccdf_policy *policy, struct
 struct xccdf_result * xccdf_policy_evaluate(struct xccdf_policy * policy)
 {
     struct xccdf_benchmark          * benchmark;
-    int                               ret       = -1;
+    int                               ret       = 0;
     const char			    * doc_version = NULL;
 
     __attribute__nonnull__(policy);
@@ -2127,19 +2495,27 @@ struct xccdf_result * xccdf_policy_evaluate(struct xccdf_policy * policy)
 
 	/** We need to process document top-down order.
 	 * See conflicts/requires and Item Processing Algorithm */
+	/* With more jobs, the walk only collects the rules for the pool */
+	if (policy->jobs > 1)
+		policy->pool = _xccdf_policy_pool_new(policy->jobs);
 	struct xccdf_item_iterator *item_it = xccdf_benchmark_get_content(benchmark);
 	while (xccdf_item_iterator_has_more(item_it)) {
 		struct xccdf_item *item = xccdf_item_iterator_next(item_it);
 		ret = xccdf_policy_item_evaluate(policy, item, result, true);
-		if (ret == -1) {
-			xccdf_item_iterator_free(item_it);
-			xccdf_result_free(result);
-			return NULL;
-		}
 		if (ret != 0)
 			break;
 	}
 	xccdf_item_iterator_free(item_it);
+	if (policy->pool != NULL) {
+		if (ret == 0)
+			ret = _xccdf_policy_pool_run(policy->pool);
+		_xccdf_policy_pool_free(policy->pool);
+		policy->pool = NULL;
+	}
+	if (ret == -1) {
+		xccdf_result_free(result);
+		return NULL;
+	}
 
 	struct oscap_htable_iterator *rit = oscap_htable_iterator_new(policy->rules);
 	while (oscap_htable_iterator_has_more(rit)) {
@@ -2250,6 +2626,7 @@ void xccdf_policy_model_free(struct xccdf_policy_model * model) {
 	xccdf_tailoring_free(model->tailoring);
         xccdf_benchmark_free(model->benchmark);
 	cpe_session_free(model->cpe);
+	oscap_htable_free0(model->platform_applicability);
         free(model);
 }
 
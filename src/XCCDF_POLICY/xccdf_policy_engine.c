@@ -75,3 +75,30 @@ struct oscap_list *xccdf_policy_engine_query(struct xccdf_policy_engine *engine,
 		return NULL;
 	return (struct oscap_list *) engine->query_fn(engine->usr, query_type, query_data);
 }
+
+bool xccdf_policy_engine_is_concurrent(struct xccdf_policy_engine *engine)
+{
+	if (engine->query_fn == NULL)
+		return false;
+	return engine->query_fn(engine->usr, POLICY_ENGINE_QUERY_CONCURRENT_EVAL, NULL) != NULL;
+}
+
+void xccdf_policy_engine_prefetch(struct xccdf_policy_engine *engine, struct oscap_list *checks)
+{
+	if (engine->query_fn == NULL)
+		return;
+	struct oscap_list *own_checks = oscap_list_new();
+	struct oscap_iterator *it = oscap_iterator_new(checks);
+	while (oscap_iterator_has_more(it)) {
+		struct xccdf_check *check = oscap_iterator_next(it);
+		if (xccdf_policy_engine_filter(engine, xccdf_check_get_system(check)))
+			oscap_list_add(own_checks, check);
+	}
+	oscap_iterator_free(it);
+	if (oscap_list_get_itemcount(own_checks) > 0) {
+		struct xccdf_check_iterator *check_it = (struct xccdf_check_iterator *) oscap_iterator_new(own_checks);
+		engine->query_fn(engine->usr, POLICY_ENGINE_QUERY_PREFETCH, check_it);
+		xccdf_check_iterator_free(check_it);
+	}
+	oscap_list_free0(own_checks);
+}
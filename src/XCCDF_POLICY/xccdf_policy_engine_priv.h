@@ -76,5 +76,23 @@ xccdf_test_result_type_t xccdf_policy_engine_eval(struct xccdf_policy_engine *en
  */
 struct oscap_list *xccdf_policy_engine_query(struct xccdf_policy_engine *engine, xccdf_policy_engine_query_t query_type, void *query_data);
 
+/**
+ * Find out whether the given checking engine can evaluate more checks
+ * concurrently, see POLICY_ENGINE_QUERY_CONCURRENT_EVAL.
+ * @memberof xccdf_policy_engine
+ * @param engine Checking Engine
+ * @returns true if the eval function may be called from more threads at once
+ */
+bool xccdf_policy_engine_is_concurrent(struct xccdf_policy_engine *engine);
+
+/**
+ * Let the given checking engine collect the data for those of the given checks
+ * which are of its system ahead of their evaluation, see POLICY_ENGINE_QUERY_PREFETCH.
+ * @memberof xccdf_policy_engine
+ * @param engine Checking Engine
+ * @param checks list of struct xccdf_check which are going to be evaluated
+ */
+void xccdf_policy_engine_prefetch(struct xccdf_policy_engine *engine, struct oscap_list *checks);
+
 
 #endif
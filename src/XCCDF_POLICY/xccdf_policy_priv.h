@@ -44,6 +44,7 @@ struct xccdf_policy_model {
 	struct oscap_list       * engines;      ///< Callbacks for checking engines (see xccdf_policy_engine)
 
 	struct cpe_session *cpe;
+	struct oscap_htable *platform_applicability;	///< Applicability of platforms evaluated so far
 };
 
 /**
@@ -72,6 +73,10 @@ struct xccdf_policy {
 	struct oscap_htable		*selected_final;
 	/* The hash-table contains the latest refine-rule for specified item-id. */
 	struct oscap_htable		*refine_rules_internal;
+	/** Number of rules to be evaluated at once, 0 or 1 to evaluate them in turn */
+	unsigned int			jobs;
+	/** Pool of the rules to be evaluated during xccdf_policy_evaluate(), NULL unless more jobs */
+	struct xccdf_policy_pool	*pool;
 };
 
 
@@ -23,11 +23,14 @@
 
 #include <string.h>
 #include <ctype.h>
+#include <time.h>
 #include <errno.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 
 #ifdef OSCAP_UNIX
+#include <fcntl.h>
+#include <sys/socket.h>
 #include <sys/wait.h>
 #endif
 
@@ -38,12 +41,14 @@
 #endif
 
 #include <libxml/tree.h>
-#include <pcre.h>
 
 #include "XCCDF/item.h"
 #include "common/_error.h"
 #include "common/debug_priv.h"
 #include "common/oscap_acquire.h"
+#include "common/oscap_buffer.h"
+#include "common/oscap_string.h"
+#include "common/oscap_pcre.h"
 #include "xccdf_policy_priv.h"
 #include "xccdf_policy_model_priv.h"
 #include "public/xccdf_policy.h"
@@ -385,8 +390,271 @@ static inline int _xccdf_fix_decode_xml(struct xccdf_fix *fix, char **result)
 	return 0;
 }
 
+/*
+ * Bash fixes of one remediation are run by a single interpreter process, the
+ * fix session, which is much smaller than oscap and forks faster. The paths
+ * of the fix scripts are sent to the session one by one, the session sources
+ * each of them in a new subshell and prints a marker line with the exit code
+ * of the fix after its output.
+ */
+struct _fix_session {
+	char *temp_dir;		///< directory with the fix scripts of the remediation
+	char *marker;		///< beginning of the line which follows the output of each fix
+	pid_t pid;		///< interpreter process of the session, 0 if not running
+	int cmd_fd;		///< paths of the fix scripts are sent there
+	int out_fd;		///< output of the fixes and the markers are read from there
+	struct oscap_buffer *pending;	///< output read after the marker of the previous fix
+};
+
 #if defined(unix) || defined(__unix__) || defined(__unix)
-static inline int _xccdf_fix_execute(struct xccdf_rule_result *rr, struct xccdf_fix *fix)
+/* The session reads the paths of the fix scripts from fd 3 rather than from
+ * stdin, so the fixes can read the stdin of oscap as before. */
+#define FIX_SESSION_CMD_FD 3
+#define FIX_SESSION_READ_SIZE 65536
+
+static struct _fix_session *_fix_session_new(void)
+{
+	struct _fix_session *session = calloc(1, sizeof(struct _fix_session));
+	session->marker = oscap_sprintf("oscap-fix-result-%ld-%ld", (long) getpid(), (long) time(NULL));
+	session->pending = oscap_buffer_new();
+	return session;
+}
+
+static inline bool _fix_session_supports(const struct xccdf_fix *fix)
+{
+	const char *sys = xccdf_fix_get_system(fix);
+	return oscap_streq(sys, "urn:xccdf:fix:commands") || oscap_streq(sys, "urn:xccdf:fix:script:sh");
+}
+
+static void _fix_session_stop(struct _fix_session *session)
+{
+	if (session->pid == 0)
+		return;
+	/* The session exits when it reads the end of the commands. */
+	close(session->cmd_fd);
+	close(session->out_fd);
+	waitpid(session->pid, NULL, 0);
+	session->pid = 0;
+	oscap_buffer_clear(session->pending);
+}
+
+static void _fix_session_free(struct _fix_session *session)
+{
+	if (session == NULL)
+		return;
+	_fix_session_stop(session);
+	if (session->temp_dir != NULL)
+		oscap_acquire_cleanup_dir(&session->temp_dir);
+	free(session->marker);
+	oscap_buffer_free(session->pending);
+	free(session);
+}
+
+static int _fix_session_start(struct _fix_session *session, struct xccdf_rule_result *rr, const char *interpret)
+{
+	int cmd_fds[2];
+	int out_fds[2];
+	/* A socket rather than a pipe, the commands are sent with MSG_NOSIGNAL,
+	 * so a session killed by a fix doesn't kill oscap by SIGPIPE.
+	 * The fixes executed by their own interpreter while the session runs
+	 * must not inherit the ends of oscap, a background process left by such
+	 * a fix would keep the session from reading the end of the commands. */
+	if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, cmd_fds) == -1) {
+		_rule_add_info_message(rr, "Could not create socket: %s", strerror(errno));
+		return 1;
+	}
+	if (pipe2(out_fds, O_CLOEXEC) == -1) {
+		_rule_add_info_message(rr, "Could not create pipe: %s", strerror(errno));
+		close(cmd_fds[0]);
+		close(cmd_fds[1]);
+		return 1;
+	}
+
+	/* Every fix is sourced by a subshell of the session, so changes of
+	 * variables, options, traps or the working directory made by a fix and
+	 * its exit or return end only the subshell. $0 is set to the fix script
+	 * as if bash executed it, BASH_SOURCE refers to it as the sourced file.
+	 * Bash older than 5.0 can't set $0 by BASH_ARGV0, the session executes
+	 * every fix by a new interpreter there. */
+	char *runner = oscap_sprintf(
+		"while IFS= read -r REPLY <&%d; do"
+		" if [ \"${BASH_VERSINFO[0]}\" -ge 5 ]; then"
+		" ( BASH_ARGV0=$REPLY; unset REPLY; . \"$BASH_ARGV0\" ) %d<&-;"
+		" else \"$BASH\" \"$REPLY\" %d<&-; fi;"
+		" printf '\\n%%s %%d\\n' '%s' $?;"
+		" done",
+		FIX_SESSION_CMD_FD, FIX_SESSION_CMD_FD, FIX_SESSION_CMD_FD, session->marker);
+
+	pid_t pid = fork();
+	if (pid == 0) {
+		close(cmd_fds[0]);
+		close(out_fds[0]);
+		dup2(out_fds[1], fileno(stdout));
+		dup2(out_fds[1], fileno(stderr));
+		/* dup2() clears the close-on-exec flag of the new fds */
+		if (cmd_fds[1] != FIX_SESSION_CMD_FD) {
+			dup2(cmd_fds[1], FIX_SESSION_CMD_FD);
+			close(cmd_fds[1]);
+		} else {
+			fcntl(FIX_SESSION_CMD_FD, F_SETFD, 0);
+		}
+		if (out_fds[1] > FIX_SESSION_CMD_FD)
+			close(out_fds[1]);
+
+		/* bash -c reads ~/.bashrc when its stdin is a socket, the
+		 * fixes executed by their own interpreter don't get it. */
+		char *const argvp[6] = {
+			(char *)interpret,
+			"--norc",
+			"-c",
+			runner,
+			(char *)interpret,
+			NULL
+		};
+
+		char *const envp[2] = {
+			"PATH=/bin:/sbin:/usr/bin:/usr/sbin",
+			NULL
+		};
+
+		execve(interpret, argvp, envp);
+		printf("Error while executing fix script: execve returned: %s\n", strerror(errno));
+		exit(42);
+	}
+
+	free(runner);
+	close(cmd_fds[1]);
+	close(out_fds[1]);
+	if (pid < 0) {
+		_rule_add_info_message(rr, "Failed to fork. %s", strerror(errno));
+		close(cmd_fds[0]);
+		close(out_fds[0]);
+		return 1;
+	}
+	dI("Started fix session %ld with %s.", (long) pid, interpret);
+	session->pid = pid;
+	session->cmd_fd = cmd_fds[0];
+	session->out_fd = out_fds[0];
+	return 0;
+}
+
+/*
+ * Returns the position of the marker line in the output, or -1 if the output
+ * doesn't contain the whole marker line yet. The marker line is
+ * "\n<marker> <exit code>\n", the newline before the marker is not part of
+ * the fix output. The search starts at *from, which is moved past the part of
+ * the output which can't contain the marker. The position of the output which
+ * follows the marker line is stored to *next.
+ */
+static ssize_t _fix_session_find_marker(const struct _fix_session *session, const char *output, size_t length, size_t *from, size_t *next)
+{
+	size_t marker_length = strlen(session->marker);
+	const char *end = output + length;
+	const char *line = output + *from;
+
+	while ((line = memchr(line, '\n', end - line)) != NULL) {
+		if ((size_t)(end - line) < marker_length + 2) {
+			/* the output may continue with the marker */
+			break;
+		}
+		if (memcmp(line + 1, session->marker, marker_length) == 0 && line[marker_length + 1] == ' ') {
+			const char *line_end = memchr(line + marker_length + 2, '\n', end - line - marker_length - 2);
+			if (line_end == NULL)
+				break;
+			*next = line_end + 1 - output;
+			return line - output;
+		}
+		line++;
+	}
+	*from = line != NULL ? (size_t)(line - output) : length;
+	return -1;
+}
+
+static char *_escape_fix_output(const char *output, size_t length)
+{
+	struct oscap_string *escaped = oscap_string_new();
+	const char *end = output + length;
+	const char *amp;
+	while ((amp = memchr(output, '&', end - output)) != NULL) {
+		// & is a special case, we have to "escape" it manually
+		// (all else will eventually get handled by libxml)
+		oscap_string_append_string_len(escaped, output, amp - output);
+		oscap_string_append_string(escaped, "&amp;");
+		output = amp + 1;
+	}
+	oscap_string_append_string_len(escaped, output, end - output);
+	return oscap_string_bequeath(escaped);
+}
+
+static int _fix_session_execute(struct _fix_session *session, struct xccdf_rule_result *rr, const char *interpret, const char *fix_file)
+{
+	if (session->pid == 0 && _fix_session_start(session, rr, interpret) != 0)
+		return 1;
+
+	char *command = oscap_sprintf("%s\n", fix_file);
+	size_t command_length = strlen(command);
+	size_t sent = 0;
+	while (sent < command_length) {
+		ssize_t ret = send(session->cmd_fd, command + sent, command_length - sent, MSG_NOSIGNAL);
+		if (ret == -1 && errno == EINTR)
+			continue;
+		if (ret == -1) {
+			_rule_add_info_message(rr, "Could not send the fix to the interpreter: %s", strerror(errno));
+			free(command);
+			_fix_session_stop(session);
+			return 1;
+		}
+		sent += ret;
+	}
+	free(command);
+
+	/* Output of background jobs of the previous fixes which came after
+	 * their marker is credited to this fix. */
+	struct oscap_buffer *output = session->pending;
+	session->pending = oscap_buffer_new();
+	char readbuf[FIX_SESSION_READ_SIZE];
+	size_t search_from = 0, next = 0;
+	ssize_t marker_pos = -1;
+	while (marker_pos < 0) {
+		ssize_t ret = read(session->out_fd, readbuf, sizeof(readbuf));
+		if (ret == -1 && errno == EINTR)
+			continue;
+		if (ret <= 0)
+			break;
+		oscap_buffer_append_binary_data(output, readbuf, ret);
+		marker_pos = _fix_session_find_marker(session, oscap_buffer_get_raw(output),
+				oscap_buffer_get_length(output), &search_from, &next);
+	}
+
+	if (marker_pos < 0) {
+		/* The interpreter exited in the middle of the fix, e.g. the fix
+		 * killed its parent process. */
+		_rule_add_info_message(rr, "Fix execution was interrupted, the interpreter exited.");
+		if (oscap_buffer_get_length(output) > 0) {
+			char *stdout_buff = _escape_fix_output(oscap_buffer_get_raw(output), oscap_buffer_get_length(output));
+			_rule_add_info_message(rr, stdout_buff);
+			free(stdout_buff);
+		}
+		oscap_buffer_free(output);
+		_fix_session_stop(session);
+		return 1;
+	}
+
+	const char *raw = oscap_buffer_get_raw(output);
+	if (next < oscap_buffer_get_length(output))
+		oscap_buffer_append_binary_data(session->pending, raw + next, oscap_buffer_get_length(output) - next);
+	int exit_code = atoi(raw + marker_pos + strlen(session->marker) + 2);
+	_rule_add_info_message(rr, "Fix execution completed and returned: %d", exit_code);
+	if (marker_pos > 0) {
+		char *stdout_buff = _escape_fix_output(raw, marker_pos);
+		_rule_add_info_message(rr, stdout_buff);
+		free(stdout_buff);
+	}
+	oscap_buffer_free(output);
+	return 0;
+}
+
+static inline int _xccdf_fix_execute(struct xccdf_rule_result *rr, struct xccdf_fix *fix, struct _fix_session *session)
 {
 	if (rr == NULL) {
 		return 1;
@@ -412,14 +680,22 @@ static inline int _xccdf_fix_execute(struct xccdf_rule_result *rr, struct xccdf_
 
 	int result = 1;
 
-	char *temp_dir = oscap_acquire_temp_dir();
-	if (temp_dir == NULL)
+	/* The fixes executed within a session share its temp directory. */
+	char *temp_dir = NULL;
+	if (session != NULL) {
+		if (session->temp_dir == NULL)
+			session->temp_dir = oscap_acquire_temp_dir();
+	} else {
+		temp_dir = oscap_acquire_temp_dir();
+	}
+	const char *fix_dir = session != NULL ? session->temp_dir : temp_dir;
+	if (fix_dir == NULL)
 		goto cleanup;
 	// TODO: Directory and files shall be labeled with SELinux to prevent
 	// confined processes with less priviledges to transit to oscap domain
 	// and become basically unconfined.
 	char *temp_file = NULL;
-	int fd = oscap_acquire_temp_file(temp_dir, "fix-XXXXXXXX", &temp_file);
+	int fd = oscap_acquire_temp_file(fix_dir, "fix-XXXXXXXX", &temp_file);
 	if (fd == -1) {
 		_rule_add_info_message(rr, "mkstemp failed: %s", strerror(errno));
 		goto cleanup;
@@ -428,16 +704,21 @@ static inline int _xccdf_fix_execute(struct xccdf_rule_result *rr, struct xccdf_
 	if (_write_text_to_fd(fd, fix_text) != 0) {
 		_rule_add_info_message(rr, "Could not write to the temp file: %s", strerror(errno));
 		(void) close(fd);
-		goto cleanup;
+		goto cleanup_file;
 	}
 
 	if (close(fd) != 0)
 		_rule_add_info_message(rr, "Could not close temp file: %s", strerror(errno));
 
+	if (session != NULL && _fix_session_supports(fix)) {
+		result = _fix_session_execute(session, rr, interpret, temp_file);
+		goto cleanup_file;
+	}
+
 	int pipefd[2];
 	if (pipe(pipefd) == -1) {
 		_rule_add_info_message(rr, "Could not create pipe: %s", strerror(errno));
-		goto cleanup;
+		goto cleanup_file;
 	}
 
 	int fork_result = fork();
@@ -468,7 +749,6 @@ static inline int _xccdf_fix_execute(struct xccdf_rule_result *rr, struct xccdf_
 			printf("Error while executing fix script: execve returned: %s\n", strerror(errno));
 			exit(42);
 		} else {
-			free(temp_file);
 			close(pipefd[1]);
 			char *stdout_buff = oscap_acquire_pipe_to_string(pipefd[0]);
 			int wstatus;
@@ -482,16 +762,28 @@ static inline int _xccdf_fix_execute(struct xccdf_rule_result *rr, struct xccdf_
 		}
 	} else {
 		_rule_add_info_message(rr, "Failed to fork. %s", strerror(errno));
-		free(temp_file);
 	}
 
+cleanup_file:
+	if (session != NULL)
+		unlink(temp_file);
+	free(temp_file);
 cleanup:
 	oscap_acquire_cleanup_dir(&temp_dir);
 	free(fix_text);
 	return result;
 }
 #else
-static inline int _xccdf_fix_execute(struct xccdf_rule_result *rr, struct xccdf_fix *fix)
+static struct _fix_session *_fix_session_new(void)
+{
+	return NULL;
+}
+
+static void _fix_session_free(struct _fix_session *session)
+{
+}
+
+static inline int _xccdf_fix_execute(struct xccdf_rule_result *rr, struct xccdf_fix *fix, struct _fix_session *session)
 {
 	if (rr == NULL) {
 		return 1;
@@ -508,7 +800,7 @@ static inline int _xccdf_fix_execute(struct xccdf_rule_result *rr, struct xccdf_
 }
 #endif
 
-int xccdf_policy_rule_result_remediate(struct xccdf_policy *policy, struct xccdf_rule_result *rr, struct xccdf_fix *fix, struct xccdf_result *test_result)
+static int _xccdf_policy_rule_result_remediate(struct xccdf_policy *policy, struct xccdf_rule_result *rr, struct xccdf_fix *fix, struct xccdf_result *test_result, struct _fix_session *session)
 {
 	if (policy == NULL || rr == NULL)
 		return 1;
@@ -547,7 +839,7 @@ int xccdf_policy_rule_result_remediate(struct xccdf_policy *policy, struct xccdf
 		}else{
 
 			/* Execute the fix. */
-			res = _xccdf_fix_execute(rr, cfix);
+			res = _xccdf_fix_execute(rr, cfix, session);
 			if (res != 0) {
 				_rule_add_info_message(rr, "Fix was not executed. Execution was aborted.");
 				xccdf_rule_result_set_result(rr, XCCDF_RESULT_ERROR);
@@ -590,15 +882,25 @@ int xccdf_policy_rule_result_remediate(struct xccdf_policy *policy, struct xccdf
 	return rule == NULL ? 0 : xccdf_policy_report_cb(policy, XCCDF_POLICY_OUTCB_END, (void *) rr);
 }
 
+int xccdf_policy_rule_result_remediate(struct xccdf_policy *policy, struct xccdf_rule_result *rr, struct xccdf_fix *fix, struct xccdf_result *test_result)
+{
+	return _xccdf_policy_rule_result_remediate(policy, rr, fix, test_result, NULL);
+}
+
 int xccdf_policy_remediate(struct xccdf_policy *policy, struct xccdf_result *result)
 {
 	__attribute__nonnull__(result);
+	/* The bash fixes are executed by one interpreter unless disabled. */
+	struct _fix_session *session = NULL;
+	if (!oscap_streq(getenv("OSCAP_REMEDIATION_BATCH"), "0"))
+		session = _fix_session_new();
 	struct xccdf_rule_result_iterator *rr_it = xccdf_result_get_rule_results(result);
 	while (xccdf_rule_result_iterator_has_more(rr_it)) {
 		struct xccdf_rule_result *rr = xccdf_rule_result_iterator_next(rr_it);
-		xccdf_policy_rule_result_remediate(policy, rr, NULL, result);
+		_xccdf_policy_rule_result_remediate(policy, rr, NULL, result, session);
 	}
 	xccdf_rule_result_iterator_free(rr_it);
+	_fix_session_free(session);
 	xccdf_result_set_end_time_current(result);
 	return 0;
 }
@@ -661,12 +963,12 @@ static int _write_fix_missing_warning_to_fd(const char *sys, int output_fd, stru
 struct blueprint_entries {
 	const char *pattern;
 	struct oscap_list *list;
-	pcre *re;
+	oscap_pcre_t *re;
 };
 
 static inline int _parse_blueprint_fix(const char *fix_text, struct oscap_list *generic, struct oscap_list *services_enable, struct oscap_list *services_disable, struct oscap_list *kernel_append)
 {
-	const char *err;
+	char *err;
 	int errofs;
 	int ret = 0;
 
@@ -681,9 +983,10 @@ static inline int _parse_blueprint_fix(const char *fix_text, struct oscap_list *
 	};
 
 	for (int i = 0; tab[i].pattern != NULL; i++) {
-		tab[i].re = pcre_compile(tab[i].pattern, PCRE_UTF8, &err, &errofs, NULL);
+		tab[i].re = oscap_pcre_get_cached(tab[i].pattern, OSCAP_PCRE_OPTS_UTF8, &err, &errofs);
 		if (tab[i].re == NULL) {
 			dE("Unable to compile /%s/ regex pattern, pcre_compile() returned error (offset: %d): '%s'.\n", tab[i].pattern, errofs, err);
+			oscap_pcre_err_free(err);
 			ret = 1;
 			goto exit;
 		}
@@ -695,8 +998,8 @@ static inline int _parse_blueprint_fix(const char *fix_text, struct oscap_list *
 
 	for (int i = 0; tab[i].pattern != NULL; i++) {
 		while (true) {
-			const int match = pcre_exec(tab[i].re, NULL, fix_text, fix_text_len, start_offset,
-			                            0, ovector, sizeof(ovector) / sizeof(ovector[0]));
+			const int match = oscap_pcre_exec(tab[i].re, fix_text, fix_text_len, start_offset,
+			                                  OSCAP_PCRE_OPTS_NONE, ovector, sizeof(ovector) / sizeof(ovector[0]));
 			if (match == -1)
 				break;
 
@@ -726,7 +1029,7 @@ static inline int _parse_blueprint_fix(const char *fix_text, struct oscap_list *
 
 exit:
 	for (int i = 0; tab[i].pattern != NULL; i++)
-		pcre_free(tab[i].re);
+		oscap_pcre_free(tab[i].re);
 
 	return ret;
 }
@@ -737,13 +1040,14 @@ static inline int _parse_ansible_fix(const char *fix_text, struct oscap_list *va
 	const char *pattern =
 		"- name: XCCDF Value [^ ]+ # promote to variable\n  set_fact:\n"
 		"    ([^:]+): (.+)\n  tags:\n    - always\n";
-	const char *err;
+	char *err;
 	int errofs;
 
-	pcre *re = pcre_compile(pattern, PCRE_UTF8, &err, &errofs, NULL);
+	oscap_pcre_t *re = oscap_pcre_get_cached(pattern, OSCAP_PCRE_OPTS_UTF8, &err, &errofs);
 	if (re == NULL) {
 		dE("Unable to compile regex pattern, "
 				"pcre_compile() returned error (offset: %d): '%s'.\n", errofs, err);
+		oscap_pcre_err_free(err);
 		return 1;
 	}
 
@@ -758,14 +1062,14 @@ static inline int _parse_ansible_fix(const char *fix_text, struct oscap_list *va
 	const size_t fix_text_len = strlen(fix_text);
 	int start_offset = 0;
 	while (true) {
-		const int match = pcre_exec(re, NULL, fix_text, fix_text_len, start_offset,
-				0, ovector, sizeof(ovector) / sizeof(ovector[0]));
+		const int match = oscap_pcre_exec(re, fix_text, fix_text_len, start_offset,
+				OSCAP_PCRE_OPTS_NONE, ovector, sizeof(ovector) / sizeof(ovector[0]));
 		if (match == -1)
 			break;
 		if (match != 3) {
 			dE("Expected 2 capture group matches per XCCDF variable. Found %i!",
 				match - 1);
-			pcre_free(re);
+			oscap_pcre_free(re);
 			return 1;
 		}
 
@@ -807,7 +1111,7 @@ static inline int _parse_ansible_fix(const char *fix_text, struct oscap_list *va
 		oscap_list_add(tasks, remediation_part);
 	}
 
-	pcre_free(re);
+	oscap_pcre_free(re);
 	return 0;
 }
 
@@ -58,4 +58,20 @@ struct oscap_err_t {
 __attribute__((format (printf, 5, 6)))
 void __oscap_seterr(const char *file, uint32_t line, const char *func, oscap_errfamily_t family, const char *fmt, ...);
 
+struct err_queue;
+
+/**
+ * Take the errors set by the calling thread, e.g. to set them in another
+ * thread by oscap_err_restore(). The errors are cleared in the calling thread.
+ * @returns the errors, NULL if there are none
+ */
+struct err_queue *oscap_err_take(void);
+
+/**
+ * Set the errors taken by oscap_err_take() in the calling thread, after
+ * the errors it has already set.
+ * @param errors the errors, the queue is disposed
+ */
+void oscap_err_restore(struct err_queue *errors);
+
 #endif				/* _OSCAP_ERROR_H */
@@ -56,6 +56,9 @@ const struct oscap_string_map OSCAP_BOOL_MAP[] = {
 bool oscap_to_start_element(xmlTextReaderPtr reader, int depth)
 {
 	//int olddepth = xmlTextReaderDepth(reader);
+	// a failed reader stays on its last node, don't return it again
+	if (xmlTextReaderFailed(reader))
+		return false;
 	while (xmlTextReaderDepth(reader) >= depth) {
 		switch (xmlTextReaderNodeType(reader)) {
 		case XML_READER_TYPE_ELEMENT:
@@ -64,7 +67,7 @@ bool oscap_to_start_element(xmlTextReaderPtr reader, int depth)
 		default:
 			break;
 		}
-		if (xmlTextReaderRead(reader) != 1)
+		if (xmlTextReaderNextNode(reader) != 1)
 			break;
 	}
 	return false;
@@ -98,8 +101,9 @@ int oscap_parser_text_value(xmlTextReaderPtr reader, oscap_xml_value_consumer co
 		return ret;
 	}
 
-	xmlTextReaderRead(reader);
-	while (xmlTextReaderDepth(reader) > depth) {
+	if (xmlTextReaderNextNode(reader) != 1)
+		ret = -1;
+	while (ret != -1 && xmlTextReaderDepth(reader) > depth) {
 		int nodetype = xmlTextReaderNodeType(reader);
 		if (nodetype == XML_READER_TYPE_CDATA || nodetype == XML_READER_TYPE_TEXT) {
 			char *value = (char *)xmlTextReaderValue(reader);
@@ -107,7 +111,7 @@ int oscap_parser_text_value(xmlTextReaderPtr reader, oscap_xml_value_consumer co
 			free(value);
 			has_value = true;
 		}
-		if (xmlTextReaderRead(reader) != 1) {
+		if (xmlTextReaderNextNode(reader) != 1) {
 			ret = -1;
 			break;
 		}
@@ -128,7 +132,7 @@ char *oscap_element_string_copy(xmlTextReaderPtr reader)
 
 	t = xmlTextReaderNodeType(reader);
 	if (t == XML_ELEMENT_NODE || t == XML_ATTRIBUTE_NODE)
-		xmlTextReaderRead(reader);
+		xmlTextReaderNextNode(reader);
 	if (xmlTextReaderHasValue(reader))
 		return (char *)xmlTextReaderValue(reader);
 	else
@@ -139,7 +143,7 @@ const char *oscap_element_string_get(xmlTextReaderPtr reader)
 {
 	if (xmlTextReaderNodeType(reader) == XML_READER_TYPE_ELEMENT ||
 			xmlTextReaderNodeType(reader) == XML_READER_TYPE_ATTRIBUTE)
-		xmlTextReaderRead(reader);
+		xmlTextReaderNextNode(reader);
 	if (xmlTextReaderHasValue(reader))
 		return (const char *)xmlTextReaderConstValue(reader);
 	return NULL;
@@ -33,6 +33,7 @@
 #include <time.h>
 #include "public/oscap.h"
 #include "util.h"
+#include "xmltext_priv.h"
 
 #define OSCAP_XMLNS_XSI BAD_CAST "http://www.w3.org/2001/XMLSchema-instance"
 
@@ -25,6 +25,7 @@
 #endif
 
 #include <assert.h>
+#include <stdint.h>
 #include <string.h>
 #include <stdio.h>
 #include <stdarg.h>
@@ -391,14 +392,45 @@ OSCAP_ITERATOR_REMOVE(oscap_stringlist, oscap_stringlist_free)
     /*OSCAP_ITERATOR_RESET(oscap_string)*/
 
 
-#define OSCAP_DEFAULT_HSIZE 389
-static inline unsigned int oscap_htable_hash(const char *str, size_t htable_size)
+/* expected number of items of tables created by oscap_htable_new() */
+#define OSCAP_DEFAULT_HSIZE 16
+#define OSCAP_HTABLE_MIN_HSIZE 8
+
+/*
+ * Hash a string a word at a time, the mixing steps are taken from
+ * the splitmix64 finalizer.
+ */
+static inline unsigned int oscap_htable_hash(const char *str)
+{
+	size_t len = strlen(str);
+	uint64_t h = 0x9e3779b97f4a7c15ULL ^ len;
+	uint64_t w;
+
+	while (len >= sizeof(w)) {
+		memcpy(&w, str, sizeof(w));
+		h = (h ^ w) * 0xbf58476d1ce4e5b9ULL;
+		h ^= h >> 31;
+		str += sizeof(w);
+		len -= sizeof(w);
+	}
+	w = 0;
+	memcpy(&w, str, len);
+	h = (h ^ w) * 0xbf58476d1ce4e5b9ULL;
+	h ^= h >> 27;
+	h *= 0x94d049bb133111ebULL;
+	h ^= h >> 31;
+
+	return (unsigned int)h;
+}
+
+static size_t oscap_htable_hsize(size_t itemcount)
 {
-	unsigned h = 0;
-	unsigned char *p;
-	for (p = (unsigned char *)str; *p != '\0'; p++)
-		h = (97 * h) + *p;
-	return h % htable_size;
+	size_t hsize = OSCAP_HTABLE_MIN_HSIZE;
+
+	/* keep the index at most 3/4 full */
+	while (hsize - hsize / 4 < itemcount)
+		hsize *= 2;
+	return hsize;
 }
 
 struct oscap_htable *oscap_htable_new1(oscap_compare_func cmp, size_t hsize)
@@ -407,32 +439,25 @@ struct oscap_htable *oscap_htable_new1(oscap_compare_func cmp, size_t hsize)
     
     assert(hsize > 0);
 
-	t = malloc(sizeof(struct oscap_htable));
+	t = calloc(1, sizeof(struct oscap_htable));
 	if (t == NULL)
 		return NULL;
-	t->hsize = hsize;
-	t->itemcount = 0;
-	t->table = calloc(hsize, sizeof(struct oscap_htable_item *));
-	if (t->table == NULL) {
-		free(t);
-		return NULL;
-	}
+	/* the index is allocated by the first oscap_htable_add() */
+	t->hsize = oscap_htable_hsize(hsize);
 	t->cmp = cmp;
 	return t;
 }
 
 struct oscap_htable * oscap_htable_clone(const struct oscap_htable * table, oscap_clone_func cloner)
 {
-	struct oscap_htable *t = oscap_htable_new();
+	struct oscap_htable *t = oscap_htable_new1(table->cmp, table->itemcount > 0 ? table->itemcount : OSCAP_DEFAULT_HSIZE);
 	if (t == NULL)
 		return NULL;
 
-	for (size_t i = 0; i < table->hsize; ++i) {
-		struct oscap_htable_item *item = table->table[i];
-		while (item != NULL) {
+	for (size_t i = 0; i < table->count; ++i) {
+		struct oscap_htable_item *item = &table->items[i];
+		if (item->key != NULL)
 			oscap_htable_add(t, item->key, (void *) cloner(item->value));
-			item = item->next;
-		}
 	}
 	
 	return t;
@@ -452,44 +477,105 @@ struct oscap_htable *oscap_htable_new(void)
 	return oscap_htable_new1(oscap_htable_cmp, OSCAP_DEFAULT_HSIZE);
 }
 
+/*
+ * Find the slot of the index which holds the key or the empty slot where
+ * the key belongs. Detached items keep their slots, so the probing isn't
+ * interrupted by them.
+ */
+static size_t oscap_htable_slot(const struct oscap_htable *htable, const char *key, unsigned int hash)
+{
+	size_t mask = htable->hsize - 1;
+	size_t slot = hash & mask;
+
+	while (htable->index[slot] != 0) {
+		const struct oscap_htable_item *item = &htable->items[htable->index[slot] - 1];
+
+		if (item->hash == hash && item->key != NULL && htable->cmp(item->key, key) == 0)
+			break;
+		slot = (slot + 1) & mask;
+	}
+	return slot;
+}
+
 static struct oscap_htable_item *oscap_htable_lookup(struct oscap_htable *htable, const char *key)
 {
 	__attribute__nonnull__(htable);
-	if (key == NULL)
+	if (key == NULL || htable->index == NULL)
 		return NULL;
-	unsigned int hashcode = oscap_htable_hash(key, htable->hsize);
-	struct oscap_htable_item *htitem = htable->table[hashcode];
-	while (htitem != NULL) {
-		if (htable->cmp(htitem->key, key) == 0)
-			return htitem;
-		htitem = htitem->next;
+	size_t slot = oscap_htable_slot(htable, key, oscap_htable_hash(key));
+	return htable->index[slot] != 0 ? &htable->items[htable->index[slot] - 1] : NULL;
+}
+
+/*
+ * Make room for one more item. The detached items are dropped when they
+ * take at least half of the items array, the index is rebuilt whenever
+ * the items array changes.
+ */
+static bool oscap_htable_reserve(struct oscap_htable *htable)
+{
+	size_t hsize = htable->hsize;
+
+	if (htable->index != NULL && htable->count < htable->alloc
+	    && htable->count + 1 <= hsize - hsize / 4)
+		return true;
+
+	if (htable->count - htable->itemcount >= htable->itemcount && htable->count > 0) {
+		size_t i, j;
+
+		for (i = 0, j = 0; i < htable->count; ++i) {
+			if (htable->items[i].key != NULL)
+				htable->items[j++] = htable->items[i];
+		}
+		htable->count = j;
 	}
-	return NULL;
+
+	if (htable->count + 1 > hsize - hsize / 4)
+		hsize = oscap_htable_hsize(htable->count + 1);
+
+	if (htable->alloc < hsize - hsize / 4) {
+		size_t alloc = hsize - hsize / 4;
+		void *items = realloc(htable->items, alloc * sizeof(struct oscap_htable_item));
+
+		if (items == NULL)
+			return false;
+		htable->items = items;
+		htable->alloc = alloc;
+	}
+
+	unsigned int *index = calloc(hsize, sizeof(unsigned int));
+	if (index == NULL)
+		return false;
+	free(htable->index);
+	htable->index = index;
+	htable->hsize = hsize;
+
+	for (size_t i = 0; i < htable->count; ++i) {
+		size_t slot = htable->items[i].hash & (hsize - 1);
+
+		while (index[slot] != 0)
+			slot = (slot + 1) & (hsize - 1);
+		index[slot] = i + 1;
+	}
+	return true;
 }
 
 bool oscap_htable_add(struct oscap_htable * htable, const char *key, void *item)
 {
 	__attribute__nonnull__(htable);
-	/*
-	   unsigned int hashcode = oscap_htable_hash(key, htable->hsize);
-	   struct oscap_htable_item* htitem = htable->table[hashcode];
-	   while(htitem != NULL)
-	   {
-	   if( (*(htable->cmp))(htitem->key, key) == 0) return false;
-	   if(htitem->next == NULL) break;
-	   htitem = htitem->next;
-	   }
-	   // htitem points to the last item
-	 */
+	if (key == NULL)
+		return false;
 	if (oscap_htable_lookup(htable, key) != NULL)
 		return false;
-	unsigned int hashcode = oscap_htable_hash(key, htable->hsize);
-	struct oscap_htable_item *newhtitem;
-	newhtitem = malloc(sizeof(struct oscap_htable_item));
+	if (!oscap_htable_reserve(htable))
+		return false;
+
+	unsigned int hash = oscap_htable_hash(key);
+	size_t slot = oscap_htable_slot(htable, key, hash);
+	struct oscap_htable_item *newhtitem = &htable->items[htable->count];
 	newhtitem->key = oscap_strdup(key);
 	newhtitem->value = item;
-	newhtitem->next = htable->table[hashcode];
-	htable->table[hashcode] = newhtitem;
+	newhtitem->hash = hash;
+	htable->index[slot] = ++htable->count;
 	htable->itemcount++;
 	return true;
 }
@@ -529,37 +615,30 @@ void oscap_htable_dump(struct oscap_htable *htable, oscap_dump_func dumper, int
 		return;
 	}
 	printf(" (hash table, %u item%s)\n", (unsigned)htable->itemcount, (htable->itemcount == 1 ? "" : "s"));
-	int i;
-	for (i = 0; i < (int)htable->hsize; ++i) {
-		struct oscap_htable_item *item = htable->table[i];
-		while (item) {
-			oscap_print_depth(depth);
-			printf("'%s':\n", item->key);
-			dumper(item->value, depth + 1);
-			item = item->next;
-		}
+	for (size_t i = 0; i < htable->count; ++i) {
+		struct oscap_htable_item *item = &htable->items[i];
+		if (item->key == NULL)
+			continue;
+		oscap_print_depth(depth);
+		printf("'%s':\n", item->key);
+		dumper(item->value, depth + 1);
 	}
 }
 
 void oscap_htable_free(struct oscap_htable *htable, oscap_destruct_func destructor)
 {
 	if (htable) {
-		size_t ht;
-		struct oscap_htable_item *cur, *next;
-
-		for (ht = 0; ht < htable->hsize; ++ht) {
-			cur = htable->table[ht];
-			while (cur) {
-				next = cur->next;
-				free(cur->key);
-				if (destructor)
-					destructor(cur->value);
-				free(cur);
-				cur = next;
-			}
+		for (size_t i = 0; i < htable->count; ++i) {
+			struct oscap_htable_item *cur = &htable->items[i];
+			if (cur->key == NULL)
+				continue;
+			free(cur->key);
+			if (destructor)
+				destructor(cur->value);
 		}
 
-		free(htable->table);
+		free(htable->items);
+		free(htable->index);
 		free(htable);
 	}
 }
@@ -571,8 +650,7 @@ void oscap_htable_free0(struct oscap_htable *htable)
 
 struct oscap_htable_iterator {
 	struct oscap_htable *htable;	// Table we iterate through
-	struct oscap_htable_item *cur;	// The current item
-	size_t hpos;			// Line on which we are now
+	size_t pos;			// Position of the next item
 };
 
 struct oscap_htable_iterator *
@@ -580,8 +658,7 @@ oscap_htable_iterator_new(struct oscap_htable *htable)
 {
 	struct oscap_htable_iterator *hit = calloc(1, sizeof(struct oscap_htable_iterator));
 	hit->htable = htable;
-	hit->cur = NULL;
-	hit->hpos = 0;
+	hit->pos = 0;
 	return hit;
 }
 
@@ -591,48 +668,21 @@ oscap_htable_iterator_has_more(struct oscap_htable_iterator *hit)
 	__attribute__nonnull__(hit);
 	if (hit->htable == NULL)
 		return false;
-	size_t i = hit->hpos;
-	if (hit->cur != NULL) {
-		if (hit->cur->next != NULL)
-			return true;
-		if (i + 1 >= hit->htable->hsize)
-			return false;
-		i++;
-	}
-	for (; i < hit->htable->hsize; i++) {
-		if (hit->htable->table[i] == NULL)
-			continue;
-		if (i != hit->hpos)
-			hit->hpos = i - 1;
-		return true;
-	}
-	hit->hpos = i;
-	return false;
+	/* skip the detached items */
+	while (hit->pos < hit->htable->count && hit->htable->items[hit->pos].key == NULL)
+		hit->pos++;
+	return hit->pos < hit->htable->count;
 }
 
 const struct oscap_htable_item *
 oscap_htable_iterator_next(struct oscap_htable_iterator *hit)
 {
 	__attribute__nonnull__(hit);
-	if (hit->cur != NULL) {
-		if (hit->cur->next != NULL) {
-			hit->cur = hit->cur->next;
-			return hit->cur;
-		}
-		if (hit->hpos + 1 >= hit->htable->hsize) {
-			assert(false);
-			return NULL;
-		}
-		hit->hpos++;
-	}
-	for (; hit->hpos < hit->htable->hsize; hit->hpos++) {
-		if (hit->htable->table[hit->hpos] == NULL)
-			continue;
-		hit->cur = hit->htable->table[hit->hpos];
-		return hit->cur;
+	if (!oscap_htable_iterator_has_more(hit)) {
+		assert(false); // no more item found
+		return NULL;
 	}
-	assert(false); // no more item found
-	return NULL;
+	return &hit->htable->items[hit->pos++];
 }
 
 const char *
@@ -663,8 +713,7 @@ void
 oscap_htable_iterator_reset(struct oscap_htable_iterator *hit)
 {
 	__attribute__nonnull__(hit);
-	hit->cur = NULL;
-	hit->hpos = 0;
+	hit->pos = 0;
 }
 
 void
@@ -170,23 +170,32 @@ void *oscap_list_find(struct oscap_list *list, void *what, oscap_cmp_func compar
 typedef int (*oscap_compare_func) (const char *, const char *);
 // Hash table item.
 struct oscap_htable_item {
-	struct oscap_htable_item *next;	// Next item.
-	char *key;		// Item key.
+	char *key;		// Item key, NULL if the item has been detached.
 	void *value;		// Item value.
+	unsigned int hash;	// Hash of the key.
 };
 
-// Hash table.
+/*
+ * Hash table.
+ *
+ * Items are stored in an array in the order in which they were added,
+ * that's also the order of iteration. The index is an open addressing
+ * table of positions in the items array, it's doubled once it's 3/4 full.
+ */
 struct oscap_htable {
-	size_t hsize;		// Size of the hash table.
+	size_t hsize;		// Size of the index, a power of 2.
 	size_t itemcount;	// Number of elements in the hash table.
-	struct oscap_htable_item **table;	// The table itself.
+	size_t count;		// Number of used slots in the items array, including detached items.
+	size_t alloc;		// Size of the items array.
+	struct oscap_htable_item *items;	// Items in the order of insertion.
+	unsigned int *index;	// Positions of items + 1, 0 marks an empty slot.
 	oscap_compare_func cmp;	// Funcion used to compare keys (e.g. strcmp).
 };
 
 /*
  * Create a new hash table.
  * @param cmp Pointer to a function used as the key comparator.
- * @hsize Size of the hash table.
+ * @hsize Expected number of items, the table grows as needed.
  * @internal
  * @return new hash table
  */
@@ -250,7 +259,8 @@ void oscap_htable_free0(struct oscap_htable *htable);
 struct oscap_htable_iterator;
 
 /**
- * Create new iterator through hash table. No ordering is defined for items.
+ * Create new iterator through hash table. Items are iterated in the order
+ * in which they were added.
  * @param htable Hash table to iterate through.
  * @return the iterator
  */
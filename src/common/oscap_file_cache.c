@@ -0,0 +1,356 @@
+/*
+ * Copyright 2026 Red Hat Inc., Durham, North Carolina.
+ * All Rights Reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "oscap_file_cache.h"
+
+#ifdef OS_WINDOWS
+
+struct oscap_file_cache *oscap_file_cache_open(const char *path, const char *magic, size_t data_size, const char *description)
+{
+	return NULL;
+}
+
+bool oscap_file_cache_get(struct oscap_file_cache *cache, const struct stat *st, uint64_t tag, void *data)
+{
+	return false;
+}
+
+void oscap_file_cache_put(struct oscap_file_cache *cache, const struct stat *st, uint64_t tag, const void *data)
+{
+}
+
+bool oscap_file_stat_unchanged(const struct stat *a, const struct stat *b)
+{
+	return a->st_size == b->st_size && a->st_mtime == b->st_mtime && a->st_ctime == b->st_ctime;
+}
+
+#else
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/file.h>
+
+#include "debug_priv.h"
+#include "list.h"
+
+#define OSCAP_FILE_CACHE_READ_RECORDS 64
+
+struct oscap_file_cache_hdr {
+	char magic[8];
+	uint32_t recsize;
+	uint32_t reserved;
+};
+
+struct oscap_file_cache_rec {
+	uint64_t dev;
+	uint64_t ino;
+	uint64_t size;
+	int64_t mtime_sec;
+	int64_t mtime_nsec;
+	int64_t ctime_sec;
+	int64_t ctime_nsec;
+	uint64_t tag;
+	uint32_t check;
+	uint32_t reserved;
+	uint8_t data[];
+};
+
+struct oscap_file_cache {
+	char magic[8];
+	char *description;
+	size_t data_size;
+	size_t recsize;                 ///< size of a record including the data
+	pthread_mutex_t mutex;
+	struct oscap_htable *records;   ///< key -> struct oscap_file_cache_rec
+	int fd;
+};
+
+static uint64_t oscap_fnv1a64(uint64_t h, const void *data, size_t len)
+{
+	const uint8_t *p = data;
+	for (size_t i = 0; i < len; ++i)
+		h = (h ^ p[i]) * 1099511628211u;
+	return h;
+}
+
+// detects records which weren't written completely
+static uint32_t oscap_file_cache_check(const struct oscap_file_cache *cache, const struct oscap_file_cache_rec *rec)
+{
+	uint64_t h = 14695981039346656037u;
+	h = oscap_fnv1a64(h, rec, offsetof(struct oscap_file_cache_rec, check));
+	h = oscap_fnv1a64(h, rec->data, cache->data_size);
+	return (uint32_t)(h ^ (h >> 32));
+}
+
+static void oscap_file_cache_key(const struct oscap_file_cache_rec *rec, char *key, size_t keylen)
+{
+	snprintf(key, keylen, "%" PRIx64 ":%" PRIx64 ":%" PRIx64, rec->dev, rec->ino, rec->tag);
+}
+
+static void oscap_file_cache_rec_init(struct oscap_file_cache_rec *rec, const struct stat *st, uint64_t tag)
+{
+	memset(rec, 0, sizeof(struct oscap_file_cache_rec));
+	rec->dev = (uint64_t)st->st_dev;
+	rec->ino = (uint64_t)st->st_ino;
+	rec->size = (uint64_t)st->st_size;
+	rec->mtime_sec = (int64_t)OSCAP_ST_MTIM(st).tv_sec;
+	rec->mtime_nsec = (int64_t)OSCAP_ST_MTIM(st).tv_nsec;
+	rec->ctime_sec = (int64_t)OSCAP_ST_CTIM(st).tv_sec;
+	rec->ctime_nsec = (int64_t)OSCAP_ST_CTIM(st).tv_nsec;
+	rec->tag = tag;
+}
+
+// insert or replace the in-memory record, called with the mutex held
+static int oscap_file_cache_insert(struct oscap_file_cache *cache, const struct oscap_file_cache_rec *rec)
+{
+	char key[64];
+	oscap_file_cache_key(rec, key, sizeof(key));
+
+	struct oscap_file_cache_rec *copy = oscap_htable_get(cache->records, key);
+	if (copy != NULL) {
+		memcpy(copy, rec, cache->recsize);
+		return 0;
+	}
+
+	copy = malloc(cache->recsize);
+	if (copy == NULL)
+		return -1;
+	memcpy(copy, rec, cache->recsize);
+	if (!oscap_htable_add(cache->records, key, copy)) {
+		free(copy);
+		return -1;
+	}
+	return 0;
+}
+
+static int oscap_file_cache_write_hdr(struct oscap_file_cache *cache, int fd)
+{
+	struct oscap_file_cache_hdr hdr;
+
+	memset(&hdr, 0, sizeof(hdr));
+	memcpy(hdr.magic, cache->magic, sizeof(hdr.magic));
+	hdr.recsize = (uint32_t)cache->recsize;
+	return write(fd, &hdr, sizeof(hdr)) == (ssize_t)sizeof(hdr) ? 0 : -1;
+}
+
+// rewrite the cache file with the current records only
+static int oscap_file_cache_compact(struct oscap_file_cache *cache, const char *path)
+{
+	char *tmp_path = malloc(strlen(path) + sizeof(".XXXXXX"));
+	if (tmp_path == NULL)
+		return -1;
+	strcpy(tmp_path, path);
+	strcat(tmp_path, ".XXXXXX");
+
+	int fd = mkstemp(tmp_path);
+	if (fd < 0) {
+		free(tmp_path);
+		return -1;
+	}
+
+	int ret = oscap_file_cache_write_hdr(cache, fd);
+	struct oscap_htable_iterator *it = oscap_htable_iterator_new(cache->records);
+	while (ret == 0 && oscap_htable_iterator_has_more(it)) {
+		const struct oscap_file_cache_rec *rec = oscap_htable_iterator_next_value(it);
+		if (write(fd, rec, cache->recsize) != (ssize_t)cache->recsize)
+			ret = -1;
+	}
+	oscap_htable_iterator_free(it);
+
+	if (ret == 0 && (fcntl(fd, F_SETFL, O_APPEND) != 0 || rename(tmp_path, path) != 0))
+		ret = -1;
+
+	if (ret != 0) {
+		unlink(tmp_path);
+		close(fd);
+	} else {
+		close(cache->fd);
+		cache->fd = fd;
+	}
+	free(tmp_path);
+	return ret;
+}
+
+static void oscap_file_cache_load(struct oscap_file_cache *cache, const char *path)
+{
+	struct oscap_file_cache_hdr hdr;
+	size_t total = 0;
+	struct stat st;
+	ssize_t ret;
+
+	int fd = open(path, O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0600);
+	if (fd < 0) {
+		dW("Can't open the %s '%s': %s. It won't be updated.", cache->description, path, strerror(errno));
+		return;
+	}
+
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_uid != geteuid()
+	    || (st.st_mode & (S_IWGRP | S_IWOTH)) != 0) {
+		dW("The %s '%s' isn't a regular file owned by the current user "
+		   "and writable only by them, ignoring it.", cache->description, path);
+		close(fd);
+		return;
+	}
+
+	cache->fd = fd;
+	(void) flock(fd, LOCK_EX);
+
+	ret = pread(fd, &hdr, sizeof(hdr), 0);
+	if (ret != (ssize_t)sizeof(hdr) || memcmp(hdr.magic, cache->magic, sizeof(hdr.magic)) != 0
+	    || hdr.recsize != cache->recsize) {
+		if (ret != 0)
+			dI("The %s '%s' has an unknown format, it will be recreated.", cache->description, path);
+
+		if (ftruncate(fd, 0) != 0 || oscap_file_cache_write_hdr(cache, fd) != 0) {
+			dW("Can't initialize the %s '%s': %s.", cache->description, path, strerror(errno));
+			cache->fd = -1;
+			close(fd);
+			return;
+		}
+		(void) flock(fd, LOCK_UN);
+		return;
+	}
+
+	uint8_t *buffer = malloc(OSCAP_FILE_CACHE_READ_RECORDS * cache->recsize);
+	if (buffer == NULL || lseek(fd, sizeof(hdr), SEEK_SET) == (off_t)-1)
+		goto unlock;
+
+	while ((ret = read(fd, buffer, OSCAP_FILE_CACHE_READ_RECORDS * cache->recsize)) > 0) {
+		size_t n = (size_t)ret / cache->recsize;
+
+		for (size_t i = 0; i < n; ++i) {
+			const struct oscap_file_cache_rec *rec = (const struct oscap_file_cache_rec *)(buffer + i * cache->recsize);
+			if (rec->check != oscap_file_cache_check(cache, rec))
+				continue;
+			oscap_file_cache_insert(cache, rec);
+			++total;
+		}
+
+		// a partially written record at the end of the file
+		if ((size_t)ret % cache->recsize != 0)
+			break;
+	}
+
+	dD("Loaded %zu records from the %s '%s'.", total, cache->description, path);
+
+	if (total > 2 * oscap_htable_itemcount(cache->records) + 256) {
+		if (oscap_file_cache_compact(cache, path) != 0)
+			dW("Can't compact the %s '%s': %s.", cache->description, path, strerror(errno));
+	}
+unlock:
+	free(buffer);
+	(void) flock(cache->fd, LOCK_UN);
+}
+
+struct oscap_file_cache *oscap_file_cache_open(const char *path, const char *magic, size_t data_size, const char *description)
+{
+	if (path == NULL || *path == '\0')
+		return NULL;
+
+	struct oscap_file_cache *cache = calloc(1, sizeof(struct oscap_file_cache));
+	if (cache == NULL)
+		return NULL;
+	cache->records = oscap_htable_new();
+	if (cache->records == NULL) {
+		free(cache);
+		return NULL;
+	}
+	memcpy(cache->magic, magic, sizeof(cache->magic));
+	cache->description = strdup(description);
+	cache->data_size = data_size;
+	// keep the records of the file aligned
+	cache->recsize = sizeof(struct oscap_file_cache_rec) + (data_size + 7) / 8 * 8;
+	pthread_mutex_init(&cache->mutex, NULL);
+	cache->fd = -1;
+
+	oscap_file_cache_load(cache, path);
+	return cache;
+}
+
+bool oscap_file_cache_get(struct oscap_file_cache *cache, const struct stat *st, uint64_t tag, void *data)
+{
+	struct oscap_file_cache_rec key_rec;
+	char key[64];
+	bool ret = false;
+
+	if (cache == NULL)
+		return false;
+
+	oscap_file_cache_rec_init(&key_rec, st, tag);
+	oscap_file_cache_key(&key_rec, key, sizeof(key));
+
+	pthread_mutex_lock(&cache->mutex);
+	const struct oscap_file_cache_rec *rec = oscap_htable_get(cache->records, key);
+	if (rec != NULL && rec->size == key_rec.size
+	    && rec->mtime_sec == key_rec.mtime_sec && rec->mtime_nsec == key_rec.mtime_nsec
+	    && rec->ctime_sec == key_rec.ctime_sec && rec->ctime_nsec == key_rec.ctime_nsec) {
+		if (data != NULL)
+			memcpy(data, rec->data, cache->data_size);
+		ret = true;
+	}
+	pthread_mutex_unlock(&cache->mutex);
+
+	return ret;
+}
+
+void oscap_file_cache_put(struct oscap_file_cache *cache, const struct stat *st, uint64_t tag, const void *data)
+{
+	if (cache == NULL)
+		return;
+
+	struct oscap_file_cache_rec *rec = calloc(1, cache->recsize);
+	if (rec == NULL)
+		return;
+	oscap_file_cache_rec_init(rec, st, tag);
+	if (cache->data_size > 0)
+		memcpy(rec->data, data, cache->data_size);
+	rec->check = oscap_file_cache_check(cache, rec);
+
+	pthread_mutex_lock(&cache->mutex);
+	if (oscap_file_cache_insert(cache, rec) == 0 && cache->fd >= 0) {
+		if (write(cache->fd, rec, cache->recsize) != (ssize_t)cache->recsize) {
+			dW("Can't write to the %s: %s. It won't be updated.", cache->description, strerror(errno));
+			close(cache->fd);
+			cache->fd = -1;
+		}
+	}
+	pthread_mutex_unlock(&cache->mutex);
+	free(rec);
+}
+
+bool oscap_file_stat_unchanged(const struct stat *a, const struct stat *b)
+{
+	return a->st_size == b->st_size
+		&& OSCAP_ST_MTIM(a).tv_sec == OSCAP_ST_MTIM(b).tv_sec
+		&& OSCAP_ST_MTIM(a).tv_nsec == OSCAP_ST_MTIM(b).tv_nsec
+		&& OSCAP_ST_CTIM(a).tv_sec == OSCAP_ST_CTIM(b).tv_sec
+		&& OSCAP_ST_CTIM(a).tv_nsec == OSCAP_ST_CTIM(b).tv_nsec;
+}
+
+#endif
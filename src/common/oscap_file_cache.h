@@ -0,0 +1,83 @@
+/*
+ * Copyright 2026 Red Hat Inc., Durham, North Carolina.
+ * All Rights Reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef OSCAP_FILE_CACHE_H
+#define OSCAP_FILE_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/stat.h>
+
+/* modification and status change times of struct stat with nanoseconds */
+#if defined(OS_APPLE)
+# define OSCAP_ST_MTIM(st) ((st)->st_mtimespec)
+# define OSCAP_ST_CTIM(st) ((st)->st_ctimespec)
+#elif !defined(OS_WINDOWS)
+# define OSCAP_ST_MTIM(st) ((st)->st_mtim)
+# define OSCAP_ST_CTIM(st) ((st)->st_ctim)
+#endif
+
+/*
+ * Persistent cache of data computed from files
+ *
+ * A record stores fixed size data computed from a file, e.g. its digest.
+ * Records are keyed by the device and inode numbers of the file and by a
+ * tag chosen by the caller, e.g. the digest algorithm. A record is valid
+ * only while the size, mtime and ctime of the file stay the same. The
+ * ctime can't be set from the user space, so a file can't be modified
+ * without invalidating its record.
+ *
+ * The cache file starts with a header followed by the records. Records
+ * are appended, so the file can be shared by several processes, and
+ * superseded records are dropped when the file is loaded and most of it
+ * is stale. The file has to be owned by the effective user and it must
+ * not be writable by the group or others, otherwise it's ignored.
+ */
+struct oscap_file_cache;
+
+/*
+ * Load the cache file. The cache works in memory only if the file can't
+ * be used, a warning is reported then.
+ * @param path path of the cache file
+ * @param magic 8 characters identifying the format of the cache file
+ * @param data_size size of the data stored in a record
+ * @param description name of the cache used in messages
+ * @return the cache or NULL if path is NULL or empty
+ */
+struct oscap_file_cache *oscap_file_cache_open(const char *path, const char *magic, size_t data_size, const char *description);
+
+/*
+ * Look up the data computed from the file described by st.
+ * @param data filled with the data if the record is found, may be NULL
+ * @return true if the record exists and the file didn't change
+ */
+bool oscap_file_cache_get(struct oscap_file_cache *cache, const struct stat *st, uint64_t tag, void *data);
+
+/*
+ * Store the data computed from the file described by st.
+ */
+void oscap_file_cache_put(struct oscap_file_cache *cache, const struct stat *st, uint64_t tag, const void *data);
+
+/*
+ * Check that two statuses of a file have the same size, mtime and ctime.
+ */
+bool oscap_file_stat_unchanged(const struct stat *a, const struct stat *b);
+
+#endif
@@ -0,0 +1,475 @@
+/*
+ * Copyright 2026 Red Hat Inc., Durham, North Carolina.
+ * All Rights Reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "oscap_model_cache.h"
+#include "list.h"
+
+struct oscap_model_writer {
+	uint8_t *data;
+	size_t size;
+	size_t alloc;
+	bool failed;
+};
+
+struct oscap_model_reader {
+	const uint8_t *data;
+	size_t size;
+	size_t pos;
+	bool failed;
+	void *map;              ///< mapped record, NULL if the data aren't mapped
+	size_t map_size;
+};
+
+struct oscap_model_writer *oscap_model_writer_new(void)
+{
+	return calloc(1, sizeof(struct oscap_model_writer));
+}
+
+void oscap_model_writer_free(struct oscap_model_writer *writer)
+{
+	if (writer != NULL) {
+		free(writer->data);
+		free(writer);
+	}
+}
+
+void oscap_model_writer_fail(struct oscap_model_writer *writer)
+{
+	writer->failed = true;
+}
+
+static void oscap_model_write(struct oscap_model_writer *writer, const void *data, size_t size)
+{
+	if (writer->failed)
+		return;
+	if (writer->size + size > writer->alloc) {
+		size_t alloc = writer->alloc > 0 ? writer->alloc : 4096;
+		while (writer->size + size > alloc)
+			alloc *= 2;
+		uint8_t *new_data = realloc(writer->data, alloc);
+		if (new_data == NULL) {
+			writer->failed = true;
+			return;
+		}
+		writer->data = new_data;
+		writer->alloc = alloc;
+	}
+	memcpy(writer->data + writer->size, data, size);
+	writer->size += size;
+}
+
+void oscap_model_write_u32(struct oscap_model_writer *writer, uint32_t value)
+{
+	oscap_model_write(writer, &value, sizeof(value));
+}
+
+void oscap_model_write_i64(struct oscap_model_writer *writer, int64_t value)
+{
+	oscap_model_write(writer, &value, sizeof(value));
+}
+
+void oscap_model_write_float(struct oscap_model_writer *writer, float value)
+{
+	oscap_model_write(writer, &value, sizeof(value));
+}
+
+void oscap_model_write_bool(struct oscap_model_writer *writer, bool value)
+{
+	uint8_t byte = value ? 1 : 0;
+	oscap_model_write(writer, &byte, sizeof(byte));
+}
+
+void oscap_model_write_string(struct oscap_model_writer *writer, const char *str)
+{
+	// 0 stands for NULL, otherwise the length + 1
+	if (str == NULL) {
+		oscap_model_write_u32(writer, 0);
+		return;
+	}
+	size_t len = strlen(str);
+	if (len >= UINT32_MAX) {
+		writer->failed = true;
+		return;
+	}
+	oscap_model_write_u32(writer, (uint32_t)len + 1);
+	oscap_model_write(writer, str, len);
+}
+
+bool oscap_model_reader_failed(const struct oscap_model_reader *reader)
+{
+	return reader->failed;
+}
+
+void oscap_model_reader_fail(struct oscap_model_reader *reader)
+{
+	reader->failed = true;
+}
+
+static const uint8_t *oscap_model_read(struct oscap_model_reader *reader, size_t size)
+{
+	if (reader->failed || size > reader->size - reader->pos) {
+		reader->failed = true;
+		return NULL;
+	}
+	const uint8_t *data = reader->data + reader->pos;
+	reader->pos += size;
+	return data;
+}
+
+uint32_t oscap_model_read_u32(struct oscap_model_reader *reader)
+{
+	uint32_t value = 0;
+	const uint8_t *data = oscap_model_read(reader, sizeof(value));
+	if (data != NULL)
+		memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+int64_t oscap_model_read_i64(struct oscap_model_reader *reader)
+{
+	int64_t value = 0;
+	const uint8_t *data = oscap_model_read(reader, sizeof(value));
+	if (data != NULL)
+		memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+float oscap_model_read_float(struct oscap_model_reader *reader)
+{
+	float value = 0;
+	const uint8_t *data = oscap_model_read(reader, sizeof(value));
+	if (data != NULL)
+		memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+bool oscap_model_read_bool(struct oscap_model_reader *reader)
+{
+	const uint8_t *data = oscap_model_read(reader, 1);
+	return data != NULL && *data != 0;
+}
+
+char *oscap_model_read_string(struct oscap_model_reader *reader)
+{
+	uint32_t len = oscap_model_read_u32(reader);
+	if (len == 0)
+		return NULL;
+	const uint8_t *data = oscap_model_read(reader, len - 1);
+	if (data == NULL)
+		return NULL;
+	char *str = malloc(len);
+	if (str == NULL) {
+		reader->failed = true;
+		return NULL;
+	}
+	memcpy(str, data, len - 1);
+	str[len - 1] = '\0';
+	return str;
+}
+
+size_t oscap_model_read_count(struct oscap_model_reader *reader)
+{
+	uint32_t count = oscap_model_read_u32(reader);
+	// every element takes at least one byte
+	if (count > reader->size - reader->pos) {
+		reader->failed = true;
+		return 0;
+	}
+	return count;
+}
+
+void oscap_model_write_list(struct oscap_model_writer *writer, const struct oscap_list *list, oscap_model_write_func write_item)
+{
+	if (list == NULL) {
+		oscap_model_write_u32(writer, 0);
+		return;
+	}
+	oscap_model_write_u32(writer, (uint32_t)list->itemcount);
+	for (struct oscap_list_item *it = list->first; it != NULL; it = it->next)
+		write_item(writer, it->data);
+}
+
+void oscap_model_read_list(struct oscap_model_reader *reader, struct oscap_list *list, oscap_model_read_func read_item)
+{
+	size_t count = oscap_model_read_count(reader);
+	for (size_t i = 0; i < count && !reader->failed; ++i) {
+		void *item = read_item(reader);
+		if (item == NULL)
+			reader->failed = true;
+		else
+			oscap_list_add(list, item);
+	}
+}
+
+void oscap_model_write_string_item(struct oscap_model_writer *writer, const void *str)
+{
+	oscap_model_write_string(writer, str);
+}
+
+void *oscap_model_read_string_item(struct oscap_model_reader *reader)
+{
+	return oscap_model_read_string(reader);
+}
+
+#ifdef OS_WINDOWS
+
+bool oscap_model_cache_enabled(void)
+{
+	return false;
+}
+
+struct oscap_model_reader *oscap_model_cache_open(const char *kind, uint32_t version, const char *key)
+{
+	return NULL;
+}
+
+int oscap_model_cache_close(struct oscap_model_reader *reader)
+{
+	return -1;
+}
+
+void oscap_model_cache_store(const char *kind, uint32_t version, const char *key, const struct oscap_model_writer *writer)
+{
+}
+
+#else
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "debug_priv.h"
+#include "oscap_helpers.h"
+
+#define OSCAP_MODEL_CACHE_MAGIC "OSCAPMC1"
+// detects records written on a host with another byte order
+#define OSCAP_MODEL_CACHE_BOM 0x01020304u
+
+static pthread_once_t oscap_model_cache_once = PTHREAD_ONCE_INIT;
+static char *oscap_model_cache_dir = NULL;
+
+static void oscap_model_cache_init(void)
+{
+	const char *dir = getenv("OSCAP_MODEL_CACHE");
+	if (dir == NULL || *dir == '\0')
+		return;
+
+	if (mkdir(dir, 0700) != 0 && errno != EEXIST) {
+		dW("Can't create the model cache directory '%s': %s.", dir, strerror(errno));
+		return;
+	}
+	oscap_model_cache_dir = strdup(dir);
+}
+
+bool oscap_model_cache_enabled(void)
+{
+	pthread_once(&oscap_model_cache_once, oscap_model_cache_init);
+	return oscap_model_cache_dir != NULL;
+}
+
+static uint64_t oscap_fnv1a64(uint64_t h, const void *data, size_t len)
+{
+	const uint8_t *p = data;
+	for (size_t i = 0; i < len; ++i)
+		h = (h ^ p[i]) * 1099511628211u;
+	return h;
+}
+
+// the key may be longer than a file name, it's verified in the header
+static char *oscap_model_cache_path(const char *kind, const char *key)
+{
+	uint64_t h = oscap_fnv1a64(14695981039346656037u, key, strlen(key));
+	return oscap_sprintf("%s/%s-%016" PRIx64 ".model", oscap_model_cache_dir, kind, h);
+}
+
+static void oscap_model_cache_write_header(struct oscap_model_writer *writer, const char *kind, uint32_t version,
+		const char *key, const struct oscap_model_writer *model)
+{
+	oscap_model_write(writer, OSCAP_MODEL_CACHE_MAGIC, 8);
+	oscap_model_write_u32(writer, OSCAP_MODEL_CACHE_BOM);
+	oscap_model_write_u32(writer, version);
+	oscap_model_write_string(writer, OPENSCAP_VERSION);
+	oscap_model_write_string(writer, kind);
+	oscap_model_write_string(writer, key);
+	oscap_model_write_i64(writer, (int64_t)model->size);
+	oscap_model_write_i64(writer, (int64_t)oscap_fnv1a64(14695981039346656037u, model->data, model->size));
+}
+
+static bool oscap_model_cache_read_string_eq(struct oscap_model_reader *reader, const char *expected)
+{
+	char *str = oscap_model_read_string(reader);
+	bool ret = str != NULL && strcmp(str, expected) == 0;
+	free(str);
+	return ret;
+}
+
+static bool oscap_model_cache_check_header(struct oscap_model_reader *reader, const char *kind, uint32_t version, const char *key)
+{
+	const uint8_t *magic = oscap_model_read(reader, 8);
+	if (magic == NULL || memcmp(magic, OSCAP_MODEL_CACHE_MAGIC, 8) != 0)
+		return false;
+	if (oscap_model_read_u32(reader) != OSCAP_MODEL_CACHE_BOM || oscap_model_read_u32(reader) != version)
+		return false;
+	if (!oscap_model_cache_read_string_eq(reader, OPENSCAP_VERSION)
+	    || !oscap_model_cache_read_string_eq(reader, kind)
+	    || !oscap_model_cache_read_string_eq(reader, key))
+		return false;
+
+	uint64_t size = (uint64_t)oscap_model_read_i64(reader);
+	uint64_t check = (uint64_t)oscap_model_read_i64(reader);
+	if (reader->failed || size != reader->size - reader->pos)
+		return false;
+	return check == oscap_fnv1a64(14695981039346656037u, reader->data + reader->pos, size);
+}
+
+struct oscap_model_reader *oscap_model_cache_open(const char *kind, uint32_t version, const char *key)
+{
+	struct stat st;
+
+	if (key == NULL || !oscap_model_cache_enabled())
+		return NULL;
+
+	char *path = oscap_model_cache_path(kind, key);
+	int fd = open(path, O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+	if (fd < 0) {
+		if (errno != ENOENT)
+			dW("Can't open the model cache record '%s': %s.", path, strerror(errno));
+		free(path);
+		return NULL;
+	}
+
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_uid != geteuid()
+	    || (st.st_mode & (S_IWGRP | S_IWOTH)) != 0 || st.st_size == 0) {
+		dW("The model cache record '%s' isn't a regular file owned by the current user "
+		   "and writable only by them, ignoring it.", path);
+		close(fd);
+		free(path);
+		return NULL;
+	}
+
+	void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED) {
+		dW("Can't map the model cache record '%s': %s.", path, strerror(errno));
+		free(path);
+		return NULL;
+	}
+
+	struct oscap_model_reader *reader = calloc(1, sizeof(struct oscap_model_reader));
+	if (reader == NULL) {
+		munmap(map, (size_t)st.st_size);
+		free(path);
+		return NULL;
+	}
+	reader->data = map;
+	reader->size = (size_t)st.st_size;
+	reader->map = map;
+	reader->map_size = (size_t)st.st_size;
+
+	if (!oscap_model_cache_check_header(reader, kind, version, key)) {
+		dI("The model cache record '%s' doesn't match the content, it will be replaced.", path);
+		oscap_model_cache_close(reader);
+		free(path);
+		return NULL;
+	}
+	dD("Loading the %s model from the model cache record '%s'.", kind, path);
+	free(path);
+	return reader;
+}
+
+int oscap_model_cache_close(struct oscap_model_reader *reader)
+{
+	if (reader == NULL)
+		return -1;
+	int ret = (reader->failed || reader->pos != reader->size) ? -1 : 0;
+	if (reader->map != NULL)
+		munmap(reader->map, reader->map_size);
+	free(reader);
+	return ret;
+}
+
+static int oscap_model_cache_write_all(int fd, const struct oscap_model_writer *writer)
+{
+	size_t done = 0;
+	while (done < writer->size) {
+		ssize_t ret = write(fd, writer->data + done, writer->size - done);
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+			return -1;
+		}
+		done += (size_t)ret;
+	}
+	return 0;
+}
+
+void oscap_model_cache_store(const char *kind, uint32_t version, const char *key, const struct oscap_model_writer *writer)
+{
+	if (key == NULL || writer == NULL || writer->failed || !oscap_model_cache_enabled())
+		return;
+
+	struct oscap_model_writer *header = oscap_model_writer_new();
+	if (header == NULL)
+		return;
+	oscap_model_cache_write_header(header, kind, version, key, writer);
+
+	char *path = oscap_model_cache_path(kind, key);
+	char *tmp_path = oscap_sprintf("%s.XXXXXX", path);
+	int fd = mkstemp(tmp_path);
+	if (fd < 0) {
+		dW("Can't create the model cache record '%s': %s.", path, strerror(errno));
+		goto cleanup;
+	}
+
+	int ret = header->failed ? -1 : 0;
+	if (ret == 0)
+		ret = oscap_model_cache_write_all(fd, header);
+	if (ret == 0)
+		ret = oscap_model_cache_write_all(fd, writer);
+	if (close(fd) != 0)
+		ret = -1;
+	// the record replaces the old one atomically, readers never see it partially written
+	if (ret == 0)
+		ret = rename(tmp_path, path);
+	if (ret != 0) {
+		dW("Can't write the model cache record '%s': %s.", path, strerror(errno));
+		unlink(tmp_path);
+		goto cleanup;
+	}
+	dD("Stored the %s model to the model cache record '%s'.", kind, path);
+
+cleanup:
+	free(tmp_path);
+	free(path);
+	oscap_model_writer_free(header);
+}
+
+#endif
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2026 Red Hat Inc., Durham, North Carolina.
+ * All Rights Reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef OSCAP_MODEL_CACHE_H
+#define OSCAP_MODEL_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Persistent cache of document models
+ *
+ * Parsing a large document and post-processing its model, e.g. resolving
+ * an XCCDF benchmark, always gives the same model for the same content.
+ * The model is serialized to a record in the directory given by the
+ * OSCAP_MODEL_CACHE environment variable and the record is loaded instead
+ * of the document the next time.
+ *
+ * A record is keyed by the kind of the model and by a string identifying
+ * the content, i.e. its digest, see oscap_source_get_digest(). The record
+ * is used only if its kind, key, format version of the kind and the
+ * OpenSCAP version match and its checksum is right. The caller falls back
+ * to parsing the document otherwise and replaces the record. Records have
+ * to be owned by the effective user and they must not be writable by the
+ * group or others, otherwise they are ignored.
+ */
+struct oscap_model_writer;
+struct oscap_model_reader;
+struct oscap_list;
+
+/*
+ * Check whether the model cache is configured.
+ */
+bool oscap_model_cache_enabled(void);
+
+/*
+ * Map the record of the model and verify its header.
+ * @param kind name of the model, e.g. "xccdf"
+ * @param version format version of the serialized model
+ * @param key digest identifying the content the model was built from
+ * @return reader positioned at the serialized model or NULL if there is
+ * no usable record
+ */
+struct oscap_model_reader *oscap_model_cache_open(const char *kind, uint32_t version, const char *key);
+
+/*
+ * Unmap the record.
+ * @return 0 if the whole record was read without errors, -1 otherwise
+ */
+int oscap_model_cache_close(struct oscap_model_reader *reader);
+
+/*
+ * Atomically replace the record of the model by the data of the writer.
+ */
+void oscap_model_cache_store(const char *kind, uint32_t version, const char *key, const struct oscap_model_writer *writer);
+
+struct oscap_model_writer *oscap_model_writer_new(void);
+void oscap_model_writer_free(struct oscap_model_writer *writer);
+/// Mark the model as not serializable, the writer won't be stored then
+void oscap_model_writer_fail(struct oscap_model_writer *writer);
+
+void oscap_model_write_u32(struct oscap_model_writer *writer, uint32_t value);
+void oscap_model_write_i64(struct oscap_model_writer *writer, int64_t value);
+void oscap_model_write_float(struct oscap_model_writer *writer, float value);
+void oscap_model_write_bool(struct oscap_model_writer *writer, bool value);
+/// NULL is stored as well and read back as NULL
+void oscap_model_write_string(struct oscap_model_writer *writer, const char *str);
+
+/*
+ * Readers return zero values once the reader failed, e.g. when a record
+ * is truncated. A failed reader stays failed, so callers check it once
+ * after reading the whole model.
+ */
+bool oscap_model_reader_failed(const struct oscap_model_reader *reader);
+void oscap_model_reader_fail(struct oscap_model_reader *reader);
+
+uint32_t oscap_model_read_u32(struct oscap_model_reader *reader);
+int64_t oscap_model_read_i64(struct oscap_model_reader *reader);
+float oscap_model_read_float(struct oscap_model_reader *reader);
+bool oscap_model_read_bool(struct oscap_model_reader *reader);
+/// @return newly allocated string or NULL
+char *oscap_model_read_string(struct oscap_model_reader *reader);
+/// Read a count of following elements, fails if the record can't hold them
+size_t oscap_model_read_count(struct oscap_model_reader *reader);
+
+typedef void (*oscap_model_write_func)(struct oscap_model_writer *writer, const void *item);
+/// @return newly allocated item or NULL, which fails the reader
+typedef void *(*oscap_model_read_func)(struct oscap_model_reader *reader);
+
+/// Write the count of items and the items, NULL list is written as empty
+void oscap_model_write_list(struct oscap_model_writer *writer, const struct oscap_list *list, oscap_model_write_func write_item);
+/// Append the items written by oscap_model_write_list() to the list
+void oscap_model_read_list(struct oscap_model_reader *reader, struct oscap_list *list, oscap_model_read_func read_item);
+
+/// Item functions for lists of strings
+void oscap_model_write_string_item(struct oscap_model_writer *writer, const void *str);
+void *oscap_model_read_string_item(struct oscap_model_reader *reader);
+
+#endif
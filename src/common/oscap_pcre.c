@@ -0,0 +1,540 @@
+/*
+ * Copyright 2026 Red Hat Inc., Durham, North Carolina.
+ * All Rights Reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(HAVE_PCRE2)
+#define PCRE2_CODE_UNIT_WIDTH 8
+#include <pcre2.h>
+#else
+#include <pcre.h>
+#endif
+
+#include "oscap_pcre.h"
+#include "list.h"
+#include "util.h"
+#include "oscap_helpers.h"
+#include "debug_priv.h"
+
+#define OSCAP_PCRE_EXEC_RECURSION_LIMIT_DEFAULT 3500
+#define OSCAP_PCRE_ERRBUF_SIZE 256
+
+/* options which make a difference at compile time, i.e. the cache key */
+#define OSCAP_PCRE_OPTS_COMPILE_MASK (OSCAP_PCRE_OPTS_UTF8 | OSCAP_PCRE_OPTS_MULTILINE \
+				      | OSCAP_PCRE_OPTS_DOTALL | OSCAP_PCRE_OPTS_CASELESS \
+				      | OSCAP_PCRE_OPTS_PARTIAL)
+
+/*
+ * The same patterns are matched over and over during a scan, e.g. a state
+ * with the pattern match operation is compared with every collected item.
+ * Compiled and JIT compiled patterns are kept in a process wide cache and
+ * shared by all the threads. Patterns which don't fit are compiled each
+ * time they're requested.
+ */
+#define OSCAP_PCRE_CACHE_HSIZE 1021
+#define OSCAP_PCRE_CACHE_MAX   4096
+
+#if defined(HAVE_PCRE2)
+/* what pcre2_match() needs besides the expression */
+struct oscap_pcre_match {
+	pcre2_match_data *data;
+	pcre2_match_context *ctx;
+};
+#endif
+
+struct oscap_pcre {
+	uint32_t refs;
+#if defined(HAVE_PCRE2)
+	pcre2_code *re;
+	/* Kept for the next match, a thread takes it over for the time of the
+	 * match. Concurrent matches of a shared expression allocate their own. */
+	struct oscap_pcre_match *match;
+#else
+	pcre *re;
+	pcre_extra *extra;
+#endif
+};
+
+static pthread_mutex_t oscap_pcre_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+static struct oscap_htable *oscap_pcre_cache = NULL; /* options:pattern -> oscap_pcre_t */
+static unsigned long oscap_pcre_cache_hits = 0;
+static unsigned long oscap_pcre_cache_misses = 0;
+
+#if defined(HAVE_PCRE2)
+static uint32_t oscap_pcre_compile_opts(oscap_pcre_options_t options)
+{
+	uint32_t res = 0;
+
+	if (options & OSCAP_PCRE_OPTS_UTF8)
+		res |= PCRE2_UTF;
+	if (options & OSCAP_PCRE_OPTS_MULTILINE)
+		res |= PCRE2_MULTILINE;
+	if (options & OSCAP_PCRE_OPTS_DOTALL)
+		res |= PCRE2_DOTALL;
+	if (options & OSCAP_PCRE_OPTS_CASELESS)
+		res |= PCRE2_CASELESS;
+
+	return res;
+}
+
+static uint32_t oscap_pcre_exec_opts(oscap_pcre_options_t options)
+{
+	uint32_t res = 0;
+
+	if (options & OSCAP_PCRE_OPTS_NO_UTF8_CHECK)
+		res |= PCRE2_NO_UTF_CHECK;
+	if (options & OSCAP_PCRE_OPTS_PARTIAL)
+		res |= PCRE2_PARTIAL_SOFT;
+
+	return res;
+}
+
+/* translate the PCRE2 return codes to the PCRE ones */
+static int oscap_pcre_rc(int rc)
+{
+	if (rc >= 0)
+		return rc;
+
+	switch (rc) {
+	case PCRE2_ERROR_NOMATCH:
+		return OSCAP_PCRE_ERR_NOMATCH;
+	case PCRE2_ERROR_PARTIAL:
+		return OSCAP_PCRE_ERR_PARTIAL;
+	case PCRE2_ERROR_DEPTHLIMIT:
+		return OSCAP_PCRE_ERR_RECURSIONLIMIT;
+	default:
+		dD("pcre2_match() returned error: %d.", rc);
+		return OSCAP_PCRE_ERR_UNKNOWN;
+	}
+}
+
+static void oscap_pcre_match_free(struct oscap_pcre_match *match)
+{
+	if (match == NULL)
+		return;
+	pcre2_match_data_free(match->data);
+	pcre2_match_context_free(match->ctx);
+	free(match);
+}
+
+static struct oscap_pcre_match *oscap_pcre_match_get(const oscap_pcre_t *opcre)
+{
+	struct oscap_pcre_match *match;
+
+	match = __sync_lock_test_and_set(&((oscap_pcre_t *)opcre)->match, NULL);
+	if (match != NULL)
+		return match;
+
+	match = calloc(1, sizeof(struct oscap_pcre_match));
+	if (match == NULL)
+		return NULL;
+	/* room for all the substrings of the expression */
+	match->data = pcre2_match_data_create_from_pattern(opcre->re, NULL);
+	match->ctx = pcre2_match_context_create(NULL);
+	if (match->data == NULL || match->ctx == NULL) {
+		oscap_pcre_match_free(match);
+		return NULL;
+	}
+	return match;
+}
+
+static void oscap_pcre_match_put(const oscap_pcre_t *opcre, struct oscap_pcre_match *match)
+{
+	if (!__sync_bool_compare_and_swap(&((oscap_pcre_t *)opcre)->match, NULL, match))
+		oscap_pcre_match_free(match);
+}
+#else
+static int oscap_pcre_compile_opts(oscap_pcre_options_t options)
+{
+	int res = 0;
+
+	if (options & OSCAP_PCRE_OPTS_UTF8)
+		res |= PCRE_UTF8;
+	if (options & OSCAP_PCRE_OPTS_MULTILINE)
+		res |= PCRE_MULTILINE;
+	if (options & OSCAP_PCRE_OPTS_DOTALL)
+		res |= PCRE_DOTALL;
+	if (options & OSCAP_PCRE_OPTS_CASELESS)
+		res |= PCRE_CASELESS;
+
+	return res;
+}
+
+static int oscap_pcre_exec_opts(oscap_pcre_options_t options)
+{
+	int res = 0;
+
+	if (options & OSCAP_PCRE_OPTS_NO_UTF8_CHECK)
+		res |= PCRE_NO_UTF8_CHECK;
+	if (options & OSCAP_PCRE_OPTS_PARTIAL)
+		res |= PCRE_PARTIAL;
+
+	return res;
+}
+#endif
+
+oscap_pcre_t *oscap_pcre_compile(const char *pattern, oscap_pcre_options_t options,
+				 char **errptr, int *erroffset)
+{
+	oscap_pcre_t *opcre = calloc(1, sizeof(oscap_pcre_t));
+
+	if (opcre == NULL)
+		return NULL;
+
+	opcre->refs = 1;
+#if defined(HAVE_PCRE2)
+	int errcode;
+	PCRE2_SIZE erroffset2;
+
+	opcre->re = pcre2_compile((PCRE2_SPTR)pattern, PCRE2_ZERO_TERMINATED,
+				  oscap_pcre_compile_opts(options), &errcode, &erroffset2, NULL);
+	if (opcre->re == NULL) {
+		if (errptr != NULL) {
+			PCRE2_UCHAR errbuf[OSCAP_PCRE_ERRBUF_SIZE];
+
+			pcre2_get_error_message(errcode, errbuf, sizeof errbuf);
+			*errptr = strdup((const char *)errbuf);
+		}
+		if (erroffset != NULL)
+			*erroffset = (int)erroffset2;
+	}
+#else
+	const char *errptr1 = NULL;
+	int erroffset1 = 0;
+
+	opcre->re = pcre_compile(pattern, oscap_pcre_compile_opts(options), &errptr1, &erroffset1, NULL);
+	if (opcre->re == NULL) {
+		if (errptr != NULL)
+			*errptr = errptr1 != NULL ? strdup(errptr1) : NULL;
+		if (erroffset != NULL)
+			*erroffset = erroffset1;
+	}
+#endif
+	if (opcre->re == NULL) {
+		free(opcre);
+		return NULL;
+	}
+
+	return opcre;
+}
+
+void oscap_pcre_optimize(oscap_pcre_t *opcre, oscap_pcre_options_t options)
+{
+	if (opcre == NULL)
+		return;
+#if defined(HAVE_PCRE2)
+	uint32_t jit_opts = PCRE2_JIT_COMPLETE;
+	int rc;
+
+	if (options & OSCAP_PCRE_OPTS_PARTIAL)
+		jit_opts |= PCRE2_JIT_PARTIAL_SOFT;
+
+	/* the interpreter is used when JIT isn't available */
+	rc = pcre2_jit_compile(opcre->re, jit_opts);
+	if (rc != 0)
+		dD("pcre2_jit_compile() returned error: %d.", rc);
+#else
+	const char *errptr = NULL;
+	int study_opts = 0;
+
+	if (opcre->extra != NULL)
+		return;
+#if defined(PCRE_STUDY_JIT_COMPILE)
+	study_opts |= PCRE_STUDY_JIT_COMPILE;
+#endif
+#if defined(PCRE_STUDY_JIT_PARTIAL_SOFT_COMPILE)
+	if (options & OSCAP_PCRE_OPTS_PARTIAL)
+		study_opts |= PCRE_STUDY_JIT_PARTIAL_SOFT_COMPILE;
+#endif
+	opcre->extra = pcre_study(opcre->re, study_opts, &errptr);
+	if (errptr != NULL)
+		dD("pcre_study() returned error: %s.", errptr);
+#endif
+}
+
+static int oscap_pcre_exec_limit(const oscap_pcre_t *opcre, const char *subject, int length,
+				 int startoffset, oscap_pcre_options_t options, int *ovector, int ovecsize,
+				 unsigned long limit)
+{
+	int rc;
+
+	if (opcre == NULL)
+		return OSCAP_PCRE_ERR_UNKNOWN;
+#if defined(HAVE_PCRE2)
+	struct oscap_pcre_match *match;
+	pcre2_match_context *mctx = NULL;
+	uint32_t opts = oscap_pcre_exec_opts(options);
+	/* a PCRE ovector has one spare third used as a workspace */
+	int pairs = ovecsize / 3;
+
+	match = oscap_pcre_match_get(opcre);
+	if (match == NULL)
+		return OSCAP_PCRE_ERR_UNKNOWN;
+	if (limit > 0) {
+		mctx = match->ctx;
+		pcre2_set_depth_limit(mctx, limit);
+	}
+
+	rc = pcre2_match(opcre->re, (PCRE2_SPTR)subject, length, startoffset, opts, match->data, mctx);
+	/* the JIT stack is small, the interpreter copes with deeper recursion */
+	if (rc == PCRE2_ERROR_JIT_STACKLIMIT)
+		rc = pcre2_match(opcre->re, (PCRE2_SPTR)subject, length, startoffset,
+				 opts | PCRE2_NO_JIT, match->data, mctx);
+
+	if (rc >= 0 || rc == PCRE2_ERROR_PARTIAL) {
+		PCRE2_SIZE *ov = pcre2_get_ovector_pointer(match->data);
+		uint32_t i, count = pcre2_get_ovector_count(match->data);
+
+		/* PCRE returns 0 when the ovector is too small */
+		if (rc > pairs)
+			rc = 0;
+		for (i = 0; (int)i < pairs; ++i) {
+			bool set = i < count && ov[2 * i] != PCRE2_UNSET;
+
+			ovector[2 * i] = set ? (int)ov[2 * i] : -1;
+			ovector[2 * i + 1] = set ? (int)ov[2 * i + 1] : -1;
+		}
+	}
+
+	oscap_pcre_match_put(opcre, match);
+
+	return oscap_pcre_rc(rc);
+#else
+	pcre_extra extra, *extrap = opcre->extra;
+	int opts = oscap_pcre_exec_opts(options);
+
+	if (limit > 0) {
+		if (extrap != NULL)
+			extra = *extrap;
+		else
+			memset(&extra, 0, sizeof extra);
+		extra.flags |= PCRE_EXTRA_MATCH_LIMIT_RECURSION;
+		extra.match_limit_recursion = limit;
+		extrap = &extra;
+	}
+
+	rc = pcre_exec(opcre->re, extrap, subject, length, startoffset, opts, ovector, ovecsize);
+#if defined(PCRE_ERROR_JIT_STACKLIMIT)
+	/* the JIT stack is small, the interpreter copes with deeper recursion */
+	if (rc == PCRE_ERROR_JIT_STACKLIMIT) {
+		if (extrap != &extra) {
+			extra = *extrap;
+			extrap = &extra;
+		}
+		extra.flags &= ~PCRE_EXTRA_EXECUTABLE_JIT;
+		rc = pcre_exec(opcre->re, extrap, subject, length, startoffset, opts, ovector, ovecsize);
+	}
+#endif
+	return rc;
+#endif
+}
+
+int oscap_pcre_exec(const oscap_pcre_t *opcre, const char *subject, int length,
+		    int startoffset, oscap_pcre_options_t options, int *ovector, int ovecsize)
+{
+	return oscap_pcre_exec_limit(opcre, subject, length, startoffset, options, ovector, ovecsize, 0);
+}
+
+int oscap_pcre_first_char(const oscap_pcre_t *opcre)
+{
+#if defined(HAVE_PCRE2)
+	uint32_t type, fc;
+
+	if (pcre2_pattern_info(opcre->re, PCRE2_INFO_FIRSTCODETYPE, &type) != 0 || type != 1)
+		return -1;
+	if (pcre2_pattern_info(opcre->re, PCRE2_INFO_FIRSTCODEUNIT, &fc) != 0)
+		return -1;
+
+	return (int)fc;
+#else
+	int fb;
+
+	if (pcre_fullinfo(opcre->re, NULL, PCRE_INFO_FIRSTBYTE, &fb) != 0 || fb < 0)
+		return -1;
+
+	return fb;
+#endif
+}
+
+int oscap_pcre_get_substrings(char *str, int *ofs, const oscap_pcre_t *re, int want_substrs, char ***substrings) {
+	int i, ret, rc;
+	int ovector[60], ovector_len = sizeof (ovector) / sizeof (ovector[0]);
+	char **substrs;
+	unsigned long limit = OSCAP_PCRE_EXEC_RECURSION_LIMIT_DEFAULT;
+
+	// todo: max match count check
+
+	for (i = 0; i < ovector_len; ++i) {
+		ovector[i] = -1;
+	}
+
+	char *limit_str = getenv("OSCAP_PCRE_EXEC_RECURSION_LIMIT");
+	if (limit_str != NULL) {
+		unsigned long limit_env;
+		if (sscanf(limit_str, "%lu", &limit_env) == 1) {
+			limit = limit_env;
+		}
+	}
+#if defined(OS_SOLARIS)
+	rc = oscap_pcre_exec_limit(re, str, strlen(str), *ofs, OSCAP_PCRE_OPTS_NO_UTF8_CHECK, ovector, ovector_len, limit);
+#else
+	rc = oscap_pcre_exec_limit(re, str, strlen(str), *ofs, OSCAP_PCRE_OPTS_NONE, ovector, ovector_len, limit);
+#endif
+
+	if (rc < -1) {
+		dE("Function pcre_exec() failed to match a regular expression with return code %d on string '%s'.", rc, str);
+		return rc;
+	} else if (rc == -1) {
+		/* no match */
+		return 0;
+	}
+
+	*ofs = (*ofs == ovector[1]) ? ovector[1] + 1 : ovector[1];
+
+	if (!want_substrs) {
+		/* just report successful match */
+		return 1;
+	}
+
+	ret = 0;
+	if (rc == 0) {
+		/* vector too small */
+		// todo: report partial results
+		rc = ovector_len / 3;
+	}
+
+	substrs = malloc(rc * sizeof (char *));
+	for (i = 0; i < rc; ++i) {
+		int len;
+		char *buf;
+
+		if (ovector[2 * i] == -1) {
+			continue;
+		}
+		len = ovector[2 * i + 1] - ovector[2 * i];
+		buf = malloc(len + 1);
+		memcpy(buf, str + ovector[2 * i], len);
+		buf[len] = '\0';
+		substrs[ret] = buf;
+		++ret;
+	}
+
+	*substrings = substrs;
+
+	return ret;
+}
+
+void oscap_pcre_free(oscap_pcre_t *opcre)
+{
+	if (opcre == NULL || __sync_sub_and_fetch(&opcre->refs, 1) != 0)
+		return;
+#if defined(HAVE_PCRE2)
+	oscap_pcre_match_free(opcre->match);
+	pcre2_code_free(opcre->re);
+#else
+	if (opcre->extra != NULL)
+		pcre_free_study(opcre->extra);
+	pcre_free(opcre->re);
+#endif
+	free(opcre);
+}
+
+void oscap_pcre_err_free(char *err)
+{
+	free(err);
+}
+
+oscap_pcre_t *oscap_pcre_get_cached(const char *pattern, oscap_pcre_options_t options,
+				    char **errptr, int *erroffset)
+{
+	oscap_pcre_t *opcre;
+	char *key;
+
+	options &= OSCAP_PCRE_OPTS_COMPILE_MASK;
+	key = oscap_sprintf("%x:%s", (unsigned int)options, pattern);
+	if (key == NULL)
+		return NULL;
+
+	pthread_mutex_lock(&oscap_pcre_cache_mutex);
+	opcre = oscap_pcre_cache != NULL ? oscap_htable_get(oscap_pcre_cache, key) : NULL;
+	if (opcre != NULL) {
+		__sync_fetch_and_add(&opcre->refs, 1);
+		++oscap_pcre_cache_hits;
+	} else {
+		++oscap_pcre_cache_misses;
+	}
+	pthread_mutex_unlock(&oscap_pcre_cache_mutex);
+
+	if (opcre != NULL) {
+		free(key);
+		return opcre;
+	}
+
+	opcre = oscap_pcre_compile(pattern, options, errptr, erroffset);
+	if (opcre == NULL) {
+		free(key);
+		return NULL;
+	}
+	oscap_pcre_optimize(opcre, options);
+
+	pthread_mutex_lock(&oscap_pcre_cache_mutex);
+	if (oscap_pcre_cache == NULL)
+		oscap_pcre_cache = oscap_htable_new1((oscap_compare_func)strcmp, OSCAP_PCRE_CACHE_HSIZE);
+	/* the pattern isn't cached if another thread was faster or the cache is full */
+	if (oscap_pcre_cache != NULL && oscap_htable_itemcount(oscap_pcre_cache) < OSCAP_PCRE_CACHE_MAX
+	    && oscap_htable_add(oscap_pcre_cache, key, opcre))
+		__sync_fetch_and_add(&opcre->refs, 1);
+	pthread_mutex_unlock(&oscap_pcre_cache_mutex);
+
+	free(key);
+	return opcre;
+}
+
+static void oscap_pcre_cache_free_cb(void *opcre)
+{
+	oscap_pcre_free(opcre);
+}
+
+void oscap_pcre_cache_reset(void)
+{
+	struct oscap_htable *cache;
+
+	pthread_mutex_lock(&oscap_pcre_cache_mutex);
+	cache = oscap_pcre_cache;
+	if (cache != NULL) {
+		dI("Compiled pattern cache: %zu patterns, %lu hits, %lu misses.",
+		   oscap_htable_itemcount(cache), oscap_pcre_cache_hits, oscap_pcre_cache_misses);
+	}
+	oscap_pcre_cache = NULL;
+	oscap_pcre_cache_hits = 0;
+	oscap_pcre_cache_misses = 0;
+	pthread_mutex_unlock(&oscap_pcre_cache_mutex);
+
+	/* the patterns which are being used are freed once released */
+	oscap_htable_free(cache, oscap_pcre_cache_free_cb);
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2026 Red Hat Inc., Durham, North Carolina.
+ * All Rights Reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef OSCAP_PCRE_H_
+#define OSCAP_PCRE_H_
+
+/*
+ * Thin wrapper around the regular expression library. The legacy PCRE
+ * library is used by default, PCRE2 is used when built WITH_PCRE2.
+ * The wrapper follows the PCRE semantics, i.e. the return codes of
+ * oscap_pcre_exec() and the layout of the ovector are the same for
+ * both libraries.
+ */
+
+typedef struct oscap_pcre oscap_pcre_t;
+
+typedef enum {
+	OSCAP_PCRE_OPTS_NONE          = 0x0000,
+	OSCAP_PCRE_OPTS_UTF8          = 0x0001,
+	OSCAP_PCRE_OPTS_MULTILINE     = 0x0002,
+	OSCAP_PCRE_OPTS_DOTALL        = 0x0004,
+	OSCAP_PCRE_OPTS_CASELESS      = 0x0008,
+	OSCAP_PCRE_OPTS_NO_UTF8_CHECK = 0x0010,
+	OSCAP_PCRE_OPTS_PARTIAL       = 0x0020
+} oscap_pcre_options_t;
+
+typedef enum {
+	OSCAP_PCRE_ERR_NOMATCH        = -1,
+	OSCAP_PCRE_ERR_PARTIAL        = -12,
+	OSCAP_PCRE_ERR_BADPARTIAL     = -13,
+	OSCAP_PCRE_ERR_RECURSIONLIMIT = -21,
+	OSCAP_PCRE_ERR_UNKNOWN        = -100
+} oscap_pcre_error_t;
+
+/**
+ * Compile a regular expression.
+ * @param pattern the regular expression
+ * @param options OSCAP_PCRE_OPTS_UTF8, _MULTILINE, _DOTALL and _CASELESS
+ * @param errptr error message on failure, free it with oscap_pcre_err_free()
+ * @param erroffset offset of the error in the pattern on failure
+ * @return compiled expression, NULL on failure
+ */
+oscap_pcre_t *oscap_pcre_compile(const char *pattern, oscap_pcre_options_t options,
+				 char **errptr, int *erroffset);
+
+/**
+ * Get a compiled regular expression from the cache of compiled expressions
+ * shared by the whole process, or compile it and add it to the cache.
+ * The returned expression is already JIT compiled and must not be
+ * modified. Parameters are the same as for oscap_pcre_compile().
+ * @return reference to the compiled expression, release it with
+ *         oscap_pcre_free(), NULL on failure
+ */
+oscap_pcre_t *oscap_pcre_get_cached(const char *pattern, oscap_pcre_options_t options,
+				    char **errptr, int *erroffset);
+
+/**
+ * JIT compile the regular expression. Worth it only for expressions which
+ * are matched many times.
+ * @param options OSCAP_PCRE_OPTS_PARTIAL to JIT compile also the partial
+ *        matching
+ */
+void oscap_pcre_optimize(oscap_pcre_t *opcre, oscap_pcre_options_t options);
+
+/**
+ * Match a compiled regular expression.
+ * @param options OSCAP_PCRE_OPTS_NO_UTF8_CHECK and _PARTIAL
+ * @param ovector vector of offsets of the matched substrings, may be NULL
+ * @param ovecsize size of the ovector, a multiple of 3
+ * @return the same values as pcre_exec(), i.e. number of the matched
+ *         substrings or 0 if the ovector is too small, negative values
+ *         (see oscap_pcre_error_t) when nothing has matched or on errors
+ */
+int oscap_pcre_exec(const oscap_pcre_t *opcre, const char *subject, int length,
+		    int startoffset, oscap_pcre_options_t options, int *ovector, int ovecsize);
+
+/**
+ * Get the first character of all the matched strings.
+ * @return the character, -1 if there's no such single character
+ */
+int oscap_pcre_first_char(const oscap_pcre_t *opcre);
+
+/**
+ * Match a regular expression and return substrings.
+ * Caller is responsible for freeing the returned array.
+ * @param str subject string
+ * @param ofs starting offset in str
+ * @param re compiled regular expression
+ * @param want_substrs if non-zero, substrings will be returned
+ * @param substrings contains returned substrings
+ * @return count of matched substrings, 0 if no match
+ * negative value on failure
+ */
+int oscap_pcre_get_substrings(char *str, int *ofs, const oscap_pcre_t *re, int want_substrs, char ***substrings);
+
+/**
+ * Free a compiled regular expression, or release a reference returned by
+ * oscap_pcre_get_cached().
+ */
+void oscap_pcre_free(oscap_pcre_t *opcre);
+
+/**
+ * Free an error message returned by oscap_pcre_compile().
+ */
+void oscap_pcre_err_free(char *err);
+
+/**
+ * Drop all cached compiled expressions. The number of oscap_pcre_get_cached()
+ * calls served from the cache (hits) and compiling the expression (misses)
+ * since the last reset is logged on the INFO verbosity level. oscap_cleanup()
+ * resets the cache, so the numbers of a scan are logged at its end.
+ */
+void oscap_pcre_cache_reset(void);
+
+#endif /* OSCAP_PCRE_H_ */
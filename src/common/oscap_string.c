@@ -60,6 +60,11 @@ void oscap_string_append_string(struct oscap_string *s, const char *t)
 	oscap_buffer_append_string((struct oscap_buffer*)s,t);
 }
 
+void oscap_string_append_string_len(struct oscap_string *s, const char *t, size_t len)
+{
+	oscap_buffer_append_binary_data((struct oscap_buffer*)s, t, len);
+}
+
 const char *oscap_string_get_cstr(const struct oscap_string *s)
 {
 	return oscap_buffer_get_raw((struct oscap_buffer*)s);
@@ -51,6 +51,14 @@ void oscap_string_append_char(struct oscap_string *s, char c);
  */
 void oscap_string_append_string(struct oscap_string *s, const char *t);
 
+/**
+ * Append the given number of characters at the end of string.
+ * @param s string
+ * @param t to append
+ * @param len number of characters of t to append
+ */
+void oscap_string_append_string_len(struct oscap_string *s, const char *t, size_t len);
+
 /**
  * Get string data as constant pointer to char
  * @param s string
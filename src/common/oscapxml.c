@@ -46,6 +46,7 @@
 #include "util.h"
 #include "list.h"
 #include "elements.h"
+#include "oscap_pcre.h"
 #include "debug_priv.h"
 #include "oscap_source.h"
 #include "oscapxml.h"
@@ -119,6 +120,7 @@ void oscap_init(void)
 void oscap_cleanup(void)
 {
 	oscap_clearerr();
+	oscap_pcre_cache_reset();
 	xsltCleanupGlobals();
 	xmlCleanupParser();
 }
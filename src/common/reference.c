@@ -32,6 +32,7 @@
 #include "reference_priv.h"
 #include "list.h"
 #include "debug_priv.h"
+#include "oscap_model_cache.h"
 
 #define NS_DUBLINCORE BAD_CAST "http://purl.org/dc/elements/1.1/"
 
@@ -79,10 +80,61 @@ void oscap_reference_free(struct oscap_reference *ref)
         free(ref->coverage);
         free(ref->rights);
         free(ref->href);
+        free(ref->text);
+        free(ref->content);
         free(ref);
     }
 }
 
+void oscap_reference_cache_write(struct oscap_model_writer *writer, const void *item)
+{
+    const struct oscap_reference *ref = item;
+    oscap_model_write_string(writer, ref->title);
+    oscap_model_write_string(writer, ref->creator);
+    oscap_model_write_string(writer, ref->subject);
+    oscap_model_write_string(writer, ref->description);
+    oscap_model_write_string(writer, ref->publisher);
+    oscap_model_write_string(writer, ref->contributor);
+    oscap_model_write_string(writer, ref->date);
+    oscap_model_write_string(writer, ref->type);
+    oscap_model_write_string(writer, ref->format);
+    oscap_model_write_string(writer, ref->identifier);
+    oscap_model_write_string(writer, ref->source);
+    oscap_model_write_string(writer, ref->language);
+    oscap_model_write_string(writer, ref->relation);
+    oscap_model_write_string(writer, ref->coverage);
+    oscap_model_write_string(writer, ref->rights);
+    oscap_model_write_bool(writer, ref->is_dublincore);
+    oscap_model_write_string(writer, ref->href);
+    oscap_model_write_string(writer, ref->text);
+    oscap_model_write_string(writer, ref->content);
+}
+
+void *oscap_reference_cache_read(struct oscap_model_reader *reader)
+{
+    struct oscap_reference *ref = oscap_reference_new();
+    ref->title = oscap_model_read_string(reader);
+    ref->creator = oscap_model_read_string(reader);
+    ref->subject = oscap_model_read_string(reader);
+    ref->description = oscap_model_read_string(reader);
+    ref->publisher = oscap_model_read_string(reader);
+    ref->contributor = oscap_model_read_string(reader);
+    ref->date = oscap_model_read_string(reader);
+    ref->type = oscap_model_read_string(reader);
+    ref->format = oscap_model_read_string(reader);
+    ref->identifier = oscap_model_read_string(reader);
+    ref->source = oscap_model_read_string(reader);
+    ref->language = oscap_model_read_string(reader);
+    ref->relation = oscap_model_read_string(reader);
+    ref->coverage = oscap_model_read_string(reader);
+    ref->rights = oscap_model_read_string(reader);
+    ref->is_dublincore = oscap_model_read_bool(reader);
+    ref->href = oscap_model_read_string(reader);
+    ref->text = oscap_model_read_string(reader);
+    ref->content = oscap_model_read_string(reader);
+    return ref;
+}
+
 #define DC_ITEM_TO_DOM(ITEM) do { \
     if (ref->ITEM != NULL) \
         xmlNewTextChild(ref_node, ns_dc, BAD_CAST #ITEM, BAD_CAST ref->ITEM); \
@@ -140,6 +192,10 @@ struct oscap_reference *oscap_reference_new_parse(xmlTextReaderPtr reader)
     xmlNode* ref_node = xmlTextReaderExpand(reader);
 
     ref->href = (char*) xmlGetProp(ref_node, BAD_CAST "href");
+    ref->content = (char*) xmlNodeGetContent(ref_node);
+    for (xmlNode* cur = ref_node->children; cur != NULL && ref->text == NULL; cur = cur->next)
+        if (cur->type == XML_TEXT_NODE || cur->type == XML_CDATA_SECTION_NODE)
+            ref->text = (char*) xmlNodeGetContent(cur);
 
     for (xmlNode* cur = ref_node->children; cur != NULL; cur = cur->next)
 		if (cur->type == XML_ELEMENT_NODE) { ref->is_dublincore = true; break; }
@@ -203,6 +259,8 @@ struct oscap_reference *oscap_reference_clone(const struct oscap_reference *ref)
     DC_ITEM_CLONE(coverage);
     DC_ITEM_CLONE(rights);
     DC_ITEM_CLONE(href);
+    DC_ITEM_CLONE(text);
+    DC_ITEM_CLONE(content);
 
     return new_ref;
 }
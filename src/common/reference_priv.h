@@ -50,10 +50,20 @@ struct oscap_reference {
     char *rights;
     bool is_dublincore;
     char *href;
+    /* the first text node and the whole text of the parsed element, the HTML
+     * report shows them for the references as text() and string() of XPath */
+    char *text;
+    char *content;
 };
 
 xmlNode *oscap_reference_to_dom(struct oscap_reference *ref, xmlNode *parent, xmlDoc *doc, const char *elname);
 struct oscap_reference *oscap_reference_new_parse(xmlTextReaderPtr reader);
 
+struct oscap_model_writer;
+struct oscap_model_reader;
+/// Item functions of the model cache for lists of references, see oscap_model_write_list()
+void oscap_reference_cache_write(struct oscap_model_writer *writer, const void *ref);
+void *oscap_reference_cache_read(struct oscap_model_reader *reader);
+
 #endif // OSCAP_REFERENCE_PRIV_H_
 
@@ -38,6 +38,7 @@
 #include "text_priv.h"
 #include "util.h"
 #include "list.h"
+#include "oscap_model_cache.h"
 #include "oscap_helpers.h"
 
 const char * const OSCAP_LANG_ENGLISH    = "en";
@@ -84,6 +85,31 @@ struct oscap_text *oscap_text_new_full(struct oscap_text_traits traits, const ch
 }
 
 
+void oscap_text_cache_write(struct oscap_model_writer *writer, const void *item)
+{
+    const struct oscap_text *text = item;
+    oscap_model_write_string(writer, text->lang);
+    oscap_model_write_string(writer, text->text);
+    oscap_model_write_bool(writer, text->traits.override_given);
+    oscap_model_write_bool(writer, text->traits.html);
+    oscap_model_write_bool(writer, text->traits.can_override);
+    oscap_model_write_bool(writer, text->traits.can_substitute);
+    oscap_model_write_bool(writer, text->traits.overrides);
+}
+
+void *oscap_text_cache_read(struct oscap_model_reader *reader)
+{
+    struct oscap_text *text = calloc(1, sizeof(struct oscap_text));
+    text->lang = oscap_model_read_string(reader);
+    text->text = oscap_model_read_string(reader);
+    text->traits.override_given = oscap_model_read_bool(reader);
+    text->traits.html = oscap_model_read_bool(reader);
+    text->traits.can_override = oscap_model_read_bool(reader);
+    text->traits.can_substitute = oscap_model_read_bool(reader);
+    text->traits.overrides = oscap_model_read_bool(reader);
+    return text;
+}
+
 struct oscap_text *oscap_text_new(void)
 {
     return oscap_text_new_full(OSCAP_TEXT_TRAITS_PLAIN, NULL, NULL);
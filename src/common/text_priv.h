@@ -75,5 +75,11 @@ bool oscap_textlist_export(struct oscap_text_iterator *texts, xmlTextWriter *wri
 
 char *_xhtml_to_plaintext(const char *xhtml_in);
 
+struct oscap_model_writer;
+struct oscap_model_reader;
+/// Item functions of the model cache for lists of texts, see oscap_model_write_list()
+void oscap_text_cache_write(struct oscap_model_writer *writer, const void *text);
+void *oscap_text_cache_read(struct oscap_model_reader *reader);
+
 
 #endif
@@ -27,23 +27,35 @@
 #include <config.h>
 #endif
 
+#include <stdio.h>
+
 #include "tsort.h"
 
 struct oscap_tsort_context {
 	struct oscap_list *visited;
 	struct oscap_list *cur_stack;
 	struct oscap_list *result;
+	// with the raw pointer comparison the nodes are looked up by their
+	// address instead of scanning the lists above
+	struct oscap_htable *visited_set;
+	struct oscap_htable *stack_set;
 	oscap_tsort_edge_func edge_func;
 	oscap_cmp_func cmp_func;
 	void *userdata;
 };
 
+#define OSCAP_TSORT_KEY_SIZE (2 * sizeof(void *) + 3)
+
 static struct oscap_tsort_context *oscap_tsort_context_new(oscap_tsort_edge_func edge_func, oscap_cmp_func cmp_func, void *userdata)
 {
 	struct oscap_tsort_context *ctx = calloc(1, sizeof(struct oscap_tsort_context));
 	ctx->visited = oscap_list_new();
 	ctx->cur_stack = oscap_list_new();
 	ctx->result = oscap_list_new();
+	if (cmp_func == oscap_ptr_cmp) {
+		ctx->visited_set = oscap_htable_new();
+		ctx->stack_set = oscap_htable_new();
+	}
 	ctx->edge_func = edge_func;
 	ctx->cmp_func = cmp_func;
 	ctx->userdata = userdata;
@@ -56,6 +68,8 @@ static void oscap_tsort_context_free(struct oscap_tsort_context *ctx)
 		oscap_list_free(ctx->visited, NULL);
 		oscap_list_free(ctx->cur_stack, NULL);
 		oscap_list_free(ctx->result, NULL);
+		oscap_htable_free0(ctx->visited_set);
+		oscap_htable_free0(ctx->stack_set);
 		free(ctx);
 	}
 }
@@ -80,14 +94,31 @@ inline static bool oscap_tsort_visit_all(struct oscap_list *nodelist, struct osc
 
 static bool oscap_tsort_visit(void *node, struct oscap_tsort_context* ctx)
 {
-	// loop detection
-	if (oscap_list_contains(ctx->cur_stack, node, ctx->cmp_func)) return false;
+	char key[OSCAP_TSORT_KEY_SIZE];
+
+	if (ctx->visited_set != NULL) {
+		snprintf(key, sizeof(key), "%p", node);
+
+		// loop detection
+		if (oscap_htable_get(ctx->stack_set, key) != NULL) return false;
 
-	// skip already visited node
-	if (oscap_list_contains(ctx->visited, node, ctx->cmp_func)) return true;
+		// skip already visited node
+		if (oscap_htable_get(ctx->visited_set, key) != NULL) return true;
 
-	// mark as visited & update stack
-	oscap_list_add(ctx->visited, node);
+		// mark as visited
+		oscap_htable_add(ctx->visited_set, key, node);
+		oscap_htable_add(ctx->stack_set, key, node);
+	} else {
+		// loop detection
+		if (oscap_list_contains(ctx->cur_stack, node, ctx->cmp_func)) return false;
+
+		// skip already visited node
+		if (oscap_list_contains(ctx->visited, node, ctx->cmp_func)) return true;
+
+		oscap_list_add(ctx->visited, node);
+	}
+
+	// update stack
 	oscap_list_push(ctx->cur_stack, node);
 
 	// visit all next nodes (dependencies)
@@ -96,7 +127,11 @@ static bool oscap_tsort_visit(void *node, struct oscap_tsort_context* ctx)
 	oscap_list_free(next, NULL);
 
 	// update stack & add node to result
-	if (ret) oscap_list_pop(ctx->cur_stack, NULL);
+	if (ret) {
+		oscap_list_pop(ctx->cur_stack, NULL);
+		if (ctx->stack_set != NULL)
+			oscap_htable_detach(ctx->stack_set, key);
+	}
 	oscap_list_add(ctx->result, node);
 
 	return ret;
@@ -25,13 +25,14 @@
 #include <config.h>
 #endif
 
+#include <errno.h>
 #include <fcntl.h>
+#include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 #include <limits.h>
 #include <stdarg.h>
 #include <math.h>
-#include <pcre.h>
 #include <sys/stat.h>
 
 #include "util.h"
@@ -46,10 +47,10 @@
 #else
 #include <libgen.h>
 #include <strings.h>
+#include <unistd.h>
 #endif
 
 #define PATH_SEPARATOR '/'
-#define OSCAP_PCRE_EXEC_RECURSION_LIMIT_DEFAULT 3500
 
 int oscap_string_to_enum(const struct oscap_string_map *map, const char *str)
 {
@@ -361,76 +362,6 @@ char *oscap_path_join(const char *path1, const char *path2)
 	return joined_path;
 }
 
-int oscap_get_substrings(char *str, int *ofs, pcre *re, int want_substrs, char ***substrings) {
-	int i, ret, rc;
-	int ovector[60], ovector_len = sizeof (ovector) / sizeof (ovector[0]);
-	char **substrs;
-
-	// todo: max match count check
-
-	for (i = 0; i < ovector_len; ++i) {
-		ovector[i] = -1;
-	}
-
-	struct pcre_extra extra;
-	extra.match_limit_recursion = OSCAP_PCRE_EXEC_RECURSION_LIMIT_DEFAULT;
-	char *limit_str = getenv("OSCAP_PCRE_EXEC_RECURSION_LIMIT");
-	if (limit_str != NULL) {
-		unsigned long limit;
-		if (sscanf(limit_str, "%lu", &limit) == 1) {
-			extra.match_limit_recursion = limit;
-		}
-	}
-	extra.flags = PCRE_EXTRA_MATCH_LIMIT_RECURSION;
-#if defined(OS_SOLARIS)
-	rc = pcre_exec(re, &extra, str, strlen(str), *ofs, PCRE_NO_UTF8_CHECK, ovector, ovector_len);
-#else
-	rc = pcre_exec(re, &extra, str, strlen(str), *ofs, 0, ovector, ovector_len);
-#endif
-
-	if (rc < -1) {
-		dE("Function pcre_exec() failed to match a regular expression with return code %d on string '%s'.", rc, str);
-		return rc;
-	} else if (rc == -1) {
-		/* no match */
-		return 0;
-	}
-
-	*ofs = (*ofs == ovector[1]) ? ovector[1] + 1 : ovector[1];
-
-	if (!want_substrs) {
-		/* just report successful match */
-		return 1;
-	}
-
-	ret = 0;
-	if (rc == 0) {
-		/* vector too small */
-		// todo: report partial results
-		rc = ovector_len / 3;
-	}
-
-	substrs = malloc(rc * sizeof (char *));
-	for (i = 0; i < rc; ++i) {
-		int len;
-		char *buf;
-
-		if (ovector[2 * i] == -1) {
-			continue;
-		}
-		len = ovector[2 * i + 1] - ovector[2 * i];
-		buf = malloc(len + 1);
-		memcpy(buf, str + ovector[2 * i], len);
-		buf[len] = '\0';
-		substrs[ret] = buf;
-		++ret;
-	}
-
-	*substrings = substrs;
-
-	return ret;
-}
-
 #ifndef OS_WINDOWS
 FILE *oscap_fopen_with_prefix(const char *prefix, const char *path)
 {
@@ -513,3 +444,30 @@ int oscap_open_writable(const char *filename)
 	}
 	return fd;
 }
+
+unsigned oscap_env_worker_count(const char *name, unsigned default_max)
+{
+	const char *workers_str = getenv(name);
+	long workers;
+
+	if (workers_str != NULL) {
+		char *endptr;
+
+		errno = 0;
+		workers = strtol(workers_str, &endptr, 10);
+		if (*workers_str != '\0' && *endptr == '\0' && errno == 0 && workers >= 0)
+			return (unsigned)(workers < OSCAP_WORKERS_MAX ? workers : OSCAP_WORKERS_MAX);
+
+		dW("Invalid value of %s: '%s'", name, workers_str);
+	}
+
+#ifdef _SC_NPROCESSORS_ONLN
+	workers = sysconf(_SC_NPROCESSORS_ONLN);
+#else
+	workers = 1;
+#endif
+	if (workers < 1)
+		workers = 1;
+
+	return (unsigned)workers < default_max ? (unsigned)workers : default_max;
+}
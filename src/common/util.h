@@ -32,7 +32,6 @@
 #include "public/oscap.h"
 #include <stdarg.h>
 #include <string.h>
-#include <pcre.h>
 #include "oscap_export.h"
 
 #ifndef __attribute__nonnull__
@@ -469,19 +468,6 @@ int oscap_strncasecmp(const char *s1, const char *s2, size_t n);
  */
 char *oscap_strerror_r(int errnum, char *buf, size_t buflen);
 
-/**
- * Match a regular expression and return substrings.
- * Caller is responsible for freeing the returned array.
- * @param str subject string
- * @param ofs starting offset in str
- * @param re compiled regular expression
- * @param want_substrs if non-zero, substrings will be returned
- * @param substrings contains returned substrings
- * @return count of matched substrings, 0 if no match
- * negative value on failure
- */
-int oscap_get_substrings(char *str, int *ofs, pcre *re, int want_substrs, char ***substrings);
-
 
 #ifndef OS_WINDOWS
 /**
@@ -536,4 +522,20 @@ char *oscap_windows_error_message(unsigned long error_code);
  */
 int oscap_open_writable(const char *filename);
 
+/* Upper bound of the worker counts set by environment variables */
+#define OSCAP_WORKERS_MAX 64
+
+/**
+ * Get the number of worker threads set by an environment variable.
+ * The value has to be a decimal number. 0 means that no worker threads
+ * are started and the work is done by the calling thread. Values larger
+ * than OSCAP_WORKERS_MAX are reduced to OSCAP_WORKERS_MAX. If the variable
+ * isn't set or its value is invalid, which is reported as a warning, the
+ * default is the number of online CPUs reduced to default_max.
+ * @param name name of the environment variable
+ * @param default_max upper bound of the default number of workers
+ * @return number of worker threads
+ */
+unsigned oscap_env_worker_count(const char *name, unsigned default_max);
+
 #endif              /* OSCAP_UTIL_H_ */
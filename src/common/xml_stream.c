@@ -0,0 +1,363 @@
+/*
+ * Copyright 2026 Red Hat Inc., Durham, North Carolina.
+ * All Rights Reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <ctype.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef OS_WINDOWS
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <libxml/xmlIO.h>
+#include <libxml/xmlsave.h>
+
+#include "_error.h"
+#include "debug_priv.h"
+#include "util.h"
+#include "xml_stream.h"
+
+#define XML_STREAM_ENCODING "UTF-8"
+
+/*
+ * The stream is kept in doc->_private, so the *_to_dom() functions don't
+ * need to pass it around. The elements on the stack have their start tags
+ * written already; the stack always is a path from the root element down.
+ */
+struct oscap_xml_stream {
+	xmlOutputBuffer *out;
+	int fd;
+	xmlNode **open;		///< elements with the start tag written
+	xmlNs **open_nsdefs;	///< last namespace declaration of each open element when it was written
+	size_t depth;
+	size_t capacity;
+	bool failed;
+};
+
+static inline struct oscap_xml_stream *_stream_get(xmlDoc *doc)
+{
+	return doc != NULL ? (struct oscap_xml_stream *) doc->_private : NULL;
+}
+
+static void _stream_indent(struct oscap_xml_stream *stream, size_t level)
+{
+	for (size_t i = 0; i < level; ++i)
+		xmlOutputBufferWrite(stream->out, 2, "  ");
+}
+
+static xmlNs *_last_nsdef(xmlNode *node)
+{
+	xmlNs *ns = node->nsDef;
+	while (ns != NULL && ns->next != NULL)
+		ns = ns->next;
+	return ns;
+}
+
+static void _stream_write_node(struct oscap_xml_stream *stream, xmlDoc *doc, xmlNode *node, size_t level)
+{
+	_stream_indent(stream, level);
+	xmlNodeDumpOutput(stream->out, doc, node, level, 1, XML_STREAM_ENCODING);
+	xmlOutputBufferWrite(stream->out, 1, "\n");
+}
+
+/* Write out and dispose all the children of the node up to the given one. */
+static void _stream_write_children(struct oscap_xml_stream *stream, xmlDoc *doc, xmlNode *parent, xmlNode *until, size_t level)
+{
+	xmlNode *child = parent->children;
+	while (child != NULL && child != until) {
+		xmlNode *next = child->next;
+		_stream_write_node(stream, doc, child, level);
+		xmlUnlinkNode(child);
+		xmlFreeNode(child);
+		child = next;
+	}
+}
+
+static bool _stream_write_start_tag(struct oscap_xml_stream *stream, xmlDoc *doc, xmlNode *node, size_t level)
+{
+	if (stream->depth == stream->capacity) {
+		size_t capacity = stream->capacity ? 2 * stream->capacity : 8;
+		xmlNode **open = realloc(stream->open, capacity * sizeof(xmlNode *));
+		xmlNs **open_nsdefs = realloc(stream->open_nsdefs, capacity * sizeof(xmlNs *));
+		if (open != NULL)
+			stream->open = open;
+		if (open_nsdefs != NULL)
+			stream->open_nsdefs = open_nsdefs;
+		if (open == NULL || open_nsdefs == NULL)
+			return false;
+		stream->capacity = capacity;
+	}
+
+	/* Let libxml2 serialize the element without children, it becomes
+	 * an empty-element tag which is turned into a start tag. */
+	xmlOutputBuffer *tag = xmlAllocOutputBuffer(NULL);
+	if (tag == NULL)
+		return false;
+	xmlNode *children = node->children;
+	xmlNode *last = node->last;
+	node->children = node->last = NULL;
+	xmlNodeDumpOutput(tag, doc, node, 0, 0, XML_STREAM_ENCODING);
+	node->children = children;
+	node->last = last;
+
+	const char *content = (const char *) xmlOutputBufferGetContent(tag);
+	size_t size = xmlOutputBufferGetSize(tag);
+	bool ret = content != NULL && size > 2 && memcmp(content + size - 2, "/>", 2) == 0;
+	if (ret) {
+		_stream_indent(stream, level);
+		xmlOutputBufferWrite(stream->out, size - 2, content);
+		xmlOutputBufferWrite(stream->out, 2, ">\n");
+		stream->open[stream->depth] = node;
+		stream->open_nsdefs[stream->depth] = _last_nsdef(node);
+		stream->depth++;
+	}
+	xmlOutputBufferClose(tag);
+	return ret;
+}
+
+/* Write out the rest of the innermost open element and dispose it. */
+static void _stream_close_element(struct oscap_xml_stream *stream, xmlDoc *doc)
+{
+	size_t level = --stream->depth;
+	xmlNode *node = stream->open[level];
+
+	if (_last_nsdef(node) != stream->open_nsdefs[level]) {
+		dE("Namespace declared on <%s> after its start tag has been written.", node->name);
+		stream->failed = true;
+	}
+
+	_stream_write_children(stream, doc, node, NULL, level + 1);
+	_stream_indent(stream, level);
+	xmlOutputBufferWrite(stream->out, 2, "</");
+	if (node->ns != NULL && node->ns->prefix != NULL) {
+		xmlOutputBufferWriteString(stream->out, (const char *) node->ns->prefix);
+		xmlOutputBufferWrite(stream->out, 1, ":");
+	}
+	xmlOutputBufferWriteString(stream->out, (const char *) node->name);
+	xmlOutputBufferWrite(stream->out, 2, ">\n");
+
+	if (node != xmlDocGetRootElement(doc)) {
+		xmlUnlinkNode(node);
+		xmlFreeNode(node);
+	}
+}
+
+bool oscap_xml_stream_open(xmlDoc *doc, const char *filename)
+{
+	struct oscap_xml_stream *stream = calloc(1, sizeof(struct oscap_xml_stream));
+	if (stream == NULL)
+		return false;
+
+	if (strcmp(filename, "-") == 0) {
+		stream->fd = -1;
+		stream->out = xmlOutputBufferCreateFile(stdout, NULL);
+	} else {
+		stream->fd = oscap_open_writable(filename);
+		if (stream->fd == -1) {
+			free(stream);
+			return false;
+		}
+		stream->out = xmlOutputBufferCreateFd(stream->fd, NULL);
+	}
+	if (stream->out == NULL) {
+		oscap_setxmlerr(xmlGetLastError());
+		dW("xmlOutputBufferCreateFd() failed.");
+		if (stream->fd != -1)
+			close(stream->fd);
+		free(stream);
+		return false;
+	}
+
+	xmlOutputBufferWriteString(stream->out, "<?xml version=\"1.0\" encoding=\"" XML_STREAM_ENCODING "\"?>\n");
+	doc->_private = stream;
+	return true;
+}
+
+/* Write out everything which precedes the children of the parent and the
+ * start tags of the parent and its ancestors. Returns the depth of the parent
+ * or 0 on failure. */
+static size_t _stream_open_path(struct oscap_xml_stream *stream, xmlDoc *doc, xmlNode *parent)
+{
+	/* The path from the root element down to the parent */
+	size_t length = 0;
+	for (xmlNode *node = parent; node != NULL && node->type == XML_ELEMENT_NODE; node = node->parent)
+		length++;
+	xmlNode *path[length];
+	size_t i = length;
+	for (xmlNode *node = parent; i > 0; node = node->parent)
+		path[--i] = node;
+
+	/* Elements which are not on the path are complete */
+	while (i < stream->depth && i < length && stream->open[i] == path[i])
+		i++;
+	while (stream->depth > i)
+		_stream_close_element(stream, doc);
+
+	for (; i < length; ++i) {
+		if (i > 0)
+			_stream_write_children(stream, doc, path[i - 1], path[i], i);
+		if (!_stream_write_start_tag(stream, doc, path[i], i)) {
+			oscap_seterr(OSCAP_EFAMILY_OSCAP, "Failed to write start tag of <%s>.", path[i]->name);
+			stream->failed = true;
+			return 0;
+		}
+	}
+	return length;
+}
+
+void oscap_xml_stream_flush(xmlDoc *doc, xmlNode *parent)
+{
+	struct oscap_xml_stream *stream = _stream_get(doc);
+	if (stream == NULL || stream->failed || parent->children == NULL)
+		return;
+
+	size_t level = _stream_open_path(stream, doc, parent);
+	if (level > 0)
+		_stream_write_children(stream, doc, parent, NULL, level);
+}
+
+/* Find the root element of a document written by libxml2, i.e. skip the XML
+ * declaration. Anything else in the prolog can't be embedded in an element. */
+static bool _find_root_element(const char *buffer, size_t size, size_t *offset)
+{
+	size_t i = 0;
+	if (size >= 5 && memcmp(buffer, "<?xml", 5) == 0) {
+		const char *end = memchr(buffer, '>', size);
+		if (end == NULL)
+			return false;
+		/* Only UTF-8 can be copied as it is */
+		for (const char *c = buffer; c + 15 < end; ++c) {
+			if (memcmp(c, "encoding=", 9) == 0 && oscap_strncasecmp(c + 10, "UTF-8", 5) != 0)
+				return false;
+		}
+		i = end - buffer + 1;
+	}
+	while (i < size && isspace((unsigned char) buffer[i]))
+		i++;
+	if (i + 1 >= size || buffer[i] != '<' || buffer[i + 1] == '!' || buffer[i + 1] == '?')
+		return false;
+	*offset = i;
+	return true;
+}
+
+bool oscap_xml_stream_copy_file(xmlDoc *doc, xmlNode *parent, const char *filename)
+{
+	struct oscap_xml_stream *stream = _stream_get(doc);
+	if (stream == NULL || stream->failed)
+		return false;
+
+	FILE *f = fopen(filename, "rb");
+	if (f == NULL) {
+		dD("Can't open '%s' to embed it: %s", filename, strerror(errno));
+		return false;
+	}
+
+	/* The document ends by the end tag of the root element, anything
+	 * after that is whitespace. */
+	char buffer[65536];
+	long end = -1;
+	if (fseek(f, 0, SEEK_END) == 0) {
+		long size = ftell(f);
+		long tail = size < (long) sizeof(buffer) ? size : (long) sizeof(buffer);
+		if (tail > 0 && fseek(f, size - tail, SEEK_SET) == 0 && fread(buffer, 1, tail, f) == (size_t) tail) {
+			long i = tail;
+			while (i > 0 && buffer[i - 1] != '>')
+				i--;
+			if (i > 0)
+				end = size - tail + i;
+		}
+	}
+
+	size_t start = 0;
+	size_t read = 0;
+	if (end < 0 || fseek(f, 0, SEEK_SET) != 0 ||
+			(read = fread(buffer, 1, sizeof(buffer), f)) == 0 ||
+			!_find_root_element(buffer, read, &start) || (long) start >= end) {
+		dD("Can't embed '%s', it will be parsed.", filename);
+		fclose(f);
+		return false;
+	}
+
+	size_t level = _stream_open_path(stream, doc, parent);
+	if (level == 0) {
+		fclose(f);
+		return false;
+	}
+	_stream_write_children(stream, doc, parent, NULL, level);
+	_stream_indent(stream, level);
+
+	long position = 0;
+	while (read > 0 && position < end) {
+		size_t count = read - start;
+		if (position + (long) read > end)
+			count = end - position - start;
+		xmlOutputBufferWrite(stream->out, count, buffer + start);
+		position += read;
+		start = 0;
+		read = fread(buffer, 1, sizeof(buffer), f);
+	}
+	xmlOutputBufferWrite(stream->out, 1, "\n");
+	if (position < end) {
+		oscap_seterr(OSCAP_EFAMILY_GLIBC, "Failed to read '%s'.", filename);
+		stream->failed = true;
+	}
+	fclose(f);
+	return true;
+}
+
+int oscap_xml_stream_close(xmlDoc *doc)
+{
+	struct oscap_xml_stream *stream = _stream_get(doc);
+	if (stream == NULL)
+		return -1;
+	doc->_private = NULL;
+
+	if (!stream->failed) {
+		if (stream->depth == 0) {
+			xmlNode *root = xmlDocGetRootElement(doc);
+			if (root != NULL)
+				_stream_write_node(stream, doc, root, 0);
+		}
+		while (stream->depth > 0)
+			_stream_close_element(stream, doc);
+	}
+
+	int written = xmlOutputBufferClose(stream->out);
+	if (stream->fd != -1)
+		close(stream->fd);
+	bool failed = stream->failed || written < 0;
+	free(stream->open);
+	free(stream->open_nsdefs);
+	free(stream);
+
+	if (failed) {
+		if (written < 0)
+			oscap_setxmlerr(xmlGetLastError());
+		dW("Streaming export of the document failed.");
+		return -1;
+	}
+	return 1;
+}
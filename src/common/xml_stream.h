@@ -0,0 +1,79 @@
+/*
+ * Copyright 2026 Red Hat Inc., Durham, North Carolina.
+ * All Rights Reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#pragma once
+#ifndef _OSCAP_XML_STREAM_H
+#define _OSCAP_XML_STREAM_H
+
+#include <stdbool.h>
+#include <libxml/tree.h>
+
+/*
+ * Streaming export of documents built by the *_to_dom() functions.
+ *
+ * Once oscap_xml_stream_open() is called on an empty document, the document
+ * is built by the usual *_to_dom() functions. Those call
+ * oscap_xml_stream_flush() whenever they append a complete child to a large
+ * container element. The children are then written to the file and removed
+ * from the document, so the whole DOM never exists in memory at once. The
+ * output is the same as the one of oscap_xml_save_filename().
+ *
+ * The builder must not modify the start tag (attributes, namespace
+ * declarations) of an element once a descendant of it has been flushed, and
+ * it must not use nodes which precede the flushed element in document order.
+ */
+
+/**
+ * Start streaming the document to the file.
+ * @param doc an empty document
+ * @param filename path to the file, "-" for standard output
+ * @returns true on success, false otherwise (oscap_seterr is set)
+ */
+bool oscap_xml_stream_open(xmlDoc *doc, const char *filename);
+
+/**
+ * Write out the children of the element and everything that precedes them.
+ * Does nothing when the document is not being streamed.
+ * @param doc the document
+ * @param parent the element whose children are complete
+ */
+void oscap_xml_stream_flush(xmlDoc *doc, xmlNode *parent);
+
+/**
+ * Write out the children of the element followed by the root element of an
+ * XML document stored in the file. The file is copied as it is, it's not
+ * parsed. Nothing is written when the file is not a UTF-8 document with just
+ * an XML declaration in its prolog, as oscap_xml_save_filename() writes it.
+ * @param doc the document
+ * @param parent the element to embed the file into
+ * @param filename path to the document to embed
+ * @returns true if the file has been embedded, false otherwise
+ */
+bool oscap_xml_stream_copy_file(xmlDoc *doc, xmlNode *parent, const char *filename);
+
+/**
+ * Write out the rest of the document and close the file. The document
+ * itself has to be freed by the caller.
+ * @param doc the document passed to oscap_xml_stream_open()
+ * @returns 1 on success, -1 on failure (oscap_seterr is set), the same as
+ * oscap_xml_save_filename().
+ */
+int oscap_xml_stream_close(xmlDoc *doc);
+
+#endif
@@ -30,6 +30,9 @@ int xmlTextReaderNextElement(xmlTextReaderPtr reader)
 {
 	__attribute__nonnull__(reader);
 
+	if (xmlTextReaderReadState(reader) == XML_TEXTREADER_MODE_ERROR)
+		return -1;
+
 	int ret;
 	do {
 		ret = xmlTextReaderRead(reader);
@@ -50,6 +53,11 @@ int xmlTextReaderNextNode(xmlTextReaderPtr reader)
 {
 	__attribute__nonnull__(reader);
 
+	// the reader goes on with the nodes it has already parsed after an error,
+	// the parsers must not see them
+	if (xmlTextReaderReadState(reader) == XML_TEXTREADER_MODE_ERROR)
+		return -1;
+
 	int ret = xmlTextReaderRead(reader);
 	if (ret == -1)
 		oscap_setxmlerr(xmlGetLastError());
@@ -61,6 +69,9 @@ int xmlTextReaderNextElementWE(xmlTextReaderPtr reader, xmlChar* end_tag)
 {
 	__attribute__nonnull__(reader);
 
+	if (xmlTextReaderReadState(reader) == XML_TEXTREADER_MODE_ERROR)
+		return -1;
+
 	int ret;
 	do {
 		ret = xmlTextReaderRead(reader);
@@ -83,3 +94,12 @@ int xmlTextReaderNextElementWE(xmlTextReaderPtr reader, xmlChar* end_tag)
 
 	return ret;
 }
+
+bool xmlTextReaderFailed(xmlTextReaderPtr reader)
+{
+	__attribute__nonnull__(reader);
+
+	// the EOF state only means the whole input has been parsed, the reader
+	// still has nodes to go through
+	return xmlTextReaderReadState(reader) == XML_TEXTREADER_MODE_ERROR;
+}
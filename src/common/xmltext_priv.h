@@ -37,9 +37,11 @@
 int xmlTextReaderNextElement(xmlTextReaderPtr reader);
 
 /**
- * Function testing reader function
+ * Function testing reader function. Once the reader failed, it keeps
+ * returning -1, unlike xmlTextReaderRead() which goes on with the nodes
+ * parsed before the error. Parsers read through this function.
  * @param reader xmlTextReader
- * @returns zero on success
+ * @returns 1 on success, 0 at the end of the document, -1 on error
  */
 int xmlTextReaderNextNode(xmlTextReaderPtr reader);
 
@@ -52,5 +54,13 @@ int xmlTextReaderNextNode(xmlTextReaderPtr reader);
  */
 int xmlTextReaderNextElementWE(xmlTextReaderPtr reader, xmlChar* end_tag);
 
+/**
+ * Function testing whether the reader failed on an XML error. A failed reader
+ * stays on its last node, so loops looking for an element have to check this.
+ * @param reader xmlTextReader
+ * @returns true if the reader can't move any further
+ */
+bool xmlTextReaderFailed(xmlTextReaderPtr reader);
+
 
 #endif
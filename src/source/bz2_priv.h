@@ -28,6 +28,7 @@
 #include "common/public/oscap.h"
 #include "common/util.h"
 #include <libxml/tree.h>
+#include <libxml/xmlreader.h>
 
 
 #ifdef BZIP2_FOUND
@@ -47,6 +48,23 @@ xmlDoc *bz2_fd_read_doc(int fd);
  */
 xmlDoc *bz2_mem_read_doc(const char *buffer, size_t size);
 
+/**
+ * Open a streaming reader of *.xml.bz2 file. The reader takes over
+ * the file descriptor and closes it when it is freed.
+ * @param fd The file descriptor to bz2 file
+ * @returns reader of the decompressed XML, NULL on failure
+ */
+xmlTextReader *bz2_fd_read_reader(int fd);
+
+/**
+ * Open a streaming reader of bzip2ed memory. The memory has to stay
+ * valid until the reader is freed.
+ * @param buffer data in memory to process (contains bzip2ed XML)
+ * @param size length of data
+ * @returns reader of the decompressed XML, NULL on failure
+ */
+xmlTextReader *bz2_mem_read_reader(const char *buffer, size_t size);
+
 #endif // BZIP2_FOUND
 
 /**
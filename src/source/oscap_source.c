@@ -24,6 +24,9 @@
 #include <config.h>
 #endif
 
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <fcntl.h>
 #ifdef OS_WINDOWS
@@ -40,6 +43,7 @@
 #include "common/debug_priv.h"
 #include "common/public/oscap.h"
 #include "common/util.h"
+#include "common/oscap_file_cache.h"
 #include "CPE/public/cpe_lang.h"
 #include "CPE/cpedict_priv.h"
 #include "CPE/cpelang_priv.h"
@@ -54,7 +58,12 @@
 #include "source/validate_priv.h"
 #include "XCCDF/elements.h"
 #include "XCCDF/public/xccdf_benchmark.h"
+#include "DS/ds_common.h"
 #include "DS/sds_priv.h"
+#if !defined(OS_WINDOWS) && (defined(HAVE_GCRYPT) || defined(HAVE_NSS3))
+#include <pthread.h>
+#include "OVAL/probes/crapi/crapi.h"
+#endif
 
 typedef enum oscap_source_type {
 	OSCAP_SRC_FROM_USER_XML_FILE = 1,               ///< The source originated from XML file supplied by user
@@ -74,7 +83,15 @@ struct oscap_source {
 	} origin;                                       ///
 	struct {
 		xmlDoc *doc;                            /// DOM
+		xmlNode *foreign_node;                  ///< Root of the DOM not copied from its parent yet
+		xmlDoc *foreign_doc;                    ///< Parent document of the foreign_node (not owned)
 	} xml;
+	struct {
+		char *value;                            ///< Digest of the content, see oscap_source_get_digest()
+		struct stat st;                         ///< Status of the file when it was read for the first time
+		bool st_valid;                          ///< The status has been taken
+		bool changed;                           ///< The file changed since then
+	} digest;
 };
 
 struct oscap_source *oscap_source_new_from_file(const char *filepath)
@@ -97,7 +114,15 @@ struct oscap_source *oscap_source_clone(struct oscap_source *old)
 	new->origin.filepath = oscap_strdup(old->origin.filepath);
 	new->origin.memory = oscap_strdup(old->origin.memory);
 	new->origin.memory_size = old->origin.memory_size;
+	if (old->xml.foreign_node != NULL) {
+		// the clone may outlive the parent document of the foreign node
+		oscap_source_get_xmlDoc(old);
+	}
 	new->xml.doc = xmlCopyDoc(old->xml.doc, true);
+	new->digest.value = oscap_strdup(old->digest.value);
+	new->digest.st = old->digest.st;
+	new->digest.st_valid = old->digest.st_valid;
+	new->digest.changed = old->digest.changed;
 	return new;
 }
 
@@ -140,6 +165,14 @@ struct oscap_source *oscap_source_new_from_xmlDoc(xmlDoc *doc, const char *filep
 	return source;
 }
 
+struct oscap_source *oscap_source_new_from_foreign_node(xmlNode *node, xmlDoc *parent, const char *filepath)
+{
+	struct oscap_source *source = oscap_source_new_from_xmlDoc(NULL, filepath);
+	source->xml.foreign_node = node;
+	source->xml.foreign_doc = parent;
+	return source;
+}
+
 void oscap_source_free(struct oscap_source *source)
 {
 	if (source != NULL) {
@@ -149,6 +182,7 @@ void oscap_source_free(struct oscap_source *source)
 			xmlFreeDoc(source->xml.doc);
 		}
 		free(source->origin.version);
+		free(source->digest.value);
 		free(source);
 	}
 }
@@ -163,20 +197,6 @@ const char *oscap_source_readable_origin(const struct oscap_source *source)
 	return source->origin.filepath;
 }
 
-xmlTextReader *oscap_source_get_xmlTextReader(struct oscap_source *source)
-{
-	xmlDoc *doc = oscap_source_get_xmlDoc(source);
-	if (doc == NULL) {
-		return NULL;
-	}
-	xmlTextReader *reader = xmlReaderWalker(doc);
-	if (reader == NULL) {
-		oscap_seterr(OSCAP_EFAMILY_XML, "Unable to create xmlTextReader for %s", oscap_source_readable_origin(source));
-		oscap_setxmlerr(xmlGetLastError());
-	}
-	return reader;
-}
-
 oscap_document_type_t oscap_source_get_scap_type(struct oscap_source *source)
 {
 	if (source->scap_type == OSCAP_DOCUMENT_UNKNOWN) {
@@ -200,6 +220,104 @@ const char *oscap_source_get_filepath(struct oscap_source *source)
 	return source->origin.filepath;
 }
 
+bool oscap_source_is_unparsed_file(const struct oscap_source *source)
+{
+	return source->origin.type == OSCAP_SRC_FROM_USER_XML_FILE && source->xml.doc == NULL;
+}
+
+/**
+ * Open the file of the source. The file is read several times, e.g. to
+ * detect its type, to validate it and to parse it, and the digest can't be
+ * trusted when it changes between the reads.
+ */
+static int oscap_source_open_file(struct oscap_source *source)
+{
+	struct stat st;
+
+	int fd = open(source->origin.filepath, O_RDONLY);
+	if (fd == -1 || fstat(fd, &st) != 0)
+		return fd;
+
+	if (!source->digest.st_valid) {
+		source->digest.st = st;
+		source->digest.st_valid = true;
+	} else if (st.st_dev != source->digest.st.st_dev || st.st_ino != source->digest.st.st_ino
+	           || !oscap_file_stat_unchanged(&st, &source->digest.st)) {
+		source->digest.changed = true;
+	}
+	return fd;
+}
+
+#if !defined(OS_WINDOWS) && (defined(HAVE_GCRYPT) || defined(HAVE_NSS3))
+static pthread_once_t oscap_source_crapi_once = PTHREAD_ONCE_INIT;
+static int oscap_source_crapi_ret = -1;
+
+static void oscap_source_crapi_init(void)
+{
+	oscap_source_crapi_ret = crapi_init(NULL);
+}
+
+static char *oscap_source_compute_digest(struct oscap_source *source)
+{
+	unsigned char digest[32];
+	size_t digest_size = sizeof(digest);
+	struct stat st;
+
+	pthread_once(&oscap_source_crapi_once, oscap_source_crapi_init);
+	if (oscap_source_crapi_ret != 0)
+		return NULL;
+
+	int fd = oscap_source_open_file(source);
+	if (fd == -1)
+		return NULL;
+	int ret = crapi_digest_fd(fd, CRAPI_DIGEST_SHA256, digest, &digest_size);
+	// the file changed while it was read
+	if (fstat(fd, &st) != 0 || !oscap_file_stat_unchanged(&st, &source->digest.st))
+		source->digest.changed = true;
+	close(fd);
+	if (ret != 0 || source->digest.changed)
+		return NULL;
+
+	char *value = malloc(strlen("sha256:") + 2 * digest_size + 1);
+	char *p = value + sprintf(value, "sha256:");
+	for (size_t i = 0; i < digest_size; ++i)
+		p += sprintf(p, "%02x", digest[i]);
+	return value;
+}
+#else
+static char *oscap_source_compute_digest(struct oscap_source *source)
+{
+	return NULL;
+}
+#endif
+
+const char *oscap_source_get_digest(struct oscap_source *source)
+{
+	if (source->digest.value == NULL && source->origin.type == OSCAP_SRC_FROM_USER_XML_FILE
+	    && source->origin.memory == NULL)
+		source->digest.value = oscap_source_compute_digest(source);
+	return source->digest.value;
+}
+
+void oscap_source_set_digest(struct oscap_source *source, const char *digest)
+{
+	free(source->digest.value);
+	source->digest.value = oscap_strdup(digest);
+}
+
+bool oscap_source_digest_is_current(struct oscap_source *source)
+{
+	struct stat st;
+
+	if (source->digest.value == NULL)
+		return false;
+	if (source->origin.type != OSCAP_SRC_FROM_USER_XML_FILE)
+		return true;
+	return !source->digest.changed && stat(source->origin.filepath, &st) == 0
+		&& st.st_dev == source->digest.st.st_dev && st.st_ino == source->digest.st.st_ino
+		&& oscap_file_stat_unchanged(&st, &source->digest.st);
+}
+
 static void xmlErrorCb(struct oscap_string *buffer, const char * format, ...)
 {
 	va_list ap;
@@ -250,6 +368,112 @@ static bool memory_file_is_executable(const char* memory, const size_t size)
 	return true;
 }
 
+// xmlInputReadCallback
+static int fd_reader_read(void *context, char *buffer, int len)
+{
+	return read((int)(intptr_t) context, buffer, len);
+}
+
+// xmlInputCloseCallback
+static int fd_reader_close(void *context)
+{
+	return close((int)(intptr_t) context);
+}
+
+static void reader_error_handler(void *user, xmlErrorPtr error)
+{
+	struct oscap_source *source = (struct oscap_source *) user;
+
+	if (error->level == XML_ERR_WARNING) {
+		dW("%s: %s", oscap_source_readable_origin(source), error->message);
+		return;
+	}
+	oscap_setxmlerr(error);
+}
+
+/**
+ * Open a streaming reader of the original file or memory buffer, the DOM
+ * is not built. Parsing errors are reported when the reader gets to them.
+ */
+static xmlTextReader *oscap_source_open_xmlTextReader(struct oscap_source *source)
+{
+	xmlTextReader *reader = NULL;
+
+	if (source->origin.memory != NULL) {
+		if (bz2_memory_is_bzip(source->origin.memory, source->origin.memory_size)) {
+#ifdef BZIP2_FOUND
+			reader = bz2_mem_read_reader(source->origin.memory, source->origin.memory_size);
+#else
+			oscap_seterr(OSCAP_EFAMILY_OSCAP, "Unable to unpack bz2 from buffer memory '%s'. Please compile OpenSCAP with bz2 support.", oscap_source_readable_origin(source));
+			return NULL;
+#endif
+		} else if (memory_file_is_executable(source->origin.memory, source->origin.memory_size)) {
+			dI("oscap-source in memory was detected as executable file '%s'. Skipped XML parsing", oscap_source_readable_origin(source));
+			return NULL;
+		} else {
+			reader = xmlReaderForMemory(source->origin.memory, source->origin.memory_size, NULL, NULL, 0);
+		}
+	} else {
+		int fd = oscap_source_open_file(source);
+		if (fd == -1) {
+			oscap_seterr(OSCAP_EFAMILY_GLIBC, "Unable to open file: '%s'", oscap_source_readable_origin(source));
+			return NULL;
+		}
+		if (bz2_fd_is_bzip(fd)) {
+#ifdef BZIP2_FOUND
+			reader = bz2_fd_read_reader(fd);
+#else
+			close(fd);
+			oscap_seterr(OSCAP_EFAMILY_OSCAP, "Unable to unpack bz2 file '%s'. Please compile OpenSCAP with bz2 support.", oscap_source_readable_origin(source));
+			return NULL;
+#endif
+		} else if (fd_file_is_executable(fd)) {
+			close(fd);
+			dI("oscap-source file was detected as executable file '%s'. Skipped XML parsing", oscap_source_readable_origin(source));
+			return NULL;
+		} else {
+			// the reader closes the descriptor, even when it fails
+			reader = xmlReaderForIO(fd_reader_read, fd_reader_close, (void *)(intptr_t) fd,
+				source->origin.filepath, NULL, 0);
+		}
+	}
+
+	if (reader == NULL) {
+		oscap_seterr(OSCAP_EFAMILY_XML, "Unable to create xmlTextReader for %s", oscap_source_readable_origin(source));
+		oscap_setxmlerr(xmlGetLastError());
+		return NULL;
+	}
+	xmlTextReaderSetStructuredErrorHandler(reader, (xmlStructuredErrorFunc) reader_error_handler, source);
+	return reader;
+}
+
+xmlTextReader *oscap_source_get_xmlTextReader(struct oscap_source *source)
+{
+	if (source->xml.foreign_node != NULL && oscap_source_get_xmlDoc(source) == NULL) {
+		return NULL;
+	}
+	if (source->xml.doc == NULL) {
+		return oscap_source_open_xmlTextReader(source);
+	}
+	// the DOM has been already built, walking it is cheaper than parsing again
+	xmlTextReader *reader = xmlReaderWalker(source->xml.doc);
+	if (reader == NULL) {
+		oscap_seterr(OSCAP_EFAMILY_XML, "Unable to create xmlTextReader for %s", oscap_source_readable_origin(source));
+		oscap_setxmlerr(xmlGetLastError());
+	}
+	return reader;
+}
+
+int oscap_source_free_xmlTextReader(xmlTextReader *reader)
+{
+	if (reader == NULL) {
+		return -1;
+	}
+	const int ret = xmlTextReaderReadState(reader) == XML_TEXTREADER_MODE_ERROR ? -1 : 0;
+	xmlFreeTextReader(reader);
+	return ret;
+}
+
 xmlDoc *oscap_source_get_xmlDoc(struct oscap_source *source)
 {
 	// We check origin.memory first because even with it being non-NULL
@@ -258,7 +482,12 @@ xmlDoc *oscap_source_get_xmlDoc(struct oscap_source *source)
 	xmlSetGenericErrorFunc(xml_error_string, (xmlGenericErrorFunc)xmlErrorCb);
 
 	if (source->xml.doc == NULL) {
-		if (source->origin.memory != NULL) {
+		if (source->xml.foreign_node != NULL) {
+			source->xml.doc = ds_doc_from_foreign_node(source->xml.foreign_node, source->xml.foreign_doc);
+			source->xml.foreign_node = NULL;
+			source->xml.foreign_doc = NULL;
+		}
+		else if (source->origin.memory != NULL) {
 			if (bz2_memory_is_bzip(source->origin.memory, source->origin.memory_size)) {
 #ifdef BZIP2_FOUND
 				source->xml.doc = bz2_mem_read_doc(source->origin.memory, source->origin.memory_size);
@@ -282,7 +511,7 @@ xmlDoc *oscap_source_get_xmlDoc(struct oscap_source *source)
 			}
 		}
 		else {
-			int fd = open(source->origin.filepath, O_RDONLY);
+			int fd = oscap_source_open_file(source);
 			if ( fd == -1 ){
 				source->xml.doc = NULL;
 				oscap_seterr(OSCAP_EFAMILY_GLIBC, "Unable to open file: '%s'", oscap_source_readable_origin(source));
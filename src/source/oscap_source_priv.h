@@ -58,15 +58,52 @@ struct oscap_source *oscap_source_new_take_memory(char *buffer, size_t size, con
  */
 struct oscap_source *oscap_source_new_from_xmlDoc(xmlDoc *doc, const char *filepath);
 
+/**
+ * Build new oscap_source from an element of another document, e.g. from
+ * a component of a DataStream. The element is copied to a document of its
+ * own only when the DOM or a reader is requested for the first time, so
+ * the sources which are never used cost nothing. The parent document is
+ * not owned by oscap_source and it must outlive the source or the source
+ * must be materialized by oscap_source_get_xmlDoc() before the parent
+ * document is freed or modified.
+ * @memberof oscap_source
+ * @param node the root element of the new document
+ * @param parent the document which owns the node
+ * @param filepath Suggested filename for the file or NULL
+ * @returns newly created oscap_source
+ */
+struct oscap_source *oscap_source_new_from_foreign_node(xmlNode *node, xmlDoc *parent, const char *filepath);
+
 /**
  * Get an xmlTextReader assigned with this resource. The reader needs to be
- * disposed by caller.
+ * disposed by caller. When the DOM representation hasn't been built yet,
+ * the reader parses the file or memory buffer as a stream and the DOM is
+ * not built at all. XML errors are then reported only as the reader gets
+ * to them, see oscap_source_free_xmlTextReader(). Parsers read the stream
+ * with xmlTextReaderNextNode() and stop when it fails.
  * @memberof oscap_source
  * @param source Resource to read the content
  * @returns xmlTextReader structure to read the content
  */
 xmlTextReader *oscap_source_get_xmlTextReader(struct oscap_source *source);
 
+/**
+ * Dispose an xmlTextReader returned by oscap_source_get_xmlTextReader()
+ * and check whether it hit an XML error in the part of the document
+ * which has been read.
+ * @param reader the reader, may be NULL
+ * @returns 0 on success, -1 on XML error or when the reader is NULL
+ */
+int oscap_source_free_xmlTextReader(xmlTextReader *reader);
+
+/**
+ * Check whether the content is going to be parsed from the file at
+ * oscap_source_get_filepath(), i.e. the source neither originates from
+ * memory or DOM nor the DOM has been built yet.
+ * @memberof oscap_source
+ */
+bool oscap_source_is_unparsed_file(const struct oscap_source *source);
+
 /**
  * Get a DOM representation of this resource. The document ins still owned
  * by oscap_source.
@@ -85,4 +122,29 @@ xmlDoc *oscap_source_get_xmlDoc(struct oscap_source *source);
  */
 xmlDoc *oscap_source_pop_xmlDoc(struct oscap_source *source);
 
+/**
+ * Get a digest identifying the content of the source. Models built from
+ * the content are stored in the model cache under it. The digest of a file
+ * is computed when it's requested for the first time, other sources get
+ * it from their creator, e.g. the components of a DataStream.
+ * @memberof oscap_source
+ * @param source Resource
+ * @returns the digest or NULL if the content has no stable identity
+ */
+const char *oscap_source_get_digest(struct oscap_source *source);
+
+/**
+ * Set the digest identifying the content of the source.
+ * @memberof oscap_source
+ */
+void oscap_source_set_digest(struct oscap_source *source, const char *digest);
+
+/**
+ * Check that the file of the source didn't change since its digest was
+ * computed or since it was read for the first time. A model built from
+ * the source can be stored under its digest only then.
+ * @memberof oscap_source
+ */
+bool oscap_source_digest_is_current(struct oscap_source *source);
+
 #endif
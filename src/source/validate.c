@@ -24,6 +24,7 @@
 
 #include <libxml/parser.h>
 #include <libxml/xmlerror.h>
+#include <libxml/xmlreader.h>
 #include <libxml/xmlschemas.h>
 #include <string.h>
 #ifdef OS_WINDOWS
@@ -33,10 +34,12 @@
 #endif
 
 #include "common/_error.h"
+#include "common/debug_priv.h"
 #include "common/util.h"
 #include "oscap.h"
 #include "oscap_source.h"
 #include "source/oscap_source_priv.h"
+#include "source/validate_cache_priv.h"
 #include "source/validate_priv.h"
 #include "oscap_helpers.h"
 
@@ -44,6 +47,8 @@ struct ctxt {
 	xml_reporter reporter;
 	void *arg;
 	char *filename;
+	bool malformed;
+	bool reported;
 };
 
 static void oscap_xml_validity_handler(void *user, xmlErrorPtr error)
@@ -80,9 +85,60 @@ static void oscap_xml_validity_handler(void *user, xmlErrorPtr error)
 	if (file == NULL)
 		file = context->filename;
 
+	context->reported = true;
 	context->reporter(file, error->line, error->message, context->arg);
 }
 
+static void oscap_xml_stream_handler(void *user, xmlErrorPtr error)
+{
+	struct ctxt *context = (struct ctxt *) user;
+
+	if (error->domain == XML_FROM_SCHEMASV) {
+		oscap_xml_validity_handler(user, error);
+	} else if (error->level != XML_ERR_WARNING) {
+		// the document is not well-formed
+		oscap_setxmlerr(error);
+		context->malformed = true;
+	}
+}
+
+/*
+ * Validate the document as it is parsed, the DOM is not built. Returns -2
+ * when the reader can't validate because it walks an already built DOM.
+ */
+static int oscap_validate_xml_stream(struct oscap_source *source, xmlSchemaValidCtxtPtr ctxt, struct ctxt *context)
+{
+	xmlTextReader *reader = oscap_source_get_xmlTextReader(source);
+	if (reader == NULL) {
+		return -1;
+	}
+	if (xmlTextReaderSchemaValidateCtxt(reader, ctxt, 0) != 0) {
+		xmlFreeTextReader(reader);
+		return -2;
+	}
+	/*
+	 * An error handler of the reader must not be set while the schema
+	 * validation is plugged into the parser, libxml2 passes it a wrong
+	 * context then. Parser errors are caught by the global handler.
+	 */
+	xmlTextReaderSetStructuredErrorHandler(reader, NULL, NULL);
+	xmlSchemaSetValidStructuredErrors(ctxt, oscap_xml_validity_handler, context);
+
+	int ret;
+	xmlSetStructuredErrorFunc(context, (xmlStructuredErrorFunc) oscap_xml_stream_handler);
+	while ((ret = xmlTextReaderRead(reader)) == 1)
+		;
+	xmlSetStructuredErrorFunc(NULL, NULL);
+	if (context->malformed) {
+		oscap_seterr(OSCAP_EFAMILY_XML, "Unable to parse XML at: '%s'", oscap_source_readable_origin(source));
+		ret = -1;
+	} else {
+		ret = (ret == 0 && xmlTextReaderIsValid(reader) == 1) ? 0 : 1;
+	}
+	xmlFreeTextReader(reader);
+	return ret;
+}
+
 static inline int oscap_validate_xml(struct oscap_source *source, const char *schemafile, xml_reporter reporter, void *arg)
 {
 	int result = -1;
@@ -91,7 +147,9 @@ static inline int oscap_validate_xml(struct oscap_source *source, const char *sc
 	xmlSchemaValidCtxtPtr ctxt = NULL;
 	xmlDocPtr doc = NULL;
 
-	struct ctxt context = { reporter, arg, (void*) oscap_source_readable_origin(source)};
+	struct ctxt context = { reporter, arg, (void*) oscap_source_readable_origin(source), false, false};
+	struct stat st;
+	bool cacheable = false;
 
 	if (schemafile == NULL) {
 		oscap_seterr(OSCAP_EFAMILY_OSCAP, "'schemafile' == NULL");
@@ -105,6 +163,16 @@ static inline int oscap_validate_xml(struct oscap_source *source, const char *sc
 		goto cleanup;
 	}
 
+	if (oscap_source_is_unparsed_file(source)) {
+		cacheable = true;
+		if (oscap_validate_cache_get(oscap_source_get_filepath(source), schemapath, &st)) {
+			dD("'%s' is known to be valid against '%s', skipping validation.",
+				oscap_source_readable_origin(source), schemapath);
+			result = 0;
+			goto cleanup;
+		}
+	}
+
 	parser_ctxt = xmlSchemaNewParserCtxt(schemapath);
 	if (parser_ctxt == NULL) {
 		oscap_seterr(OSCAP_EFAMILY_XML, "Could not create parser context for validation");
@@ -127,6 +195,14 @@ static inline int oscap_validate_xml(struct oscap_source *source, const char *sc
 
 	xmlSchemaSetValidStructuredErrors(ctxt, oscap_xml_validity_handler, &context);
 
+	result = oscap_validate_xml_stream(source, ctxt, &context);
+	if (result != -2) {
+		// warnings would not be reported again
+		if (result == 0 && cacheable && !context.reported)
+			oscap_validate_cache_put(oscap_source_get_filepath(source), schemapath, &st);
+		goto cleanup;
+	}
+
 	doc = oscap_source_get_xmlDoc(source);
 	if (!doc)
 		goto cleanup;
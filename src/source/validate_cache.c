@@ -0,0 +1,120 @@
+/*
+ * Copyright 2026 Red Hat Inc., Durham, North Carolina.
+ * All Rights Reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdint.h>
+#include <string.h>
+
+#include "common/oscap_file_cache.h"
+#include "validate_cache_priv.h"
+
+#ifdef OS_WINDOWS
+
+bool oscap_validate_cache_get(const char *filepath, const char *schemapath, struct stat *st)
+{
+	return false;
+}
+
+void oscap_validate_cache_put(const char *filepath, const char *schemapath, const struct stat *st)
+{
+}
+
+#else
+
+#include <pthread.h>
+#include <stdlib.h>
+
+/*
+ * Persistent cache of successful XSD validations, see oscap_file_cache.h.
+ * Every record says that the file is valid against the schema, the record
+ * is tagged by a hash of the OpenSCAP version, the path and the status of
+ * the schema file.
+ */
+
+#define OSCAP_VALIDATE_CACHE_MAGIC "OSCAPVC2"
+
+static pthread_once_t oscap_validate_cache_once = PTHREAD_ONCE_INIT;
+static struct oscap_file_cache *oscap_validate_cache = NULL;
+
+static uint64_t fnv1a64(uint64_t h, const void *data, size_t len)
+{
+	const uint8_t *p = data;
+	for (size_t i = 0; i < len; ++i)
+		h = (h ^ p[i]) * 1099511628211u;
+	return h;
+}
+
+static int oscap_validate_cache_schema(const char *schemapath, uint64_t *schema)
+{
+	struct stat st;
+	if (stat(schemapath, &st) != 0)
+		return -1;
+
+	int64_t times[4] = {
+		OSCAP_ST_MTIM(&st).tv_sec, OSCAP_ST_MTIM(&st).tv_nsec,
+		OSCAP_ST_CTIM(&st).tv_sec, OSCAP_ST_CTIM(&st).tv_nsec
+	};
+	uint64_t h = 14695981039346656037u;
+	h = fnv1a64(h, OPENSCAP_VERSION, sizeof(OPENSCAP_VERSION));
+	h = fnv1a64(h, schemapath, strlen(schemapath) + 1);
+	h = fnv1a64(h, times, sizeof(times));
+	*schema = h;
+	return 0;
+}
+
+static void oscap_validate_cache_init(void)
+{
+	oscap_validate_cache = oscap_file_cache_open(getenv("OSCAP_VALIDATION_CACHE"),
+			OSCAP_VALIDATE_CACHE_MAGIC, 0, "validation cache");
+}
+
+bool oscap_validate_cache_get(const char *filepath, const char *schemapath, struct stat *st)
+{
+	uint64_t schema;
+
+	pthread_once(&oscap_validate_cache_once, oscap_validate_cache_init);
+	if (oscap_validate_cache == NULL)
+		return false;
+	if (stat(filepath, st) != 0 || !S_ISREG(st->st_mode) || oscap_validate_cache_schema(schemapath, &schema) != 0) {
+		memset(st, 0, sizeof(struct stat));
+		return false;
+	}
+	return oscap_file_cache_get(oscap_validate_cache, st, schema, NULL);
+}
+
+void oscap_validate_cache_put(const char *filepath, const char *schemapath, const struct stat *st)
+{
+	struct stat now;
+	uint64_t schema;
+
+	pthread_once(&oscap_validate_cache_once, oscap_validate_cache_init);
+	if (oscap_validate_cache == NULL || st->st_ino == 0)
+		return;
+	if (stat(filepath, &now) != 0 || oscap_validate_cache_schema(schemapath, &schema) != 0)
+		return;
+	// the file changed while it was validated
+	if (now.st_dev != st->st_dev || now.st_ino != st->st_ino || !oscap_file_stat_unchanged(&now, st))
+		return;
+	oscap_file_cache_put(oscap_validate_cache, st, schema, NULL);
+}
+
+#endif
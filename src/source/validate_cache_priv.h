@@ -0,0 +1,43 @@
+/*
+ * Copyright 2026 Red Hat Inc., Durham, North Carolina.
+ * All Rights Reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+#ifndef OSCAP_SOURCE_VALIDATE_CACHE_H
+#define OSCAP_SOURCE_VALIDATE_CACHE_H
+
+#include <stdbool.h>
+#include <sys/stat.h>
+
+/**
+ * Check whether the file has been already found valid against the schema.
+ * The cache is enabled by setting OSCAP_VALIDATION_CACHE to the path of
+ * the cache file.
+ * @param filepath the validated file
+ * @param schemapath the schema used for validation
+ * @param st filled with the status of the file, pass it to
+ *        oscap_validate_cache_put() after the file is validated
+ * @return true if the file is valid according to the cache
+ */
+bool oscap_validate_cache_get(const char *filepath, const char *schemapath, struct stat *st);
+
+/**
+ * Remember that the file is valid against the schema. Nothing is stored
+ * if the file changed since oscap_validate_cache_get() filled st.
+ */
+void oscap_validate_cache_put(const char *filepath, const char *schemapath, const struct stat *st);
+
+#endif
@@ -235,6 +235,44 @@ int main(int argc, char **argv)
 		oscap_source_free(source);
 	}
 
+	else if (argc == 6 && !strcmp(argv[1], "--rename")) {
+
+		struct oscap_source *source = oscap_source_new_from_file(argv[2]);
+		if ((dict_model = cpe_dict_model_import_source(source)) == NULL) {
+			oscap_source_free(source);
+			return 2;
+		}
+
+		name = cpe_name_new(argv[4]);
+		struct cpe_name *new_name = cpe_name_new(argv[5]);
+
+		// the name is looked up in the dictionary before it's changed
+		if (!cpe_name_match_dict(name, dict_model))
+			ret_val = 1;
+
+		item = NULL;
+		OSCAP_FOREACH(cpe_item, local_item,
+			      cpe_dict_model_get_items(dict_model),
+			      if (cpe_name_match_one(name, cpe_item_get_name(local_item)))
+			      item = local_item;)
+		if (item == NULL)
+			return 1;
+
+		cpe_item_set_name(item, cpe_name_new(argv[5]));
+		if (!cpe_name_match_dict(new_name, dict_model) || cpe_name_match_dict(name, dict_model))
+			ret_val = 1;
+
+		// the name of the item is changed back in place
+		cpe_name_set_vendor(cpe_item_get_name(item), cpe_name_get_vendor(name));
+		if (!cpe_name_match_dict(name, dict_model) || cpe_name_match_dict(new_name, dict_model))
+			ret_val = 1;
+
+		cpe_name_free(new_name);
+		cpe_name_free(name);
+		cpe_dict_model_free(dict_model);
+		oscap_source_free(source);
+	}
+
 	else if (argc == 6 && !strcmp(argv[1], "--export")) {
 		struct oscap_source *source = oscap_source_new_from_file(argv[2]);
 		if ((dict_model = cpe_dict_model_import_source(source)) == NULL) {
@@ -301,8 +339,9 @@ void print_usage(const char *program_name, FILE * out)
 		"  %s --list           CPE_DICT_XML ENCODING\n"
 		"  %s --match          CPE_DICT_XML ENCODING CPE_URI\n"
 		"  %s --remove         CPE_DICT_XML ENCODING CPE_URI\n"
+		"  %s --rename         CPE_DICT_XML ENCODING CPE_URI CPE_URI\n"
 		"  %s --export         CPE_DICT_XML ENCODING CPE_DICT_XML ENCODING\n"
 		"  %s --smoke-test\n",
 		program_name, program_name, program_name, program_name,
-		program_name, program_name, program_name);
+		program_name, program_name, program_name, program_name);
 }
@@ -45,6 +45,11 @@ function test_api_cpe_dict_match_existing_cpe {
     return 0 
 }
 
+function test_api_cpe_dict_rename_cpe {
+    ./test_api_cpe_dict --rename $srcdir/dict.xml "UTF-8" \
+	"cpe:/a:3com:3cdaemon" "cpe:/a:example:3cdaemon"
+}
+
 function test_api_cpe_dict_export_xml {
     ./test_api_cpe_dict --export $srcdir/dict.xml "UTF-8" \
 	dict.xml.out "UTF-8" && \
@@ -126,6 +131,7 @@ if [ -z ${CUSTOM_OSCAP+x} ] ; then
         test_api_cpe_dict_match_non_existing_cpe   
     test_run "test_api_cpe_dict_match_existing_cpe" \
         test_api_cpe_dict_match_existing_cpe
+    test_run "test_api_cpe_dict_rename_cpe" test_api_cpe_dict_rename_cpe
     test_run "test_api_cpe_dict_export_xml"  test_api_cpe_dict_export_xml
     #test_run "test_api_cpe_dict_import_cp1250_xml" \
     #    test_api_cpe_dict_import_cp1250_xml   
@@ -30,6 +30,16 @@ function test_api_oval_results {
     cmp $srcdir/results-good.xml exported-results.xml
 }
 
+# The streamed export has to be the same as the saved DOM
+function test_api_oval_results_stream {
+    local ret=0
+    ./test_api_results $srcdir/$1 streamed-results.xml saved-results.xml
+    cmp saved-results.xml streamed-results.xml || ret=1
+    cmp $srcdir/$2 streamed-results.xml || ret=1
+    rm streamed-results.xml saved-results.xml
+    return $ret
+}
+
 function test_api_oval_directives {
     ./test_api_directives $srcdir/directives.xml exported-directives.xml
     cmp $srcdir/directives.xml exported-directives.xml
@@ -43,6 +53,8 @@ if [ -z ${CUSTOM_OSCAP+x} ] ; then
     test_run "test_api_oval_definition" test_api_oval_definition
     test_run "test_api_oval_syschar" test_api_oval_syschar
     test_run "test_api_oval_results" test_api_oval_results
+    test_run "test_api_oval_results_stream" test_api_oval_results_stream results.xml results-good.xml
+    test_run "test_api_oval_results_stream record states" test_api_oval_results_stream results-record.xml results-record.xml
     test_run "test_api_oval_directives" test_api_oval_directives
 fi
 
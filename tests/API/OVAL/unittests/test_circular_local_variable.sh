@@ -0,0 +1,23 @@
+#!/usr/bin/env bash
+
+. $builddir/tests/test_common.sh
+set -e
+set -o pipefail
+
+stdout="$(mktemp)"
+stderr="$(mktemp)"
+result="$(mktemp)"
+
+$OSCAP oval eval --results "$result" $srcdir/test_circular_local_variable.xml > "$stdout" 2> "$stderr"
+
+grep -q "Definition oval:x:def:1: error" "$stdout"
+grep -q "Definition oval:x:def:2: true" "$stdout"
+grep -q "Circular dependency in OVAL variable 'oval:x:var:1'\." "$stderr"
+
+assert_exists 1 '/oval_results/results/system/tests/test[@test_id="oval:x:tst:1" and @result="error"]'
+assert_exists 1 '/oval_results/results/system/tests/test[@test_id="oval:x:tst:2" and @result="true"]'
+assert_exists 1 '/oval_results/results/system/tests/test[@test_id="oval:x:tst:2"]/tested_variable[@variable_id="oval:x:var:4" and text()="a-b-a"]'
+
+rm -f "$stdout"
+rm -f "$stderr"
+rm -f "$result"
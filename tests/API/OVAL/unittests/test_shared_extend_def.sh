@@ -0,0 +1,28 @@
+#!/usr/bin/env bash
+
+# Definitions 1 and 2 share the extended definition 3 and definitions 4 and 5
+# extend each other. The independent objects are collected before the
+# evaluation, each of them once and in the order in which they are queried.
+
+. $builddir/tests/test_common.sh
+set -e
+set -o pipefail
+
+stdout="$(mktemp)"
+stderr="$(mktemp)"
+
+$OSCAP oval eval --verbose DEVEL $srcdir/test_shared_extend_def.xml > "$stdout" 2> "$stderr"
+
+grep -q "Definition oval:x:def:1: false" "$stdout"
+grep -q "Definition oval:x:def:2: false" "$stdout"
+grep -q "Definition oval:x:def:3: false" "$stdout"
+grep -q "Definition oval:x:def:4: not evaluated" "$stdout"
+grep -q "Definition oval:x:def:5: true" "$stdout"
+
+collected="$(grep "SEAP_packet_msg2sexp" "$stderr" | grep -o "oval:x:obj:[0-9]*" | tr '\n' ' ')"
+queried="$(grep -o "Querying textfilecontent54 object 'oval:x:obj:[0-9]*'" "$stderr" | grep -o "oval:x:obj:[0-9]*" | tr '\n' ' ')"
+[ "$collected" == "$queried" ]
+[ "$(echo $collected | wc -w)" -eq 5 ]
+
+rm -f "$stdout"
+rm -f "$stderr"
@@ -0,0 +1,42 @@
+#!/usr/bin/env bash
+. $builddir/tests/test_common.sh
+
+set -e -o pipefail
+
+# The states are compared with many items, each of the items gets its own result
+name=$(basename $0 .sh)
+result=$(mktemp ${name}.out.XXXXXX)
+echo "result file: $result"
+stderr=$(mktemp ${name}.err.XXXXXX)
+echo "stderr file: $stderr"
+
+echo "Analysing syschar content."
+$OSCAP oval analyse --results $result $srcdir/$name.oval.xml $srcdir/$name.syschar.xml 2> $stderr
+# The item 4 has no epoch in its Debian EVR string
+grep -q "Invalid epoch." $stderr; rm $stderr
+[ -f $result ]
+
+assert_exists 3 '/oval_results/results/system/definitions/definition[@result="false"]'
+
+test='/oval_results/results/system/tests/test[@test_id="oval:x:tst:1"]'
+assert_exists 1 $test'[@result="false"]'
+assert_exists 1 $test'/tested_item[@item_id="1"][@result="true"]'
+assert_exists 1 $test'/tested_item[@item_id="2"][@result="false"]'
+assert_exists 1 $test'/tested_item[@item_id="3"][@result="true"]'
+assert_exists 1 $test'/tested_item[@item_id="4"][@result="error"]'
+
+test='/oval_results/results/system/tests/test[@test_id="oval:x:tst:2"]'
+assert_exists 1 $test'[@result="false"]'
+assert_exists 1 $test'/tested_item[@item_id="1"][@result="true"]'
+assert_exists 1 $test'/tested_item[@item_id="2"][@result="false"]'
+assert_exists 1 $test'/tested_item[@item_id="3"][@result="true"]'
+assert_exists 1 $test'/tested_item[@item_id="4"][@result="false"]'
+
+test='/oval_results/results/system/tests/test[@test_id="oval:x:tst:3"]'
+assert_exists 1 $test'[@result="false"]'
+assert_exists 1 $test'/tested_item[@item_id="1"][@result="true"]'
+assert_exists 1 $test'/tested_item[@item_id="2"][@result="false"]'
+assert_exists 1 $test'/tested_item[@item_id="3"][@result="false"]'
+assert_exists 1 $test'/tested_item[@item_id="4"][@result="true"]'
+
+rm $result
@@ -47,6 +47,19 @@ int main(int argc, char **argv)
 		oscap_cleanup();
 		return 0;
 	}
+	else if (strcmp(argv[1], "--export-source") == 0) {
+		if (argc != 4) return 1;
+		struct oscap_source *source = oscap_source_new_from_file(argv[2]);
+		struct xccdf_benchmark *bench = xccdf_benchmark_import_source(source);
+		oscap_source_free(source);
+		if (bench == NULL) return 1;
+		source = xccdf_benchmark_export_source(bench, argv[3]);
+		oscap_source_save_as(source, NULL);
+		oscap_source_free(source);
+		xccdf_benchmark_free(bench);
+		oscap_cleanup();
+		return 0;
+	}
 	else if (strcmp(argv[1], "--validate") == 0) {
 		if (argc != 4) {
 			fprintf(stderr, "Usage: %s --validate ver xccdf\n", argv[0]);
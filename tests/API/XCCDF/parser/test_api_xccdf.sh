@@ -37,6 +37,17 @@ function test_api_xccdf_export {
 	return 0
 }
 
+# The streamed export has to be the same as the saved DOM
+function test_api_xccdf_export_stream {
+	local INPUT=$srcdir/$1
+	local OUTPUT=$(basename $1)
+
+	./test_api_xccdf --export $INPUT $OUTPUT.streamed
+	./test_api_xccdf --export-source $INPUT $OUTPUT.saved
+	cmp $OUTPUT.saved $OUTPUT.streamed
+	rm $OUTPUT.saved $OUTPUT.streamed
+}
+
 function test_api_xccdf_validate {
 	local INPUT=$1
 	local VER=$2
@@ -50,6 +61,9 @@ function test_api_xccdf_validate {
 test_init
 
 if [ -z ${CUSTOM_OSCAP+x} ] ; then
+    test_run "stream xccdf 1.2" test_api_xccdf_export_stream xccdf12.xml
+    test_run "stream xccdf results 1.1" test_api_xccdf_export_stream xccdf11-results.xml
+    test_run "stream xccdf results 1.2" test_api_xccdf_export_stream ../../../DS/rds_simple/results-xccdf.xml
     test_run "export xccdf 1.1" test_api_xccdf_export xccdf11.xml
     test_run "validate xccdf 1.1" test_api_xccdf_validate xccdf11.xml "1.1"
     test_run "export xccdf 1.2" test_api_xccdf_export xccdf12.xml
@@ -24,6 +24,7 @@
 #include <config.h>
 #endif
 
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include "common/list.h"
@@ -234,6 +235,50 @@ static void _test_hit_multiple_items1(void)
 	oscap_htable_free0(h);
 }
 
+static void _test_htable_grow_detach(void)
+{
+	struct oscap_htable *h = oscap_htable_new1(_htable_cmp, 1);
+	char key[12];
+	int i;
+
+	for (i = 0; i < 1000; i++) {
+		snprintf(key, 12, "%d", i);
+		oscap_assert(oscap_htable_add(h, key, (void *)(intptr_t)(i + 1)));
+	}
+	oscap_assert(!oscap_htable_add(h, "500", NULL));
+	oscap_assert(oscap_htable_itemcount(h) == 1000);
+
+	// detach the even keys, add some of them again
+	for (i = 0; i < 1000; i += 2) {
+		snprintf(key, 12, "%d", i);
+		oscap_assert(oscap_htable_detach(h, key) == (void *)(intptr_t)(i + 1));
+		oscap_assert(oscap_htable_get(h, key) == NULL);
+	}
+	oscap_assert(oscap_htable_itemcount(h) == 500);
+	oscap_assert(oscap_htable_add(h, "0", (void *)(intptr_t)1));
+	oscap_assert(oscap_htable_add(h, "new", NULL));
+
+	for (i = 1; i < 1000; i += 2) {
+		snprintf(key, 12, "%d", i);
+		oscap_assert(oscap_htable_get(h, key) == (void *)(intptr_t)(i + 1));
+	}
+	oscap_assert(oscap_htable_get(h, "0") == (void *)(intptr_t)1);
+	oscap_assert(oscap_htable_get(h, "2") == NULL);
+
+	// the items are iterated in the order of insertion, detached ones are skipped
+	struct oscap_htable_iterator *hit = oscap_htable_iterator_new(h);
+	for (i = 1; i < 1000; i += 2) {
+		snprintf(key, 12, "%d", i);
+		oscap_assert(oscap_htable_iterator_has_more(hit));
+		oscap_assert(strcmp(oscap_htable_iterator_next_key(hit), key) == 0);
+	}
+	oscap_assert(strcmp(oscap_htable_iterator_next_key(hit), "0") == 0);
+	oscap_assert(strcmp(oscap_htable_iterator_next_key(hit), "new") == 0);
+	oscap_assert(!oscap_htable_iterator_has_more(hit));
+	oscap_htable_iterator_free(hit);
+	oscap_htable_free0(h);
+}
+
 static bool _test_list_remove_ptreq(void *a, void *b)
 {
 	return a == b;
@@ -328,6 +373,7 @@ int main(int argc, char *argv[])
 	_test_hit_empty1();
 	_test_hit_single_item1();
 	_test_hit_multiple_items1();
+	_test_htable_grow_detach();
 
 	_test_list_remove();
 
@@ -0,0 +1,63 @@
+#!/usr/bin/env bash
+. $builddir/tests/test_common.sh
+
+set -e
+set -o pipefail
+
+name=$(basename $0 .sh)
+stderr=$(mktemp -t ${name}.out.XXXXXX)
+result=$(mktemp -t ${name}.out.XXXXXX)
+echo "Stderr file = $stderr"
+echo "Result file = $result"
+rm -f test_file
+
+# The bash fixes are sourced by subshells of one interpreter.
+$OSCAP xccdf remediate --results $result $srcdir/${name}.xccdf.xml 2> $stderr || [ $? -eq 2 ]
+[ -f $stderr ]; [ ! -s $stderr ]; :> $stderr
+[ -f test_file ]; rm test_file
+$OSCAP xccdf validate --skip-schematron $result
+tr='//TestResult[@id="xccdf_org.open-scap_testresult_default-profile001"]'
+rule='xccdf_moc.elpmaxe.www_rule_'
+assert_exists 8 $tr'/rule-result'
+assert_exists 7 $tr'/rule-result[result="fixed"]'
+assert_exists 1 $tr'/rule-result[@idref="'$rule'1"]/message[text()="Fix execution completed and returned: 0"]'
+assert_exists 1 $tr'/rule-result[@idref="'$rule'1"]/message[normalize-space(text())="first"]'
+assert_exists 1 $tr'/rule-result[@idref="'$rule'2"]/message[text()="Fix execution completed and returned: 3"]'
+assert_exists 1 $tr'/rule-result[@idref="'$rule'2"]/message[starts-with(normalize-space(text()), "cwd='$(pwd)' leaked=no reply=unset script=fix-")]'
+assert_exists 1 $tr'/rule-result[@idref="'$rule'2"]/message[contains(text(), "source=script")]'
+assert_exists 1 $tr'/rule-result[@idref="'$rule'3"]/message[text()="no newline"]'
+# a return outside of a function ends the sourced fix
+assert_exists 1 $tr'/rule-result[@idref="'$rule'4"]/message[normalize-space(text())="before return"]'
+assert_exists 1 $tr'/rule-result[@idref="'$rule'5"]/message[normalize-space(text())="foreground"]'
+# the output of the background job which came after the marker is kept
+assert_exists 1 $tr'/rule-result[@idref="'$rule'6"]/message[normalize-space(text())="background after background"]'
+assert_exists 1 $tr'/rule-result[@idref="'$rule'7"][result="error"]'
+assert_exists 1 $tr'/rule-result[@idref="'$rule'7"]/message[text()="Fix execution was interrupted, the interpreter exited."]'
+assert_exists 1 $tr'/rule-result[@idref="'$rule'8"]/message[normalize-space(text())="last"]'
+
+# Each fix is executed by its own interpreter started by oscap.
+OSCAP_REMEDIATION_BATCH=0 $OSCAP xccdf remediate --results $result $srcdir/${name}.xccdf.xml 2> $stderr
+[ -f $stderr ]; [ ! -s $stderr ]; rm $stderr
+[ -f test_file ]; rm test_file
+$OSCAP xccdf validate --skip-schematron $result
+assert_exists 8 $tr'/rule-result[result="fixed"]'
+assert_exists 1 $tr'/rule-result[@idref="'$rule'1"]/message[normalize-space(text())="first"]'
+assert_exists 1 $tr'/rule-result[@idref="'$rule'2"]/message[text()="Fix execution completed and returned: 3"]'
+assert_exists 1 $tr'/rule-result[@idref="'$rule'2"]/message[starts-with(normalize-space(text()), "cwd='$(pwd)' leaked=no reply=unset script=fix-")]'
+assert_exists 1 $tr'/rule-result[@idref="'$rule'2"]/message[contains(text(), "source=script")]'
+assert_exists 1 $tr'/rule-result[@idref="'$rule'3"]/message[text()="no newline"]'
+assert_exists 1 $tr'/rule-result[@idref="'$rule'4"]/message[normalize-space(text())="before return after return"]'
+
+# A background process left by a fix executed by its own interpreter while
+# the session runs doesn't keep the session from ending.
+rm -f sleep_pid
+timeout 30 $OSCAP xccdf eval --remediate --results $result $srcdir/${name}_background.xccdf.xml > /dev/null 2> $stderr || [ $? -eq 2 ]
+[ -f $stderr ]; [ ! -s $stderr ]; rm $stderr
+[ -f test_file ]; rm test_file
+[ -f sleep_pid ]; kill $(cat sleep_pid); rm sleep_pid
+$OSCAP xccdf validate --skip-schematron $result
+assert_exists 3 '//rule-result[result="fixed"]'
+assert_exists 1 '//rule-result[@idref="'$rule'2"]/message[normalize-space(text())="perl"]'
+assert_exists 1 '//rule-result[@idref="'$rule'3"]/message[normalize-space(text())="last"]'
+
+rm $result
@@ -0,0 +1,71 @@
+#!/usr/bin/env bash
+. $builddir/tests/test_common.sh
+
+set -e
+set -o pipefail
+
+touch not_executable
+
+name=$(basename $0 .sh)
+tmpdir=$(mktemp -d -t ${name}.XXXXXX)
+stderr=$tmpdir/stderr
+xccdf=$srcdir/test_deriving_xccdf_result_from_oval.xccdf.xml
+
+export OSCAP_MODEL_CACHE=$tmpdir/cache
+
+function eval_results() {
+	$OSCAP --verbose INFO xccdf eval --results $tmpdir/results.xml $xccdf 2> $stderr
+	sed -E 's/(start-time|end-time|time)="[^"]*"//g' $tmpdir/results.xml > $1
+}
+
+# The first evaluation stores the benchmark and both OVAL files,
+# the second one loads them and gives the same results.
+eval_results $tmpdir/parsed.xml
+grep -q "from the model cache" $stderr && false
+[ $(ls $OSCAP_MODEL_CACHE | wc -l) -eq 3 ]
+eval_results $tmpdir/loaded.xml
+grep -q "Loaded the XCCDF benchmark of .* from the model cache" $stderr
+[ $(grep -c "Loaded the OVAL definitions of .* from the model cache" $stderr) -eq 2 ]
+diff $tmpdir/parsed.xml $tmpdir/loaded.xml
+
+# Damaged records are replaced by the parsed models.
+for record in $OSCAP_MODEL_CACHE/*; do
+	printf 'X' | dd of=$record bs=1 seek=$(( $(stat -c %s $record) - 1 )) conv=notrunc 2> /dev/null
+done
+eval_results $tmpdir/damaged.xml
+[ $(grep -c "doesn't match the content" $stderr) -eq 3 ]
+grep -q "from the model cache" $stderr && false
+diff $tmpdir/parsed.xml $tmpdir/damaged.xml
+eval_results $tmpdir/loaded.xml
+[ $(grep -c "from the model cache" $stderr) -eq 3 ]
+
+# Records writable by others are ignored.
+chmod o+w $OSCAP_MODEL_CACHE/*
+eval_results $tmpdir/ignored.xml
+grep -q "ignoring it" $stderr
+grep -q "from the model cache" $stderr && false
+diff $tmpdir/parsed.xml $tmpdir/ignored.xml
+
+# The resolved benchmarks and the OVAL definitions loaded from the model
+# cache are exported the same as the parsed ones. The TestResult and the CPE
+# dictionary, which aren't cached, are removed from the parser test contents.
+export OSCAP_MODEL_CACHE=$tmpdir/export-cache
+for version in 11 12; do
+	sed -e '/<TestResult/,/<\/TestResult>/d' -e '/<cpe-list/,/<\/cpe-list>/d' \
+		$srcdir/../parser/xccdf$version.xml > $tmpdir/xccdf$version.xml
+done
+for content in $xccdf $tmpdir/xccdf11.xml $tmpdir/xccdf12.xml \
+		$srcdir/../../../DS/sds_simple/scap-fedora14-xccdf.xml \
+		$srcdir/test_deriving_xccdf_result_from_oval_fail.oval.xml \
+		$srcdir/../../OVAL/scap-rhel5-oval.xml \
+		$srcdir/../../../DS/sds_simple/scap-fedora14-oval.xml ; do
+	./test_xccdf_model_cache_export $content $tmpdir/parsed.xml 2> $stderr
+	grep -q "from the model cache" $stderr && false
+	./test_xccdf_model_cache_export $content $tmpdir/loaded.xml 2> $stderr
+	grep -q "Loaded the .* of .* from the model cache" $stderr
+	diff $tmpdir/parsed.xml $tmpdir/loaded.xml
+done
+[ $(ls $OSCAP_MODEL_CACHE | wc -l) -eq 7 ]
+
+rm -rf $tmpdir
+rm not_executable
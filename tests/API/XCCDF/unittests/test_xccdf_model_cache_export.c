@@ -0,0 +1,65 @@
+/*
+ * Copyright 2026 Red Hat Inc., Durham, North Carolina.
+ * All Rights Reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include <oscap_debug.h>
+#include <oscap_source.h>
+#include <oval_definitions.h>
+#include <xccdf_benchmark.h>
+#include <xccdf_policy.h>
+#include <xccdf_session.h>
+
+#include "oscap_assert.h"
+
+/*
+ * Export the resolved benchmark the session loads from the XCCDF file, or
+ * the OVAL definitions, parsed or from the model cache given by
+ * OSCAP_MODEL_CACHE.
+ */
+int main(int argc, char *argv[])
+{
+	oscap_assert(argc == 3);
+	oscap_assert(oscap_set_verbose("INFO", NULL));
+	struct oscap_source *source = oscap_source_new_from_file(argv[1]);
+	if (oscap_source_get_scap_type(source) == OSCAP_DOCUMENT_OVAL_DEFINITIONS) {
+		struct oval_definition_model *model = oval_definition_model_import_source(source);
+		oscap_assert(model != NULL);
+		oscap_assert(oval_definition_model_export(model, argv[2]) == 1);
+		oval_definition_model_free(model);
+		oscap_source_free(source);
+		return 0;
+	}
+	oscap_source_free(source);
+
+	struct xccdf_session *session = xccdf_session_new(argv[1]);
+	oscap_assert(session != NULL);
+	xccdf_session_set_validation(session, false, false);
+	oscap_assert(xccdf_session_load_xccdf(session) == 0);
+	struct xccdf_benchmark *benchmark = xccdf_policy_model_get_benchmark(xccdf_session_get_policy_model(session));
+	oscap_assert(benchmark != NULL);
+	oscap_assert(xccdf_benchmark_export(benchmark, argv[2]) == 0);
+	xccdf_session_free(session);
+	return 0;
+}
@@ -0,0 +1,20 @@
+#!/usr/bin/env bash
+. $builddir/tests/test_common.sh
+
+set -e
+set -o pipefail
+
+name=$(basename $0 .sh)
+stderr=$(mktemp -t ${name}.out.XXXXXX)
+result=$(mktemp -t ${name}.res.XXXXXX)
+
+# The content is parsed while it is imported, the error at the end of
+# the document must not get lost.
+$OSCAP xccdf eval --skip-valid --results $result $srcdir/${name}.xccdf.xml 2> $stderr && false
+grep -Eq "Unable to parse XML|Failed to import XCCDF content" $stderr
+[ ! -s $result ]
+
+$OSCAP xccdf validate $srcdir/${name}.xccdf.xml 2> $stderr && false
+grep -q "Unable to parse XML" $stderr
+
+rm $stderr $result
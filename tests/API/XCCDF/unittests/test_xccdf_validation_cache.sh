@@ -0,0 +1,34 @@
+#!/usr/bin/env bash
+. $builddir/tests/test_common.sh
+
+set -e
+set -o pipefail
+
+name=$(basename $0 .sh)
+tmpdir=$(mktemp -d -t ${name}.XXXXXX)
+stderr=$tmpdir/stderr
+xccdf=$tmpdir/benchmark.xccdf.xml
+
+export OSCAP_VALIDATION_CACHE=$tmpdir/cache
+cp $srcdir/test_remediation_simple.xccdf.xml $xccdf
+
+# The first validation fills the cache, the second one uses it.
+$OSCAP --verbose DEVEL xccdf validate $xccdf 2> $stderr
+grep -q "skipping validation" $stderr && false
+$OSCAP --verbose DEVEL xccdf validate $xccdf 2> $stderr
+grep -q "Loaded 1 records from the validation cache" $stderr
+grep -q "skipping validation" $stderr
+
+# A modified file is validated again.
+sed -i 's|<version>1.0</version>|<version>1.0</version><foo/>|' $xccdf
+$OSCAP --verbose DEVEL xccdf validate $xccdf 2> $stderr && false
+grep -q "skipping validation" $stderr && false
+$OSCAP --verbose DEVEL xccdf validate $xccdf 2> $stderr && false
+grep -q "skipping validation" $stderr && false
+
+# A cache writable by others is ignored.
+chmod o+w $OSCAP_VALIDATION_CACHE
+$OSCAP --verbose DEVEL xccdf validate $srcdir/test_remediation_simple.xccdf.xml 2> $stderr
+grep -q "ignoring it" $stderr
+
+rm -rf $tmpdir
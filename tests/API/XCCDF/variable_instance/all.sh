@@ -543,6 +543,46 @@ function xccdf_eval_2_multiset(){
 	chmod u+w $tested_file ; rm $tested_file
 }
 
+#
+# Evaluate XCCDF while exporting two values from XCCDF document to an OVAL
+# external variable which is referenced only through a local variable. The
+# local variable has to be computed again for the second variable set.
+#
+function xccdf_eval_2_multiset_local(){
+	local oval_result="requires_local-oval.xml.result.xml"
+	local xccdf_result=$(mktemp -t ${FUNCNAME}.xml.XXXXXX)
+	local stderr=$(mktemp -t ${FUNCNAME}.err.XXXXXX)
+	local profile="xccdf_moc.elpmaxe.www_profile_12"
+	local tested_file="testing_file.xml"
+	echo "Stderr file = $stderr"
+	cp $srcdir/testing_file_300.xml $tested_file
+
+	for f in $oval_result $xccdf_result; do
+		[ ! -f $f ] || rm $f
+	done
+	local res=0
+	$OSCAP xccdf eval --profile $profile \
+		--oval-results --results $xccdf_result \
+		$srcdir/test_xccdf_variable_instance.xccdf.xml 2> $stderr || res=$?
+	[ $res -eq 2 ]
+	[ -f $stderr ]; [ ! -s $stderr ]
+	$OSCAP oval validate --schematron $oval_result
+	local result="$xccdf_result"
+	assert_exists 2 '/Benchmark/TestResult/rule-result/result[text()!="notselected"]'
+	assert_exists 1 '/Benchmark/TestResult/rule-result[@idref="xccdf_moc.elpmaxe.www_rule_15"]/result[text()="pass"]'
+	assert_exists 1 '/Benchmark/TestResult/rule-result[@idref="xccdf_moc.elpmaxe.www_rule_16"]/result[text()="fail"]'
+	result="$oval_result"
+	assert_exists 2 '/oval_results/results/system/definitions/definition'
+	assert_exists 1 '/oval_results/results/system/definitions/definition[@variable_instance="1" and @result="true"]'
+	assert_exists 1 '/oval_results/results/system/definitions/definition[@variable_instance="2" and @result="false"]'
+	assert_exists 1 '/oval_results/results/system/tests/test[not(@variable_instance)]/tested_variable[@variable_id="oval:com.example.www:var:2" and text() = "300"]'
+	assert_exists 1 '/oval_results/results/system/tests/test[@variable_instance="2"]/tested_variable[@variable_id="oval:com.example.www:var:2" and text() = "600"]'
+	rm $stderr
+	rm $xccdf_result
+	rm $oval_result
+	chmod u+w $tested_file ; rm $tested_file
+}
+
 #
 # Evaluate XCCDF while exporting two values from XCCDF document to a single OVAL
 # variable that it should result in multiple (two) variable sets each with a single
@@ -681,5 +721,6 @@ test_run "Export from XCCDF to variables: 3x3 the last is subset (multiset,multi
 
 test_run "Evaluate XCCDF: 2x1 values (multiset)" xccdf_eval_2_multiset
 test_run "Evaluate XCCDF: 2x1 values (multiset) in syschar" xccdf_eval_1_multiset_syschar
+test_run "Evaluate XCCDF: 2x1 values (multiset) through local variable" xccdf_eval_2_multiset_local
 
 test_exit
@@ -87,6 +87,46 @@ function test_crapi_mdigest {
     return 0
 }
 
+function test_crapi_mdigest_cache {
+    local TEMPDIR="$(make_temp_dir /tmp tmp)"
+
+    local sum_md5="";
+    local sum_sha1="";
+    local sum_sha256="";
+
+    export OSCAP_PROBE_FILEHASH_CACHE="${TEMPDIR}/cache"
+
+    dd if=/dev/urandom of="${TEMPDIR}/a" count=1   bs=1k || return 2
+    dd if=/dev/urandom of="${TEMPDIR}/b" count=1   bs=1024k || return 2
+
+    # the second run uses the cached digests, the third one follows a change of the file
+    for run in 1 2 3; do
+        if [[ $run -eq 3 ]]; then
+            echo "changed" >> "${TEMPDIR}/a" || return 2
+        fi
+
+        for file in a b; do
+            sum_md5=$((md5sum "${TEMPDIR}/${file}" || openssl md5 "${TEMPDIR}/${file}") | sed -n 's|^.*\([0-9a-f]\{32\}\).*$|\1|p')
+            sum_sha1=$((sha1sum "${TEMPDIR}/${file}" || openssl sha1 "${TEMPDIR}/${file}") | sed -n 's|^.*\([0-9a-f]\{40\}\).*$|\1|p')
+            sum_sha256=$((sha256sum "${TEMPDIR}/${file}" || openssl sha256 "${TEMPDIR}/${file}") | sed -n 's|^.*\([0-9a-f]\{64\}\).*$|\1|p')
+
+            if [[ "$sum_md5" == "" || "$sum_sha1" == "" || "$sum_sha256" == "" ]]; then
+                return 2
+            fi
+
+            ./test_crapi_mdigest "${TEMPDIR}/${file}" "$sum_md5" "$sum_sha1" "$sum_sha256" || return 1
+        done
+    done
+
+    # header and 3 records per file and run, except of the cached run
+    [ "$(wc -c < "${TEMPDIR}/cache")" -eq $((16 + 9 * 144)) ] || return 1
+
+    unset OSCAP_PROBE_FILEHASH_CACHE
+    rm -rf "$TEMPDIR"
+
+    return 0
+}
+
 # Testing.
 
 test_init
@@ -101,6 +141,7 @@ if [ -z ${CUSTOM_OSCAP+x} ] ; then
     test_run "test_crapi_digest_sha256" test_crapi_digest sha256
     if [[ "$OPENSCAP_ENABLE_MD5" == "ON"  && "$OPENSCAP_ENABLE_SHA1" == "ON" ]] ; then
         test_run "test_crapi_mdigest" test_crapi_mdigest
+        test_run "test_crapi_mdigest_cache" test_crapi_mdigest_cache
     fi
 fi
 
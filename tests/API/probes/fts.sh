@@ -14,18 +14,29 @@ function gen_tree {
 
 	mkdir -p $ROOT/{d1/{d11/d111,d12},d2/d21}
 	touch $ROOT/{d1/{d11/{d111/f1111,f111,f112,f113},d12/f121,f11},d2/{d21/f211,f21}}
+	mkdir -p $ROOT/d3
+	ln -s ../d2 $ROOT/d3/l2
+	ln -s .. $ROOT/d3/up
 }
 
 function oval_fts {
 	echo "=== $1 ==="
 	shift
-	./oval_fts_list "$@" | sort | tee ${tmpdir}/oval_fts_list.out | \
+	./oval_fts_list "${@:1:10}" | sort | tee ${tmpdir}/oval_fts_list.out | \
 		sed "s|${ROOT}/||" | tr '\n' ',' > ${tmpdir}/oval_fts_list.out2
 	if [ $? -ne 0 ]; then
 		echo "oval_fts_list failed"
 		return 2
 	fi
 
+	# the parallel traversal returns the same entries in the same order as the legacy one
+	OSCAP_PROBE_FTS_WORKERS=0 ./oval_fts_list "${@:1:10}" > ${tmpdir}/oval_fts_list.legacy
+	OSCAP_PROBE_FTS_WORKERS=4 ./oval_fts_list "${@:1:10}" > ${tmpdir}/oval_fts_list.parallel
+	if ! diff ${tmpdir}/oval_fts_list.legacy ${tmpdir}/oval_fts_list.parallel; then
+		echo "parallel traversal differs from the legacy one"
+		return 1
+	fi
+
 	shift 10
 	echo -e "expected result:\n$1\noval_fts_list.out2:"
 	cat ${tmpdir}/oval_fts_list.out2
@@ -242,6 +253,48 @@ test20 \
 "-1" "directories" "down" "local" \
 d1/d11/d111/f1111,
 
+# symlinks are followed with "symlinks and directories", cycles are skipped
+test21 \
+"equals" "$ROOT/d3" \
+"equals" "f21" \
+'' '' \
+"-1" "symlinks and directories" "down" "all" \
+d3/l2/f21,d3/up/d2/f21,
+
+test22 \
+"equals" "$ROOT/d3" \
+"equals" "f21" \
+'' '' \
+"-1" "directories" "down" "all" \
+# intentionally left blank
+
+test23 \
+"equals" "$ROOT/d3" \
+"equals" "" \
+'' '' \
+"1" "symlinks and directories" "down" "all" \
+d3/,d3/l2/,d3/up/,
+
 EOF
 
+# the parallel traversal returns the entries of the legacy one in the same order with any number of threads
+for filename in "" "f21"; do
+	OSCAP_PROBE_FTS_WORKERS=0 ./oval_fts_list "equals" "$ROOT" "equals" "$filename" '' '' \
+		"-1" "symlinks and directories" "down" "all" > ${tmpdir}/order0.out
+	[ -s ${tmpdir}/order0.out ]
+	for workers in 1 2 4 8; do
+		OSCAP_PROBE_FTS_WORKERS=$workers ./oval_fts_list "equals" "$ROOT" "equals" "$filename" '' '' \
+			"-1" "symlinks and directories" "down" "all" > ${tmpdir}/order.out
+		diff ${tmpdir}/order0.out ${tmpdir}/order.out
+	done
+done
+
+# the directory listings cached by the first traversal are read again once the directories change
+OSCAP_PROBE_FTS_WORKERS=4 ./oval_fts_list "equals" "$ROOT/d1" "pattern match" "^f" '' '' \
+	"-1" "symlinks and directories" "down" "all" "$ROOT/d1/d11/d111/f1112" > ${tmpdir}/changed.out
+sed '/^--$/,$d' ${tmpdir}/changed.out > ${tmpdir}/changed1.out
+sed '1,/^--$/d' ${tmpdir}/changed.out > ${tmpdir}/changed2.out
+echo "$ROOT/d1/d11/d111/f1112" | sort - ${tmpdir}/changed1.out | diff - <(sort ${tmpdir}/changed2.out)
+rm -f $ROOT/d1/d11/d111/f1112
+
 rm -rf $tmpdir
@@ -6,6 +6,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include "sexp.h"
 #include "oval_fts.h"
 #include "probe-api.h"
@@ -170,7 +173,7 @@ int main(int argc, char *argv[])
 
 	SEXP_t *path, *filename, *behaviors, *filepath, *result;
 
-	int ret = 0;
+	int ret = 0, pass, passes = argc > 11 ? 2 : 1;
 
 	if (argc < 11) {
 		fprintf(stderr, "Invalid usage -- too few arguments supplied.\n");
@@ -185,6 +188,8 @@ int main(int argc, char *argv[])
 		fprintf(stderr, "    argv[8]  - behaviors recurse\n");
 		fprintf(stderr, "    argv[9]  - behaviors recurse_direction\n");
 		fprintf(stderr, "    argv[10] - behaviors recurse_file_system\n");
+		fprintf(stderr, "\nOptionally:\n\n");
+		fprintf(stderr, "    argv[11] - file created after the traversal, which is then repeated\n");
 		return 1;
 	}
 
@@ -213,15 +218,30 @@ int main(int argc, char *argv[])
 		"filepath=%p\n"
 		"behaviors=%p\n", path, filename, filepath, behaviors);
 
-	ofts = oval_fts_open_prefixed(NULL, path, filename, filepath, behaviors, result);
+	for (pass = 0; pass < passes; ++pass) {
+		if (pass > 0) {
+			/* the second traversal has to see the new file */
+			int fd = open(argv[11], O_WRONLY | O_CREAT | O_EXCL, 0644);
 
-	if (ofts != NULL) {
-		while ((ofts_ent = oval_fts_read(ofts)) != NULL) {
-			printf("%s/%s\n", ofts_ent->path, ofts_ent->file ? ofts_ent->file : "");
-			oval_ftsent_free(ofts_ent);
+			if (fd < 0) {
+				fprintf(stderr, "Can't create '%s': %s\n", argv[11], strerror(errno));
+				return 1;
+			}
+
+			close(fd);
+			printf("--\n");
 		}
 
-		oval_fts_close(ofts);
+		ofts = oval_fts_open_prefixed(NULL, path, filename, filepath, behaviors, result);
+
+		if (ofts != NULL) {
+			while ((ofts_ent = oval_fts_read(ofts)) != NULL) {
+				printf("%s/%s\n", ofts_ent->path, ofts_ent->file ? ofts_ent->file : "");
+				oval_ftsent_free(ofts_ent);
+			}
+
+			oval_fts_close(ofts);
+		}
 	}
 
 	SEXP_free(path);
@@ -166,6 +166,106 @@ function test_eval_complex()
 	rm $arf
 }
 
+function test_eval_arf_stream()
+{
+	local name=${FUNCNAME}
+	local xccdf="$srcdir/sds_multiple_oval/multiple-oval-xccdf.xml"
+	local dir=$(mktemp -d -t ${name}.XXXXXX)
+	local stderr=$(mktemp -t ${name}.err.XXXXXX)
+	local result="$dir/arf.xml"
+
+	# The ARF is written as it is being built, the OVAL results are copied
+	pushd "$dir"
+	$OSCAP xccdf eval --oval-results --results-arf "$result" --report report.html \
+		"$xccdf" > /dev/null 2> $stderr || [ $? -eq 2 ]
+	popd
+	[ ! -s $stderr ]
+	$OSCAP ds rds-validate "$result" 2> $stderr
+	[ ! -s $stderr ]
+	assert_exists 2 '//rule-result/result[text()="fail"]'
+	assert_exists 2 '//report/content/oval_results'
+	[ -s "$dir/report.html" ]
+
+	# The embedded results are the same text as the result files
+	awk -v dir="$dir" '/<oval_results/ {n++; f=dir "/embedded" n} f {print > f} /<\/oval_results>/ {f=""}' "$result"
+	local f
+	for f in first-oval.xml.result.xml second-oval.xml.result.xml; do
+		local found=0
+		for embedded in "$dir"/embedded*; do
+			tail -n +2 "$dir/$f" | cmp -s - <(sed '1s/^ *//' "$embedded") && found=1
+		done
+		[ $found -eq 1 ]
+	done
+
+	# The ARF goes to the standard output, the report is generated from the same ARF
+	$OSCAP xccdf eval --results-arf - --report "$dir/report-stdout.html" \
+		"$xccdf" > "$dir/stdout" 2> $stderr || [ $? -eq 2 ]
+	[ ! -s $stderr ]
+	sed -n '/^<?xml/,/^<\/arf:asset-report-collection>/p' "$dir/stdout" > "$dir/arf-stdout.xml"
+	$OSCAP ds rds-validate "$dir/arf-stdout.xml" 2> $stderr
+	[ ! -s $stderr ]
+	result="$dir/arf-stdout.xml"
+	assert_exists 2 '//report/content/oval_results'
+	[ -s "$dir/report-stdout.html" ]
+
+	# The ARF streamed to the standard output, it's not validated then
+	env -u OSCAP_FULL_VALIDATION $OSCAP xccdf eval --results-arf - "$xccdf" > "$dir/stdout" 2> $stderr || [ $? -eq 2 ]
+	[ ! -s $stderr ]
+	sed -n '/^<?xml/,/^<\/arf:asset-report-collection>/p' "$dir/stdout" > "$dir/arf-stdout.xml"
+	$OSCAP ds rds-validate "$dir/arf-stdout.xml" 2> $stderr
+	[ ! -s $stderr ]
+	assert_exists 2 '//report/content/oval_results'
+
+	# Just the report, there is no ARF to write
+	$OSCAP xccdf eval --report "$dir/report-only.html" "$xccdf" > /dev/null 2> $stderr || [ $? -eq 2 ]
+	[ ! -s $stderr ]
+	[ -s "$dir/report-only.html" ]
+
+	rm -rf "$dir" $stderr
+}
+
+function test_eval_multiple_components()
+{
+	local name=${FUNCNAME}
+	local dir=$(mktemp -d -t ${name}.XXXXXX)
+	local stderr=$(mktemp -t ${name}.err.XXXXXX)
+	local result="$dir/arf.xml"
+
+	# Two checklists sharing an OVAL component, one of them also refers to an OCIL one
+	cp "$srcdir"/sds_multiple_components/*.xml "$dir"
+	chmod u+w "$dir"/*
+	pushd "$dir"
+	$OSCAP ds sds-compose checklist.xccdf.xml sds.xml 2> $stderr
+	$OSCAP ds sds-add other.xccdf.xml sds.xml 2>> $stderr
+	popd
+	[ ! -s $stderr ]
+	$OSCAP ds sds-validate "$dir/sds.xml" 2> $stderr
+	[ ! -s $stderr ]
+
+	# The OVAL components are copied out of the datastream when they are
+	# loaded, the OCIL one is never loaded and it's copied just before the
+	# ARF takes over the datastream. A stray read of the datastream after
+	# that shows up with the freed memory perturbed.
+	MALLOC_PERTURB_=165 $OSCAP xccdf eval --datastream-id scap_org.open-scap_datastream_from_xccdf_checklist.xccdf.xml \
+		--xccdf-id scap_org.open-scap_cref_checklist.xccdf.xml --results-arf "$result" \
+		"$dir/sds.xml" > /dev/null 2> $stderr || [ $? -eq 2 ]
+	[ ! -s $stderr ]
+	$OSCAP ds rds-validate "$result" 2> $stderr
+	[ ! -s $stderr ]
+	assert_exists 3 '//rule-result'
+	assert_exists 1 '//rule-result[@idref="xccdf_com.example.www_rule_pass"]/result[text()="pass"]'
+	assert_exists 1 '//rule-result[@idref="xccdf_com.example.www_rule_fail"]/result[text()="fail"]'
+	assert_exists 1 '//rule-result[@idref="xccdf_com.example.www_rule_ocil"]/result[text()="notchecked"]'
+	assert_exists 2 '//report/content/oval_results'
+
+	# All the components are left in the datastream embedded in the ARF
+	$OSCAP ds rds-split "$result" "$dir/split" 2> $stderr
+	[ ! -s $stderr ]
+	cmp "$dir/sds.xml" "$dir/split/report-request.xml"
+
+	rm -rf "$dir" $stderr
+}
+
 function test_oval_eval {
 
     $OSCAP oval eval "${srcdir}/$1"
@@ -285,6 +385,8 @@ test_init
 test_run "sds_external_xccdf_in_ds" test_sds_external_xccdf_in_ds
 test_run "sds_external_xccdf" test_sds_external_xccdf
 test_run "sds_tailoring" test_sds_tailoring sds_tailoring sds_tailoring/sds.ds.xml scap_com.example_datastream_with_tailoring xccdf_com.example_cref_tailoring_01 xccdf_com.example_profile_tailoring
+test_run "test_eval_arf_stream" test_eval_arf_stream
+test_run "test_eval_multiple_components" test_eval_multiple_components
 
 test_run "eval_simple" test_eval eval_simple/sds.xml
 test_run "cpe_in_ds" test_eval cpe_in_ds/sds.xml
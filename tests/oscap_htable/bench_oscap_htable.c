@@ -0,0 +1,126 @@
+/*
+ * Copyright 2026 Red Hat Inc., Durham, North Carolina.
+ * All Rights Reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * Micro-benchmark of oscap_htable. Tables of growing sizes are filled with
+ * keys which look like XCCDF rule IDs, then every key is looked up several
+ * times, half of the lookups miss. The time per operation should stay
+ * about the same as the tables grow.
+ *
+ * Usage: bench_oscap_htable [max_items]
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "common/list.h"
+
+#define BENCH_MAX_ITEMS_DEFAULT 1000000
+#define BENCH_LOOKUP_ROUNDS     4
+
+static double bench_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static char **bench_keys(size_t count, const char *prefix)
+{
+	char **keys = malloc(count * sizeof(char *));
+
+	for (size_t i = 0; i < count; i++) {
+		keys[i] = malloc(64);
+		snprintf(keys[i], 64, "xccdf_org.ssgproject.content_rule_%s_%zu", prefix, i);
+	}
+	return keys;
+}
+
+static void bench_keys_free(char **keys, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		free(keys[i]);
+	free(keys);
+}
+
+static int bench_run(size_t count)
+{
+	char **keys = bench_keys(count, "present");
+	char **missing = bench_keys(count, "missing");
+	struct oscap_htable *h = oscap_htable_new();
+	double start, insert, lookup;
+	size_t i, found = 0;
+	int round;
+
+	start = bench_now();
+	for (i = 0; i < count; i++) {
+		if (!oscap_htable_add(h, keys[i], (void *)(uintptr_t)(i + 1))) {
+			fprintf(stderr, "Failed to add '%s'\n", keys[i]);
+			return 1;
+		}
+	}
+	insert = bench_now() - start;
+
+	start = bench_now();
+	for (round = 0; round < BENCH_LOOKUP_ROUNDS; round++) {
+		for (i = 0; i < count; i++) {
+			if (oscap_htable_get(h, keys[i]) == (void *)(uintptr_t)(i + 1))
+				found++;
+			if (oscap_htable_get(h, missing[i]) != NULL) {
+				fprintf(stderr, "Found '%s' which hasn't been added\n", missing[i]);
+				return 1;
+			}
+		}
+	}
+	lookup = bench_now() - start;
+
+	if (found != count * BENCH_LOOKUP_ROUNDS || oscap_htable_itemcount(h) != count) {
+		fprintf(stderr, "Found %zu of %zu items\n", found, count * BENCH_LOOKUP_ROUNDS);
+		return 1;
+	}
+
+	printf("%10zu items: insert %8.1f ns/item, lookup %8.1f ns/lookup\n", count,
+	       insert * 1e9 / count, lookup * 1e9 / (2 * count * BENCH_LOOKUP_ROUNDS));
+
+	oscap_htable_free0(h);
+	bench_keys_free(keys, count);
+	bench_keys_free(missing, count);
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	size_t max_items = BENCH_MAX_ITEMS_DEFAULT;
+
+	if (argc > 1)
+		max_items = strtoul(argv[1], NULL, 10);
+
+	for (size_t count = 100; count <= max_items; count *= 10) {
+		if (bench_run(count) != 0)
+			return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,381 @@
+/*
+ * Copyright 2026 Red Hat Inc., Durham, North Carolina.
+ * All Rights Reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * Correctness tests of oscap_htable. Detached items stay in the items
+ * array until the table compacts it, these tests check that lookups,
+ * iteration and cloning never see them and that the order of insertion
+ * is kept across detaching, re-adding and compaction.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "common/list.h"
+
+#define TEST_KEY_SIZE 32
+
+int test_detach_readd(void);
+int test_detach_heavy(void);
+int test_clone(void);
+int test_iterator_after_detach(void);
+int test_random_operations(void);
+
+static void test_key(char *buf, size_t i)
+{
+	snprintf(buf, TEST_KEY_SIZE, "key_%zu", i);
+}
+
+static void *test_value(size_t i)
+{
+	return (void *)(uintptr_t)(i + 1);
+}
+
+/*
+ * Check that the table holds exactly the given keys in the given order,
+ * the value of key_N has to be N + 1.
+ */
+static int test_check_table(struct oscap_htable *h, const size_t *order, size_t count)
+{
+	char key[TEST_KEY_SIZE];
+	size_t i = 0;
+
+	if (oscap_htable_itemcount(h) != count) {
+		fprintf(stderr, "Table has %zu items instead of %zu.\n", oscap_htable_itemcount(h), count);
+		return 1;
+	}
+	for (i = 0; i < count; i++) {
+		test_key(key, order[i]);
+		if (oscap_htable_get(h, key) != test_value(order[i])) {
+			fprintf(stderr, "Lookup of '%s' failed.\n", key);
+			return 1;
+		}
+	}
+
+	struct oscap_htable_iterator *hit = oscap_htable_iterator_new(h);
+	for (i = 0; oscap_htable_iterator_has_more(hit); i++) {
+		const char *k;
+		void *v;
+
+		oscap_htable_iterator_next_kv(hit, &k, &v);
+		test_key(key, i < count ? order[i] : 0);
+		if (i >= count || strcmp(k, key) != 0 || v != test_value(order[i])) {
+			fprintf(stderr, "Iterator returned '%s' at position %zu.\n", k, i);
+			oscap_htable_iterator_free(hit);
+			return 1;
+		}
+	}
+	oscap_htable_iterator_free(hit);
+	if (i != count) {
+		fprintf(stderr, "Iterator returned %zu items instead of %zu.\n", i, count);
+		return 1;
+	}
+	return 0;
+}
+
+int test_detach_readd()
+{
+	char key[TEST_KEY_SIZE];
+	size_t order[] = {0, 2, 1};
+	int retval = 0;
+	struct oscap_htable *h = oscap_htable_new();
+
+	for (size_t i = 0; i < 3; i++) {
+		test_key(key, i);
+		oscap_htable_add(h, key, test_value(i));
+	}
+
+	if (oscap_htable_detach(h, "key_1") != test_value(1)) {
+		fprintf(stderr, "Detach didn't return the value of the item.\n");
+		retval = 1;
+	} else if (oscap_htable_get(h, "key_1") != NULL || oscap_htable_detach(h, "key_1") != NULL) {
+		fprintf(stderr, "Detached item is still in the table.\n");
+		retval = 1;
+	} else if (!oscap_htable_add(h, "key_1", test_value(1))) {
+		fprintf(stderr, "Detached key can't be added again.\n");
+		retval = 1;
+	} else if (oscap_htable_add(h, "key_1", test_value(1))) {
+		fprintf(stderr, "Re-added key has been added twice.\n");
+		retval = 1;
+	} else {
+		/* the re-added item is iterated as the last one */
+		retval = test_check_table(h, order, 3);
+	}
+	oscap_htable_free0(h);
+	return retval;
+}
+
+int test_detach_heavy()
+{
+	const size_t limit = 5000;
+	char key[TEST_KEY_SIZE];
+	size_t *order = malloc(limit * sizeof(size_t));
+	size_t count = 0;
+	int retval = 0;
+	struct oscap_htable *h = oscap_htable_new();
+
+	/*
+	 * Keep at most a few items alive while thousands are added and
+	 * detached, so that the items array is compacted many times.
+	 */
+	for (size_t i = 0; i < limit; i++) {
+		test_key(key, i);
+		if (!oscap_htable_add(h, key, test_value(i))) {
+			fprintf(stderr, "Failed to add '%s'.\n", key);
+			retval = 1;
+			goto cleanup;
+		}
+		if (i % 4 != 0) {
+			test_key(key, i - 1);
+			if (oscap_htable_detach(h, key) != test_value(i - 1)) {
+				fprintf(stderr, "Failed to detach '%s'.\n", key);
+				retval = 1;
+				goto cleanup;
+			}
+		}
+		if (i % 4 == 3)
+			order[count++] = i;
+	}
+	if (oscap_htable_get(h, "key_0") != NULL) {
+		fprintf(stderr, "Detached item is still in the table.\n");
+		retval = 1;
+		goto cleanup;
+	}
+	retval = test_check_table(h, order, count);
+
+	/* detach everything and start again */
+	for (size_t i = 0; retval == 0 && i < count; i++) {
+		test_key(key, order[i]);
+		oscap_htable_detach(h, key);
+	}
+	for (size_t i = 0; retval == 0 && i < count; i++) {
+		test_key(key, order[i]);
+		oscap_htable_add(h, key, test_value(order[i]));
+	}
+	if (retval == 0)
+		retval = test_check_table(h, order, count);
+
+cleanup:
+	oscap_htable_free0(h);
+	free(order);
+	return retval;
+}
+
+static int test_clone_count;
+
+static void *test_clone_value(void *value)
+{
+	test_clone_count++;
+	return (void *)((uintptr_t)value + 1000);
+}
+
+int test_clone()
+{
+	char key[TEST_KEY_SIZE];
+	size_t order[] = {1, 3, 5, 7, 9};
+	int retval = 0;
+	struct oscap_htable *h = oscap_htable_new();
+
+	for (size_t i = 0; i < 10; i++) {
+		test_key(key, i);
+		oscap_htable_add(h, key, test_value(i));
+	}
+	for (size_t i = 0; i < 10; i += 2) {
+		test_key(key, i);
+		oscap_htable_detach(h, key);
+	}
+
+	struct oscap_htable *clone = oscap_htable_clone(h, test_clone_value);
+	if (test_clone_count != 5) {
+		fprintf(stderr, "Cloner has been called %d times instead of 5.\n", test_clone_count);
+		retval = 1;
+		goto cleanup;
+	}
+
+	/* the clone keeps the order of the original, detached items are left out */
+	struct oscap_htable_iterator *hit = oscap_htable_iterator_new(clone);
+	for (size_t i = 0; i < 5; i++) {
+		const struct oscap_htable_item *item;
+
+		test_key(key, order[i]);
+		if (!oscap_htable_iterator_has_more(hit)
+		    || strcmp((item = oscap_htable_iterator_next(hit))->key, key) != 0
+		    || item->value != (void *)((uintptr_t)test_value(order[i]) + 1000)) {
+			fprintf(stderr, "Clone differs at position %zu.\n", i);
+			retval = 1;
+			break;
+		}
+	}
+	if (retval == 0 && oscap_htable_iterator_has_more(hit)) {
+		fprintf(stderr, "Clone has more items than the original.\n");
+		retval = 1;
+	}
+	oscap_htable_iterator_free(hit);
+	if (retval != 0)
+		goto cleanup;
+
+	/* the tables are independent of each other */
+	oscap_htable_detach(clone, "key_1");
+	oscap_htable_add(clone, "key_0", test_value(0));
+	if (oscap_htable_get(h, "key_1") != test_value(1) || oscap_htable_get(h, "key_0") != NULL) {
+		fprintf(stderr, "Change of the clone has changed the original.\n");
+		retval = 1;
+		goto cleanup;
+	}
+	retval = test_check_table(h, order, 5);
+
+cleanup:
+	oscap_htable_free0(clone);
+	oscap_htable_free0(h);
+	return retval;
+}
+
+int test_iterator_after_detach()
+{
+	char key[TEST_KEY_SIZE];
+	size_t order[] = {1, 2};
+	int retval = 0;
+	struct oscap_htable *h = oscap_htable_new();
+	struct oscap_htable_iterator *hit = oscap_htable_iterator_new(h);
+
+	if (oscap_htable_iterator_has_more(hit)) {
+		fprintf(stderr, "Iterator of an empty table has more items.\n");
+		retval = 1;
+		goto cleanup;
+	}
+
+	for (size_t i = 0; i < 5; i++) {
+		test_key(key, i);
+		oscap_htable_add(h, key, test_value(i));
+	}
+	/* detached items at the start, in the middle and at the end */
+	oscap_htable_detach(h, "key_0");
+	oscap_htable_detach(h, "key_3");
+	oscap_htable_detach(h, "key_4");
+	if ((retval = test_check_table(h, order, 2)) != 0)
+		goto cleanup;
+
+	/* an item detached during the iteration isn't returned */
+	oscap_htable_iterator_reset(hit);
+	if (strcmp(oscap_htable_iterator_next_key(hit), "key_1") != 0) {
+		fprintf(stderr, "Iterator didn't skip the detached first item.\n");
+		retval = 1;
+		goto cleanup;
+	}
+	oscap_htable_detach(h, "key_2");
+	if (oscap_htable_iterator_has_more(hit)) {
+		fprintf(stderr, "Iterator returns an item detached during the iteration.\n");
+		retval = 1;
+		goto cleanup;
+	}
+
+	/* reset starts over from the first item which is still present */
+	oscap_htable_iterator_reset(hit);
+	if (!oscap_htable_iterator_has_more(hit)
+	    || oscap_htable_iterator_next_value(hit) != test_value(1)
+	    || oscap_htable_iterator_has_more(hit)) {
+		fprintf(stderr, "Reset iterator doesn't return the only item.\n");
+		retval = 1;
+	}
+
+cleanup:
+	oscap_htable_iterator_free(hit);
+	oscap_htable_free0(h);
+	return retval;
+}
+
+int test_random_operations()
+{
+	const size_t keys = 300;
+	const size_t rounds = 100000;
+	char key[TEST_KEY_SIZE];
+	size_t *order = malloc(keys * sizeof(size_t));
+	size_t count = 0;
+	unsigned int seed = 12345;
+	int retval = 0;
+	struct oscap_htable *h = oscap_htable_new1(strcmp, 8);
+
+	/*
+	 * Compare the table with a plain array of the present keys in the
+	 * order of insertion, the pseudorandom sequence is fixed.
+	 */
+	for (size_t r = 0; r < rounds && retval == 0; r++) {
+		seed = seed * 1103515245 + 12345;
+		size_t k = (seed >> 8) % keys;
+		size_t pos;
+
+		for (pos = 0; pos < count && order[pos] != k; pos++)
+			;
+		test_key(key, k);
+		if (pos < count) {
+			if (oscap_htable_add(h, key, test_value(k))
+			    || oscap_htable_detach(h, key) != test_value(k)) {
+				fprintf(stderr, "Round %zu: add or detach of present '%s' failed.\n", r, key);
+				retval = 1;
+			}
+			memmove(&order[pos], &order[pos + 1], (count - pos - 1) * sizeof(size_t));
+			count--;
+		} else {
+			if (oscap_htable_get(h, key) != NULL || !oscap_htable_add(h, key, test_value(k))) {
+				fprintf(stderr, "Round %zu: add of absent '%s' failed.\n", r, key);
+				retval = 1;
+			}
+			order[count++] = k;
+		}
+		if (retval == 0 && r % 1000 == 0)
+			retval = test_check_table(h, order, count);
+	}
+	if (retval == 0)
+		retval = test_check_table(h, order, count);
+
+	oscap_htable_free0(h);
+	free(order);
+	return retval;
+}
+
+int main (int argc, char *argv[])
+{
+	int retval = 0;
+	if ((retval = test_detach_readd()) != 0 ) {
+		return retval;
+	}
+
+	if ((retval = test_detach_heavy()) != 0 ) {
+		return retval;
+	}
+
+	if ((retval = test_clone()) != 0 ) {
+		return retval;
+	}
+
+	if ((retval = test_iterator_after_detach()) != 0 ) {
+		return retval;
+	}
+
+	if ((retval = test_random_operations()) != 0 ) {
+		return retval;
+	}
+
+	return retval;
+}
@@ -0,0 +1,27 @@
+#!/usr/bin/env bash
+
+# Copyright 2026 Red Hat Inc., Durham, North Carolina.
+# All Rights Reserved.
+#
+# OpenScap Test Suite
+
+. $builddir/tests/test_common.sh
+
+# Test cases.
+
+# Run the benchmark with small tables only, it checks the looked up values
+# as well. Run ./bench_oscap_htable without arguments to get the timings
+# for tables of up to 1M items.
+function test_oscap_htable_bench {
+    ./bench_oscap_htable 10000
+}
+
+# Testing.
+
+test_init
+
+if [ -z ${CUSTOM_OSCAP+x} ] ; then
+    test_run "test_oscap_htable_bench" test_oscap_htable_bench
+fi
+
+test_exit
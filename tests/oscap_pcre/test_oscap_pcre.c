@@ -0,0 +1,233 @@
+/*
+ * Copyright 2026 Red Hat Inc., Durham, North Carolina.
+ * All Rights Reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "common/oscap_pcre.h"
+
+#define TEST_THREADS 8
+#define TEST_THREAD_MATCHES 10000
+/* deep enough to exhaust the default JIT stack */
+#define TEST_DEEP_SUBJECT_LEN 100000
+
+static int test_exec(void)
+{
+	char *err = NULL;
+	int erroffset = 0;
+	int ovector[12];
+	int ret = 0;
+	int rc;
+
+	oscap_pcre_t *re = oscap_pcre_compile("^(a+)(x)?(b+)$", OSCAP_PCRE_OPTS_NONE, &err, &erroffset);
+	if (re == NULL) {
+		fprintf(stderr, "Failed to compile the pattern: %s\n", err);
+		oscap_pcre_err_free(err);
+		return 1;
+	}
+
+	rc = oscap_pcre_exec(re, "aabbb", 5, 0, OSCAP_PCRE_OPTS_NONE, ovector, 12);
+	if (rc != 4 || ovector[0] != 0 || ovector[1] != 5 || ovector[2] != 0 || ovector[3] != 2
+			|| ovector[4] != -1 || ovector[5] != -1 || ovector[6] != 2 || ovector[7] != 5) {
+		fprintf(stderr, "Unexpected match of 'aabbb': %d\n", rc);
+		ret = 1;
+	}
+	/* the ovector is too small for all the substrings */
+	rc = oscap_pcre_exec(re, "aabbb", 5, 0, OSCAP_PCRE_OPTS_NONE, ovector, 6);
+	if (rc != 0 || ovector[0] != 0 || ovector[1] != 5 || ovector[2] != 0 || ovector[3] != 2) {
+		fprintf(stderr, "Unexpected match of 'aabbb' with a small ovector: %d\n", rc);
+		ret = 1;
+	}
+	rc = oscap_pcre_exec(re, "ab", 2, 0, OSCAP_PCRE_OPTS_NONE, NULL, 0);
+	if (rc != 0) {
+		fprintf(stderr, "Unexpected match of 'ab' without an ovector: %d\n", rc);
+		ret = 1;
+	}
+	rc = oscap_pcre_exec(re, "aaxc", 4, 0, OSCAP_PCRE_OPTS_NONE, ovector, 12);
+	if (rc != OSCAP_PCRE_ERR_NOMATCH) {
+		fprintf(stderr, "Unexpected match of 'aaxc': %d\n", rc);
+		ret = 1;
+	}
+	oscap_pcre_free(re);
+
+	re = oscap_pcre_compile("a(", OSCAP_PCRE_OPTS_NONE, &err, &erroffset);
+	if (re != NULL || err == NULL || erroffset != 2) {
+		fprintf(stderr, "Invalid pattern has been compiled.\n");
+		ret = 1;
+	}
+	oscap_pcre_err_free(err);
+	oscap_pcre_free(re);
+	return ret;
+}
+
+static int test_cache_hits(void)
+{
+	int ret = 0;
+
+	oscap_pcre_cache_reset();
+	oscap_pcre_t *re1 = oscap_pcre_get_cached("^abc", OSCAP_PCRE_OPTS_NONE, NULL, NULL);
+	oscap_pcre_t *re2 = oscap_pcre_get_cached("^abc", OSCAP_PCRE_OPTS_NONE, NULL, NULL);
+	/* the options of the match don't make a different expression */
+	oscap_pcre_t *re3 = oscap_pcre_get_cached("^abc", OSCAP_PCRE_OPTS_NO_UTF8_CHECK, NULL, NULL);
+	oscap_pcre_t *re4 = oscap_pcre_get_cached("^abc", OSCAP_PCRE_OPTS_CASELESS, NULL, NULL);
+	if (re1 == NULL || re1 != re2 || re1 != re3) {
+		fprintf(stderr, "The cached expression hasn't been reused.\n");
+		ret = 1;
+	}
+	if (re4 == NULL || re4 == re1) {
+		fprintf(stderr, "The expression compiled with other options has been reused.\n");
+		ret = 1;
+	}
+	if (re4 != NULL && oscap_pcre_exec(re4, "ABC", 3, 0, OSCAP_PCRE_OPTS_NONE, NULL, 0) != 0) {
+		fprintf(stderr, "The caseless expression doesn't match.\n");
+		ret = 1;
+	}
+	if (oscap_pcre_get_cached("a(", OSCAP_PCRE_OPTS_NONE, NULL, NULL) != NULL) {
+		fprintf(stderr, "Invalid pattern has been compiled.\n");
+		ret = 1;
+	}
+	oscap_pcre_free(re1);
+	oscap_pcre_free(re2);
+	oscap_pcre_free(re3);
+	oscap_pcre_free(re4);
+	oscap_pcre_cache_reset();
+	return ret;
+}
+
+static int test_cache_refs(void)
+{
+	int ret = 0;
+
+	oscap_pcre_cache_reset();
+	oscap_pcre_t *re1 = oscap_pcre_get_cached("b+$", OSCAP_PCRE_OPTS_NONE, NULL, NULL);
+	oscap_pcre_t *re2 = oscap_pcre_get_cached("b+$", OSCAP_PCRE_OPTS_NONE, NULL, NULL);
+	if (re1 == NULL || re2 != re1) {
+		fprintf(stderr, "The cached expression hasn't been reused.\n");
+		oscap_pcre_free(re1);
+		oscap_pcre_free(re2);
+		return 1;
+	}
+
+	/* released by the first user, still referenced by the cache and the second one */
+	oscap_pcre_free(re1);
+	if (oscap_pcre_exec(re2, "abb", 3, 0, OSCAP_PCRE_OPTS_NONE, NULL, 0) != 0) {
+		fprintf(stderr, "The expression doesn't match after a reference was released.\n");
+		ret = 1;
+	}
+	/* dropped from the cache, the second user keeps it alive */
+	oscap_pcre_cache_reset();
+	if (oscap_pcre_exec(re2, "abb", 3, 0, OSCAP_PCRE_OPTS_NONE, NULL, 0) != 0) {
+		fprintf(stderr, "The expression doesn't match after the cache was reset.\n");
+		ret = 1;
+	}
+	oscap_pcre_t *re3 = oscap_pcre_get_cached("b+$", OSCAP_PCRE_OPTS_NONE, NULL, NULL);
+	if (re3 == NULL || oscap_pcre_exec(re3, "ab", 2, 0, OSCAP_PCRE_OPTS_NONE, NULL, 0) != 0) {
+		fprintf(stderr, "The expression hasn't been compiled again.\n");
+		ret = 1;
+	}
+	oscap_pcre_free(re2);
+	oscap_pcre_free(re3);
+	oscap_pcre_cache_reset();
+	return ret;
+}
+
+static int test_jit_fallback(void)
+{
+	int ret = 0;
+	int ovector[6];
+	char *subject = malloc(TEST_DEEP_SUBJECT_LEN + 2);
+	if (subject == NULL)
+		return 1;
+	memset(subject, 'a', TEST_DEEP_SUBJECT_LEN);
+	strcpy(subject + TEST_DEEP_SUBJECT_LEN, "c");
+
+	/* every iteration of the group takes a frame of the JIT stack */
+	oscap_pcre_t *re = oscap_pcre_get_cached("(a|b)*c", OSCAP_PCRE_OPTS_NONE, NULL, NULL);
+	if (re == NULL) {
+		free(subject);
+		return 1;
+	}
+	int rc = oscap_pcre_exec(re, subject, TEST_DEEP_SUBJECT_LEN + 1, 0, OSCAP_PCRE_OPTS_NONE, ovector, 6);
+	if (rc != 2 || ovector[0] != 0 || ovector[1] != TEST_DEEP_SUBJECT_LEN + 1) {
+		fprintf(stderr, "The deep match failed: %d\n", rc);
+		ret = 1;
+	}
+	oscap_pcre_free(re);
+	free(subject);
+	oscap_pcre_cache_reset();
+	return ret;
+}
+
+static void *test_threads_worker(void *arg)
+{
+	const char *subjects[] = { "key = value", "key=", "nokey" };
+	const int expected[] = { 3, 3, OSCAP_PCRE_ERR_NOMATCH };
+	long failed = 0;
+
+	for (int i = 0; i < TEST_THREAD_MATCHES; ++i) {
+		int ovector[9];
+		int j = i % 3;
+		oscap_pcre_t *re = oscap_pcre_get_cached("^(\\w+)\\s*=\\s*(.*)$", OSCAP_PCRE_OPTS_NONE, NULL, NULL);
+		int rc = oscap_pcre_exec(re, subjects[j], strlen(subjects[j]), 0, OSCAP_PCRE_OPTS_NONE, ovector, 9);
+		if (rc != expected[j] || (rc == 3 && (ovector[2] != 0 || ovector[3] != 3)))
+			failed++;
+		oscap_pcre_free(re);
+	}
+	return (void *) failed;
+}
+
+static int test_threads(void)
+{
+	pthread_t threads[TEST_THREADS];
+	int ret = 0;
+
+	oscap_pcre_cache_reset();
+	for (int i = 0; i < TEST_THREADS; ++i) {
+		if (pthread_create(&threads[i], NULL, test_threads_worker, NULL) != 0)
+			return 1;
+	}
+	for (int i = 0; i < TEST_THREADS; ++i) {
+		void *failed = NULL;
+		pthread_join(threads[i], &failed);
+		if (failed != NULL) {
+			fprintf(stderr, "%ld matches of a shared expression failed.\n", (long) failed);
+			ret = 1;
+		}
+	}
+	oscap_pcre_cache_reset();
+	return ret;
+}
+
+int main(int argc, char *argv[])
+{
+	int ret = 0;
+
+	ret |= test_exec();
+	ret |= test_cache_hits();
+	ret |= test_cache_refs();
+	ret |= test_jit_fallback();
+	ret |= test_threads();
+
+	return ret;
+}
@@ -0,0 +1,114 @@
+#!/usr/bin/env bash
+
+# Copyright 2026 Red Hat Inc., Durham, North Carolina.
+# All Rights Reserved.
+#
+# OpenScap Test Suite
+#
+# Compares the built-in HTML report generator with the xccdf-report.xsl
+# transformation of the ARF. A benchmark with given number of rules, each
+# checked by an OVAL definition, is evaluated with both report generators,
+# the time of the evaluations is printed and the report of the built-in
+# generator is checked to be the same as the report generated from the ARF.
+#
+# Usage: bench_report.sh [RULES]
+
+set -e -o pipefail
+
+rules=${1:-5000}
+OSCAP=${OSCAP:-oscap}
+workdir=$(mktemp -d -t bench_report.XXXXXX)
+trap 'rm -rf "$workdir"' EXIT
+
+oval="$workdir/bench.oval.xml"
+xccdf="$workdir/bench.xccdf.xml"
+
+{
+	cat <<EOF
+<?xml version="1.0"?>
+<oval_definitions xmlns:oval="http://oval.mitre.org/XMLSchema/oval-common-5" xmlns:ind="http://oval.mitre.org/XMLSchema/oval-definitions-5#independent" xmlns="http://oval.mitre.org/XMLSchema/oval-definitions-5">
+  <generator>
+    <oval:schema_version>5.10.1</oval:schema_version>
+    <oval:timestamp>0001-01-01T00:00:00+00:00</oval:timestamp>
+  </generator>
+EOF
+	echo "  <definitions>"
+	for i in $(seq $rules); do
+		cat <<EOF
+    <definition class="compliance" version="1" id="oval:x:def:$i">
+      <metadata><title>Definition $i</title><description>Variable $i equals $((i % 2))</description></metadata>
+      <criteria><criterion test_ref="oval:x:tst:$i" comment="variable $i"/></criteria>
+    </definition>
+EOF
+	done
+	echo "  </definitions>"
+	echo "  <tests>"
+	for i in $(seq $rules); do
+		cat <<EOF
+    <ind:variable_test id="oval:x:tst:$i" version="1" check="all" comment="oval:x:var:$i should equal 0">
+      <ind:object object_ref="oval:x:obj:$i"/>
+      <ind:state state_ref="oval:x:ste:1"/>
+    </ind:variable_test>
+EOF
+	done
+	echo "  </tests>"
+	echo "  <objects>"
+	for i in $(seq $rules); do
+		echo "    <ind:variable_object id=\"oval:x:obj:$i\" version=\"1\"><ind:var_ref>oval:x:var:$i</ind:var_ref></ind:variable_object>"
+	done
+	echo "  </objects>"
+	echo "  <states>"
+	echo "    <ind:variable_state id=\"oval:x:ste:1\" version=\"1\"><ind:value datatype=\"int\">0</ind:value></ind:variable_state>"
+	echo "  </states>"
+	echo "  <variables>"
+	for i in $(seq $rules); do
+		echo "    <constant_variable id=\"oval:x:var:$i\" datatype=\"int\" version=\"1\" comment=\"variable $i\"><value>$((i % 2))</value></constant_variable>"
+	done
+	echo "  </variables>"
+	echo "</oval_definitions>"
+} > "$oval"
+
+{
+	cat <<EOF
+<?xml version="1.0" encoding="UTF-8"?>
+<Benchmark xmlns="http://checklists.nist.gov/xccdf/1.2" id="xccdf_org.open-scap_benchmark_report" resolved="1">
+  <status>accepted</status>
+  <title>Report benchmark</title>
+  <version>1.0</version>
+EOF
+	for i in $(seq $rules); do
+		cat <<EOF
+  <Rule selected="true" id="xccdf_org.open-scap_rule_$i" severity="medium">
+    <title>Rule $i</title>
+    <description>Checks that variable $i equals 0.</description>
+    <ident system="https://example.org/ident">EXAMPLE-$i</ident>
+    <check system="http://oval.mitre.org/XMLSchema/oval-definitions-5">
+      <check-content-ref href="bench.oval.xml" name="oval:x:def:$i"/>
+    </check>
+  </Rule>
+EOF
+	done
+	echo "</Benchmark>"
+} > "$xccdf"
+
+# Runs the evaluation and prints the elapsed time in milliseconds
+function eval_report {
+	local start=$(date +%s%N)
+	$OSCAP xccdf eval --skip-validation "$@" "$xccdf" > /dev/null || [ $? -eq 2 ]
+	echo $(( ($(date +%s%N) - start) / 1000000 ))
+}
+
+pushd "$workdir" > /dev/null
+time_none=$(eval_report --results-arf none.arf.xml)
+time_xslt=$(eval_report --results-arf xslt.arf.xml --report xslt.html)
+time_native=$(OSCAP_REPORT_GENERATOR=native eval_report --results-arf native.arf.xml --report native.html)
+$OSCAP xccdf generate report native.arf.xml > native.arf.html
+popd > /dev/null
+
+echo "rules: $rules"
+echo "evaluation without report: $time_none ms"
+echo "evaluation with XSLT report: $time_xslt ms"
+echo "evaluation with native report: $time_native ms"
+
+[ -s "$workdir/xslt.html" ]
+cmp "$workdir/native.html" "$workdir/native.arf.html"
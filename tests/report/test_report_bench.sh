@@ -0,0 +1,27 @@
+#!/usr/bin/env bash
+
+# Copyright 2026 Red Hat Inc., Durham, North Carolina.
+# All Rights Reserved.
+#
+# OpenScap Test Suite
+
+. $builddir/tests/test_common.sh
+
+# Test cases.
+
+# Run the benchmark with a small benchmark only, it checks the built-in
+# report is the same as the report generated from the ARF as well. Run
+# bench_report.sh without arguments to get the timings for 5000 rules.
+function test_report_bench {
+    bash $srcdir/bench_report.sh 100
+}
+
+# Testing.
+
+test_init
+
+if [ -z ${CUSTOM_OSCAP+x} ] ; then
+    test_run "test_report_bench" test_report_bench
+fi
+
+test_exit
@@ -0,0 +1,70 @@
+#!/usr/bin/env bash
+
+# Copyright 2026 Red Hat Inc., Durham, North Carolina.
+# All Rights Reserved.
+#
+# OpenScap Test Suite
+#
+# Checks that the built-in report generator (OSCAP_REPORT_GENERATOR=native)
+# writes the same HTML report as the xccdf-report.xsl transformation of the
+# ARF, which is the default report generator. Contents the built-in generator
+# doesn't support have to fall back to the transformation.
+
+. $builddir/tests/test_common.sh
+
+set -e -o pipefail
+
+# Test cases.
+
+# test_report_generators <native|xslt> <content> [eval options]
+function test_report_generators {
+    local generator="$1"
+    local content="$2"
+    shift 2
+    local workdir=$(make_temp_dir /tmp report_generators)
+
+    pushd "$workdir" > /dev/null
+    OSCAP_REPORT_GENERATOR=native $OSCAP --verbose INFO --verbose-log-file native.log \
+        xccdf eval --results-arf native.arf.xml --report native.html "$@" "$content" \
+        > /dev/null || [ $? -eq 2 ]
+    $OSCAP xccdf generate report native.arf.xml > xslt.html
+    $OSCAP xccdf eval --report default.html "$@" "$content" > /dev/null || [ $? -eq 2 ]
+    popd > /dev/null
+
+    local ret=0
+    cmp "$workdir/native.html" "$workdir/xslt.html" || ret=1
+    grep -q "OpenSCAP Evaluation Report" "$workdir/default.html" || ret=1
+    if [ "$generator" == "native" ] ; then
+        grep -q "built-in generator doesn't support" "$workdir/native.log" && ret=1
+    else
+        grep -q "built-in generator doesn't support" "$workdir/native.log" || ret=1
+    fi
+    rm -rf "$workdir"
+    return $ret
+}
+
+# Testing.
+
+test_init
+
+if [ -z ${CUSTOM_OSCAP+x} ] ; then
+    test_run "report generators on ds.xml" test_report_generators native $srcdir/ds.xml
+    for content in $srcdir/../oval_details/*.xccdf.xml \
+            $srcdir/../API/XCCDF/unittests/test_xccdf_sub_title.xccdf.xml \
+            $srcdir/../API/XCCDF/unittests/test_xccdf_role_unscored.xccdf.xml ; do
+        test_run "report generators on $(basename $content)" test_report_generators native $content
+    done
+    test_run "report generators on references, sets and namespaces" test_report_generators native \
+        $srcdir/test_report_generators.xccdf.xml --skip-valid
+    test_run "report generators on a profile" test_report_generators native \
+        $srcdir/test_report_generators.xccdf.xml --skip-valid --profile xccdf_moc.elpmaxe.www_profile_1
+    test_run "report generators on a tailoring" test_report_generators native \
+        $srcdir/test_report_generators.xccdf.xml --skip-valid \
+        --tailoring-file $srcdir/test_report_generators.tailoring.xml --profile xccdf_moc.elpmaxe.www_profile_2
+    test_run "report generators on an unresolved benchmark" test_report_generators xslt \
+        $srcdir/test_report_generators_unresolved.xccdf.xml
+    test_run "report generators on literal attributes" test_report_generators xslt \
+        $srcdir/test_report_generators_literals.xccdf.xml
+fi
+
+test_exit
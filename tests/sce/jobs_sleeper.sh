@@ -0,0 +1,9 @@
+#!/usr/bin/env bash
+
+# Record when the script ran, the stamps are checked by test_sce_jobs.sh
+stamps="$(dirname "$0")/stamps"
+start=$(date +%s%N)
+sleep 1
+echo "$start $(date +%s%N)" >> "$stamps"
+echo "result $XCCDF_VALUE_result"
+eval exit \$XCCDF_RESULT_$XCCDF_VALUE_result
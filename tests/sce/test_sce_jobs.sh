@@ -0,0 +1,56 @@
+#!/usr/bin/env bash
+
+# Test the SCE checks of more rules are evaluated at once with --jobs
+# and the results are the same as the results of the serial evaluation.
+
+. $builddir/tests/test_common.sh
+
+set -e -o pipefail
+
+# Succeed if some of the scripts run at the same time. The scripts write
+# the nanoseconds when they started and ended to the stamps file.
+function stamps_overlap {
+    sort -n "$1" | awk '
+        NR > 1 && $1 < end { overlap = 1 }
+        $2 > end { end = $2 }
+        END { exit !overlap }'
+}
+
+function test_sce_jobs {
+
+    local jobs=$1
+    local workdir=$(mktemp -d)
+    shift
+    for file in "$@" jobs_sleeper.sh; do
+        cp "${srcdir}/$file" "$workdir"
+    done
+    local xccdf_file="$workdir/$1"
+
+    $OSCAP xccdf eval --progress --results "$workdir/result.xml" "$xccdf_file" > $workdir/stdout || [ $? -eq 2 ]
+    ! stamps_overlap "$workdir/stamps"
+    rm "$workdir/stamps"
+    $OSCAP --verbose INFO --verbose-log-file "$workdir/log" xccdf eval --jobs $jobs --progress --results "$workdir/result_jobs.xml" "$xccdf_file" > $workdir/stdout_jobs || [ $? -eq 2 ]
+    echo "===== result ====="
+    cat $workdir/result_jobs.xml
+
+    stamps_overlap "$workdir/stamps"
+    diff $workdir/stdout $workdir/stdout_jobs
+    diff <(sed -E 's/(start-time|end-time|time)="[^"]*"//g' $workdir/result.xml) \
+         <(sed -E 's/(start-time|end-time|time)="[^"]*"//g' $workdir/result_jobs.xml)
+    grep -q '<check-import import-name="stdout">result FAIL' $workdir/result_jobs.xml
+    # the objects of the OVAL definitions of the following rules are
+    # collected by the family and environmentvariable58 probes at once
+    if [ $# -gt 1 ]; then
+        grep -q "Collecting 2 objects using 2 probes" $workdir/log
+    fi
+
+    rm -r "$workdir"
+}
+
+# Testing.
+test_init
+
+test_run "SCE checks evaluated by more jobs" test_sce_jobs 5 test_sce_jobs.xccdf.xml
+test_run "SCE and OVAL checks evaluated by more jobs" test_sce_jobs 4 test_sce_jobs_mixed.xccdf.xml test_sce_jobs_mixed.oval.xml
+
+test_exit
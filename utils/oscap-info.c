@@ -280,9 +280,12 @@ static inline void _print_xccdf_tailoring_header(struct xccdf_tailoring *tailori
 	printf("%sBenchmark Hint: %s\n", prefix ? prefix : "", xccdf_tailoring_get_benchmark_ref(tailoring));
 }
 
-static inline void _print_xccdf_tailoring(struct oscap_source *source, const char *prefix, void (*print_one_profile)(const struct xccdf_profile *, const char *))
+static inline int _print_xccdf_tailoring(struct oscap_source *source, const char *prefix, void (*print_one_profile)(const struct xccdf_profile *, const char *))
 {
 	struct xccdf_tailoring *tailoring = xccdf_tailoring_import_source(source, NULL);
+	if (tailoring == NULL) {
+		return OSCAP_ERROR;
+	}
 	_print_xccdf_tailoring_header(tailoring, prefix);
 
 	struct xccdf_profile_iterator *prof_it = xccdf_tailoring_get_profiles(tailoring);
@@ -290,6 +293,7 @@ static inline void _print_xccdf_tailoring(struct oscap_source *source, const cha
 	xccdf_profile_iterator_free(prof_it);
 
 	xccdf_tailoring_free(tailoring);
+	return OSCAP_OK;
 }
 
 static void _print_single_benchmark_profiles_only(struct xccdf_benchmark *bench)
@@ -340,7 +344,12 @@ static int app_info_single_ds_profiles_only(struct ds_stream_index_iterator* sds
 			xccdf_benchmark_free(bench);
 
 		} else if (oscap_source_get_scap_type(xccdf_source) == OSCAP_DOCUMENT_XCCDF_TAILORING) {
-			_print_xccdf_tailoring(xccdf_source, 0, _print_xccdf_profile_terse);
+			if (_print_xccdf_tailoring(xccdf_source, 0, _print_xccdf_profile_terse) != OSCAP_OK) {
+				oscap_string_iterator_free(checklist_it);
+				ds_stream_index_iterator_free(sds_it);
+				ds_sds_session_free(session);
+				return OSCAP_ERROR;
+			}
 		}
 		ds_sds_session_reset(session);
 	}
@@ -465,7 +474,12 @@ static int app_info_single_ds_all(struct ds_stream_index_iterator* sds_it, struc
 			_print_xccdf_benchmark(bench, prefix, 0);
 			// bench is freed as a side-effect of the function above
 		} else if (oscap_source_get_scap_type(xccdf_source) == OSCAP_DOCUMENT_XCCDF_TAILORING) {
-			_print_xccdf_tailoring(xccdf_source, prefix, 0);
+			if (_print_xccdf_tailoring(xccdf_source, prefix, 0) != OSCAP_OK) {
+				oscap_string_iterator_free(checklist_it);
+				ds_stream_index_iterator_free(sds_it);
+				ds_sds_session_free(session);
+				return OSCAP_ERROR;
+			}
 		}
 		ds_sds_session_reset(session);
 	}
@@ -729,7 +743,8 @@ static int app_info(const struct oscap_action *action)
 	case OSCAP_DOCUMENT_XCCDF_TAILORING:
 		printf("Document type: XCCDF Tailoring\n");
 		print_time(action->file);
-		_print_xccdf_tailoring(source, "", 0);
+		if (_print_xccdf_tailoring(source, "", 0) != OSCAP_OK)
+			goto cleanup;
 	break;
 	case OSCAP_DOCUMENT_CVE_FEED:
 		printf("Document type: CVE Feed\n");
@@ -176,6 +176,7 @@ struct oscap_action {
 	char *verbosity_level;
 	char *fix_type;
 	char *local_files;
+	unsigned int jobs;
 };
 
 int app_xslt(const char *infile, const char *xsltfile, const char *outfile, const char **params);
@@ -178,6 +178,9 @@ static struct oscap_module XCCDF_EVAL = {
 		"                                   Format is \"$rule_id:$result\\n\".\n"
 		"   --progress-full               - Switch to sparse but a bit more saturated output also suitable for progress reporting.\n"
 		"                                   Format is \"$rule_id|$rule_title|$result\\n\".\n"
+		"   --jobs <N>                    - Evaluate up to N rules at once. Only the checks of the engines\n"
+		"                                   running each check in its own process (SCE) run in parallel,\n"
+		"                                   the OVAL probes collect the objects of more rules at once.\n"
 		"   --datastream-id <id>          - ID of the data stream in the collection to use.\n"
 		"                                   (only applicable for source data streams)\n"
 		"   --xccdf-id <id>               - ID of component-ref with XCCDF in the data stream that should be evaluated.\n"
@@ -637,6 +640,7 @@ int app_evaluate_xccdf(const struct oscap_action *action)
 		xccdf_session_skip_rule(session, rid);
 	}
 	oscap_string_iterator_free(sit);
+	xccdf_session_set_jobs(session, action->jobs);
 
 	if (xccdf_session_load(session) != 0)
 		goto cleanup;
@@ -671,6 +675,9 @@ int app_evaluate_xccdf(const struct oscap_action *action)
 	xccdf_session_set_oval_results_export(session, action->oval_results);
 	xccdf_session_set_oval_variables_export(session, action->export_variables);
 	xccdf_session_set_arf_export(session, action->f_results_arf);
+	xccdf_session_set_xccdf_export(session, action->f_results);
+	xccdf_session_set_xccdf_stig_viewer_export(session, action->f_results_stig);
+	xccdf_session_set_report_export(session, action->f_report);
 
 	if (xccdf_session_export_oval(session) != 0)
 		goto cleanup;
@@ -701,9 +708,6 @@ int app_evaluate_xccdf(const struct oscap_action *action)
 	syslog(priority, "Evaluation finished. Return code: %d, Base score %f.", evaluation_result, xccdf_session_get_base_score(session));
 #endif
 
-	xccdf_session_set_xccdf_export(session, action->f_results);
-	xccdf_session_set_xccdf_stig_viewer_export(session, action->f_results_stig);
-	xccdf_session_set_report_export(session, action->f_report);
 	if (xccdf_session_export_all(session) != 0)
 		goto cleanup;
 
@@ -1200,7 +1204,8 @@ enum oval_opt {
     XCCDF_OPT_OUTPUT = 'o',
     XCCDF_OPT_RESULT_ID = 'i',
 	XCCDF_OPT_FIX_TYPE,
-	XCCDF_OPT_LOCAL_FILES
+	XCCDF_OPT_LOCAL_FILES,
+	XCCDF_OPT_JOBS
 };
 
 bool getopt_xccdf(int argc, char **argv, struct oscap_action *action)
@@ -1234,6 +1239,7 @@ bool getopt_xccdf(int argc, char **argv, struct oscap_action *action)
 		{"sce-template", 	required_argument, NULL, XCCDF_OPT_SCE_TEMPLATE},
 		{"fix-type", required_argument, NULL, XCCDF_OPT_FIX_TYPE},
 		{"local-files", required_argument, NULL, XCCDF_OPT_LOCAL_FILES},
+		{"jobs", required_argument, NULL, XCCDF_OPT_JOBS},
 	// flags
 		{"force",		no_argument, &action->force, 1},
 		{"oval-results",	no_argument, &action->oval_results, 1},
@@ -1297,6 +1303,15 @@ bool getopt_xccdf(int argc, char **argv, struct oscap_action *action)
 		case XCCDF_OPT_LOCAL_FILES:
 			action->local_files = optarg;
 			break;
+		case XCCDF_OPT_JOBS:
+		{
+			char *end = NULL;
+			unsigned long jobs = strtoul(optarg, &end, 10);
+			if (*optarg == '\0' || *end != '\0' || jobs == 0 || jobs > 1024)
+				return oscap_module_usage(action->module, stderr, "The number of jobs needs to be between 1 and 1024.");
+			action->jobs = jobs;
+			break;
+		}
 		case 0: break;
 		default: return oscap_module_usage(action->module, stderr, NULL);
 		}